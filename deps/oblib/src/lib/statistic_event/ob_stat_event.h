@@ -285,6 +285,10 @@ STAT_EVENT_ADD_DEF(PUSHDOWN_STORAGE_FILTER_ROW_CNT, "storage filtered row count"
 STAT_EVENT_ADD_DEF(MINOR_SSSTORE_READ_ROW_COUNT, "minor ssstore read row count", ObStatClassIds::STORAGE, 60091, true, true, true)
 STAT_EVENT_ADD_DEF(MAJOR_SSSTORE_READ_ROW_COUNT, "major ssstore read row count", ObStatClassIds::STORAGE, 60092, true, true, true)
 STAT_EVENT_ADD_DEF(STORAGE_WRITING_THROTTLE_TIME, "storage waiting throttle time", ObStatClassIds::STORAGE, 60093, true, true, true)
+STAT_EVENT_ADD_DEF(TMP_FILE_WASH_BYTES, "tmp file wash bytes", ObStatClassIds::STORAGE, 60094, true, true, true)
+STAT_EVENT_ADD_DEF(TMP_FILE_WASH_DISK_BYTES, "tmp file wash disk bytes", ObStatClassIds::STORAGE, 60095, true, true, true)
+STAT_EVENT_ADD_DEF(TMP_FILE_READ_DISK_BYTES, "tmp file read disk bytes", ObStatClassIds::STORAGE, 60096, true, true, true)
+STAT_EVENT_ADD_DEF(MEMSTORE_WRITE_LOCK_HANDOVER_COUNT, "memstore write lock handover count in lock_wait_mgr", ObStatClassIds::STORAGE, 60097, false, true, true)
 
 // backup & restore
 STAT_EVENT_ADD_DEF(BACKUP_IO_READ_COUNT, "backup io read count", ObStatClassIds::STORAGE, 69000, true, true, true)
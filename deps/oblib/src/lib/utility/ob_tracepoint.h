@@ -807,6 +807,12 @@ class EventTable
       EN_DISABLE_SORTKEY_SEPARATELY = 2208,
       EN_ENABLE_VECTOR_IN = 2209,
       EN_SQL_MEMORY_MRG_OPTION = 2210,
+      EN_ENABLE_VEC_WINDOW_FUNCTION = 2211,
+      EN_ENABLE_VEC_MERGE_JOIN = 2212,
+      EN_DISABLE_VEC_NESTED_LOOP_JOIN = 2213,
+      EN_DISABLE_VEC_HASH_SET_OP = 2214,
+      EN_DISABLE_VEC_MERGE_GROUP_BY = 2215,
+      EN_DISABLE_VEC_MERGE_DISTINCT = 2216,
       // WR && ASH
       EN_CLOSE_ASH = 2301,
       EN_DISABLE_HASH_BASE_DISTINCT = 2302,
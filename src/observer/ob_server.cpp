@@ -202,6 +202,7 @@ ObServer::ObServer()
     conn_res_mgr_(),
     unix_domain_listener_(),
     disk_usage_report_task_(),
+    cache_warm_up_task_(),
     log_block_mgr_()
 #ifdef OB_BUILD_ARBITRATION
     ,arb_gcs_(),
@@ -676,6 +677,11 @@ void ObServer::destroy()
     TG_DESTROY(lib::TGDefIDs::DiskUseReport);
     FLOG_INFO("disk usage report task destroyed");
 
+    FLOG_INFO("begin to destroy cache warm up task");
+    TG_DESTROY(lib::TGDefIDs::CacheWarmUp);
+    cache_warm_up_task_.destroy();
+    FLOG_INFO("cache warm up task destroyed");
+
     FLOG_INFO("begin to destroy store cache");
     OB_STORE_CACHE.destroy();
     FLOG_INFO("store cache destroyed");
@@ -976,6 +982,13 @@ int ObServer::start()
       FLOG_INFO("success to schedule disk_usage_report_task_ task");
     }
 
+    if (FAILEDx(TG_SCHEDULE(lib::TGDefIDs::CacheWarmUp, cache_warm_up_task_,
+        ObMicroBlockCacheWarmUpTask::SCHEDULE_INTERVAL, true))) {
+      LOG_ERROR("fail to schedule cache_warm_up_task_ task", KR(ret));
+    } else {
+      FLOG_INFO("success to schedule cache_warm_up_task_ task");
+    }
+
     if (FAILEDx(ObActiveSessHistTask::get_instance().start())) {
       LOG_ERROR("fail to init active session history task", KR(ret));
     } else {
@@ -1248,6 +1261,10 @@ int ObServer::stop()
     TG_STOP(lib::TGDefIDs::DiskUseReport);
     FLOG_INFO("disk usage report task stopped");
 
+    FLOG_INFO("begin to stop cache warm up task");
+    TG_STOP(lib::TGDefIDs::CacheWarmUp);
+    FLOG_INFO("cache warm up task stopped");
+
     FLOG_INFO("begin to stop ob server block mgr");
     OB_SERVER_BLOCK_MGR.stop();
     FLOG_INFO("ob server block mgr stopped");
@@ -1644,6 +1661,17 @@ int ObServer::wait()
     TG_WAIT(lib::TGDefIDs::DiskUseReport);
     FLOG_INFO("wait disk usage report task success");
 
+    FLOG_INFO("begin to wait cache warm up task");
+    TG_WAIT(lib::TGDefIDs::CacheWarmUp);
+    // keep the latest hot blocks for next start
+    if (GCONF._cache_warm_up_snapshot_interval > 0) {
+      int tmp_ret = OB_SUCCESS;
+      if (OB_TMP_FAIL(cache_warm_up_task_.take_snapshot())) {
+        LOG_WARN("fail to take micro block cache snapshot", KR(tmp_ret));
+      }
+    }
+    FLOG_INFO("wait cache warm up task success");
+
     FLOG_INFO("begin to wait ob_server_block_mgr");
     OB_SERVER_BLOCK_MGR.wait();
     FLOG_INFO("wait ob_server_block_mgr success");
@@ -2704,6 +2732,21 @@ int ObServer::init_storage()
       LOG_WARN("fail to init disk usage report task", KR(ret));
     } else if (OB_FAIL(TG_START(lib::TGDefIDs::DiskUseReport))) {
       LOG_WARN("fail to initialize disk usage report timer", KR(ret));
+    } else if (OB_FAIL(cache_warm_up_task_.init(storage_env_.data_dir_))) {
+      LOG_WARN("fail to init cache warm up task", KR(ret));
+    } else if (OB_FAIL(TG_START(lib::TGDefIDs::CacheWarmUp))) {
+      LOG_WARN("fail to initialize cache warm up timer", KR(ret));
+    }
+  }
+
+  if (OB_SUCC(ret) && GCONF._micro_block_disk_cache_size > 0
+      && 0 != STRLEN(GCONF._micro_block_disk_cache_dir.str())) {
+    int tmp_ret = OB_SUCCESS;
+    // the disk cache is only an optimization, start without it on failure
+    if (OB_TMP_FAIL(OB_STORE_CACHE.init_micro_block_disk_cache(
+        GCONF._micro_block_disk_cache_dir.str(), GCONF._micro_block_disk_cache_size))) {
+      LOG_WARN("fail to init micro block disk cache", KR(tmp_ret),
+          K(GCONF._micro_block_disk_cache_dir.str()));
     }
   }
 
@@ -68,6 +68,7 @@
 #include "storage/ddl/ob_ddl_heart_beat_task.h"
 
 #include "storage/ob_disk_usage_reporter.h"
+#include "storage/blocksstable/ob_micro_block_cache_warm_up.h"
 #include "observer/dbms_scheduler/ob_dbms_sched_job_rpc_proxy.h"
 #include "logservice/ob_server_log_block_mgr.h"
 #ifdef OB_BUILD_ARBITRATION
@@ -450,6 +451,7 @@ private:
   sql::ObConnectResourceMgr conn_res_mgr_;
   diagnose::ObUnixDomainListener unix_domain_listener_;
   ObDiskUsageReportTask disk_usage_report_task_;
+  blocksstable::ObMicroBlockCacheWarmUpTask cache_warm_up_task_;
 
   logservice::ObServerLogBlockMgr log_block_mgr_;
 #ifdef OB_BUILD_ARBITRATION
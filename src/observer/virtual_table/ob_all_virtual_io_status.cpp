@@ -335,7 +335,9 @@ int ObAllVirtualIOQuota::init(const common::ObAddr &addr)
         }
       } else if (OB_FAIL(record_user_group(cur_tenant_id, tenant_holder.get_ptr()->get_io_usage(), tenant_holder.get_ptr()->get_io_config()))) {
         LOG_WARN("fail to record user group item", K(ret), K(cur_tenant_id), K(tenant_holder.get_ptr()->get_io_config()));
-      } else if (OB_FAIL(record_sys_group(cur_tenant_id, tenant_holder.get_ptr()->get_backup_io_usage()))) {
+      } else if (OB_FAIL(record_sys_group(cur_tenant_id,
+                                          tenant_holder.get_ptr()->get_backup_io_usage(),
+                                          tenant_holder.get_ptr()->get_latency_controller().get_background_iops_limit()))) {
         LOG_WARN("fail to record sys group item", K(ret), K(cur_tenant_id));
       }
     }
@@ -428,7 +430,9 @@ int ObAllVirtualIOQuota::record_user_group(const uint64_t tenant_id, ObIOUsage &
   return ret;
 }
 
-int ObAllVirtualIOQuota::record_sys_group(const uint64_t tenant_id, ObSysIOUsage &sys_io_usage)
+int ObAllVirtualIOQuota::record_sys_group(const uint64_t tenant_id,
+                                          ObSysIOUsage &sys_io_usage,
+                                          const int64_t background_iops_limit)
 {
   int ret = OB_SUCCESS;
   if (OB_UNLIKELY(!is_valid_tenant_id(tenant_id))) {
@@ -451,7 +455,8 @@ int ObAllVirtualIOQuota::record_sys_group(const uint64_t tenant_id, ObSysIOUsage
             item.size_ = sys_avg_size.at(i).at(j);
             item.real_iops_ = sys_avg_iops.at(i).at(j);
             item.min_iops_ = INT64_MAX;
-            item.max_iops_ = INT64_MAX;
+            // shared by all background groups when throttled by _io_latency_slo_target
+            item.max_iops_ = is_background_io_module(item.group_id_) ? background_iops_limit : INT64_MAX;
             if (OB_FAIL(quota_infos_.push_back(item))) {
               LOG_WARN("push back io group item failed", K(j), K(ret), K(item));
             }
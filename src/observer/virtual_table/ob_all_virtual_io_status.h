@@ -98,7 +98,7 @@ public:
   virtual ~ObAllVirtualIOQuota();
   int init(const common::ObAddr &addr);
   int record_user_group(const uint64_t tenant_id, ObIOUsage &io_usage, const ObTenantIOConfig &io_config);
-  int record_sys_group(const uint64_t tenant_id, ObSysIOUsage &sys_io_usage);
+  int record_sys_group(const uint64_t tenant_id, ObSysIOUsage &sys_io_usage, const int64_t background_iops_limit);
   virtual void reset() override;
   virtual int inner_get_next_row(common::ObNewRow *&row) override;
 private:
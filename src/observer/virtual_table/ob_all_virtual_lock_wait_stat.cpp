@@ -72,11 +72,13 @@ int ObAllVirtualLockWaitStat::process_curr_tenant(ObNewRow *&row)
   } else if (!start_to_read_ && OB_FAIL(make_this_ready_to_read())) {
     SERVER_LOG(WARN, "prepare_start_to_read_ error", K(ret), K(start_to_read_));
   } else if (OB_ISNULL(node_iter_ = MTL(memtable::ObLockWaitMgr *)
-                                        ->next(node_iter_, &cur_node_))) {
+                                        ->next(node_iter_, &cur_node_, queue_depth_))) {
     ret = OB_ITER_END;
   } else {
     int type = 0; // 1-TR 2-TX 3-TM
     get_lock_type(node_iter_->hash_, type);
+    ObLockWaitMgr::KeyWaitStat key_wait_stat;
+    MTL(memtable::ObLockWaitMgr *)->get_key_wait_stat(node_iter_->hash_, key_wait_stat);
     const int64_t col_count = output_column_ids_.count();
     ObString ipstr;
     for (int64_t i = 0; OB_SUCC(ret) && i < col_count; ++i) {
@@ -215,6 +217,15 @@ int ObAllVirtualLockWaitStat::process_curr_tenant(ObNewRow *&row)
           cur_row_.cells_[i].set_int(holder_tx_id.get_id());
           break;
         }
+        case WAIT_QUEUE_DEPTH:
+          cur_row_.cells_[i].set_int(queue_depth_);
+          break;
+        case KEY_WAKEUP_CNT:
+          cur_row_.cells_[i].set_int(key_wait_stat.wakeup_cnt_);
+          break;
+        case KEY_WAIT_TIME:
+          cur_row_.cells_[i].set_int(key_wait_stat.wait_time_);
+          break;
         default:
           ret = OB_ERR_UNEXPECTED;
           SERVER_LOG(WARN, "invalid col_id", K(ret), K(col_id));
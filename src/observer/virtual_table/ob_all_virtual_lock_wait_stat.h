@@ -26,7 +26,7 @@ class ObAllVirtualLockWaitStat : public common::ObVirtualTableScannerIterator,
                                  public omt::ObMultiTenantOperator
 {
 public:
-  ObAllVirtualLockWaitStat() : node_iter_(nullptr) {}
+  ObAllVirtualLockWaitStat() : node_iter_(nullptr), queue_depth_(0) {}
   virtual ~ObAllVirtualLockWaitStat() { reset(); }
 
 public:
@@ -62,8 +62,12 @@ private:
     TOTAL_UPDATE_CNT,
     TRANS_ID,
     HOLDER_TRANS_ID,
+    WAIT_QUEUE_DEPTH,
+    KEY_WAKEUP_CNT,
+    KEY_WAIT_TIME,
   };
   rpc::ObLockWaitNode *node_iter_;
+  int64_t queue_depth_;
   rpc::ObLockWaitNode cur_node_;
   char rowkey_[common::MAX_LOCK_ROWKEY_BUF_LENGTH];
   char lock_mode_[common::MAX_LOCK_MODE_BUF_LENGTH];
@@ -62,7 +62,8 @@ private:
     TOTAL_PUT_CNT,
     TOTAL_HIT_CNT,
     TOTAL_MISS_CNT,
-    HOLD_SIZE
+    HOLD_SIZE,
+    ADMISSION_PROBATION_CNT
   };
   common::ObAddr *addr_;
   common::ObString ipstr_;
@@ -360,7 +360,8 @@ int ObKVGlobalCache::put(
     COMMON_LOG(WARN, "The inst is NULL, ", K(ret));
   } else if (!overwrite && (OB_SUCC(map_.get(cache_id, key, pvalue, mb_handle)))) {
     ret = OB_ENTRY_EXIST;
-  } else if (OB_FAIL(store.store(*inst_handle.get_inst(), key, value, kvpair, mb_wrapper))) {
+  } else if (OB_FAIL(store.store(*inst_handle.get_inst(), key, value, kvpair, mb_wrapper,
+      get_admit_policy(*inst_handle.get_inst(), cache_id, key)))) {
     COMMON_LOG(WARN, "Fail to store kvpair to store, ", K(ret));
   } else {
     mb_handle = mb_wrapper->get_mb_handle();
@@ -390,9 +391,11 @@ int ObKVGlobalCache::alloc(
     const int64_t value_size,
     ObKVCachePair *&kvpair,
     ObKVMemBlockHandle *&mb_handle,
-    ObKVCacheInstHandle &inst_handle)
+    ObKVCacheInstHandle &inst_handle,
+    const ObIKVCacheKey *admit_key)
 {
-  return alloc(store_, cache_id, tenant_id, key_size, value_size, kvpair, mb_handle, inst_handle);
+  return alloc(store_, cache_id, tenant_id, key_size, value_size, kvpair, mb_handle, inst_handle,
+               admit_key);
 }
 
 int ObKVGlobalCache::alloc(
@@ -424,7 +427,8 @@ int ObKVGlobalCache::alloc(
     const int64_t value_size,
     ObKVCachePair *&kvpair,
     ObKVMemBlockHandle *&mb_handle,
-    ObKVCacheInstHandle &inst_handle)
+    ObKVCacheInstHandle &inst_handle,
+    const ObIKVCacheKey *admit_key)
 {
   int ret = OB_SUCCESS;
   ObKVCacheInstKey inst_key(cache_id, tenant_id);
@@ -441,7 +445,9 @@ int ObKVGlobalCache::alloc(
     ret = OB_ERR_UNEXPECTED;
     COMMON_LOG(WARN, "The inst is NULL, ", K(ret));
   } else if (OB_FAIL(store.alloc_kvpair(*inst_handle.get_inst(),
-          key_size, value_size, kvpair, mb_wrapper))) {
+          key_size, value_size, kvpair, mb_wrapper,
+          nullptr == admit_key
+          ? LRU : get_admit_policy(*inst_handle.get_inst(), cache_id, *admit_key)))) {
     COMMON_LOG(WARN, "Fail to store kvpair, ", K(ret));
   } else {
     mb_handle = mb_wrapper->get_mb_handle();
@@ -449,6 +455,23 @@ int ObKVGlobalCache::alloc(
   return ret;
 }
 
+ObKVCachePolicy ObKVGlobalCache::get_admit_policy(
+    ObKVCacheInst &inst,
+    const int64_t cache_id,
+    const ObIKVCacheKey &key)
+{
+  ObKVCachePolicy policy = LRU;
+  uint64_t hash_code = 0;
+  if (nullptr == inst.sketch_ || !GCONF._enable_kvcache_admission) {
+  } else if (OB_SUCCESS != key.hash(hash_code)) {
+    // admit kvs whose hash can not be got
+  } else {
+    // keep the same hash as ObKVCacheMap
+    policy = inst.get_admit_policy(hash_code + cache_id);
+  }
+  return policy;
+}
+
 int ObKVGlobalCache::get(
   const int64_t cache_id,
   const ObIKVCacheKey &key,
@@ -602,7 +625,8 @@ int ObKVGlobalCache::erase_cache(const char *cache_name)
 int ObKVGlobalCache::register_cache(
   const char *cache_name,
   const int64_t priority,
-  int64_t &cache_id)
+  int64_t &cache_id,
+  const bool enable_admission)
 {
   int ret = OB_SUCCESS;
   if (!inited_) {
@@ -632,6 +656,7 @@ int ObKVGlobalCache::register_cache(
         STRNCPY(configs_[cache_id].cache_name_, cache_name, MAX_CACHE_NAME_LENGTH - 1);
         configs_[cache_id].cache_name_[MAX_CACHE_NAME_LENGTH - 1] = '\0';
         configs_[cache_id].priority_ = priority;
+        configs_[cache_id].enable_admission_ = enable_admission;
         configs_[cache_id].is_valid_ = true;
       }
     }
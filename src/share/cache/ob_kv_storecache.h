@@ -58,7 +58,9 @@ class ObKVCache : public ObIKVCache<Key, Value>
 public:
   ObKVCache();
   virtual ~ObKVCache();
-  int init(const char *cache_name, const int64_t priority = 1);
+  // kvs put to cache with admission enabled go to probationary memblocks unless they have
+  // been accessed recently, see ObKVCacheInst::get_admit_policy
+  int init(const char *cache_name, const int64_t priority = 1, const bool enable_admission = false);
   void destroy();
   int set_priority(const int64_t priority);
   virtual int put(const Key &key, const Value &value, bool overwrite = true);
@@ -78,6 +80,13 @@ public:
       ObKVCachePair *&kvpair,
       ObKVCacheHandle &handle,
       ObKVCacheInstHandle &inst_handle) override;
+  // same as above, but the kvpair is admitted by %key
+  int alloc(
+      const Key &key,
+      const int64_t value_size,
+      ObKVCachePair *&kvpair,
+      ObKVCacheHandle &handle,
+      ObKVCacheInstHandle &inst_handle);
   int64_t size(const uint64_t tenant_id = OB_SYS_TENANT_ID) const;
   int64_t count(const uint64_t tenant_id = OB_SYS_TENANT_ID) const;
   int64_t get_hit_cnt(const uint64_t tenant_id = OB_SYS_TENANT_ID) const;
@@ -169,7 +178,8 @@ private:
   friend class ObKVCacheHandle;
   ObKVGlobalCache();
   virtual ~ObKVGlobalCache();
-  int register_cache(const char *cache_name, const int64_t priority, int64_t &cache_id);
+  int register_cache(const char *cache_name, const int64_t priority, int64_t &cache_id,
+                     const bool enable_admission = false);
   void deregister_cache(const int64_t cache_id);
   int create_working_set(const ObKVCacheInstKey &inst_key, ObWorkingSet *&working_set);
   int delete_working_set(ObWorkingSet *working_set);
@@ -204,7 +214,8 @@ private:
       const int64_t value_size,
       ObKVCachePair *&kvpair,
       ObKVMemBlockHandle *&mb_handle,
-      ObKVCacheInstHandle &inst_handle);
+      ObKVCacheInstHandle &inst_handle,
+      const ObIKVCacheKey *admit_key = nullptr);
   int alloc(
       ObWorkingSet *working_set,
       const uint64_t tenant_id,
@@ -222,7 +233,8 @@ private:
       const int64_t value_size,
       ObKVCachePair *&kvpair,
       ObKVMemBlockHandle *&mb_handle,
-      ObKVCacheInstHandle &inst_handle);
+      ObKVCacheInstHandle &inst_handle,
+      const ObIKVCacheKey *admit_key = nullptr);
   int get(
     const int64_t cache_id,
     const ObIKVCacheKey &key,
@@ -233,6 +245,9 @@ private:
   void wash();
   void replace_map();
   int get_cache_id(const char *cache_name, int64_t &cache_id);
+private:
+  ObKVCachePolicy get_admit_policy(ObKVCacheInst &inst, const int64_t cache_id,
+                                   const ObIKVCacheKey &key);
 private:
   static const int64_t DEFAULT_BUCKET_NUM = 10000000L;
   static const int64_t DEFAULT_MAX_CACHE_SIZE = 1024L * 1024L * 1024L * 1024L;  //1T
@@ -359,6 +374,9 @@ public:
    */
   template <class Key, class Value>
   int get_next_kvpair(const Key *&key, const Value *&value, ObKVCacheHandle &handle);
+  // @param get_cnt: out, times the kvpair is got since it is put
+  template <class Key, class Value>
+  int get_next_kvpair(const Key *&key, const Value *&value, int64_t &get_cnt, ObKVCacheHandle &handle);
   void reset();
 private:
   int64_t cache_id_;
@@ -412,7 +430,8 @@ ObKVCache<Key, Value>::~ObKVCache()
 }
 
 template <class Key, class Value>
-int ObKVCache<Key, Value>::init(const char *cache_name, const int64_t priority)
+int ObKVCache<Key, Value>::init(const char *cache_name, const int64_t priority,
+                                const bool enable_admission)
 {
   int ret = OB_SUCCESS;
   if (OB_UNLIKELY(inited_)) {
@@ -422,10 +441,12 @@ int ObKVCache<Key, Value>::init(const char *cache_name, const int64_t priority)
       || OB_UNLIKELY(priority <= 0)) {
     ret = OB_INVALID_ARGUMENT;
     COMMON_LOG(WARN, "Invalid argument, ", KP(cache_name), K(priority), K(ret));
-  } else if (OB_FAIL(ObKVGlobalCache::get_instance().register_cache(cache_name, priority, cache_id_))) {
+  } else if (OB_FAIL(ObKVGlobalCache::get_instance().register_cache(
+      cache_name, priority, cache_id_, enable_admission))) {
     COMMON_LOG(WARN, "Fail to register cache, ", K(ret));
   } else {
-    COMMON_LOG(INFO, "Succ to register cache", K(cache_name), K(priority), K_(cache_id));
+    COMMON_LOG(INFO, "Succ to register cache", K(cache_name), K(priority), K(enable_admission),
+        K_(cache_id));
     inited_ = true;
   }
   return ret;
@@ -659,6 +680,34 @@ int ObKVCache<Key, Value>::alloc(const uint64_t tenant_id, const int64_t key_siz
   return ret;
 }
 
+template <class Key, class Value>
+int ObKVCache<Key, Value>::alloc(const Key &key, const int64_t value_size,
+    ObKVCachePair *&kvpair, ObKVCacheHandle &handle, ObKVCacheInstHandle &inst_handle)
+{
+  int ret = OB_SUCCESS;
+  handle.reset();
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObKVCache has not been inited, ", K(ret));
+  } else if (OB_FAIL(ObKVGlobalCache::get_instance().alloc(
+          cache_id_,
+          key.get_tenant_id(),
+          key.size(),
+          value_size,
+          kvpair,
+          handle.mb_handle_,
+          inst_handle,
+          &key))) {
+    COMMON_LOG(WARN, "failed to alloc", K(ret));
+  } else {
+#ifdef ENABLE_DEBUG_LOG
+    storage::ObStorageLeakChecker::get_instance().handle_hold(&handle, storage::ObStorageCheckID::ALL_CACHE);
+#endif
+  }
+
+  return ret;
+}
+
 
 template <class Key, class Value>
 int64_t ObKVCache<Key, Value>::store_size(const uint64_t tenant_id) const
@@ -686,6 +735,17 @@ int ObKVCacheIterator::get_next_kvpair(
     const Key *&key,
     const Value *&value,
     ObKVCacheHandle &handle)
+{
+  int64_t get_cnt = 0;
+  return get_next_kvpair(key, value, get_cnt, handle);
+}
+
+template <class Key, class Value>
+int ObKVCacheIterator::get_next_kvpair(
+    const Key *&key,
+    const Value *&value,
+    int64_t &get_cnt,
+    ObKVCacheHandle &handle)
 {
   int ret = OB_SUCCESS;
   ObKVCacheMap::Node node;
@@ -717,6 +777,7 @@ int ObKVCacheIterator::get_next_kvpair(
     handle.reset();
     key = reinterpret_cast<const Key*>(node.key_);
     value = reinterpret_cast<const Value*>(node.value_);
+    get_cnt = node.get_cnt_;
     handle.mb_handle_ = node.mb_handle_;
 #ifdef ENABLE_DEBUG_LOG
     storage::ObStorageLeakChecker::get_instance().handle_hold(&handle, storage::ObStorageCheckID::ALL_CACHE);
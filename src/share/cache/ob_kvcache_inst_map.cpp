@@ -11,6 +11,7 @@
  */
 
 #include "ob_kvcache_inst_map.h"
+#include "lib/alloc/alloc_func.h"
 
 
 namespace oceanbase
@@ -303,6 +304,15 @@ int ObKVCacheInstMap::get_cache_inst(
           COMMON_LOG(WARN, "get mb list failed", K(ret), "tenant_id", inst_key.tenant_id_);
         } else if (OB_FAIL(inst->node_allocator_.init(OB_MALLOC_BIG_BLOCK_SIZE, attr, 1))) {
           COMMON_LOG(WARN, "Fail to init node allocator, ", K(ret));
+        } else if (configs_[inst_key.cache_id_].enable_admission_
+            && OB_ISNULL(inst->sketch_ = OB_NEW(ObKVCacheFrequencySketch,
+                ObMemAttr(inst_key.tenant_id_, "CACHE_SKETCH")))) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          COMMON_LOG(WARN, "Fail to alloc frequency sketch, ", K(ret));
+        } else if (nullptr != inst->sketch_ && OB_FAIL(inst->sketch_->init(
+            lib::get_tenant_memory_limit(inst_key.tenant_id_) / ObKVCacheFrequencySketch::AVG_KV_SIZE,
+            ObMemAttr(inst_key.tenant_id_, "CACHE_SKETCH")))) {
+          COMMON_LOG(WARN, "Fail to init frequency sketch, ", K(ret), "tenant_id", inst_key.tenant_id_);
         } else if (OB_FAIL(inst_map_.set_refactored(inst_key, inst))) {
           COMMON_LOG(WARN, "Fail to set inst to inst map, ", K(ret));
         } else {
@@ -76,6 +76,8 @@ struct ObTenantMBListHandle
 
 struct ObKVCacheInst
 {
+  // 1 in HIT_SAMPLE_RATE hits of a thread is recorded into the sketch
+  static const int64_t HIT_SAMPLE_RATE = 8;
   int64_t cache_id_;
   uint64_t tenant_id_;
   ObKVMemBlockHandle *handles_[MAX_POLICY];
@@ -84,6 +86,7 @@ struct ObKVCacheInst
   bool is_delete_;
   int64_t ref_cnt_;
   ObTenantMBListHandle mb_list_handle_; // list of tenant mbs
+  ObKVCacheFrequencySketch *sketch_; // only for caches with admission enabled
   ObKVCacheInst()
     : cache_id_(0),
       tenant_id_(0),
@@ -91,7 +94,8 @@ struct ObKVCacheInst
       status_(),
       is_delete_(false),
       ref_cnt_(0),
-      mb_list_handle_() { MEMSET(handles_, 0, sizeof(handles_)); }
+      mb_list_handle_(),
+      sketch_(nullptr) { MEMSET(handles_, 0, sizeof(handles_)); }
   bool can_destroy() const ;
   void reset() {
     cache_id_ = 0;
@@ -102,6 +106,10 @@ struct ObKVCacheInst
     ref_cnt_ = 0;
     mb_list_handle_.reset();
     MEMSET(handles_, 0, sizeof(handles_));
+    if (nullptr != sketch_) {
+      ob_delete(sketch_);
+      sketch_ = nullptr;
+    }
   }
   bool is_valid() const { return ref_cnt_ > 0; }
   bool is_mark_delete() const { return ATOMIC_LOAD(&is_delete_); }
@@ -112,6 +120,31 @@ struct ObKVCacheInst
 
   common::ObDLink *get_mb_list() { return mb_list_handle_.get_head(); }
 
+  // admission related, %hash should be the one used by ObKVCacheMap. Hits are sampled, the
+  // counters of the sketch are shared by all the readers of the cache, hot keys are still
+  // recorded often enough to tell them from the cold ones.
+  inline void record_access(const uint64_t hash)
+  {
+    RLOCAL_INLINE(int64_t, hit_cnt);
+    if (nullptr != sketch_ && 0 == (++hit_cnt & (HIT_SAMPLE_RATE - 1))) {
+      sketch_->increment(hash);
+    }
+  }
+  // a put is counted as an access as well, so kvs put for the first time recently go to
+  // probationary memblocks, a scan can only wash them instead of the hot ones.
+  inline ObKVCachePolicy get_admit_policy(const uint64_t hash)
+  {
+    ObKVCachePolicy policy = LRU;
+    if (nullptr != sketch_) {
+      if (0 == sketch_->estimate(hash)) {
+        policy = PROBATION;
+        status_.admission_probation_cnt_.inc();
+      }
+      sketch_->increment(hash);
+    }
+    return policy;
+  }
+
   TO_STRING_KV(K_(cache_id), K_(tenant_id), K_(is_delete), K_(status), K_(ref_cnt));
 };
 
@@ -286,6 +286,9 @@ int ObKVCacheMap::get(
               ++out_handle->recent_get_cnt_;
               iter_get_cnt = ++ iter->get_cnt_;
               iter->inst_->status_.total_hit_cnt_.inc();
+              if (GCONF._enable_kvcache_admission) {
+                iter->inst_->record_access(hash_code);
+              }
               mb_policy = out_handle->policy_;
 
               break;
@@ -300,7 +303,9 @@ int ObKVCacheMap::get(
       } else if (NULL == iter) {
         ret = OB_ENTRY_NOT_EXIST;
       } else {
-        if (LRU == mb_policy && need_modify_cache(iter_get_cnt, mb_get_cnt, mb_handle_kv_cnt)) {
+        // kvs hit on probationary memblocks are admitted at once
+        if ((LRU == mb_policy && need_modify_cache(iter_get_cnt, mb_get_cnt, mb_handle_kv_cnt))
+            || PROBATION == mb_policy) {
           int tmp_ret = OB_SUCCESS;
           ObBucketWLockGuard guard(bucket_lock_, bucket_pos);
           if (OB_TMP_FAIL(guard.get_ret())) {
@@ -911,10 +911,10 @@ int ObKVCacheStore::alloc_mbhandle(
       COMMON_LOG(ERROR, "Fail to set mb_handle status from FREE to USING, ", K(ret));
     } else {
       (void) ATOMIC_AAF(&inst.status_.store_size_, block_size);
-      if (LRU == policy) {
-        (void) ATOMIC_AAF(&inst.status_.lru_mb_cnt_, 1);
-      } else {
+      if (LFU == policy) {
         (void) ATOMIC_AAF(&inst.status_.lfu_mb_cnt_, 1);
+      } else {
+        (void) ATOMIC_AAF(&inst.status_.lru_mb_cnt_, 1);
       }
       mb_handle->inst_ = &inst;
       mb_handle->policy_ = policy;
@@ -1211,10 +1211,10 @@ int ObKVCacheStore::do_wash_mb(ObKVMemBlockHandle *mb_handle, void *&buf, int64_
     if (NULL != mb_handle->inst_) {
       (void) ATOMIC_SAF(&mb_handle->inst_->status_.store_size_,
                         mb_handle->mem_block_->get_payload_size() + sizeof(ObKVStoreMemBlock));
-      if (mb_handle->policy_ == LRU) {
-        (void) ATOMIC_SAF(&mb_handle->inst_->status_.lru_mb_cnt_, 1);
-      } else {
+      if (mb_handle->policy_ == LFU) {
         (void) ATOMIC_SAF(&mb_handle->inst_->status_.lfu_mb_cnt_, 1);
+      } else {
+        (void) ATOMIC_SAF(&mb_handle->inst_->status_.lru_mb_cnt_, 1);
       }
     }
     buf = mb_handle->mem_block_;
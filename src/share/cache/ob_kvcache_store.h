@@ -337,8 +337,8 @@ int ObIKVCacheStore<MBWrapper>::alloc_kvpair_without_retry(
           de_handle_ref(mb_wrapper);
           COMMON_LOG(WARN, "alloc failed", K(ret));
         } else {
-          //success to alloc kv
-          mb_wrapper->set_full(inst.status_.base_mb_score_);
+          //success to alloc kv, probationary memblocks start from the lowest score
+          mb_wrapper->set_full(PROBATION == policy ? 0 : inst.status_.base_mb_score_);
         }
       } else {
         ret = OB_ERR_UNEXPECTED;
@@ -372,7 +372,7 @@ int ObIKVCacheStore<MBWrapper>::alloc_kvpair_without_retry(
           COMMON_LOG(WARN, "alloc failed", K(ret), K(block_size));
         } else if (ATOMIC_BCAS((uint64_t*)(&get_curr_mb(inst, policy)), (uint64_t)mb_wrapper, (uint64_t)new_mb_wrapper)) {
           if (NULL != mb_wrapper) {
-            mb_wrapper->set_full(inst.status_.base_mb_score_);
+            mb_wrapper->set_full(PROBATION == policy ? 0 : inst.status_.base_mb_score_);
           }
         } else if (OB_FAIL(free(new_mb_wrapper))) {
           COMMON_LOG(ERROR, "free failed", K(ret));
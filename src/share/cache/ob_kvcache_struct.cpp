@@ -21,7 +21,8 @@ namespace common
  */
 ObKVCacheConfig::ObKVCacheConfig()
   : is_valid_(false),
-    priority_(0)
+    priority_(0),
+    enable_admission_(false)
 {
   MEMSET(cache_name_, 0, MAX_CACHE_NAME_LENGTH);
 }
@@ -30,6 +31,7 @@ void ObKVCacheConfig::reset()
 {
   is_valid_ = false;
   priority_ = 0;
+  enable_admission_ = false;
   MEMSET(cache_name_, 0, MAX_CACHE_NAME_LENGTH);
 }
 
@@ -62,6 +64,7 @@ void ObKVCacheStatus::reset()
   lfu_mb_cnt_ = 0;
   total_put_cnt_.reset();
   total_hit_cnt_.reset();
+  admission_probation_cnt_.reset();
   total_miss_cnt_ = 0;
   last_hit_cnt_ = 0;
   base_mb_score_ = 0;
@@ -69,6 +72,90 @@ void ObKVCacheStatus::reset()
   total_miss_cnt_ = 0;
 }
 
+/*
+ * -------------------------------------------------------------ObKVCacheFrequencySketch-------------------------------------------------
+ */
+const uint64_t ObKVCacheFrequencySketch::SEEDS[DEPTH] = {
+  0x97CB3127E11A2A5DULL, 0xC6A4A7935BD1E995ULL, 0x9E3779B97F4A7C15ULL, 0xBF58476D1CE4E5B9ULL };
+
+ObKVCacheFrequencySketch::ObKVCacheFrequencySketch()
+  : width_(0),
+    sample_size_(0),
+    sample_cnt_(0),
+    table_(nullptr)
+{
+}
+
+ObKVCacheFrequencySketch::~ObKVCacheFrequencySketch()
+{
+  destroy();
+}
+
+int ObKVCacheFrequencySketch::init(const int64_t capacity, const lib::ObMemAttr &attr)
+{
+  int ret = OB_SUCCESS;
+  int64_t width = MIN_WIDTH;
+  while (width < capacity && width < MAX_WIDTH) {
+    width <<= 1;
+  }
+  if (OB_UNLIKELY(nullptr != table_)) {
+    ret = OB_INIT_TWICE;
+    COMMON_LOG(WARN, "frequency sketch init twice", K(ret));
+  } else if (OB_ISNULL(table_ = static_cast<uint8_t *>(ob_malloc(DEPTH * width, attr)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    COMMON_LOG(WARN, "fail to alloc frequency sketch table", K(ret), K(width));
+  } else {
+    MEMSET(table_, 0, DEPTH * width);
+    width_ = width;
+    sample_size_ = SAMPLE_FACTOR * width;
+    sample_cnt_ = 0;
+  }
+  return ret;
+}
+
+void ObKVCacheFrequencySketch::destroy()
+{
+  if (nullptr != table_) {
+    ob_free(table_);
+    table_ = nullptr;
+  }
+  width_ = 0;
+  sample_size_ = 0;
+  sample_cnt_ = 0;
+}
+
+void ObKVCacheFrequencySketch::increment(const uint64_t hash)
+{
+  for (int64_t row = 0; row < DEPTH; ++row) {
+    uint8_t &counter = counter_of(hash, row);
+    const uint8_t freq = ATOMIC_LOAD(&counter);
+    if (freq < MAX_FREQ) {
+      ATOMIC_STORE_REL(&counter, static_cast<uint8_t>(freq + 1));
+    }
+  }
+  if (ATOMIC_AAF(&sample_cnt_, 1) == sample_size_) {
+    age();
+  }
+}
+
+uint8_t ObKVCacheFrequencySketch::estimate(const uint64_t hash) const
+{
+  uint8_t freq = MAX_FREQ;
+  for (int64_t row = 0; row < DEPTH; ++row) {
+    freq = MIN(freq, ATOMIC_LOAD(&counter_of(hash, row)));
+  }
+  return freq;
+}
+
+void ObKVCacheFrequencySketch::age()
+{
+  // only the thread reaching sample_size_ gets here
+  for (int64_t i = 0; i < DEPTH * width_; ++i) {
+    ATOMIC_STORE_REL(&table_[i], static_cast<uint8_t>(ATOMIC_LOAD(&table_[i]) >> 1));
+  }
+  ATOMIC_SAF(&sample_cnt_, sample_size_ / 2);
+}
+
 /*
  * -------------------------------------------------------------ObKVStoreMemBlock--------------------------------------------------------
  */
@@ -74,7 +74,50 @@ enum ObKVCachePolicy
 {
   LRU = 0,
   LFU = 1,
-  MAX_POLICY = 2
+  // kvs not admitted by the admission filter, memblocks of them get no base score when full
+  // and are washed before LRU and LFU ones, kvs hit later are moved to LFU memblocks.
+  PROBATION = 2,
+  MAX_POLICY = 3
+};
+
+// Count-min sketch of recent access frequency of keys, counters saturate at MAX_FREQ and
+// are halved every SAMPLE_FACTOR * width increments so that old popularity fades out. The
+// width follows the number of kvs the cache is expected to hold, so that the sketch still
+// tells apart hot keys of a large cache. Updates are not synchronized, lost ones only make
+// the estimation a bit lower.
+class ObKVCacheFrequencySketch
+{
+public:
+  static const int64_t DEPTH = 4;
+  static const int64_t MIN_WIDTH = 1L << 12;
+  static const int64_t MAX_WIDTH = 1L << 22;
+  static const int64_t SAMPLE_FACTOR = 10;
+  // the expected kv count of a cache is the tenant memory limit divided by this size
+  static const int64_t AVG_KV_SIZE = 8L << 10;
+  static const uint8_t MAX_FREQ = 15;
+  ObKVCacheFrequencySketch();
+  ~ObKVCacheFrequencySketch();
+  // %capacity is the expected kv count of the cache
+  int init(const int64_t capacity, const lib::ObMemAttr &attr);
+  void destroy();
+  void increment(const uint64_t hash);
+  uint8_t estimate(const uint64_t hash) const;
+  inline int64_t get_width() const { return width_; }
+  inline int64_t get_sample_size() const { return sample_size_; }
+private:
+  void age();
+  OB_INLINE uint8_t &counter_of(const uint64_t hash, const int64_t row) const
+  {
+    const uint64_t h = (hash + SEEDS[row]) * SEEDS[row];
+    return table_[row * width_ + static_cast<int64_t>((h ^ (h >> 32)) & (width_ - 1))];
+  }
+private:
+  static const uint64_t SEEDS[DEPTH];
+  int64_t width_;
+  int64_t sample_size_;
+  int64_t sample_cnt_;
+  uint8_t *table_;
+  DISALLOW_COPY_AND_ASSIGN(ObKVCacheFrequencySketch);
 };
 
 class ObKVStoreMemBlock
@@ -176,6 +219,8 @@ public:
   void reset();
   bool is_valid_;
   int64_t priority_;
+  // put kvs not accessed recently to probationary memblocks, see ObKVCacheInst::get_admit_policy
+  bool enable_admission_;
   char cache_name_[MAX_CACHE_NAME_LENGTH];
 };
 
@@ -194,8 +239,11 @@ public:
   const ObKVCacheConfig *config_;
   ObPCNonAtomicCounter total_put_cnt_;
   ObPCNonAtomicCounter total_hit_cnt_;
+  // puts not admitted and stored on probationary memblocks
+  ObPCNonAtomicCounter admission_probation_cnt_;
   int64_t kv_cnt_;
   int64_t store_size_;
+  // memblocks of LRU and PROBATION
   int64_t lru_mb_cnt_;
   int64_t lfu_mb_cnt_;
   int64_t map_size_;
@@ -516,6 +516,17 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObConfigPublishSchemaModeChecker);
 };
 
+class ObConfigIOEngineChecker
+  : public ObConfigChecker
+{
+public:
+  ObConfigIOEngineChecker() {}
+  virtual ~ObConfigIOEngineChecker() {}
+  bool check(const ObConfigItem& t) const;
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObConfigIOEngineChecker);
+};
+
 // config item container
 class ObConfigStringKey
 {
@@ -7560,6 +7560,7 @@ def_table_schema(
   ('total_hit_cnt', 'int', 'false'),
   ('total_miss_cnt', 'int', 'false'),
   ('hold_size', 'int', 'false'),
+  ('admission_probation_cnt', 'int', 'false'),
   ],
   vtable_route_policy = 'distributed',
   partition_columns = ['svr_ip', 'svr_port'],
@@ -9808,7 +9809,11 @@ def_table_schema(
   ('last_compact_cnt', 'int'),
   ('total_update_cnt', 'int'),
   ('trans_id', 'int'),
-  ('holder_trans_id', 'int')
+  ('holder_trans_id', 'int'),
+  ('wait_queue_depth', 'int'),
+  # accumulated since the key became the last one waited on in its lock bucket
+  ('key_wakeup_cnt', 'int'),
+  ('key_wait_time', 'int')
   ],
 
   partition_columns = ['svr_ip', 'svr_port'],
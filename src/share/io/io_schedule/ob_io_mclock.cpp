@@ -205,10 +205,11 @@ ObTenantIOClock::ObTenantIOClock()
   : is_inited_(false),
     group_clocks_(),
     other_group_clock_(),
+    background_clock_(),
     io_config_(),
     io_usage_(nullptr)
 {
-
+  background_clock_.iops_ = INT64_MAX;
 }
 
 ObTenantIOClock::~ObTenantIOClock()
@@ -334,6 +335,12 @@ int ObTenantIOClock::calc_phyqueue_clock(ObPhyQueue *phy_queue, ObIORequest &req
       } else {
         // ensure not exceed max iops of the tenant
         unit_clock_.atom_update(current_ts, iops_scale, phy_queue->tenant_limitation_ts_);
+        if (is_background_io_module(req.get_group_id()) && INT64_MAX != ATOMIC_LOAD(&background_clock_.iops_)) {
+          // throttled for latency of foreground io, counted in requests regardless of size
+          int64_t background_limitation_ts = 0;
+          background_clock_.atom_update(current_ts, 1.0, background_limitation_ts);
+          phy_queue->group_limitation_ts_ = max(phy_queue->group_limitation_ts_, background_limitation_ts);
+        }
       }
     }
   }
@@ -74,8 +74,10 @@ public:
   int64_t get_min_proportion_ts();
   bool is_unlimited_config(const ObMClock &clock, const ObTenantIOConfig::GroupConfig &cur_config);
   void stop_clock(const uint64_t index);
+  // limit of background io in requests per second, INT64_MAX means unlimited
+  void set_background_iops_limit(const int64_t iops) { ATOMIC_STORE(&background_clock_.iops_, iops); }
   TO_STRING_KV(K(is_inited_), "group_clocks", group_clocks_, "other_clock", other_group_clock_,
-      K_(unit_clock), K(io_config_), K(io_usage_));
+      K_(unit_clock), K_(background_clock), K(io_config_), K(io_usage_));
 private:
   ObMClock &get_mclock(const int64_t queue_index);
   double get_weight_scale(const int64_t queue_index);
@@ -86,6 +88,7 @@ private:
   ObSEArray<ObMClock, GROUP_START_NUM> group_clocks_;
   ObMClock other_group_clock_;
   ObAtomIOClock unit_clock_;
+  ObAtomIOClock background_clock_;
   ObTenantIOConfig io_config_;
   const ObIOUsage *io_usage_;
 };
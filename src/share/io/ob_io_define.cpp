@@ -635,6 +635,7 @@ void ObIOResult::finish(const ObIORetCode &ret_code, ObIORequest *req)
         } else {
           tenant_io_mgr_.get_ptr()->io_usage_.accumulate(*this, *req);
         }
+        tenant_io_mgr_.get_ptr()->io_latency_controller_.record_io(get_group_id(), *req);
         tenant_io_mgr_.get_ptr()->io_usage_.record_request_finish(*this);
         end_ts_ = ObTimeUtility::fast_current_time();
         // record io error
@@ -1517,7 +1518,7 @@ bool ObTenantIOConfig::GroupConfig::is_valid() const
 }
 
 ObTenantIOConfig::ObTenantIOConfig()
-  : memory_limit_(0), callback_thread_count_(0), group_num_(0), group_ids_(), group_configs_(),
+  : memory_limit_(0), callback_thread_count_(0), latency_slo_target_us_(0), group_num_(0), group_ids_(), group_configs_(),
     other_group_config_(), group_config_change_(false), enable_io_tracer_(false)
 {
 
@@ -1539,6 +1540,7 @@ const ObTenantIOConfig &ObTenantIOConfig::default_instance()
   static ObTenantIOConfig instance;
   instance.memory_limit_ = 512L * 1024L * 1024L; // min_tenant_memory: 512M
   instance.callback_thread_count_ = 0;
+  instance.latency_slo_target_us_ = 0;
   instance.group_num_ = 0;
   instance.unit_config_.min_iops_ = 10000;
   instance.unit_config_.max_iops_ = 50000;
@@ -1578,6 +1580,8 @@ bool ObTenantIOConfig::operator ==(const ObTenantIOConfig &other) const
     LOG_INFO("memory limit not equal", K(memory_limit_), K(other.memory_limit_));
   } else if (callback_thread_count_ != other.callback_thread_count_) {
     LOG_INFO("callback thread count not equal", K(callback_thread_count_), K(other.callback_thread_count_));
+  } else if (latency_slo_target_us_ != other.latency_slo_target_us_) {
+    LOG_INFO("latency slo target not equal", K(latency_slo_target_us_), K(other.latency_slo_target_us_));
   } else if (unit_config_.weight_ != other.unit_config_.weight_
       || unit_config_.max_iops_ != other.unit_config_.max_iops_
       || unit_config_.min_iops_ != other.unit_config_.min_iops_) {
@@ -1603,6 +1607,7 @@ int ObTenantIOConfig::deep_copy(const ObTenantIOConfig &other_config)
   if (OB_SUCC(ret)) {
     memory_limit_ = other_config.memory_limit_;
     callback_thread_count_ = other_config.callback_thread_count_;
+    latency_slo_target_us_ = other_config.latency_slo_target_us_;
     unit_config_ = other_config.unit_config_;
     group_config_change_ = other_config.group_config_change_;
     enable_io_tracer_ = other_config.enable_io_tracer_;
@@ -1763,7 +1768,7 @@ int64_t ObTenantIOConfig::to_string(char* buf, const int64_t buf_len) const
 {
   int64_t pos = 0;
   J_OBJ_START();
-  J_KV(K(group_num_), K(memory_limit_), K(callback_thread_count_), K(unit_config_), K_(enable_io_tracer));
+  J_KV(K(group_num_), K(memory_limit_), K(callback_thread_count_), K_(latency_slo_target_us), K(unit_config_), K_(enable_io_tracer));
   // if self invalid, print all group configs, otherwise, only print valid group configs
   const bool self_valid = is_valid();
   BUF_PRINTF(", group_configs:[");
@@ -72,6 +72,16 @@ enum ObIOModule {
 };
 
 const char *get_io_sys_group_name(ObIOModule module);
+// io of compaction, migration and backup, throttled when foreground io is slower than _io_latency_slo_target
+OB_INLINE bool is_background_io_module(const int64_t group_id)
+{
+  return SSTABLE_MACRO_BLOCK_WRITE_IO == group_id
+      || SSTABLE_INDEX_BUILDER_IO == group_id
+      || SSTABLE_WHOLE_SCANNER_IO == group_id
+      || HA_COPY_MACRO_BLOCK_IO == group_id
+      || HA_MACRO_BLOCK_WRITER_IO == group_id
+      || BACKUP_READER_IO == group_id;
+}
 struct ObIOFlag final
 {
 public:
@@ -491,6 +501,7 @@ public:
 public:
   int64_t memory_limit_;
   int64_t callback_thread_count_;
+  int64_t latency_slo_target_us_; // 0 means background io is never throttled
   int64_t group_num_;
   UnitConfig unit_config_;
   ObSEArray <int64_t , GROUP_START_NUM> group_ids_;
@@ -1086,6 +1086,11 @@ int ObTenantIOManager::update_basic_io_config(const ObTenantIOConfig &io_config)
       }
     }
     if (OB_FAIL(ret)) {
+    } else if (io_config_.latency_slo_target_us_ != io_config.latency_slo_target_us_) {
+      LOG_INFO("update io latency slo target", K(tenant_id_), K(io_config.latency_slo_target_us_), K(io_config_.latency_slo_target_us_));
+      ATOMIC_SET(&io_config_.latency_slo_target_us_, io_config.latency_slo_target_us_);
+    }
+    if (OB_FAIL(ret)) {
     } else if (io_config_.callback_thread_count_ != io_config.callback_thread_count_) {
       LOG_INFO("update io callback thread count", K(tenant_id_), K(io_config.callback_thread_count_), K(io_config_.callback_thread_count_));
       io_config_.callback_thread_count_ = io_config.callback_thread_count_;
@@ -1560,6 +1565,14 @@ uint64_t ObTenantIOManager::get_usage_index(const int64_t group_id)
   }
   return index;
 }
+void ObTenantIOManager::adjust_background_io_limit()
+{
+  if (is_working() && is_inited_) {
+    io_latency_controller_.adjust(ATOMIC_LOAD(&io_config_.latency_slo_target_us_));
+    io_clock_->set_background_iops_limit(io_latency_controller_.get_background_iops_limit());
+  }
+}
+
 void ObTenantIOManager::print_io_status()
 {
   if (is_working() && is_inited_) {
@@ -1655,6 +1668,10 @@ void ObTenantIOManager::print_io_status()
           "free_result_count", io_result_pool_.get_free_cnt(),
           "callback_queues", queue_count_array);
     }
+    if (INT64_MAX != io_latency_controller_.get_background_iops_limit()) {
+      LOG_INFO("[IO STATUS SLO]", K_(tenant_id), "latency_slo_target_us", io_config_.latency_slo_target_us_,
+          "latency_controller", io_latency_controller_);
+    }
     if (ATOMIC_LOAD(&io_config_.enable_io_tracer_)) {
       io_tracer_.print_status();
     }
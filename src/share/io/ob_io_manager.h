@@ -126,6 +126,7 @@ public:
   ObIOUsage &get_io_usage() { return io_usage_; }
   ObIOCallbackManager &get_callback_mgr() { return callback_mgr_; };
   ObSysIOUsage &get_backup_io_usage() { return io_backup_usage_; }
+  const ObIOLatencyController &get_latency_controller() const { return io_latency_controller_; }
   int update_basic_io_config(const ObTenantIOConfig &io_config);
   int try_alloc_req_until_timeout(const int64_t timeout_ts, ObIORequest *&req);
   int try_alloc_result_until_timeout(const int64_t timeout_ts, ObIOResult *&result);
@@ -169,6 +170,7 @@ public:
   uint64_t get_usage_index(const int64_t group_id);
   ObIOAllocator *get_tenant_io_allocator() { return &io_allocator_; }
   void print_io_status();
+  void adjust_background_io_limit();
   void inc_ref();
   void dec_ref();
   TO_STRING_KV(K(is_inited_), K(tenant_id_), K(ref_cnt_), K(io_memory_limit_), K(request_count_), K(result_count_),
@@ -191,6 +193,7 @@ private:
   ObIOCallbackManager callback_mgr_;
   ObIOUsage io_usage_;
   ObSysIOUsage io_backup_usage_; //for backup mock group
+  ObIOLatencyController io_latency_controller_;
   ObIOTracer io_tracer_;
   DRWLock io_config_lock_; //for map and config
   hash::ObHashMap<uint64_t, uint64_t> group_id_index_map_; //key:group_id, value:index
@@ -710,6 +710,105 @@ void ObSysIOUsage::get_io_usage(SysAvgItems &avg_iops, SysAvgItems &avg_bytes, S
   avg_rt_us.assign(group_avg_rt_us_);
 }
 
+/******************             IOLatencyController              **********************/
+ObIOLatencyController::ObIOLatencyController()
+  : background_cnt_(0),
+    last_adjust_ts_(ObTimeUtility::fast_current_time()),
+    foreground_cnt_(0),
+    foreground_p99_us_(0),
+    background_iops_(0),
+    background_iops_limit_(INT64_MAX),
+    target_us_(0)
+{
+  MEMSET(buckets_, 0, sizeof(buckets_));
+}
+
+ObIOLatencyController::~ObIOLatencyController()
+{
+
+}
+
+int64_t ObIOLatencyController::get_bucket_idx(const int64_t delay_us)
+{
+  int64_t idx = 0;
+  if (delay_us < SUB_BUCKET_CNT) {
+    idx = max(0L, delay_us);
+  } else {
+    const int64_t msb = 63 - __builtin_clzll(delay_us);
+    idx = (msb - SUB_BUCKET_BITS + 1) * SUB_BUCKET_CNT + ((delay_us >> (msb - SUB_BUCKET_BITS)) & (SUB_BUCKET_CNT - 1));
+    idx = min(idx, BUCKET_CNT - 1);
+  }
+  return idx;
+}
+
+int64_t ObIOLatencyController::get_bucket_upper_bound(const int64_t idx)
+{
+  int64_t upper_bound = idx;
+  if (idx >= SUB_BUCKET_CNT) {
+    const int64_t shift = idx / SUB_BUCKET_CNT - 1;
+    upper_bound = ((SUB_BUCKET_CNT + idx % SUB_BUCKET_CNT + 1) << shift) - 1;
+  }
+  return upper_bound;
+}
+
+void ObIOLatencyController::record_io(const int64_t group_id, const ObIORequest &request)
+{
+  if (ATOMIC_LOAD(&target_us_) <= 0) {
+    // disabled
+  } else if (is_background_io_module(group_id)) {
+    ATOMIC_INC(&background_cnt_);
+  } else if (request.time_log_.return_ts_ > 0) {
+    const int64_t device_delay = get_io_interval(request.time_log_.return_ts_, request.time_log_.submit_ts_);
+    ATOMIC_INC(&buckets_[get_bucket_idx(device_delay)]);
+  }
+}
+
+void ObIOLatencyController::adjust(const int64_t target_us)
+{
+  const int64_t current_ts = ObTimeUtility::fast_current_time();
+  const int64_t interval_us = max(1L, current_ts - last_adjust_ts_);
+  ATOMIC_STORE(&target_us_, target_us);
+  int64_t counts[BUCKET_CNT];
+  int64_t total_cnt = 0;
+  for (int64_t i = 0; i < BUCKET_CNT; ++i) {
+    counts[i] = ATOMIC_TAS(&buckets_[i], 0);
+    total_cnt += counts[i];
+  }
+  int64_t p99_us = 0;
+  const int64_t p99_rank = (total_cnt * 99 + 99) / 100;
+  for (int64_t i = 0, cnt = 0; i < BUCKET_CNT && cnt < p99_rank; ++i) {
+    cnt += counts[i];
+    p99_us = get_bucket_upper_bound(i);
+  }
+  last_adjust_ts_ = current_ts;
+  foreground_cnt_ = total_cnt;
+  foreground_p99_us_ = p99_us;
+  background_iops_ = ATOMIC_TAS(&background_cnt_, 0) * 1000L * 1000L / interval_us;
+
+  const int64_t old_limit = background_iops_limit_;
+  int64_t new_limit = old_limit;
+  if (target_us <= 0) {
+    new_limit = INT64_MAX;
+  } else if (total_cnt >= MIN_SAMPLE_CNT && p99_us > target_us) {
+    if (INT64_MAX != old_limit) {
+      new_limit = max(static_cast<int64_t>(MIN_BACKGROUND_IOPS), old_limit / 2);
+    } else if (background_iops_ > MIN_BACKGROUND_IOPS) {
+      new_limit = max(static_cast<int64_t>(MIN_BACKGROUND_IOPS), background_iops_ / 2);
+    }
+  } else if (INT64_MAX != old_limit && (total_cnt < MIN_SAMPLE_CNT || p99_us * 5 < target_us * 4)) {
+    new_limit = old_limit + max(static_cast<int64_t>(MIN_BACKGROUND_IOPS), old_limit / 4);
+    if (new_limit > background_iops_ * 2) {
+      // background io does not use up the limit
+      new_limit = INT64_MAX;
+    }
+  }
+  if (new_limit != old_limit) {
+    ATOMIC_STORE(&background_iops_limit_, new_limit);
+    LOG_INFO("[IO SLO] adjust background iops limit", K(target_us), K(p99_us), K(total_cnt),
+        K_(background_iops), K(old_limit), K(new_limit));
+  }
+}
+
 /******************             CpuUsage              **********************/
 ObCpuUsage::ObCpuUsage()
   : last_usage_(),
@@ -824,6 +923,7 @@ void ObIOTuner::run1()
       (void) try_release_thread();
       // print interval must <= 1s, for ensuring real_iops >= 1 in gv$ob_io_quota.
       if (REACH_TIME_INTERVAL(1000L * 1000L * 1L)) {
+        adjust_background_io_limit();
         print_io_status();
         print_sender_status();
         if (OB_FAIL(send_detect_task())) {
@@ -902,6 +1002,27 @@ void ObIOTuner::print_io_status()
   }
 }
 
+void ObIOTuner::adjust_background_io_limit()
+{
+  int ret = OB_SUCCESS;
+  ObArray<uint64_t> tenant_ids;
+  if (OB_FAIL(OB_IO_MANAGER.get_tenant_ids(tenant_ids))) {
+    LOG_WARN("get tenant id failed", K(ret));
+  } else {
+    for (int64_t i = 0; i < tenant_ids.count(); ++i) {
+      const uint64_t cur_tenant_id = tenant_ids.at(i);
+      ObRefHolder<ObTenantIOManager> tenant_holder;
+      if (OB_FAIL(OB_IO_MANAGER.get_tenant_io_manager(cur_tenant_id, tenant_holder))) {
+        if (OB_HASH_NOT_EXIST != ret) {
+          LOG_WARN("get tenant io manager failed", K(ret), K(cur_tenant_id));
+        }
+      } else {
+        tenant_holder.get_ptr()->adjust_background_io_limit();
+      }
+    }
+  }
+}
+
 /******************             ObIOGroupQueues              **********************/
 ObIOGroupQueues::ObIOGroupQueues(ObIAllocator &allocator)
   : is_inited_(false),
@@ -182,6 +182,44 @@ private:
   SysAvgItems group_avg_rt_us_;
 };
 
+// Throttles background io (see is_background_io_module) of a tenant to keep p99 device latency
+// of the other io under _io_latency_slo_target. Device latency of foreground io is collected into
+// a histogram with 4 buckets per power of two, and evaluated by io tuner every second: the limit of
+// background iops is halved while p99 exceeds the target, and raised by a quarter when p99 drops
+// under 80% of the target, until background io does not use up the limit any more. Nothing is
+// recorded while the target is 0.
+class ObIOLatencyController final
+{
+public:
+  ObIOLatencyController();
+  ~ObIOLatencyController();
+  void record_io(const int64_t group_id, const ObIORequest &request);
+  void adjust(const int64_t target_us);
+  // counted in requests regardless of size, INT64_MAX means unlimited
+  int64_t get_background_iops_limit() const { return ATOMIC_LOAD(&background_iops_limit_); }
+  int64_t get_foreground_p99_us() const { return foreground_p99_us_; }
+  TO_STRING_KV(K_(last_adjust_ts), K_(foreground_cnt), K_(foreground_p99_us), K_(background_iops),
+               K_(background_iops_limit), K_(target_us));
+private:
+  static int64_t get_bucket_idx(const int64_t delay_us);
+  static int64_t get_bucket_upper_bound(const int64_t idx);
+private:
+  static const int64_t SUB_BUCKET_BITS = 2;
+  static const int64_t SUB_BUCKET_CNT = 1L << SUB_BUCKET_BITS;
+  static const int64_t BUCKET_CNT = 40 * SUB_BUCKET_CNT;
+  static const int64_t MIN_SAMPLE_CNT = 64;
+  static const int64_t MIN_BACKGROUND_IOPS = 100;
+  int64_t buckets_[BUCKET_CNT];
+  int64_t background_cnt_;
+  int64_t last_adjust_ts_;
+  int64_t foreground_cnt_;
+  int64_t foreground_p99_us_;
+  int64_t background_iops_;
+  int64_t background_iops_limit_;
+  // target of the last adjust, 0 means disabled
+  int64_t target_us_;
+};
+
 class ObCpuUsage final
 {
 public:
@@ -209,6 +247,7 @@ private:
   void print_sender_status();
   int try_release_thread();
   void print_io_status();
+  void adjust_background_io_limit();
 private:
   bool is_inited_;
   ObCpuUsage cpu_usage_;
@@ -123,6 +123,13 @@ struct ObTableScanStatistic
   int64_t block_cache_hit_cnt_;
   int64_t block_cache_miss_cnt_;
   int64_t rowkey_prefix_;
+  //data micro blocks prefetched and times the reader waited for them
+  int64_t prefetch_micro_cnt_;
+  int64_t prefetch_wait_cnt_;
+  int64_t max_prefetch_depth_;
+  //ios reading adjacent micro blocks together and the micro blocks read
+  int64_t multi_block_io_cnt_;
+  int64_t multi_block_io_micro_cnt_;
   ObTableScanStatistic()
     : access_row_cnt_(0),
       out_row_cnt_(0),
@@ -135,7 +142,12 @@ struct ObTableScanStatistic
       row_cache_miss_cnt_(0),
       block_cache_hit_cnt_(0),
       block_cache_miss_cnt_(0),
-      rowkey_prefix_(0)
+      rowkey_prefix_(0),
+      prefetch_micro_cnt_(0),
+      prefetch_wait_cnt_(0),
+      max_prefetch_depth_(0),
+      multi_block_io_cnt_(0),
+      multi_block_io_micro_cnt_(0)
   {}
   OB_INLINE void reset()
   {
@@ -151,6 +163,11 @@ struct ObTableScanStatistic
     block_cache_hit_cnt_ = 0;
     block_cache_miss_cnt_ = 0;
     rowkey_prefix_ = 0;
+    prefetch_micro_cnt_ = 0;
+    prefetch_wait_cnt_ = 0;
+    max_prefetch_depth_ = 0;
+    multi_block_io_cnt_ = 0;
+    multi_block_io_micro_cnt_ = 0;
   }
   OB_INLINE void reset_cache_stat()
   {
@@ -162,6 +179,11 @@ struct ObTableScanStatistic
     row_cache_miss_cnt_ = 0;
     block_cache_hit_cnt_ = 0;
     block_cache_miss_cnt_ = 0;
+    prefetch_micro_cnt_ = 0;
+    prefetch_wait_cnt_ = 0;
+    max_prefetch_depth_ = 0;
+    multi_block_io_cnt_ = 0;
+    multi_block_io_micro_cnt_ = 0;
   }
   TO_STRING_KV(
       K_(access_row_cnt),
@@ -173,7 +195,12 @@ struct ObTableScanStatistic
       K_(row_cache_miss_cnt),
       K_(fuse_row_cache_hit_cnt),
       K_(fuse_row_cache_miss_cnt),
-      K_(rowkey_prefix));
+      K_(rowkey_prefix),
+      K_(prefetch_micro_cnt),
+      K_(prefetch_wait_cnt),
+      K_(max_prefetch_depth),
+      K_(multi_block_io_cnt),
+      K_(multi_block_io_micro_cnt));
 };
 
 static const int64_t OB_DEFAULT_FILTER_EXPR_COUNT = 4;
@@ -0,0 +1,381 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SHARE
+
+#include <poll.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "share/ob_io_uring.h"
+#include "share/ob_errno.h"
+#include "lib/time/ob_time_utility.h"
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+
+using namespace oceanbase::common;
+
+namespace oceanbase {
+namespace share {
+
+namespace
+{
+// values of include/uapi/linux/io_uring.h
+const int64_t IORING_OFF_SQ_RING = 0;
+const int64_t IORING_OFF_CQ_RING = 0x8000000;
+const int64_t IORING_OFF_SQES = 0x10000000;
+const uint32_t IORING_SETUP_SQPOLL = 1U << 1;
+const uint32_t IORING_FEAT_SINGLE_MMAP = 1U << 0;
+const uint32_t IORING_FEAT_RW_CUR_POS = 1U << 3;
+const uint32_t IORING_FEAT_SQPOLL_NONFIXED = 1U << 7;
+const uint32_t IORING_ENTER_SQ_WAKEUP = 1U << 1;
+const uint32_t IORING_SQ_NEED_WAKEUP = 1U << 0;
+const uint32_t IORING_REGISTER_FILES = 2;
+const uint8_t IORING_OP_READ = 22;
+const uint8_t IORING_OP_WRITE = 23;
+const uint8_t IOSQE_FIXED_FILE = 1U << 0;
+}
+
+STATIC_ASSERT(64 == sizeof(ObIOUring::SQE), "size of io_uring_sqe mismatch");
+STATIC_ASSERT(16 == sizeof(ObIOUring::CQE), "size of io_uring_cqe mismatch");
+STATIC_ASSERT(120 == sizeof(ObIOUring::Params), "size of io_uring_params mismatch");
+
+ObIOUring::ObIOUring()
+  : is_inited_(false),
+    is_sqpoll_(false),
+    ring_fd_(-1),
+    fixed_fd_(-1),
+    sq_entries_(0),
+    cq_entries_(0),
+    sq_ring_ptr_(nullptr),
+    sq_ring_size_(0),
+    sq_head_(nullptr),
+    sq_tail_(nullptr),
+    sq_mask_(nullptr),
+    sq_flags_(nullptr),
+    sq_array_(nullptr),
+    sqes_(nullptr),
+    sqes_size_(0),
+    cq_ring_ptr_(nullptr),
+    cq_ring_size_(0),
+    cq_head_(nullptr),
+    cq_tail_(nullptr),
+    cq_mask_(nullptr),
+    cqes_(nullptr),
+    submit_lock_()
+{
+}
+
+int ObIOUring::init(const uint32_t entries, const bool sqpoll, const int fixed_fd)
+{
+  int ret = OB_SUCCESS;
+  Params params;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("io uring init twice", K(ret));
+  } else if (OB_UNLIKELY(0 == entries)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(entries));
+  } else if (OB_FAIL(setup(entries, sqpoll, params))) {
+    LOG_WARN("fail to setup io uring", K(ret), K(entries), K(sqpoll));
+  } else if (0 == (params.features_ & IORING_FEAT_RW_CUR_POS)) {
+    // IORING_OP_READ/WRITE come with the same kernel version
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("io uring of this kernel is too old", K(ret), K(params.features_));
+  } else if (OB_FAIL(map_rings(params))) {
+    LOG_WARN("fail to map io uring", K(ret));
+  } else {
+    if (fixed_fd >= 0) {
+      int32_t fds[1] = { fixed_fd };
+      if (0 != ::syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_FILES, fds, 1)) {
+        LOG_INFO("fail to register fixed file, use normal fd", K(fixed_fd), K(errno));
+      } else {
+        fixed_fd_ = fixed_fd;
+      }
+    }
+    is_inited_ = true;
+    LOG_INFO("succ to init io uring", K(*this), K(params.features_));
+  }
+  if (OB_FAIL(ret)) {
+    destroy();
+  }
+  return ret;
+}
+
+int ObIOUring::setup(const uint32_t entries, const bool sqpoll, Params &params)
+{
+  int ret = OB_SUCCESS;
+  bool use_sqpoll = sqpoll;
+  ring_fd_ = -1;
+  while (OB_SUCC(ret) && ring_fd_ < 0) {
+    MEMSET(&params, 0, sizeof(params));
+    if (use_sqpoll) {
+      params.flags_ |= IORING_SETUP_SQPOLL;
+      params.sq_thread_idle_ = SQ_THREAD_IDLE_MS;
+    }
+    const int fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    if (fd >= 0) {
+      // without IORING_FEAT_SQPOLL_NONFIXED the sq thread only accepts registered files,
+      // which is not true for the normal files of local device.
+      if (use_sqpoll && 0 == (params.features_ & IORING_FEAT_SQPOLL_NONFIXED)) {
+        ::close(fd);
+        use_sqpoll = false;
+        LOG_INFO("sqpoll of io uring not supported for normal files, disable it");
+      } else {
+        ring_fd_ = fd;
+        is_sqpoll_ = use_sqpoll;
+      }
+    } else if (use_sqpoll) {
+      LOG_INFO("fail to setup io uring with sqpoll, disable it", K(errno));
+      use_sqpoll = false;
+    } else {
+      ret = (ENOSYS == errno) ? OB_NOT_SUPPORTED : OB_IO_ERROR;
+      LOG_WARN("fail to setup io uring", K(ret), K(entries), K(errno), KERRMSG);
+    }
+  }
+  return ret;
+}
+
+int ObIOUring::map_rings(const Params &params)
+{
+  int ret = OB_SUCCESS;
+  sq_entries_ = params.sq_entries_;
+  cq_entries_ = params.cq_entries_;
+  sq_ring_size_ = params.sq_off_.array_ + params.sq_entries_ * sizeof(uint32_t);
+  cq_ring_size_ = params.cq_off_.cqes_ + params.cq_entries_ * sizeof(CQE);
+  sqes_size_ = params.sq_entries_ * sizeof(SQE);
+  const bool single_mmap = 0 != (params.features_ & IORING_FEAT_SINGLE_MMAP);
+  if (single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+  void *ptr = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  if (MAP_FAILED == ptr) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to map sq ring", K(ret), K(errno), KERRMSG);
+  } else {
+    sq_ring_ptr_ = ptr;
+    if (single_mmap) {
+      cq_ring_ptr_ = sq_ring_ptr_;
+    } else if (MAP_FAILED == (ptr = ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                                           MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING))) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to map cq ring", K(ret), K(errno), KERRMSG);
+    } else {
+      cq_ring_ptr_ = ptr;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    if (MAP_FAILED == (ptr = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES))) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to map sqes", K(ret), K(errno), KERRMSG);
+    } else {
+      char *sq = static_cast<char *>(sq_ring_ptr_);
+      char *cq = static_cast<char *>(cq_ring_ptr_);
+      sqes_ = static_cast<SQE *>(ptr);
+      sq_head_ = reinterpret_cast<uint32_t *>(sq + params.sq_off_.head_);
+      sq_tail_ = reinterpret_cast<uint32_t *>(sq + params.sq_off_.tail_);
+      sq_mask_ = reinterpret_cast<uint32_t *>(sq + params.sq_off_.ring_mask_);
+      sq_flags_ = reinterpret_cast<uint32_t *>(sq + params.sq_off_.flags_);
+      sq_array_ = reinterpret_cast<uint32_t *>(sq + params.sq_off_.array_);
+      cq_head_ = reinterpret_cast<uint32_t *>(cq + params.cq_off_.head_);
+      cq_tail_ = reinterpret_cast<uint32_t *>(cq + params.cq_off_.tail_);
+      cq_mask_ = reinterpret_cast<uint32_t *>(cq + params.cq_off_.ring_mask_);
+      cqes_ = reinterpret_cast<CQE *>(cq + params.cq_off_.cqes_);
+    }
+  }
+  return ret;
+}
+
+void ObIOUring::destroy()
+{
+  if (nullptr != sqes_) {
+    ::munmap(sqes_, sqes_size_);
+  }
+  if (nullptr != cq_ring_ptr_ && cq_ring_ptr_ != sq_ring_ptr_) {
+    ::munmap(cq_ring_ptr_, cq_ring_size_);
+  }
+  if (nullptr != sq_ring_ptr_) {
+    ::munmap(sq_ring_ptr_, sq_ring_size_);
+  }
+  if (ring_fd_ >= 0) {
+    ::close(ring_fd_);
+  }
+  sqes_ = nullptr;
+  sq_ring_ptr_ = nullptr;
+  cq_ring_ptr_ = nullptr;
+  sq_head_ = sq_tail_ = sq_mask_ = sq_flags_ = sq_array_ = nullptr;
+  cq_head_ = cq_tail_ = cq_mask_ = nullptr;
+  cqes_ = nullptr;
+  ring_fd_ = -1;
+  fixed_fd_ = -1;
+  sq_entries_ = 0;
+  cq_entries_ = 0;
+  is_sqpoll_ = false;
+  is_inited_ = false;
+}
+
+int ObIOUring::enter(const uint32_t to_submit, const uint32_t min_complete, const uint32_t flags)
+{
+  int ret = OB_SUCCESS;
+  int sys_ret = 0;
+  while ((sys_ret = static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd_, to_submit,
+                                               min_complete, flags, nullptr, _NSIG / 8))) < 0
+         && EINTR == errno); // ignore EINTR
+  if (sys_ret < 0) {
+    ret = (EAGAIN == errno || EBUSY == errno) ? OB_EAGAIN : OB_IO_ERROR;
+    LOG_WARN("fail to enter io uring", K(ret), K(to_submit), K(flags), K(errno), KERRMSG);
+  } else if (OB_UNLIKELY(static_cast<uint32_t>(sys_ret) < to_submit)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("submitted less than expected", K(ret), K(sys_ret), K(to_submit));
+  }
+  return ret;
+}
+
+int ObIOUring::submit(struct iocb &cb)
+{
+  int ret = OB_SUCCESS;
+  uint8_t opcode = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("io uring not init", K(ret));
+  } else if (IO_CMD_PREAD == cb.aio_lio_opcode) {
+    opcode = IORING_OP_READ;
+  } else if (IO_CMD_PWRITE == cb.aio_lio_opcode) {
+    opcode = IORING_OP_WRITE;
+  } else {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("io command not supported by io uring", K(ret), K(cb.aio_lio_opcode));
+  }
+  if (OB_SUCC(ret)) {
+    lib::ObMutexGuard guard(submit_lock_);
+    const uint32_t tail = *sq_tail_;
+    if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+      ret = OB_EAGAIN;
+    } else {
+      const uint32_t idx = tail & *sq_mask_;
+      SQE &sqe = sqes_[idx];
+      MEMSET(&sqe, 0, sizeof(sqe));
+      sqe.opcode_ = opcode;
+      if (fixed_fd_ >= 0 && cb.aio_fildes == fixed_fd_) {
+        sqe.flags_ = IOSQE_FIXED_FILE;
+        sqe.fd_ = 0; // index in registered files
+      } else {
+        sqe.fd_ = cb.aio_fildes;
+      }
+      sqe.off_ = static_cast<uint64_t>(cb.u.c.offset);
+      sqe.addr_ = reinterpret_cast<uint64_t>(cb.u.c.buf);
+      sqe.len_ = static_cast<uint32_t>(cb.u.c.nbytes);
+      sqe.user_data_ = reinterpret_cast<uint64_t>(&cb);
+      sq_array_[idx] = idx;
+      __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+      if (is_sqpoll_) {
+        // the sq thread sets NEED_WAKEUP before going to sleep, the full barrier pairs
+        // with the one of kernel so a new tail is never missed.
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (0 != (__atomic_load_n(sq_flags_, __ATOMIC_RELAXED) & IORING_SQ_NEED_WAKEUP)) {
+          if (OB_FAIL(enter(0, 0, IORING_ENTER_SQ_WAKEUP))) {
+            LOG_WARN("fail to wake up sq thread", K(ret));
+          }
+        }
+      } else if (OB_FAIL(enter(1, 0, 0))) {
+        // nothing consumed by kernel on failure, take the sqe back
+        __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+        LOG_WARN("fail to submit to io uring", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int64_t ObIOUring::reap(const int64_t max_nr, struct io_event *events)
+{
+  int64_t cnt = 0;
+  uint32_t head = *cq_head_;
+  const uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  while (head != tail && cnt < max_nr) {
+    const CQE &cqe = cqes_[head & *cq_mask_];
+    struct iocb *cb = reinterpret_cast<struct iocb *>(cqe.user_data_);
+    struct io_event &event = events[cnt++];
+    event.data = cb->data;
+    event.obj = cb;
+    event.res = cqe.res_;
+    event.res2 = 0;
+    ++head;
+  }
+  if (cnt > 0) {
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  }
+  return cnt;
+}
+
+int ObIOUring::get_events(const int64_t min_nr,
+                          const int64_t max_nr,
+                          struct io_event *events,
+                          const struct timespec *timeout,
+                          int64_t &complete_cnt)
+{
+  int ret = OB_SUCCESS;
+  complete_cnt = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("io uring not init", K(ret));
+  } else if (OB_ISNULL(events) || OB_UNLIKELY(max_nr <= 0 || min_nr > max_nr)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(events), K(min_nr), K(max_nr));
+  } else {
+    complete_cnt = reap(max_nr, events);
+    // io_uring_enter can not wait with timeout before IORING_FEAT_EXT_ARG, poll the ring
+    // fd instead, which is readable once the completion ring is not empty.
+    // the timeout is for the whole call, not for each poll
+    const int64_t deadline_us = OB_ISNULL(timeout) ? INT64_MAX
+        : ObTimeUtility::current_time() + timeout->tv_sec * 1000000L + timeout->tv_nsec / 1000L;
+    bool timed_out = false;
+    while (OB_SUCC(ret) && complete_cnt < min_nr && !timed_out) {
+      struct pollfd pfd;
+      struct timespec remain_ts;
+      struct timespec *remain = nullptr;
+      pfd.fd = ring_fd_;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      if (OB_NOT_NULL(timeout)) {
+        const int64_t remain_us = MAX(0, deadline_us - ObTimeUtility::current_time());
+        remain_ts.tv_sec = remain_us / 1000000L;
+        remain_ts.tv_nsec = (remain_us % 1000000L) * 1000L;
+        remain = &remain_ts;
+      }
+      const int sys_ret = ::ppoll(&pfd, 1, remain, nullptr);
+      if (sys_ret < 0 && EINTR != errno) {
+        ret = OB_IO_ERROR;
+        LOG_WARN("fail to poll io uring", K(ret), K(errno), KERRMSG);
+      } else {
+        complete_cnt += reap(max_nr - complete_cnt, events + complete_cnt);
+        timed_out = (0 == sys_ret)
+            || (OB_NOT_NULL(timeout) && ObTimeUtility::current_time() >= deadline_us);
+      }
+    }
+  }
+  return ret;
+}
+
+} /* namespace share */
+} /* namespace oceanbase */
@@ -0,0 +1,150 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef SRC_SHARE_OB_IO_URING_H_
+#define SRC_SHARE_OB_IO_URING_H_
+
+#include <libaio.h>
+#include <time.h>
+#include "lib/lock/ob_mutex.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase {
+namespace share {
+
+// A minimal io_uring ring driven by raw syscalls, it accepts iocbs prepared by libaio
+// helpers and reaps completions as libaio io_events, so ObLocalDevice can switch engine
+// without touching the callers of ObIODevice. The kernel ABI structs are mirrored here
+// to not depend on the kernel headers of the build host.
+//
+// submit() may be called concurrently, get_events() must be called by a single thread.
+class ObIOUring
+{
+public:
+  ObIOUring();
+  ~ObIOUring() { destroy(); }
+  // %fixed_fd is registered as fixed file when it is valid, requests on it skip the
+  // fd lookup of kernel. SQPOLL is dropped if the kernel can not support it.
+  int init(const uint32_t entries, const bool sqpoll, const int fixed_fd);
+  void destroy();
+  int submit(struct iocb &cb);
+  // reap at most %max_nr completions into %events, wait until at least %min_nr are
+  // reaped or %timeout passed.
+  int get_events(const int64_t min_nr,
+                 const int64_t max_nr,
+                 struct io_event *events,
+                 const struct timespec *timeout,
+                 int64_t &complete_cnt);
+  bool is_sqpoll() const { return is_sqpoll_; }
+  TO_STRING_KV(K_(is_inited), K_(ring_fd), K_(sq_entries), K_(cq_entries), K_(fixed_fd),
+               K_(is_sqpoll));
+
+public:
+  struct SQE
+  {
+    uint8_t opcode_;
+    uint8_t flags_;
+    uint16_t ioprio_;
+    int32_t fd_;
+    uint64_t off_;
+    uint64_t addr_;
+    uint32_t len_;
+    uint32_t rw_flags_;
+    uint64_t user_data_;
+    uint16_t buf_index_;
+    uint16_t personality_;
+    int32_t splice_fd_in_;
+    uint64_t pad_[2];
+  };
+  struct CQE
+  {
+    uint64_t user_data_;
+    int32_t res_;
+    uint32_t flags_;
+  };
+  struct SQRingOffsets
+  {
+    uint32_t head_;
+    uint32_t tail_;
+    uint32_t ring_mask_;
+    uint32_t ring_entries_;
+    uint32_t flags_;
+    uint32_t dropped_;
+    uint32_t array_;
+    uint32_t resv1_;
+    uint64_t resv2_;
+  };
+  struct CQRingOffsets
+  {
+    uint32_t head_;
+    uint32_t tail_;
+    uint32_t ring_mask_;
+    uint32_t ring_entries_;
+    uint32_t overflow_;
+    uint32_t cqes_;
+    uint32_t flags_;
+    uint32_t resv1_;
+    uint64_t resv2_;
+  };
+  struct Params
+  {
+    uint32_t sq_entries_;
+    uint32_t cq_entries_;
+    uint32_t flags_;
+    uint32_t sq_thread_cpu_;
+    uint32_t sq_thread_idle_;
+    uint32_t features_;
+    uint32_t wq_fd_;
+    uint32_t resv_[3];
+    SQRingOffsets sq_off_;
+    CQRingOffsets cq_off_;
+  };
+  static const uint32_t SQ_THREAD_IDLE_MS = 10;
+
+private:
+  int setup(const uint32_t entries, const bool sqpoll, Params &params);
+  int map_rings(const Params &params);
+  int enter(const uint32_t to_submit, const uint32_t min_complete, const uint32_t flags);
+  int64_t reap(const int64_t max_nr, struct io_event *events);
+
+private:
+  bool is_inited_;
+  bool is_sqpoll_;
+  int ring_fd_;
+  int fixed_fd_;
+  uint32_t sq_entries_;
+  uint32_t cq_entries_;
+  // submission ring
+  void *sq_ring_ptr_;
+  int64_t sq_ring_size_;
+  uint32_t *sq_head_;
+  uint32_t *sq_tail_;
+  uint32_t *sq_mask_;
+  uint32_t *sq_flags_;
+  uint32_t *sq_array_;
+  SQE *sqes_;
+  int64_t sqes_size_;
+  // completion ring, shares the mapping of submission ring with IORING_FEAT_SINGLE_MMAP
+  void *cq_ring_ptr_;
+  int64_t cq_ring_size_;
+  uint32_t *cq_head_;
+  uint32_t *cq_tail_;
+  uint32_t *cq_mask_;
+  CQE *cqes_;
+  lib::ObMutex submit_lock_;
+  DISALLOW_COPY_AND_ASSIGN(ObIOUring);
+};
+
+} /* namespace share */
+} /* namespace oceanbase */
+
+#endif /* SRC_SHARE_OB_IO_URING_H_ */
@@ -93,7 +93,9 @@ ObLocalDevice::ObLocalDevice()
     block_bitmap_(nullptr),
     allocator_(),
     iocb_pool_(),
-    is_fs_support_punch_hole_(true)
+    is_fs_support_punch_hole_(true),
+    use_io_uring_(false),
+    io_uring_sqpoll_(false)
 {
 
   MEMSET(store_dir_, 0, sizeof(store_dir_));
@@ -142,6 +144,10 @@ int ObLocalDevice::init(const common::ObIODOpts &opts)
         datafile_size = opts.opts_[i].value_.value_int64;
       } else if (0 == STRCMP(opts.opts_[i].key_, "media_id")) {
         media_id = opts.opts_[i].value_.value_int64;
+      } else if (0 == STRCMP(opts.opts_[i].key_, "io_engine")) {
+        use_io_uring_ = (0 == STRCASECMP(opts.opts_[i].value_.value_str, "io_uring"));
+      } else if (0 == STRCMP(opts.opts_[i].key_, "io_uring_sqpoll")) {
+        io_uring_sqpoll_ = opts.opts_[i].value_.value_bool;
       } else {
         ret = OB_NOT_SUPPORTED;
         SHARE_LOG(WARN, "Not supported option, ", K(ret), K(i), K(opts.opts_[i].key_));
@@ -277,6 +283,8 @@ void ObLocalDevice::destroy()
   is_inited_ = false;
   is_marked_ = false;
   is_fs_support_punch_hole_ = true;
+  use_io_uring_ = false;
+  io_uring_sqpoll_ = false;
 
   MEMSET(store_dir_, 0, sizeof(store_dir_));
   MEMSET(sstable_dir_, 0, sizeof(sstable_dir_));
@@ -1039,10 +1047,30 @@ int ObLocalDevice::io_setup(
 {
   int ret = OB_SUCCESS;
   void *buf = nullptr;
+  bool use_io_uring = false;
 
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
     SHARE_LOG(WARN, "The ObLocalDevice has not been inited, ", K(ret));
+  } else if (use_io_uring_) {
+    ObLocalIOUringContext *uring_context = nullptr;
+    if (OB_ISNULL(buf = allocator_.alloc(sizeof(ObLocalIOUringContext)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      SHARE_LOG(WARN, "Fail to allocate memory, ", K(ret));
+    } else if (FALSE_IT(uring_context = new (buf) ObLocalIOUringContext())) {
+    } else if (OB_FAIL(uring_context->ring_.init(max_events, io_uring_sqpoll_, block_fd_ > 0 ? block_fd_ : -1))) {
+      SHARE_LOG(WARN, "Fail to setup io uring, fallback to libaio", K(ret), K(max_events));
+      uring_context->~ObLocalIOUringContext();
+      allocator_.free(buf);
+      buf = nullptr;
+      ret = OB_SUCCESS;
+    } else {
+      io_context = uring_context;
+      use_io_uring = true;
+    }
+  }
+
+  if (OB_FAIL(ret) || use_io_uring) {
   } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(ObLocalIOContext)))) {
     ret = OB_ALLOCATE_MEMORY_FAILED;
     SHARE_LOG(WARN, "Fail to allocate memory, ", K(ret));
@@ -1068,6 +1096,7 @@ int ObLocalDevice::io_destroy(common::ObIOContext *io_context)
 {
   int ret = OB_SUCCESS;
   ObLocalIOContext *local_io_context = nullptr;
+  ObLocalIOUringContext *uring_context = nullptr;
 
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
@@ -1075,6 +1104,9 @@ int ObLocalDevice::io_destroy(common::ObIOContext *io_context)
   } else if (OB_ISNULL(io_context)) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid argument, ", KP(io_context));
+  } else if (nullptr != (uring_context = dynamic_cast<ObLocalIOUringContext*> (io_context))) {
+    uring_context->~ObLocalIOUringContext();
+    allocator_.free(io_context);
   } else if (OB_ISNULL(local_io_context = dynamic_cast<ObLocalIOContext*> (io_context))) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid io context pointer, ", K(ret), KP(io_context));
@@ -1166,6 +1198,7 @@ int ObLocalDevice::io_submit(
   int ret = OB_SUCCESS;
   ObTimeGuard time_guard("LocalDevice", 5000); //5ms
   ObLocalIOContext *local_io_context = nullptr;
+  ObLocalIOUringContext *uring_context = nullptr;
   ObLocalIOCB *local_iocb = nullptr;
   struct iocb *iocbp = nullptr;
 
@@ -1178,6 +1211,11 @@ int ObLocalDevice::io_submit(
   } else if (OB_ISNULL(local_iocb = dynamic_cast<ObLocalIOCB*> (iocb))) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid iocb pointer, ", K(ret), KP(iocb));
+  } else if (nullptr != (uring_context = dynamic_cast<ObLocalIOUringContext*> (io_context))) {
+    if (OB_FAIL(uring_context->ring_.submit(local_iocb->iocb_))) {
+      SHARE_LOG(WARN, "Fail to submit io uring, ", K(ret));
+    }
+    time_guard.click("LocalDevice_submit");
   } else if (OB_ISNULL(local_io_context = dynamic_cast<ObLocalIOContext*> (io_context))) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid io context pointer, ", K(ret), KP(io_context));
@@ -1211,6 +1249,10 @@ int ObLocalDevice::io_cancel(
   } else if (OB_ISNULL(local_iocb = dynamic_cast<ObLocalIOCB*> (iocb))) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid iocb pointer, ", K(ret), KP(iocb));
+  } else if (nullptr != dynamic_cast<ObLocalIOUringContext*> (io_context)) {
+    // same as the kernels whose aio can not cancel, the request is reaped by io_getevents.
+    ret = OB_NOT_SUPPORTED;
+    SHARE_LOG(DEBUG, "io uring does not support cancel, ", K(ret));
   } else if (OB_ISNULL(local_io_context = dynamic_cast<ObLocalIOContext*> (io_context))) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid io context pointer, ", K(ret), KP(io_context));
@@ -1232,6 +1274,7 @@ int ObLocalDevice::io_getevents(
 {
   int ret = OB_SUCCESS;
   ObLocalIOContext *local_io_context = nullptr;
+  ObLocalIOUringContext *uring_context = nullptr;
   ObLocalIOEvents *local_io_events = nullptr;
 
   if (OB_UNLIKELY(!is_inited_)) {
@@ -1243,6 +1286,21 @@ int ObLocalDevice::io_getevents(
   } else if (OB_ISNULL(local_io_events = dynamic_cast<ObLocalIOEvents*> (events))) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid io events pointer, ", K(ret), KP(events));
+  } else if (nullptr != (uring_context = dynamic_cast<ObLocalIOUringContext*> (io_context))) {
+    int64_t complete_cnt = 0;
+    {
+      oceanbase::lib::Thread::WaitGuard guard(oceanbase::lib::Thread::WAIT_FOR_IO_EVENT);
+      ret = uring_context->ring_.get_events(min_nr,
+                                            local_io_events->max_event_cnt_,
+                                            local_io_events->io_events_,
+                                            timeout,
+                                            complete_cnt);
+    }
+    if (OB_FAIL(ret)) {
+      SHARE_LOG(WARN, "Fail to get io uring events, ", K(ret));
+    } else {
+      local_io_events->complete_io_cnt_ = complete_cnt;
+    }
   } else if (OB_ISNULL(local_io_context = dynamic_cast<ObLocalIOContext*> (io_context))) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid io context pointer, ", K(ret), KP(io_context));
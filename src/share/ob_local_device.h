@@ -16,6 +16,7 @@
 #include <libaio.h>
 #include "lib/allocator/ob_fifo_allocator.h"
 #include "common/storage/ob_io_device.h"
+#include "share/ob_io_uring.h"
 
 namespace oceanbase {
 namespace share {
@@ -42,6 +43,17 @@ private:
   io_context_t io_context_;
 };
 
+// io context of io_uring engine, iocbs are still prepared by libaio helpers.
+class ObLocalIOUringContext : public common::ObIOContext
+{
+public:
+  ObLocalIOUringContext() : ring_() {}
+  virtual ~ObLocalIOUringContext() {}
+private:
+  friend class ObLocalDevice;
+  ObIOUring ring_;
+};
+
 class ObLocalIOEvents : public common::ObIOEvents
 {
 public:
@@ -222,6 +234,9 @@ private:
   common::ObFIFOAllocator allocator_;
   ObIOCBPool<ObLocalIOCB> iocb_pool_;
   bool is_fs_support_punch_hole_;
+  // async io engine, libaio is used if io_uring is not supported by the kernel
+  bool use_io_uring_;
+  bool io_uring_sqpoll_;
 };
 
 OB_INLINE int64_t ObLocalDevice::get_block_file_offset(const common::ObIOFd &fd, const int64_t offset)
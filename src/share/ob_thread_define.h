@@ -69,6 +69,7 @@ TG_DEF(LineCache, LineCache, TIMER)
 TG_DEF(LocalityReload, LocalityReload, TIMER)
 TG_DEF(MemstoreGC, MemstoreGC, TIMER)
 TG_DEF(DiskUseReport, DiskUseReport, TIMER)
+TG_DEF(CacheWarmUp, CacheWarmUp, TIMER)
 TG_DEF(CLOGReqMinor, CLOGReqMinor, TIMER)
 TG_DEF(PGArchiveLog, PGArchiveLog, TIMER)
 TG_DEF(CKPTLogRep, CKPTLogRep, TIMER)
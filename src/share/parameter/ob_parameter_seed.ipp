@@ -446,6 +446,10 @@ DEF_BOOL(_force_hash_groupby_dump, OB_TENANT_PARAMETER, "False",
          "force hash groupby to dump"
          "Value:  True:turned on  False: turned off",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_external_table_read_ahead_window, OB_TENANT_PARAMETER, "2", "[0, 16]",
+        "the count of buffers read ahead asynchronously by an external table scan, "
+        "0 means reading synchronously. Range: [0, 16]",
+        ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(_force_hash_join_spill, OB_TENANT_PARAMETER, "False",
          "force hash join to dump after get all build hash table "
          "Value:  True:turned on  False: turned off",
@@ -473,6 +477,11 @@ DEF_INT(_temporary_file_meta_memory_limit_percentage, OB_TENANT_PARAMETER, "0",
         "The default value is 70. For compatibility, 0 is 70% of tenant memory."
         "Range: [0, 100], percentage",
         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR_WITH_CHECKER(_temporary_file_compress_func, OB_TENANT_PARAMETER, "none",
+                     common::ObConfigCompressFuncChecker,
+                     "compressor used for the blocks of temporary file written to disk, "
+                     "values: none, lz4_1.0, snappy_1.0, zstd_1.0, zstd_1.3.8",
+                     ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_storage_meta_memory_limit_percentage, OB_TENANT_PARAMETER, "20", "[0, 50)",
          "maximum memory for storage meta, as a percentage of total tenant memory. "
          "Range: [0, 50), percentage, 0 means no limit to storage meta memory",
@@ -883,9 +892,33 @@ DEF_INT(bf_cache_priority, OB_CLUSTER_PARAMETER, "1", "[1,)", "bf cache priority
         ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(bf_cache_miss_count_threshold, OB_CLUSTER_PARAMETER, "100", "[0,)", "bf cache miss count threshold, 0 means disable bf cache. Range:[0, )",
         ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_macro_block_xor_filter, OB_CLUSTER_PARAMETER, "True",
+        "specifies whether to build xor filters of rowkeys for data macro blocks written by compaction "
+        "and put them to bf cache. Value: True: enable; False: disable",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(fuse_row_cache_priority, OB_CLUSTER_PARAMETER, "1", "[1,)", "fuse row cache priority. Range:[1, )", ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(storage_meta_cache_priority, OB_CLUSTER_PARAMETER, "10", "[1,)", "storage meta cache priority. Range:[1, )",
         ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_kvcache_admission, OB_CLUSTER_PARAMETER, "False",
+        "specifies whether kvs of user block cache and user row cache not accessed recently are "
+        "put to probationary memory blocks which are washed first. "
+        "Value: True: enable; False: disable",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR(_micro_block_disk_cache_dir, OB_CLUSTER_PARAMETER, "",
+        "the directory on local disk of the second tier of user block cache, "
+        "which is disabled if empty",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_CAP(_micro_block_disk_cache_size, OB_CLUSTER_PARAMETER, "0M", "[0M,]",
+        "the file size of the second tier of user block cache on local disk, "
+        "0 means disabled. Range: [0M,]",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_TIME(_cache_warm_up_snapshot_interval, OB_CLUSTER_PARAMETER, "10m", "[0s,)",
+        "the interval to persist keys of hot micro blocks in user block cache and index block cache, "
+        "which are read back to the caches after restart. 0 means disabled. Range: [0s,)",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_CAP(_cache_warm_up_bandwidth, OB_CLUSTER_PARAMETER, "64M", "[1M,)",
+        "the disk bandwidth per second to read micro blocks back to caches after restart. Range: [1M,)",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 //background limit config
 DEF_TIME(_data_storage_io_timeout, OB_CLUSTER_PARAMETER, "10s", "[1s,600s]",
@@ -913,6 +946,20 @@ DEF_INT_WITH_CHECKER(disk_io_thread_count, OB_CLUSTER_PARAMETER, "8",
 DEF_INT(_io_callback_thread_count, OB_TENANT_PARAMETER, "0", "[0,64]",
         "The number of io callback threads. The default value is 0. Range: [0,64] in integer. If not specified, The number of threads is dynamically configured according to the memory size",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_TIME(_io_latency_slo_target, OB_TENANT_PARAMETER, "0ms", "[0ms,10s]",
+         "the target of p99 device latency of foreground io. Background io of compaction, migration "
+         "and backup is throttled while the latency exceeds the target. 0 means never throttled. "
+         "The default value is 0ms. Range: [0ms, 10s]",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR_WITH_CHECKER(_io_engine, OB_CLUSTER_PARAMETER, "libaio",
+                     common::ObConfigIOEngineChecker,
+                     "the engine of asynchronous io on local device, libaio is used if io_uring "
+                     "is not supported by the kernel. values: libaio, io_uring",
+                     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_BOOL(_io_uring_sqpoll, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether io_uring submits io by a kernel polling thread. The default value is False. "
+         "Value: True: turned on; False: turned off",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
 
 DEF_BOOL(_enable_parallel_minor_merge, OB_TENANT_PARAMETER, "True",
          "specifies whether enable parallel minor merge. "
@@ -69,6 +69,9 @@
 #include "sql/engine/set/ob_hash_union_op.h"
 #include "sql/engine/set/ob_hash_intersect_op.h"
 #include "sql/engine/set/ob_hash_except_op.h"
+#include "sql/engine/set/ob_hash_union_vec_op.h"
+#include "sql/engine/set/ob_hash_intersect_vec_op.h"
+#include "sql/engine/set/ob_hash_except_vec_op.h"
 #include "sql/engine/table/ob_table_scan_op.h"
 #include "sql/engine/aggregate/ob_hash_distinct_op.h"
 #include "sql/engine/aggregate/ob_merge_distinct_op.h"
@@ -103,6 +106,8 @@
 #include "sql/engine/aggregate/ob_merge_groupby_op.h"
 #include "sql/engine/aggregate/ob_hash_groupby_op.h"
 #include "sql/engine/join/ob_merge_join_op.h"
+#include "sql/engine/join/ob_merge_join_vec_op.h"
+#include "sql/engine/join/ob_nested_loop_join_vec_op.h"
 #include "sql/engine/basic/ob_topk_op.h"
 #include "sql/executor/ob_task_spliter.h"
 #include "sql/engine/dml/ob_table_delete_op.h"
@@ -115,6 +120,7 @@
 #include "sql/engine/dml/ob_table_insert_up_op.h"
 #include "sql/engine/dml/ob_table_replace_op.h"
 #include "sql/engine/window_function/ob_window_function_op.h"
+#include "sql/engine/window_function/ob_window_function_vec_op.h"
 #include "sql/engine/table/ob_row_sample_scan_op.h"
 #include "sql/engine/table/ob_block_sample_scan_op.h"
 #include "sql/engine/table/ob_table_scan_with_index_back_op.h"
@@ -151,6 +157,8 @@
 #include "sql/engine/px/p2p_datahub/ob_p2p_dh_mgr.h"
 #include "sql/engine/aggregate/ob_hash_distinct_vec_op.h"
 #include "sql/engine/aggregate/ob_scalar_aggregate_vec_op.h"
+#include "sql/engine/aggregate/ob_merge_distinct_vec_op.h"
+#include "sql/engine/aggregate/ob_merge_groupby_vec_op.h"
 #include "share/aggregate/processor.h"
 #include "share/vector/expr_cmp_func.h"
 #include "sql/engine/sort/ob_sort_vec_op.h"
@@ -1121,6 +1129,12 @@ int ObStaticEngineCG::generate_spec(
   return ret;
 }
 
+int ObStaticEngineCG::generate_spec(
+  ObLogDistinct &op, ObMergeDistinctVecSpec &spec, const bool in_root_job)
+{
+  return generate_spec(op, static_cast<ObMergeDistinctSpec &>(spec), in_root_job);
+}
+
 void ObStaticEngineCG::set_murmur_hash_func(
      ObHashFunc &hash_func, const ObExprBasicFuncs *basic_funcs_)
 {
@@ -1513,6 +1527,37 @@ int ObStaticEngineCG::generate_spec(ObLogSet &op, ObHashExceptSpec &spec, const
   return ret;
 }
 
+int ObStaticEngineCG::generate_spec(ObLogSet &op, ObHashUnionVecSpec &spec, const bool in_root_job)
+{
+  int ret = OB_SUCCESS;
+  UNUSED(in_root_job);
+  if (OB_FAIL(generate_hash_set_spec(op, spec))) {
+    LOG_WARN("failed to generate spec set", K(ret));
+  }
+  return ret;
+}
+
+int ObStaticEngineCG::generate_spec(
+  ObLogSet &op, ObHashIntersectVecSpec &spec, const bool in_root_job)
+{
+  int ret = OB_SUCCESS;
+  UNUSED(in_root_job);
+  if (OB_FAIL(generate_hash_set_spec(op, spec))) {
+    LOG_WARN("failed to generate spec set", K(ret));
+  }
+  return ret;
+}
+
+int ObStaticEngineCG::generate_spec(ObLogSet &op, ObHashExceptVecSpec &spec, const bool in_root_job)
+{
+  int ret = OB_SUCCESS;
+  UNUSED(in_root_job);
+  if (OB_FAIL(generate_hash_set_spec(op, spec))) {
+    LOG_WARN("failed to generate spec set", K(ret));
+  }
+  return ret;
+}
+
 int ObStaticEngineCG::generate_hash_set_spec(ObLogSet &op, ObHashSetSpec &spec)
 {
   int ret = OB_SUCCESS;
@@ -4440,6 +4485,12 @@ int ObStaticEngineCG::generate_spec(ObLogGroupBy &op, ObMergeGroupBySpec &spec,
   return ret;
 }
 
+int ObStaticEngineCG::generate_spec(ObLogGroupBy &op, ObMergeGroupByVecSpec &spec,
+    const bool in_root_job)
+{
+  return generate_spec(op, static_cast<ObMergeGroupBySpec &>(spec), in_root_job);
+}
+
 int ObStaticEngineCG::set_3stage_info(ObLogGroupBy &op, ObGroupBySpec &spec)
 {
   int ret = OB_SUCCESS;
@@ -5376,6 +5427,31 @@ int ObStaticEngineCG::generate_spec(ObLogJoin &op,
   UNUSED(in_root_job);
   return generate_join_spec(op, spec);
 }
+int ObStaticEngineCG::generate_spec(ObLogJoin &op,
+                                    ObNestedLoopJoinVecSpec &spec,
+                                    const bool in_root_job)
+{
+  int ret = OB_SUCCESS;
+  UNUSED(in_root_job);
+  if (op.is_partition_wise()) {
+    phy_plan_->set_is_wise_join(op.is_partition_wise()); // set is_wise_join
+  }
+  const ObIArray<ObRawExpr*> &other_join_conds = op.get_other_join_conditions();
+  OZ(spec.other_join_conds_.init(other_join_conds.count()));
+  OZ(generate_rt_exprs(other_join_conds, spec.other_join_conds_));
+  spec.join_type_ = op.get_join_type();
+  if (OB_FAIL(ret)) {
+  } else if (OB_UNLIKELY(0 != op.get_equal_join_conditions().count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("equal join conditions' count should equal 0", K(ret));
+  } else if (OB_FAIL(generate_param_spec(op.get_nl_params(), spec.rescan_params_))) {
+    LOG_WARN("generate rescan params failed", K(ret));
+  } else if (OB_FAIL(set_batch_exec_param(op.get_nl_params(), spec.rescan_params_))) {
+    // params of multi level group rescan NLJ below
+    LOG_WARN("fail to set batch exec param", K(ret));
+  }
+  return ret;
+}
 int ObStaticEngineCG::generate_spec(ObLogJoin &op,
                                     ObMergeJoinSpec &spec,
                                     const bool in_root_job)
@@ -5383,6 +5459,114 @@ int ObStaticEngineCG::generate_spec(ObLogJoin &op,
   UNUSED(in_root_job);
   return generate_join_spec(op, spec);
 }
+int ObStaticEngineCG::generate_spec(ObLogJoin &op,
+                                    ObMergeJoinVecSpec &spec,
+                                    const bool in_root_job)
+{
+  int ret = OB_SUCCESS;
+  UNUSED(in_root_job);
+  bool left_unique = false;
+  if (op.is_partition_wise()) {
+    phy_plan_->set_is_wise_join(op.is_partition_wise()); // set is_wise_join
+  }
+  const ObIArray<ObRawExpr*> &other_join_conds = op.get_other_join_conditions();
+  OZ(spec.other_join_conds_.init(other_join_conds.count()));
+  OZ(generate_rt_exprs(other_join_conds, spec.other_join_conds_));
+  spec.join_type_ = op.get_join_type();
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(generate_merge_join_conds(op, spec))) {
+    LOG_WARN("failed to generate merge join conditions", K(ret));
+  } else if (OB_FAIL(spec.set_merge_directions(op.get_merge_directions()))) {
+    LOG_WARN("fail to set merge directions", K(ret));
+  } else if (OB_FAIL(op.is_left_unique(left_unique))) {
+    LOG_WARN("fail to check left unique", K(ret), K(op));
+  } else {
+    spec.is_left_unique_ = left_unique;
+  }
+  return ret;
+}
+
+template <typename MergeJoinSpecType>
+int ObStaticEngineCG::generate_merge_join_conds(ObLogJoin &op, MergeJoinSpecType &spec)
+{
+  int ret = OB_SUCCESS;
+  const ObOpSpec *left = spec.get_left();
+  const ObOpSpec *right = spec.get_right();
+  ObFixedArray<ObMergeJoinSpec::EqualConditionInfo, ObIAllocator> &equal_cond_infos =
+      spec.equal_cond_infos_;
+  ExprFixedArray &left_all_exprs = spec.left_child_fetcher_all_exprs_;
+  ExprFixedArray &right_all_exprs = spec.right_child_fetcher_all_exprs_;
+  const ObIArray<ObRawExpr*> &equal_join_conds = op.get_equal_join_conditions();
+  OZ(equal_cond_infos.init(equal_join_conds.count()));
+  if (OB_ISNULL(left)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("left is null", K(ret));
+  } else if (OB_ISNULL(right)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("right is null", K(ret));
+  } else if (OB_FAIL(left_all_exprs.init(left->output_.count() + equal_join_conds.count()))) {
+    LOG_WARN("failed to init left fetcher all exprs", K(ret));
+  } else if (OB_FAIL(right_all_exprs.init(right->output_.count() + equal_join_conds.count()))) {
+    LOG_WARN("failed to init right fetcher all exprs", K(ret));
+  } else if (OB_FAIL(append_array_no_dup(left_all_exprs, left->output_))) {
+    LOG_WARN("fail to append array no dup for left child", K(ret), K(op));
+  } else if (OB_FAIL(append_array_no_dup(right_all_exprs, right->output_))) {
+    LOG_WARN("fail to append array no dup for right child", K(ret), K(op));
+  }
+  ARRAY_FOREACH(equal_join_conds, i) {
+    ObMergeJoinSpec::EqualConditionInfo equal_cond_info;
+    ObRawExpr *raw_expr = equal_join_conds.at(i);
+    CK(OB_NOT_NULL(raw_expr));
+    CK(T_OP_EQ == raw_expr->get_expr_type() || T_OP_NSEQ == raw_expr->get_expr_type());
+    OZ(generate_rt_expr(*raw_expr, equal_cond_info.expr_));
+    CK(OB_NOT_NULL(equal_cond_info.expr_));
+    CK(equal_cond_info.expr_->arg_cnt_ == 2)
+    CK(OB_NOT_NULL(equal_cond_info.expr_->args_));
+    CK(OB_NOT_NULL(equal_cond_info.expr_->args_[0]));
+    CK(OB_NOT_NULL(equal_cond_info.expr_->args_[1]));
+    if (OB_SUCC(ret)){
+      ObDatumMeta &l = equal_cond_info.expr_->args_[0]->datum_meta_;
+      ObDatumMeta &r = equal_cond_info.expr_->args_[1]->datum_meta_;
+      bool has_lob_header = equal_cond_info.expr_->args_[0]->obj_meta_.has_lob_header() ||
+                            equal_cond_info.expr_->args_[1]->obj_meta_.has_lob_header();
+      CK(l.cs_type_ == r.cs_type_);
+      if (OB_SUCC(ret)) {
+        const ObScale scale = ObDatumFuncs::max_scale(l.scale_, r.scale_);
+        OZ(calc_equal_cond_opposite(op, *raw_expr, equal_cond_info.is_opposite_));
+        if (OB_SUCC(ret)) {
+          if (equal_cond_info.is_opposite_) {
+            equal_cond_info.ns_cmp_func_ = ObDatumFuncs::get_nullsafe_cmp_func(r.type_,
+                              l.type_, default_null_pos(), r.cs_type_, scale, is_oracle_mode(),
+                              has_lob_header, l.precision_, r.precision_);
+          } else {
+            equal_cond_info.ns_cmp_func_ = ObDatumFuncs::get_nullsafe_cmp_func(l.type_,
+                              r.type_, default_null_pos(), l.cs_type_, scale, is_oracle_mode(),
+                              has_lob_header, l.precision_, r.precision_);
+          }
+        }
+        CK(OB_NOT_NULL(equal_cond_info.ns_cmp_func_));
+        OZ(equal_cond_infos.push_back(equal_cond_info));
+        // when is_opposite_ is true: left child fetcher accept right
+        // arg(args_[1]) and vice versa
+        if (OB_SUCC(ret) && OB_FAIL(add_var_to_array_no_dup(left_all_exprs,
+            !equal_cond_info.is_opposite_ ? equal_cond_info.expr_->args_[0]
+                                         : equal_cond_info.expr_->args_[1]))) {
+          OB_LOG(WARN, "fail to add_var_to_array_no_dup",  K(ret));
+        } else if (OB_SUCC(ret) && OB_FAIL(add_var_to_array_no_dup(right_all_exprs,
+            !equal_cond_info.is_opposite_ ? equal_cond_info.expr_->args_[1]
+                                         : equal_cond_info.expr_->args_[0]))) {
+          OB_LOG(WARN, "fail to add_var_to_array_no_dup", K(ret));
+        }
+        LOG_DEBUG("equijoin condition", K(*raw_expr), K(equal_cond_info),
+                 K(equal_cond_info.is_opposite_),
+                 KPC(equal_cond_info.expr_->args_[0]),
+                 KPC(equal_cond_info.expr_->args_[1]));
+      }
+    }
+  } // end for
+  return ret;
+}
+
 int ObStaticEngineCG::generate_join_spec(ObLogJoin &op, ObJoinSpec &spec)
 {
   int ret = OB_SUCCESS;
@@ -5424,82 +5608,10 @@ int ObStaticEngineCG::generate_join_spec(ObLogJoin &op, ObJoinSpec &spec)
   if (MERGE_JOIN == op.get_join_algo()) {
     //A.1. add equaljoin conditions and populate all exprs for left/right child fetcher
     ObMergeJoinSpec &mj_spec = static_cast<ObMergeJoinSpec &>(spec);
-    const ObIArray<ObRawExpr*> &equal_join_conds = op.get_equal_join_conditions();
-    OZ(mj_spec.equal_cond_infos_.init(equal_join_conds.count()));
-    if (OB_ISNULL(mj_spec.get_left())) {
-      ret = OB_ERR_UNEXPECTED;
-      LOG_WARN("left is null", K(ret));
-    } else if (OB_ISNULL(mj_spec.get_right())) {
-      ret = OB_ERR_UNEXPECTED;
-      LOG_WARN("right is null", K(ret));
-    } else if (OB_FAIL(mj_spec.left_child_fetcher_all_exprs_.init(
-                 mj_spec.get_left()->output_.count() +
-                 equal_join_conds.count()))) {
-      LOG_WARN("failed to init left fetcher all exprs", K(ret));
-    } else if (OB_FAIL(mj_spec.right_child_fetcher_all_exprs_.init(
-                 mj_spec.get_right()->output_.count() +
-                 equal_join_conds.count()))) {
-      LOG_WARN("failed to init right fetcher all exprs", K(ret));
-    } else if (OB_FAIL(
-                  append_array_no_dup(mj_spec.left_child_fetcher_all_exprs_,
-                                       mj_spec.get_left()->output_))) {
-      LOG_WARN("fail to append array no dup for left child", K(ret), K(op));
-    } else if (OB_FAIL(
-                  append_array_no_dup(mj_spec.right_child_fetcher_all_exprs_,
-                                       mj_spec.get_right()->output_))) {
-      LOG_WARN("fail to append array no dup for right child", K(ret), K(op));
-    }
-    ARRAY_FOREACH(equal_join_conds, i) {
-      ObMergeJoinSpec::EqualConditionInfo equal_cond_info;
-      ObRawExpr *raw_expr = equal_join_conds.at(i);
-      CK(OB_NOT_NULL(raw_expr));
-      CK(T_OP_EQ == raw_expr->get_expr_type() || T_OP_NSEQ == raw_expr->get_expr_type());
-      OZ(generate_rt_expr(*raw_expr, equal_cond_info.expr_));
-      CK(OB_NOT_NULL(equal_cond_info.expr_));
-      CK(equal_cond_info.expr_->arg_cnt_ == 2)
-      CK(OB_NOT_NULL(equal_cond_info.expr_->args_));
-      CK(OB_NOT_NULL(equal_cond_info.expr_->args_[0]));
-      CK(OB_NOT_NULL(equal_cond_info.expr_->args_[1]));
-      if (OB_SUCC(ret)){
-        ObDatumMeta &l = equal_cond_info.expr_->args_[0]->datum_meta_;
-        ObDatumMeta &r = equal_cond_info.expr_->args_[1]->datum_meta_;
-        bool has_lob_header = equal_cond_info.expr_->args_[0]->obj_meta_.has_lob_header() ||
-                              equal_cond_info.expr_->args_[1]->obj_meta_.has_lob_header();
-        CK(l.cs_type_ == r.cs_type_);
-        if (OB_SUCC(ret)) {
-          const ObScale scale = ObDatumFuncs::max_scale(l.scale_, r.scale_);
-          OZ(calc_equal_cond_opposite(op, *raw_expr, equal_cond_info.is_opposite_));
-          if (OB_SUCC(ret)) {
-            if (equal_cond_info.is_opposite_) {
-              equal_cond_info.ns_cmp_func_ = ObDatumFuncs::get_nullsafe_cmp_func(r.type_,
-                                l.type_, default_null_pos(), r.cs_type_, scale, is_oracle_mode(),
-                                has_lob_header, l.precision_, r.precision_);
-            } else {
-              equal_cond_info.ns_cmp_func_ = ObDatumFuncs::get_nullsafe_cmp_func(l.type_,
-                                r.type_, default_null_pos(), l.cs_type_, scale, is_oracle_mode(),
-                                has_lob_header, l.precision_, r.precision_);
-            }
-          }
-          CK(OB_NOT_NULL(equal_cond_info.ns_cmp_func_));
-          OZ(mj_spec.equal_cond_infos_.push_back(equal_cond_info));
-          // when is_opposite_ is true: left child fetcher accept right
-          // arg(args_[1]) and vice versa
-          if (OB_SUCC(ret) && OB_FAIL(add_var_to_array_no_dup(mj_spec.left_child_fetcher_all_exprs_,
-              !equal_cond_info.is_opposite_ ? equal_cond_info.expr_->args_[0]
-                                           : equal_cond_info.expr_->args_[1]))) {
-            OB_LOG(WARN, "fail to add_var_to_array_no_dup",  K(ret));
-          } else if (OB_SUCC(ret) && OB_FAIL(add_var_to_array_no_dup(mj_spec.right_child_fetcher_all_exprs_,
-              !equal_cond_info.is_opposite_ ? equal_cond_info.expr_->args_[1]
-                                           : equal_cond_info.expr_->args_[0]))) {
-            OB_LOG(WARN, "fail to add_var_to_array_no_dup", K(ret));
-          }
-          LOG_DEBUG("equijoin condition", K(*raw_expr), K(equal_cond_info),
-                   K(equal_cond_info.is_opposite_),
-                   KPC(equal_cond_info.expr_->args_[0]),
-                   KPC(equal_cond_info.expr_->args_[1]));
-        }
-      }
-    } // end for
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(generate_merge_join_conds(op, mj_spec))) {
+      LOG_WARN("failed to generate merge join conditions", K(ret));
+    }
     // A.2. add merge directions
     if (OB_SUCC(ret)) {
       const ObIArray<ObOrderDirection> &merge_directions = op.get_merge_directions();
@@ -6969,6 +7081,35 @@ int ObStaticEngineCG::generate_spec(ObLogWindowFunction &op, ObWindowFunctionSpe
   return ret;
 }
 
+int ObStaticEngineCG::generate_spec(ObLogWindowFunction &op, ObWindowFunctionVecSpec &spec,
+    const bool in_root_job)
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<ObExpr *, 16> all_expr;
+  if (OB_FAIL(generate_spec(op, static_cast<ObWindowFunctionSpec &>(spec), in_root_job))) {
+    LOG_WARN("generate window function spec failed", K(ret));
+  } else if (OB_FAIL(append(all_expr, spec.all_expr_))) {
+    LOG_WARN("failed to append", K(ret));
+  } else {
+    // partition by exprs and aggregate params are read from the stored rows directly
+    for (int64_t i = 0; OB_SUCC(ret) && i < spec.wf_infos_.count(); i++) {
+      const WinFuncInfo &wf_info = spec.wf_infos_.at(i);
+      if (OB_FAIL(append_array_no_dup(all_expr, wf_info.partition_exprs_))) {
+        LOG_WARN("failed to append", K(ret));
+      } else if (OB_FAIL(append_array_no_dup(all_expr, wf_info.aggr_info_.param_exprs_))) {
+        LOG_WARN("failed to append", K(ret));
+      }
+    }
+    if (OB_SUCC(ret) && all_expr.count() != spec.all_expr_.count()) {
+      spec.all_expr_.reset();
+      if (OB_FAIL(spec.all_expr_.assign(all_expr))) {
+        LOG_WARN("failed to assign", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObStaticEngineCG::fill_wf_info(ObIArray<ObExpr *> &all_expr,
     ObWinFunRawExpr &win_expr, WinFuncInfo &wf_info, const bool can_push_down)
 {
@@ -8021,6 +8162,18 @@ int ObStaticEngineCG::get_phy_op_type(ObLogicalOperator &log_op,
             type = PHY_VEC_SCALAR_AGGREGATE;
           } else {
             type = PHY_MERGE_GROUP_BY;
+            tmp_ret = OB_E(EventTable::EN_DISABLE_VEC_MERGE_GROUP_BY) OB_SUCCESS;
+            // rollup, three stage aggregation and distinct aggregation are not supported
+            // by vectorized merge group by
+            if (OB_SUCCESS == tmp_ret && use_rich_format && !op.is_pushdown_scalar_aggr()
+                && !op.has_rollup()
+                && ObThreeStageAggrStage::NONE_STAGE == op.get_aggr_stage()
+                && op.get_distinct_exprs().empty()
+                && !op.get_group_by_exprs().empty()
+                && aggregate::Processor::all_supported_aggregate_functions(
+                  static_cast<ObLogGroupBy *>(&log_op)->get_aggr_funcs())) {
+              type = PHY_VEC_MERGE_GROUP_BY;
+            }
           }
           break;
         }
@@ -8092,15 +8245,39 @@ int ObStaticEngineCG::get_phy_op_type(ObLogicalOperator &log_op,
       auto &op = static_cast<ObLogJoin&>(log_op);
       switch(op.get_join_algo()) {
         case NESTED_LOOP_JOIN: {
-          type = CONNECT_BY_JOIN != op.get_join_type()
-             ? PHY_NESTED_LOOP_JOIN
-             : (op.get_nl_params().count() > 0
-                  ? PHY_NESTED_LOOP_CONNECT_BY_WITH_INDEX
-                  : PHY_NESTED_LOOP_CONNECT_BY);
+          int tmp_ret = OB_SUCCESS;
+          tmp_ret = OB_E(EventTable::EN_DISABLE_VEC_NESTED_LOOP_JOIN) OB_SUCCESS;
+          if (CONNECT_BY_JOIN == op.get_join_type()) {
+            type = op.get_nl_params().count() > 0
+                ? PHY_NESTED_LOOP_CONNECT_BY_WITH_INDEX
+                : PHY_NESTED_LOOP_CONNECT_BY;
+          } else if (OB_SUCCESS == tmp_ret && use_rich_format
+                     && op.can_use_batch_nlj()
+                     && !op.enable_px_batch_rescan()
+                     && !op.is_enable_gi_partition_pruning()
+                     && op.get_above_pushdown_left_params().empty()
+                     && op.get_above_pushdown_right_params().empty()
+                     && (INNER_JOIN == op.get_join_type()
+                         || LEFT_OUTER_JOIN == op.get_join_type()
+                         || LEFT_SEMI_JOIN == op.get_join_type()
+                         || LEFT_ANTI_JOIN == op.get_join_type())) {
+            // vectorized NLJ always do group rescan, multi level group rescan is not supported
+            type = PHY_VEC_NESTED_LOOP_JOIN;
+          } else {
+            type = PHY_NESTED_LOOP_JOIN;
+          }
           break;
         }
         case MERGE_JOIN: {
-          type = PHY_MERGE_JOIN;
+          int tmp_ret = OB_SUCCESS;
+          // ObMergeJoinVecOp can not dump the equal key groups yet, it is only
+          // generated when enabled explicitly.
+          tmp_ret = OB_E(EventTable::EN_ENABLE_VEC_MERGE_JOIN) OB_SUCCESS;
+          if (OB_SUCCESS != tmp_ret && use_rich_format) {
+            type = PHY_VEC_MERGE_JOIN;
+          } else {
+            type = PHY_MERGE_JOIN;
+          }
           break;
         }
         case HASH_JOIN: {
@@ -8185,7 +8362,13 @@ int ObStaticEngineCG::get_phy_op_type(ObLogicalOperator &log_op,
     case log_op_def::LOG_DISTINCT: {
       auto &op = static_cast<ObLogDistinct&>(log_op);
       if (MERGE_AGGREGATE == op.get_algo()) {
-        type = PHY_MERGE_DISTINCT;
+        int tmp_ret = OB_SUCCESS;
+        tmp_ret = OB_E(EventTable::EN_DISABLE_VEC_MERGE_DISTINCT) OB_SUCCESS;
+        if (OB_SUCCESS == tmp_ret && use_rich_format) {
+          type = PHY_VEC_MERGE_DISTINCT;
+        } else {
+          type = PHY_MERGE_DISTINCT;
+        }
       } else if (HASH_AGGREGATE == op.get_algo()) {
         int tmp_ret = OB_SUCCESS;
         tmp_ret = OB_E(EventTable::EN_DISABLE_VEC_HASH_DISTINCT) OB_SUCCESS;
@@ -8260,19 +8443,32 @@ int ObStaticEngineCG::get_phy_op_type(ObLogicalOperator &log_op,
     }
     case log_op_def::LOG_SET: {
       auto &op = static_cast<ObLogSet&>(log_op);
+      int tmp_ret = OB_SUCCESS;
+      tmp_ret = OB_E(EventTable::EN_DISABLE_VEC_HASH_SET_OP) OB_SUCCESS;
+      const bool use_vec_hash_set = (OB_SUCCESS == tmp_ret && use_rich_format);
       switch (op.get_set_op()) {
         case ObSelectStmt::UNION:
           if (op.is_recursive_union()) {
             type = PHY_RECURSIVE_UNION_ALL;
+          } else if (MERGE_SET == op.get_algo()) {
+            type = PHY_MERGE_UNION;
           } else {
-            type = (MERGE_SET == op.get_algo() ? PHY_MERGE_UNION : PHY_HASH_UNION);
+            type = use_vec_hash_set ? PHY_VEC_HASH_UNION : PHY_HASH_UNION;
           }
           break;
         case ObSelectStmt::INTERSECT:
-          type = (MERGE_SET == op.get_algo() ? PHY_MERGE_INTERSECT : PHY_HASH_INTERSECT);
+          if (MERGE_SET == op.get_algo()) {
+            type = PHY_MERGE_INTERSECT;
+          } else {
+            type = use_vec_hash_set ? PHY_VEC_HASH_INTERSECT : PHY_HASH_INTERSECT;
+          }
           break;
         case ObSelectStmt::EXCEPT:
-          type = (MERGE_SET == op.get_algo() ? PHY_MERGE_EXCEPT : PHY_HASH_EXCEPT);
+          if (MERGE_SET == op.get_algo()) {
+            type = PHY_MERGE_EXCEPT;
+          } else {
+            type = use_vec_hash_set ? PHY_VEC_HASH_EXCEPT : PHY_HASH_EXCEPT;
+          }
           break;
         default:
           break;
@@ -8296,7 +8492,20 @@ int ObStaticEngineCG::get_phy_op_type(ObLogicalOperator &log_op,
       break;
     }
     case log_op_def::LOG_WINDOW_FUNCTION: {
-      type = PHY_WINDOW_FUNCTION;
+      auto &op = static_cast<ObLogWindowFunction&>(log_op);
+      int tmp_ret = OB_SUCCESS;
+      // ObWindowFunctionVecOp can not dump the buffered partition yet, it is only
+      // generated when enabled explicitly.
+      tmp_ret = OB_E(EventTable::EN_ENABLE_VEC_WINDOW_FUNCTION) OB_SUCCESS;
+      if (OB_SUCCESS != tmp_ret && use_rich_format
+          && ObLogWindowFunction::WindowFunctionRoleType::NORMAL == op.get_role_type()
+          && !op.is_range_dist_parallel()
+          && !op.is_single_part_parallel()
+          && ObWindowFunctionVecOp::all_supported_window_functions(op.get_window_exprs())) {
+        type = PHY_VEC_WINDOW_FUNCTION;
+      } else {
+        type = PHY_WINDOW_FUNCTION;
+      }
       break;
     }
     case log_op_def::LOG_SELECT_INTO: {
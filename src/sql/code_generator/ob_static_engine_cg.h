@@ -43,6 +43,9 @@ class ObHashSetSpec;
 class ObHashUnionSpec;
 class ObHashIntersectSpec;
 class ObHashExceptSpec;
+class ObHashUnionVecSpec;
+class ObHashIntersectVecSpec;
+class ObHashExceptVecSpec;
 class ObCountSpec;
 class ObExprValuesSpec;
 class ObTableMergeSpec;
@@ -61,8 +64,10 @@ class ObFakeCTETableSpec;
 class ObHashJoinSpec;
 class ObHashJoinVecSpec;
 class ObNestedLoopJoinSpec;
+class ObNestedLoopJoinVecSpec;
 class ObBasicNestedLoopJoinSpec;
 class ObMergeJoinSpec;
+class ObMergeJoinVecSpec;
 class ObJoinSpec;
 class ObMonitoringDumpSpec;
 class ObLogSequence;
@@ -97,6 +102,7 @@ class ObHashGroupBySpec;
 class ObAggregateProcessor;
 struct ObAggrInfo;
 class ObWindowFunctionSpec;
+class ObWindowFunctionVecSpec;
 class WinFuncInfo;
 template <int TYPE>
     struct GenSpecHelper;
@@ -130,6 +136,8 @@ struct ObTableScanCtDef;
 struct ObDASScanCtDef;
 struct InsertAllTableInfo;
 class ObHashDistinctVecSpec;
+class ObMergeDistinctVecSpec;
+class ObMergeGroupByVecSpec;
 class ObSortVecSpec;
 typedef common::ObList<uint64_t, common::ObIAllocator> DASTableIdList;
 typedef common::ObSEArray<common::ObSEArray<int64_t, 8, common::ModulePageAllocator, true>,
@@ -269,10 +277,14 @@ private:
   int generate_spec(ObLogDistinct &op, ObMergeDistinctSpec &spec, const bool in_root_job);
   int generate_spec(ObLogDistinct &op, ObHashDistinctSpec &spec, const bool in_root_job);
   int generate_spec(ObLogDistinct &op, ObHashDistinctVecSpec &spec, const bool in_root_job);
+  int generate_spec(ObLogDistinct &op, ObMergeDistinctVecSpec &spec, const bool in_root_job);
 
   int generate_spec(ObLogSet &op, ObHashUnionSpec &spec, const bool in_root_job);
   int generate_spec(ObLogSet &op, ObHashIntersectSpec &spec, const bool in_root_job);
   int generate_spec(ObLogSet &op, ObHashExceptSpec &spec, const bool in_root_job);
+  int generate_spec(ObLogSet &op, ObHashUnionVecSpec &spec, const bool in_root_job);
+  int generate_spec(ObLogSet &op, ObHashIntersectVecSpec &spec, const bool in_root_job);
+  int generate_spec(ObLogSet &op, ObHashExceptVecSpec &spec, const bool in_root_job);
   int generate_hash_set_spec(ObLogSet &op, ObHashSetSpec &spec);
 
   int generate_spec(ObLogSet &op, ObMergeUnionSpec &spec, const bool in_root_job);
@@ -314,6 +326,7 @@ private:
   int generate_spec(ObLogGroupBy &op, ObScalarAggregateSpec &spec, const bool in_root_job);
   int generate_spec(ObLogGroupBy &op, ObScalarAggregateVecSpec &spec, const bool in_root_job);
   int generate_spec(ObLogGroupBy &op, ObMergeGroupBySpec &spec, const bool in_root_job);
+  int generate_spec(ObLogGroupBy &op, ObMergeGroupByVecSpec &spec, const bool in_root_job);
   int generate_spec(ObLogGroupBy &op, ObHashGroupBySpec &spec, const bool in_root_job);
   int generate_spec(ObLogGroupBy &op, ObHashGroupByVecSpec &spec, const bool in_root_job);
   int generate_dist_aggr_distinct_columns(ObLogGroupBy &op, ObHashGroupBySpec &spec);
@@ -343,8 +356,13 @@ private:
 
   // generate nested loop join
   int generate_spec(ObLogJoin &op, ObNestedLoopJoinSpec &spec, const bool in_root_job);
+  int generate_spec(ObLogJoin &op, ObNestedLoopJoinVecSpec &spec, const bool in_root_job);
   // generate merge join
   int generate_spec(ObLogJoin &op, ObMergeJoinSpec &spec, const bool in_root_job);
+  int generate_spec(ObLogJoin &op, ObMergeJoinVecSpec &spec, const bool in_root_job);
+  // generate equal join conditions and child fetcher exprs of merge join
+  template <typename MergeJoinSpecType>
+  int generate_merge_join_conds(ObLogJoin &op, MergeJoinSpecType &spec);
 
   int generate_join_spec(ObLogJoin &op, ObJoinSpec &spec);
 
@@ -404,6 +422,7 @@ private:
   int generate_spec(ObLogExchange &op, ObDirectReceiveSpec &spec, const bool in_root_job);
 
   int generate_spec(ObLogWindowFunction &op, ObWindowFunctionSpec &spec, const bool in_root_job);
+  int generate_spec(ObLogWindowFunction &op, ObWindowFunctionVecSpec &spec, const bool in_root_job);
 
   int generate_spec(ObLogTableScan &op, ObRowSampleScanSpec &spec, const bool in_root_job);
   int generate_spec(ObLogTableScan &op, ObBlockSampleScanSpec &spec, const bool in_root_job);
@@ -0,0 +1,230 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/aggregate/ob_merge_distinct_vec_op.h"
+#include "sql/engine/ob_physical_plan.h"
+#include "sql/engine/ob_exec_context.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace sql
+{
+
+int ObSortedRunUtil::mark_run_starts(const ObIArray<ObExpr *> &exprs,
+                                     ObEvalCtx &eval_ctx,
+                                     const ObBatchRows &brs,
+                                     const LastCompactRow *last_row,
+                                     ObBitVector &run_starts)
+{
+  int ret = OB_SUCCESS;
+  run_starts.reset(brs.size_);
+  int64_t first_idx = 0;
+  while (first_idx < brs.size_ && brs.skip_->at(first_idx)) {
+    ++first_idx;
+  }
+  if (first_idx >= brs.size_) {
+    // all rows are skipped
+  } else {
+    if (OB_ISNULL(last_row)) {
+      run_starts.set(first_idx);
+    }
+    // compare one column for the whole batch at a time, rows already known as
+    // run starts are not compared again on the following columns.
+    for (int64_t col_idx = 0; OB_SUCC(ret) && col_idx < exprs.count(); ++col_idx) {
+      const ObExpr *expr = exprs.at(col_idx);
+      if (OB_ISNULL(expr)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("expr is null", K(ret), K(col_idx));
+      } else if (expr->is_const_expr()) {
+        // const exprs are equal for all rows
+      } else {
+        const ObIVector *vec = expr->get_vector(eval_ctx);
+        int64_t prev_idx = -1;
+        for (int64_t i = first_idx; OB_SUCC(ret) && i < brs.size_; ++i) {
+          if (brs.skip_->at(i)) {
+            continue;
+          }
+          if (!run_starts.at(i)) {
+            bool r_null = false;
+            const char *r_v = nullptr;
+            ObLength r_len = 0;
+            int cmp_ret = 0;
+            if (prev_idx < 0) {
+              r_null = last_row->compact_row_->is_null(col_idx);
+              if (!r_null) {
+                last_row->compact_row_->get_cell_payload(last_row->row_meta_, col_idx, r_v, r_len);
+              }
+            } else {
+              vec->get_payload(prev_idx, r_null, r_v, r_len);
+            }
+            if (OB_FAIL(vec->null_first_cmp(*expr, i, r_null, r_v, r_len, cmp_ret))) {
+              LOG_WARN("compare failed", K(ret), K(col_idx), K(i));
+            } else if (0 != cmp_ret) {
+              run_starts.set(i);
+            }
+          }
+          prev_idx = i;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+ObMergeDistinctVecSpec::ObMergeDistinctVecSpec(ObIAllocator &alloc, const ObPhyOperatorType type)
+  : ObMergeDistinctSpec(alloc, type)
+{}
+
+OB_SERIALIZE_MEMBER((ObMergeDistinctVecSpec, ObMergeDistinctSpec));
+
+ObMergeDistinctVecOp::ObMergeDistinctVecOp(ObExecContext &exec_ctx, const ObOpSpec &spec,
+                                           ObOpInput *input)
+  : ObOperator(exec_ctx, spec, input),
+    has_last_row_(false),
+    alloc_(ObModIds::OB_SQL_MERGE_GROUPBY,
+      OB_MALLOC_NORMAL_BLOCK_SIZE, exec_ctx.get_my_session()->get_effective_tenant_id(),
+      ObCtxIds::WORK_AREA),
+    last_row_(alloc_),
+    distinct_rows_(nullptr)
+{
+}
+
+int ObMergeDistinctVecOp::inner_open()
+{
+  int ret = OB_SUCCESS;
+  void *mem = nullptr;
+  if (OB_ISNULL(child_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("child is null", K(ret));
+  } else if (MY_SPEC.is_block_mode_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("merge distinct not support block mode", K(ret));
+  } else if (OB_ISNULL(mem = ctx_.get_allocator().alloc(
+                         ObBitVector::memory_size(MY_SPEC.max_batch_size_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc memory", K(ret));
+  } else {
+    distinct_rows_ = to_bit_vector(mem);
+    distinct_rows_->reset(MY_SPEC.max_batch_size_);
+    last_row_.reuse_ = true;
+    has_last_row_ = false;
+  }
+  return ret;
+}
+
+int ObMergeDistinctVecOp::inner_close()
+{
+  has_last_row_ = false;
+  last_row_.reset();
+  alloc_.reset();
+  return ObOperator::inner_close();
+}
+
+int ObMergeDistinctVecOp::inner_rescan()
+{
+  int ret = OB_SUCCESS;
+  has_last_row_ = false;
+  last_row_.reset();
+  alloc_.reset();
+  if (OB_FAIL(ObOperator::inner_rescan())) {
+    LOG_WARN("failed to rescan", K(ret));
+  }
+  return ret;
+}
+
+void ObMergeDistinctVecOp::destroy()
+{
+  last_row_.reset();
+  alloc_.reset();
+  ObOperator::destroy();
+}
+
+int ObMergeDistinctVecOp::inner_get_next_row()
+{
+  return OB_NOT_IMPLEMENT;
+}
+
+int ObMergeDistinctVecOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  const int64_t batch_size = std::min(max_row_cnt, MY_SPEC.max_batch_size_);
+  const ObBatchRows *child_brs = nullptr;
+  bool got_batch = false;
+  while (OB_SUCC(ret) && !got_batch) {
+    clear_evaluated_flag();
+    if (OB_FAIL(child_->get_next_batch(batch_size, child_brs))) {
+      LOG_WARN("failed to get next batch", K(ret));
+    } else if (child_brs->end_ && 0 == child_brs->size_) {
+      ret = OB_ITER_END;
+    } else if (OB_FAIL(try_check_status())) {
+      LOG_WARN("check status failed", K(ret));
+    } else if (OB_FAIL(deduplicate_for_batch(*child_brs))) {
+      LOG_WARN("failed to deduplicate batch", K(ret));
+    } else {
+      // do not return batches filtered out entirely, unless iterating end
+      got_batch = child_brs->end_ || !brs_.skip_->is_all_true(brs_.size_);
+    }
+  }
+  if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+    brs_.end_ = true;
+    brs_.size_ = 0;
+  }
+  return ret;
+}
+
+int ObMergeDistinctVecOp::deduplicate_for_batch(const ObBatchRows &child_brs)
+{
+  int ret = OB_SUCCESS;
+  int64_t last_start = -1;
+  for (int64_t i = 0; OB_SUCC(ret) && i < MY_SPEC.distinct_exprs_.count(); ++i) {
+    if (OB_FAIL(MY_SPEC.distinct_exprs_.at(i)->eval_vector(eval_ctx_, child_brs))) {
+      LOG_WARN("failed to eval vector", K(ret), K(i));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(brs_.copy(&child_brs))) {
+    LOG_WARN("failed to copy batch rows", K(ret));
+  } else if (OB_FAIL(ObSortedRunUtil::mark_run_starts(MY_SPEC.distinct_exprs_, eval_ctx_,
+                                                      child_brs,
+                                                      has_last_row_ ? &last_row_ : nullptr,
+                                                      *distinct_rows_))) {
+    LOG_WARN("failed to mark distinct rows", K(ret));
+  } else {
+    for (int64_t i = 0; i < child_brs.size_; ++i) {
+      if (child_brs.skip_->at(i)) {
+      } else if (distinct_rows_->at(i)) {
+        last_start = i;
+      } else {
+        brs_.set_skip(i);
+      }
+    }
+  }
+  if (OB_SUCC(ret) && last_start >= 0) {
+    // keep the last distinct row to compare with the first row of next batch
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+    batch_info_guard.set_batch_size(child_brs.size_);
+    batch_info_guard.set_batch_idx(last_start);
+    if (OB_FAIL(last_row_.save_store_row(MY_SPEC.distinct_exprs_, child_brs, eval_ctx_))) {
+      LOG_WARN("failed to save last row", K(ret));
+    } else {
+      has_last_row_ = true;
+    }
+  }
+  return ret;
+}
+
+} // end namespace sql
+} // end namespace oceanbase
@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SRC_SQL_ENGINE_AGGREGATE_OB_MERGE_DISTINCT_VEC_OP_H_
+#define OCEANBASE_SRC_SQL_ENGINE_AGGREGATE_OB_MERGE_DISTINCT_VEC_OP_H_
+
+#include "sql/engine/ob_operator.h"
+#include "sql/engine/aggregate/ob_merge_distinct_op.h"
+#include "sql/engine/basic/ob_compact_row.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+
+// Utilities for operators working on input sorted by some exprs.
+struct ObSortedRunUtil
+{
+  // Set %run_starts for active rows which differ from the previous active row on %exprs,
+  // vectors are compared a column at a time. The first active row is compared with
+  // %last_row, or always starts a new run if %last_row is null.
+  static int mark_run_starts(const common::ObIArray<ObExpr *> &exprs,
+                             ObEvalCtx &eval_ctx,
+                             const ObBatchRows &brs,
+                             const LastCompactRow *last_row,
+                             ObBitVector &run_starts);
+};
+
+class ObMergeDistinctVecSpec : public ObMergeDistinctSpec
+{
+  OB_UNIS_VERSION_V(1);
+public:
+  ObMergeDistinctVecSpec(common::ObIAllocator &alloc, const ObPhyOperatorType type);
+};
+
+class ObMergeDistinctVecOp : public ObOperator
+{
+public:
+  ObMergeDistinctVecOp(ObExecContext &exec_ctx, const ObOpSpec &spec, ObOpInput *input);
+
+  virtual int inner_open() override;
+  virtual int inner_close() override;
+  virtual int inner_rescan() override;
+  virtual int inner_get_next_row() override;
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
+  virtual void destroy() override;
+
+private:
+  int deduplicate_for_batch(const ObBatchRows &child_brs);
+
+private:
+  bool has_last_row_;
+  common::ObArenaAllocator alloc_;
+  LastCompactRow last_row_;
+  // rows differ from the previous distinct row in current batch
+  ObBitVector *distinct_rows_;
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+
+#endif /* OCEANBASE_SRC_SQL_ENGINE_AGGREGATE_OB_MERGE_DISTINCT_VEC_OP_H_ */
@@ -0,0 +1,291 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/aggregate/ob_merge_groupby_vec_op.h"
+#include "sql/engine/ob_physical_plan.h"
+#include "sql/engine/ob_exec_context.h"
+#include "sql/engine/basic/ob_chunk_row_store.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace sql
+{
+
+OB_SERIALIZE_MEMBER((ObMergeGroupByVecSpec, ObMergeGroupBySpec));
+
+ObMergeGroupByVecOp::ObMergeGroupByVecOp(ObExecContext &exec_ctx, const ObOpSpec &spec,
+                                         ObOpInput *input)
+  : ObGroupByVecOp(exec_ctx, spec, input),
+    dir_id_(-1),
+    child_iter_end_(false),
+    has_cur_group_(false),
+    alloc_(ObModIds::OB_SQL_MERGE_GROUPBY,
+      OB_MALLOC_NORMAL_BLOCK_SIZE, exec_ctx.get_my_session()->get_effective_tenant_id(),
+      ObCtxIds::WORK_AREA),
+    cur_group_row_(alloc_),
+    group_alloc_(ObModIds::OB_SQL_MERGE_GROUPBY,
+      OB_MALLOC_NORMAL_BLOCK_SIZE, exec_ctx.get_my_session()->get_effective_tenant_id(),
+      ObCtxIds::WORK_AREA),
+    run_starts_(nullptr),
+    group_rows_(nullptr),
+    group_rows_cap_(0),
+    group_cnt_(0),
+    output_idx_(0)
+{
+}
+
+int ObMergeGroupByVecOp::inner_open()
+{
+  int ret = OB_SUCCESS;
+  void *mem = nullptr;
+  // a child batch finishes at most one group per row, plus the last group at iterating end
+  const int64_t rows_cap = 2 * MY_SPEC.max_batch_size_ + 1;
+  if (OB_ISNULL(child_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("child is null", K(ret));
+  } else if (OB_UNLIKELY(MY_SPEC.has_rollup_
+                         || ObThreeStageAggrStage::NONE_STAGE != MY_SPEC.aggr_stage_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected merge group by", K(ret), K(MY_SPEC.has_rollup_), K(MY_SPEC.aggr_stage_));
+  } else if (OB_FAIL(ObGroupByVecOp::inner_open())) {
+    LOG_WARN("groupby inner open failed", K(ret));
+  } else if (OB_FAIL(ObChunkStoreUtil::alloc_dir_id(dir_id_))) {
+    LOG_WARN("failed to allocate dir id", K(ret));
+  } else if (OB_ISNULL(mem = ctx_.get_allocator().alloc(
+                         ObBitVector::memory_size(MY_SPEC.max_batch_size_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc memory", K(ret));
+  } else if (FALSE_IT(run_starts_ = to_bit_vector(mem))) {
+  } else if (OB_ISNULL(mem = ctx_.get_allocator().alloc(sizeof(ObCompactRow *) * rows_cap))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc memory", K(ret), K(rows_cap));
+  } else {
+    group_rows_ = static_cast<const ObCompactRow **>(mem);
+    group_rows_cap_ = rows_cap;
+    run_starts_->reset(MY_SPEC.max_batch_size_);
+    aggr_processor_.set_dir_id(dir_id_);
+    aggr_processor_.set_io_event_observer(&io_event_observer_);
+    aggr_processor_.set_op_monitor_info(&op_monitor_info_);
+    cur_group_row_.reuse_ = true;
+    child_iter_end_ = false;
+    has_cur_group_ = false;
+    reset_groups();
+  }
+  return ret;
+}
+
+void ObMergeGroupByVecOp::reset_groups()
+{
+  group_cnt_ = 0;
+  output_idx_ = 0;
+  group_alloc_.reset();
+}
+
+int ObMergeGroupByVecOp::inner_close()
+{
+  child_iter_end_ = false;
+  has_cur_group_ = false;
+  reset_groups();
+  cur_group_row_.reset();
+  alloc_.reset();
+  return ObGroupByVecOp::inner_close();
+}
+
+int ObMergeGroupByVecOp::inner_rescan()
+{
+  int ret = OB_SUCCESS;
+  child_iter_end_ = false;
+  has_cur_group_ = false;
+  reset_groups();
+  cur_group_row_.reset();
+  alloc_.reset();
+  if (OB_FAIL(ObGroupByVecOp::inner_rescan())) {
+    LOG_WARN("failed to rescan", K(ret));
+  }
+  return ret;
+}
+
+int ObMergeGroupByVecOp::inner_switch_iterator()
+{
+  int ret = OB_SUCCESS;
+  child_iter_end_ = false;
+  has_cur_group_ = false;
+  reset_groups();
+  cur_group_row_.reset();
+  alloc_.reset();
+  if (OB_FAIL(ObGroupByVecOp::inner_switch_iterator())) {
+    LOG_WARN("failed to switch iterator", K(ret));
+  }
+  return ret;
+}
+
+void ObMergeGroupByVecOp::destroy()
+{
+  group_rows_ = nullptr;
+  run_starts_ = nullptr;
+  cur_group_row_.reset();
+  alloc_.reset();
+  group_alloc_.reset();
+  ObGroupByVecOp::destroy();
+}
+
+int ObMergeGroupByVecOp::inner_get_next_row()
+{
+  return OB_NOT_IMPLEMENT;
+}
+
+int ObMergeGroupByVecOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  const int64_t batch_size = std::min(max_row_cnt, MY_SPEC.max_batch_size_);
+  const ObBatchRows *child_brs = nullptr;
+  if (output_idx_ >= group_cnt_) {
+    reset_groups();
+  }
+  while (OB_SUCC(ret) && !child_iter_end_ && group_cnt_ - output_idx_ < batch_size
+         && group_cnt_ + MY_SPEC.max_batch_size_ + 1 <= group_rows_cap_) {
+    clear_evaluated_flag();
+    if (OB_FAIL(child_->get_next_batch(MY_SPEC.max_batch_size_, child_brs))) {
+      LOG_WARN("failed to get next batch", K(ret));
+    } else if (OB_FAIL(try_check_status())) {
+      LOG_WARN("check status failed", K(ret));
+    } else if (child_brs->size_ > 0 && OB_FAIL(process_child_batch(*child_brs))) {
+      LOG_WARN("failed to process child batch", K(ret), K(*child_brs));
+    } else if (child_brs->end_) {
+      child_iter_end_ = true;
+      if (has_cur_group_ && OB_FAIL(finish_group())) {
+        LOG_WARN("failed to finish group", K(ret));
+      } else {
+        has_cur_group_ = false;
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    const int64_t output_cnt = std::min(batch_size, group_cnt_ - output_idx_);
+    clear_evaluated_flag();
+    brs_.size_ = 0;
+    brs_.end_ = false;
+    if (output_cnt > 0) {
+      brs_.reset_skip(output_cnt);
+      if (OB_FAIL(aggr_processor_.collect_group_results(cur_group_row_.row_meta_,
+                                                        MY_SPEC.group_exprs_,
+                                                        static_cast<int32_t>(output_cnt),
+                                                        group_rows_ + output_idx_, brs_))) {
+        LOG_WARN("failed to collect group results", K(ret), K(output_cnt));
+      } else {
+        output_idx_ += output_cnt;
+      }
+    }
+    if (OB_SUCC(ret) && child_iter_end_ && output_idx_ >= group_cnt_) {
+      brs_.end_ = true;
+    }
+  }
+  return ret;
+}
+
+int ObMergeGroupByVecOp::process_child_batch(const ObBatchRows &child_brs)
+{
+  int ret = OB_SUCCESS;
+  int64_t run_begin = 0;
+  for (int64_t i = 0; OB_SUCC(ret) && i < MY_SPEC.group_exprs_.count(); ++i) {
+    if (OB_FAIL(MY_SPEC.group_exprs_.at(i)->eval_vector(eval_ctx_, child_brs))) {
+      LOG_WARN("failed to eval vector", K(ret), K(i));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(aggr_processor_.eval_aggr_param_batch(child_brs))) {
+    LOG_WARN("failed to eval aggregate params batch", K(ret));
+  } else if (OB_FAIL(ObSortedRunUtil::mark_run_starts(MY_SPEC.group_exprs_, eval_ctx_,
+                                                      child_brs,
+                                                      has_cur_group_ ? &cur_group_row_ : nullptr,
+                                                      *run_starts_))) {
+    LOG_WARN("failed to mark group starts", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < child_brs.size_; ++i) {
+    if (child_brs.skip_->at(i) || !run_starts_->at(i)) {
+      // rows of the current group
+    } else if (has_cur_group_
+               && (OB_FAIL(add_group_rows(child_brs, run_begin, i)) || OB_FAIL(finish_group()))) {
+      LOG_WARN("failed to finish group", K(ret), K(run_begin), K(i));
+    } else if (OB_FAIL(start_group(child_brs, i))) {
+      LOG_WARN("failed to start group", K(ret), K(i));
+    } else {
+      run_begin = i;
+    }
+  }
+  if (OB_SUCC(ret) && has_cur_group_
+      && OB_FAIL(add_group_rows(child_brs, run_begin, child_brs.size_))) {
+    LOG_WARN("failed to add group rows", K(ret), K(run_begin));
+  }
+  return ret;
+}
+
+int ObMergeGroupByVecOp::start_group(const ObBatchRows &child_brs, const int64_t batch_idx)
+{
+  int ret = OB_SUCCESS;
+  const int32_t aggr_row_size = aggr_processor_.get_aggregate_row_size();
+  ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+  batch_info_guard.set_batch_size(child_brs.size_);
+  batch_info_guard.set_batch_idx(batch_idx);
+  if (OB_FAIL(cur_group_row_.save_store_row(MY_SPEC.group_exprs_, child_brs, eval_ctx_,
+                                            aggr_row_size))) {
+    LOG_WARN("failed to save group row", K(ret));
+  } else if (OB_FAIL(aggr_processor_.add_one_aggregate_row(
+               static_cast<char *>(
+                 cur_group_row_.compact_row_->get_extra_payload(cur_group_row_.row_meta_)),
+               aggr_row_size, false))) {
+    LOG_WARN("failed to init aggregate row", K(ret));
+  } else {
+    has_cur_group_ = true;
+  }
+  return ret;
+}
+
+int ObMergeGroupByVecOp::finish_group()
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_size = cur_group_row_.compact_row_->get_row_size();
+  char *buf = nullptr;
+  if (OB_UNLIKELY(group_cnt_ >= group_rows_cap_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("too many groups", K(ret), K(group_cnt_), K(group_rows_cap_));
+  } else if (OB_ISNULL(buf = static_cast<char *>(group_alloc_.alloc(row_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc memory", K(ret), K(row_size));
+  } else {
+    MEMCPY(buf, cur_group_row_.compact_row_, row_size);
+    group_rows_[group_cnt_++] = reinterpret_cast<const ObCompactRow *>(buf);
+  }
+  return ret;
+}
+
+int ObMergeGroupByVecOp::add_group_rows(const ObBatchRows &child_brs, const int64_t begin,
+                                        const int64_t end)
+{
+  int ret = OB_SUCCESS;
+  if (begin < end) {
+    aggregate::AggrRowPtr agg_row = static_cast<char *>(
+      cur_group_row_.compact_row_->get_extra_payload(cur_group_row_.row_meta_));
+    if (OB_FAIL(aggr_processor_.add_batch_rows(0, aggr_processor_.aggregates_cnt(), agg_row,
+                                               child_brs, static_cast<uint16_t>(begin),
+                                               static_cast<uint16_t>(end)))) {
+      LOG_WARN("add batch rows failed", K(ret), K(begin), K(end));
+    }
+  }
+  return ret;
+}
+
+} // end namespace sql
+} // end namespace oceanbase
@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SRC_SQL_ENGINE_AGGREGATE_OB_MERGE_GROUPBY_VEC_OP_H_
+#define OCEANBASE_SRC_SQL_ENGINE_AGGREGATE_OB_MERGE_GROUPBY_VEC_OP_H_
+
+#include "sql/engine/aggregate/ob_groupby_vec_op.h"
+#include "sql/engine/aggregate/ob_merge_groupby_op.h"
+#include "sql/engine/aggregate/ob_merge_distinct_vec_op.h"
+#include "sql/engine/basic/ob_compact_row.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+
+// Rollup, three stage aggregation and distinct aggregate functions are not supported,
+// see ObStaticEngineCG::get_phy_op_type.
+class ObMergeGroupByVecSpec : public ObMergeGroupBySpec
+{
+  OB_UNIS_VERSION_V(1);
+public:
+  ObMergeGroupByVecSpec(common::ObIAllocator &alloc, const ObPhyOperatorType type)
+    : ObMergeGroupBySpec(alloc, type)
+  {}
+};
+
+// Input is sorted by group exprs. Group boundaries of a batch are found by comparing
+// group exprs column by column, each run of rows is added to the aggregate row of its
+// group by aggregate::Processor::add_batch_rows.
+class ObMergeGroupByVecOp : public ObGroupByVecOp
+{
+public:
+  ObMergeGroupByVecOp(ObExecContext &exec_ctx, const ObOpSpec &spec, ObOpInput *input);
+
+  virtual int inner_open() override;
+  virtual int inner_close() override;
+  virtual int inner_rescan() override;
+  virtual int inner_switch_iterator() override;
+  virtual int inner_get_next_row() override;
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
+  virtual void destroy() override;
+
+private:
+  void reset_groups();
+  int process_child_batch(const ObBatchRows &child_brs);
+  // save row of %batch_idx as the current group and initialize its aggregate row
+  int start_group(const ObBatchRows &child_brs, const int64_t batch_idx);
+  // move the current group to finished groups
+  int finish_group();
+  int add_group_rows(const ObBatchRows &child_brs, const int64_t begin, const int64_t end);
+  DISALLOW_COPY_AND_ASSIGN(ObMergeGroupByVecOp);
+
+private:
+  int64_t dir_id_;
+  bool child_iter_end_;
+  bool has_cur_group_;
+  common::ObArenaAllocator alloc_;
+  // group exprs of the current group, with aggregate row as extra payload
+  LastCompactRow cur_group_row_;
+  // memory of finished groups, reset after they are all returned
+  common::ObArenaAllocator group_alloc_;
+  ObBitVector *run_starts_;
+  const ObCompactRow **group_rows_;
+  int64_t group_rows_cap_;
+  int64_t group_cnt_;
+  int64_t output_idx_;
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+
+#endif /* OCEANBASE_SRC_SQL_ENGINE_AGGREGATE_OB_MERGE_GROUPBY_VEC_OP_H_ */
@@ -155,6 +155,8 @@ void ObIHashPartInfrastructure::destroy()
     if (OB_NOT_NULL(alloc_)) {
       alloc_->free(my_skip_);
       my_skip_ = nullptr;
+      alloc_->free(probe_skip_);
+      probe_skip_ = nullptr;
     }
   }
 }
@@ -207,7 +209,7 @@ int ObIHashPartInfrastructure::init_default_part(
     part->part_key_.nth_part_ = nth_part;
     ObMemAttr attr(tenant_id_, "HashPartInfra", ObCtxIds::WORK_AREA);
     if (OB_FAIL(part->store_.init(*exprs_, max_batch_size_, attr, limit, true,
-                                  ObHashPartItem::get_extra_size()))) {
+                                  ObHashPartItem::get_extra_size(need_match_)))) {
       SQL_ENG_LOG(WARN, "failed to init row store", K(ret));
     } else if (OB_ISNULL(sql_mem_processor_)) {
       ret = OB_ERR_UNEXPECTED;
@@ -724,6 +726,44 @@ insert_row_for_batch(const common::ObIArray<ObExpr *> &batch_exprs,
   return ret;
 }
 
+int ObIHashPartInfrastructure::exists_batch(const common::ObIArray<ObExpr *> &exprs,
+                                            uint64_t *hash_values_for_batch,
+                                            const int64_t batch_size,
+                                            const ObBitVector *skip,
+                                            ObBitVector *&output_vec)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(my_skip_) || OB_ISNULL(probe_skip_) || OB_ISNULL(eval_ctx_)) {
+    ret = OB_ERR_UNEXPECTED;
+    SQL_ENG_LOG(WARN, "skip or eval_ctx_ is not init", K(ret), K(my_skip_), K(probe_skip_),
+                K(eval_ctx_));
+  } else if (OB_ISNULL(hash_values_for_batch)) {
+    ret = OB_ERR_UNEXPECTED;
+    SQL_ENG_LOG(WARN, "hash values vector is not init", K(ret));
+  } else if (!need_match_) {
+    ret = OB_ERR_UNEXPECTED;
+    SQL_ENG_LOG(WARN, "match flag of hash table rows is not enabled", K(ret));
+  } else {
+    my_skip_->reset(batch_size);
+    probe_skip_->reset(batch_size);
+    output_vec = my_skip_;
+    if (OB_FAIL(probe_batch_for_match(hash_values_for_batch, batch_size, skip,
+                                      *my_skip_, *probe_skip_))) {
+      SQL_ENG_LOG(WARN, "failed to probe batch", K(ret));
+    } else if (has_left_dumped()) {
+      // dump right rows which are not found if left is dumped
+      if (!has_right_dumped()
+          && OB_FAIL(create_dumped_partitions(InputSide::RIGHT))) {
+        SQL_ENG_LOG(WARN, "failed to create dump partitions", K(ret));
+      } else if (OB_FAIL(insert_batch_on_partitions(exprs, *probe_skip_,
+                                                    batch_size, hash_values_for_batch))) {
+        SQL_ENG_LOG(WARN, "failed to insert batch on partitions", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObIHashPartInfrastructure::finish_insert_row()
 {
   int ret = OB_SUCCESS;
@@ -1013,17 +1053,29 @@ int ObIHashPartInfrastructure::get_left_next_batch(
 int ObIHashPartInfrastructure::get_right_next_batch(
   const common::ObIArray<ObExpr *> &exprs,
   const int64_t max_row_cnt,
-  int64_t &read_rows)
+  int64_t &read_rows,
+  uint64_t *hash_values_for_batch)
 {
   int ret = OB_SUCCESS;
+  const ObCompactRow *store_rows[max_row_cnt];
   if (OB_ISNULL(cur_right_part_) || OB_ISNULL(eval_ctx_)) {
     ret = OB_ERR_UNEXPECTED;
     SQL_ENG_LOG(WARN, "unexpected status: current partition is null", K(cur_right_part_));
-  } else if (OB_FAIL(right_row_store_iter_.get_next_batch(exprs, *eval_ctx_, max_row_cnt, read_rows))) {
+  } else if (OB_FAIL(right_row_store_iter_.get_next_batch(exprs,
+                                                          *eval_ctx_,
+                                                          max_row_cnt,
+                                                          read_rows,
+                                                          &store_rows[0]))) {
     if (OB_ITER_END != ret) {
       SQL_ENG_LOG(WARN, "failed to get next row", K(ret));
     }
   }
+  if (OB_SUCC(ret) && OB_NOT_NULL(hash_values_for_batch)) {
+    for (int64_t i = 0; i < read_rows; ++i) {
+      const ObHashPartItem *sr = static_cast<const ObHashPartItem *> (store_rows[i]);
+      hash_values_for_batch[i] = sr->get_hash_value(cur_right_part_->store_.get_row_meta());
+    }
+  }
   return ret;
 }
 
@@ -1621,4 +1673,92 @@ int64_t ObHashPartInfrastructureVecImpl::estimate_total_count() const
   }
   return est_total_cnt;
 }
+void ObHashPartInfrastructureVecImpl::set_need_match()
+{
+  HP_INFRAS_STATUS_CHECK
+  {
+    hp_infras_->set_need_match();
+  }
+}
+
+void ObHashPartInfrastructureVecImpl::switch_left()
+{
+  HP_INFRAS_STATUS_CHECK
+  {
+    hp_infras_->switch_left();
+  }
+}
+
+void ObHashPartInfrastructureVecImpl::switch_right()
+{
+  HP_INFRAS_STATUS_CHECK
+  {
+    hp_infras_->switch_right();
+  }
+}
+
+bool ObHashPartInfrastructureVecImpl::has_cur_part(InputSide input_side)
+{
+  bool has_part = false;
+  HP_INFRAS_STATUS_CHECK
+  {
+    has_part = hp_infras_->has_cur_part(input_side);
+  }
+  return has_part;
+}
+
+bool ObHashPartInfrastructureVecImpl::has_left_dumped()
+{
+  bool dumped = false;
+  HP_INFRAS_STATUS_CHECK
+  {
+    dumped = hp_infras_->has_left_dumped();
+  }
+  return dumped;
+}
+
+int ObHashPartInfrastructureVecImpl::get_right_next_batch(
+  const common::ObIArray<ObExpr *> &exprs,
+  const int64_t max_row_cnt,
+  int64_t &read_rows,
+  uint64_t *hash_values_for_batch)
+{
+  HP_INFRAS_STATUS_CHECK
+  {
+    if (OB_FAIL(hp_infras_->get_right_next_batch(exprs, max_row_cnt,
+                                                 read_rows, hash_values_for_batch))) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("failed to get right next batch", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObHashPartInfrastructureVecImpl::exists_batch(const common::ObIArray<ObExpr *> &exprs,
+                                                  uint64_t *hash_values_for_batch,
+                                                  const int64_t batch_size,
+                                                  const ObBitVector *skip,
+                                                  ObBitVector *&output_vec)
+{
+  HP_INFRAS_STATUS_CHECK
+  {
+    if (OB_FAIL(hp_infras_->exists_batch(exprs, hash_values_for_batch,
+                                         batch_size, skip, output_vec))) {
+      LOG_WARN("failed to probe batch", K(ret));
+    }
+  }
+  return ret;
+}
+
+const RowMeta *ObHashPartInfrastructureVecImpl::get_hash_store_row_meta() const
+{
+  const RowMeta *row_meta = nullptr;
+  HP_INFRAS_STATUS_CHECK
+  {
+    row_meta = &hp_infras_->get_hash_store_row_meta();
+  }
+  return row_meta;
+}
+
 //////////////////// end ObHashPartInfrastructureVecImpl //////////////////
@@ -30,7 +30,7 @@ namespace sql
 {
 
 /*
-|        |extra: hash value + next ptr|       |
+|        |extra: hash value + next ptr (+ match flag)|       |
                compact row
 */
 class ObHashPartItem : public ObCompactRow
@@ -56,7 +56,22 @@ public:
   {
     *reinterpret_cast<uint64_t *>(this->get_extra_payload(row_meta)) = hash_val;
   }
-  static int64_t get_extra_size() { return sizeof(uint64_t) + sizeof(ObHashPartItem *); }
+  // match flag is only stored when the infrastructure is required to mark matched rows,
+  // e.g. intersect and except
+  bool is_match(const RowMeta &row_meta) const
+  {
+    return *reinterpret_cast<const int64_t *>(static_cast<const char *> (
+        this->get_extra_payload(row_meta)) + sizeof(uint64_t) + sizeof(ObHashPartItem *)) != 0;
+  }
+  void set_is_match(const RowMeta &row_meta, const bool is_match)
+  {
+    *reinterpret_cast<int64_t *>(static_cast<char *> (this->get_extra_payload(row_meta))
+        + sizeof(uint64_t) + sizeof(ObHashPartItem *)) = is_match ? 1 : 0;
+  }
+  static int64_t get_extra_size(const bool need_match = false)
+  {
+    return sizeof(uint64_t) + sizeof(ObHashPartItem *) + (need_match ? sizeof(int64_t) : 0);
+  }
 };
 
 template<typename CompactRowItem>
@@ -131,7 +146,8 @@ public:
     has_cur_part_dumped_(false), has_create_part_map_(false),
     est_part_cnt_(INT64_MAX), cur_level_(0), part_shift_(0), period_row_cnt_(0),
     left_part_cur_id_(0), right_part_cur_id_(0), my_skip_(nullptr),
-    is_push_down_(false), exprs_(nullptr), is_inited_vec_(false), max_batch_size_(0)
+    is_push_down_(false), exprs_(nullptr), is_inited_vec_(false), max_batch_size_(0),
+    need_match_(false), probe_skip_(nullptr)
   {}
   virtual ~ObIHashPartInfrastructure();
 public:
@@ -327,7 +343,8 @@ public:
                           uint64_t *hash_values_for_batch);
   int get_right_next_batch(const common::ObIArray<ObExpr *> &exprs,
                            const int64_t max_row_cnt,
-                           int64_t &read_rows);
+                           int64_t &read_rows,
+                           uint64_t *hash_values_for_batch = nullptr);
   int get_next_hash_table_batch(const common::ObIArray<ObExpr *> &exprs,
                                 const int64_t max_row_cnt,
                                 int64_t &read_rows,
@@ -356,6 +373,15 @@ public:
       my_skip_ = to_bit_vector(data);
       my_skip_->reset(batch_size);
     }
+    if (OB_SUCC(ret) && need_match_) {
+      if (OB_ISNULL(data = alloc_->alloc(ObBitVector::memory_size(batch_size)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        SQL_ENG_LOG(WARN, "failed to init hp_infra probe skip", K(ret));
+      } else {
+        probe_skip_ = to_bit_vector(data);
+        probe_skip_->reset(batch_size);
+      }
+    }
     return ret;
   }
 
@@ -366,8 +392,24 @@ public:
         alloc_->free(my_skip_);
         my_skip_ = nullptr;
       }
+      if (OB_NOT_NULL(alloc_) && OB_NOT_NULL(probe_skip_)) {
+        alloc_->free(probe_skip_);
+        probe_skip_ = nullptr;
+      }
     }
   }
+  // rows of hash table carry a match flag, must be set before start_round
+  void set_need_match() { need_match_ = true; }
+  const RowMeta &get_hash_store_row_meta() const { return preprocess_part_.store_.get_row_meta(); }
+  // probe hash table by rows of right side for intersect and except:
+  // output_vec is unset for the rows which are matched for the first time, and the matched
+  // items of hash table are marked. If left is dumped, rows not found are added to right
+  // dumped partitions.
+  int exists_batch(const common::ObIArray<ObExpr *> &exprs,
+                   uint64_t *hash_values_for_batch,
+                   const int64_t batch_size,
+                   const ObBitVector *skip,
+                   ObBitVector *&output_vec);
 
   int set_funcs(const common::ObIArray<ObSortFieldCollation> *sort_collations,
                 ObEvalCtx *eval_ctx)
@@ -402,6 +444,11 @@ protected:
                           const int64_t batch_size,
                           const ObBitVector *skip,
                           ObBitVector &my_skip) = 0;
+  virtual int probe_batch_for_match(uint64_t *hash_values_for_batch,
+                                    const int64_t batch_size,
+                                    const ObBitVector *skip,
+                                    ObBitVector &my_skip,
+                                    ObBitVector &miss_skip) = 0;
   bool is_left() const { return InputSide::LEFT == cur_side_; }
   bool is_right() const { return InputSide::RIGHT == cur_side_; }
 
@@ -502,6 +549,9 @@ protected:
   bool is_inited_vec_;
   common::ObFixedArray<ObIVector *, common::ObIAllocator> vector_ptrs_;
   int64_t max_batch_size_;
+  bool need_match_;
+  // rows which are not found in hash table when probing, used for dumping right rows
+  ObBitVector *probe_skip_;
 };
 
 template<typename HashBucket>
@@ -544,6 +594,11 @@ private:
                   const int64_t batch_size,
                   const ObBitVector *skip,
                   ObBitVector &my_skip) override;
+  int probe_batch_for_match(uint64_t *hash_values_for_batch,
+                            const int64_t batch_size,
+                            const ObBitVector *skip,
+                            ObBitVector &my_skip,
+                            ObBitVector &miss_skip) override;
   int64_t est_extend_hash_bucket_num(const int64_t bucket_num,
                                      const int64_t max_hash_mem,
                                      const int64_t min_bucket);
@@ -712,6 +767,21 @@ public:
   int64_t get_hash_store_mem_used() const;
   void destroy_my_skip();
   int64_t estimate_total_count() const;
+  void set_need_match();
+  void switch_left();
+  void switch_right();
+  bool has_cur_part(InputSide input_side);
+  bool has_left_dumped();
+  int get_right_next_batch(const common::ObIArray<ObExpr *> &exprs,
+                           const int64_t max_row_cnt,
+                           int64_t &read_rows,
+                           uint64_t *hash_values_for_batch);
+  int exists_batch(const common::ObIArray<ObExpr *> &exprs,
+                   uint64_t *hash_values_for_batch,
+                   const int64_t batch_size,
+                   const ObBitVector *skip,
+                   ObBitVector *&output_vec);
+  const RowMeta *get_hash_store_row_meta() const;
 private:
   static const int64_t MIN_BUCKET_NUM = 128;
   static const int64_t MAX_BUCKET_NUM = 131072;   // 1M = 131072 * 8
@@ -824,6 +894,12 @@ set_distinct_batch(const common::ObIArray<ObExpr *> &exprs,
                   const int64_t size,
                   ObCompactRow **stored_rows) -> int {
     ret = preprocess_part_.store_.add_batch(vectors, selector, size, stored_rows);
+    if (OB_SUCC(ret) && need_match_) {
+      const RowMeta &row_meta = preprocess_part_.store_.get_row_meta();
+      for (int64_t i = 0; i < size; ++i) {
+        static_cast<ObHashPartItem *>(stored_rows[i])->set_is_match(row_meta, false);
+      }
+    }
     return ret;
   };
   if (!is_push_down_ && OB_FAIL(prefetch<HashBucket>(hash_values_for_batch, batch_size, skip))) {
@@ -868,6 +944,46 @@ probe_batch(uint64_t *hash_values_for_batch,
   return ret;
 }
 
+template<typename HashBucket>
+int ObHashPartInfrastructureVec<HashBucket>::
+probe_batch_for_match(uint64_t *hash_values_for_batch,
+                      const int64_t batch_size,
+                      const ObBitVector *skip,
+                      ObBitVector &my_skip,
+                      ObBitVector &miss_skip)
+{
+  int ret = OB_SUCCESS;
+  const ObHashPartItem *exists_item = nullptr;
+  const RowMeta &row_meta = preprocess_part_.store_.get_row_meta();
+  ObEvalCtx::BatchInfoScopeGuard batch_info_guard(*eval_ctx_);
+  batch_info_guard.set_batch_idx(0);
+  batch_info_guard.set_batch_size(batch_size);
+  if (!is_push_down_ && OB_FAIL(prefetch<HashBucket>(hash_values_for_batch, batch_size, skip))) {
+    SQL_ENG_LOG(WARN, "failed to prefetch", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; ++i) {
+    if (OB_NOT_NULL(skip) && skip->at(i)) {
+      my_skip.set(i);
+      miss_skip.set(i);
+      continue;
+    }
+    batch_info_guard.set_batch_idx(i);
+    if (OB_FAIL(hash_table_.get(row_meta, i, hash_values_for_batch[i], exists_item))) {
+      SQL_ENG_LOG(WARN, "failed to get item", K(ret));
+    } else if (OB_ISNULL(exists_item)) {
+      my_skip.set(i);
+    } else {
+      miss_skip.set(i);
+      if (exists_item->is_match(row_meta)) {
+        my_skip.set(i);
+      } else {
+        const_cast<ObHashPartItem *>(exists_item)->set_is_match(row_meta, true);
+      }
+    }
+  }
+  return ret;
+}
+
 //////////////////// end ObHashPartInfrastructureVec //////////////////
 template<typename BktType>
 int ObHashPartInfrastructureVecImpl::alloc_hp_infras_impl_instance(const int64_t tenant_id,
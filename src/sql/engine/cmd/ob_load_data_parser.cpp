@@ -18,6 +18,10 @@
 #include "lib/utility/ob_print_utils.h"
 #include "lib/string/ob_hex_utils_base.h"
 #include "deps/oblib/src/lib/list/ob_dlist.h"
+#include "common/ob_target_specific.h"
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 using namespace oceanbase::sql;
 using namespace oceanbase::common;
@@ -28,8 +32,85 @@ namespace sql
 {
 const char INVALID_TERM_CHAR = '\xff';
 
+OB_DECLARE_DEFAULT_CODE(
+static const char *find_csv_special_char(const char *str, const char *end,
+                                         const char *special_chars,
+                                         const bool stop_at_mb_char)
+{
+  const char c0 = special_chars[0];
+  const char c1 = special_chars[1];
+  const char c2 = special_chars[2];
+  const char c3 = special_chars[3];
+  for (; str < end; ++str) {
+    const char c = *str;
+    if (c == c0 || c == c1 || c == c2 || c == c3 || (stop_at_mb_char && (c & 0x80))) {
+      break;
+    }
+  }
+  return str;
+}
+)
+
+OB_DECLARE_SSE42_SPECIFIC_CODE(
+static const char *find_csv_special_char(const char *str, const char *end,
+                                         const char *special_chars,
+                                         const bool stop_at_mb_char)
+{
+  const __m128i c0 = _mm_set1_epi8(special_chars[0]);
+  const __m128i c1 = _mm_set1_epi8(special_chars[1]);
+  const __m128i c2 = _mm_set1_epi8(special_chars[2]);
+  const __m128i c3 = _mm_set1_epi8(special_chars[3]);
+  const uint32_t mb_mask = stop_at_mb_char ? 0xFFFF : 0;
+  bool found = false;
+  while (!found && str + 16 <= end) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str));
+    const __m128i eq = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, c0), _mm_cmpeq_epi8(v, c1)),
+                                    _mm_or_si128(_mm_cmpeq_epi8(v, c2), _mm_cmpeq_epi8(v, c3)));
+    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(eq))
+                          | (static_cast<uint32_t>(_mm_movemask_epi8(v)) & mb_mask);
+    if (0 != mask) {
+      str += __builtin_ctz(mask);
+      found = true;
+    } else {
+      str += 16;
+    }
+  }
+  return found ? str : specific::normal::find_csv_special_char(str, end, special_chars, stop_at_mb_char);
+}
+)
+
+OB_DECLARE_AVX2_SPECIFIC_CODE(
+static const char *find_csv_special_char(const char *str, const char *end,
+                                         const char *special_chars,
+                                         const bool stop_at_mb_char)
+{
+  const __m256i c0 = _mm256_set1_epi8(special_chars[0]);
+  const __m256i c1 = _mm256_set1_epi8(special_chars[1]);
+  const __m256i c2 = _mm256_set1_epi8(special_chars[2]);
+  const __m256i c3 = _mm256_set1_epi8(special_chars[3]);
+  const uint32_t mb_mask = stop_at_mb_char ? 0xFFFFFFFF : 0;
+  bool found = false;
+  while (!found && str + 32 <= end) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(str));
+    const __m256i eq = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, c0), _mm256_cmpeq_epi8(v, c1)),
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, c2), _mm256_cmpeq_epi8(v, c3)));
+    const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq))
+                          | (static_cast<uint32_t>(_mm256_movemask_epi8(v)) & mb_mask);
+    if (0 != mask) {
+      str += __builtin_ctz(mask);
+      found = true;
+    } else {
+      str += 32;
+    }
+  }
+  return found ? str : specific::normal::find_csv_special_char(str, end, special_chars, stop_at_mb_char);
+}
+)
+
 const char * FORMAT_TYPE_STR[] = {
   "CSV",
+  "PARQUET",
 };
 static_assert(array_elements(FORMAT_TYPE_STR) == ObExternalFileFormat::MAX_FORMAT, "Not enough initializer for ObExternalFileFormat");
 
@@ -105,6 +186,26 @@ int ObCSVGeneralParser::init_opt_variables()
         && !opt_param_.is_same_escape_enclosed_
         && format_.field_enclosed_char_ == INT64_MAX;
 
+    // unused slots repeat the field terminator, so that every slot can be compared
+    opt_param_.special_chars_[0] = opt_param_.field_term_c_;
+    opt_param_.special_chars_[1] = opt_param_.line_term_c_;
+    opt_param_.special_chars_[2] = (INT64_MAX == format_.field_escaped_char_)
+        ? opt_param_.field_term_c_ : static_cast<char>(format_.field_escaped_char_);
+    opt_param_.special_chars_[3] = (INT64_MAX == format_.field_enclosed_char_)
+        ? opt_param_.field_term_c_ : static_cast<char>(format_.field_enclosed_char_);
+    // bytes of multi-byte chars may look like special chars in gbk and gb18030
+    opt_param_.stop_at_mb_char_ = (CHARSET_BINARY != format_.cs_type_);
+#if OB_USE_MULTITARGET_CODE
+    if (is_arch_supported(ObTargetArch::AVX2)) {
+      find_special_char_ = specific::avx2::find_csv_special_char;
+    } else if (is_arch_supported(ObTargetArch::SSE42)) {
+      find_special_char_ = specific::sse42::find_csv_special_char;
+    } else {
+      find_special_char_ = specific::normal::find_csv_special_char;
+    }
+#else
+    find_special_char_ = specific::normal::find_csv_special_char;
+#endif
   }
 
   if (OB_SUCC(ret) && OB_FAIL(fields_per_line_.prepare_allocate(format_.file_column_nums_))) {
@@ -346,6 +447,9 @@ int64_t ObExternalFileFormat::to_string(char *buf, const int64_t buf_len) const
       pos += csv_format_.to_json_kv_string(buf + pos, buf_len - pos);
       pos += origin_file_format_str_.to_json_kv_string(buf + pos, buf_len - pos);
       break;
+    case PARQUET_FORMAT:
+      // columnar file is self-describing, no extra option
+      break;
     default:
       pos = 0;
   }
@@ -389,6 +493,10 @@ int ObExternalFileFormat::load_from_string(const ObString &str, ObIAllocator &al
           OZ (csv_format_.load_from_json_data(format_type_node, allocator));
           OZ (origin_file_format_str_.load_from_json_data(format_type_node, allocator));
           break;
+        case PARQUET_FORMAT:
+          // values of parquet file columns are presented as utf8 strings
+          csv_format_.cs_type_ = CHARSET_UTF8MB4;
+          break;
         default:
           ret = OB_ERR_UNEXPECTED;
           LOG_WARN("invalid format type", K(ret), K(format_type_str));
@@ -105,22 +105,34 @@ public:
     };
     TO_STRING_KV(KP(ptr_), K(len_), K(flags_), "string", common::ObString(len_, ptr_));
   };
+  static const int64_t SPECIAL_CHAR_CNT = 4;
   struct OptParams {
     OptParams() : line_term_c_(0), field_term_c_(0),
       is_filling_zero_to_empty_field_(false),
       is_line_term_by_counting_field_(false),
       is_same_escape_enclosed_(false),
-      is_simple_format_(false)
-    {}
+      is_simple_format_(false),
+      stop_at_mb_char_(true)
+    {
+      MEMSET(special_chars_, 0, sizeof(special_chars_));
+    }
     char line_term_c_;
     char field_term_c_;
     bool is_filling_zero_to_empty_field_;
     bool is_line_term_by_counting_field_;
     bool is_same_escape_enclosed_;
     bool is_simple_format_;
+    // chars which may change the state of scanning: terminators, escaped char and enclosed char
+    char special_chars_[SPECIAL_CHAR_CNT];
+    // stop at bytes >= 0x80, let mbcharlen decide the length of multi-byte chars
+    bool stop_at_mb_char_;
   };
+  // return the first special char in [str, end), or end if not found
+  typedef const char *(*FindSpecialCharFunc)(const char *str, const char *end,
+                                             const char *special_chars,
+                                             const bool stop_at_mb_char);
 public:
-  ObCSVGeneralParser() {}
+  ObCSVGeneralParser() : find_special_char_(nullptr) {}
   int init(const ObCSVGeneralFormat &format);
 
   int init(const ObDataInFileStruct &format,
@@ -247,6 +259,7 @@ protected:
   ObCSVGeneralFormat format_;
   common::ObSEArray<FieldValue, 1> fields_per_line_;
   OptParams opt_param_;
+  FindSpecialCharFunc find_special_char_;
 };
 
 
@@ -390,6 +403,8 @@ int ObCSVGeneralParser::scan_proto(const char *&str,
           if (!is_term) {
             int mb_len = mbcharlen<cs_type>(str, end);
             str += mb_len;
+            // skip the plain chars in bulk, they never change the state of scanning
+            str = find_special_char_(str, end, opt_param_.special_chars_, opt_param_.stop_at_mb_char_);
           }
         }
       }
@@ -495,6 +510,7 @@ struct ObExternalFileFormat
   enum FormatType {
     INVALID_FORMAT = -1,
     CSV_FORMAT,
+    PARQUET_FORMAT,
     MAX_FORMAT
   };
 
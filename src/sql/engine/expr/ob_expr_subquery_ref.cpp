@@ -304,6 +304,9 @@ int ObExprSubQueryRef::expr_eval(
   const ExtraInfo *extra_info = static_cast<ExtraInfo *>(expr.extra_info_);
   ObDatum *datum = NULL;
   ObSubQueryIterator *iter = NULL;
+  ObDatum cached_out;
+  bool found_in_hash_map = false;
+  bool probed_hash_map = false;
   //对所有iter 进行reset操作
   if (OB_ISNULL(extra_info)) {
     ret = OB_ERR_UNEXPECTED;
@@ -313,6 +316,23 @@ int ObExprSubQueryRef::expr_eval(
   } else if (OB_ISNULL(iter)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("null iter returned", K(ret));
+  } else if (extra.is_scalar_ && !extra_info->is_cursor_ && iter->can_skip_rewind()) {
+    // probe result cache first, rescan of subplan is not needed if the same
+    // exec params have been calculated before
+    probed_hash_map = true;
+    if (OB_FAIL(iter->get_curr_probe_row())) {
+      LOG_WARN("failed to get probe row", K(ret));
+    } else if (OB_FAIL(iter->get_refactored(cached_out))) {
+      if (OB_HASH_NOT_EXIST != ret) {
+        LOG_WARN("failed to find in hash map", K(ret));
+      } else {
+        ret = OB_SUCCESS;
+      }
+    } else {
+      found_in_hash_map = true;
+    }
+  }
+  if (OB_FAIL(ret) || found_in_hash_map) {
   } else if (OB_FAIL(iter->rewind())) {
     LOG_WARN("filter to rewind subquery iterator", K(ret));
   }
@@ -390,9 +410,12 @@ int ObExprSubQueryRef::expr_eval(
       LOG_USER_ERROR(OB_ERR_INVALID_COLUMN_NUM, 1L);
     } else {
       bool iter_end = false;
-      bool found_in_hash_map = false;
       bool is_hash_enabled = iter->has_hashmap();
-      if (is_hash_enabled) {
+      if (found_in_hash_map) {
+        if (OB_FAIL(expr.deep_copy_datum(ctx, cached_out))) {
+          LOG_WARN("failed to deep copy datum", K(ret));
+        }
+      } else if (is_hash_enabled && !probed_hash_map) {
         ObDatum out;
         if (OB_FAIL(iter->get_curr_probe_row())) {
           LOG_WARN("failed to get probe row", K(ret));
@@ -415,6 +438,8 @@ int ObExprSubQueryRef::expr_eval(
           ret = OB_SUCCESS;
           iter_end = true;
           expr_datum.set_null();
+          // empty result is cached as null too
+          datum = &expr_datum;
         } else {
           LOG_WARN("get next row from subquery failed", K(ret));
         }
@@ -427,7 +452,7 @@ int ObExprSubQueryRef::expr_eval(
       if (OB_SUCC(ret) && is_hash_enabled
                        && iter->probe_row_.cnt_ > 0
                        && !found_in_hash_map
-                       && !iter_end) {
+                       && OB_NOT_NULL(datum)) {
         //now we can insert curr row and curr result into hashmap
         //first to get arena allocator from sp_iter to deep copy row
         ObDatum value;
@@ -0,0 +1,700 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/join/ob_merge_join_vec_op.h"
+#include "sql/engine/ob_exec_context.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace sql
+{
+
+OB_SERIALIZE_MEMBER((ObMergeJoinVecSpec, ObJoinVecSpec),
+                    equal_cond_infos_,
+                    merge_directions_,
+                    is_left_unique_,
+                    left_child_fetcher_all_exprs_,
+                    right_child_fetcher_all_exprs_);
+
+const int64_t ObMergeJoinVecSpec::MERGE_DIRECTION_ASC = 1;
+const int64_t ObMergeJoinVecSpec::MERGE_DIRECTION_DESC = -1;
+
+int ObMergeJoinVecSpec::set_merge_directions(const ObIArray<ObOrderDirection> &merge_directions)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(merge_directions_.init(merge_directions.count()))) {
+    LOG_WARN("fail to init merge direction", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < merge_directions.count(); i++) {
+    if (OB_FAIL(merge_directions_.push_back(is_ascending_direction(merge_directions.at(i))
+                                            ? MERGE_DIRECTION_ASC : MERGE_DIRECTION_DESC))) {
+      LOG_WARN("failed to add merge direction", K(ret), K(i));
+    }
+  }
+  return ret;
+}
+
+ObMergeJoinVecOp::ObMergeJoinVecOp(ObExecContext &exec_ctx, const ObOpSpec &spec,
+                                   ObOpInput *input)
+  : ObJoinVecOp(exec_ctx, spec, input),
+    state_(JS_MERGE),
+    left_unique_(false),
+    left_side_(),
+    right_side_(),
+    group_left_idx_(0),
+    group_right_idx_(0),
+    output_mode_(OUTPUT_NONE),
+    output_cnt_(0),
+    output_cap_(0),
+    output_left_rows_(NULL),
+    output_right_rows_(NULL),
+    output_left_idx_(NULL),
+    output_right_idx_(NULL)
+{
+}
+
+int ObMergeJoinVecOp::inner_open()
+{
+  int ret = OB_SUCCESS;
+  ObIAllocator &alloc = ctx_.get_allocator();
+  const int64_t batch_size = MY_SPEC.max_batch_size_;
+  if (OB_FAIL(ObJoinVecOp::inner_open())) {
+    LOG_WARN("failed to open in base class", K(ret));
+  } else if (OB_UNLIKELY(MY_SPEC.equal_cond_infos_.count()
+                         != MY_SPEC.merge_directions_.count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("equal conditions and merge directions mismatch", K(ret),
+             K(MY_SPEC.equal_cond_infos_.count()), K(MY_SPEC.merge_directions_.count()));
+  } else if (OB_ISNULL(output_left_rows_ = static_cast<ObCompactRow **>(
+                       alloc.alloc(sizeof(ObCompactRow *) * batch_size)))
+             || OB_ISNULL(output_right_rows_ = static_cast<ObCompactRow **>(
+                          alloc.alloc(sizeof(ObCompactRow *) * batch_size)))
+             || OB_ISNULL(output_left_idx_ = static_cast<int64_t *>(
+                          alloc.alloc(sizeof(int64_t) * batch_size)))
+             || OB_ISNULL(output_right_idx_ = static_cast<int64_t *>(
+                          alloc.alloc(sizeof(int64_t) * batch_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(batch_size));
+  } else if (OB_FAIL(init_side(left_side_, left_, MY_SPEC.left_child_fetcher_all_exprs_, true))) {
+    LOG_WARN("init left side failed", K(ret));
+  } else if (OB_FAIL(init_side(right_side_, right_, MY_SPEC.right_child_fetcher_all_exprs_,
+                               false))) {
+    LOG_WARN("init right side failed", K(ret));
+  } else {
+    // null keys of unique left rows may be equal by null safe equal
+    left_unique_ = MY_SPEC.is_left_unique_;
+    for (int64_t i = 0; left_unique_ && i < MY_SPEC.equal_cond_infos_.count(); i++) {
+      if (T_OP_NSEQ == MY_SPEC.equal_cond_infos_.at(i).expr_->type_) {
+        left_unique_ = false;
+      }
+    }
+  }
+  LOG_TRACE("merge join left unique", K(MY_SPEC.id_), K(MY_SPEC.is_left_unique_), K(left_unique_));
+  return ret;
+}
+
+int ObMergeJoinVecOp::inner_rescan()
+{
+  int ret = OB_SUCCESS;
+  reset();
+  for (int64_t i = 0; OB_SUCC(ret) && i < 2; i++) {
+    if (OB_FAIL(init_store(left_side_, left_side_.stores_[i]))) {
+      LOG_WARN("init left row store failed", K(ret));
+    } else if (OB_FAIL(init_store(right_side_, right_side_.stores_[i]))) {
+      LOG_WARN("init right row store failed", K(ret));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(ObJoinVecOp::inner_rescan())) {
+    LOG_WARN("failed to rescan ObJoinVecOp", K(ret));
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::inner_close()
+{
+  reset();
+  return ObJoinVecOp::inner_close();
+}
+
+void ObMergeJoinVecOp::destroy()
+{
+  reset();
+  left_side_.rows_.destroy();
+  left_side_.matched_.destroy();
+  right_side_.rows_.destroy();
+  right_side_.matched_.destroy();
+  ObJoinVecOp::destroy();
+}
+
+void ObMergeJoinVecOp::reset()
+{
+  state_ = JS_MERGE;
+  reset_side(left_side_);
+  reset_side(right_side_);
+  group_left_idx_ = 0;
+  group_right_idx_ = 0;
+  output_mode_ = OUTPUT_NONE;
+  output_cnt_ = 0;
+}
+
+void ObMergeJoinVecOp::reset_side(ChildSide &side)
+{
+  side.stores_[0].reset();
+  side.stores_[1].reset();
+  side.cur_store_ = 0;
+  side.rows_.reuse();
+  side.cur_ = 0;
+  side.iter_end_ = false;
+  side.group_start_ = 0;
+  side.group_end_ = 0;
+  side.matched_.reuse();
+}
+
+int ObMergeJoinVecOp::inner_get_next_row()
+{
+  int ret = OB_ERR_UNEXPECTED;
+  LOG_WARN("vectorized merge join should not call get_next_row", K(ret));
+  return ret;
+}
+
+int ObMergeJoinVecOp::init_side(ChildSide &side, ObOperator *child,
+                                const ExprFixedArray &all_exprs, const bool is_left)
+{
+  int ret = OB_SUCCESS;
+  side.child_ = child;
+  side.all_exprs_ = &all_exprs;
+  side.key_cols_.reuse();
+  for (int64_t i = 0; OB_SUCC(ret) && i < MY_SPEC.equal_cond_infos_.count(); i++) {
+    const ObMergeJoinVecSpec::EqualConditionInfo &info = MY_SPEC.equal_cond_infos_.at(i);
+    // left child key is args_[1] if the equal condition is opposite
+    ObExpr *key = (is_left != info.is_opposite_) ? info.expr_->args_[0] : info.expr_->args_[1];
+    int64_t idx = OB_INVALID_INDEX;
+    if (!has_exist_in_array(all_exprs, key, &idx)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("join key not in child fetcher exprs", K(ret), K(i), K(is_left));
+    } else if (OB_FAIL(side.key_cols_.push_back(idx))) {
+      LOG_WARN("push back failed", K(ret));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_ISNULL(child)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("child is null", K(ret), K(is_left));
+  } else if (OB_ISNULL(side.batch_rows_ = static_cast<ObCompactRow **>(
+                       ctx_.get_allocator().alloc(sizeof(ObCompactRow *)
+                                                  * MY_SPEC.max_batch_size_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret));
+  } else if (OB_FAIL(init_store(side, side.stores_[0]))) {
+    LOG_WARN("init row store failed", K(ret));
+  } else if (OB_FAIL(init_store(side, side.stores_[1]))) {
+    LOG_WARN("init row store failed", K(ret));
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::init_store(ChildSide &side, ObTempRowStore &store)
+{
+  int ret = OB_SUCCESS;
+  const uint64_t tenant_id = ctx_.get_my_session()->get_effective_tenant_id();
+  ObMemAttr mem_attr(tenant_id, ObModIds::OB_SQL_MERGE_JOIN, ObCtxIds::WORK_AREA);
+  if (OB_FAIL(store.init(*side.all_exprs_, MY_SPEC.max_batch_size_, mem_attr,
+                         0 /* mem_limit */, false /* enable_dump */, 0 /* row_extra_size */))) {
+    LOG_WARN("init row store failed", K(ret));
+  } else if (OB_FAIL(store.init_batch_ctx())) {
+    LOG_WARN("init batch ctx failed", K(ret));
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::fetch_rows(ChildSide &side, const int64_t keep_from)
+{
+  int ret = OB_SUCCESS;
+  const ObBatchRows *child_brs = NULL;
+  int64_t stored_cnt = 0;
+  if (keep_from > 0 && OB_FAIL(release_rows(side, keep_from))) {
+    LOG_WARN("release rows failed", K(ret), K(keep_from));
+  } else if (OB_FAIL(side.child_->get_next_batch(MY_SPEC.max_batch_size_, child_brs))) {
+    LOG_WARN("get next batch failed", K(ret));
+  } else if (FALSE_IT(clear_evaluated_flag())) {
+  } else if (OB_FAIL(side.stores_[side.cur_store_].add_batch(*side.all_exprs_, eval_ctx_,
+                                                             *child_brs, stored_cnt,
+                                                             side.batch_rows_))) {
+    LOG_WARN("add batch failed", K(ret));
+  } else {
+    side.iter_end_ = child_brs->end_;
+    for (int64_t i = 0; OB_SUCC(ret) && i < stored_cnt; i++) {
+      if (OB_FAIL(side.rows_.push_back(side.batch_rows_[i]))) {
+        LOG_WARN("push back failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+// copy rows in [keep_from, rows_.count()) to the other store and release the current store
+int ObMergeJoinVecOp::release_rows(ChildSide &side, const int64_t keep_from)
+{
+  int ret = OB_SUCCESS;
+  ObTempRowStore &src = side.stores_[side.cur_store_];
+  ObTempRowStore &dst = side.stores_[1 - side.cur_store_];
+  const int64_t pending_cnt = side.rows_.count() - keep_from;
+  for (int64_t i = 0; OB_SUCC(ret) && i < pending_cnt; i++) {
+    ObCompactRow *row = NULL;
+    if (OB_FAIL(dst.add_row(side.rows_.at(keep_from + i), row))) {
+      LOG_WARN("add row failed", K(ret));
+    } else {
+      side.rows_.at(i) = row;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    while (side.rows_.count() > pending_cnt) {
+      side.rows_.pop_back();
+    }
+    src.reset();
+    side.cur_store_ = 1 - side.cur_store_;
+    side.cur_ = side.cur_ > keep_from ? side.cur_ - keep_from : 0;
+    side.group_start_ = side.group_start_ > keep_from ? side.group_start_ - keep_from : 0;
+    side.group_end_ = side.group_end_ > keep_from ? side.group_end_ - keep_from : 0;
+    if (OB_FAIL(init_store(side, src))) {
+      LOG_WARN("init row store failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::compare(const int64_t l_idx, const int64_t r_idx, int64_t &cmp_res) const
+{
+  int ret = OB_SUCCESS;
+  cmp_res = 0;
+  for (int64_t i = 0; OB_SUCC(ret) && 0 == cmp_res && i < MY_SPEC.equal_cond_infos_.count(); i++) {
+    const ObMergeJoinVecSpec::EqualConditionInfo &equal_cond = MY_SPEC.equal_cond_infos_.at(i);
+    const ObDatum l_datum = get_key(left_side_, l_idx, i);
+    const ObDatum r_datum = get_key(right_side_, r_idx, i);
+    if (l_datum.is_null() && r_datum.is_null()) {
+      cmp_res = (T_OP_NSEQ == equal_cond.expr_->type_) ? 0 : -1;
+    } else {
+      int cmp_ret = 0;
+      if (OB_FAIL(equal_cond.ns_cmp_func_(l_datum, r_datum, cmp_ret))) {
+        LOG_WARN("failed to compare", K(ret));
+      } else if (cmp_ret != 0) {
+        cmp_res = cmp_ret;
+        cmp_res *= MY_SPEC.merge_directions_.at(i);
+      }
+    }
+  }
+  return ret;
+}
+
+template <typename Pred>
+int ObMergeJoinVecOp::gallop(const ChildSide &side, const int64_t begin, Pred &pred,
+                             int64_t &end) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t cnt = side.rows_.count();
+  // %pred is true in [begin, lo) and false at %hi if %hi < cnt
+  int64_t lo = begin;
+  int64_t hi = begin;
+  int64_t step = 1;
+  bool res = true;
+  while (OB_SUCC(ret) && res && hi < cnt) {
+    if (OB_FAIL(pred(hi, res))) {
+      LOG_WARN("check row failed", K(ret), K(hi));
+    } else if (res) {
+      lo = hi + 1;
+      hi += step;
+      step <<= 1;
+    }
+  }
+  hi = std::min(hi, cnt);
+  while (OB_SUCC(ret) && lo < hi) {
+    const int64_t mid = lo + (hi - lo) / 2;
+    if (OB_FAIL(pred(mid, res))) {
+      LOG_WARN("check row failed", K(ret), K(mid));
+    } else if (res) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    end = lo;
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  bool has_output = false;
+  output_cap_ = std::min(max_row_cnt, MY_SPEC.max_batch_size_);
+  while (OB_SUCC(ret) && !has_output) {
+    bool need_flush = false;
+    switch (state_) {
+      case JS_MERGE: {
+        ret = merge(need_flush);
+        break;
+      }
+      case JS_GROUP_PAIRS: {
+        ret = join_group_pairs(need_flush);
+        break;
+      }
+      case JS_GROUP_LEFT: {
+        ret = output_group_side(left_side_, true, need_flush);
+        break;
+      }
+      case JS_GROUP_RIGHT: {
+        ret = output_group_side(right_side_, false, need_flush);
+        break;
+      }
+      case JS_DRAIN_LEFT: {
+        ret = drain_side(left_side_, true, need_flush);
+        break;
+      }
+      case JS_DRAIN_RIGHT: {
+        ret = drain_side(right_side_, false, need_flush);
+        break;
+      }
+      case JS_JOIN_END: {
+        break;
+      }
+      default: {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected join state", K(ret), K(state_));
+        break;
+      }
+    }
+    if (OB_FAIL(ret)) {
+      LOG_WARN("merge join failed", K(ret), K(state_));
+    } else if (!need_flush && output_cnt_ < output_cap_ && JS_JOIN_END != state_) {
+      // continue
+    } else if (output_cnt_ > 0) {
+      if (OB_FAIL(flush_output(has_output))) {
+        LOG_WARN("flush output failed", K(ret));
+      }
+    } else if (JS_JOIN_END == state_) {
+      brs_.size_ = 0;
+      brs_.end_ = true;
+      has_output = true;
+    }
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::merge(bool &need_flush)
+{
+  int ret = OB_SUCCESS;
+  ChildSide &l = left_side_;
+  ChildSide &r = right_side_;
+  int64_t cmp_res = 0;
+  if ((!l.has_row() && !l.iter_end_) || (!r.has_row() && !r.iter_end_)) {
+    // stored rows may be released when fetching, output rows first
+    if (output_cnt_ > 0) {
+      need_flush = true;
+    } else if (!l.has_row() && !l.iter_end_ && OB_FAIL(fetch_rows(l, l.cur_))) {
+      LOG_WARN("fetch left rows failed", K(ret));
+    } else if (!r.has_row() && !r.iter_end_ && OB_FAIL(fetch_rows(r, r.cur_))) {
+      LOG_WARN("fetch right rows failed", K(ret));
+    }
+  } else if (l.end() || r.end()) {
+    if (!l.end()) {
+      state_ = need_left_unmatched() ? JS_DRAIN_LEFT : JS_JOIN_END;
+    } else if (!r.end()) {
+      state_ = need_right_unmatched() ? JS_DRAIN_RIGHT : JS_JOIN_END;
+    } else {
+      state_ = JS_JOIN_END;
+    }
+  } else if (OB_FAIL(compare(l.cur_, r.cur_, cmp_res))) {
+    LOG_WARN("compare failed", K(ret));
+  } else if (cmp_res < 0) {
+    // all left rows less than the current right row can not be joined
+    int64_t end = l.cur_;
+    auto pred = [&](const int64_t idx, bool &res) -> int {
+      int64_t cmp = 0;
+      int tmp_ret = compare(idx, r.cur_, cmp);
+      res = cmp < 0;
+      return tmp_ret;
+    };
+    if (OB_FAIL(gallop(l, l.cur_, pred, end))) {
+      LOG_WARN("gallop failed", K(ret));
+    } else if (!need_left_unmatched()) {
+      l.cur_ = end;
+    } else {
+      for (; l.cur_ < end && can_append(OUTPUT_LEFT); l.cur_++) {
+        append_output(OUTPUT_LEFT, l.rows_.at(l.cur_), NULL, l.cur_, -1);
+      }
+      need_flush = l.cur_ < end;
+    }
+  } else if (cmp_res > 0) {
+    int64_t end = r.cur_;
+    auto pred = [&](const int64_t idx, bool &res) -> int {
+      int64_t cmp = 0;
+      int tmp_ret = compare(l.cur_, idx, cmp);
+      res = cmp > 0;
+      return tmp_ret;
+    };
+    if (OB_FAIL(gallop(r, r.cur_, pred, end))) {
+      LOG_WARN("gallop failed", K(ret));
+    } else if (!need_right_unmatched()) {
+      r.cur_ = end;
+    } else {
+      for (; r.cur_ < end && can_append(OUTPUT_RIGHT); r.cur_++) {
+        append_output(OUTPUT_RIGHT, NULL, r.rows_.at(r.cur_), -1, r.cur_);
+      }
+      need_flush = r.cur_ < end;
+    }
+  } else if (output_cnt_ > 0) {
+    // rows may be fetched when locating the equal key groups
+    need_flush = true;
+  } else if (OB_FAIL(find_group(l, true))) {
+    LOG_WARN("find left group failed", K(ret));
+  } else if (OB_FAIL(find_group(r, false))) {
+    LOG_WARN("find right group failed", K(ret));
+  } else if (OB_FAIL(start_group())) {
+    LOG_WARN("start group failed", K(ret));
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::find_group(ChildSide &side, const bool is_left)
+{
+  int ret = OB_SUCCESS;
+  const int64_t r_cur = right_side_.cur_;
+  const int64_t l_start = left_side_.group_start_;
+  int64_t begin = side.cur_;
+  int64_t end = side.cur_;
+  bool found = false;
+  auto pred = [&](const int64_t idx, bool &res) -> int {
+    int64_t cmp = 0;
+    int tmp_ret = is_left ? compare(idx, r_cur, cmp) : compare(l_start, idx, cmp);
+    res = 0 == cmp;
+    return tmp_ret;
+  };
+  side.group_start_ = side.cur_;
+  side.group_end_ = side.cur_;
+  if (is_left && left_unique_) {
+    // the current left row is equal to the current right row, and no other left row has its key
+    side.group_end_ = side.cur_ + 1;
+    found = true;
+  }
+  while (OB_SUCC(ret) && !found) {
+    if (OB_FAIL(gallop(side, begin, pred, end))) {
+      LOG_WARN("gallop failed", K(ret));
+    } else if (end < side.rows_.count() || side.iter_end_) {
+      side.group_end_ = end;
+      found = true;
+    } else {
+      // group may continue in the next batch
+      const int64_t shift = side.group_start_;
+      side.group_end_ = end;
+      if (OB_FAIL(fetch_rows(side, side.group_start_))) {
+        LOG_WARN("fetch rows failed", K(ret));
+      } else {
+        begin = end - shift;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::start_group()
+{
+  int ret = OB_SUCCESS;
+  // all rows in groups are matched if there is no other join condition
+  const uint8_t init_flag = MY_SPEC.other_join_conds_.empty() ? 1 : 0;
+  ChildSide *sides[2] = { &left_side_, &right_side_ };
+  for (int64_t i = 0; OB_SUCC(ret) && i < 2; i++) {
+    ChildSide &side = *sides[i];
+    side.matched_.reuse();
+    if (OB_FAIL(side.matched_.prepare_allocate(side.group_cnt()))) {
+      LOG_WARN("prepare allocate failed", K(ret), K(side.group_cnt()));
+    } else if (side.group_cnt() > 0) {
+      MEMSET(&side.matched_.at(0), init_flag, side.group_cnt());
+    }
+  }
+  if (OB_SUCC(ret)) {
+    group_left_idx_ = 0;
+    group_right_idx_ = 0;
+    state_ = (is_semi_anti() && MY_SPEC.other_join_conds_.empty())
+             ? JS_GROUP_LEFT : JS_GROUP_PAIRS;
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::join_group_pairs(bool &need_flush)
+{
+  int ret = OB_SUCCESS;
+  ChildSide &l = left_side_;
+  ChildSide &r = right_side_;
+  const OutputMode mode = is_semi_anti() ? OUTPUT_PAIR_CHECK : OUTPUT_PAIR;
+  const bool skip_left_matched = LEFT_SEMI_JOIN == MY_SPEC.join_type_
+                                 || LEFT_ANTI_JOIN == MY_SPEC.join_type_;
+  const bool skip_right_matched = RIGHT_SEMI_JOIN == MY_SPEC.join_type_
+                                  || RIGHT_ANTI_JOIN == MY_SPEC.join_type_;
+  while (!need_flush && group_left_idx_ < l.group_cnt()) {
+    if (skip_left_matched && l.matched_.at(group_left_idx_)) {
+      // semi/anti join only need to know whether the row is matched, skip the rest pairs
+      group_right_idx_ = r.group_cnt() - 1;
+    } else if (skip_right_matched && r.matched_.at(group_right_idx_)) {
+    } else if (!can_append(mode)) {
+      need_flush = true;
+    } else {
+      append_output(mode, l.rows_.at(l.group_start_ + group_left_idx_),
+                    r.rows_.at(r.group_start_ + group_right_idx_),
+                    group_left_idx_, group_right_idx_);
+    }
+    if (!need_flush && ++group_right_idx_ >= r.group_cnt()) {
+      group_right_idx_ = 0;
+      group_left_idx_ += 1;
+    }
+  }
+  if (OB_SUCC(ret) && !need_flush) {
+    group_left_idx_ = 0;
+    group_right_idx_ = 0;
+    state_ = JS_GROUP_LEFT;
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::output_group_side(ChildSide &side, const bool is_left, bool &need_flush)
+{
+  int ret = OB_SUCCESS;
+  const ObJoinType join_type = MY_SPEC.join_type_;
+  const bool output_unmatched = is_left ? need_left_unmatched() : need_right_unmatched();
+  const bool output_matched = is_left ? LEFT_SEMI_JOIN == join_type
+                                      : RIGHT_SEMI_JOIN == join_type;
+  const OutputMode mode = is_left ? OUTPUT_LEFT : OUTPUT_RIGHT;
+  int64_t &idx = is_left ? group_left_idx_ : group_right_idx_;
+  if (output_cnt_ > 0 && (OUTPUT_PAIR == output_mode_ || OUTPUT_PAIR_CHECK == output_mode_)) {
+    // match flags are updated when joined rows are flushed
+    need_flush = true;
+  } else if (output_unmatched || output_matched) {
+    for (; !need_flush && idx < side.group_cnt(); idx++) {
+      const bool matched = side.matched_.at(idx);
+      if (matched != output_matched) {
+      } else if (!can_append(mode)) {
+        need_flush = true;
+        break;
+      } else if (is_left) {
+        append_output(mode, side.rows_.at(side.group_start_ + idx), NULL, idx, -1);
+      } else {
+        append_output(mode, NULL, side.rows_.at(side.group_start_ + idx), -1, idx);
+      }
+    }
+  }
+  if (OB_SUCC(ret) && !need_flush) {
+    if (is_left) {
+      state_ = JS_GROUP_RIGHT;
+    } else {
+      left_side_.cur_ = left_side_.group_end_;
+      right_side_.cur_ = right_side_.group_end_;
+      state_ = JS_MERGE;
+    }
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::drain_side(ChildSide &side, const bool is_left, bool &need_flush)
+{
+  int ret = OB_SUCCESS;
+  const OutputMode mode = is_left ? OUTPUT_LEFT : OUTPUT_RIGHT;
+  if (!side.has_row()) {
+    if (side.iter_end_) {
+      state_ = JS_JOIN_END;
+    } else if (output_cnt_ > 0) {
+      need_flush = true;
+    } else if (OB_FAIL(fetch_rows(side, side.cur_))) {
+      LOG_WARN("fetch rows failed", K(ret));
+    }
+  } else {
+    for (; side.has_row() && can_append(mode); side.cur_++) {
+      if (is_left) {
+        append_output(mode, side.rows_.at(side.cur_), NULL, side.cur_, -1);
+      } else {
+        append_output(mode, NULL, side.rows_.at(side.cur_), -1, side.cur_);
+      }
+    }
+    need_flush = side.has_row();
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::flush_output(bool &has_output)
+{
+  int ret = OB_SUCCESS;
+  const int64_t cnt = output_cnt_;
+  const ExprFixedArray &left_exprs = MY_SPEC.left_child_fetcher_all_exprs_;
+  const ExprFixedArray &right_exprs = MY_SPEC.right_child_fetcher_all_exprs_;
+  clear_evaluated_flag();
+  brs_.skip_->reset(cnt);
+  brs_.all_rows_active_ = true;
+  has_output = true;
+  if (OUTPUT_LEFT == output_mode_) {
+    if (OB_FAIL(ObTempRowStore::Iterator::attach_rows(
+                left_exprs, eval_ctx_, left_side_.get_row_meta(),
+                const_cast<const ObCompactRow **>(output_left_rows_), cnt))) {
+      LOG_WARN("attach rows failed", K(ret));
+    } else if (need_left_join() && OB_FAIL(blank_row_batch(right_->get_spec().output_, cnt))) {
+      LOG_WARN("blank right row batch failed", K(ret));
+    }
+  } else if (OUTPUT_RIGHT == output_mode_) {
+    if (OB_FAIL(ObTempRowStore::Iterator::attach_rows(
+                right_exprs, eval_ctx_, right_side_.get_row_meta(),
+                const_cast<const ObCompactRow **>(output_right_rows_), cnt))) {
+      LOG_WARN("attach rows failed", K(ret));
+    } else if (need_right_join() && OB_FAIL(blank_row_batch(left_->get_spec().output_, cnt))) {
+      LOG_WARN("blank left row batch failed", K(ret));
+    }
+  } else if (OUTPUT_PAIR == output_mode_ || OUTPUT_PAIR_CHECK == output_mode_) {
+    bool all_filtered = false;
+    if (OB_FAIL(ObTempRowStore::Iterator::attach_rows(
+                left_exprs, eval_ctx_, left_side_.get_row_meta(),
+                const_cast<const ObCompactRow **>(output_left_rows_), cnt))) {
+      LOG_WARN("attach rows failed", K(ret));
+    } else if (OB_FAIL(ObTempRowStore::Iterator::attach_rows(
+                       right_exprs, eval_ctx_, right_side_.get_row_meta(),
+                       const_cast<const ObCompactRow **>(output_right_rows_), cnt))) {
+      LOG_WARN("attach rows failed", K(ret));
+    } else if (MY_SPEC.other_join_conds_.empty()) {
+    } else if (OB_FAIL(filter_rows(MY_SPEC.other_join_conds_, *brs_.skip_, cnt, all_filtered,
+                                   brs_.all_rows_active_))) {
+      LOG_WARN("calc other join conditions failed", K(ret));
+    } else {
+      for (int64_t i = 0; i < cnt; i++) {
+        if (!brs_.skip_->at(i)) {
+          left_side_.matched_.at(output_left_idx_[i]) = 1;
+          right_side_.matched_.at(output_right_idx_[i]) = 1;
+        }
+      }
+    }
+    if (OB_SUCC(ret) && OUTPUT_PAIR_CHECK == output_mode_) {
+      // semi/anti join output rows by the match flags later
+      has_output = false;
+    }
+  } else {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected output mode", K(ret), K(output_mode_), K(cnt));
+  }
+  if (OB_SUCC(ret)) {
+    brs_.size_ = has_output ? cnt : 0;
+    output_cnt_ = 0;
+    output_mode_ = OUTPUT_NONE;
+  }
+  return ret;
+}
+
+} // end namespace sql
+} // end namespace oceanbase
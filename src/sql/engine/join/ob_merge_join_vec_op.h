@@ -0,0 +1,213 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_ENGINE_JOIN_OB_MERGE_JOIN_VEC_OP_
+#define OCEANBASE_SQL_ENGINE_JOIN_OB_MERGE_JOIN_VEC_OP_
+
+#include "sql/engine/join/ob_join_vec_op.h"
+#include "sql/engine/join/ob_merge_join_op.h"
+#include "sql/engine/basic/ob_temp_row_store.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+class ObMergeJoinVecSpec: public ObJoinVecSpec
+{
+  OB_UNIS_VERSION_V(1);
+public:
+  typedef ObMergeJoinSpec::EqualConditionInfo EqualConditionInfo;
+  ObMergeJoinVecSpec(common::ObIAllocator &alloc, const ObPhyOperatorType type)
+    : ObJoinVecSpec(alloc, type),
+      equal_cond_infos_(alloc),
+      merge_directions_(alloc),
+      is_left_unique_(false),
+      left_child_fetcher_all_exprs_(alloc),
+      right_child_fetcher_all_exprs_(alloc)
+  {}
+
+  virtual ~ObMergeJoinVecSpec() {};
+
+  int set_merge_directions(const common::ObIArray<ObOrderDirection> &merge_directions);
+
+private:
+  static const int64_t MERGE_DIRECTION_ASC;
+  static const int64_t MERGE_DIRECTION_DESC;
+
+public:
+  common::ObFixedArray<EqualConditionInfo, common::ObIAllocator> equal_cond_infos_;
+  common::ObFixedArray<int64_t, common::ObIAllocator> merge_directions_;
+  bool is_left_unique_;
+  // child output exprs + join keys of each side, which are stored in the row store
+  ExprFixedArray left_child_fetcher_all_exprs_;
+  ExprFixedArray right_child_fetcher_all_exprs_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObMergeJoinVecSpec);
+};
+
+// Vectorized merge join.
+//
+// Batches of both children are added to per side temp row stores, all join work is done on the
+// stored rows:
+//   - runs of rows which can not be joined (key less than the current key of the other side)
+//     are located by galloping search over the sorted rows and output in bulk,
+//   - equal key groups of both sides are located the same way, the cross product of the groups
+//     is output batch by batch, other join conditions are evaluated on the whole batch.
+// Rows of an equal key group may span multiple child batches, stored rows of finished groups
+// are released by copying the pending rows to the other store of the side.
+//
+// Equal key groups are kept in memory and are not dumped, so the operator is only generated when
+// tracepoint EN_ENABLE_VEC_MERGE_JOIN is set.
+class ObMergeJoinVecOp: public ObJoinVecOp
+{
+private:
+  enum JoinState {
+    JS_MERGE = 0,    // compare the current rows of both sides
+    JS_GROUP_PAIRS,  // join equal key groups
+    JS_GROUP_LEFT,   // output left rows of equal key group by match flags
+    JS_GROUP_RIGHT,  // output right rows of equal key group by match flags
+    JS_DRAIN_LEFT,   // right side iterate end, output remain left rows
+    JS_DRAIN_RIGHT,  // left side iterate end, output remain right rows
+    JS_JOIN_END
+  };
+
+  enum OutputMode {
+    OUTPUT_NONE = 0,
+    OUTPUT_LEFT,       // left rows with blank right rows for outer join
+    OUTPUT_RIGHT,      // right rows with blank left rows for outer join
+    OUTPUT_PAIR,       // joined rows
+    OUTPUT_PAIR_CHECK, // joined rows of semi/anti join, only update the match flags
+  };
+
+  struct ChildSide
+  {
+    ChildSide() : child_(NULL), all_exprs_(NULL), key_cols_(), cur_store_(0), rows_(),
+                  batch_rows_(NULL), cur_(0), iter_end_(false), group_start_(0),
+                  group_end_(0), matched_()
+    {}
+    const RowMeta &get_row_meta() const { return stores_[cur_store_].get_row_meta(); }
+    bool has_row() const { return cur_ < rows_.count(); }
+    bool end() const { return iter_end_ && !has_row(); }
+    int64_t group_cnt() const { return group_end_ - group_start_; }
+
+    ObOperator *child_;
+    const ExprFixedArray *all_exprs_;
+    // column index of join keys in stored rows
+    common::ObSEArray<int64_t, 4> key_cols_;
+    ObTempRowStore stores_[2];
+    int64_t cur_store_;
+    common::ObArray<ObCompactRow *> rows_;
+    ObCompactRow **batch_rows_;
+    // first row not consumed
+    int64_t cur_;
+    bool iter_end_;
+    // rows of current equal key group: [group_start_, group_end_)
+    int64_t group_start_;
+    int64_t group_end_;
+    common::ObArray<uint8_t> matched_;
+  };
+
+public:
+  ObMergeJoinVecOp(ObExecContext &exec_ctx, const ObOpSpec &spec, ObOpInput *input);
+  virtual ~ObMergeJoinVecOp() {}
+
+  virtual int inner_open() override;
+  virtual int inner_rescan() override;
+  virtual int inner_get_next_row() override;
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
+  virtual int inner_close() override;
+  virtual void destroy() override;
+
+private:
+  void reset();
+  void reset_side(ChildSide &side);
+  int init_side(ChildSide &side, ObOperator *child, const ExprFixedArray &all_exprs,
+                const bool is_left);
+  int init_store(ChildSide &side, ObTempRowStore &store);
+  // get next batch of child, rows before %keep_from are released first.
+  int fetch_rows(ChildSide &side, const int64_t keep_from);
+  int release_rows(ChildSide &side, const int64_t keep_from);
+  // compare join keys of the left row and right row, the result is adjusted by merge direction
+  int compare(const int64_t l_idx, const int64_t r_idx, int64_t &cmp_res) const;
+  // find first row in [begin, rows_.count()) of %side which make %pred false, the rows in range
+  // are sorted, %pred is true for a prefix of them.
+  template <typename Pred>
+  int gallop(const ChildSide &side, const int64_t begin, Pred &pred, int64_t &end) const;
+  int merge(bool &need_flush);
+  int find_group(ChildSide &side, const bool is_left);
+  int start_group();
+  int join_group_pairs(bool &need_flush);
+  int output_group_side(ChildSide &side, const bool is_left, bool &need_flush);
+  int drain_side(ChildSide &side, const bool is_left, bool &need_flush);
+  int flush_output(bool &has_output);
+
+  bool can_append(const OutputMode mode) const
+  {
+    return 0 == output_cnt_ || (mode == output_mode_ && output_cnt_ < output_cap_);
+  }
+  void append_output(const OutputMode mode, ObCompactRow *l_row, ObCompactRow *r_row,
+                     const int64_t l_idx, const int64_t r_idx)
+  {
+    output_mode_ = mode;
+    output_left_rows_[output_cnt_] = l_row;
+    output_right_rows_[output_cnt_] = r_row;
+    output_left_idx_[output_cnt_] = l_idx;
+    output_right_idx_[output_cnt_] = r_idx;
+    output_cnt_ += 1;
+  }
+  bool need_left_unmatched() const
+  {
+    return LEFT_OUTER_JOIN == MY_SPEC.join_type_ || FULL_OUTER_JOIN == MY_SPEC.join_type_
+        || LEFT_ANTI_JOIN == MY_SPEC.join_type_;
+  }
+  bool need_right_unmatched() const
+  {
+    return RIGHT_OUTER_JOIN == MY_SPEC.join_type_ || FULL_OUTER_JOIN == MY_SPEC.join_type_
+        || RIGHT_ANTI_JOIN == MY_SPEC.join_type_;
+  }
+  bool is_semi_anti() const
+  {
+    return LEFT_SEMI_JOIN == MY_SPEC.join_type_ || LEFT_ANTI_JOIN == MY_SPEC.join_type_
+        || RIGHT_SEMI_JOIN == MY_SPEC.join_type_ || RIGHT_ANTI_JOIN == MY_SPEC.join_type_;
+  }
+  inline common::ObDatum get_key(const ChildSide &side, const int64_t row_idx,
+                                 const int64_t key_idx) const
+  {
+    return side.rows_.at(row_idx)->get_datum(side.get_row_meta(), side.key_cols_.at(key_idx));
+  }
+
+private:
+  JoinState state_;
+  // left join keys are unique and no null safe equal condition, the left group is one row
+  bool left_unique_;
+  ChildSide left_side_;
+  ChildSide right_side_;
+  // current pair of equal key groups
+  int64_t group_left_idx_;
+  int64_t group_right_idx_;
+  OutputMode output_mode_;
+  int64_t output_cnt_;
+  int64_t output_cap_;
+  ObCompactRow **output_left_rows_;
+  ObCompactRow **output_right_rows_;
+  // row index in equal key group of the joined rows
+  int64_t *output_left_idx_;
+  int64_t *output_right_idx_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObMergeJoinVecOp);
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+#endif // OCEANBASE_SQL_ENGINE_JOIN_OB_MERGE_JOIN_VEC_OP_
@@ -0,0 +1,619 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/join/ob_nested_loop_join_vec_op.h"
+#include "sql/engine/ob_exec_context.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace sql
+{
+
+OB_SERIALIZE_MEMBER((ObNestedLoopJoinVecSpec, ObJoinVecSpec),
+                    rescan_params_,
+                    group_size_);
+
+ObNestedLoopJoinVecOp::ObNestedLoopJoinVecOp(ObExecContext &exec_ctx,
+                                             const ObOpSpec &spec,
+                                             ObOpInput *input)
+  : ObJoinVecOp(exec_ctx, spec, input),
+    state_(JS_FILL_GROUP),
+    mem_context_(NULL),
+    left_store_(),
+    left_rows_(),
+    batch_rows_(NULL),
+    left_iter_end_(false),
+    group_size_(0),
+    max_group_size_(0),
+    group_params_(),
+    cur_idx_(0),
+    matched_(),
+    right_iter_end_(false),
+    skip_rescan_right_(false),
+    dup_left_rows_(NULL),
+    output_left_rows_(NULL),
+    output_cnt_(0),
+    output_idx_(0),
+    right_store_(),
+    saved_right_rows_(NULL),
+    saved_cnt_(0),
+    op_max_batch_size_(0)
+{
+}
+
+int ObNestedLoopJoinVecOp::inner_open()
+{
+  int ret = OB_SUCCESS;
+  ObIAllocator &alloc = ctx_.get_allocator();
+  const int64_t batch_size = MY_SPEC.max_batch_size_;
+  int64_t simulate_group_size = - EVENT_CALL(EventTable::EN_DAS_SIMULATE_GROUP_SIZE);
+  group_size_ = simulate_group_size > 0 ? simulate_group_size : MY_SPEC.group_size_;
+  max_group_size_ = group_size_ + batch_size;
+  if (OB_ISNULL(left_) || OB_ISNULL(right_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("nlj child is null", K(ret), KP(left_), KP(right_));
+  } else if (OB_FAIL(ObJoinVecOp::inner_open())) {
+    LOG_WARN("failed to open in base class", K(ret));
+  } else if (OB_UNLIKELY(group_size_ <= 0 || batch_size <= 0)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid group size or batch size", K(ret), K(group_size_), K(batch_size));
+  } else if (OB_ISNULL(batch_rows_ = static_cast<ObCompactRow **>(
+                       alloc.alloc(sizeof(ObCompactRow *) * batch_size)))
+             || OB_ISNULL(dup_left_rows_ = static_cast<const ObCompactRow **>(
+                          alloc.alloc(sizeof(ObCompactRow *) * batch_size)))
+             || OB_ISNULL(output_left_rows_ = static_cast<const ObCompactRow **>(
+                          alloc.alloc(sizeof(ObCompactRow *) * batch_size)))
+             || OB_ISNULL(saved_right_rows_ = static_cast<ObCompactRow **>(
+                          alloc.alloc(sizeof(ObCompactRow *) * batch_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(batch_size));
+  } else if (OB_ISNULL(mem_context_)) {
+    lib::ContextParam param;
+    param.set_mem_attr(ctx_.get_my_session()->get_effective_tenant_id(),
+                       ObModIds::OB_SQL_NLJ_CACHE,
+                       ObCtxIds::WORK_AREA)
+      .set_properties(lib::USE_TL_PAGE_OPTIONAL);
+    if (OB_FAIL(CURRENT_CONTEXT->CREATE_CONTEXT(mem_context_, param))) {
+      LOG_WARN("create entity failed", K(ret));
+    } else if (OB_ISNULL(mem_context_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("null memory entity returned", K(ret));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(init_store(left_store_, left_->get_spec().output_))) {
+    LOG_WARN("init left row store failed", K(ret));
+  } else if (OB_FAIL(init_store(right_store_, right_->get_spec().output_))) {
+    LOG_WARN("init right row store failed", K(ret));
+  } else if (OB_FAIL(init_group_params())) {
+    LOG_WARN("init group params failed", K(ret));
+  }
+  return ret;
+}
+
+// NLJ's rescan only drive left child's rescan, the right child is rescanned with the params of
+// the left rows in fill_group().
+int ObNestedLoopJoinVecOp::rescan()
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(left_->rescan())) {
+    LOG_WARN("rescan left child operator failed", K(ret), "child op_type", left_->op_name());
+  } else if (OB_FAIL(inner_rescan())) {
+    LOG_WARN("failed to inner rescan", K(ret));
+  }
+
+#ifndef NDEBUG
+  OX(OB_ASSERT(false == brs_.end_));
+#endif
+
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::inner_rescan()
+{
+  int ret = OB_SUCCESS;
+  reset();
+  set_param_null();
+  if (OB_FAIL(init_store(left_store_, left_->get_spec().output_))) {
+    LOG_WARN("init left row store failed", K(ret));
+  } else if (OB_FAIL(init_store(right_store_, right_->get_spec().output_))) {
+    LOG_WARN("init right row store failed", K(ret));
+  } else if (OB_FAIL(ObJoinVecOp::inner_rescan())) {
+    LOG_WARN("failed to rescan ObJoinVecOp", K(ret));
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::inner_close()
+{
+  reset();
+  return ObJoinVecOp::inner_close();
+}
+
+void ObNestedLoopJoinVecOp::destroy()
+{
+  reset();
+  left_rows_.destroy();
+  matched_.destroy();
+  if (NULL != mem_context_) {
+    DESTROY_CONTEXT(mem_context_);
+    mem_context_ = NULL;
+  }
+  ObJoinVecOp::destroy();
+}
+
+void ObNestedLoopJoinVecOp::reset()
+{
+  state_ = JS_FILL_GROUP;
+  left_store_.reset();
+  left_rows_.reuse();
+  left_iter_end_ = false;
+  cur_idx_ = 0;
+  matched_.reuse();
+  right_iter_end_ = false;
+  skip_rescan_right_ = false;
+  output_cnt_ = 0;
+  output_idx_ = 0;
+  right_store_.reset();
+  saved_cnt_ = 0;
+  if (NULL != mem_context_) {
+    mem_context_->get_arena_allocator().reset();
+  }
+}
+
+int ObNestedLoopJoinVecOp::inner_get_next_row()
+{
+  int ret = OB_ERR_UNEXPECTED;
+  LOG_WARN("vectorized nested loop join should not call get_next_row", K(ret));
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::init_store(ObTempRowStore &store, const ExprFixedArray &exprs)
+{
+  int ret = OB_SUCCESS;
+  const uint64_t tenant_id = ctx_.get_my_session()->get_effective_tenant_id();
+  ObMemAttr mem_attr(tenant_id, ObModIds::OB_SQL_NLJ_CACHE, ObCtxIds::WORK_AREA);
+  if (OB_FAIL(store.init(exprs, MY_SPEC.max_batch_size_, mem_attr,
+                         0 /* mem_limit */, false /* enable_dump */, 0 /* row_extra_size */))) {
+    LOG_WARN("init row store failed", K(ret));
+  } else if (OB_FAIL(store.init_batch_ctx())) {
+    LOG_WARN("init batch ctx failed", K(ret));
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::init_group_params()
+{
+  int ret = OB_SUCCESS;
+  const ObIArray<ObDynamicParamSetter> &rescan_params = MY_SPEC.rescan_params_;
+  if (!group_params_.empty()) {
+    for (int64_t i = 0; i < group_params_.count(); ++i) {
+      group_params_.at(i).count_ = 0;
+    }
+  } else if (OB_FAIL(group_params_.allocate_array(ctx_.get_allocator(),
+                                                  rescan_params.count()))) {
+    LOG_WARN("allocate group params array failed", K(ret), K(rescan_params.count()));
+  } else {
+    const int64_t obj_buf_size = sizeof(ObObjParam) * max_group_size_;
+    for (int64_t i = 0; OB_SUCC(ret) && i < group_params_.count(); ++i) {
+      ObExpr *dst_expr = rescan_params.at(i).dst_;
+      void *buf = ctx_.get_allocator().alloc(obj_buf_size);
+      if (OB_ISNULL(buf)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("alloc memory failed", K(ret), K(obj_buf_size));
+      } else {
+        group_params_.at(i).data_ = reinterpret_cast<ObObjParam *>(buf);
+        group_params_.at(i).count_ = 0;
+        group_params_.at(i).element_.set_meta_type(dst_expr->obj_meta_);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::fill_group()
+{
+  int ret = OB_SUCCESS;
+  const ExprFixedArray &left_exprs = left_->get_spec().output_;
+  left_store_.reset();
+  left_rows_.reuse();
+  matched_.reuse();
+  mem_context_->get_arena_allocator().reset();
+  if (OB_FAIL(init_store(left_store_, left_exprs))) {
+    LOG_WARN("init left row store failed", K(ret));
+  } else if (OB_FAIL(init_group_params())) {
+    LOG_WARN("init group params failed", K(ret));
+  }
+  while (OB_SUCC(ret) && !left_iter_end_ && left_rows_.count() < group_size_) {
+    const ObBatchRows *left_brs = NULL;
+    int64_t stored_cnt = 0;
+    // Reset exec param before get left batch, the exec param still reference to the previous
+    // left row, which may become wild pointer.
+    set_param_null();
+    clear_evaluated_flag();
+    if (OB_FAIL(left_->get_next_batch(op_max_batch_size_, left_brs))) {
+      LOG_WARN("get left batch failed", K(ret));
+    } else if (FALSE_IT(left_iter_end_ = left_brs->end_)) {
+    } else if (0 == left_brs->size_) {
+    } else if (OB_FAIL(left_store_.add_batch(left_exprs, eval_ctx_, *left_brs, stored_cnt,
+                                             batch_rows_))) {
+      LOG_WARN("add batch failed", K(ret));
+    } else if (OB_FAIL(add_group_params(*left_brs))) {
+      LOG_WARN("add group params failed", K(ret));
+    } else {
+      for (int64_t i = 0; OB_SUCC(ret) && i < stored_cnt; i++) {
+        if (OB_FAIL(left_rows_.push_back(batch_rows_[i]))) {
+          LOG_WARN("push back failed", K(ret));
+        }
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (left_rows_.empty()) {
+    state_ = JS_JOIN_END;
+  } else if (OB_FAIL(matched_.prepare_allocate(left_rows_.count()))) {
+    LOG_WARN("prepare allocate failed", K(ret));
+  } else {
+    MEMSET(&matched_.at(0), 0, matched_.count());
+    set_param_null();
+    if (OB_FAIL(bind_group_params())) {
+      LOG_WARN("bind group params failed", K(ret));
+    } else if (OB_FAIL(right_->rescan())) {
+      // right child fetches the rows of all the group params here
+      ret = (OB_ITER_END == ret) ? OB_ERR_UNEXPECTED : ret;
+      LOG_WARN("rescan right failed", K(ret));
+    } else {
+      skip_rescan_right_ = true;
+      cur_idx_ = -1;
+      state_ = JS_NEXT_LEFT;
+    }
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::add_group_params(const ObBatchRows &left_brs)
+{
+  int ret = OB_SUCCESS;
+  ParamStore &param_store = GET_PHY_PLAN_CTX(ctx_)->get_param_store_for_update();
+  for (int64_t i = 0; OB_SUCC(ret) && i < MY_SPEC.rescan_params_.count(); i++) {
+    const ObDynamicParamSetter &rescan_param = MY_SPEC.rescan_params_.at(i);
+    ObSqlArrayObj &arr = group_params_.at(i);
+    ObIVector *vec = NULL;
+    if (OB_FAIL(rescan_param.src_->eval_vector(eval_ctx_, left_brs))) {
+      LOG_WARN("eval rescan param failed", K(ret), K(rescan_param));
+    } else {
+      vec = rescan_param.src_->get_vector(eval_ctx_);
+    }
+    for (int64_t j = 0; OB_SUCC(ret) && j < left_brs.size_; j++) {
+      if (left_brs.skip_->at(j)) {
+        continue;
+      }
+      ObDatum datum(vec->get_payload(j), vec->get_length(j), vec->is_null(j));
+      if (OB_UNLIKELY(arr.count_ >= max_group_size_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("too many group params", K(ret), K(arr.count_), K(max_group_size_));
+      } else if (OB_FAIL(rescan_param.update_dynamic_param(eval_ctx_, datum))) {
+        LOG_WARN("update dynamic param failed", K(ret));
+      } else if (OB_FAIL(ob_write_obj(mem_context_->get_arena_allocator(),
+                                      param_store.at(rescan_param.param_idx_),
+                                      arr.data_[arr.count_]))) {
+        // the param datum of the source expr may be overwritten, deep copy is needed
+        LOG_WARN("deep copy dynamic param failed", K(ret), K(i), K(j));
+      } else {
+        arr.count_++;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::bind_group_params()
+{
+  int ret = OB_SUCCESS;
+  ParamStore &param_store = GET_PHY_PLAN_CTX(ctx_)->get_param_store_for_update();
+  for (int64_t i = 0; OB_SUCC(ret) && i < MY_SPEC.rescan_params_.count(); i++) {
+    const int64_t param_idx = MY_SPEC.rescan_params_.at(i).param_idx_;
+    const int64_t array_obj_addr = reinterpret_cast<int64_t>(&group_params_.at(i));
+    param_store.at(param_idx).set_extend(array_obj_addr, T_EXT_SQL_ARRAY);
+  }
+  return ret;
+}
+
+// set params of current left row, which may be referenced by the right child or other join
+// conditions.
+int ObNestedLoopJoinVecOp::fill_cur_row_group_param()
+{
+  int ret = OB_SUCCESS;
+  ObPhysicalPlanCtx *plan_ctx = GET_PHY_PLAN_CTX(ctx_);
+  for (int64_t i = 0; OB_SUCC(ret) && i < group_params_.count(); i++) {
+    const ObDynamicParamSetter &rescan_param = MY_SPEC.rescan_params_.at(i);
+    ObExpr *dst = rescan_param.dst_;
+    ObSqlArrayObj &arr = group_params_.at(i);
+    if (OB_UNLIKELY(cur_idx_ >= arr.count_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("row idx is unexpected", K(ret), K(cur_idx_), K(arr.count_));
+    } else {
+      ObDatum &param_datum = dst->locate_datum_for_write(eval_ctx_);
+      dst->get_eval_info(eval_ctx_).clear_evaluated_flag();
+      ObDynamicParamSetter::clear_parent_evaluated_flag(eval_ctx_, *dst);
+      if (OB_FAIL(param_datum.from_obj(arr.data_[cur_idx_], dst->obj_datum_map_))) {
+        LOG_WARN("fail to cast datum", K(ret));
+      } else {
+        plan_ctx->get_param_store_for_update().at(rescan_param.param_idx_) = arr.data_[cur_idx_];
+        dst->set_evaluated_projected(eval_ctx_);
+      }
+    }
+  }
+  return ret;
+}
+
+// The first left row of group reads the result of the group rescan in fill_group() directly,
+// the following rows switch right child to the next scan group.
+int ObNestedLoopJoinVecOp::rescan_right()
+{
+  int ret = OB_SUCCESS;
+  if (skip_rescan_right_) {
+    skip_rescan_right_ = false;
+  } else if (OB_FAIL(right_->rescan())) {
+    ret = (OB_ITER_END == ret) ? OB_ERR_UNEXPECTED : ret;
+    LOG_WARN("rescan right failed", K(ret));
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  bool has_output = false;
+  op_max_batch_size_ = std::min(max_row_cnt, MY_SPEC.max_batch_size_);
+  while (OB_SUCC(ret) && !has_output) {
+    switch (state_) {
+      case JS_FILL_GROUP: {
+        if (left_iter_end_) {
+          state_ = JS_JOIN_END;
+        } else {
+          ret = fill_group();
+        }
+        break;
+      }
+      case JS_NEXT_LEFT: {
+        ret = next_left_row(has_output);
+        break;
+      }
+      case JS_JOIN_RIGHT: {
+        ret = join_right_batch(has_output);
+        break;
+      }
+      case JS_OUTPUT_GROUP: {
+        ret = output_group(has_output);
+        break;
+      }
+      case JS_JOIN_END: {
+        set_param_null();
+        brs_.size_ = 0;
+        brs_.end_ = true;
+        has_output = true;
+        break;
+      }
+      default: {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected join state", K(ret), K(state_));
+        break;
+      }
+    }
+    if (OB_FAIL(ret)) {
+      LOG_WARN("nested loop join failed", K(ret), K(state_));
+    }
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::next_left_row(bool &has_output)
+{
+  int ret = OB_SUCCESS;
+  cur_idx_ += 1;
+  if (cur_idx_ >= left_rows_.count()) {
+    if (is_semi_anti()) {
+      output_idx_ = 0;
+      state_ = JS_OUTPUT_GROUP;
+    } else {
+      // unmatched left rows reference the left store, output them before the next group
+      if (output_cnt_ > 0) {
+        if (OB_FAIL(flush_left_rows(true))) {
+          LOG_WARN("flush left rows failed", K(ret));
+        } else {
+          has_output = true;
+        }
+      }
+      state_ = JS_FILL_GROUP;
+    }
+  } else if (OB_FAIL(try_check_status())) {
+    LOG_WARN("check status failed", K(ret));
+  } else if (OB_FAIL(rescan_right())) {
+    LOG_WARN("rescan right failed", K(ret), K(cur_idx_));
+  } else if (OB_FAIL(fill_cur_row_group_param())) {
+    LOG_WARN("fill group param failed", K(ret), K(cur_idx_));
+  } else {
+    right_iter_end_ = false;
+    state_ = JS_JOIN_RIGHT;
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::join_right_batch(bool &has_output)
+{
+  int ret = OB_SUCCESS;
+  const ObBatchRows *right_brs = NULL;
+  if (saved_cnt_ > 0) {
+    if (OB_FAIL(output_saved_batch())) {
+      LOG_WARN("output saved batch failed", K(ret));
+    } else {
+      has_output = true;
+    }
+  } else if (right_iter_end_ || (is_semi_anti() && matched_.at(cur_idx_))) {
+    // the rest rows of the scan group are skipped when switching to next scan group
+    if (need_left_join() && !matched_.at(cur_idx_)
+        && OB_FAIL(add_unmatched_left(has_output))) {
+      LOG_WARN("add unmatched left row failed", K(ret));
+    } else {
+      state_ = JS_NEXT_LEFT;
+    }
+  } else if (FALSE_IT(clear_evaluated_flag())) {
+  } else if (OB_FAIL(right_->get_next_batch(op_max_batch_size_, right_brs))) {
+    LOG_WARN("get right batch failed", K(ret));
+  } else if (FALSE_IT(right_iter_end_ = right_brs->end_)) {
+  } else if (0 == right_brs->size_) {
+  } else {
+    const int64_t size = right_brs->size_;
+    bool all_filtered = false;
+    brs_.skip_->deep_copy(*right_brs->skip_, size);
+    brs_.all_rows_active_ = right_brs->all_rows_active_;
+    for (int64_t i = 0; i < size; i++) {
+      dup_left_rows_[i] = left_rows_.at(cur_idx_);
+    }
+    if (OB_FAIL(ObTempRowStore::Iterator::attach_rows(left_->get_spec().output_, eval_ctx_,
+                                                      left_store_.get_row_meta(),
+                                                      dup_left_rows_, size))) {
+      LOG_WARN("attach rows failed", K(ret));
+    } else if (MY_SPEC.other_join_conds_.empty()) {
+    } else if (OB_FAIL(filter_rows(MY_SPEC.other_join_conds_, *brs_.skip_, size, all_filtered,
+                                   brs_.all_rows_active_))) {
+      LOG_WARN("calc other join conditions failed", K(ret));
+    }
+    if (OB_FAIL(ret)) {
+    } else if (all_filtered || brs_.skip_->accumulate_bit_cnt(size) == size) {
+      // no matched row in this batch
+    } else {
+      matched_.at(cur_idx_) = 1;
+      if (!is_semi_anti() && OB_FAIL(output_matched_batch(*right_brs, has_output))) {
+        LOG_WARN("output matched batch failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::output_matched_batch(const ObBatchRows &right_brs, bool &has_output)
+{
+  int ret = OB_SUCCESS;
+  const int64_t size = right_brs.size_;
+  if (0 == output_cnt_) {
+    brs_.size_ = size;
+    has_output = true;
+  } else {
+    // unmatched left rows before current row must be output first, the matched rows are saved
+    // and output in the next batch.
+    ObBatchRows matched_brs;
+    matched_brs.skip_ = brs_.skip_;
+    matched_brs.size_ = size;
+    matched_brs.all_rows_active_ = brs_.all_rows_active_;
+    right_store_.reset();
+    if (OB_FAIL(init_store(right_store_, right_->get_spec().output_))) {
+      LOG_WARN("init right row store failed", K(ret));
+    } else if (OB_FAIL(right_store_.add_batch(right_->get_spec().output_, eval_ctx_, matched_brs,
+                                              saved_cnt_, saved_right_rows_))) {
+      LOG_WARN("add batch failed", K(ret));
+    } else if (OB_FAIL(flush_left_rows(true))) {
+      LOG_WARN("flush left rows failed", K(ret));
+    } else {
+      has_output = true;
+    }
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::output_saved_batch()
+{
+  int ret = OB_SUCCESS;
+  const int64_t cnt = saved_cnt_;
+  clear_evaluated_flag();
+  for (int64_t i = 0; i < cnt; i++) {
+    dup_left_rows_[i] = left_rows_.at(cur_idx_);
+  }
+  if (OB_FAIL(ObTempRowStore::Iterator::attach_rows(left_->get_spec().output_, eval_ctx_,
+                                                    left_store_.get_row_meta(),
+                                                    dup_left_rows_, cnt))) {
+    LOG_WARN("attach rows failed", K(ret));
+  } else if (OB_FAIL(ObTempRowStore::Iterator::attach_rows(
+                     right_->get_spec().output_, eval_ctx_, right_store_.get_row_meta(),
+                     const_cast<const ObCompactRow **>(saved_right_rows_), cnt))) {
+    LOG_WARN("attach rows failed", K(ret));
+  } else {
+    brs_.skip_->reset(cnt);
+    brs_.all_rows_active_ = true;
+    brs_.size_ = cnt;
+    saved_cnt_ = 0;
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::add_unmatched_left(bool &has_output)
+{
+  int ret = OB_SUCCESS;
+  output_left_rows_[output_cnt_++] = left_rows_.at(cur_idx_);
+  if (output_cnt_ >= op_max_batch_size_) {
+    if (OB_FAIL(flush_left_rows(true))) {
+      LOG_WARN("flush left rows failed", K(ret));
+    } else {
+      has_output = true;
+    }
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::flush_left_rows(const bool blank_right)
+{
+  int ret = OB_SUCCESS;
+  const int64_t cnt = output_cnt_;
+  clear_evaluated_flag();
+  if (OB_FAIL(ObTempRowStore::Iterator::attach_rows(left_->get_spec().output_, eval_ctx_,
+                                                    left_store_.get_row_meta(),
+                                                    output_left_rows_, cnt))) {
+    LOG_WARN("attach rows failed", K(ret));
+  } else if (blank_right && OB_FAIL(blank_row_batch(right_->get_spec().output_, cnt))) {
+    LOG_WARN("blank right row batch failed", K(ret));
+  } else {
+    brs_.skip_->reset(cnt);
+    brs_.all_rows_active_ = true;
+    brs_.size_ = cnt;
+    output_cnt_ = 0;
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::output_group(bool &has_output)
+{
+  int ret = OB_SUCCESS;
+  const bool output_matched = (LEFT_SEMI_JOIN == MY_SPEC.join_type_);
+  for (; output_idx_ < left_rows_.count() && output_cnt_ < op_max_batch_size_; output_idx_++) {
+    if (static_cast<bool>(matched_.at(output_idx_)) == output_matched) {
+      output_left_rows_[output_cnt_++] = left_rows_.at(output_idx_);
+    }
+  }
+  if (output_cnt_ > 0) {
+    if (OB_FAIL(flush_left_rows(false))) {
+      LOG_WARN("flush left rows failed", K(ret));
+    } else {
+      has_output = true;
+    }
+  }
+  if (OB_SUCC(ret) && output_idx_ >= left_rows_.count()) {
+    state_ = JS_FILL_GROUP;
+  }
+  return ret;
+}
+
+} // end namespace sql
+} // end namespace oceanbase
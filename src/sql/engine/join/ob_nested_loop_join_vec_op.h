@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_ENGINE_JOIN_OB_NESTED_LOOP_JOIN_VEC_OP_
+#define OCEANBASE_SQL_ENGINE_JOIN_OB_NESTED_LOOP_JOIN_VEC_OP_
+
+#include "sql/engine/join/ob_join_vec_op.h"
+#include "sql/engine/basic/ob_temp_row_store.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+class ObNestedLoopJoinVecSpec : public ObJoinVecSpec
+{
+  OB_UNIS_VERSION_V(1);
+public:
+  ObNestedLoopJoinVecSpec(common::ObIAllocator &alloc, const ObPhyOperatorType type)
+    : ObJoinVecSpec(alloc, type),
+      rescan_params_(alloc),
+      group_size_(OB_MAX_BULK_JOIN_ROWS)
+  {}
+  virtual ~ObNestedLoopJoinVecSpec() {}
+
+public:
+  common::ObFixedArray<ObDynamicParamSetter, common::ObIAllocator> rescan_params_;
+  // left rows of one DAS group rescan
+  int64_t group_size_;
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObNestedLoopJoinVecSpec);
+};
+
+// Vectorized nested loop join with DAS group rescan.
+//
+// Left rows are always buffered by group: up to group_size_ rows are added to the temp row
+// store, rescan params of all the buffered rows are pushed down to the right child as
+// ObSqlArrayObj, so the right child fetch the whole group with one DAS group scan
+// (ObDASGroupScanOp/ObGroupScanIter). Then the group rows are joined one by one, right child is
+// switched to the scan group of the left row by rescan, which does not access storage again.
+//
+// Joined rows are output by right child batch: left row is attached to every position of the
+// batch, other join conditions are evaluated on the whole batch. Unmatched left rows of outer
+// join and result rows of semi/anti join are output in batch too, keeping the left row order.
+//
+// Only used when the right child supports group rescan (ObLogJoin::can_use_batch_nlj()) and no
+// batch params are supplied by operators above (multi level group rescan),
+// ObNestedLoopJoinOp is used for other cases.
+class ObNestedLoopJoinVecOp : public ObJoinVecOp
+{
+private:
+  enum JoinState {
+    JS_FILL_GROUP = 0,  // buffer group of left rows and rescan right child with group params
+    JS_NEXT_LEFT,       // switch to the next left row of group
+    JS_JOIN_RIGHT,      // join current left row with right batches
+    JS_OUTPUT_GROUP,    // output left rows of group by match flags for semi/anti join
+    JS_JOIN_END
+  };
+
+public:
+  ObNestedLoopJoinVecOp(ObExecContext &exec_ctx, const ObOpSpec &spec, ObOpInput *input);
+  virtual ~ObNestedLoopJoinVecOp() {}
+
+  virtual int inner_open() override;
+  virtual int rescan() override;
+  virtual int inner_rescan() override;
+  virtual int inner_get_next_row() override;
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
+  virtual int inner_close() override;
+  virtual void destroy() override;
+
+  virtual OperatorOpenOrder get_operator_open_order() const override final
+  { return OPEN_SELF_FIRST; }
+
+private:
+  void reset();
+  int init_store(ObTempRowStore &store, const ExprFixedArray &exprs);
+  int init_group_params();
+  int fill_group();
+  // save rescan params of left batch to group params
+  int add_group_params(const ObBatchRows &left_brs);
+  int bind_group_params();
+  int fill_cur_row_group_param();
+  int rescan_right();
+  int next_left_row(bool &has_output);
+  int join_right_batch(bool &has_output);
+  int output_matched_batch(const ObBatchRows &right_brs, bool &has_output);
+  int output_saved_batch();
+  int add_unmatched_left(bool &has_output);
+  int flush_left_rows(const bool blank_right);
+  int output_group(bool &has_output);
+  void set_param_null() { set_pushdown_param_null(MY_SPEC.rescan_params_); }
+  bool is_semi_anti() const
+  {
+    return LEFT_SEMI_JOIN == MY_SPEC.join_type_ || LEFT_ANTI_JOIN == MY_SPEC.join_type_;
+  }
+
+private:
+  JoinState state_;
+  lib::MemoryContext mem_context_; // for group params copying, reset for each group
+  ObTempRowStore left_store_;
+  common::ObArray<ObCompactRow *> left_rows_;
+  ObCompactRow **batch_rows_;
+  bool left_iter_end_;
+  int64_t group_size_;
+  // capacity of group params, the last left batch may exceed group_size_
+  int64_t max_group_size_;
+  common::ObArrayWrap<common::ObSqlArrayObj> group_params_;
+  // current left row of group
+  int64_t cur_idx_;
+  common::ObArray<uint8_t> matched_;
+  bool right_iter_end_;
+  // right child is rescanned with whole group params already
+  bool skip_rescan_right_;
+  // same left row for every position of the output batch
+  const ObCompactRow **dup_left_rows_;
+  // left rows output with blank right rows or without right rows
+  const ObCompactRow **output_left_rows_;
+  int64_t output_cnt_;
+  int64_t output_idx_;
+  // matched right batch which is delayed by the unmatched left rows before
+  ObTempRowStore right_store_;
+  ObCompactRow **saved_right_rows_;
+  int64_t saved_cnt_;
+  int64_t op_max_batch_size_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObNestedLoopJoinVecOp);
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+#endif // OCEANBASE_SQL_ENGINE_JOIN_OB_NESTED_LOOP_JOIN_VEC_OP_
@@ -103,6 +103,9 @@
 #include "sql/engine/set/ob_hash_union_op.h"
 #include "sql/engine/set/ob_hash_intersect_op.h"
 #include "sql/engine/set/ob_hash_except_op.h"
+#include "sql/engine/set/ob_hash_union_vec_op.h"
+#include "sql/engine/set/ob_hash_intersect_vec_op.h"
+#include "sql/engine/set/ob_hash_except_vec_op.h"
 #include "sql/engine/set/ob_merge_union_op.h"
 #include "sql/engine/recursive_cte/ob_recursive_union_all_op.h"
 #include "sql/engine/recursive_cte/ob_fake_cte_table_op.h"
@@ -126,6 +129,8 @@
 #include "sql/engine/subquery/ob_subplan_scan_op.h"
 #include "sql/engine/subquery/ob_unpivot_op.h"
 #include "sql/engine/join/ob_merge_join_op.h"
+#include "sql/engine/join/ob_merge_join_vec_op.h"
+#include "sql/engine/join/ob_nested_loop_join_vec_op.h"
 #include "sql/code_generator/ob_static_engine_cg.h"
 #include "sql/engine/basic/ob_monitoring_dump_op.h"
 #include "sql/engine/join/ob_join_filter_op.h"
@@ -146,6 +151,7 @@
 #include "sql/engine/aggregate/ob_hash_groupby_op.h"
 #include "sql/engine/table/ob_table_row_store_op.h"
 #include "sql/engine/window_function/ob_window_function_op.h"
+#include "sql/engine/window_function/ob_window_function_vec_op.h"
 #include "sql/engine/table/ob_row_sample_scan_op.h"
 #include "sql/engine/table/ob_block_sample_scan_op.h"
 #include "sql/engine/table/ob_table_scan_with_index_back_op.h"
@@ -168,6 +174,8 @@
 #include "sql/engine/opt_statistics/ob_optimizer_stats_gathering_op.h"
 #include "sql/engine/aggregate/ob_hash_groupby_vec_op.h"
 #include "sql/engine/aggregate/ob_hash_distinct_vec_op.h"
+#include "sql/engine/aggregate/ob_merge_distinct_vec_op.h"
+#include "sql/engine/aggregate/ob_merge_groupby_vec_op.h"
 #include "sql/engine/aggregate/ob_scalar_aggregate_vec_op.h"
 #include "sql/engine/basic/ob_temp_table_insert_vec_op.h"
 #include "sql/engine/basic/ob_temp_table_access_vec_op.h"
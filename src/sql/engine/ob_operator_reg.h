@@ -173,6 +173,12 @@ REGISTER_OPERATOR(ObLogDistinct, PHY_VEC_HASH_DISTINCT, ObHashDistinctVecSpec,
                   ObHashDistinctVecOp, NOINPUT, VECTORIZED_OP, 0 /*+version*/,
                   SUPPORT_RICH_FORMAT);
 
+class ObMergeDistinctVecSpec;
+class ObMergeDistinctVecOp;
+REGISTER_OPERATOR(ObLogDistinct, PHY_VEC_MERGE_DISTINCT, ObMergeDistinctVecSpec,
+                  ObMergeDistinctVecOp, NOINPUT, VECTORIZED_OP, 0 /*+version*/,
+                  SUPPORT_RICH_FORMAT);
+
 class ObLogMaterial;
 class ObMaterialSpec;
 class ObMaterialOp;
@@ -240,6 +246,25 @@ class ObHashExceptOp;
 REGISTER_OPERATOR(ObLogSet, PHY_HASH_EXCEPT, ObHashExceptSpec, ObHashExceptOp,
                   NOINPUT, VECTORIZED_OP);
 
+class ObLogSet;
+class ObHashUnionVecSpec;
+class ObHashUnionVecOp;
+REGISTER_OPERATOR(ObLogSet, PHY_VEC_HASH_UNION, ObHashUnionVecSpec, ObHashUnionVecOp,
+                  NOINPUT, VECTORIZED_OP, 0 /*+version*/, SUPPORT_RICH_FORMAT);
+
+class ObLogSet;
+class ObHashIntersectVecSpec;
+class ObHashIntersectVecOp;
+REGISTER_OPERATOR(ObLogSet, PHY_VEC_HASH_INTERSECT, ObHashIntersectVecSpec,
+                  ObHashIntersectVecOp, NOINPUT, VECTORIZED_OP, 0 /*+version*/,
+                  SUPPORT_RICH_FORMAT);
+
+class ObLogSet;
+class ObHashExceptVecSpec;
+class ObHashExceptVecOp;
+REGISTER_OPERATOR(ObLogSet, PHY_VEC_HASH_EXCEPT, ObHashExceptVecSpec, ObHashExceptVecOp,
+                  NOINPUT, VECTORIZED_OP, 0 /*+version*/, SUPPORT_RICH_FORMAT);
+
 class ObLogSet;
 class ObMergeUnionSpec;
 class ObMergeUnionOp;
@@ -483,6 +508,12 @@ class ObMergeGroupByOp;
 REGISTER_OPERATOR(ObLogGroupBy, PHY_MERGE_GROUP_BY, ObMergeGroupBySpec,
                   ObMergeGroupByOp, NOINPUT, VECTORIZED_OP);
 
+class ObMergeGroupByVecSpec;
+class ObMergeGroupByVecOp;
+REGISTER_OPERATOR(ObLogGroupBy, PHY_VEC_MERGE_GROUP_BY, ObMergeGroupByVecSpec,
+                  ObMergeGroupByVecOp, NOINPUT, VECTORIZED_OP, 0 /*+version*/,
+                  SUPPORT_RICH_FORMAT);
+
 class ObLogGroupBy;
 class ObHashGroupBySpec;
 class ObHashGroupByOp;
@@ -501,12 +532,31 @@ class ObWindowFunctionOpInput;
 REGISTER_OPERATOR(ObLogWindowFunction, PHY_WINDOW_FUNCTION, ObWindowFunctionSpec,
                   ObWindowFunctionOp, ObWindowFunctionOpInput, VECTORIZED_OP);
 
+class ObLogWindowFunction;
+class ObWindowFunctionVecSpec;
+class ObWindowFunctionVecOp;
+REGISTER_OPERATOR(ObLogWindowFunction, PHY_VEC_WINDOW_FUNCTION, ObWindowFunctionVecSpec,
+                  ObWindowFunctionVecOp, NOINPUT, VECTORIZED_OP, 0, SUPPORT_RICH_FORMAT);
+
 class ObLogJoin;
 class ObMergeJoinSpec;
 class ObMergeJoinOp;
 REGISTER_OPERATOR(ObLogJoin, PHY_MERGE_JOIN, ObMergeJoinSpec, ObMergeJoinOp,
                   NOINPUT, VECTORIZED_OP);
 
+class ObLogJoin;
+class ObMergeJoinVecSpec;
+class ObMergeJoinVecOp;
+REGISTER_OPERATOR(ObLogJoin, PHY_VEC_MERGE_JOIN, ObMergeJoinVecSpec, ObMergeJoinVecOp,
+                  NOINPUT, VECTORIZED_OP, 0 /*+version*/, SUPPORT_RICH_FORMAT);
+
+class ObLogJoin;
+class ObNestedLoopJoinVecSpec;
+class ObNestedLoopJoinVecOp;
+REGISTER_OPERATOR(ObLogJoin, PHY_VEC_NESTED_LOOP_JOIN, ObNestedLoopJoinVecSpec,
+                  ObNestedLoopJoinVecOp, NOINPUT, VECTORIZED_OP, 0 /*+version*/,
+                  SUPPORT_RICH_FORMAT);
+
 class ObLogTopk;
 class ObTopKSpec;
 class ObTopKOp;
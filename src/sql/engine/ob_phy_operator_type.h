@@ -134,6 +134,14 @@ PHY_OP_DEF(PHY_VEC_TEMP_TABLE_INSERT)
 PHY_OP_DEF(PHY_VEC_TEMP_TABLE_ACCESS)
 PHY_OP_DEF(PHY_VEC_TEMP_TABLE_TRANSFORMATION)
 PHY_OP_DEF(PHY_VEC_SORT)
+PHY_OP_DEF(PHY_VEC_WINDOW_FUNCTION)
+PHY_OP_DEF(PHY_VEC_MERGE_JOIN)
+PHY_OP_DEF(PHY_VEC_NESTED_LOOP_JOIN)
+PHY_OP_DEF(PHY_VEC_HASH_UNION)
+PHY_OP_DEF(PHY_VEC_HASH_INTERSECT)
+PHY_OP_DEF(PHY_VEC_HASH_EXCEPT)
+PHY_OP_DEF(PHY_VEC_MERGE_GROUP_BY)
+PHY_OP_DEF(PHY_VEC_MERGE_DISTINCT)
 PHY_OP_DEF(PHY_END)
 #endif /*PHY_OP_DEF*/
 
@@ -15,6 +15,7 @@
 
 #include "sql/engine/sort/ob_sort_vec_op_chunk.h"
 #include "sql/engine/sort/ob_sort_basic_info.h"
+#include "sql/engine/ob_batch_rows.h"
 
 namespace oceanbase
 {
@@ -134,6 +135,9 @@ public:
   bool operator()(const Store_Row *r, ObEvalCtx &eval_ctx);
   int with_ties_cmp(const Store_Row *r, ObEvalCtx &eval_ctx);
   int with_ties_cmp(const Store_Row *l, const Store_Row *r);
+  // compare the first sort key of the batch rows with r column at a time, and skip the rows
+  // which can not be less than r. used to pre-filter batch rows by the top of topn heap.
+  int filter_by_first_key(const Store_Row *r, const int64_t start_pos, ObBatchRows &brs);
 
 protected:
   int compare(const Store_Row *l, const Store_Row *r, const RowMeta *row_meta);
@@ -189,6 +193,9 @@ public:
   bool operator()(const Store_Row *r, ObEvalCtx &eval_ctx);
   int with_ties_cmp(const Store_Row *r, ObEvalCtx &eval_ctx);
   int with_ties_cmp(const Store_Row *l, const Store_Row *r);
+  // compare the first sort key of the batch rows with r column at a time, and skip the rows
+  // which can not be less than r. used to pre-filter batch rows by the top of topn heap.
+  int filter_by_first_key(const Store_Row *r, const int64_t start_pos, ObBatchRows &brs);
 
 protected:
   int compare(const Store_Row *l, const Store_Row *r, const RowMeta *row_meta);
@@ -120,6 +120,41 @@ int GeneralCompare<Store_Row, has_addon>::with_ties_cmp(const Store_Row *l, cons
   return cmp;
 }
 
+template <typename Store_Row, bool has_addon>
+int GeneralCompare<Store_Row, has_addon>::filter_by_first_key(const Store_Row *r,
+                                                              const int64_t start_pos,
+                                                              ObBatchRows &brs)
+{
+  int &ret = ret_;
+  if (OB_UNLIKELY(OB_SUCCESS != ret) || OB_UNLIKELY(cnt_ <= 0)) {
+  } else {
+    const ObSortFieldCollation &sort_collation = cmp_sort_collations_->at(0);
+    const ObExpr *e = cmp_sk_exprs_->at(sort_collation.field_idx_);
+    const SortKeyColResult &col_result = sk_col_result_list_[0];
+    NullSafeRowCmpFunc cmp_func = cmp_funcs_.at(0);
+    const bool r_null = r->is_null(sort_collation.field_idx_);
+    const char *r_data = nullptr;
+    ObLength r_len = 0;
+    r->get_cell_payload(*sk_row_meta_, sort_collation.field_idx_, r_data, r_len);
+    for (int64_t i = start_pos; OB_SUCC(ret) && i < brs.size_; i++) {
+      int cmp = 0;
+      if (brs.skip_->exist(i)) {
+      } else if (OB_FAIL(cmp_func(e->obj_meta_, e->obj_meta_, col_result.get_payload(i),
+                                  col_result.get_length(i), col_result.is_null(i), r_data, r_len,
+                                  r_null, cmp))) {
+        SQL_ENG_LOG(WARN, "failed to compare", K(ret));
+      } else {
+        cmp = sort_collation.is_ascending_ ? -cmp : cmp;
+        // equal rows need the following sort keys to decide unless there is only one key
+        if (cmp < 0 || (0 == cmp && 1 == cnt_)) {
+          brs.set_skip(i);
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 template <typename Store_Row, bool has_addon>
 int GeneralCompare<Store_Row, has_addon>::compare(const Store_Row *l, const Store_Row *r,
                                                   const RowMeta *row_meta)
@@ -360,6 +395,33 @@ int FixedCompare<Store_Row, has_addon>::with_ties_cmp(const Store_Row *l, const
   return cmp;
 }
 
+template <typename Store_Row, bool has_addon>
+int FixedCompare<Store_Row, has_addon>::filter_by_first_key(const Store_Row *r,
+                                                            const int64_t start_pos,
+                                                            ObBatchRows &brs)
+{
+  int &ret = ret_;
+  if (OB_UNLIKELY(OB_SUCCESS != ret) || OB_UNLIKELY(cnt_ <= 0)) {
+  } else {
+    const ObSortFieldCollation &sort_collation = cmp_sort_collations_->at(0);
+    const SortKeyColResult &col_result = sk_col_result_list_[0];
+    CmpFunc cmp_func = basic_cmp_funcs_.at(0);
+    const bool r_null = r->is_null(sort_collation.field_idx_);
+    const char *r_data = r->get_cell_payload(*sk_row_meta_, sort_collation.field_idx_);
+    for (int64_t i = start_pos; i < brs.size_; i++) {
+      if (!brs.skip_->exist(i)) {
+        int cmp = cmp_func(col_result.get_payload(i), col_result.is_null(i), r_data, r_null);
+        cmp = sort_collation.is_ascending_ ? -cmp : cmp;
+        // equal rows need the following sort keys to decide unless there is only one key
+        if (cmp < 0 || (0 == cmp && 1 == cnt_)) {
+          brs.set_skip(i);
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 template <typename Store_Row, bool has_addon>
 int FixedCompare<Store_Row, has_addon>::compare(const Store_Row *l, const Store_Row *r,
                                                 const RowMeta *row_meta)
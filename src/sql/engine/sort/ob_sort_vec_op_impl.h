@@ -60,7 +60,7 @@ public:
     ties_array_pos_(0), ties_array_(), sorted_dumped_rows_ptrs_(), last_ties_row_(nullptr), rows_(nullptr),
     sort_exprs_getter_(allocator_),
     store_row_factory_(allocator_, sql_mem_processor_, sk_row_meta_, addon_row_meta_, inmem_row_size_, topn_cnt_),
-    topn_filter_(nullptr), is_topn_filter_enabled_(false)
+    topn_filter_(nullptr), is_topn_filter_enabled_(false), topn_prefilter_brs_()
   {}
   virtual ~ObSortVecOpImpl()
   {
@@ -232,6 +232,14 @@ protected:
   int add_heap_sort_batch(const ObBatchRows &input_brs, const uint16_t selector[],
                           const int64_t size);
   int adjust_topn_heap(const Store_Row *&store_row);
+  // once the topn heap is full, rows not less than the heap top are dropped before they are
+  // compared with the heap row by row.
+  bool need_topn_prefilter() const
+  {
+    return use_heap_sort_ && !is_fetch_with_ties_ && OB_NOT_NULL(topn_prefilter_brs_.skip_)
+           && topn_heap_->count() > 0 && topn_heap_->count() == topn_cnt_ - outputted_rows_cnt_;
+  }
+  int topn_prefilter(const ObBatchRows &input_brs, const int64_t start_pos);
   int adjust_topn_heap_with_ties(const Store_Row *&store_row);
   int copy_to_topn_row(Store_Row *&new_row);
   // row is in parameter and out parameter.
@@ -443,6 +451,7 @@ protected:
   ObSortVecOpStoreRowFactory<Store_Row, has_addon> store_row_factory_;
   ObSortVecOpEagerFilter<Compare, Store_Row, has_addon> *topn_filter_;
   bool is_topn_filter_enabled_;
+  ObBatchRows topn_prefilter_brs_;
 };
 
 } // end namespace sql
@@ -79,6 +79,10 @@ void ObSortVecOpImpl<Compare, Store_Row, has_addon>::reset()
       mem_context_->get_malloc_allocator().free(topn_filter_);
       topn_filter_ = nullptr;
     }
+    if (nullptr != topn_prefilter_brs_.skip_) {
+      mem_context_->get_malloc_allocator().free(topn_prefilter_brs_.skip_);
+      topn_prefilter_brs_.skip_ = nullptr;
+    }
     if (nullptr != topn_heap_) {
       for (int64_t i = 0; i < topn_heap_->count(); ++i) {
         store_row_factory_.free_row_store(topn_heap_->at(i));
@@ -300,6 +304,12 @@ int ObSortVecOpImpl<Compare, Store_Row, has_addon>::init(ObSortVecOpContext &ctx
                               sizeof(*addon_rows_) * batch_size)))) {
       ret = OB_ALLOCATE_MEMORY_FAILED;
       SQL_ENG_LOG(WARN, "allocate memory failed", K(ret));
+    } else if (is_topn_sort() && !is_fetch_with_ties_ && batch_size > 0
+               && OB_ISNULL(topn_prefilter_brs_.skip_ = to_bit_vector(
+                              mem_context_->get_malloc_allocator().alloc(
+                                ObBitVector::memory_size(batch_size))))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      SQL_ENG_LOG(WARN, "allocate memory failed", K(ret));
     } else {
       quick_sort_array_.set_block_allocator(
         ModulePageAllocator(mem_context_->get_malloc_allocator(), "SortOpRows"));
@@ -369,6 +379,16 @@ int ObSortVecOpImpl<Compare, Store_Row, has_addon>::add_batch(const ObBatchRows
     } else {
       input_brs_ptr = &input_brs;
     }
+    if (OB_SUCC(ret) && need_topn_prefilter()) {
+      if (need_load_data && OB_FAIL(load_data_to_comp(input_brs))) {
+        SQL_ENG_LOG(WARN, "failed to load data", K(ret));
+      } else if (OB_FAIL(topn_prefilter(*input_brs_ptr, start_pos))) {
+        SQL_ENG_LOG(WARN, "failed to prefilter by topn heap", K(ret));
+      } else {
+        need_load_data = false;
+        input_brs_ptr = &topn_prefilter_brs_;
+      }
+    }
     if (OB_SUCC(ret)) {
       if (use_heap_sort_) {
         ret = add_heap_sort_batch(*input_brs_ptr, start_pos, append_row_count,
@@ -587,6 +607,24 @@ int ObSortVecOpImpl<Compare, Store_Row, has_addon>::adjust_topn_heap(const Store
   return ret;
 }
 
+template <typename Compare, typename Store_Row, bool has_addon>
+int ObSortVecOpImpl<Compare, Store_Row, has_addon>::topn_prefilter(const ObBatchRows &input_brs,
+                                                                   const int64_t start_pos)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(topn_heap_->top())) {
+    ret = OB_ERR_UNEXPECTED;
+    SQL_ENG_LOG(WARN, "unexpected error.top of the heap is nullptr", K(ret),
+                K(topn_heap_->count()));
+  } else if (OB_FAIL(topn_prefilter_brs_.copy(&input_brs))) {
+    SQL_ENG_LOG(WARN, "failed to copy batch rows", K(ret));
+  } else if (OB_FAIL(comp_.filter_by_first_key(topn_heap_->top(), start_pos,
+                                               topn_prefilter_brs_))) {
+    SQL_ENG_LOG(WARN, "failed to filter by first sort key", K(ret));
+  }
+  return ret;
+}
+
 // for order by c1 desc fetch next 5 rows with ties:
 //  row < heap.top: add row to ties_array_
 //  row = heap.top: add row to ties_array_
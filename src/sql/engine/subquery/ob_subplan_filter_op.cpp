@@ -335,6 +335,16 @@ int ObSubQueryIterator::set_refactored(const DatumRow &row,
   return ret;
 }
 
+bool ObSubQueryIterator::can_skip_rewind() const
+{
+  return has_hashmap()
+         && !onetime_plan_
+         && !init_plan_
+         && OB_NOT_NULL(parent_)
+         && !parent_->enable_left_das_batch()
+         && !parent_->enable_px_batch_rescan();
+}
+
 int ObSubQueryIterator::reset_hash_map()
 {
   int ret = OB_SUCCESS;
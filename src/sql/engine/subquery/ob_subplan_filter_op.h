@@ -90,6 +90,9 @@ public:
   int set_refactored(const DatumRow &row, const ObDatum &result, const int64_t deep_copy_size);
   void set_parent(const ObSubPlanFilterOp *filter) { parent_ = filter; }
   int reset_hash_map();
+  //result found in hashmap can skip rewind of subplan, except batch rescan
+  //which rewind drives the param group of subplan
+  bool can_skip_rewind() const;
 
   bool check_can_insert(const int64_t deep_copy_size)
   {
@@ -205,7 +208,7 @@ public:
     return common::OB_SUCCESS;
   }
   int handle_next_row();
-  bool enable_px_batch_rescan() { return enable_left_px_batch_; }
+  bool enable_px_batch_rescan() const { return enable_left_px_batch_; }
   //for vectorized
   int inner_get_next_batch(const int64_t max_row_cnt);
   // for vectorized end
@@ -12,6 +12,7 @@
 
 #define USING_LOG_PREFIX SQL
 #include "ob_external_table_access_service.h"
+#include "ob_parquet_table_row_iter.h"
 
 #include "sql/resolver/ob_resolver_utils.h"
 #include "sql/engine/expr/ob_expr.h"
@@ -20,6 +21,7 @@
 #include "share/backup/ob_backup_io_adapter.h"
 #include "share/external_table/ob_external_table_utils.h"
 #include "share/ob_device_manager.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 #include "lib/utility/ob_macro_utils.h"
 
 namespace oceanbase
@@ -348,6 +350,12 @@ int ObExternalTableAccessService::table_scan(
         LOG_WARN("alloc memory failed", K(ret));
       }
       break;
+    case ObExternalFileFormat::PARQUET_FORMAT:
+      if (OB_ISNULL(row_iter = OB_NEWx(ObParquetTableRowIterator, (scan_param.allocator_)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("alloc memory failed", K(ret));
+      }
+      break;
     default:
       ret = OB_ERR_UNEXPECTED;
       LOG_WARN("unexpected format", K(ret), "format", param.external_file_format_.format_type_);
@@ -376,6 +384,7 @@ int ObExternalTableAccessService::table_rescan(ObVTableScanParam &param, ObNewRo
   } else {
     switch (param.external_file_format_.format_type_) {
       case ObExternalFileFormat::CSV_FORMAT:
+      case ObExternalFileFormat::PARQUET_FORMAT:
         result->reset();
         break;
       default:
@@ -410,6 +419,8 @@ int ObExternalTableAccessService::revert_scan_iter(ObNewRowIterator *iter)
 
 ObCSVTableRowIterator::~ObCSVTableRowIterator()
 {
+  read_aheader_.destroy();
+  LOG_TRACE("external table scan stat", K_(scan_stat));
   release_buf();
   if (nullptr != bit_vector_cache_) {
     allocator_.free(bit_vector_cache_);
@@ -525,15 +536,26 @@ int ObCSVTableRowIterator::init(const storage::ObTableScanParam *scan_param)
     OZ (init_exprs(scan_param));
     OZ (data_access_driver_.init(scan_param_->external_file_location_, scan_param->external_file_access_info_));
     OZ (expand_buf());
+    if (OB_SUCC(ret)) {
+      int64_t read_ahead_window = 0;
+      omt::ObTenantConfigGuard tenant_config(TENANT_CONF(scan_param->tenant_id_));
+      if (tenant_config.is_valid()) {
+        read_ahead_window = tenant_config->_external_table_read_ahead_window;
+      }
+      if (read_ahead_window > 0) {
+        OZ (read_aheader_.init(allocator_, data_access_driver_, read_ahead_window,
+                               state_.buf_len_, scan_stat_));
+      }
+    }
   }
   return ret;
 }
 
-int ObCSVTableRowIterator::get_next_file_and_line_number(const int64_t task_idx,
-                                                         ObString &file_url,
-                                                         int64_t &file_id,
-                                                         int64_t &start_line,
-                                                         int64_t &end_line)
+int ObExternalTableRowIterator::get_next_file_and_line_number(const int64_t task_idx,
+                                                              ObString &file_url,
+                                                              int64_t &file_id,
+                                                              int64_t &start_line,
+                                                              int64_t &end_line)
 {
   int ret = OB_SUCCESS;
   if (task_idx >= scan_param_->key_ranges_.count()) {
@@ -557,7 +579,11 @@ int ObCSVTableRowIterator::open_next_file()
   ObString location = scan_param_->external_file_location_;
 
   if (data_access_driver_.is_opened()) {
-    data_access_driver_.close();
+    if (OB_FAIL(read_aheader_.stop())) {
+      LOG_WARN("failed to stop read ahead", K(ret));
+    } else {
+      data_access_driver_.close();
+    }
   }
 
   do {
@@ -567,8 +593,9 @@ int ObCSVTableRowIterator::open_next_file()
     int64_t end_line = 0;
     int64_t task_idx = state_.file_idx_++;
     url_.reuse();
-    ret = get_next_file_and_line_number(task_idx, file_url, file_id, start_line, end_line);
-    if (OB_SUCC(ret)) {
+    if (OB_FAIL(ret)) {
+    } else if (OB_SUCC(get_next_file_and_line_number(task_idx, file_url, file_id,
+                                                     start_line, end_line))) {
       if (start_line == MIN_EXTERNAL_TABLE_LINE_NUMBER && end_line == INT64_MAX) {
         state_.cur_file_name_ = file_url;
         state_.cur_file_id_ = file_id;
@@ -592,6 +619,9 @@ int ObCSVTableRowIterator::open_next_file()
     LOG_DEBUG("try next file", K(ret), K(url_), K(file_url), K(state_));
   } while (OB_SUCC(ret) && 0 >= state_.file_size_); //skip empty file
   OZ (data_access_driver_.open(url_.string()), url_);
+  if (OB_SUCC(ret) && read_aheader_.is_inited()) {
+    OZ (read_aheader_.start(state_.file_size_));
+  }
 
   LOG_DEBUG("open external file", K(ret), K(url_), K(state_.file_size_), K(location));
 
@@ -630,7 +660,7 @@ int ObCSVTableRowIterator::load_next_buf()
 
     if (OB_SUCC(ret)) {
       int64_t read_size = 0;
-      OZ (data_access_driver_.pread(next_load_pos, next_buf_len, state_.file_offset_, read_size));
+      OZ (read_file(next_load_pos, next_buf_len, read_size));
       if (OB_SUCC(ret)) {
         state_.file_offset_ += read_size;
         state_.pos_ = state_.buf_;
@@ -643,6 +673,24 @@ int ObCSVTableRowIterator::load_next_buf()
   return ret;
 }
 
+int ObCSVTableRowIterator::read_file(char *buf, const int64_t len, int64_t &read_size)
+{
+  int ret = OB_SUCCESS;
+  if (read_aheader_.is_inited()) {
+    ret = read_aheader_.read(buf, len, read_size);
+  } else {
+    const int64_t begin_ts = ObTimeUtility::current_time();
+    ret = data_access_driver_.pread(buf, len, state_.file_offset_, read_size);
+    const int64_t cost = ObTimeUtility::current_time() - begin_ts;
+    // scan thread is blocked by synchronous read
+    scan_stat_.io_time_us_ += cost;
+    scan_stat_.wait_time_us_ += cost;
+    scan_stat_.read_bytes_ += read_size;
+    scan_stat_.read_count_++;
+  }
+  return ret;
+}
+
 int ObCSVTableRowIterator::skip_lines()
 {
   int ret = OB_SUCCESS;
@@ -766,6 +814,8 @@ int ObCSVTableRowIterator::get_next_rows(int64_t &count, int64_t capacity)
   int64_t batch_size = capacity;
   int64_t returned_row_cnt = 0; // rows count for scan output, exclude blank lines or skip header
   bool is_oracle_mode = lib::is_oracle_mode();
+  const int64_t begin_ts = ObTimeUtility::current_time();
+  const int64_t begin_wait_time = scan_stat_.wait_time_us_;
 
   if (OB_ISNULL(bit_vector_cache_)) {
     void *mem = nullptr;
@@ -858,6 +908,8 @@ int ObCSVTableRowIterator::get_next_rows(int64_t &count, int64_t capacity)
   }
 
   count = returned_row_cnt;
+  scan_stat_.parse_time_us_ += ObTimeUtility::current_time() - begin_ts
+                               - (scan_stat_.wait_time_us_ - begin_wait_time);
 
   return ret;
 }
@@ -865,7 +917,13 @@ int ObCSVTableRowIterator::get_next_rows(int64_t &count, int64_t capacity)
 void ObCSVTableRowIterator::reset()
 {
   // reset state_ to initial values for rescan
+  int tmp_ret = OB_SUCCESS;
+  if (OB_TMP_FAIL(read_aheader_.stop())) {
+    LOG_WARN("failed to stop read ahead", K(tmp_ret));
+  }
   state_.reuse();
+  LOG_TRACE("external table scan stat", K_(scan_stat));
+  scan_stat_.reset();
 }
 
 
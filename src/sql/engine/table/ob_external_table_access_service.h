@@ -21,6 +21,7 @@
 #include "storage/access/ob_dml_param.h"
 #include "common/storage/ob_io_device.h"
 #include "share/backup/ob_backup_struct.h"
+#include "sql/engine/table/ob_external_table_read_ahead.h"
 
 
 namespace oceanbase
@@ -71,6 +72,12 @@ public:
     scan_param_ = scan_param;
     return common::OB_SUCCESS;
   }
+protected:
+  int get_next_file_and_line_number(const int64_t task_idx,
+                                    common::ObString &file_url,
+                                    int64_t &file_id,
+                                    int64_t &start_line,
+                                    int64_t &end_line);
 protected:
   const storage::ObTableScanParam *scan_param_;
 };
@@ -152,12 +159,8 @@ private:
   int expand_buf();
   int load_next_buf();
   int open_next_file();
-  int get_next_file_and_line_number(const int64_t task_idx,
-                                    common::ObString &file_url,
-                                    int64_t &file_id,
-                                    int64_t &start_line,
-                                    int64_t &end_line);
   int skip_lines();
+  int read_file(char *buf, const int64_t len, int64_t &read_size);
   void release_buf();
   void dump_error_log(common::ObIArray<ObCSVGeneralParser::LineErrRec> &error_msgs);
   int init_exprs(const storage::ObTableScanParam *scan_param);
@@ -167,6 +170,9 @@ private:
   common::ObMalloc allocator_;
   ObCSVGeneralParser parser_;
   ObExternalDataAccessDriver data_access_driver_;
+  // declared after data_access_driver_, reads in flight are waited before driver is closed
+  ObExternalReadAheader read_aheader_;
+  ObExternalScanStat scan_stat_;
   ObSqlString url_;
   ObSEArray<ObExpr*, 16> column_exprs_;
   ObExpr *line_number_expr_;
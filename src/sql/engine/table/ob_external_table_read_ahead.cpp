@@ -0,0 +1,316 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+#include "ob_external_table_read_ahead.h"
+#include "ob_external_table_access_service.h"
+#include "lib/time/ob_time_utility.h"
+#include "lib/stat/ob_diagnose_info.h"
+#include "lib/worker.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace sql
+{
+
+/* ObExternalReadAheadPool */
+
+ObExternalReadAheadPool &ObExternalReadAheadPool::get_instance()
+{
+  static ObExternalReadAheadPool instance;
+  return instance;
+}
+
+int ObExternalReadAheadPool::submit(void *task)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!ATOMIC_LOAD(&is_inited_))) {
+    lib::ObMutexGuard guard(lock_);
+    if (is_inited_) {
+    } else if (OB_FAIL(init(THREAD_NUM, TASK_NUM_LIMIT, "ExtReadAhead"))) {
+      LOG_WARN("failed to init read ahead pool", K(ret));
+    } else {
+      ATOMIC_STORE(&is_inited_, true);
+    }
+  }
+  if (OB_SUCC(ret) && OB_FAIL(push(task))) {
+    LOG_TRACE("failed to push read ahead task", K(ret));
+  }
+  return ret;
+}
+
+void ObExternalReadAheadPool::handle(void *task)
+{
+  ObExternalReadAheader::Slot *slot = static_cast<ObExternalReadAheader::Slot *>(task);
+  if (OB_NOT_NULL(slot) && OB_NOT_NULL(slot->owner_)) {
+    slot->owner_->do_read(*slot);
+  }
+}
+
+/* ObExternalReadAheader */
+
+int ObExternalReadAheader::init(ObIAllocator &allocator,
+                                ObExternalDataAccessDriver &driver,
+                                const int64_t window,
+                                const int64_t buf_size,
+                                ObExternalScanStat &stat)
+{
+  int ret = OB_SUCCESS;
+  void *mem = nullptr;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_UNLIKELY(window <= 0 || window > MAX_WINDOW || buf_size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(window), K(buf_size));
+  } else if (OB_FAIL(cond_.init(ObWaitEventIds::DEFAULT_COND_WAIT))) {
+    LOG_WARN("failed to init cond", K(ret));
+  } else if (OB_ISNULL(mem = allocator.alloc(sizeof(Slot) * window))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc slots", K(ret), K(window));
+  } else {
+    allocator_ = &allocator;
+    driver_ = &driver;
+    stat_ = &stat;
+    slots_ = new (mem) Slot[window];
+    slot_cnt_ = window;
+    buf_size_ = buf_size;
+    for (int64_t i = 0; OB_SUCC(ret) && i < slot_cnt_; ++i) {
+      slots_[i].owner_ = this;
+      if (OB_ISNULL(slots_[i].buf_ = static_cast<char *>(allocator.alloc(buf_size)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("failed to alloc read ahead buffer", K(ret), K(buf_size));
+      }
+    }
+    is_inited_ = true;
+  }
+  if (OB_FAIL(ret) && OB_INIT_TWICE != ret) {
+    destroy();
+  }
+  return ret;
+}
+
+void ObExternalReadAheader::destroy()
+{
+  if (is_inited_) {
+    // buffers are written by io threads until the reads in flight are done
+    ATOMIC_STORE(&is_canceled_, true);
+    (void) wait_inflight(false);
+  }
+  if (OB_NOT_NULL(slots_)) {
+    for (int64_t i = 0; i < slot_cnt_; ++i) {
+      if (OB_NOT_NULL(slots_[i].buf_)) {
+        allocator_->free(slots_[i].buf_);
+      }
+      slots_[i].~Slot();
+    }
+    allocator_->free(slots_);
+    slots_ = nullptr;
+  }
+  slot_cnt_ = 0;
+  if (is_inited_) {
+    cond_.destroy();
+  }
+  is_inited_ = false;
+}
+
+int ObExternalReadAheader::stop()
+{
+  int ret = OB_SUCCESS;
+  if (is_inited_) {
+    ATOMIC_STORE(&is_canceled_, true);
+    if (OB_FAIL(wait_inflight(true))) {
+      LOG_WARN("failed to wait reads in flight", K(ret), KPC(this));
+    }
+  }
+  return ret;
+}
+
+int ObExternalReadAheader::wait_inflight(const bool need_check)
+{
+  int ret = OB_SUCCESS;
+  ObThreadCondGuard guard(cond_);
+  while (OB_SUCC(ret) && inflight_cnt_ > 0) {
+    if (need_check && OB_FAIL(check_interrupt())) {
+      LOG_WARN("interrupted while waiting reads in flight", K(ret));
+    } else {
+      cond_.wait_us(1000);
+    }
+  }
+  return ret;
+}
+
+int ObExternalReadAheader::check_interrupt() const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(THIS_WORKER.is_timeout())) {
+    ret = OB_TIMEOUT;
+    LOG_WARN("query timeout", K(ret), K(THIS_WORKER.get_timeout_ts()));
+  } else if (OB_FAIL(THIS_WORKER.check_status())) {
+    LOG_WARN("worker check status failed", K(ret));
+  }
+  return ret;
+}
+
+int ObExternalReadAheader::start(const int64_t file_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_FAIL(stop())) {
+    LOG_WARN("failed to stop reads of last file", K(ret));
+  } else {
+    ATOMIC_STORE(&is_canceled_, false);
+    for (int64_t i = 0; i < slot_cnt_; ++i) {
+      slots_[i].offset_ = 0;
+      slots_[i].data_len_ = 0;
+      slots_[i].pos_ = 0;
+      slots_[i].ret_ = OB_SUCCESS;
+      slots_[i].state_ = SLOT_FREE;
+    }
+    file_size_ = file_size;
+    next_offset_ = 0;
+    submit_idx_ = 0;
+    read_idx_ = 0;
+    if (OB_FAIL(submit_reads())) {
+      LOG_WARN("failed to submit reads", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObExternalReadAheader::submit_reads()
+{
+  int ret = OB_SUCCESS;
+  Slot *to_submit[MAX_WINDOW];
+  int64_t submit_cnt = 0;
+  {
+    ObThreadCondGuard guard(cond_);
+    while (next_offset_ < file_size_ && SLOT_FREE == slots_[submit_idx_ % slot_cnt_].state_) {
+      Slot &slot = slots_[submit_idx_ % slot_cnt_];
+      slot.offset_ = next_offset_;
+      slot.data_len_ = MIN(buf_size_, file_size_ - next_offset_);
+      slot.pos_ = 0;
+      slot.ret_ = OB_SUCCESS;
+      slot.state_ = SLOT_READING;
+      next_offset_ += slot.data_len_;
+      ++submit_idx_;
+      ++inflight_cnt_;
+      to_submit[submit_cnt++] = &slot;
+    }
+  }
+  for (int64_t i = 0; i < submit_cnt; ++i) {
+    if (OB_SUCCESS != ObExternalReadAheadPool::get_instance().submit(to_submit[i])) {
+      // io threads are busy, read in current thread instead
+      do_read(*to_submit[i]);
+    }
+  }
+  return ret;
+}
+
+void ObExternalReadAheader::do_read(Slot &slot)
+{
+  int ret = OB_SUCCESS;
+  const int64_t begin_ts = ObTimeUtility::current_time();
+  int64_t total = 0;
+  int64_t read_cnt = 0;
+  {
+    lib::ObMutexGuard guard(io_lock_);
+    while (OB_SUCC(ret) && total < slot.data_len_) {
+      int64_t read_size = 0;
+      if (OB_UNLIKELY(ATOMIC_LOAD(&is_canceled_))) {
+        // stopped before the read is done, the file may be closed soon
+        ret = OB_CANCELED;
+      } else if (OB_FAIL(driver_->pread(slot.buf_ + total, slot.data_len_ - total,
+                                        slot.offset_ + total, read_size))) {
+        LOG_WARN("failed to read external file", K(ret), K(slot));
+      } else if (OB_UNLIKELY(read_size <= 0)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected end of external file", K(ret), K(slot), K(total));
+      } else {
+        total += read_size;
+        ++read_cnt;
+      }
+    }
+  }
+  ObThreadCondGuard guard(cond_);
+  slot.ret_ = ret;
+  slot.state_ = SLOT_READY;
+  stat_->read_bytes_ += total;
+  stat_->read_count_ += read_cnt;
+  stat_->io_time_us_ += ObTimeUtility::current_time() - begin_ts;
+  --inflight_cnt_;
+  cond_.broadcast();
+}
+
+int ObExternalReadAheader::wait_slot(Slot &slot)
+{
+  int ret = OB_SUCCESS;
+  ObThreadCondGuard guard(cond_);
+  if (SLOT_READING == slot.state_) {
+    const int64_t begin_ts = ObTimeUtility::current_time();
+    while (OB_SUCC(ret) && SLOT_READING == slot.state_) {
+      if (OB_FAIL(check_interrupt())) {
+        LOG_WARN("interrupted while waiting read ahead", K(ret), K(slot));
+      } else {
+        cond_.wait_us(1000);
+      }
+    }
+    stat_->wait_time_us_ += ObTimeUtility::current_time() - begin_ts;
+  }
+  if (OB_SUCC(ret)) {
+    ret = slot.ret_;
+  }
+  return ret;
+}
+
+int ObExternalReadAheader::read(char *buf, const int64_t len, int64_t &read_size)
+{
+  int ret = OB_SUCCESS;
+  read_size = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  }
+  while (OB_SUCC(ret) && read_size < len) {
+    Slot &slot = slots_[read_idx_ % slot_cnt_];
+    bool slot_done = false;
+    if (SLOT_FREE == slot.state_) {
+      // nothing submitted, end of file
+      break;
+    } else if (OB_FAIL(wait_slot(slot))) {
+      LOG_WARN("failed to read ahead", K(ret), K(slot));
+    } else {
+      const int64_t copy_len = MIN(len - read_size, slot.data_len_ - slot.pos_);
+      MEMCPY(buf + read_size, slot.buf_ + slot.pos_, copy_len);
+      slot.pos_ += copy_len;
+      read_size += copy_len;
+      slot_done = (slot.pos_ >= slot.data_len_);
+    }
+    if (OB_SUCC(ret) && slot_done) {
+      {
+        ObThreadCondGuard guard(cond_);
+        slot.state_ = SLOT_FREE;
+        ++read_idx_;
+      }
+      if (OB_FAIL(submit_reads())) {
+        LOG_WARN("failed to submit reads", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+}
+}
@@ -0,0 +1,143 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_EXTERNAL_TABLE_READ_AHEAD_H_
+#define OB_EXTERNAL_TABLE_READ_AHEAD_H_
+
+#include "lib/thread/ob_simple_thread_pool.h"
+#include "lib/lock/ob_thread_cond.h"
+#include "lib/lock/ob_mutex.h"
+#include "lib/allocator/ob_allocator.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+class ObExternalDataAccessDriver;
+class ObExternalReadAheader;
+
+struct ObExternalScanStat
+{
+  ObExternalScanStat()
+    : read_bytes_(0), read_count_(0), io_time_us_(0), wait_time_us_(0), parse_time_us_(0) {}
+  void reset()
+  {
+    read_bytes_ = 0;
+    read_count_ = 0;
+    io_time_us_ = 0;
+    wait_time_us_ = 0;
+    parse_time_us_ = 0;
+  }
+  TO_STRING_KV(K_(read_bytes), K_(read_count), K_(io_time_us), K_(wait_time_us), K_(parse_time_us));
+  int64_t read_bytes_;
+  int64_t read_count_;
+  // time spent in pread, no matter which thread issued it
+  int64_t io_time_us_;
+  // time the scan thread blocked on data not ready yet
+  int64_t wait_time_us_;
+  int64_t parse_time_us_;
+};
+
+// Shared io threads of external table read ahead, created on first use.
+class ObExternalReadAheadPool : public common::ObSimpleThreadPool
+{
+public:
+  static const int64_t THREAD_NUM = 8;
+  static const int64_t TASK_NUM_LIMIT = 4096;
+  static ObExternalReadAheadPool &get_instance();
+  int submit(void *task);
+private:
+  ObExternalReadAheadPool() : is_inited_(false) {}
+  virtual void handle(void *task) override;
+private:
+  lib::ObMutex lock_;
+  bool is_inited_;
+  DISALLOW_COPY_AND_ASSIGN(ObExternalReadAheadPool);
+};
+
+// Read a file sequentially through a window of buffers, the next reads are issued to
+// ObExternalReadAheadPool while the data already read is being parsed.
+class ObExternalReadAheader
+{
+public:
+  enum SlotState
+  {
+    SLOT_FREE = 0,
+    SLOT_READING,
+    SLOT_READY,
+  };
+  struct Slot
+  {
+    Slot() : owner_(nullptr), buf_(nullptr), offset_(0), data_len_(0), pos_(0),
+             ret_(common::OB_SUCCESS), state_(SLOT_FREE) {}
+    TO_STRING_KV(KP_(buf), K_(offset), K_(data_len), K_(pos), K_(ret), K_(state));
+    ObExternalReadAheader *owner_;
+    char *buf_;
+    int64_t offset_;
+    int64_t data_len_;
+    int64_t pos_;
+    int ret_;
+    SlotState state_;
+  };
+  static const int64_t MAX_WINDOW = 16;
+public:
+  ObExternalReadAheader()
+    : is_inited_(false), allocator_(nullptr), driver_(nullptr), stat_(nullptr), slots_(nullptr),
+      slot_cnt_(0), buf_size_(0), file_size_(0), next_offset_(0), submit_idx_(0), read_idx_(0),
+      inflight_cnt_(0), is_canceled_(false) {}
+  ~ObExternalReadAheader() { destroy(); }
+  // window is the count of buffers, each buffer is buf_size bytes
+  int init(common::ObIAllocator &allocator, ObExternalDataAccessDriver &driver,
+           const int64_t window, const int64_t buf_size, ObExternalScanStat &stat);
+  // start reading the opened file of driver from offset 0
+  int start(const int64_t file_size);
+  // cancel the reads not started yet and wait the ones in flight, must be called before driver
+  // switches file. Fails if the query is killed or timed out while waiting, the reads may be
+  // still running then, so the file must be kept open.
+  int stop();
+  void destroy();
+  int read(char *buf, const int64_t len, int64_t &read_size);
+  bool is_inited() const { return is_inited_; }
+  void do_read(Slot &slot);
+  TO_STRING_KV(K_(slot_cnt), K_(buf_size), K_(file_size), K_(next_offset),
+               K_(submit_idx), K_(read_idx), K_(inflight_cnt), K_(is_canceled));
+private:
+  int submit_reads();
+  int wait_slot(Slot &slot);
+  int wait_inflight(const bool need_check);
+  int check_interrupt() const;
+private:
+  bool is_inited_;
+  common::ObIAllocator *allocator_;
+  ObExternalDataAccessDriver *driver_;
+  ObExternalScanStat *stat_;
+  Slot *slots_;
+  int64_t slot_cnt_;
+  int64_t buf_size_;
+  int64_t file_size_;
+  // file offset of the next read to issue
+  int64_t next_offset_;
+  int64_t submit_idx_;
+  int64_t read_idx_;
+  int64_t inflight_cnt_;
+  bool is_canceled_;
+  // protect slot states and serialize preads on the shared fd of driver
+  common::ObThreadCond cond_;
+  lib::ObMutex io_lock_;
+  DISALLOW_COPY_AND_ASSIGN(ObExternalReadAheader);
+};
+
+}
+}
+
+#endif // OB_EXTERNAL_TABLE_READ_AHEAD_H_
@@ -0,0 +1,1817 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+#include "ob_parquet_table_row_iter.h"
+
+#include "sql/engine/expr/ob_expr.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
+#include "share/external_table/ob_external_table_utils.h"
+#include "lib/compress/ob_compressor_pool.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace share;
+namespace sql
+{
+
+namespace
+{
+const char PARQUET_MAGIC[] = "PAR1";
+const int64_t PARQUET_MAGIC_LEN = 4;
+const int64_t MAX_RENDER_LEN = 64;
+const int64_t USECS_PER_DAY = 86400L * 1000000L;
+const int64_t JULIAN_DAY_OF_EPOCH = 2440588;
+const char BOOL_VALUES[2] = {0, 1};
+
+enum PageType
+{
+  DATA_PAGE = 0,
+  INDEX_PAGE = 1,
+  DICTIONARY_PAGE = 2,
+  DATA_PAGE_V2 = 3,
+};
+
+enum Encoding
+{
+  PLAIN = 0,
+  PLAIN_DICTIONARY = 2,
+  RLE_DICTIONARY = 8,
+};
+
+enum Codec
+{
+  UNCOMPRESSED = 0,
+  SNAPPY = 1,
+  ZSTD = 6,
+  LZ4_RAW = 7,
+};
+
+enum Repetition
+{
+  REQUIRED = 0,
+  OPTIONAL = 1,
+  REPEATED = 2,
+};
+
+OB_INLINE int32_t bit_width_of(int64_t max_value)
+{
+  int32_t width = 0;
+  while (max_value > 0) {
+    ++width;
+    max_value >>= 1;
+  }
+  return width;
+}
+
+template <typename T>
+OB_INLINE T read_le(const char *ptr)
+{
+  T v;
+  MEMCPY(&v, ptr, sizeof(T));
+  return v;
+}
+
+// days since 1970-01-01 to y-m-d, proleptic gregorian calendar
+void civil_from_days(int64_t days, int64_t &year, int64_t &month, int64_t &day)
+{
+  days += 719468;
+  const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  const int64_t doe = days - era * 146097;
+  const int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const int64_t mp = (5 * doy + 2) / 153;
+  day = doy - (153 * mp + 2) / 5 + 1;
+  month = mp < 10 ? mp + 3 : mp - 9;
+  year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+}
+
+int print_date(const int64_t days, char *buf, const int64_t buf_len, int64_t &pos)
+{
+  int64_t year = 0;
+  int64_t month = 0;
+  int64_t day = 0;
+  civil_from_days(days, year, month, day);
+  return databuff_printf(buf, buf_len, pos, "%04ld-%02ld-%02ld", year, month, day);
+}
+
+int print_datetime(const int64_t usec, char *buf, const int64_t buf_len, int64_t &pos)
+{
+  int ret = OB_SUCCESS;
+  int64_t days = usec / USECS_PER_DAY;
+  int64_t usec_of_day = usec % USECS_PER_DAY;
+  if (usec_of_day < 0) {
+    usec_of_day += USECS_PER_DAY;
+    --days;
+  }
+  const int64_t secs = usec_of_day / 1000000;
+  if (OB_FAIL(print_date(days, buf, buf_len, pos))) {
+  } else {
+    ret = databuff_printf(buf, buf_len, pos, " %02ld:%02ld:%02ld.%06ld",
+                          secs / 3600, secs / 60 % 60, secs % 60, usec_of_day % 1000000);
+  }
+  return ret;
+}
+
+int print_decimal(const __int128 value, const int32_t scale,
+                  char *buf, const int64_t buf_len, int64_t &pos)
+{
+  int ret = OB_SUCCESS;
+  char digits[64];
+  int64_t digit_cnt = 0;
+  const bool is_neg = value < 0;
+  unsigned __int128 abs_value = is_neg ? -static_cast<unsigned __int128>(value) : static_cast<unsigned __int128>(value);
+  do {
+    digits[digit_cnt++] = static_cast<char>('0' + abs_value % 10);
+    abs_value /= 10;
+  } while (abs_value > 0 && digit_cnt < sizeof(digits));
+  while (digit_cnt <= scale && digit_cnt < sizeof(digits)) {
+    digits[digit_cnt++] = '0';
+  }
+  if (OB_UNLIKELY(pos + digit_cnt + 2 > buf_len)) {
+    ret = OB_SIZE_OVERFLOW;
+  } else {
+    if (is_neg) {
+      buf[pos++] = '-';
+    }
+    for (int64_t i = digit_cnt - 1; i >= 0; --i) {
+      buf[pos++] = digits[i];
+      if (i == scale && scale > 0) {
+        buf[pos++] = '.';
+      }
+    }
+  }
+  return ret;
+}
+
+int get_compressor_type(const int32_t codec, ObCompressorType &type)
+{
+  int ret = OB_SUCCESS;
+  switch (codec) {
+    case SNAPPY:
+      type = SNAPPY_COMPRESSOR;
+      break;
+    case ZSTD:
+      type = ZSTD_COMPRESSOR;
+      break;
+    case LZ4_RAW:
+      type = LZ4_COMPRESSOR;
+      break;
+    default:
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("parquet compression codec not supported", K(ret), K(codec));
+      LOG_USER_ERROR(OB_NOT_SUPPORTED, "parquet compression codec");
+  }
+  return ret;
+}
+}
+
+/* ObParquetThriftReader */
+
+int ObParquetThriftReader::read_byte(uint8_t &v)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(pos_ >= end_)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("unexpected end of thrift buffer", K(ret));
+  } else {
+    v = static_cast<uint8_t>(*pos_++);
+  }
+  return ret;
+}
+
+int ObParquetThriftReader::read_varint(uint64_t &v)
+{
+  int ret = OB_SUCCESS;
+  uint8_t byte = 0;
+  int64_t shift = 0;
+  v = 0;
+  do {
+    if (OB_FAIL(read_byte(byte))) {
+    } else if (OB_UNLIKELY(shift > 63)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("varint is too long", K(ret));
+    } else {
+      v |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      shift += 7;
+    }
+  } while (OB_SUCC(ret) && (byte & 0x80));
+  return ret;
+}
+
+int ObParquetThriftReader::read_i32(int32_t &v)
+{
+  int ret = OB_SUCCESS;
+  uint64_t u = 0;
+  if (OB_SUCC(read_varint(u))) {
+    v = static_cast<int32_t>((u >> 1) ^ -(u & 1));
+  }
+  return ret;
+}
+
+int ObParquetThriftReader::read_i64(int64_t &v)
+{
+  int ret = OB_SUCCESS;
+  uint64_t u = 0;
+  if (OB_SUCC(read_varint(u))) {
+    v = static_cast<int64_t>((u >> 1) ^ -(u & 1));
+  }
+  return ret;
+}
+
+int ObParquetThriftReader::read_binary(ObString &v)
+{
+  int ret = OB_SUCCESS;
+  uint64_t len = 0;
+  if (OB_FAIL(read_varint(len))) {
+  } else if (OB_UNLIKELY(len > static_cast<uint64_t>(end_ - pos_))) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("binary length out of range", K(ret), K(len));
+  } else {
+    v.assign_ptr(pos_, static_cast<ObString::obstr_size_t>(len));
+    pos_ += len;
+  }
+  return ret;
+}
+
+int ObParquetThriftReader::read_field_begin(int8_t &type, int16_t &field_id)
+{
+  int ret = OB_SUCCESS;
+  uint8_t byte = 0;
+  if (OB_SUCC(read_byte(byte))) {
+    type = static_cast<int8_t>(byte & 0x0f);
+    if (T_STOP == type) {
+    } else if (0 != (byte >> 4)) {
+      field_id = static_cast<int16_t>(field_id + (byte >> 4));
+    } else {
+      int32_t id = 0;
+      if (OB_SUCC(read_i32(id))) {
+        field_id = static_cast<int16_t>(id);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObParquetThriftReader::read_list_begin(int8_t &elem_type, int64_t &size)
+{
+  int ret = OB_SUCCESS;
+  uint8_t byte = 0;
+  if (OB_SUCC(read_byte(byte))) {
+    elem_type = static_cast<int8_t>(byte & 0x0f);
+    size = byte >> 4;
+    if (15 == size) {
+      uint64_t u = 0;
+      if (OB_SUCC(read_varint(u))) {
+        size = static_cast<int64_t>(u);
+      }
+    }
+    if (OB_SUCC(ret) && OB_UNLIKELY(size < 0 || size > end_ - pos_)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid list size", K(ret), K(size));
+    }
+  }
+  return ret;
+}
+
+int ObParquetThriftReader::skip_in_container(const int8_t type)
+{
+  int ret = OB_SUCCESS;
+  uint8_t byte = 0;
+  if (T_BOOL_TRUE == type || T_BOOL_FALSE == type) {
+    // bool element of container is encoded as one byte
+    ret = read_byte(byte);
+  } else {
+    ret = skip(type);
+  }
+  return ret;
+}
+
+int ObParquetThriftReader::skip(const int8_t type)
+{
+  int ret = OB_SUCCESS;
+  uint64_t u = 0;
+  ObString str;
+  if (OB_UNLIKELY(++depth_ > MAX_SKIP_DEPTH)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("thrift struct is too deep", K(ret));
+  } else {
+    switch (type) {
+      case T_BOOL_TRUE:
+      case T_BOOL_FALSE:
+        break;
+      case T_BYTE:
+        if (OB_UNLIKELY(pos_ >= end_)) {
+          ret = OB_INVALID_DATA;
+        } else {
+          ++pos_;
+        }
+        break;
+      case T_I16:
+      case T_I32:
+      case T_I64:
+        ret = read_varint(u);
+        break;
+      case T_DOUBLE:
+        if (OB_UNLIKELY(end_ - pos_ < 8)) {
+          ret = OB_INVALID_DATA;
+        } else {
+          pos_ += 8;
+        }
+        break;
+      case T_BINARY:
+        ret = read_binary(str);
+        break;
+      case T_LIST:
+      case T_SET: {
+        int8_t elem_type = 0;
+        int64_t size = 0;
+        if (OB_SUCC(read_list_begin(elem_type, size))) {
+          for (int64_t i = 0; OB_SUCC(ret) && i < size; ++i) {
+            ret = skip_in_container(elem_type);
+          }
+        }
+        break;
+      }
+      case T_MAP: {
+        uint8_t kv_type = 0;
+        if (OB_FAIL(read_varint(u))) {
+        } else if (0 == u) {
+        } else if (OB_FAIL(read_byte(kv_type))) {
+        } else {
+          for (uint64_t i = 0; OB_SUCC(ret) && i < u; ++i) {
+            if (OB_FAIL(skip_in_container(static_cast<int8_t>(kv_type >> 4)))) {
+            } else {
+              ret = skip_in_container(static_cast<int8_t>(kv_type & 0x0f));
+            }
+          }
+        }
+        break;
+      }
+      case T_STRUCT: {
+        int16_t field_id = 0;
+        int8_t field_type = T_STOP;
+        do {
+          if (OB_FAIL(read_field_begin(field_type, field_id))) {
+          } else if (T_STOP != field_type) {
+            ret = skip(field_type);
+          }
+        } while (OB_SUCC(ret) && T_STOP != field_type);
+        break;
+      }
+      default:
+        ret = OB_INVALID_DATA;
+        LOG_WARN("unknown thrift type", K(ret), K(type));
+    }
+  }
+  --depth_;
+  return ret;
+}
+
+/* ObParquetRleDecoder */
+
+void ObParquetRleDecoder::reset()
+{
+  pos_ = nullptr;
+  end_ = nullptr;
+  bit_width_ = 0;
+  rle_left_ = 0;
+  rle_value_ = 0;
+  bp_ptr_ = nullptr;
+  bp_left_ = 0;
+  bp_bit_pos_ = 0;
+}
+
+int ObParquetRleDecoder::init(const char *buf, const int64_t len, const int32_t bit_width)
+{
+  int ret = OB_SUCCESS;
+  reset();
+  if (OB_UNLIKELY(len < 0 || bit_width < 0 || bit_width > 32)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(len), K(bit_width));
+  } else {
+    pos_ = buf;
+    end_ = buf + len;
+    bit_width_ = bit_width;
+  }
+  return ret;
+}
+
+int ObParquetRleDecoder::next_run()
+{
+  int ret = OB_SUCCESS;
+  while (OB_SUCC(ret) && 0 == rle_left_ && 0 == bp_left_) {
+    uint64_t header = 0;
+    int64_t shift = 0;
+    uint8_t byte = 0;
+    do {
+      if (OB_UNLIKELY(pos_ >= end_ || shift > 63)) {
+        ret = OB_INVALID_DATA;
+        LOG_WARN("invalid rle run header", K(ret));
+      } else {
+        byte = static_cast<uint8_t>(*pos_++);
+        header |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        shift += 7;
+      }
+    } while (OB_SUCC(ret) && (byte & 0x80));
+    if (OB_FAIL(ret)) {
+    } else if (header & 1) {
+      const int64_t groups = static_cast<int64_t>(header >> 1);
+      bp_ptr_ = pos_;
+      bp_left_ = groups * 8;
+      bp_bit_pos_ = 0;
+      // the last group may be truncated by writer, every value is bounds checked
+      pos_ = MIN(end_, pos_ + groups * bit_width_);
+    } else {
+      const int64_t bytes = (bit_width_ + 7) / 8;
+      if (OB_UNLIKELY(end_ - pos_ < bytes)) {
+        ret = OB_INVALID_DATA;
+        LOG_WARN("invalid rle run value", K(ret), K(bytes));
+      } else {
+        rle_value_ = 0;
+        for (int64_t i = 0; i < bytes; ++i) {
+          rle_value_ |= static_cast<uint32_t>(static_cast<uint8_t>(pos_[i])) << (8 * i);
+        }
+        pos_ += bytes;
+        rle_left_ = static_cast<int64_t>(header >> 1);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObParquetRleDecoder::get_next(uint32_t &v)
+{
+  int ret = OB_SUCCESS;
+  if (0 == rle_left_ && 0 == bp_left_ && OB_FAIL(next_run())) {
+    LOG_WARN("failed to get next run", K(ret));
+  } else if (rle_left_ > 0) {
+    v = rle_value_;
+    --rle_left_;
+  } else {
+    const int64_t byte_off = bp_bit_pos_ >> 3;
+    const int64_t shift = bp_bit_pos_ & 7;
+    const int64_t need_bytes = (shift + bit_width_ + 7) >> 3;
+    if (OB_UNLIKELY(bp_ptr_ + byte_off + need_bytes > end_)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("bit packed run out of range", K(ret), K(byte_off), K(need_bytes));
+    } else {
+      uint64_t word = 0;
+      for (int64_t i = 0; i < need_bytes; ++i) {
+        word |= static_cast<uint64_t>(static_cast<uint8_t>(bp_ptr_[byte_off + i])) << (8 * i);
+      }
+      v = static_cast<uint32_t>((word >> shift) & ((1ULL << bit_width_) - 1));
+      bp_bit_pos_ += bit_width_;
+      --bp_left_;
+    }
+  }
+  return ret;
+}
+
+/* ObParquetColumnReader */
+
+void ObParquetColumnReader::destroy()
+{
+  if (nullptr != page_buf_) {
+    allocator_.free(page_buf_);
+    page_buf_ = nullptr;
+  }
+  page_buf_len_ = 0;
+}
+
+int ObParquetColumnReader::open_chunk(const ObParquetChunkMeta &meta,
+                                      const char *chunk_buf,
+                                      ObIAllocator &rg_alloc)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(chunk_buf) && meta.size_ > 0) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(meta));
+  } else {
+    meta_ = meta;
+    chunk_buf_ = chunk_buf;
+    chunk_pos_ = chunk_buf;
+    chunk_end_ = chunk_buf + meta.size_;
+    page_values_left_ = 0;
+    values_pos_ = nullptr;
+    values_end_ = nullptr;
+    bool_bit_pos_ = 0;
+    dict_ = nullptr;
+    dict_cnt_ = 0;
+    rg_alloc_ = &rg_alloc;
+    def_decoder_.reset();
+    index_decoder_.reset();
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::prepare_page_buf(const int64_t len)
+{
+  int ret = OB_SUCCESS;
+  if (len > page_buf_len_) {
+    const int64_t new_len = MAX(len, OB_MALLOC_NORMAL_BLOCK_SIZE);
+    destroy();
+    if (OB_ISNULL(page_buf_ = static_cast<char *>(allocator_.alloc(new_len)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc page buffer", K(ret), K(new_len));
+    } else {
+      page_buf_len_ = new_len;
+    }
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::decompress(const char *src, const int64_t src_len,
+                                      char *dst, const int64_t dst_len)
+{
+  int ret = OB_SUCCESS;
+  ObCompressorType type = INVALID_COMPRESSOR;
+  ObCompressor *compressor = nullptr;
+  int64_t data_len = 0;
+  if (OB_FAIL(get_compressor_type(meta_.codec_, type))) {
+  } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(type, compressor))) {
+    LOG_WARN("failed to get compressor", K(ret), K(type));
+  } else if (OB_FAIL(compressor->decompress(src, src_len, dst, dst_len, data_len))) {
+    LOG_WARN("failed to decompress page", K(ret), K(src_len), K(dst_len));
+  } else if (OB_UNLIKELY(data_len != dst_len)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("decompressed size mismatch", K(ret), K(data_len), K(dst_len));
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::read_page_header(int32_t &page_type,
+                                            int32_t &compressed_size,
+                                            int32_t &uncompressed_size,
+                                            int32_t &num_values,
+                                            int32_t &encoding,
+                                            int32_t &def_levels_len,
+                                            int32_t &rep_levels_len,
+                                            bool &is_compressed)
+{
+  int ret = OB_SUCCESS;
+  ObParquetThriftReader reader(chunk_pos_, chunk_end_ - chunk_pos_);
+  int16_t field_id = 0;
+  int8_t type = ObParquetThriftReader::T_STOP;
+  page_type = -1;
+  compressed_size = -1;
+  uncompressed_size = -1;
+  num_values = 0;
+  encoding = PLAIN;
+  def_levels_len = -1;
+  rep_levels_len = 0;
+  is_compressed = true;
+  do {
+    if (OB_FAIL(reader.read_field_begin(type, field_id))) {
+    } else if (ObParquetThriftReader::T_STOP == type) {
+    } else if (1 == field_id) {
+      ret = reader.read_i32(page_type);
+    } else if (2 == field_id) {
+      ret = reader.read_i32(uncompressed_size);
+    } else if (3 == field_id) {
+      ret = reader.read_i32(compressed_size);
+    } else if (5 == field_id || 7 == field_id || 8 == field_id) {
+      // DataPageHeader, DictionaryPageHeader and DataPageHeaderV2
+      const bool is_v2 = (8 == field_id);
+      int16_t sub_id = 0;
+      int8_t sub_type = ObParquetThriftReader::T_STOP;
+      do {
+        if (OB_FAIL(reader.read_field_begin(sub_type, sub_id))) {
+        } else if (ObParquetThriftReader::T_STOP == sub_type) {
+        } else if (1 == sub_id) {
+          ret = reader.read_i32(num_values);
+        } else if (!is_v2 && 2 == sub_id) {
+          ret = reader.read_i32(encoding);
+        } else if (is_v2 && 4 == sub_id) {
+          ret = reader.read_i32(encoding);
+        } else if (is_v2 && 5 == sub_id) {
+          ret = reader.read_i32(def_levels_len);
+        } else if (is_v2 && 6 == sub_id) {
+          ret = reader.read_i32(rep_levels_len);
+        } else if (is_v2 && 7 == sub_id) {
+          is_compressed = (ObParquetThriftReader::T_BOOL_TRUE == sub_type);
+        } else {
+          ret = reader.skip(sub_type);
+        }
+      } while (OB_SUCC(ret) && ObParquetThriftReader::T_STOP != sub_type);
+    } else {
+      ret = reader.skip(type);
+    }
+  } while (OB_SUCC(ret) && ObParquetThriftReader::T_STOP != type);
+  if (OB_FAIL(ret)) {
+    LOG_WARN("failed to read page header", K(ret));
+  } else if (OB_UNLIKELY(compressed_size < 0 || uncompressed_size < 0
+                         || compressed_size > chunk_end_ - reader.get_pos())) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid page header", K(ret), K(compressed_size), K(uncompressed_size));
+  } else {
+    chunk_pos_ = reader.get_pos();
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::next_plain_value(const char *&pos, const char *end, ObString &raw)
+{
+  int ret = OB_SUCCESS;
+  int64_t width = 0;
+  if (ObParquetColumnDesc::BYTE_ARRAY == desc_.physical_type_) {
+    if (OB_UNLIKELY(end - pos < 4)) {
+      ret = OB_INVALID_DATA;
+    } else {
+      width = read_le<uint32_t>(pos);
+      pos += 4;
+    }
+  } else {
+    ret = get_value_width(width);
+  }
+  if (OB_FAIL(ret)) {
+    LOG_WARN("invalid plain value", K(ret), K_(desc));
+  } else if (OB_UNLIKELY(width > end - pos)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("plain value out of range", K(ret), K(width), K_(desc));
+  } else {
+    raw.assign_ptr(pos, static_cast<ObString::obstr_size_t>(width));
+    pos += width;
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::get_value_width(int64_t &width) const
+{
+  int ret = OB_SUCCESS;
+  switch (desc_.physical_type_) {
+    case ObParquetColumnDesc::INT32:
+    case ObParquetColumnDesc::FLOAT:
+      width = 4;
+      break;
+    case ObParquetColumnDesc::INT64:
+    case ObParquetColumnDesc::DOUBLE:
+      width = 8;
+      break;
+    case ObParquetColumnDesc::INT96:
+      width = 12;
+      break;
+    case ObParquetColumnDesc::FIXED_LEN_BYTE_ARRAY:
+      width = desc_.type_length_;
+      break;
+    default:
+      ret = OB_INVALID_DATA;
+      LOG_WARN("unexpected physical type", K(ret), K_(desc));
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::decode_dictionary(const char *buf, const int64_t len,
+                                             const int32_t num_values, ObIAllocator &rg_alloc)
+{
+  int ret = OB_SUCCESS;
+  const char *pos = buf;
+  const char *end = buf + len;
+  if (OB_UNLIKELY(num_values < 0)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid dictionary size", K(ret), K(num_values));
+  } else if (0 == num_values) {
+    dict_cnt_ = 0;
+  } else if (OB_ISNULL(dict_ = static_cast<ObString *>(
+                       rg_alloc.alloc(sizeof(ObString) * num_values)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc dictionary", K(ret), K(num_values));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < num_values; ++i) {
+      new (&dict_[i]) ObString();
+      ret = next_plain_value(pos, end, dict_[i]);
+    }
+    dict_cnt_ = num_values;
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::next_page()
+{
+  int ret = OB_SUCCESS;
+  bool got_data_page = false;
+  while (OB_SUCC(ret) && !got_data_page) {
+    int32_t page_type = -1;
+    int32_t compressed_size = 0;
+    int32_t uncompressed_size = 0;
+    int32_t num_values = 0;
+    int32_t encoding = PLAIN;
+    int32_t def_levels_len = 0;
+    int32_t rep_levels_len = 0;
+    bool is_compressed = true;
+    const char *page_data = nullptr;
+    if (OB_UNLIKELY(chunk_pos_ >= chunk_end_)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("column chunk has not enough values", K(ret), KPC(this));
+    } else if (OB_FAIL(read_page_header(page_type, compressed_size, uncompressed_size,
+                                        num_values, encoding, def_levels_len,
+                                        rep_levels_len, is_compressed))) {
+    } else {
+      page_data = chunk_pos_;
+      chunk_pos_ += compressed_size;
+    }
+    if (OB_FAIL(ret)) {
+    } else if (DICTIONARY_PAGE == page_type) {
+      char *dict_buf = const_cast<char *>(page_data);
+      if (UNCOMPRESSED == meta_.codec_) {
+        // only compressed size is checked against the chunk
+        if (OB_UNLIKELY(compressed_size != uncompressed_size)) {
+          ret = OB_INVALID_DATA;
+          LOG_WARN("invalid uncompressed dictionary page", K(ret), K(compressed_size),
+                   K(uncompressed_size));
+        }
+      } else if (OB_ISNULL(dict_buf = static_cast<char *>(rg_alloc_->alloc(uncompressed_size)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("failed to alloc dictionary page", K(ret), K(uncompressed_size));
+      } else if (OB_FAIL(decompress(page_data, compressed_size, dict_buf, uncompressed_size))) {
+      }
+      if (OB_SUCC(ret) && OB_FAIL(decode_dictionary(dict_buf, uncompressed_size,
+                                                    num_values, *rg_alloc_))) {
+        LOG_WARN("failed to decode dictionary", K(ret));
+      }
+    } else if (DATA_PAGE == page_type || DATA_PAGE_V2 == page_type) {
+      const char *buf = page_data;
+      int64_t len = compressed_size;
+      const char *levels = nullptr;
+      int64_t levels_len = 0;
+      if (DATA_PAGE_V2 == page_type) {
+        // levels of v2 page are never compressed
+        if (OB_UNLIKELY(def_levels_len < 0 || rep_levels_len < 0
+                        || def_levels_len + rep_levels_len > compressed_size
+                        || def_levels_len + rep_levels_len > uncompressed_size)) {
+          ret = OB_INVALID_DATA;
+          LOG_WARN("invalid levels length", K(ret), K(def_levels_len), K(rep_levels_len));
+        } else {
+          levels = page_data + rep_levels_len;
+          levels_len = def_levels_len;
+          buf = page_data + rep_levels_len + def_levels_len;
+          len = compressed_size - rep_levels_len - def_levels_len;
+          const int64_t raw_len = uncompressed_size - rep_levels_len - def_levels_len;
+          if (is_compressed && UNCOMPRESSED != meta_.codec_ && raw_len > 0) {
+            if (OB_FAIL(prepare_page_buf(raw_len))) {
+            } else if (OB_FAIL(decompress(buf, len, page_buf_, raw_len))) {
+            } else {
+              buf = page_buf_;
+              len = raw_len;
+            }
+          }
+        }
+      } else {
+        if (UNCOMPRESSED != meta_.codec_) {
+          if (OB_FAIL(prepare_page_buf(uncompressed_size))) {
+          } else if (OB_FAIL(decompress(buf, len, page_buf_, uncompressed_size))) {
+          } else {
+            buf = page_buf_;
+            len = uncompressed_size;
+          }
+        }
+        if (OB_SUCC(ret) && desc_.max_def_level_ > 0) {
+          if (OB_UNLIKELY(len < 4 || read_le<uint32_t>(buf) > len - 4)) {
+            ret = OB_INVALID_DATA;
+            LOG_WARN("invalid definition levels", K(ret), K(len));
+          } else {
+            levels_len = read_le<uint32_t>(buf);
+            levels = buf + 4;
+            buf += 4 + levels_len;
+            len -= 4 + levels_len;
+          }
+        }
+      }
+      if (OB_FAIL(ret)) {
+      } else if (desc_.max_def_level_ > 0
+                 && OB_FAIL(def_decoder_.init(levels, levels_len,
+                                              bit_width_of(desc_.max_def_level_)))) {
+        LOG_WARN("failed to init definition level decoder", K(ret));
+      } else if (PLAIN_DICTIONARY == encoding || RLE_DICTIONARY == encoding) {
+        if (OB_ISNULL(dict_)) {
+          ret = OB_INVALID_DATA;
+          LOG_WARN("dictionary page is missing", K(ret), KPC(this));
+        } else if (len <= 0) {
+          // all values are null
+          ret = index_decoder_.init(buf, 0, 0);
+        } else {
+          ret = index_decoder_.init(buf + 1, len - 1, static_cast<uint8_t>(buf[0]));
+        }
+      } else if (PLAIN != encoding) {
+        ret = OB_NOT_SUPPORTED;
+        LOG_WARN("parquet encoding not supported", K(ret), K(encoding));
+        LOG_USER_ERROR(OB_NOT_SUPPORTED, "parquet encoding");
+      }
+      if (OB_SUCC(ret)) {
+        page_encoding_ = encoding;
+        page_values_left_ = num_values;
+        values_pos_ = buf;
+        values_end_ = buf + len;
+        bool_bit_pos_ = 0;
+        got_data_page = num_values > 0;
+      }
+    } else {
+      // index page or unknown page, skip it
+    }
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::next_raw_value(ObString &raw)
+{
+  int ret = OB_SUCCESS;
+  if (PLAIN_DICTIONARY == page_encoding_ || RLE_DICTIONARY == page_encoding_) {
+    uint32_t idx = 0;
+    if (OB_FAIL(index_decoder_.get_next(idx))) {
+      LOG_WARN("failed to get dictionary index", K(ret));
+    } else if (OB_UNLIKELY(idx >= dict_cnt_)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("dictionary index out of range", K(ret), K(idx), K_(dict_cnt));
+    } else {
+      raw = dict_[idx];
+    }
+  } else if (ObParquetColumnDesc::BOOLEAN == desc_.physical_type_) {
+    const int64_t byte_off = bool_bit_pos_ >> 3;
+    if (OB_UNLIKELY(values_pos_ + byte_off >= values_end_)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("boolean value out of range", K(ret), K_(bool_bit_pos));
+    } else {
+      const int64_t bit = (static_cast<uint8_t>(values_pos_[byte_off]) >> (bool_bit_pos_ & 7)) & 1;
+      raw.assign_ptr(&BOOL_VALUES[bit], 1);
+      ++bool_bit_pos_;
+    }
+  } else {
+    ret = next_plain_value(values_pos_, values_end_, raw);
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::render(const ObString &raw, ObIAllocator &batch_alloc, ObDatum &datum)
+{
+  int ret = OB_SUCCESS;
+  char *buf = nullptr;
+  int64_t pos = 0;
+  const int32_t converted = desc_.converted_type_;
+  const int32_t physical = desc_.physical_type_;
+  const bool is_binary = (ObParquetColumnDesc::BYTE_ARRAY == physical
+                          || ObParquetColumnDesc::FIXED_LEN_BYTE_ARRAY == physical);
+  if (ObParquetColumnDesc::BOOLEAN == physical) {
+    datum.set_string(raw.ptr()[0] ? "1" : "0", 1);
+  } else if (is_binary && ObParquetColumnDesc::DECIMAL != converted) {
+    // values live in chunk or page buffer, which may be switched inside the batch
+    if (0 == raw.length()) {
+      datum.set_string(raw.ptr(), 0);
+    } else if (OB_ISNULL(buf = static_cast<char *>(batch_alloc.alloc(raw.length())))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc value", K(ret), K(raw.length()));
+    } else {
+      MEMCPY(buf, raw.ptr(), raw.length());
+      datum.set_string(buf, raw.length());
+    }
+  } else if (OB_ISNULL(buf = static_cast<char *>(batch_alloc.alloc(MAX_RENDER_LEN)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc value", K(ret));
+  } else {
+    switch (physical) {
+      case ObParquetColumnDesc::INT32: {
+        const int32_t v = read_le<int32_t>(raw.ptr());
+        if (ObParquetColumnDesc::DECIMAL == converted) {
+          ret = print_decimal(v, desc_.scale_, buf, MAX_RENDER_LEN, pos);
+        } else if (ObParquetColumnDesc::DATE == converted) {
+          ret = print_date(v, buf, MAX_RENDER_LEN, pos);
+        } else if (converted >= ObParquetColumnDesc::UINT_8 && converted <= ObParquetColumnDesc::UINT_32) {
+          ret = databuff_printf(buf, MAX_RENDER_LEN, pos, "%u", static_cast<uint32_t>(v));
+        } else {
+          ret = databuff_printf(buf, MAX_RENDER_LEN, pos, "%d", v);
+        }
+        break;
+      }
+      case ObParquetColumnDesc::INT64: {
+        const int64_t v = read_le<int64_t>(raw.ptr());
+        if (ObParquetColumnDesc::DECIMAL == converted) {
+          ret = print_decimal(v, desc_.scale_, buf, MAX_RENDER_LEN, pos);
+        } else if (ObParquetColumnDesc::TIMESTAMP_MILLIS == converted) {
+          ret = print_datetime(v * 1000, buf, MAX_RENDER_LEN, pos);
+        } else if (ObParquetColumnDesc::TIMESTAMP_MICROS == converted) {
+          ret = print_datetime(v, buf, MAX_RENDER_LEN, pos);
+        } else if (ObParquetColumnDesc::UINT_64 == converted) {
+          ret = databuff_printf(buf, MAX_RENDER_LEN, pos, "%lu", static_cast<uint64_t>(v));
+        } else {
+          ret = databuff_printf(buf, MAX_RENDER_LEN, pos, "%ld", v);
+        }
+        break;
+      }
+      case ObParquetColumnDesc::INT96: {
+        // legacy timestamp: nanoseconds of day followed by julian day
+        const int64_t nanos = read_le<int64_t>(raw.ptr());
+        const int32_t julian_day = read_le<int32_t>(raw.ptr() + 8);
+        ret = print_datetime((julian_day - JULIAN_DAY_OF_EPOCH) * USECS_PER_DAY + nanos / 1000,
+                             buf, MAX_RENDER_LEN, pos);
+        break;
+      }
+      case ObParquetColumnDesc::FLOAT:
+        ret = databuff_printf(buf, MAX_RENDER_LEN, pos, "%.9g", read_le<float>(raw.ptr()));
+        break;
+      case ObParquetColumnDesc::DOUBLE:
+        ret = databuff_printf(buf, MAX_RENDER_LEN, pos, "%.17g", read_le<double>(raw.ptr()));
+        break;
+      case ObParquetColumnDesc::BYTE_ARRAY:
+      case ObParquetColumnDesc::FIXED_LEN_BYTE_ARRAY: {
+        // decimal as big-endian two's complement
+        if (OB_UNLIKELY(raw.length() > static_cast<int64_t>(sizeof(__int128)))) {
+          ret = OB_NOT_SUPPORTED;
+          LOG_WARN("decimal is too long", K(ret), K(raw.length()));
+          LOG_USER_ERROR(OB_NOT_SUPPORTED, "parquet decimal longer than 16 bytes");
+        } else {
+          unsigned __int128 u = 0;
+          for (int64_t i = 0; i < raw.length(); ++i) {
+            u = (u << 8) | static_cast<uint8_t>(raw.ptr()[i]);
+          }
+          if (raw.length() > 0 && raw.length() < static_cast<int64_t>(sizeof(__int128))
+              && (static_cast<uint8_t>(raw.ptr()[0]) & 0x80)) {
+            // sign extension
+            u |= ~static_cast<unsigned __int128>(0) << (raw.length() * 8);
+          }
+          ret = print_decimal(static_cast<__int128>(u), desc_.scale_, buf, MAX_RENDER_LEN, pos);
+        }
+        break;
+      }
+      default:
+        ret = OB_INVALID_DATA;
+        LOG_WARN("unexpected physical type", K(ret), K_(desc));
+    }
+    if (OB_SUCC(ret)) {
+      datum.set_string(buf, pos);
+    }
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::read(ObDatum *datums, const int64_t count, ObIAllocator &batch_alloc)
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < count; ++i) {
+    uint32_t def_level = 0;
+    ObString raw;
+    if (0 == page_values_left_ && OB_FAIL(next_page())) {
+      LOG_WARN("failed to get next page", K(ret));
+    } else if (desc_.max_def_level_ > 0 && OB_FAIL(def_decoder_.get_next(def_level))) {
+      LOG_WARN("failed to get definition level", K(ret));
+    } else {
+      --page_values_left_;
+      if (desc_.max_def_level_ > 0 && def_level < desc_.max_def_level_) {
+        datums[i].set_null();
+      } else if (OB_FAIL(next_raw_value(raw))) {
+        LOG_WARN("failed to get value", K(ret));
+      } else if (OB_FAIL(render(raw, batch_alloc, datums[i]))) {
+        LOG_WARN("failed to render value", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::skip(const int64_t count)
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < count; ++i) {
+    uint32_t def_level = 0;
+    ObString raw;
+    if (0 == page_values_left_ && OB_FAIL(next_page())) {
+      LOG_WARN("failed to get next page", K(ret));
+    } else if (desc_.max_def_level_ > 0 && OB_FAIL(def_decoder_.get_next(def_level))) {
+      LOG_WARN("failed to get definition level", K(ret));
+    } else {
+      --page_values_left_;
+      if (desc_.max_def_level_ > 0 && def_level < desc_.max_def_level_) {
+      } else if (OB_FAIL(next_raw_value(raw))) {
+        LOG_WARN("failed to skip value", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+/* ObParquetTableRowIterator */
+
+ObParquetTableRowIterator::~ObParquetTableRowIterator()
+{
+  for (int64_t i = 0; i < column_readers_.count(); ++i) {
+    if (OB_NOT_NULL(column_readers_.at(i))) {
+      column_readers_.at(i)->~ObParquetColumnReader();
+      allocator_.free(column_readers_.at(i));
+    }
+  }
+  column_readers_.reset();
+  if (nullptr != bit_vector_cache_) {
+    allocator_.free(bit_vector_cache_);
+  }
+}
+
+int ObParquetTableRowIterator::init_exprs(const storage::ObTableScanParam *scan_param)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(scan_param)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("scan param is null", K(ret));
+  } else {
+    if (scan_param->column_ids_.count() != scan_param->output_exprs_->count()) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("column ids not equal to access expr", K(ret));
+    }
+    for (int i = 0; OB_SUCC(ret) && i < scan_param->column_ids_.count(); i++) {
+      ObExpr *cur_expr = scan_param->output_exprs_->at(i);
+      switch (scan_param->column_ids_.at(i)) {
+        case OB_HIDDEN_LINE_NUMBER_COLUMN_ID:
+          line_number_expr_ = cur_expr;
+          break;
+        case OB_HIDDEN_FILE_ID_COLUMN_ID:
+          file_id_expr_ = cur_expr;
+          break;
+        default:
+          OZ (column_exprs_.push_back(cur_expr));
+          break;
+      }
+    }
+    if (OB_SUCC(ret) && column_exprs_.count() != scan_param->ext_column_convert_exprs_->count()) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("column expr not equal to convert convert expr", K(ret),
+               K(column_exprs_), KPC(scan_param->ext_column_convert_exprs_));
+    }
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::init(const storage::ObTableScanParam *scan_param)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(scan_param)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("scan param is null", K(ret));
+  } else {
+    allocator_.set_attr(lib::ObMemAttr(scan_param->tenant_id_, "ParquetRowIter"));
+    file_allocator_.set_attr(lib::ObMemAttr(scan_param->tenant_id_, "ParquetFile"));
+    rg_allocator_.set_attr(lib::ObMemAttr(scan_param->tenant_id_, "ParquetRowGroup"));
+    batch_allocator_.set_attr(lib::ObMemAttr(scan_param->tenant_id_, "ParquetBatch"));
+    OZ (ObExternalTableRowIterator::init(scan_param));
+    OZ (init_exprs(scan_param));
+    OZ (data_access_driver_.init(scan_param_->external_file_location_, scan_param->external_file_access_info_));
+    const ExprFixedArray &file_column_exprs = *(scan_param_->ext_file_column_exprs_);
+    for (int64_t i = 0; OB_SUCC(ret) && i < file_column_exprs.count(); ++i) {
+      ObParquetColumnReader *reader = nullptr;
+      int64_t leaf_idx = static_cast<int64_t>(file_column_exprs.at(i)->extra_) - 1;
+      if (OB_UNLIKELY(leaf_idx < 0)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("invalid file column index", K(ret), K(leaf_idx));
+      } else if (OB_ISNULL(reader = OB_NEWx(ObParquetColumnReader, &allocator_, allocator_))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("alloc memory failed", K(ret));
+      } else if (OB_FAIL(column_readers_.push_back(reader))) {
+        reader->~ObParquetColumnReader();
+        allocator_.free(reader);
+        LOG_WARN("failed to push back reader", K(ret));
+      } else if (OB_FAIL(file_col_leaf_idxs_.push_back(leaf_idx))) {
+        LOG_WARN("failed to push back leaf idx", K(ret));
+      }
+    }
+    OZ (init_prune_filters());
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::init_prune_filters()
+{
+  int ret = OB_SUCCESS;
+  prune_filters_.reuse();
+  if (OB_NOT_NULL(scan_param_->pd_storage_filters_)) {
+    ret = add_prune_filter(scan_param_->pd_storage_filters_);
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::add_prune_filter(ObPushdownFilterExecutor *filter)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(filter)) {
+  } else if (filter->is_logic_and_node()) {
+    for (uint32_t i = 0; OB_SUCC(ret) && i < filter->get_child_count(); ++i) {
+      ret = add_prune_filter(filter->get_childs()[i]);
+    }
+  } else if (WHITE_FILTER_EXECUTOR == filter->get_type()) {
+    // only the filter on a column which is converted from a single file column directly
+    // can be checked against statistics of parquet column chunk
+    ObWhiteFilterExecutor *white = static_cast<ObWhiteFilterExecutor *>(filter);
+    const ObExpr *filter_expr = white->get_filter_node().expr_;
+    const ObExpr *col_expr = nullptr;
+    const ObExpr *file_col_expr = nullptr;
+    for (int64_t i = 0; OB_NOT_NULL(filter_expr) && i < filter_expr->arg_cnt_; ++i) {
+      if (OB_NOT_NULL(filter_expr->args_[i]) && T_REF_COLUMN == filter_expr->args_[i]->type_) {
+        col_expr = filter_expr->args_[i];
+      }
+    }
+    for (int64_t i = 0; OB_NOT_NULL(col_expr) && nullptr == file_col_expr
+                        && i < column_exprs_.count(); ++i) {
+      if (col_expr == column_exprs_.at(i)) {
+        const ObExpr *e = scan_param_->ext_column_convert_exprs_->at(i);
+        while (OB_NOT_NULL(e) && nullptr == file_col_expr) {
+          if (T_PSEUDO_EXTERNAL_FILE_COL == e->type_) {
+            file_col_expr = e;
+          } else if (T_FUN_COLUMN_CONV == e->type_ && e->arg_cnt_ > 4) {
+            e = e->args_[4];
+          } else if (T_FUN_SYS_CAST == e->type_ && e->arg_cnt_ > 0) {
+            e = e->args_[0];
+          } else {
+            e = nullptr;
+          }
+        }
+      }
+    }
+    const ExprFixedArray &file_column_exprs = *(scan_param_->ext_file_column_exprs_);
+    for (int64_t i = 0; OB_SUCC(ret) && OB_NOT_NULL(file_col_expr)
+                        && i < file_column_exprs.count(); ++i) {
+      if (file_col_expr == file_column_exprs.at(i)) {
+        PruneFilter prune;
+        prune.filter_ = white;
+        prune.column_idx_ = i;
+        if (OB_FAIL(prune_filters_.push_back(prune))) {
+          LOG_WARN("failed to push back prune filter", K(ret));
+        }
+        break;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::read_fully(char *buf, const int64_t len, const int64_t offset)
+{
+  int ret = OB_SUCCESS;
+  int64_t total = 0;
+  while (OB_SUCC(ret) && total < len) {
+    int64_t read_size = 0;
+    if (OB_FAIL(data_access_driver_.pread(buf + total, len - total, offset + total, read_size))) {
+      LOG_WARN("failed to read file", K(ret), K(url_), K(offset), K(len));
+    } else if (OB_UNLIKELY(read_size <= 0)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("unexpected end of file", K(ret), K(url_), K(offset), K(len), K(total));
+    } else {
+      total += read_size;
+    }
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::open_next_file()
+{
+  int ret = OB_SUCCESS;
+  ObString location = scan_param_->external_file_location_;
+
+  if (data_access_driver_.is_opened()) {
+    data_access_driver_.close();
+  }
+  file_opened_ = false;
+  file_allocator_.reuse();
+  rg_allocator_.reuse();
+  leaf_descs_.reuse();
+  row_groups_.reuse();
+  chunk_metas_.reuse();
+  cur_rg_idx_ = -1;
+  rg_rows_left_ = 0;
+
+  do {
+    ObString file_url;
+    int64_t file_id = 0;
+    int64_t start_line = 0;
+    int64_t end_line = 0;
+    int64_t task_idx = file_idx_++;
+    url_.reuse();
+    ret = get_next_file_and_line_number(task_idx, file_url, file_id, start_line, end_line);
+    if (OB_SUCC(ret)) {
+      // line number of parquet file is row number, start from 1
+      cur_file_name_ = file_url;
+      cur_file_id_ = file_id;
+      cur_row_number_ = start_line;
+      skip_rows_ = start_line - ObCSVTableRowIterator::MIN_EXTERNAL_TABLE_LINE_NUMBER;
+      row_count_limit_ = (INT64_MAX == end_line) ? INT64_MAX : end_line - start_line + 1;
+      const char *split_char = "/";
+      OZ (url_.append_fmt("%.*s%s%.*s", location.length(), location.ptr(),
+                                        (location.empty() || location[location.length() - 1] == '/') ? "" : split_char,
+                                        file_url.length(), file_url.ptr()));
+      OZ (data_access_driver_.get_file_size(url_.string(), file_size_));
+    }
+    LOG_DEBUG("try next file", K(ret), K(url_), K(file_url), K(file_size_));
+  } while (OB_SUCC(ret) && 0 >= file_size_); //skip empty file
+  OZ (data_access_driver_.open(url_.string()), url_);
+  OZ (read_file_meta());
+  if (OB_SUCC(ret)) {
+    file_opened_ = true;
+  }
+
+  LOG_DEBUG("open parquet file", K(ret), K(url_), K(file_size_), K(row_groups_.count()));
+  return ret;
+}
+
+int ObParquetTableRowIterator::read_file_meta()
+{
+  int ret = OB_SUCCESS;
+  char footer[FOOTER_SIZE];
+  char *meta_buf = nullptr;
+  int64_t meta_len = 0;
+  if (OB_UNLIKELY(file_size_ < FOOTER_SIZE + PARQUET_MAGIC_LEN)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid parquet file", K(ret), K(url_), K(file_size_));
+  } else if (OB_FAIL(read_fully(footer, FOOTER_SIZE, file_size_ - FOOTER_SIZE))) {
+    LOG_WARN("failed to read footer", K(ret));
+  } else if (OB_UNLIKELY(0 != MEMCMP(footer + 4, PARQUET_MAGIC, PARQUET_MAGIC_LEN))) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid parquet magic", K(ret), K(url_));
+  } else if (OB_FALSE_IT(meta_len = read_le<uint32_t>(footer))) {
+  } else if (OB_UNLIKELY(meta_len <= 0 || meta_len > MAX_FOOTER_LEN
+                         || meta_len > file_size_ - FOOTER_SIZE - PARQUET_MAGIC_LEN)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid parquet metadata length", K(ret), K(url_), K(meta_len), K(file_size_));
+  } else if (OB_ISNULL(meta_buf = static_cast<char *>(file_allocator_.alloc(meta_len)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc metadata buffer", K(ret), K(meta_len));
+  } else if (OB_FAIL(read_fully(meta_buf, meta_len, file_size_ - FOOTER_SIZE - meta_len))) {
+    LOG_WARN("failed to read metadata", K(ret));
+  } else if (OB_FAIL(parse_file_meta(meta_buf, meta_len))) {
+    LOG_WARN("failed to parse parquet metadata", K(ret), K(url_));
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::parse_schema_element(ObParquetThriftReader &reader,
+                                                    ObParquetColumnDesc &desc,
+                                                    int32_t &repetition_type,
+                                                    int32_t &num_children)
+{
+  int ret = OB_SUCCESS;
+  int16_t field_id = 0;
+  int8_t type = ObParquetThriftReader::T_STOP;
+  repetition_type = REQUIRED;
+  num_children = 0;
+  do {
+    if (OB_FAIL(reader.read_field_begin(type, field_id))) {
+    } else if (ObParquetThriftReader::T_STOP == type) {
+    } else if (1 == field_id) {
+      ret = reader.read_i32(desc.physical_type_);
+    } else if (2 == field_id) {
+      ret = reader.read_i32(desc.type_length_);
+    } else if (3 == field_id) {
+      ret = reader.read_i32(repetition_type);
+    } else if (5 == field_id) {
+      ret = reader.read_i32(num_children);
+    } else if (6 == field_id) {
+      ret = reader.read_i32(desc.converted_type_);
+    } else if (7 == field_id) {
+      ret = reader.read_i32(desc.scale_);
+    } else {
+      ret = reader.skip(type);
+    }
+  } while (OB_SUCC(ret) && ObParquetThriftReader::T_STOP != type);
+  return ret;
+}
+
+int ObParquetTableRowIterator::parse_statistics(ObParquetThriftReader &reader,
+                                                ObParquetChunkMeta &meta)
+{
+  int ret = OB_SUCCESS;
+  int16_t field_id = 0;
+  int8_t type = ObParquetThriftReader::T_STOP;
+  ObString legacy_min;
+  ObString legacy_max;
+  ObString min_value;
+  ObString max_value;
+  do {
+    if (OB_FAIL(reader.read_field_begin(type, field_id))) {
+    } else if (ObParquetThriftReader::T_STOP == type) {
+    } else if (1 == field_id) {
+      ret = reader.read_binary(legacy_max);
+    } else if (2 == field_id) {
+      ret = reader.read_binary(legacy_min);
+    } else if (3 == field_id) {
+      ret = reader.read_i64(meta.null_count_);
+    } else if (5 == field_id) {
+      ret = reader.read_binary(max_value);
+    } else if (6 == field_id) {
+      ret = reader.read_binary(min_value);
+    } else {
+      ret = reader.skip(type);
+    }
+  } while (OB_SUCC(ret) && ObParquetThriftReader::T_STOP != type);
+  if (OB_SUCC(ret)) {
+    // legacy min/max is only used for signed integer and floating point columns, whose
+    // sort order is not changed by the new fields
+    meta.min_ = min_value.empty() ? legacy_min : min_value;
+    meta.max_ = max_value.empty() ? legacy_max : max_value;
+    meta.has_stats_ = !meta.min_.empty() && !meta.max_.empty();
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::parse_column_meta(ObParquetThriftReader &reader,
+                                                 ObParquetChunkMeta &meta)
+{
+  int ret = OB_SUCCESS;
+  int16_t field_id = 0;
+  int8_t type = ObParquetThriftReader::T_STOP;
+  int64_t data_page_offset = -1;
+  int64_t dict_page_offset = -1;
+  do {
+    if (OB_FAIL(reader.read_field_begin(type, field_id))) {
+    } else if (ObParquetThriftReader::T_STOP == type) {
+    } else if (4 == field_id) {
+      ret = reader.read_i32(meta.codec_);
+    } else if (5 == field_id) {
+      ret = reader.read_i64(meta.num_values_);
+    } else if (7 == field_id) {
+      ret = reader.read_i64(meta.size_);
+    } else if (9 == field_id) {
+      ret = reader.read_i64(data_page_offset);
+    } else if (11 == field_id) {
+      ret = reader.read_i64(dict_page_offset);
+    } else if (12 == field_id) {
+      ret = parse_statistics(reader, meta);
+    } else {
+      ret = reader.skip(type);
+    }
+  } while (OB_SUCC(ret) && ObParquetThriftReader::T_STOP != type);
+  if (OB_SUCC(ret)) {
+    meta.offset_ = (dict_page_offset > 0 && dict_page_offset < data_page_offset)
+                   ? dict_page_offset : data_page_offset;
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::parse_column_chunk(ObParquetThriftReader &reader,
+                                                  ObParquetChunkMeta &meta)
+{
+  int ret = OB_SUCCESS;
+  int16_t field_id = 0;
+  int8_t type = ObParquetThriftReader::T_STOP;
+  do {
+    if (OB_FAIL(reader.read_field_begin(type, field_id))) {
+    } else if (ObParquetThriftReader::T_STOP == type) {
+    } else if (1 == field_id) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("column chunk in other file is not supported", K(ret));
+      LOG_USER_ERROR(OB_NOT_SUPPORTED, "parquet column chunk in other file");
+    } else if (3 == field_id) {
+      ret = parse_column_meta(reader, meta);
+    } else {
+      ret = reader.skip(type);
+    }
+  } while (OB_SUCC(ret) && ObParquetThriftReader::T_STOP != type);
+  return ret;
+}
+
+int ObParquetTableRowIterator::parse_row_group(ObParquetThriftReader &reader,
+                                               RowGroupMeta &rg,
+                                               const int64_t rg_idx)
+{
+  int ret = OB_SUCCESS;
+  int16_t field_id = 0;
+  int8_t type = ObParquetThriftReader::T_STOP;
+  ObSEArray<ObParquetChunkMeta, 16> all_chunks;
+  do {
+    if (OB_FAIL(reader.read_field_begin(type, field_id))) {
+    } else if (ObParquetThriftReader::T_STOP == type) {
+    } else if (1 == field_id) {
+      int8_t elem_type = 0;
+      int64_t size = 0;
+      if (OB_SUCC(reader.read_list_begin(elem_type, size))) {
+        for (int64_t i = 0; OB_SUCC(ret) && i < size; ++i) {
+          ObParquetChunkMeta meta;
+          if (OB_FAIL(parse_column_chunk(reader, meta))) {
+          } else if (OB_FAIL(all_chunks.push_back(meta))) {
+            LOG_WARN("failed to push back chunk meta", K(ret));
+          }
+        }
+      }
+    } else if (3 == field_id) {
+      ret = reader.read_i64(rg.num_rows_);
+    } else {
+      ret = reader.skip(type);
+    }
+  } while (OB_SUCC(ret) && ObParquetThriftReader::T_STOP != type);
+  for (int64_t i = 0; OB_SUCC(ret) && i < file_col_leaf_idxs_.count(); ++i) {
+    const int64_t leaf_idx = file_col_leaf_idxs_.at(i);
+    if (OB_UNLIKELY(leaf_idx >= all_chunks.count())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("file column index out of range", K(ret), K(leaf_idx), K(all_chunks.count()), K(rg_idx));
+    } else {
+      const ObParquetChunkMeta &meta = all_chunks.at(leaf_idx);
+      if (OB_UNLIKELY(meta.offset_ < 0 || meta.size_ < 0 || meta.offset_ + meta.size_ > file_size_)) {
+        ret = OB_INVALID_DATA;
+        LOG_WARN("invalid column chunk", K(ret), K(meta), K(file_size_), K(rg_idx));
+      } else if (OB_FAIL(chunk_metas_.push_back(meta))) {
+        LOG_WARN("failed to push back chunk meta", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::parse_file_meta(const char *buf, const int64_t len)
+{
+  int ret = OB_SUCCESS;
+  struct SchemaLevel
+  {
+    int32_t children_left_;
+    int16_t def_level_;
+    int16_t rep_level_;
+  };
+  ObParquetThriftReader reader(buf, len);
+  int16_t field_id = 0;
+  int8_t type = ObParquetThriftReader::T_STOP;
+  do {
+    if (OB_FAIL(reader.read_field_begin(type, field_id))) {
+    } else if (ObParquetThriftReader::T_STOP == type) {
+    } else if (2 == field_id) {
+      // schema is a flatten tree in depth-first order, the first element is root
+      ObSEArray<SchemaLevel, 8> stack;
+      int8_t elem_type = 0;
+      int64_t size = 0;
+      if (OB_SUCC(reader.read_list_begin(elem_type, size))) {
+        for (int64_t i = 0; OB_SUCC(ret) && i < size; ++i) {
+          ObParquetColumnDesc desc;
+          int32_t repetition_type = REQUIRED;
+          int32_t num_children = 0;
+          SchemaLevel level;
+          if (OB_FAIL(parse_schema_element(reader, desc, repetition_type, num_children))) {
+          } else if (0 == i) {
+            level.children_left_ = num_children;
+            level.def_level_ = 0;
+            level.rep_level_ = 0;
+            ret = stack.push_back(level);
+          } else if (OB_UNLIKELY(stack.empty())) {
+            ret = OB_INVALID_DATA;
+            LOG_WARN("invalid parquet schema", K(ret), K(i));
+          } else {
+            SchemaLevel &parent = stack.at(stack.count() - 1);
+            --parent.children_left_;
+            level.def_level_ = parent.def_level_ + (REQUIRED != repetition_type ? 1 : 0);
+            level.rep_level_ = parent.rep_level_ + (REPEATED == repetition_type ? 1 : 0);
+            if (num_children > 0) {
+              level.children_left_ = num_children;
+              ret = stack.push_back(level);
+            } else {
+              desc.max_def_level_ = level.def_level_;
+              desc.max_rep_level_ = level.rep_level_;
+              ret = leaf_descs_.push_back(desc);
+            }
+            while (OB_SUCC(ret) && stack.count() > 1 && stack.at(stack.count() - 1).children_left_ <= 0) {
+              stack.pop_back();
+            }
+          }
+        }
+      }
+    } else if (4 == field_id) {
+      int8_t elem_type = 0;
+      int64_t size = 0;
+      int64_t first_row = ObCSVTableRowIterator::MIN_EXTERNAL_TABLE_LINE_NUMBER;
+      if (OB_SUCC(reader.read_list_begin(elem_type, size))) {
+        for (int64_t i = 0; OB_SUCC(ret) && i < size; ++i) {
+          RowGroupMeta rg;
+          rg.first_row_ = first_row;
+          if (OB_FAIL(parse_row_group(reader, rg, i))) {
+          } else if (OB_FAIL(row_groups_.push_back(rg))) {
+            LOG_WARN("failed to push back row group", K(ret));
+          } else {
+            first_row += rg.num_rows_;
+          }
+        }
+      }
+    } else {
+      ret = reader.skip(type);
+    }
+  } while (OB_SUCC(ret) && ObParquetThriftReader::T_STOP != type);
+  for (int64_t i = 0; OB_SUCC(ret) && i < column_readers_.count(); ++i) {
+    const int64_t leaf_idx = file_col_leaf_idxs_.at(i);
+    if (OB_UNLIKELY(leaf_idx >= leaf_descs_.count())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("file column index out of range", K(ret), K(leaf_idx), K(leaf_descs_.count()));
+    } else if (OB_UNLIKELY(leaf_descs_.at(leaf_idx).max_rep_level_ > 0)) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("repeated column is not supported", K(ret), K(leaf_idx));
+      LOG_USER_ERROR(OB_NOT_SUPPORTED, "parquet repeated column");
+    } else {
+      column_readers_.at(i)->set_desc(leaf_descs_.at(leaf_idx));
+    }
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::check_filter_by_stats(const PruneFilter &prune,
+                                                     const ObParquetChunkMeta &meta,
+                                                     bool &skipped)
+{
+  int ret = OB_SUCCESS;
+  ObEvalCtx &eval_ctx = scan_param_->op_->get_eval_ctx();
+  const ObParquetColumnDesc &desc = column_readers_.at(prune.column_idx_)->get_desc();
+  const ObExpr *filter_expr = prune.filter_->get_filter_node().expr_;
+  const ObWhiteFilterOperatorType op_type = prune.filter_->get_op_type();
+  const ObObjTypeClass expect_tc = desc.is_signed_integer() ? ObIntTC : ObDoubleTC;
+  ObDatum params[2];
+  int64_t param_cnt = 0;
+  bool can_prune = meta.has_stats_ && OB_NOT_NULL(filter_expr);
+  skipped = false;
+  if (WHITE_OP_NU == op_type || WHITE_OP_NN == op_type) {
+    // checked by null count only
+    can_prune = false;
+    skipped = can_skip_by_stats(desc, meta, op_type, params, 0);
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && can_prune && i < filter_expr->arg_cnt_; ++i) {
+    const ObExpr *arg = filter_expr->args_[i];
+    ObDatum *datum = nullptr;
+    if (OB_ISNULL(arg)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected null arg", K(ret));
+    } else if (T_REF_COLUMN == arg->type_) {
+      can_prune = (expect_tc == ob_obj_type_class(arg->datum_meta_.type_));
+    } else if (param_cnt >= 2 || expect_tc != ob_obj_type_class(arg->datum_meta_.type_)) {
+      can_prune = false;
+    } else if (OB_FAIL(arg->eval(eval_ctx, datum))) {
+      LOG_WARN("failed to eval filter param", K(ret));
+    } else if (datum->is_null()) {
+      can_prune = false;
+    } else {
+      params[param_cnt++] = *datum;
+    }
+  }
+  if (OB_SUCC(ret) && can_prune) {
+    skipped = can_skip_by_stats(desc, meta, op_type, params, param_cnt);
+  }
+  return ret;
+}
+
+bool ObParquetTableRowIterator::can_skip_by_stats(const ObParquetColumnDesc &desc,
+                                                  const ObParquetChunkMeta &meta,
+                                                  const int64_t op_type,
+                                                  const ObDatum *params,
+                                                  const int64_t param_cnt)
+{
+  bool skipped = false;
+  const bool is_int = desc.is_signed_integer();
+  const bool is_float = ObParquetColumnDesc::DOUBLE == desc.physical_type_
+                        || ObParquetColumnDesc::FLOAT == desc.physical_type_;
+  const int64_t width = (ObParquetColumnDesc::INT32 == desc.physical_type_
+                         || ObParquetColumnDesc::FLOAT == desc.physical_type_) ? 4 : 8;
+  if (WHITE_OP_NU == op_type) {
+    skipped = (0 == meta.null_count_);
+  } else if (WHITE_OP_NN == op_type) {
+    skipped = (meta.null_count_ >= 0 && meta.null_count_ == meta.num_values_);
+  } else if (!meta.has_stats_ || (!is_int && !is_float) || OB_ISNULL(params)) {
+  } else if (WHITE_OP_EQ != op_type && WHITE_OP_LT != op_type && WHITE_OP_LE != op_type
+             && WHITE_OP_GT != op_type && WHITE_OP_GE != op_type && WHITE_OP_BT != op_type) {
+  } else if (meta.min_.length() != width || meta.max_.length() != width
+             || param_cnt != (WHITE_OP_BT == op_type ? 2 : 1)) {
+  } else if (is_int) {
+    const int64_t min = 4 == width ? read_le<int32_t>(meta.min_.ptr()) : read_le<int64_t>(meta.min_.ptr());
+    const int64_t max = 4 == width ? read_le<int32_t>(meta.max_.ptr()) : read_le<int64_t>(meta.max_.ptr());
+    const int64_t p = params[0].get_int();
+    switch (op_type) {
+      case WHITE_OP_EQ: skipped = p < min || p > max; break;
+      case WHITE_OP_LT: skipped = min >= p; break;
+      case WHITE_OP_LE: skipped = min > p; break;
+      case WHITE_OP_GT: skipped = max <= p; break;
+      case WHITE_OP_GE: skipped = max < p; break;
+      case WHITE_OP_BT: skipped = p > max || params[1].get_int() < min; break;
+      default: break;
+    }
+  } else {
+    const double min = 4 == width ? read_le<float>(meta.min_.ptr()) : read_le<double>(meta.min_.ptr());
+    const double max = 4 == width ? read_le<float>(meta.max_.ptr()) : read_le<double>(meta.max_.ptr());
+    const double p = params[0].get_double();
+    if (std::isnan(min) || std::isnan(max)) {
+    } else {
+      switch (op_type) {
+        case WHITE_OP_EQ: skipped = p < min || p > max; break;
+        case WHITE_OP_LT: skipped = min >= p; break;
+        case WHITE_OP_LE: skipped = min > p; break;
+        case WHITE_OP_GT: skipped = max <= p; break;
+        case WHITE_OP_GE: skipped = max < p; break;
+        case WHITE_OP_BT: skipped = p > max || params[1].get_double() < min; break;
+        default: break;
+      }
+    }
+  }
+  return skipped;
+}
+
+int ObParquetTableRowIterator::check_row_group_skipped(const int64_t rg_idx, bool &skipped)
+{
+  int ret = OB_SUCCESS;
+  skipped = false;
+  for (int64_t i = 0; OB_SUCC(ret) && !skipped && i < prune_filters_.count(); ++i) {
+    const PruneFilter &prune = prune_filters_.at(i);
+    const ObParquetChunkMeta &meta =
+        chunk_metas_.at(rg_idx * column_readers_.count() + prune.column_idx_);
+    if (OB_FAIL(check_filter_by_stats(prune, meta, skipped))) {
+      LOG_WARN("failed to check filter by statistics", K(ret), K(prune));
+    }
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::open_next_row_group()
+{
+  int ret = OB_SUCCESS;
+  bool opened = false;
+  while (OB_SUCC(ret) && !opened) {
+    bool skipped = false;
+    if (++cur_rg_idx_ >= row_groups_.count() || row_count_limit_ <= 0) {
+      ret = OB_ITER_END;
+    } else if (skip_rows_ >= row_groups_.at(cur_rg_idx_).num_rows_) {
+      skip_rows_ -= row_groups_.at(cur_rg_idx_).num_rows_;
+    } else if (OB_FAIL(check_row_group_skipped(cur_rg_idx_, skipped))) {
+    } else if (skipped) {
+      const RowGroupMeta &rg = row_groups_.at(cur_rg_idx_);
+      row_count_limit_ -= MIN(rg.num_rows_ - skip_rows_, row_count_limit_);
+      skip_rows_ = 0;
+      LOG_DEBUG("skip parquet row group by statistics", K(url_), K(cur_rg_idx_), K(rg));
+    } else {
+      const RowGroupMeta &rg = row_groups_.at(cur_rg_idx_);
+      rg_allocator_.reuse();
+      for (int64_t i = 0; OB_SUCC(ret) && i < column_readers_.count(); ++i) {
+        const ObParquetChunkMeta &meta = chunk_metas_.at(cur_rg_idx_ * column_readers_.count() + i);
+        char *buf = nullptr;
+        if (meta.size_ > 0 && OB_ISNULL(buf = static_cast<char *>(rg_allocator_.alloc(meta.size_)))) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          LOG_WARN("failed to alloc column chunk", K(ret), K(meta));
+        } else if (meta.size_ > 0 && OB_FAIL(read_fully(buf, meta.size_, meta.offset_))) {
+          LOG_WARN("failed to read column chunk", K(ret), K(meta));
+        } else if (OB_FAIL(column_readers_.at(i)->open_chunk(meta, buf, rg_allocator_))) {
+          LOG_WARN("failed to open column chunk", K(ret), K(meta));
+        } else if (skip_rows_ > 0 && OB_FAIL(column_readers_.at(i)->skip(skip_rows_))) {
+          LOG_WARN("failed to skip rows", K(ret), K(skip_rows_));
+        }
+      }
+      if (OB_SUCC(ret)) {
+        rg_rows_left_ = rg.num_rows_ - skip_rows_;
+        cur_row_number_ = rg.first_row_ + skip_rows_;
+        skip_rows_ = 0;
+        opened = true;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::fill_rows(ObDatum **file_datums, const int64_t capacity, int64_t &count)
+{
+  int ret = OB_SUCCESS;
+  count = 0;
+  while (OB_SUCC(ret) && 0 == count) {
+    if (!file_opened_) {
+      if (OB_FAIL(open_next_file())) {
+        //do not print log
+      }
+    } else if (0 == rg_rows_left_ || row_count_limit_ <= 0) {
+      if (OB_FAIL(open_next_row_group())) {
+        if (OB_ITER_END == ret) {
+          ret = OB_SUCCESS;
+          file_opened_ = false;
+        } else {
+          LOG_WARN("failed to open next row group", K(ret));
+        }
+      }
+    } else {
+      const int64_t n = MIN(MIN(capacity, rg_rows_left_), row_count_limit_);
+      for (int64_t i = 0; OB_SUCC(ret) && i < column_readers_.count(); ++i) {
+        if (OB_FAIL(column_readers_.at(i)->read(file_datums[i], n, batch_allocator_))) {
+          LOG_WARN("failed to read column", K(ret), K(i), K(url_));
+        }
+      }
+      if (OB_SUCC(ret)) {
+        count = n;
+        rg_rows_left_ -= n;
+        row_count_limit_ -= n;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::fill_hidden_columns(const int64_t count, const bool is_batch)
+{
+  int ret = OB_SUCCESS;
+  ObEvalCtx &eval_ctx = scan_param_->op_->get_eval_ctx();
+  if (OB_NOT_NULL(file_id_expr_)) {
+    ObDatum *datums = is_batch ? file_id_expr_->locate_batch_datums(eval_ctx)
+                               : &file_id_expr_->locate_datum_for_write(eval_ctx);
+    for (int64_t i = 0; i < count; i++) {
+      datums[i].set_int(cur_file_id_);
+    }
+    file_id_expr_->set_evaluated_flag(eval_ctx);
+  }
+  if (OB_NOT_NULL(line_number_expr_)) {
+    ObDatum *datums = is_batch ? line_number_expr_->locate_batch_datums(eval_ctx)
+                               : &line_number_expr_->locate_datum_for_write(eval_ctx);
+    for (int64_t i = 0; i < count; i++) {
+      datums[i].set_int(cur_row_number_ + i);
+    }
+    line_number_expr_->set_evaluated_flag(eval_ctx);
+  }
+  cur_row_number_ += count;
+  return ret;
+}
+
+int ObParquetTableRowIterator::calc_column_convert(const int64_t count, const bool is_batch)
+{
+  int ret = OB_SUCCESS;
+  ObEvalCtx &eval_ctx = scan_param_->op_->get_eval_ctx();
+  const ExprFixedArray &file_column_exprs = *(scan_param_->ext_file_column_exprs_);
+  for (int i = 0; OB_SUCC(ret) && i < file_column_exprs.count(); i++) {
+    file_column_exprs.at(i)->set_evaluated_flag(eval_ctx);
+  }
+  for (int i = 0; OB_SUCC(ret) && i < column_exprs_.count(); i++) {
+    ObExpr *column_expr = column_exprs_.at(i);
+    ObExpr *column_convert_expr = scan_param_->ext_column_convert_exprs_->at(i);
+    if (is_batch) {
+      OZ (column_convert_expr->eval_batch(eval_ctx, *bit_vector_cache_, count));
+      if (OB_SUCC(ret)) {
+        MEMCPY(column_expr->locate_batch_datums(eval_ctx),
+               column_convert_expr->locate_batch_datums(eval_ctx), sizeof(ObDatum) * count);
+        column_expr->set_evaluated_flag(eval_ctx);
+      }
+    } else {
+      ObDatum *convert_datum = NULL;
+      OZ (column_convert_expr->eval(eval_ctx, convert_datum));
+      if (OB_SUCC(ret)) {
+        column_expr->locate_datum_for_write(eval_ctx) = *convert_datum;
+        column_expr->set_evaluated_flag(eval_ctx);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::get_next_row()
+{
+  int ret = OB_SUCCESS;
+  const ExprFixedArray &file_column_exprs = *(scan_param_->ext_file_column_exprs_);
+  ObEvalCtx &eval_ctx = scan_param_->op_->get_eval_ctx();
+  ObSEArray<ObDatum *, 16> file_datums;
+  int64_t count = 0;
+  batch_allocator_.reuse();
+  for (int64_t i = 0; OB_SUCC(ret) && i < file_column_exprs.count(); ++i) {
+    OZ (file_datums.push_back(&file_column_exprs.at(i)->locate_datum_for_write(eval_ctx)));
+  }
+  OZ (fill_rows(file_datums.get_data(), 1, count));
+  OZ (fill_hidden_columns(count, false));
+  OZ (calc_column_convert(count, false));
+  return ret;
+}
+
+int ObParquetTableRowIterator::get_next_rows(int64_t &count, int64_t capacity)
+{
+  int ret = OB_SUCCESS;
+  const ExprFixedArray &file_column_exprs = *(scan_param_->ext_file_column_exprs_);
+  ObEvalCtx &eval_ctx = scan_param_->op_->get_eval_ctx();
+  ObSEArray<ObDatum *, 16> file_datums;
+  int64_t returned_row_cnt = 0;
+  batch_allocator_.reuse();
+
+  if (OB_ISNULL(bit_vector_cache_)) {
+    void *mem = nullptr;
+    if (OB_ISNULL(mem = allocator_.alloc(ObBitVector::memory_size(eval_ctx.max_batch_size_)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc memory for skip", K(ret), K(eval_ctx.max_batch_size_));
+    } else {
+      bit_vector_cache_ = to_bit_vector(mem);
+      bit_vector_cache_->reset(eval_ctx.max_batch_size_);
+    }
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < file_column_exprs.count(); ++i) {
+    OZ (file_datums.push_back(file_column_exprs.at(i)->locate_batch_datums(eval_ctx)));
+  }
+  OZ (fill_rows(file_datums.get_data(), capacity, returned_row_cnt));
+  OZ (fill_hidden_columns(returned_row_cnt, true));
+  OZ (calc_column_convert(returned_row_cnt, true));
+  if (OB_SUCC(ret)) {
+    count = returned_row_cnt;
+  }
+  return ret;
+}
+
+void ObParquetTableRowIterator::reset()
+{
+  // reset state to initial values for rescan
+  file_idx_ = 0;
+  file_opened_ = false;
+  cur_rg_idx_ = -1;
+  rg_rows_left_ = 0;
+  row_count_limit_ = 0;
+  skip_rows_ = 0;
+  cur_row_number_ = 0;
+}
+
+}
+}
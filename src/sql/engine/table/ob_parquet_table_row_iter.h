@@ -0,0 +1,309 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_PARQUET_TABLE_ROW_ITER_H_
+#define OB_PARQUET_TABLE_ROW_ITER_H_
+
+#include "sql/engine/table/ob_external_table_access_service.h"
+#include "lib/allocator/page_arena.h"
+#include "lib/compress/ob_compressor.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+class ObPushdownFilterExecutor;
+class ObWhiteFilterExecutor;
+
+// Minimal reader of thrift compact protocol, only what parquet metadata needs.
+class ObParquetThriftReader
+{
+public:
+  enum FieldType
+  {
+    T_STOP = 0,
+    T_BOOL_TRUE = 1,
+    T_BOOL_FALSE = 2,
+    T_BYTE = 3,
+    T_I16 = 4,
+    T_I32 = 5,
+    T_I64 = 6,
+    T_DOUBLE = 7,
+    T_BINARY = 8,
+    T_LIST = 9,
+    T_SET = 10,
+    T_MAP = 11,
+    T_STRUCT = 12,
+  };
+  ObParquetThriftReader(const char *buf, const int64_t len)
+    : pos_(buf), end_(buf + len), depth_(0) {}
+  // field_id is in-out, it holds id of the last field of current struct
+  int read_field_begin(int8_t &type, int16_t &field_id);
+  int read_list_begin(int8_t &elem_type, int64_t &size);
+  int read_i32(int32_t &v);
+  int read_i64(int64_t &v);
+  int read_binary(common::ObString &v);
+  int skip(const int8_t type);
+  const char *get_pos() const { return pos_; }
+private:
+  int read_byte(uint8_t &v);
+  int read_varint(uint64_t &v);
+  int skip_in_container(const int8_t type);
+private:
+  static const int64_t MAX_SKIP_DEPTH = 64;
+  const char *pos_;
+  const char *end_;
+  int64_t depth_;
+};
+
+// leaf column of parquet schema, nested column is not supported
+struct ObParquetColumnDesc
+{
+  enum PhysicalType
+  {
+    BOOLEAN = 0,
+    INT32 = 1,
+    INT64 = 2,
+    INT96 = 3,
+    FLOAT = 4,
+    DOUBLE = 5,
+    BYTE_ARRAY = 6,
+    FIXED_LEN_BYTE_ARRAY = 7,
+  };
+  enum ConvertedType
+  {
+    NONE = -1,
+    UTF8 = 0,
+    DECIMAL = 5,
+    DATE = 6,
+    TIMESTAMP_MILLIS = 9,
+    TIMESTAMP_MICROS = 10,
+    UINT_8 = 11,
+    UINT_16 = 12,
+    UINT_32 = 13,
+    UINT_64 = 14,
+    INT_8 = 15,
+    INT_16 = 16,
+    INT_32 = 17,
+    INT_64 = 18,
+  };
+  ObParquetColumnDesc()
+    : physical_type_(-1), type_length_(0), converted_type_(NONE), scale_(0),
+      max_def_level_(0), max_rep_level_(0) {}
+  bool is_signed_integer() const
+  {
+    return (INT32 == physical_type_ || INT64 == physical_type_)
+           && (NONE == converted_type_ || (converted_type_ >= INT_8 && converted_type_ <= INT_64));
+  }
+  TO_STRING_KV(K_(physical_type), K_(type_length), K_(converted_type), K_(scale),
+               K_(max_def_level), K_(max_rep_level));
+  int32_t physical_type_;
+  int32_t type_length_;
+  int32_t converted_type_;
+  int32_t scale_;
+  int16_t max_def_level_;
+  int16_t max_rep_level_;
+};
+
+struct ObParquetChunkMeta
+{
+  ObParquetChunkMeta()
+    : codec_(0), num_values_(0), offset_(0), size_(0), has_stats_(false), null_count_(-1) {}
+  TO_STRING_KV(K_(codec), K_(num_values), K_(offset), K_(size), K_(has_stats), K_(null_count));
+  int32_t codec_;
+  int64_t num_values_;
+  int64_t offset_;
+  int64_t size_;
+  bool has_stats_;
+  common::ObString min_;
+  common::ObString max_;
+  int64_t null_count_;
+};
+
+// RLE / bit-packing hybrid encoding, used by levels and dictionary indexes
+class ObParquetRleDecoder
+{
+public:
+  ObParquetRleDecoder() { reset(); }
+  void reset();
+  int init(const char *buf, const int64_t len, const int32_t bit_width);
+  int get_next(uint32_t &v);
+private:
+  int next_run();
+private:
+  const char *pos_;
+  const char *end_;
+  int32_t bit_width_;
+  int64_t rle_left_;
+  uint32_t rle_value_;
+  const char *bp_ptr_;
+  int64_t bp_left_;
+  int64_t bp_bit_pos_;
+};
+
+// Reads one column chunk of current row group, pages are decoded lazily and
+// values are rendered to strings for file column exprs.
+class ObParquetColumnReader
+{
+public:
+  ObParquetColumnReader(common::ObIAllocator &allocator)
+    : allocator_(allocator), desc_(), chunk_buf_(nullptr), chunk_pos_(nullptr), chunk_end_(nullptr),
+      page_buf_(nullptr), page_buf_len_(0), page_values_left_(0), page_encoding_(0),
+      values_pos_(nullptr), values_end_(nullptr), bool_bit_pos_(0),
+      dict_(nullptr), dict_cnt_(0), rg_alloc_(nullptr) {}
+  ~ObParquetColumnReader() { destroy(); }
+  void destroy();
+  void set_desc(const ObParquetColumnDesc &desc) { desc_ = desc; }
+  const ObParquetColumnDesc &get_desc() const { return desc_; }
+  // chunk memory is owned by row group arena of iterator
+  int open_chunk(const ObParquetChunkMeta &meta, const char *chunk_buf, common::ObIAllocator &rg_alloc);
+  int read(common::ObDatum *datums, const int64_t count, common::ObIAllocator &batch_alloc);
+  int skip(const int64_t count);
+  TO_STRING_KV(K_(desc), K_(meta), K_(page_values_left), K_(page_encoding), K_(dict_cnt));
+private:
+  int next_page();
+  int prepare_page_buf(const int64_t len);
+  int decompress(const char *src, const int64_t src_len, char *dst, const int64_t dst_len);
+  int read_page_header(int32_t &page_type, int32_t &compressed_size, int32_t &uncompressed_size,
+                       int32_t &num_values, int32_t &encoding, int32_t &def_levels_len,
+                       int32_t &rep_levels_len, bool &is_compressed);
+  int decode_dictionary(const char *buf, const int64_t len, const int32_t num_values,
+                        common::ObIAllocator &rg_alloc);
+  int next_raw_value(common::ObString &raw);
+  int next_plain_value(const char *&pos, const char *end, common::ObString &raw);
+  int render(const common::ObString &raw, common::ObIAllocator &batch_alloc, common::ObDatum &datum);
+  int get_value_width(int64_t &width) const;
+private:
+  common::ObIAllocator &allocator_;
+  ObParquetColumnDesc desc_;
+  ObParquetChunkMeta meta_;
+  const char *chunk_buf_;
+  const char *chunk_pos_;
+  const char *chunk_end_;
+  // buffer of current data page after decompress, reused between pages
+  char *page_buf_;
+  int64_t page_buf_len_;
+  int64_t page_values_left_;
+  int32_t page_encoding_;
+  ObParquetRleDecoder def_decoder_;
+  ObParquetRleDecoder index_decoder_;
+  const char *values_pos_;
+  const char *values_end_;
+  int64_t bool_bit_pos_;
+  common::ObString *dict_;
+  int64_t dict_cnt_;
+  common::ObIAllocator *rg_alloc_;
+};
+
+class ObParquetTableRowIterator : public ObExternalTableRowIterator {
+public:
+  static const int64_t FOOTER_SIZE = 8;
+  static const int64_t MAX_FOOTER_LEN = 64L << 20; // 64M
+public:
+  ObParquetTableRowIterator()
+    : bit_vector_cache_(nullptr), line_number_expr_(nullptr), file_id_expr_(nullptr),
+      file_idx_(0), cur_file_id_(0), file_size_(0), cur_row_number_(0), row_count_limit_(0), skip_rows_(0),
+      cur_rg_idx_(-1), rg_rows_left_(0), file_opened_(false) {}
+  virtual ~ObParquetTableRowIterator();
+  int init(const storage::ObTableScanParam *scan_param) override;
+  int get_next_row() override;
+  int get_next_rows(int64_t &count, int64_t capacity) override;
+
+  virtual int get_next_row(ObNewRow *&row) override {
+    UNUSED(row);
+    return common::OB_ERR_UNEXPECTED;
+  }
+
+  virtual void reset() override;
+
+private:
+  struct RowGroupMeta
+  {
+    RowGroupMeta() : num_rows_(0), first_row_(0) {}
+    TO_STRING_KV(K_(num_rows), K_(first_row));
+    int64_t num_rows_;
+    // row number of first row in file, start from 1 like line number of csv
+    int64_t first_row_;
+  };
+  // pushed down white filter which can be checked by min/max of row group
+  struct PruneFilter
+  {
+    PruneFilter() : filter_(nullptr), column_idx_(-1) {}
+    TO_STRING_KV(KP_(filter), K_(column_idx));
+    ObWhiteFilterExecutor *filter_;
+    // index of column_readers_
+    int64_t column_idx_;
+  };
+  int init_exprs(const storage::ObTableScanParam *scan_param);
+  int init_prune_filters();
+  int add_prune_filter(ObPushdownFilterExecutor *filter);
+  int open_next_file();
+  int read_file_meta();
+  int parse_file_meta(const char *buf, const int64_t len);
+  int parse_schema_element(ObParquetThriftReader &reader, ObParquetColumnDesc &desc,
+                           int32_t &repetition_type, int32_t &num_children);
+  int parse_row_group(ObParquetThriftReader &reader, RowGroupMeta &rg, const int64_t rg_idx);
+  int parse_column_chunk(ObParquetThriftReader &reader, ObParquetChunkMeta &meta);
+  int parse_column_meta(ObParquetThriftReader &reader, ObParquetChunkMeta &meta);
+  int parse_statistics(ObParquetThriftReader &reader, ObParquetChunkMeta &meta);
+  int open_next_row_group();
+  int check_row_group_skipped(const int64_t rg_idx, bool &skipped);
+  int check_filter_by_stats(const PruneFilter &prune, const ObParquetChunkMeta &meta,
+                            bool &skipped);
+  // whether no row of the chunk can satisfy the compare of %op_type against %params, which
+  // hold int for integer columns and double for floating point columns
+  static bool can_skip_by_stats(const ObParquetColumnDesc &desc, const ObParquetChunkMeta &meta,
+                                const int64_t op_type, const ObDatum *params,
+                                const int64_t param_cnt);
+  int read_fully(char *buf, const int64_t len, const int64_t offset);
+  int fill_rows(ObDatum **file_datums, const int64_t capacity, int64_t &count);
+  int fill_hidden_columns(const int64_t count, const bool is_batch);
+  int calc_column_convert(const int64_t count, const bool is_batch);
+private:
+  ObBitVector *bit_vector_cache_;
+  common::ObMalloc allocator_;
+  // memory of footer and schema, reset when switch file
+  common::ObArenaAllocator file_allocator_;
+  // memory of column chunks and dictionaries, reset when switch row group
+  common::ObArenaAllocator rg_allocator_;
+  // memory of rendered values, reset for every batch
+  common::ObArenaAllocator batch_allocator_;
+  ObExternalDataAccessDriver data_access_driver_;
+  ObSqlString url_;
+  ObSEArray<ObExpr*, 16> column_exprs_;
+  ObExpr *line_number_expr_;
+  ObExpr *file_id_expr_;
+  // parquet leaf column index of every file column expr
+  ObSEArray<int64_t, 16> file_col_leaf_idxs_;
+  ObSEArray<ObParquetColumnReader*, 16> column_readers_;
+  ObSEArray<PruneFilter, 4> prune_filters_;
+  // schema of all leaf columns in current file
+  ObSEArray<ObParquetColumnDesc, 16> leaf_descs_;
+  ObSEArray<RowGroupMeta, 16> row_groups_;
+  // chunk meta of projected columns, row_groups_.count() * column_readers_.count()
+  ObSEArray<ObParquetChunkMeta, 16> chunk_metas_;
+  int64_t file_idx_;
+  common::ObString cur_file_name_;
+  int64_t cur_file_id_;
+  int64_t file_size_;
+  int64_t cur_row_number_;
+  int64_t row_count_limit_;
+  int64_t skip_rows_;
+  int64_t cur_rg_idx_;
+  int64_t rg_rows_left_;
+  bool file_opened_;
+};
+
+}
+}
+
+#endif // OB_PARQUET_TABLE_ROW_ITER_H_
@@ -452,12 +452,30 @@ int ObWindowFunctionOp::get_param_int_value(ObExpr &expr,
 {
   int ret = OB_SUCCESS;
   ObDatum *result = NULL;
-  bool is_valid_param = true;
   is_null = false;
   value = 0;
   if (OB_FAIL(expr.eval(eval_ctx, result))) {
     LOG_WARN("eval failed", K(ret));
-  } else if (result->is_null()) {
+  } else if (OB_FAIL(get_param_int_value(expr, *result, is_null, value, need_number,
+                                         need_check_valid))) {
+    LOG_WARN("get param int value failed", K(ret));
+  }
+  return ret;
+}
+
+int ObWindowFunctionOp::get_param_int_value(const ObExpr &expr,
+                                            const ObDatum &datum,
+                                            bool &is_null,
+                                            int64_t &value,
+                                            const bool need_number/* = false*/,
+                                            const bool need_check_valid/* = false*/)
+{
+  int ret = OB_SUCCESS;
+  const ObDatum *result = &datum;
+  bool is_valid_param = true;
+  is_null = false;
+  value = 0;
+  if (result->is_null()) {
     is_null = true;
     is_valid_param = !need_check_valid;
   } else if (need_number || expr.obj_meta_.is_number()) {
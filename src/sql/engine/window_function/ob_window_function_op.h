@@ -768,6 +768,11 @@ public:
                       const ObDatum &rank,
                       const int64_t val);
 
+  // convert the evaluated %datum of a frame bound or bucket param %expr to int64
+  static int get_param_int_value(const ObExpr &expr, const ObDatum &datum, bool &is_null,
+                                 int64_t &value, const bool need_number_type = false,
+                                 const bool need_check_valid = false);
+
 protected:
   int init();
 
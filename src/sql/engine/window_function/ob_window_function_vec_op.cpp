@@ -0,0 +1,985 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/window_function/ob_window_function_vec_op.h"
+#include "sql/engine/ob_exec_context.h"
+#include "sql/engine/expr/ob_expr_util.h"
+#include "sql/engine/aggregate/ob_aggregate_processor.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace common::number;
+namespace sql
+{
+
+OB_SERIALIZE_MEMBER((ObWindowFunctionVecSpec, ObWindowFunctionSpec));
+
+void ObWindowFunctionVecOp::FrameAggr::reuse()
+{
+  cnt_ = 0;
+  dbl_sum_.ptr_ = dbl_buf_;
+  dbl_sum_.set_null();
+  nmb_sum_.set_zero();
+  nmb_idx_ = 0;
+  queue_.reuse();
+  queue_head_ = 0;
+}
+
+ObWindowFunctionVecOp::ObWindowFunctionVecOp(
+    ObExecContext &exec_ctx, const ObOpSpec &spec, ObOpInput *input)
+  : ObOperator(exec_ctx, spec, input),
+    res_alloc_(ObModIds::OB_SQL_WINDOW_FUNC),
+    cur_store_(0),
+    rows_(),
+    batch_rows_(NULL),
+    wf_ctxs_(NULL),
+    wf_cnt_(0),
+    frame_aggr_(),
+    last_part_start_(0),
+    computed_cnt_(0),
+    output_idx_(0),
+    child_iter_end_(false),
+    boundaries_(),
+    part_starts_(),
+    peer_starts_(),
+    peer_ends_()
+{
+}
+
+bool ObWindowFunctionVecOp::all_supported_window_functions(
+    const ObIArray<ObWinFunRawExpr *> &wf_exprs)
+{
+  bool supported = true;
+  for (int64_t i = 0; supported && i < wf_exprs.count(); i++) {
+    const ObWinFunRawExpr *wf_expr = wf_exprs.at(i);
+    if (OB_ISNULL(wf_expr)) {
+      supported = false;
+    } else {
+      const bool is_rows = WINDOW_ROWS == wf_expr->get_window_type();
+      // frame bound must be UNBOUNDED, CURRENT ROW or literal offset of ROWS frame,
+      // which makes the frame head and tail non-decreasing within partition.
+      const Bound *bounds[2] = { &wf_expr->upper_, &wf_expr->lower_ };
+      switch (wf_expr->get_func_type()) {
+        case T_WIN_FUN_ROW_NUMBER:
+        case T_WIN_FUN_RANK:
+        case T_WIN_FUN_DENSE_RANK:
+        case T_WIN_FUN_PERCENT_RANK:
+        case T_WIN_FUN_CUME_DIST: {
+          break;
+        }
+        case T_FUN_COUNT:
+        case T_FUN_SUM:
+        case T_FUN_MIN:
+        case T_FUN_MAX: {
+          const ObAggFunRawExpr *agg_expr = wf_expr->get_agg_expr();
+          for (int64_t j = 0; supported && j < 2; j++) {
+            supported = BOUND_UNBOUNDED == bounds[j]->type_
+                        || BOUND_CURRENT_ROW == bounds[j]->type_
+                        || (BOUND_INTERVAL == bounds[j]->type_ && is_rows
+                            && bounds[j]->is_nmb_literal_ && NULL != bounds[j]->interval_expr_
+                            && NULL == bounds[j]->date_unit_expr_);
+          }
+          if (!supported) {
+          } else if (NULL == agg_expr || agg_expr->is_param_distinct()
+                     || agg_expr->get_real_param_count() > 1) {
+            supported = false;
+          } else if (T_FUN_COUNT == wf_expr->get_func_type()) {
+            // count(*) or count(expr)
+          } else if (1 != agg_expr->get_real_param_count()
+                     || OB_ISNULL(agg_expr->get_real_param_exprs().at(0))) {
+            supported = false;
+          } else {
+            const ObExprResType &param_type =
+                agg_expr->get_real_param_exprs().at(0)->get_result_type();
+            const ObExprResType &res_type = agg_expr->get_result_type();
+            const ObObjTypeClass param_tc = param_type.get_type_class();
+            if (T_FUN_SUM == wf_expr->get_func_type()) {
+              // double sum is not invertible, only cumulative frames are supported
+              supported = (ObNumberTC == res_type.get_type_class()
+                           && (ObIntTC == param_tc || ObUIntTC == param_tc
+                               || ObNumberTC == param_tc))
+                          || (ObDoubleType == res_type.get_type()
+                              && ObDoubleType == param_type.get_type()
+                              && BOUND_UNBOUNDED == wf_expr->upper_.type_
+                              && wf_expr->upper_.is_preceding_);
+            } else {
+              supported = param_type.get_type() == res_type.get_type()
+                          && param_type.get_collation_type() == res_type.get_collation_type();
+            }
+          }
+          break;
+        }
+        default: {
+          supported = false;
+          break;
+        }
+      }
+    }
+  }
+  return supported;
+}
+
+int ObWindowFunctionVecOp::inner_open()
+{
+  int ret = OB_SUCCESS;
+  const uint64_t tenant_id = ctx_.get_my_session()->get_effective_tenant_id();
+  if (OB_FAIL(ObOperator::inner_open())) {
+    LOG_WARN("operator open failed", K(ret));
+  } else if (OB_ISNULL(child_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("child is null", K(ret));
+  } else if (OB_ISNULL(batch_rows_ = static_cast<ObCompactRow **>(ctx_.get_allocator().alloc(
+      sizeof(ObCompactRow *) * MY_SPEC.max_batch_size_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(MY_SPEC.max_batch_size_));
+  } else if (FALSE_IT(res_alloc_.set_tenant_id(tenant_id))) {
+  } else if (OB_FAIL(init_wf_ctxs())) {
+    LOG_WARN("init window function context failed", K(ret));
+  } else if (OB_FAIL(init_store(stores_[0]))) {
+    LOG_WARN("init row store failed", K(ret));
+  } else if (OB_FAIL(init_store(stores_[1]))) {
+    LOG_WARN("init row store failed", K(ret));
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::inner_rescan()
+{
+  int ret = OB_SUCCESS;
+  reset();
+  if (OB_FAIL(ObOperator::inner_rescan())) {
+    LOG_WARN("operator rescan failed", K(ret));
+  } else if (OB_FAIL(init_store(stores_[0]))) {
+    LOG_WARN("init row store failed", K(ret));
+  } else if (OB_FAIL(init_store(stores_[1]))) {
+    LOG_WARN("init row store failed", K(ret));
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::inner_close()
+{
+  reset();
+  return ObOperator::inner_close();
+}
+
+void ObWindowFunctionVecOp::destroy()
+{
+  reset();
+  if (NULL != wf_ctxs_) {
+    for (int64_t i = 0; i < wf_cnt_; i++) {
+      wf_ctxs_[i].~WinFuncCtx();
+    }
+    wf_ctxs_ = NULL;
+    wf_cnt_ = 0;
+  }
+  rows_.destroy();
+  boundaries_.destroy();
+  part_starts_.destroy();
+  peer_starts_.destroy();
+  peer_ends_.destroy();
+  frame_aggr_.queue_.destroy();
+  res_alloc_.reset();
+  ObOperator::destroy();
+}
+
+void ObWindowFunctionVecOp::reset()
+{
+  stores_[0].reset();
+  stores_[1].reset();
+  cur_store_ = 0;
+  rows_.reuse();
+  for (int64_t i = 0; NULL != wf_ctxs_ && i < wf_cnt_; i++) {
+    wf_ctxs_[i].res_.reuse();
+    wf_ctxs_[i].bound_evaluated_ = false;
+  }
+  frame_aggr_.reuse();
+  res_alloc_.reset_remain_one_page();
+  last_part_start_ = 0;
+  computed_cnt_ = 0;
+  output_idx_ = 0;
+  child_iter_end_ = false;
+}
+
+int ObWindowFunctionVecOp::inner_get_next_row()
+{
+  int ret = OB_ERR_UNEXPECTED;
+  LOG_WARN("vectorized window function should not call get_next_row", K(ret));
+  return ret;
+}
+
+int ObWindowFunctionVecOp::init_wf_ctxs()
+{
+  int ret = OB_SUCCESS;
+  const int64_t wf_cnt = MY_SPEC.wf_infos_.count();
+  void *buf = NULL;
+  if (wf_cnt <= 0) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("no window function", K(ret));
+  } else if (OB_ISNULL(buf = ctx_.get_allocator().alloc(sizeof(WinFuncCtx) * wf_cnt))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(wf_cnt));
+  } else {
+    wf_ctxs_ = static_cast<WinFuncCtx *>(buf);
+    for (int64_t i = 0; i < wf_cnt; i++) {
+      new (&wf_ctxs_[i]) WinFuncCtx();
+    }
+    wf_cnt_ = wf_cnt;
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < wf_cnt_; i++) {
+    WinFuncCtx &wf_ctx = wf_ctxs_[i];
+    const WinFuncInfo &info = MY_SPEC.wf_infos_.at(i);
+    int64_t idx = OB_INVALID_INDEX;
+    wf_ctx.info_ = &info;
+    for (int64_t j = 0; OB_SUCC(ret) && j < info.partition_exprs_.count(); j++) {
+      if (!has_exist_in_array(MY_SPEC.all_expr_, info.partition_exprs_.at(j), &idx)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("partition expr not in all expr", K(ret), K(j), K(info));
+      } else if (OB_FAIL(wf_ctx.part_cols_.push_back(idx))) {
+        LOG_WARN("push back failed", K(ret));
+      }
+    }
+    if (OB_SUCC(ret) && 1 == info.aggr_info_.param_exprs_.count()) {
+      if (!has_exist_in_array(MY_SPEC.all_expr_, info.aggr_info_.param_exprs_.at(0), &idx)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("aggregate param expr not in all expr", K(ret), K(info));
+      } else {
+        wf_ctx.param_col_ = idx;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::init_store(ObTempRowStore &store)
+{
+  int ret = OB_SUCCESS;
+  const uint64_t tenant_id = ctx_.get_my_session()->get_effective_tenant_id();
+  ObMemAttr mem_attr(tenant_id, ObModIds::OB_SQL_WINDOW_ROW_STORE, ObCtxIds::WORK_AREA);
+  if (OB_FAIL(store.init(MY_SPEC.all_expr_, MY_SPEC.max_batch_size_, mem_attr,
+                         0 /* mem_limit */, false /* enable_dump */, 0 /* row_extra_size */))) {
+    LOG_WARN("init row store failed", K(ret));
+  } else if (OB_FAIL(store.init_batch_ctx())) {
+    LOG_WARN("init batch ctx failed", K(ret));
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  if (output_idx_ >= computed_cnt_ && computed_cnt_ > 0 && OB_FAIL(shrink_rows())) {
+    LOG_WARN("shrink rows failed", K(ret));
+  }
+  while (OB_SUCC(ret) && output_idx_ >= computed_cnt_ && !child_iter_end_) {
+    if (OB_FAIL(fetch_child_rows())) {
+      LOG_WARN("fetch child rows failed", K(ret));
+    } else if (child_iter_end_) {
+      if (OB_FAIL(compute(rows_.count()))) {
+        LOG_WARN("compute window function failed", K(ret));
+      }
+    } else if (last_part_start_ > computed_cnt_) {
+      if (OB_FAIL(compute(last_part_start_))) {
+        LOG_WARN("compute window function failed", K(ret));
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (output_idx_ < computed_cnt_) {
+    clear_evaluated_flag();
+    if (OB_FAIL(output_rows(max_row_cnt))) {
+      LOG_WARN("output rows failed", K(ret));
+    }
+  } else {
+    brs_.size_ = 0;
+    brs_.end_ = true;
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::fetch_child_rows()
+{
+  int ret = OB_SUCCESS;
+  const ObBatchRows *child_brs = NULL;
+  int64_t stored_cnt = 0;
+  const int64_t start = rows_.count();
+  const WinFuncCtx &last_wf = wf_ctxs_[wf_cnt_ - 1];
+  clear_evaluated_flag();
+  if (OB_FAIL(THIS_WORKER.check_status())) {
+    LOG_WARN("check physical plan status failed", K(ret));
+  } else if (OB_FAIL(child_->get_next_batch(MY_SPEC.max_batch_size_, child_brs))) {
+    LOG_WARN("get next batch failed", K(ret));
+  } else if (OB_FAIL(stores_[cur_store_].add_batch(MY_SPEC.all_expr_, eval_ctx_, *child_brs,
+                                                   stored_cnt, batch_rows_))) {
+    LOG_WARN("add batch failed", K(ret));
+  } else {
+    child_iter_end_ = child_brs->end_;
+    for (int64_t i = 0; OB_SUCC(ret) && i < stored_cnt; i++) {
+      if (OB_FAIL(rows_.push_back(batch_rows_[i]))) {
+        LOG_WARN("push back failed", K(ret));
+      }
+    }
+    // Rows before the last partition start can be calculated. The partition by exprs of the
+    // last window function are subsets of the others, which is guaranteed by code generator.
+    bool same = true;
+    for (int64_t i = rows_.count() - 1;
+         OB_SUCC(ret) && same && !last_wf.part_cols_.empty() && i > 0 && i >= start; i--) {
+      if (OB_FAIL(is_same_part(last_wf.part_cols_, *last_wf.info_, i - 1, i, same))) {
+        LOG_WARN("compare partition failed", K(ret));
+      } else if (!same) {
+        last_part_start_ = i;
+      }
+    }
+  }
+  return ret;
+}
+
+// release calculated rows (all outputted) and move rows of pending partition to the other store
+int ObWindowFunctionVecOp::shrink_rows()
+{
+  int ret = OB_SUCCESS;
+  ObTempRowStore &src = stores_[cur_store_];
+  ObTempRowStore &dst = stores_[1 - cur_store_];
+  const int64_t pending_cnt = rows_.count() - computed_cnt_;
+  for (int64_t i = 0; OB_SUCC(ret) && i < pending_cnt; i++) {
+    ObCompactRow *row = NULL;
+    if (OB_FAIL(dst.add_row(rows_.at(computed_cnt_ + i), row))) {
+      LOG_WARN("add row failed", K(ret));
+    } else {
+      rows_.at(i) = row;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    while (rows_.count() > pending_cnt) {
+      rows_.pop_back();
+    }
+    src.reset();
+    cur_store_ = 1 - cur_store_;
+    for (int64_t i = 0; i < wf_cnt_; i++) {
+      wf_ctxs_[i].res_.reuse();
+    }
+    res_alloc_.reset_remain_one_page();
+    last_part_start_ = 0;
+    computed_cnt_ = 0;
+    output_idx_ = 0;
+    if (OB_FAIL(init_store(src))) {
+      LOG_WARN("init row store failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::is_same_part(const ObIArray<int64_t> &part_cols,
+                                        const WinFuncInfo &info,
+                                        const int64_t l,
+                                        const int64_t r,
+                                        bool &same) const
+{
+  int ret = OB_SUCCESS;
+  same = true;
+  for (int64_t i = 0; OB_SUCC(ret) && same && i < part_cols.count(); i++) {
+    const ObExpr *expr = info.partition_exprs_.at(i);
+    int cmp_ret = 0;
+    if (OB_FAIL(expr->basic_funcs_->null_first_cmp_(get_datum(l, part_cols.at(i)),
+                                                    get_datum(r, part_cols.at(i)), cmp_ret))) {
+      LOG_WARN("compare failed", K(ret));
+    } else {
+      same = (0 == cmp_ret);
+    }
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::mark_boundaries(const WinFuncInfo &info,
+                                           const ObIArray<int64_t> *part_cols,
+                                           const int64_t begin,
+                                           const int64_t end)
+{
+  int ret = OB_SUCCESS;
+  const int64_t cnt = end - begin;
+  const int64_t col_cnt = NULL != part_cols ? part_cols->count() : info.sort_collations_.count();
+  boundaries_.reuse();
+  if (OB_FAIL(boundaries_.prepare_allocate(cnt))) {
+    LOG_WARN("prepare allocate failed", K(ret), K(cnt));
+  } else if (cnt > 0) {
+    MEMSET(&boundaries_.at(0), 0, cnt);
+    boundaries_.at(0) = 1;
+  }
+  // compare column by column, rows already known as boundary are skipped
+  for (int64_t col = 0; OB_SUCC(ret) && col < col_cnt; col++) {
+    const int64_t col_idx = NULL != part_cols
+                            ? part_cols->at(col) : info.sort_collations_.at(col).field_idx_;
+    for (int64_t i = begin + 1; OB_SUCC(ret) && i < end; i++) {
+      int cmp_ret = 0;
+      if (boundaries_.at(i - begin)) {
+      } else if (NULL != part_cols) {
+        ret = info.partition_exprs_.at(col)->basic_funcs_->null_first_cmp_(
+            get_datum(i - 1, col_idx), get_datum(i, col_idx), cmp_ret);
+      } else {
+        ret = info.sort_cmp_funcs_.at(col).cmp_func_(
+            get_datum(i - 1, col_idx), get_datum(i, col_idx), cmp_ret);
+      }
+      if (OB_FAIL(ret)) {
+        LOG_WARN("compare failed", K(ret), K(col_idx), K(i));
+      } else if (0 != cmp_ret) {
+        boundaries_.at(i - begin) = 1;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::calc_peer_groups(const WinFuncInfo &info,
+                                            const int64_t ps,
+                                            const int64_t pe)
+{
+  int ret = OB_SUCCESS;
+  const int64_t cnt = pe - ps;
+  peer_starts_.reuse();
+  peer_ends_.reuse();
+  if (OB_FAIL(mark_boundaries(info, NULL, ps, pe))) {
+    LOG_WARN("mark peer group boundaries failed", K(ret));
+  } else if (OB_FAIL(peer_starts_.prepare_allocate(cnt))) {
+    LOG_WARN("prepare allocate failed", K(ret), K(cnt));
+  } else if (OB_FAIL(peer_ends_.prepare_allocate(cnt))) {
+    LOG_WARN("prepare allocate failed", K(ret), K(cnt));
+  } else {
+    for (int64_t i = 0; i < cnt; i++) {
+      peer_starts_.at(i) = boundaries_.at(i) ? ps + i : peer_starts_.at(i - 1);
+    }
+    for (int64_t i = cnt - 1; i >= 0; i--) {
+      peer_ends_.at(i) = (i == cnt - 1 || boundaries_.at(i + 1)) ? ps + i + 1 : peer_ends_.at(i + 1);
+    }
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::compute(const int64_t end)
+{
+  int ret = OB_SUCCESS;
+  const int64_t begin = computed_cnt_;
+  for (int64_t i = 0; OB_SUCC(ret) && i < wf_cnt_ && end > begin; i++) {
+    WinFuncCtx &wf_ctx = wf_ctxs_[i];
+    part_starts_.reuse();
+    if (OB_FAIL(wf_ctx.res_.prepare_allocate(end))) {
+      LOG_WARN("prepare allocate failed", K(ret), K(end));
+    } else if (OB_FAIL(mark_boundaries(*wf_ctx.info_, &wf_ctx.part_cols_, begin, end))) {
+      LOG_WARN("mark partition boundaries failed", K(ret));
+    }
+    for (int64_t j = begin; OB_SUCC(ret) && j < end; j++) {
+      if (boundaries_.at(j - begin) && OB_FAIL(part_starts_.push_back(j))) {
+        LOG_WARN("push back failed", K(ret));
+      }
+    }
+    for (int64_t j = 0; OB_SUCC(ret) && j < part_starts_.count(); j++) {
+      const int64_t pe = (j + 1 < part_starts_.count()) ? part_starts_.at(j + 1) : end;
+      if (OB_FAIL(compute_partition(wf_ctx, part_starts_.at(j), pe))) {
+        LOG_WARN("compute partition failed", K(ret), K(part_starts_.at(j)), K(pe));
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    computed_cnt_ = end;
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::compute_partition(WinFuncCtx &wf_ctx,
+                                             const int64_t ps,
+                                             const int64_t pe)
+{
+  int ret = OB_SUCCESS;
+  switch (wf_ctx.info_->func_type_) {
+    case T_WIN_FUN_ROW_NUMBER:
+    case T_WIN_FUN_RANK:
+    case T_WIN_FUN_DENSE_RANK:
+    case T_WIN_FUN_PERCENT_RANK:
+    case T_WIN_FUN_CUME_DIST: {
+      ret = compute_ranking(wf_ctx, ps, pe);
+      break;
+    }
+    case T_FUN_COUNT:
+    case T_FUN_SUM:
+    case T_FUN_MIN:
+    case T_FUN_MAX: {
+      ret = compute_aggregation(wf_ctx, ps, pe);
+      break;
+    }
+    default: {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("window function not supported", K(ret), K(wf_ctx));
+      break;
+    }
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::compute_ranking(WinFuncCtx &wf_ctx,
+                                           const int64_t ps,
+                                           const int64_t pe)
+{
+  int ret = OB_SUCCESS;
+  const WinFuncInfo &info = *wf_ctx.info_;
+  const int64_t part_cnt = pe - ps;
+  if (T_WIN_FUN_ROW_NUMBER == info.func_type_) {
+    for (int64_t i = ps; OB_SUCC(ret) && i < pe; i++) {
+      ret = set_int_result(info, i - ps + 1, wf_ctx.res_.at(i));
+    }
+  } else if (OB_FAIL(calc_peer_groups(info, ps, pe))) {
+    LOG_WARN("calc peer groups failed", K(ret));
+  } else {
+    int64_t dense_rank = 0;
+    for (int64_t i = ps; OB_SUCC(ret) && i < pe; i++) {
+      const int64_t group_start = peer_starts_.at(i - ps);
+      const int64_t group_end = peer_ends_.at(i - ps);
+      ObDatum &res = wf_ctx.res_.at(i);
+      if (group_start == i) {
+        dense_rank += 1;
+      } else if (T_WIN_FUN_PERCENT_RANK != info.func_type_
+                 && T_WIN_FUN_CUME_DIST != info.func_type_) {
+        // same as the previous peer
+        res = wf_ctx.res_.at(i - 1);
+        continue;
+      }
+      switch (info.func_type_) {
+        case T_WIN_FUN_RANK: {
+          ret = set_int_result(info, group_start - ps + 1, res);
+          break;
+        }
+        case T_WIN_FUN_DENSE_RANK: {
+          ret = set_int_result(info, dense_rank, res);
+          break;
+        }
+        case T_WIN_FUN_PERCENT_RANK: {
+          ret = group_start != i ? (res = wf_ctx.res_.at(i - 1), OB_SUCCESS)
+              : set_ratio_result(info, group_start - ps, part_cnt - 1, res);
+          break;
+        }
+        case T_WIN_FUN_CUME_DIST: {
+          ret = group_start != i ? (res = wf_ctx.res_.at(i - 1), OB_SUCCESS)
+              : set_ratio_result(info, group_end - ps, part_cnt, res);
+          break;
+        }
+        default: {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("unexpected window function", K(ret), K(info.func_type_));
+          break;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::compute_aggregation(WinFuncCtx &wf_ctx,
+                                               const int64_t ps,
+                                               const int64_t pe)
+{
+  int ret = OB_SUCCESS;
+  const WinFuncInfo &info = *wf_ctx.info_;
+  const bool need_peer = WINDOW_RANGE == info.win_type_
+      && ((!info.upper_.is_unbounded_ && NULL == info.upper_.between_value_expr_)
+          || (!info.lower_.is_unbounded_ && NULL == info.lower_.between_value_expr_));
+  // rows in [ps, added) are added to frame, rows in [ps, removed) are removed from frame
+  int64_t added = ps;
+  int64_t removed = ps;
+  int64_t prev_lo = -1;
+  int64_t prev_hi = -1;
+  bool prev_valid = false;
+  frame_aggr_.reuse();
+  if (!wf_ctx.bound_evaluated_ && OB_FAIL(eval_frame_bound(wf_ctx))) {
+    LOG_WARN("eval frame bound failed", K(ret));
+  } else if (need_peer && OB_FAIL(calc_peer_groups(info, ps, pe))) {
+    LOG_WARN("calc peer groups failed", K(ret));
+  }
+  for (int64_t i = ps; OB_SUCC(ret) && i < pe; i++) {
+    int64_t lo = 0;
+    int64_t hi = 0;
+    bool valid = false;
+    ObDatum &res = wf_ctx.res_.at(i);
+    if (OB_FAIL(get_frame(wf_ctx, ps, pe, i, lo, hi, valid))) {
+      LOG_WARN("get frame failed", K(ret), K(i));
+    } else if (!valid) {
+      // count returns 0 for invalid frame, others return NULL
+      if (T_FUN_COUNT == info.func_type_) {
+        ret = set_int_result(info, 0, res);
+      } else {
+        res.set_null();
+      }
+    } else if (prev_valid && lo == prev_lo && hi == prev_hi) {
+      res = wf_ctx.res_.at(i - 1);
+    } else {
+      // frame head and tail never move backward
+      for (; OB_SUCC(ret) && removed < lo && removed < added; removed++) {
+        ret = frame_remove(wf_ctx, removed);
+      }
+      removed = std::max(removed, lo);
+      added = std::max(added, removed);
+      for (; OB_SUCC(ret) && added <= hi; added++) {
+        ret = frame_add(wf_ctx, added);
+      }
+      if (OB_FAIL(ret)) {
+        LOG_WARN("update frame failed", K(ret), K(lo), K(hi));
+      } else if (OB_FAIL(frame_result(wf_ctx, res))) {
+        LOG_WARN("get frame result failed", K(ret));
+      }
+    }
+    prev_lo = lo;
+    prev_hi = hi;
+    prev_valid = valid;
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::eval_frame_bound(WinFuncCtx &wf_ctx)
+{
+  int ret = OB_SUCCESS;
+  const WinFuncInfo &info = *wf_ctx.info_;
+  const WinFuncInfo::ExtBound *bounds[2] = { &info.upper_, &info.lower_ };
+  bool *is_nulls[2] = { &wf_ctx.upper_is_null_, &wf_ctx.lower_is_null_ };
+  int64_t *offsets[2] = { &wf_ctx.upper_offset_, &wf_ctx.lower_offset_ };
+  for (int64_t i = 0; OB_SUCC(ret) && i < 2; i++) {
+    ObExpr *expr = bounds[i]->between_value_expr_;
+    *is_nulls[i] = false;
+    *offsets[i] = 0;
+    if (NULL == expr) {
+    } else if (OB_UNLIKELY(lib::is_mysql_mode() && !expr->obj_meta_.is_integer_type())) {
+      ret = OB_ERR_WINDOW_FRAME_ILLEGAL;
+      LOG_WARN("frame start or end is negative, NULL or of non-integral type",
+               K(ret), K(expr->obj_meta_));
+    } else if (OB_FAIL(eval_bound_value(*expr, *is_nulls[i], *offsets[i]))) {
+      LOG_WARN("eval frame bound value failed", K(ret));
+    } else if (!*is_nulls[i] && *offsets[i] < 0) {
+      ret = OB_DATA_OUT_OF_RANGE;
+      LOG_WARN("invalid argument", K(ret), K(*offsets[i]));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    wf_ctx.bound_evaluated_ = true;
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::eval_bound_value(ObExpr &expr, bool &is_null, int64_t &value)
+{
+  int ret = OB_SUCCESS;
+  int64_t skip_int = 0;
+  ObBitVector *skip = to_bit_vector(&skip_int);
+  if (OB_FAIL(expr.eval_vector(eval_ctx_, *skip, 1, true))) {
+    LOG_WARN("expr evaluate failed", K(ret), K(expr));
+  } else {
+    const ObIVector *vec = expr.get_vector(eval_ctx_);
+    const char *payload = NULL;
+    ObLength len = 0;
+    bool null = false;
+    vec->get_payload(0, null, payload, len);
+    ObDatum datum(payload, len, null);
+    if (OB_FAIL(ObWindowFunctionOp::get_param_int_value(expr, datum, is_null, value, false,
+                                                        lib::is_mysql_mode()))) {
+      LOG_WARN("get param int value failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::get_frame(const WinFuncCtx &wf_ctx,
+                                     const int64_t ps,
+                                     const int64_t pe,
+                                     const int64_t idx,
+                                     int64_t &lo,
+                                     int64_t &hi,
+                                     bool &valid)
+{
+  int ret = OB_SUCCESS;
+  const WinFuncInfo &info = *wf_ctx.info_;
+  const bool is_rows = WINDOW_ROWS == info.win_type_;
+  const WinFuncInfo::ExtBound *bounds[2] = { &info.upper_, &info.lower_ };
+  const int64_t offsets[2] = { wf_ctx.upper_offset_, wf_ctx.lower_offset_ };
+  int64_t *pos[2] = { &lo, &hi };
+  valid = !wf_ctx.upper_is_null_ && !wf_ctx.lower_is_null_;
+  for (int64_t i = 0; OB_SUCC(ret) && valid && i < 2; i++) {
+    const WinFuncInfo::ExtBound &bound = *bounds[i];
+    if (bound.is_unbounded_) {
+      *pos[i] = bound.is_preceding_ ? ps : pe - 1;
+    } else if (NULL == bound.between_value_expr_) {
+      // current row
+      if (is_rows) {
+        *pos[i] = idx;
+      } else {
+        *pos[i] = 0 == i ? peer_starts_.at(idx - ps) : peer_ends_.at(idx - ps) - 1;
+      }
+    } else if (bound.is_preceding_) {
+      *pos[i] = idx - offsets[i];
+    } else if (OB_UNLIKELY(offsets[i] > INT64_MAX - idx)) {
+      if (lib::is_mysql_mode()) {
+        ret = OB_ERR_WINDOW_FRAME_ILLEGAL;
+        LOG_WARN("frame start or end is negative, NULL or of non-integral type",
+                 K(ret), K(idx), K(offsets[i]));
+      } else {
+        ret = OB_DATA_OUT_OF_RANGE;
+        LOG_WARN("int64 out of range", K(ret), K(idx), K(offsets[i]));
+      }
+    } else {
+      *pos[i] = idx + offsets[i];
+    }
+  }
+  if (OB_SUCC(ret) && valid) {
+    valid = lo <= hi && lo <= pe - 1 && hi >= ps;
+    lo = std::max(lo, ps);
+    hi = std::min(hi, pe - 1);
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::frame_add(const WinFuncCtx &wf_ctx, const int64_t idx)
+{
+  int ret = OB_SUCCESS;
+  const WinFuncInfo &info = *wf_ctx.info_;
+  const ObDatum datum = wf_ctx.param_col_ >= 0 ? get_datum(idx, wf_ctx.param_col_) : ObDatum();
+  if (wf_ctx.param_col_ >= 0 && datum.is_null()) {
+    // null values are ignored by aggregation
+  } else if (T_FUN_COUNT == info.func_type_) {
+    frame_aggr_.cnt_ += 1;
+  } else if (T_FUN_SUM == info.func_type_) {
+    frame_aggr_.cnt_ += 1;
+    if (ObDoubleType == info.expr_->datum_meta_.type_) {
+      if (OB_FAIL(ObAggregateCalcFunc::add_calc(frame_aggr_.dbl_sum_, datum, frame_aggr_.dbl_sum_,
+                                                ObDoubleTC, info.expr_->datum_meta_.precision_,
+                                                res_alloc_))) {
+        LOG_WARN("add calc failed", K(ret));
+      }
+    } else {
+      const ObObjTypeClass tc = ob_obj_type_class(info.aggr_info_.get_first_child_type());
+      ObNumStackOnceAlloc tmp_alloc;
+      ObDataBuffer allocator(frame_aggr_.nmb_buf_[frame_aggr_.nmb_idx_],
+                             ObNumber::MAX_CALC_BYTE_LEN);
+      ObNumber param;
+      ObNumber res;
+      if (ObNumberTC == tc) {
+        param.assign(datum.get_number_desc().desc_,
+                     const_cast<uint32_t *>(datum.get_number_digits()));
+      } else if (ObIntTC == tc) {
+        ret = param.from(datum.get_int(), tmp_alloc);
+      } else {
+        ret = param.from(datum.get_uint64(), tmp_alloc);
+      }
+      if (OB_FAIL(ret)) {
+        LOG_WARN("number from integer failed", K(ret));
+      } else if (OB_FAIL(frame_aggr_.nmb_sum_.add_v3(param, res, allocator, false))) {
+        LOG_WARN("number add failed", K(ret));
+      } else {
+        frame_aggr_.nmb_sum_ = res;
+        frame_aggr_.nmb_idx_ = 1 - frame_aggr_.nmb_idx_;
+      }
+    }
+  } else {
+    // min/max, keep candidates in the queue monotonic, the earliest row wins on tie
+    const ObExpr *param_expr = info.aggr_info_.param_exprs_.at(0);
+    ObArray<int64_t> &queue = frame_aggr_.queue_;
+    bool stop = false;
+    while (OB_SUCC(ret) && !stop && queue.count() > frame_aggr_.queue_head_) {
+      int cmp_ret = 0;
+      if (OB_FAIL(param_expr->basic_funcs_->null_first_cmp_(
+                  get_datum(queue.at(queue.count() - 1), wf_ctx.param_col_), datum, cmp_ret))) {
+        LOG_WARN("compare failed", K(ret));
+      } else if ((T_FUN_MAX == info.func_type_ && cmp_ret < 0)
+                 || (T_FUN_MIN == info.func_type_ && cmp_ret > 0)) {
+        queue.pop_back();
+      } else {
+        stop = true;
+      }
+    }
+    if (OB_SUCC(ret) && OB_FAIL(queue.push_back(idx))) {
+      LOG_WARN("push back failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::frame_remove(const WinFuncCtx &wf_ctx, const int64_t idx)
+{
+  int ret = OB_SUCCESS;
+  const WinFuncInfo &info = *wf_ctx.info_;
+  const ObDatum datum = wf_ctx.param_col_ >= 0 ? get_datum(idx, wf_ctx.param_col_) : ObDatum();
+  if (wf_ctx.param_col_ >= 0 && datum.is_null()) {
+  } else if (T_FUN_COUNT == info.func_type_) {
+    frame_aggr_.cnt_ -= 1;
+  } else if (T_FUN_SUM == info.func_type_) {
+    frame_aggr_.cnt_ -= 1;
+    if (ObDoubleType == info.expr_->datum_meta_.type_) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("double sum can not be removed from frame", K(ret));
+    } else {
+      const ObObjTypeClass tc = ob_obj_type_class(info.aggr_info_.get_first_child_type());
+      ObNumStackOnceAlloc tmp_alloc;
+      ObDataBuffer allocator(frame_aggr_.nmb_buf_[frame_aggr_.nmb_idx_],
+                             ObNumber::MAX_CALC_BYTE_LEN);
+      ObNumber param;
+      ObNumber res;
+      if (ObNumberTC == tc) {
+        param.assign(datum.get_number_desc().desc_,
+                     const_cast<uint32_t *>(datum.get_number_digits()));
+      } else if (ObIntTC == tc) {
+        ret = param.from(datum.get_int(), tmp_alloc);
+      } else {
+        ret = param.from(datum.get_uint64(), tmp_alloc);
+      }
+      if (OB_FAIL(ret)) {
+        LOG_WARN("number from integer failed", K(ret));
+      } else if (OB_FAIL(frame_aggr_.nmb_sum_.sub_v3(param, res, allocator, false))) {
+        LOG_WARN("number sub failed", K(ret));
+      } else {
+        frame_aggr_.nmb_sum_ = res;
+        frame_aggr_.nmb_idx_ = 1 - frame_aggr_.nmb_idx_;
+      }
+    }
+  } else if (frame_aggr_.queue_.count() > frame_aggr_.queue_head_
+             && frame_aggr_.queue_.at(frame_aggr_.queue_head_) == idx) {
+    frame_aggr_.queue_head_ += 1;
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::frame_result(const WinFuncCtx &wf_ctx, ObDatum &res)
+{
+  int ret = OB_SUCCESS;
+  const WinFuncInfo &info = *wf_ctx.info_;
+  if (T_FUN_COUNT == info.func_type_) {
+    ret = set_int_result(info, frame_aggr_.cnt_, res);
+  } else if (T_FUN_SUM == info.func_type_) {
+    if (0 == frame_aggr_.cnt_) {
+      res.set_null();
+    } else if (ObDoubleType == info.expr_->datum_meta_.type_) {
+      if (OB_ISNULL(res.ptr_ = static_cast<char *>(res_alloc_.alloc(sizeof(double))))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("allocate memory failed", K(ret));
+      } else {
+        res.set_double(frame_aggr_.dbl_sum_.get_double());
+      }
+    } else if (OB_FAIL(ObAggregateCalcFunc::clone_number_cell(frame_aggr_.nmb_sum_, res,
+                                                              res_alloc_))) {
+      LOG_WARN("clone number failed", K(ret));
+    }
+  } else if (frame_aggr_.queue_.count() > frame_aggr_.queue_head_) {
+    res = get_datum(frame_aggr_.queue_.at(frame_aggr_.queue_head_), wf_ctx.param_col_);
+  } else {
+    res.set_null();
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::set_int_result(const WinFuncInfo &info,
+                                          const int64_t val,
+                                          ObDatum &res)
+{
+  int ret = OB_SUCCESS;
+  if (ob_is_number_tc(info.expr_->datum_meta_.type_)) {
+    ObNumber res_nmb;
+    ObNumStackOnceAlloc tmp_alloc;
+    if (OB_FAIL(res_nmb.from(val, tmp_alloc))) {
+      LOG_WARN("failed to build number from int64_t", K(ret));
+    } else if (OB_FAIL(ObAggregateCalcFunc::clone_number_cell(res_nmb, res, res_alloc_))) {
+      LOG_WARN("clone number failed", K(ret));
+    }
+  } else if (OB_ISNULL(res.ptr_ = static_cast<char *>(res_alloc_.alloc(sizeof(int64_t))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret));
+  } else {
+    res.set_int(val);
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::set_ratio_result(const WinFuncInfo &info,
+                                            const int64_t numerator,
+                                            const int64_t denominator,
+                                            ObDatum &res)
+{
+  int ret = OB_SUCCESS;
+  if (ob_is_number_tc(info.expr_->datum_meta_.type_)) {
+    ObNumber res_nmb;
+    ObNumStackAllocator<3> tmp_alloc;
+    if (0 == denominator) {
+      res_nmb.set_zero();
+    } else {
+      ObNumber num;
+      ObNumber den;
+      if (OB_FAIL(num.from(numerator, tmp_alloc))) {
+        LOG_WARN("failed to build number from int64_t", K(ret));
+      } else if (OB_FAIL(den.from(denominator, tmp_alloc))) {
+        LOG_WARN("failed to build number from int64_t", K(ret));
+      } else if (OB_FAIL(num.div(den, res_nmb, tmp_alloc))) {
+        LOG_WARN("failed to div number", K(ret));
+      }
+    }
+    if (OB_SUCC(ret)
+        && OB_FAIL(ObAggregateCalcFunc::clone_number_cell(res_nmb, res, res_alloc_))) {
+      LOG_WARN("clone number failed", K(ret));
+    }
+  } else if (ObDoubleType == info.expr_->datum_meta_.type_) {
+    if (OB_ISNULL(res.ptr_ = static_cast<char *>(res_alloc_.alloc(sizeof(double))))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret));
+    } else {
+      res.set_double(0 == denominator
+                     ? 0 : static_cast<double>(numerator) / static_cast<double>(denominator));
+    }
+  } else {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("the result type of window function is unexpected", K(ret),
+             K(info.expr_->datum_meta_));
+  }
+  return ret;
+}
+
+int ObWindowFunctionVecOp::output_rows(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  const int64_t size = std::min(std::min(max_row_cnt, MY_SPEC.max_batch_size_),
+                                computed_cnt_ - output_idx_);
+  const ObCompactRow **srows = const_cast<const ObCompactRow **>(&rows_.at(output_idx_));
+  if (OB_FAIL(ObTempRowStore::Iterator::attach_rows(MY_SPEC.all_expr_, eval_ctx_,
+                                                    stores_[cur_store_].get_row_meta(),
+                                                    srows, size))) {
+    LOG_WARN("attach rows failed", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < wf_cnt_; i++) {
+    const ObExpr *expr = wf_ctxs_[i].info_->expr_;
+    const ObArray<ObDatum> &res = wf_ctxs_[i].res_;
+    if (OB_FAIL(expr->init_vector_for_write(eval_ctx_, expr->get_default_res_format(), size))) {
+      LOG_WARN("init vector failed", K(ret));
+    } else {
+      ObIVector *vec = expr->get_vector(eval_ctx_);
+      for (int64_t j = 0; j < size; j++) {
+        const ObDatum &datum = res.at(output_idx_ + j);
+        if (datum.is_null()) {
+          vec->set_null(j);
+        } else {
+          vec->set_payload_shallow(j, datum.ptr_, datum.len_);
+        }
+      }
+      expr->set_evaluated_projected(eval_ctx_);
+    }
+  }
+  if (OB_SUCC(ret)) {
+    brs_.size_ = size;
+    brs_.skip_->reset(size);
+    output_idx_ += size;
+  }
+  return ret;
+}
+
+} // end namespace sql
+} // end namespace oceanbase
@@ -0,0 +1,171 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_WINDOW_FUNCTION_OB_WINDOW_FUNCTION_VEC_OP_H_
+#define OCEANBASE_WINDOW_FUNCTION_OB_WINDOW_FUNCTION_VEC_OP_H_
+
+#include "lib/container/ob_array.h"
+#include "lib/allocator/page_arena.h"
+#include "sql/engine/ob_operator.h"
+#include "sql/engine/basic/ob_temp_row_store.h"
+#include "sql/engine/window_function/ob_window_function_op.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+
+// Spec of vectorized (rich format) window function.
+// Shares the layout of ObWindowFunctionSpec, except that %all_expr_ also holds the
+// partition by exprs and aggregate param exprs of every window function, so that
+// all columns needed by the calculation can be read from the stored rows.
+class ObWindowFunctionVecSpec : public ObWindowFunctionSpec
+{
+  OB_UNIS_VERSION_V(1);
+public:
+  ObWindowFunctionVecSpec(common::ObIAllocator &alloc, const ObPhyOperatorType type)
+    : ObWindowFunctionSpec(alloc, type)
+  {
+  }
+};
+
+// Vectorized window function operator.
+//
+// Input rows are buffered in a temp row store until the partition (partition by exprs of the
+// last window function, which are subsets of the others) is complete. The window functions
+// are then calculated for the whole partition block in one pass per function, and the results
+// are projected to the output vectors batch by batch:
+//   - ranking functions are computed from the peer group boundaries,
+//   - aggregate functions use a sliding frame, the frame bounds never move backward for the
+//     supported frame types, so SUM/COUNT are maintained by adding and removing rows and
+//     MIN/MAX are maintained by a monotonic queue.
+// Unsupported window functions (see all_supported_window_functions()) are processed by
+// ObWindowFunctionOp.
+//
+// The buffered rows are accessed by position and can not be dumped, so memory is bounded by
+// the largest partition only. Until the store supports dumping, the code generator keeps
+// ObWindowFunctionOp unless EN_ENABLE_VEC_WINDOW_FUNCTION is set.
+class ObWindowFunctionVecOp : public ObOperator
+{
+public:
+  ObWindowFunctionVecOp(ObExecContext &exec_ctx, const ObOpSpec &spec, ObOpInput *input);
+  virtual ~ObWindowFunctionVecOp() {}
+
+  virtual int inner_open() override;
+  virtual int inner_close() override;
+  virtual int inner_rescan() override;
+  virtual int inner_get_next_row() override;
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
+  virtual void destroy() override;
+
+  static bool all_supported_window_functions(const common::ObIArray<ObWinFunRawExpr *> &wf_exprs);
+
+private:
+  struct WinFuncCtx
+  {
+    WinFuncCtx() : info_(NULL), part_cols_(), param_col_(-1), bound_evaluated_(false),
+                   upper_is_null_(false), lower_is_null_(false), upper_offset_(0),
+                   lower_offset_(0), res_()
+    {
+    }
+    TO_STRING_KV(KPC_(info), K_(part_cols), K_(param_col), K_(bound_evaluated),
+                 K_(upper_is_null), K_(lower_is_null), K_(upper_offset), K_(lower_offset));
+
+    const WinFuncInfo *info_;
+    // column index of partition by exprs and aggregate param in stored rows
+    common::ObSEArray<int64_t, 4> part_cols_;
+    int64_t param_col_;
+    // literal offsets of `ROWS BETWEEN N PRECEDING AND M FOLLOWING`
+    bool bound_evaluated_;
+    bool upper_is_null_;
+    bool lower_is_null_;
+    int64_t upper_offset_;
+    int64_t lower_offset_;
+    // result of each buffered row
+    common::ObArray<common::ObDatum> res_;
+  };
+
+  // running state of sliding frame aggregation
+  struct FrameAggr
+  {
+    FrameAggr() : cnt_(0), dbl_sum_(), nmb_sum_(), nmb_idx_(0), queue_(), queue_head_(0) {}
+    void reuse();
+
+    int64_t cnt_;
+    common::ObDatum dbl_sum_;
+    char dbl_buf_[sizeof(double)];
+    common::number::ObNumber nmb_sum_;
+    char nmb_buf_[2][common::number::ObNumber::MAX_CALC_BYTE_LEN];
+    int64_t nmb_idx_;
+    // row indexes of MIN/MAX candidates, values are monotonic from head to tail
+    common::ObArray<int64_t> queue_;
+    int64_t queue_head_;
+  };
+
+  void reset();
+  int init_wf_ctxs();
+  int init_store(ObTempRowStore &store);
+  int fetch_child_rows();
+  int shrink_rows();
+  int is_same_part(const common::ObIArray<int64_t> &part_cols, const WinFuncInfo &info,
+                   const int64_t l, const int64_t r, bool &same) const;
+  // mark the first row of each partition (%part_cols not NULL) or peer group in [begin, end)
+  int mark_boundaries(const WinFuncInfo &info, const common::ObIArray<int64_t> *part_cols,
+                      const int64_t begin, const int64_t end);
+  int calc_peer_groups(const WinFuncInfo &info, const int64_t ps, const int64_t pe);
+  int compute(const int64_t end);
+  int compute_partition(WinFuncCtx &wf_ctx, const int64_t ps, const int64_t pe);
+  int compute_ranking(WinFuncCtx &wf_ctx, const int64_t ps, const int64_t pe);
+  int compute_aggregation(WinFuncCtx &wf_ctx, const int64_t ps, const int64_t pe);
+  int eval_frame_bound(WinFuncCtx &wf_ctx);
+  int eval_bound_value(ObExpr &expr, bool &is_null, int64_t &value);
+  int get_frame(const WinFuncCtx &wf_ctx, const int64_t ps, const int64_t pe,
+                const int64_t idx, int64_t &lo, int64_t &hi, bool &valid);
+  int frame_add(const WinFuncCtx &wf_ctx, const int64_t idx);
+  int frame_remove(const WinFuncCtx &wf_ctx, const int64_t idx);
+  int frame_result(const WinFuncCtx &wf_ctx, common::ObDatum &res);
+  int set_int_result(const WinFuncInfo &info, const int64_t val, common::ObDatum &res);
+  int set_ratio_result(const WinFuncInfo &info, const int64_t numerator,
+                       const int64_t denominator, common::ObDatum &res);
+  int output_rows(const int64_t max_row_cnt);
+
+  inline common::ObDatum get_datum(const int64_t row_idx, const int64_t col_idx) const
+  {
+    return rows_.at(row_idx)->get_datum(stores_[cur_store_].get_row_meta(), col_idx);
+  }
+
+private:
+  common::ObArenaAllocator res_alloc_;
+  // rows are copied between the two stores when the processed rows are released,
+  // keeping the rows of the pending partition.
+  ObTempRowStore stores_[2];
+  int64_t cur_store_;
+  common::ObArray<ObCompactRow *> rows_;
+  ObCompactRow **batch_rows_;
+  WinFuncCtx *wf_ctxs_;
+  int64_t wf_cnt_;
+  FrameAggr frame_aggr_;
+  // start row of the last (maybe incomplete) partition
+  int64_t last_part_start_;
+  int64_t computed_cnt_;
+  int64_t output_idx_;
+  bool child_iter_end_;
+  common::ObArray<uint8_t> boundaries_;
+  common::ObArray<int64_t> part_starts_;
+  common::ObArray<int64_t> peer_starts_;
+  common::ObArray<int64_t> peer_ends_;
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+
+#endif // OCEANBASE_WINDOW_FUNCTION_OB_WINDOW_FUNCTION_VEC_OP_H_
@@ -188,7 +188,10 @@ enum ObMatchAgainstMode {
  ((type) == PHY_HASH_INTERSECT) || \
  ((type) == PHY_MERGE_INTERSECT) || \
  ((type) == PHY_HASH_EXCEPT) || \
- ((type) == PHY_MERGE_EXCEPT))
+ ((type) == PHY_MERGE_EXCEPT) || \
+ ((type) == PHY_VEC_HASH_UNION) || \
+ ((type) == PHY_VEC_HASH_INTERSECT) || \
+ ((type) == PHY_VEC_HASH_EXCEPT))
 
 
 inline ObJoinType get_opposite_join_type(ObJoinType type)
@@ -2300,6 +2300,8 @@ int ObDDLResolver::resolve_file_format(const ParseNode *node, ObExternalFileForm
         ObString string_v = ObString(node->children_[0]->str_len_, node->children_[0]->str_value_).trim_space_only();
         if (0 == string_v.case_compare("CSV")) {
           format.format_type_ = ObExternalFileFormat::CSV_FORMAT;
+        } else if (0 == string_v.case_compare("PARQUET")) {
+          format.format_type_ = ObExternalFileFormat::PARQUET_FORMAT;
         } else {
           ObSqlString err_msg;
           err_msg.append_fmt("format '%.*s'", string_v.length(), string_v.ptr());
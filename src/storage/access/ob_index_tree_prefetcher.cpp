@@ -582,8 +582,18 @@ int ObIndexTreeMultiPrefetcher::drill_down(
   } else {
     // hold block cache of the parent temporaliy to avoid freed
     ObMicroBlockDataHandle &next_handle = read_handle.get_read_handle();
-    if (OB_FAIL(prefetch_block_data(index_block_info, next_handle, cur_level_is_leaf))) {
+    const ObMicroBlockDataHandle *prefetched_handle = get_prefetched_handle(read_handle, index_block_info);
+    if (nullptr != prefetched_handle) {
+      next_handle = *prefetched_handle;
+      // an in-flight io is neither a hit nor a new miss, it is counted once by its owner
+      if (ObSSTableMicroBlockState::IN_BLOCK_CACHE == next_handle.block_state_) {
+        ++access_ctx_->table_store_stat_.block_cache_hit_cnt_;
+      }
+      LOG_DEBUG("share micro block handle prefetched by other rowkey", K(index_block_info), K(next_handle));
+    } else if (OB_FAIL(prefetch_block_data(index_block_info, next_handle, cur_level_is_leaf))) {
       LOG_WARN("fail to prefetch_block_data", K(ret), K(read_handle), K(index_block_info), K(cur_level_is_leaf));
+    }
+    if (OB_FAIL(ret)) {
     } else if (FALSE_IT(read_handle.set_cur_micro_handle(next_handle))) {
     } else if (cur_level_is_leaf) {
       mark_cur_rowkey_prefetched(read_handle);
@@ -615,6 +625,30 @@ int ObIndexTreeMultiPrefetcher::drill_down(
   return ret;
 }
 
+const ObMicroBlockDataHandle *ObIndexTreeMultiPrefetcher::get_prefetched_handle(
+    const ObSSTableReadHandleExt &read_handle,
+    const ObMicroIndexInfo &index_block_info) const
+{
+  const ObMicroBlockDataHandle *prefetched_handle = nullptr;
+  const MacroBlockId &macro_id = index_block_info.get_macro_id();
+  const int32_t offset = static_cast<int32_t>(index_block_info.get_block_offset());
+  const int32_t size = static_cast<int32_t>(index_block_info.get_block_size());
+  // search from the latest rowkey, which is the most likely one for sorted rowkeys
+  for (int64_t i = 1; nullptr == prefetched_handle && i < max_handle_prefetching_cnt_ && i <= read_handle.range_idx_; ++i) {
+    const ObSSTableReadHandleExt &other = ext_read_handles_[(read_handle.range_idx_ - i) % max_handle_prefetching_cnt_];
+    // handles before micro_handle_idx_ are got for the rowkey of this read handle
+    const int64_t handle_cnt = min(other.micro_handle_idx_,
+        static_cast<int64_t>(ObSSTableReadHandleExt::DEFAULT_MULTIGET_MICRO_DATA_HANDLE_CNT));
+    for (int64_t j = 0; nullptr == prefetched_handle && j < handle_cnt; ++j) {
+      const ObMicroBlockDataHandle &handle = other.micro_handles_[j];
+      if (handle.in_block_state() && handle.match(macro_id, offset, size)) {
+        prefetched_handle = &handle;
+      }
+    }
+  }
+  return prefetched_handle;
+}
+
 ////////////////////////////////// MultiPassPrefetcher /////////////////////////////////////////////
 template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
 ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::~ObIndexTreeMultiPassPrefetcher()
@@ -644,6 +678,9 @@ void ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::
   max_micro_handle_cnt_ = 0;
   prefetch_depth_ = 1;
   total_micro_data_cnt_ = 0;
+  window_hit_cnt_ = 0;
+  window_miss_cnt_ = 0;
+  window_wait_cnt_ = 0;
   query_range_ = nullptr;
   border_rowkey_.reset();
   read_handles_.reset();
@@ -665,6 +702,9 @@ void ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::
   agg_row_store_ = nullptr;
   prefetch_depth_ = 1;
   total_micro_data_cnt_ = 0;
+  window_hit_cnt_ = 0;
+  window_miss_cnt_ = 0;
+  window_wait_cnt_ = 0;
   for (int64_t i = 0; i < tree_handle_cap_; i++) {
     tree_handles_[i].reuse();
   }
@@ -703,12 +743,34 @@ int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::i
   return ret;
 }
 
+template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
+int32_t ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::adjust_prefetch_depth(
+    const int32_t depth,
+    const int32_t hit_cnt,
+    const int32_t miss_cnt,
+    const int32_t wait_cnt)
+{
+  int32_t new_depth = depth;
+  const int32_t window_cnt = hit_cnt + miss_cnt;
+  if (0 < wait_cnt || 0 == window_cnt) {
+    // reader waited for the prefetched blocks, enlarge the window to hide io latency
+    new_depth = MIN(2 * depth, DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT);
+  } else if (hit_cnt * 100 >= window_cnt * PREFETCH_CACHE_HIT_PERCENT) {
+    // blocks are mostly in block cache, prefetching them early only holds more memory
+    new_depth = MAX(1, depth / 2);
+  }
+  return new_depth;
+}
+
 template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
 int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::get_prefetch_depth(int64_t &depth)
 {
   int ret = OB_SUCCESS;
   depth = 0;
-  prefetch_depth_ = MIN(2 * prefetch_depth_, DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT);
+  prefetch_depth_ = adjust_prefetch_depth(prefetch_depth_, window_hit_cnt_, window_miss_cnt_, window_wait_cnt_);
+  window_hit_cnt_ = 0;
+  window_miss_cnt_ = 0;
+  window_wait_cnt_ = 0;
   if (need_check_prefetch_depth_) {
     int64_t prefetch_micro_cnt = MAX(1,
           (access_ctx_->limit_param_->offset_ + access_ctx_->limit_param_->limit_ - access_ctx_->out_cnt_ + \
@@ -717,6 +779,8 @@ int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::g
   }
   depth = min(static_cast<int64_t>(prefetch_depth_),
               max_micro_handle_cnt_ - (micro_data_prefetch_idx_ - cur_micro_data_fetch_idx_));
+  access_ctx_->table_store_stat_.max_prefetch_depth_ =
+      MAX(access_ctx_->table_store_stat_.max_prefetch_depth_, prefetch_depth_);
   return ret;
 }
 
@@ -892,6 +956,19 @@ void ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::
 {
   current_micro_handle().reset();
   ++cur_micro_data_fetch_idx_;
+  bool need_wait = false;
+  if (cur_micro_data_fetch_idx_ < micro_data_prefetch_idx_) {
+    const ObMicroBlockDataHandle &micro_handle = current_micro_handle();
+    need_wait = ObSSTableMicroBlockState::IN_BLOCK_IO == micro_handle.block_state_
+        && !micro_handle.io_handle_.is_finished();
+  } else {
+    // all prefetched blocks are consumed
+    need_wait = !is_prefetch_end_;
+  }
+  if (need_wait) {
+    ++window_wait_cnt_;
+    ++access_ctx_->table_store_stat_.prefetch_wait_cnt_;
+  }
 }
 
 /*
@@ -1044,6 +1121,8 @@ int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::p
   int64_t prefetched_cnt = 0;
   int64_t prefetch_micro_idx = 0;
   int64_t prefetch_depth = 0;
+  int64_t io_start_idx = 0;
+  int64_t io_cnt = 0;
   if (OB_UNLIKELY(index_tree_height_ <= cur_level_ ||
                   micro_data_prefetch_idx_ - cur_micro_data_fetch_idx_ > max_micro_handle_cnt_)) {
     ret = OB_ERR_UNEXPECTED;
@@ -1103,8 +1182,8 @@ int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::p
             if (OB_UNLIKELY(OB_ITER_END != ret)) {
               LOG_WARN("Fail to check row lock", K(ret), K(block_info), KPC(this));
             }
-          } else if (OB_FAIL(prefetch_block_data(block_info, micro_data_handles_[prefetch_micro_idx]))) {
-            LOG_WARN("fail to prefetch_block_data", K(ret), K(block_info));
+          } else if (OB_FAIL(prefetch_data_block(block_info, io_start_idx, io_cnt))) {
+            LOG_WARN("fail to prefetch data block", K(ret), K(block_info));
           }
 
           if OB_SUCC(ret) {
@@ -1130,10 +1209,105 @@ int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::p
       }
     }
   }
+  if (0 < io_cnt && (OB_SUCC(ret) || OB_ITER_END == ret)) {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_TMP_FAIL(submit_data_block_io(io_start_idx, io_cnt))) {
+      ret = tmp_ret;
+      LOG_WARN("Fail to submit data block io", K(ret), K(io_start_idx), K(io_cnt));
+    }
+  }
   LOG_DEBUG("[INDEX BLOCK] prefetched info", K(ret),  KPC(this));
   return ret;
 }
 
+template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
+int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::prefetch_data_block(
+    ObMicroIndexInfo &block_info,
+    int64_t &io_start_idx,
+    int64_t &io_cnt)
+{
+  int ret = OB_SUCCESS;
+  ObMicroBlockDataHandle &micro_handle = micro_data_handles_[micro_data_prefetch_idx_ % max_micro_handle_cnt_];
+  ++access_ctx_->table_store_stat_.prefetch_micro_cnt_;
+  if (is_rescan_ || access_ctx_->micro_block_handle_mgr_.reach_hold_limit()) {
+    if (OB_FAIL(prefetch_block_data(block_info, micro_handle))) {
+      LOG_WARN("fail to prefetch_block_data", K(ret), K(block_info));
+    } else if (ObSSTableMicroBlockState::IN_BLOCK_CACHE == micro_handle.block_state_) {
+      ++window_hit_cnt_;
+    } else {
+      ++window_miss_cnt_;
+    }
+  } else if (OB_SUCCESS != access_ctx_->micro_block_handle_mgr_.get_micro_block_handle(
+              block_info,
+              true, /* is data block */
+              false, /* need submit io */
+              micro_handle)) {
+    // not in block cache, read with the previous missed blocks if they are adjacent
+    ++window_miss_cnt_;
+    if (0 < io_cnt) {
+      const ObMicroIndexInfo &last_info = micro_data_infos_[(io_start_idx + io_cnt - 1) % max_micro_handle_cnt_];
+      if (!can_merge_block_io(last_info, io_start_idx + io_cnt, io_cnt, block_info, micro_data_prefetch_idx_)) {
+        if (OB_FAIL(submit_data_block_io(io_start_idx, io_cnt))) {
+          LOG_WARN("Fail to submit data block io", K(ret), K(io_start_idx), K(io_cnt));
+        } else {
+          io_cnt = 0;
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      if (0 == io_cnt) {
+        io_start_idx = micro_data_prefetch_idx_;
+      }
+      ++io_cnt;
+    }
+  } else {
+    ++window_hit_cnt_;
+  }
+  return ret;
+}
+
+template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
+bool ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::can_merge_block_io(
+    const ObMicroIndexInfo &last_info,
+    const int64_t io_end_idx,
+    const int64_t io_cnt,
+    const ObMicroIndexInfo &block_info,
+    const int64_t block_idx)
+{
+  // blocks hit in cache between them break the run
+  return io_end_idx == block_idx
+      && io_cnt < MAX_MULTI_BLOCK_IO_CNT
+      && last_info.parent_macro_id_ == block_info.parent_macro_id_
+      && last_info.get_block_offset() + last_info.get_block_size() == block_info.get_block_offset();
+}
+
+template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
+int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::submit_data_block_io(
+    const int64_t io_start_idx,
+    const int64_t io_cnt)
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<ObMicroIndexInfo, MAX_MULTI_BLOCK_IO_CNT> block_infos;
+  ObMicroBlockDataHandle *micro_handles[MAX_MULTI_BLOCK_IO_CNT];
+  if (OB_UNLIKELY(io_cnt <= 0 || io_cnt > MAX_MULTI_BLOCK_IO_CNT)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), K(io_start_idx), K(io_cnt));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < io_cnt; ++i) {
+    const int64_t micro_idx = (io_start_idx + i) % max_micro_handle_cnt_;
+    micro_handles[i] = &micro_data_handles_[micro_idx];
+    if (OB_FAIL(block_infos.push_back(micro_data_infos_[micro_idx]))) {
+      LOG_WARN("Fail to push back block info", K(ret), K(micro_idx));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(access_ctx_->micro_block_handle_mgr_.get_multi_micro_block_handles(
+              block_infos, micro_handles))) {
+    LOG_WARN("Fail to get multi micro block handles", K(ret), K(io_start_idx), K(io_cnt));
+  }
+  return ret;
+}
+
 // drill down to get next valid index micro block
 template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
 int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::drill_down()
@@ -303,6 +303,11 @@ private:
       ObSSTableReadHandleExt &read_handle,
       const bool cur_level_is_leaf,
       const bool force_prefetch);
+  // rowkeys in the same micro block share the handle got by the first of them, so the block is
+  // read by one io or cache get for all the rowkeys in the prefetching window
+  const ObMicroBlockDataHandle *get_prefetched_handle(
+      const ObSSTableReadHandleExt &read_handle,
+      const ObMicroIndexInfo &index_block_info) const;
 };
 
 template <int32_t DATA_PREFETCH_DEPTH = 32, int32_t INDEX_PREFETCH_DEPTH = 3>
@@ -325,6 +330,9 @@ public:
       max_range_prefetching_cnt_(0),
       max_micro_handle_cnt_(0),
       total_micro_data_cnt_(0),
+      window_hit_cnt_(0),
+      window_miss_cnt_(0),
+      window_wait_cnt_(0),
       query_range_(nullptr),
       border_rowkey_(),
       read_handles_(),
@@ -391,7 +399,8 @@ public:
                        K_(is_prefetch_end), K_(cur_range_fetch_idx), K_(cur_range_prefetch_idx), K_(max_range_prefetching_cnt),
                        K_(cur_micro_data_fetch_idx), K_(micro_data_prefetch_idx), K_(max_micro_handle_cnt),
                        K_(iter_type), K_(cur_level), K_(index_tree_height), K_(prefetch_depth),
-                       K_(total_micro_data_cnt), KP_(query_range), K_(tree_handle_cap),
+                       K_(total_micro_data_cnt), K_(window_hit_cnt), K_(window_miss_cnt),
+                       K_(window_wait_cnt), KP_(query_range), K_(tree_handle_cap),
                        K_(can_blockscan), K_(need_check_prefetch_depth),
                        K(ObArrayWrap<ObIndexTreeLevelHandle>(tree_handles_, index_tree_height_)));
 protected:
@@ -404,6 +413,26 @@ protected:
   struct ObIndexTreeLevelHandle;
   virtual int prefetch_index_tree();
   virtual int prefetch_micro_data();
+  // Prefetch the data block of micro_data_prefetch_idx_, the blocks missed in block cache are
+  // collected to [io_start_idx, io_start_idx + io_cnt) to be read with one io if adjacent.
+  int prefetch_data_block(
+      ObMicroIndexInfo &block_info,
+      int64_t &io_start_idx,
+      int64_t &io_cnt);
+  int submit_data_block_io(const int64_t io_start_idx, const int64_t io_cnt);
+  // Prefetch depth for the next refill from what is observed since the last one.
+  static int32_t adjust_prefetch_depth(
+      const int32_t depth,
+      const int32_t hit_cnt,
+      const int32_t miss_cnt,
+      const int32_t wait_cnt);
+  // Whether the block of %block_idx can join the io of %io_cnt blocks ending at %last_info.
+  static bool can_merge_block_io(
+      const ObMicroIndexInfo &last_info,
+      const int64_t io_end_idx,
+      const int64_t io_cnt,
+      const ObMicroIndexInfo &block_info,
+      const int64_t block_idx);
   int try_add_query_range(ObIndexTreeLevelHandle &tree_handle);
   int drill_down();
   int prepare_read_handle(
@@ -430,6 +459,8 @@ protected:
   static const int32_t DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT = DATA_PREFETCH_DEPTH;
   static const int32_t INDEX_TREE_PREFETCH_DEPTH = INDEX_PREFETCH_DEPTH;
   static const int32_t SSTABLE_MICRO_AVG_COUNT = 100;
+  static const int32_t MAX_MULTI_BLOCK_IO_CNT = 8;
+  static const int32_t PREFETCH_CACHE_HIT_PERCENT = 90;
   struct ObIndexBlockReadHandle {
     ObIndexBlockReadHandle() :
         end_prefetched_row_idx_(-1),
@@ -604,6 +635,10 @@ protected:
   int32_t max_range_prefetching_cnt_;
   int32_t max_micro_handle_cnt_;
   int64_t total_micro_data_cnt_;
+  // observed since prefetch_depth_ is adjusted last time
+  int32_t window_hit_cnt_;
+  int32_t window_miss_cnt_;
+  int32_t window_wait_cnt_;
   union {
     const common::ObIArray<blocksstable::ObDatumRowkey> *rowkeys_; // for multi get/multi exist/single exist
     const blocksstable::ObDatumRange *range_; // for scan
@@ -362,6 +362,75 @@ int ObMicroBlockHandleMgr::get_micro_block_handle(
   return ret;
 }
 
+int ObMicroBlockHandleMgr::get_multi_micro_block_handles(
+    ObIArray<ObMicroIndexInfo> &index_block_infos,
+    ObMicroBlockDataHandle **micro_block_handles)
+{
+  int ret = OB_SUCCESS;
+  const uint64_t tenant_id = MTL_ID();
+  const int64_t block_count = index_block_infos.count();
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Block handle manager is not inited", K(ret));
+  } else if (OB_UNLIKELY(block_count <= 0 || nullptr == micro_block_handles)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), K(block_count), KP(micro_block_handles));
+  } else if (1 == block_count || (enable_limit_ && current_hold_size_ > hold_limit_)) {
+    for (int64_t i = 0; OB_SUCC(ret) && i < block_count; ++i) {
+      if (OB_FAIL(get_micro_block_handle(index_block_infos.at(i), true, true, *micro_block_handles[i]))) {
+        LOG_WARN("Fail to get micro block handle", K(ret), K(i), K(index_block_infos.at(i)));
+      }
+    }
+  } else {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_TMP_FAIL(update_limit())) {
+      LOG_WARN("Fail to update limit", K(tmp_ret));
+    }
+    const MacroBlockId &macro_id = index_block_infos.at(0).get_macro_id();
+    const bool use_cache = query_flag_->is_use_block_cache() && use_data_block_cache_;
+    ObMacroBlockHandle macro_handle;
+    ObMultiBlockIOParam io_param;
+    io_param.micro_index_infos_ = &index_block_infos;
+    io_param.start_index_ = 0;
+    io_param.block_count_ = block_count;
+    if (OB_FAIL(data_block_cache_->prefetch(tenant_id, macro_id, io_param, use_cache, macro_handle))) {
+      LOG_WARN("Fail to prefetch multi micro blocks", K(ret), K(io_param), K(macro_handle));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < block_count; ++i) {
+      ObMicroIndexInfo &index_block_info = index_block_infos.at(i);
+      ObMicroBlockDataHandle &micro_block_handle = *micro_block_handles[i];
+      const int64_t size = index_block_info.get_block_size();
+      micro_block_handle.reset();
+      if (OB_ISNULL(index_block_info.row_header_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("Unexpect null index header", K(ret), K(index_block_info));
+      } else if (OB_FAIL(index_block_info.row_header_->fill_micro_des_meta(
+                  true /* deep_copy_key */, micro_block_handle.des_meta_))) {
+        LOG_WARN("Fail to fill micro block deserialize meta", K(ret));
+      } else {
+        micro_block_handle.tenant_id_ = tenant_id;
+        micro_block_handle.macro_block_id_ = macro_id;
+        micro_block_handle.micro_info_.set(index_block_info.get_block_offset(), size);
+        micro_block_handle.handle_mgr_ = this;
+        micro_block_handle.block_state_ = ObSSTableMicroBlockState::IN_BLOCK_IO;
+        micro_block_handle.block_index_ = static_cast<int32_t>(i);
+        micro_block_handle.io_handle_ = macro_handle;
+        micro_block_handle.allocator_ = &block_io_allocator_;
+        current_hold_size_ += micro_block_handle.get_handle_size();
+        cache_miss(true);
+        if (use_cache) {
+          update_data_block_io_size(size);
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      ++table_store_stat_->multi_block_io_cnt_;
+      table_store_stat_->multi_block_io_micro_cnt_ += block_count;
+    }
+  }
+  return ret;
+}
+
 void ObMicroBlockHandleMgr::dec_hold_size(ObMicroBlockDataHandle &handle)
 {
   current_hold_size_ -= handle.get_handle_size();
@@ -86,6 +86,11 @@ public:
       const bool is_data_block,
       const bool need_submit_io,
       ObMicroBlockDataHandle &micro_block_handle);
+  // Read the data blocks with one io, they should be adjacent in the same macro block and not in
+  // the block cache. Falls back to one io for each block if reaching hold limit.
+  int get_multi_micro_block_handles(
+      common::ObIArray<blocksstable::ObMicroIndexInfo> &index_block_infos,
+      ObMicroBlockDataHandle **micro_block_handles);
 
   void dec_hold_size(ObMicroBlockDataHandle &handle);
   bool reach_hold_limit() const;
@@ -188,6 +188,12 @@ OB_INLINE int ObMultipleMerge::update_and_report_tablet_stat()
     access_ctx_->table_scan_stat_->block_cache_miss_cnt_ += access_ctx_->table_store_stat_.block_cache_miss_cnt_;
     access_ctx_->table_scan_stat_->row_cache_hit_cnt_ += access_ctx_->table_store_stat_.row_cache_hit_cnt_;
     access_ctx_->table_scan_stat_->row_cache_miss_cnt_ += access_ctx_->table_store_stat_.row_cache_miss_cnt_;
+    access_ctx_->table_scan_stat_->prefetch_micro_cnt_ += access_ctx_->table_store_stat_.prefetch_micro_cnt_;
+    access_ctx_->table_scan_stat_->prefetch_wait_cnt_ += access_ctx_->table_store_stat_.prefetch_wait_cnt_;
+    access_ctx_->table_scan_stat_->max_prefetch_depth_ = MAX(access_ctx_->table_scan_stat_->max_prefetch_depth_,
+                                                             access_ctx_->table_store_stat_.max_prefetch_depth_);
+    access_ctx_->table_scan_stat_->multi_block_io_cnt_ += access_ctx_->table_store_stat_.multi_block_io_cnt_;
+    access_ctx_->table_scan_stat_->multi_block_io_micro_cnt_ += access_ctx_->table_store_stat_.multi_block_io_micro_cnt_;
   }
   if (lib::is_diagnose_info_enabled()) {
     collect_merge_stat(access_ctx_->table_store_stat_);
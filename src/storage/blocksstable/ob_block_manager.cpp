@@ -140,6 +140,7 @@ ObBlockManager::ObBlockManager()
     bad_block_lock_(),
     io_device_(NULL),
     blk_seq_generator_(),
+    start_write_seq_(-1),
     alloc_num_(0),
     resize_file_lock_(),
     group_id_(0),
@@ -275,6 +276,7 @@ void ObBlockManager::destroy()
   is_mark_sweep_enabled_ = false;
   marker_status_.reset();
   blk_seq_generator_.reset();
+  ATOMIC_STORE(&start_write_seq_, -1);
   ATOMIC_STORE(&alloc_num_, 0);
   group_id_ = 0;
   is_inited_ = false;
@@ -466,6 +468,7 @@ int ObBlockManager::first_mark_device()
     LOG_WARN("fail to first mark blocks before running", K(ret));
   } else {
     blk_seq_generator_.update_sequence(iter.get_max_write_sequence());
+    ATOMIC_STORE(&start_write_seq_, static_cast<int64_t>(iter.get_max_write_sequence()));
     enable_mark_sweep();
   }
   return ret;
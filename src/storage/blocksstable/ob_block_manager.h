@@ -231,6 +231,9 @@ public:
   int get_marker_status(ObMacroBlockMarkerStatus &status);
   void mark_and_sweep();
   int first_mark_device();
+  // max write sequence of blocks in use when the device is first marked, blocks allocated
+  // later all have larger sequence, -1 if not marked yet.
+  int64_t get_start_write_seq() const { return ATOMIC_LOAD(&start_write_seq_); }
 
   bool is_started() { return is_started_; }
 private:
@@ -488,6 +491,7 @@ private:
 
   common::ObIODevice *io_device_;
   ObMacroBlockSeqGenerator blk_seq_generator_;
+  int64_t start_write_seq_;
   int64_t alloc_num_;
   lib::ObMutex resize_file_lock_;
 
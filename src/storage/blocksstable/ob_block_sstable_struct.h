@@ -1086,6 +1086,11 @@ public:
         && row_store_type_ < common::ObRowStoreType::MAX_ROW_STORE
         && compressor_type_ < common::ObCompressorType::MAX_COMPRESSOR;
   }
+  // written with encryption, whether or not this build is able to decrypt it
+  OB_INLINE bool is_encrypted() const
+  {
+    return encrypt_id_ > static_cast<int64_t>(share::ObCipherOpMode::ob_invalid_mode);
+  }
 public:
   common::ObCompressorType compressor_type_;
   common::ObRowStoreType row_store_type_;
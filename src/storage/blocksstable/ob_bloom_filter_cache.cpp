@@ -309,6 +309,7 @@ ObBloomFilterCacheValue::ObBloomFilterCacheValue()
     rowkey_column_cnt_(0),
     row_count_(0),
     bloom_filter_(),
+    xor_filter_(),
     is_inited_(false)
 {
 }
@@ -319,8 +320,10 @@ ObBloomFilterCacheValue::~ObBloomFilterCacheValue()
 
 void ObBloomFilterCacheValue::reset()
 {
+  version_ = BLOOM_FILTER_CACHE_VALUE_VERSION;
   rowkey_column_cnt_ = 0;
   bloom_filter_.destroy();
+  xor_filter_.destroy();
   row_count_ = 0;
   is_inited_ = false;
 }
@@ -333,7 +336,8 @@ void ObBloomFilterCacheValue::reuse()
 
 int64_t ObBloomFilterCacheValue::size() const
 {
-  return static_cast<int64_t>(sizeof(*this) + bloom_filter_.get_deep_copy_size());
+  return static_cast<int64_t>(sizeof(*this) + bloom_filter_.get_deep_copy_size()
+                              + xor_filter_.get_deep_copy_size());
 }
 
 int ObBloomFilterCacheValue::deep_copy(ObBloomFilterCacheValue &bf_cache_value) const
@@ -345,9 +349,14 @@ int ObBloomFilterCacheValue::deep_copy(ObBloomFilterCacheValue &bf_cache_value)
     STORAGE_LOG(WARN, "The bloom filter cache value is not valid", K(*this), K(ret));
   } else {
     bf_cache_value.reset();
-    if (OB_FAIL(bf_cache_value.bloom_filter_.deep_copy(bloom_filter_))) {
+    if (is_xor_filter()) {
+      if (OB_FAIL(bf_cache_value.xor_filter_.deep_copy(xor_filter_))) {
+        STORAGE_LOG(WARN, "Fail to deep copy xor filter cache value", K(ret));
+      }
+    } else if (OB_FAIL(bf_cache_value.bloom_filter_.deep_copy(bloom_filter_))) {
       STORAGE_LOG(WARN, "Fail to deep copy bloom filter cache value", K(ret));
-    } else {
+    }
+    if (OB_SUCC(ret)) {
       bf_cache_value.version_ = version_;
       bf_cache_value.rowkey_column_cnt_ = rowkey_column_cnt_;
       bf_cache_value.row_count_ = row_count_;
@@ -370,9 +379,14 @@ int ObBloomFilterCacheValue::deep_copy(char *buf, const int64_t buf_len, common:
     STORAGE_LOG(WARN, "The bloom filter cache value is not valid, ", K(*this), K(ret));
   } else {
     ObBloomFilterCacheValue *bfcache_value = new (buf) ObBloomFilterCacheValue();
-    if (OB_FAIL(bfcache_value->bloom_filter_.deep_copy(bloom_filter_, buf + sizeof(*bfcache_value)))) {
+    if (is_xor_filter()) {
+      if (OB_FAIL(bfcache_value->xor_filter_.deep_copy(xor_filter_, buf + sizeof(*bfcache_value)))) {
+        STORAGE_LOG(WARN, "Fail to deep copy xor filter cache value, ", K(ret));
+      }
+    } else if (OB_FAIL(bfcache_value->bloom_filter_.deep_copy(bloom_filter_, buf + sizeof(*bfcache_value)))) {
       STORAGE_LOG(WARN, "Fail to deep copy bloom filter cache value, ", K(ret));
-    } else {
+    }
+    if (OB_SUCC(ret)) {
       bfcache_value->version_ = version_;
       bfcache_value->rowkey_column_cnt_ = rowkey_column_cnt_;
       bfcache_value->row_count_ = row_count_;
@@ -403,12 +417,40 @@ int ObBloomFilterCacheValue::init(const int64_t rowkey_column_cnt, const int64_t
   return ret;
 }
 
+int ObBloomFilterCacheValue::init_with_xor_filter(
+    const int64_t rowkey_column_cnt,
+    uint64_t *hashes,
+    const int64_t count)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(rowkey_column_cnt <= 0 || nullptr == hashes || count <= 0 || count > INT32_MAX)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "Invalid argument, ", K(rowkey_column_cnt), KP(hashes), K(count), K(ret));
+  } else if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    STORAGE_LOG(WARN, "The bloom filter cache value has been inited, ", K(ret));
+  } else if (OB_FAIL(xor_filter_.init(hashes, count))) {
+    if (OB_NOT_SUPPORTED != ret) {
+      STORAGE_LOG(WARN, "Fail to init xor filter, ", K(count), K(ret));
+    }
+  } else {
+    version_ = XOR_FILTER_CACHE_VALUE_VERSION;
+    rowkey_column_cnt_ = static_cast<int16_t>(rowkey_column_cnt);
+    row_count_ = static_cast<int32_t>(count);
+    is_inited_ = true;
+  }
+  return ret;
+}
+
 int ObBloomFilterCacheValue::insert(const uint32_t hash)
 {
   int ret = OB_SUCCESS;
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
     STORAGE_LOG(WARN, "The bloom filter cache value has not been inited, ", K(ret));
+  } else if (OB_UNLIKELY(is_xor_filter())) {
+    ret = OB_NOT_SUPPORTED;
+    STORAGE_LOG(WARN, "Xor filter can not be inserted into, ", K(ret));
   } else if (OB_FAIL(bloom_filter_.insert(hash))) {
     STORAGE_LOG(WARN, "Fail to insert rowkey to bloom filter, ", K(hash), K(ret));
   } else {
@@ -417,19 +459,42 @@ int ObBloomFilterCacheValue::insert(const uint32_t hash)
   return ret;
 }
 
-int ObBloomFilterCacheValue::may_contain(const uint32_t hash, bool &is_contain) const
+int ObBloomFilterCacheValue::may_contain(const uint64_t hash, bool &is_contain) const
 {
   int ret = OB_SUCCESS;
   is_contain = true;
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
     STORAGE_LOG(WARN, "The bloom filter cache value has not been inited, ", K(ret));
-  } else if (OB_FAIL(bloom_filter_.may_contain(hash, is_contain))) {
+  } else if (is_xor_filter()) {
+    is_contain = xor_filter_.may_contain(hash);
+  } else if (OB_FAIL(bloom_filter_.may_contain(static_cast<uint32_t>(hash), is_contain))) {
     STORAGE_LOG(WARN, "The bloom filter judge failed, ", K(ret));
   }
   return ret;
 }
 
+int ObBloomFilterCacheValue::may_contain(const uint64_t *hashes, const int64_t count, bool *is_contain) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "The bloom filter cache value has not been inited, ", K(ret));
+  } else if (OB_UNLIKELY(nullptr == hashes || nullptr == is_contain || count < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "Invalid argument, ", KP(hashes), KP(is_contain), K(count), K(ret));
+  } else if (is_xor_filter()) {
+    xor_filter_.may_contain(hashes, count, is_contain);
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < count; ++i) {
+      if (OB_FAIL(bloom_filter_.may_contain(static_cast<uint32_t>(hashes[i]), is_contain[i]))) {
+        STORAGE_LOG(WARN, "The bloom filter judge failed, ", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
 bool ObBloomFilterCacheValue::is_valid() const
 {
   return is_inited_ && rowkey_column_cnt_ > 0;
@@ -441,6 +506,7 @@ bool ObBloomFilterCacheValue::could_merge_bloom_filter(const ObBloomFilterCacheV
 
   if (OB_UNLIKELY(!is_valid() || !bf_cache_value.is_valid())) {
   } else if (bf_cache_value.version_ != version_ || bf_cache_value.rowkey_column_cnt_ != rowkey_column_cnt_) {
+  } else if (is_xor_filter()) {
   } else if (bf_cache_value.bloom_filter_.get_nhash() != bloom_filter_.get_nhash()
           || bf_cache_value.bloom_filter_.get_nbit() != bloom_filter_.get_nbit()) {
   } else {
@@ -493,6 +559,10 @@ DEFINE_SERIALIZE(ObBloomFilterCacheValue)
     STORAGE_LOG(WARN, "Failed to encode rowkey column cnt", K(buf_len), K(pos), K_(rowkey_column_cnt), K(ret));
   } else if (OB_FAIL(serialization::encode_vi32(buf, buf_len, pos, row_count_))) {
     STORAGE_LOG(WARN, "Failed to encode row cnt", K(buf_len), K(pos), K_(row_count), K(ret));
+  } else if (is_xor_filter()) {
+    if (OB_FAIL(xor_filter_.serialize(buf, buf_len, pos))) {
+      STORAGE_LOG(WARN, "Failed to serialize xor_filter", K(buf_len), K(pos), K(ret));
+    }
   } else if (OB_FAIL(bloom_filter_.serialize(buf, buf_len, pos))) {
     STORAGE_LOG(WARN, "Failed to serialize bloom_filter", K(buf_len), K(pos), K(ret));
   }
@@ -512,6 +582,10 @@ DEFINE_DESERIALIZE(ObBloomFilterCacheValue)
     reset();
     if (OB_FAIL(serialization::decode_i16(buf, data_len, pos, &version_))) {
       STORAGE_LOG(WARN, "Failed to decode version", K(data_len), K(pos), K(ret));
+    } else if (OB_UNLIKELY(BLOOM_FILTER_CACHE_VALUE_VERSION != version_
+                           && XOR_FILTER_CACHE_VALUE_VERSION != version_)) {
+      ret = OB_NOT_SUPPORTED;
+      STORAGE_LOG(WARN, "Unexpected bloomfilter cache version", K_(version), K(ret));
     } else if (OB_FAIL(serialization::decode_i16(buf, data_len, pos, &rowkey_column_cnt_))) {
       STORAGE_LOG(WARN, "Failed to decode rowkey column cnt", K(data_len), K(pos), K(ret));
     } else if (rowkey_column_cnt_ <= 0) {
@@ -519,6 +593,12 @@ DEFINE_DESERIALIZE(ObBloomFilterCacheValue)
       STORAGE_LOG(WARN, "Unexpected deserialize rowkey column cnt", K_(rowkey_column_cnt), K(ret));
     } else if (OB_FAIL(serialization::decode_vi32(buf, data_len, pos, &row_count_))) {
       STORAGE_LOG(WARN, "Failed to decode row cnt", K(data_len), K(pos), K(ret));
+    } else if (is_xor_filter()) {
+      if (OB_FAIL(xor_filter_.deserialize(buf, data_len, pos))) {
+        STORAGE_LOG(WARN, "Failed to deserialize xor_filter", K(data_len), K(pos), K(ret));
+      } else {
+        is_inited_ = true;
+      }
     } else if (OB_FAIL(bloom_filter_.deserialize(buf, data_len, pos))) {
       STORAGE_LOG(WARN, "Failed to deserialize bloom_filter", K(data_len), K(pos), K(ret));
     } else {
@@ -531,7 +611,7 @@ DEFINE_DESERIALIZE(ObBloomFilterCacheValue)
 
 DEFINE_GET_SERIALIZE_SIZE(ObBloomFilterCacheValue)
 {
-  return bloom_filter_.get_serialize_size()
+  return (is_xor_filter() ? xor_filter_.get_serialize_size() : bloom_filter_.get_serialize_size())
        + serialization::encoded_length_i16(version_)
        + serialization::encoded_length_i16(rowkey_column_cnt_)
        + serialization::encoded_length_vi32(row_count_);
@@ -614,7 +694,7 @@ int ObBloomFilterCache::may_contain(
       STORAGE_LOG(WARN, "Unexpected error, the bf_value is NULL, ", K(ret));
     } else if (OB_FAIL(rowkey.murmurhash(0, datum_utils, key_hash))) {
       STORAGE_LOG(WARN, "Failed to calc rowkey hash", K(ret), K(rowkey));
-    } else if (OB_FAIL(bf_value->may_contain(static_cast<uint32_t>(key_hash), is_contain))) {
+    } else if (OB_FAIL(bf_value->may_contain(key_hash, is_contain))) {
       STORAGE_LOG(WARN, "Fail to check rowkey exist from bloom filter, ", K(ret));
     } else {
       STORAGE_LOG(DEBUG, "debug bloom_filter may contain", K(ret), KP(bf_value), K(key_hash), K(is_contain), K(rowkey));
@@ -643,7 +723,6 @@ int ObBloomFilterCache::may_contain(
   ObBloomFilterCacheKey bf_key(tenant_id, macro_block_id, static_cast<int8_t>(my_rows_info->get_datum_cnt()));
   const ObBloomFilterCacheValue *bf_value = NULL;
   ObKVCacheHandle handle;
-  uint64_t key_hash = 0;
   if (OB_UNLIKELY(!bf_key.is_valid())) {
     ret = OB_INVALID_ARGUMENT;
     STORAGE_LOG(WARN, "Invalid argument", K(bf_key), K(ret));
@@ -660,26 +739,39 @@ int ObBloomFilterCache::may_contain(
       ret = OB_ERR_UNEXPECTED;
       STORAGE_LOG(WARN, "Unexpected null bf value", K(ret));
     } else {
-      for (int64_t i = rowkey_begin_idx; OB_SUCC(ret) && i < rowkey_end_idx; ++i) {
-        bool tmp_contain = false;
-        const ObDatumRowkey &rowkey = rows_info->get_rowkey(i);
-        if (rows_info->is_row_skipped(i)) {
-          continue;
-        } else if (OB_FAIL(rowkey.murmurhash(0, datum_utils, key_hash))) {
-          STORAGE_LOG(WARN, "Failed to calc rowkey hash", K(ret), K(rowkey));
-        } else if (OB_FAIL(bf_value->may_contain(static_cast<uint32_t>(key_hash), tmp_contain))) {
+      // rowkeys are hashed and probed in batches, to overlap the memory accesses of the probes
+      uint64_t key_hashes[MAX_BATCH_PROBE_CNT];
+      int64_t rowkey_idxs[MAX_BATCH_PROBE_CNT];
+      bool is_contains[MAX_BATCH_PROBE_CNT];
+      int64_t i = rowkey_begin_idx;
+      while (OB_SUCC(ret) && i < rowkey_end_idx) {
+        int64_t batch_cnt = 0;
+        for (; OB_SUCC(ret) && i < rowkey_end_idx && batch_cnt < MAX_BATCH_PROBE_CNT; ++i) {
+          const ObDatumRowkey &rowkey = rows_info->get_rowkey(i);
+          if (rows_info->is_row_skipped(i)) {
+          } else if (OB_FAIL(rowkey.murmurhash(0, datum_utils, key_hashes[batch_cnt]))) {
+            STORAGE_LOG(WARN, "Failed to calc rowkey hash", K(ret), K(rowkey));
+          } else {
+            rowkey_idxs[batch_cnt++] = i;
+          }
+        }
+        if (OB_FAIL(ret) || 0 == batch_cnt) {
+        } else if (OB_FAIL(bf_value->may_contain(key_hashes, batch_cnt, is_contains))) {
           STORAGE_LOG(WARN, "Fail to check rowkey exist from bloom filter, ", K(ret));
         } else {
-          if (tmp_contain) {
-            is_contain = true;
-            EVENT_INC(ObStatEventIds::BLOOM_FILTER_PASSES);
-          } else {
-            if (!my_rows_info->is_row_bf_checked(i)) {
-              my_rows_info->set_row_non_existent(i);
+          for (int64_t j = 0; j < batch_cnt; ++j) {
+            const int64_t rowkey_idx = rowkey_idxs[j];
+            if (is_contains[j]) {
+              is_contain = true;
+              EVENT_INC(ObStatEventIds::BLOOM_FILTER_PASSES);
+            } else {
+              if (!my_rows_info->is_row_bf_checked(rowkey_idx)) {
+                my_rows_info->set_row_non_existent(rowkey_idx);
+              }
+              EVENT_INC(ObStatEventIds::BLOOM_FILTER_FILTS);
             }
-            EVENT_INC(ObStatEventIds::BLOOM_FILTER_FILTS);
+            my_rows_info->set_row_bf_checked(rowkey_idx);
           }
-          my_rows_info->set_row_bf_checked(i);
         }
       }
     }
@@ -807,7 +899,8 @@ void ObBloomFilterCache::destroy()
  */
 
 ObMacroBloomFilterCacheWriter::ObMacroBloomFilterCacheWriter()
-  : bf_cache_value_(),
+  : hashs_(),
+    rowkey_column_count_(0),
     max_row_count_(0),
     need_build_(false),
     is_inited_(false)
@@ -818,13 +911,18 @@ ObMacroBloomFilterCacheWriter::~ObMacroBloomFilterCacheWriter()
 {
 }
 
-int ObMacroBloomFilterCacheWriter::init(const int64_t rowkey_column_count, const int64_t row_count)
+int ObMacroBloomFilterCacheWriter::init(const int64_t rowkey_column_count, const int64_t max_row_count)
 {
   int ret = OB_SUCCESS;
-  max_row_count_ = row_count + row_count / 16;
-  if (OB_FAIL(bf_cache_value_.init(rowkey_column_count, max_row_count_))) {
-    STORAGE_LOG(WARN, "blolomfilter cache value init failed, ", K(ret));
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    STORAGE_LOG(WARN, "ObMacroBloomFilterCacheWriter has been inited", K(ret));
+  } else if (OB_UNLIKELY(rowkey_column_count <= 0 || max_row_count <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "Invalid argument, ", K(rowkey_column_count), K(max_row_count), K(ret));
   } else {
+    rowkey_column_count_ = rowkey_column_count;
+    max_row_count_ = max_row_count;
     need_build_ = true;
     is_inited_ = true;
   }
@@ -833,7 +931,8 @@ int ObMacroBloomFilterCacheWriter::init(const int64_t rowkey_column_count, const
 
 void ObMacroBloomFilterCacheWriter::reset()
 {
-  bf_cache_value_.reset();
+  hashs_.reset();
+  rowkey_column_count_ = 0;
   max_row_count_ = 0;
   need_build_ = false;
   is_inited_ = false;
@@ -842,88 +941,60 @@ void ObMacroBloomFilterCacheWriter::reset()
 void ObMacroBloomFilterCacheWriter::reuse()
 {
   if (is_inited_) {
-    bf_cache_value_.reuse();
+    hashs_.reuse();
     need_build_ = true;
   }
 }
 
 void ObMacroBloomFilterCacheWriter::set_not_need_build()
 {
-  bf_cache_value_.reuse();
+  hashs_.reuse();
   need_build_ = false;
 }
 
-int ObMacroBloomFilterCacheWriter::append(const common::ObArray<uint32_t> &hashs)
+int ObMacroBloomFilterCacheWriter::append(const common::ObIArray<uint64_t> &hashs)
 {
   int ret = OB_SUCCESS;
   if (IS_NOT_INIT) {
     ret = OB_NOT_INIT;
     STORAGE_LOG(WARN, "ObMacroBloomFilterCacheWriter not init", K(ret));
   } else if (!need_build_) {
-    ret = OB_NOT_SUPPORTED;
-    STORAGE_LOG(WARN, "Not need build bloomfilter, ", K_(need_build), K(ret));
+    // skip
   } else if (get_row_count() + hashs.count() > max_row_count_) {
-    ret = OB_NOT_SUPPORTED;
-    STORAGE_LOG(INFO, "Bloomfilter is full, ", K_(max_row_count), K(get_row_count()), K(hashs.count()));
-    bf_cache_value_.reuse();
-    need_build_ = false;
+    STORAGE_LOG(DEBUG, "Too many rows to build xor filter, ", K_(max_row_count), K(get_row_count()), K(hashs.count()));
+    set_not_need_build();
   } else {
-    for (int i = 0; OB_SUCC(ret) && i < hashs.count(); ++i) {
-      if (OB_FAIL(bf_cache_value_.insert(hashs.at(i)))) {
-        bf_cache_value_.reuse();
-        need_build_ = false;
-        STORAGE_LOG(WARN, "bloomfilter insert hash value failed, ", K(i), K(hashs.at(i)), K(ret));
+    for (int64_t i = 0; OB_SUCC(ret) && i < hashs.count(); ++i) {
+      if (OB_FAIL(hashs_.push_back(hashs.at(i)))) {
+        STORAGE_LOG(WARN, "Fail to push back rowkey hash, ", K(i), K(ret));
+        set_not_need_build();
       }
     }
   }
   return ret;
 }
 
-bool ObMacroBloomFilterCacheWriter::can_merge(const ObMacroBloomFilterCacheWriter &other)
-{
-  bool bret = false;
-  if (OB_UNLIKELY(!is_valid() || !other.is_valid())) {
-  } else if (!is_need_build() || !other.is_need_build()) {
-  } else if (get_row_count() + other.get_row_count() > max_row_count_) {
-  } else {
-    bret = true;
-  }
-  return bret;
-}
-
-int ObMacroBloomFilterCacheWriter::merge(const ObMacroBloomFilterCacheWriter &other)
-{
-  int ret = OB_SUCCESS;
-  if (OB_UNLIKELY(!is_valid() || !other.is_valid())) {
-    ret = OB_INVALID_ARGUMENT;
-    STORAGE_LOG(WARN, "Cache writer not valid, ", K(*this), K(other), K(ret));
-  } else if (!need_build_ || !other.is_need_build()) {
-    //not need build
-  } else if (get_row_count() + other.get_row_count() > max_row_count_) {
-    ret = OB_NOT_SUPPORTED;
-    STORAGE_LOG(WARN, "Exceed bloomfilter cache writer max count, ", K(*this), K(other), K(ret));
-  } else if (!bf_cache_value_.could_merge_bloom_filter(other.bf_cache_value_)) {
-    ret = OB_NOT_SUPPORTED;
-    STORAGE_LOG(WARN, "Can not merge bloomfilter cache value, ", K(*this), K(other), K(ret));
-  } else if (OB_FAIL(bf_cache_value_.merge_bloom_filter(other.bf_cache_value_))) {
-    STORAGE_LOG(WARN, "Failed to merge bloomfilter cache value, ", K(*this), K(other), K(ret));
-  }
-  return ret;
-}
-
 int ObMacroBloomFilterCacheWriter::flush_to_cache(
     const uint64_t tenant_id,
     const MacroBlockId& macro_id)
 {
   int ret = OB_SUCCESS;
-  if (OB_UNLIKELY(!macro_id.is_valid() || !is_valid())) {
+  ObBloomFilterCacheValue bf_cache_value;
+  if (OB_UNLIKELY(!macro_id.is_valid())) {
     ret = OB_INVALID_ARGUMENT;
-    STORAGE_LOG(ERROR, "invalid argument,", K(ret), K(macro_id), K(*this));
-  } else if (need_build_
-      && OB_FAIL(ObStorageCacheSuite::get_instance().get_bf_cache().put_bloom_filter(
-          tenant_id, macro_id, bf_cache_value_))) {
+    STORAGE_LOG(WARN, "invalid argument,", K(ret), K(macro_id), K(*this));
+  } else if (!is_need_build() || hashs_.empty()) {
+    // skip
+  } else if (OB_FAIL(bf_cache_value.init_with_xor_filter(rowkey_column_count_, &hashs_.at(0), hashs_.count()))) {
+    if (OB_NOT_SUPPORTED == ret) {
+      ret = OB_SUCCESS;
+    } else {
+      STORAGE_LOG(WARN, "Fail to build xor filter", K(ret), K(*this));
+    }
+  } else if (OB_FAIL(ObStorageCacheSuite::get_instance().get_bf_cache().put_bloom_filter(
+      tenant_id, macro_id, bf_cache_value))) {
     STORAGE_LOG(WARN, "Fail to put value to bloom filter cache",
-                K(tenant_id), K(macro_id), K_(bf_cache_value), K(ret));
+                K(tenant_id), K(macro_id), K(bf_cache_value), K(ret));
   }
   return ret;
 }
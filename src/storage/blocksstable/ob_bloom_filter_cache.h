@@ -15,6 +15,7 @@
 
 #include "share/config/ob_server_config.h"
 #include "storage/blocksstable/ob_block_sstable_struct.h"
+#include "storage/blocksstable/ob_xor_filter.h"
 #include "storage/ob_i_table.h"
 
 namespace oceanbase
@@ -81,10 +82,13 @@ private:
 
 //TODO @hanhui we need refactor bloomfilter with new hash insert method
 // there is no need to use template with bloomfilter
+// Holds either a bloom filter, which is built by inserting hashes one by one, or a xor filter,
+// which is built from all hashes at once by init_with_xor_filter.
 class ObBloomFilterCacheValue : public common::ObIKVCacheValue
 {
 public:
   static const int64_t BLOOM_FILTER_CACHE_VALUE_VERSION = 1;
+  static const int64_t XOR_FILTER_CACHE_VALUE_VERSION = 2;
   ObBloomFilterCacheValue();
   virtual ~ObBloomFilterCacheValue();
   void reset();
@@ -93,9 +97,13 @@ public:
   virtual int deep_copy(char *buf, const int64_t buf_len, common::ObIKVCacheValue *&value) const;
   virtual int deep_copy(ObBloomFilterCacheValue &bf_cache_value) const;
   int init(const int64_t rowkey_column_cnt, const int64_t row_cnt);
+  // %hashes are sorted and deduplicated in place
+  int init_with_xor_filter(const int64_t rowkey_column_cnt, uint64_t *hashes, const int64_t count);
   int insert(const uint32_t hash);
-  int may_contain(const uint32_t hash, bool &is_contain) const;
+  int may_contain(const uint64_t hash, bool &is_contain) const;
+  int may_contain(const uint64_t *hashes, const int64_t count, bool *is_contain) const;
   bool is_valid() const;
+  inline bool is_xor_filter() const { return XOR_FILTER_CACHE_VALUE_VERSION == version_; }
   inline bool is_empty() const { return 0 == row_count_; }
   inline int64_t get_prefix_len() const { return rowkey_column_cnt_; }
   bool could_merge_bloom_filter(const ObBloomFilterCacheValue &bf_cache_value) const;
@@ -105,7 +113,9 @@ public:
   OB_INLINE int64_t get_nhash() const { return bloom_filter_.get_nhash(); }
   OB_INLINE int64_t get_nbit() const { return bloom_filter_.get_nbit(); }
   OB_INLINE int64_t get_nbytes() const { return bloom_filter_.get_nbytes(); }
-  TO_STRING_KV(K_(version), K_(rowkey_column_cnt), K_(row_count), K_(bloom_filter), K_(is_inited));
+  TO_STRING_KV(K_(version), K_(rowkey_column_cnt), K_(row_count), K_(bloom_filter), K_(xor_filter), K_(is_inited));
+  // serialize is hand written without the unis version header, the leading version_ tells which
+  // filter follows, and the versions not known are rejected by deserialize
   OB_UNIS_VERSION(BLOOM_FILTER_CACHE_VALUE_VERSION);
 private:
   int16_t version_;
@@ -113,6 +123,7 @@ private:
   int16_t rowkey_column_cnt_;
   int32_t row_count_;
   ObBloomFilter bloom_filter_;
+  ObXorFilter xor_filter_;
   bool is_inited_;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObBloomFilterCacheValue);
@@ -213,6 +224,7 @@ public:
 
 private:
   static const int64_t BF_BUILD_SPEED_SHIFT = 4;
+  static const int64_t MAX_BATCH_PROBE_CNT = 64;
   static const int64_t DEFAULT_EMPTY_READ_CNT_THRESHOLD = 100;
   static const int64_t MAX_EMPTY_READ_CNT_THRESHOLD = 1000000;
   volatile int64_t bf_cache_miss_count_threshold_;
@@ -234,26 +246,28 @@ inline int ObBloomFilterCache::set_bf_cache_miss_count_threshold(const int64_t t
   return ret;
 }
 
+// Collects rowkey hashes of the macro block being written, and puts a xor filter built from
+// them to the bloom filter cache when the macro block is flushed, so that point reads of newly
+// written macro blocks could be filtered without waiting for empty reads to trigger the build.
 class ObMacroBloomFilterCacheWriter
 {
 public:
   ObMacroBloomFilterCacheWriter();
   virtual ~ObMacroBloomFilterCacheWriter();
-  int init(const int64_t rowkey_column_count, const int64_t row_count);
+  int init(const int64_t rowkey_column_count, const int64_t max_row_count);
   void reset();
   void reuse();
   void set_not_need_build();
-  int append(const common::ObArray<uint32_t> &hashs);
-  bool can_merge(const ObMacroBloomFilterCacheWriter &other);
-  int merge(const ObMacroBloomFilterCacheWriter &other);
+  int append(const common::ObIArray<uint64_t> &hashs);
   int flush_to_cache(const uint64_t tenant_id, const MacroBlockId& macro_id);
+  OB_INLINE bool is_inited() const { return is_inited_; }
   OB_INLINE bool is_need_build() const { return is_inited_ && need_build_; }
-  OB_INLINE bool is_valid() const { return is_inited_ && bf_cache_value_.is_valid(); }
-  OB_INLINE int32_t get_row_count() const { return bf_cache_value_.get_row_count(); }
-  OB_INLINE int64_t get_rowkey_column_count() const { return bf_cache_value_.get_prefix_len(); }
-  TO_STRING_KV(K_(is_inited), K_(need_build), K_(max_row_count), K_(bf_cache_value));
+  OB_INLINE int64_t get_row_count() const { return hashs_.count(); }
+  OB_INLINE int64_t get_rowkey_column_count() const { return rowkey_column_count_; }
+  TO_STRING_KV(K_(is_inited), K_(need_build), K_(rowkey_column_count), K_(max_row_count), "row_count", hashs_.count());
 private:
-  ObBloomFilterCacheValue bf_cache_value_;
+  common::ObArray<uint64_t> hashs_;
+  int64_t rowkey_column_count_;
   int64_t max_row_count_;
   bool need_build_;
   bool is_inited_;
@@ -508,6 +508,8 @@ int ObMacroBlockWriter::open(
       STORAGE_LOG(WARN, "Failed to init reader helper", K(ret));
     } else if (OB_FAIL(init_pre_agg_util(data_store_desc))) {
       STORAGE_LOG(WARN, "Failed to init pre aggregate utilities", K(ret));
+    } else if (OB_FAIL(open_bf_cache_writer(data_store_desc, MAX_BF_CACHE_ROW_COUNT))) {
+      STORAGE_LOG(WARN, "Failed to open bloom filter cache writer", K(ret));
     } else {
       //TODO  use 4.1.0.0 for version judgment
       const bool is_use_adaptive = !data_store_desc_->is_major_merge_type()
@@ -662,6 +664,8 @@ int ObMacroBlockWriter::append_row(const ObDatumRow &row, const int64_t split_si
       STORAGE_LOG(WARN, "Fail to update_micro_commit_info", K(ret), K(row));
     } else if (OB_FAIL(save_last_key(*row_to_append))) {
       STORAGE_LOG(WARN, "Fail to save last key, ", K(ret), K(row));
+    } else if (bf_cache_writer_[0].is_inited() && OB_FAIL(collect_rowkey_hash(*row_to_append))) {
+      STORAGE_LOG(WARN, "Fail to collect rowkey hash, ", K(ret), K(row));
     } else if (nullptr != data_aggregator_ && OB_FAIL(data_aggregator_->eval(*row_to_append))) {
       STORAGE_LOG(WARN, "Fail to evaluate aggregate data", K(ret));
     } else if (OB_FAIL(micro_block_adaptive_splitter_.check_need_split(micro_writer_->get_block_size(), micro_writer_->get_row_count(),
@@ -721,8 +725,12 @@ int ObMacroBlockWriter::append_micro_block(const ObMicroBlock &micro_block, cons
         STORAGE_LOG(WARN, "Failed to eval aggregated data from reused micro block", K(ret));
       } else if (OB_FAIL(write_micro_block(micro_block_desc))) {
         STORAGE_LOG(WARN, "Failed to write micro block, ", K(ret), K(micro_block_desc));
-      } else if (NULL != merge_info_) {
-        merge_info_->multiplexed_micro_count_in_new_macro_++;
+      } else {
+        // rowkeys of reused micro block are unknown
+        bf_cache_writer_[current_index_].set_not_need_build();
+        if (NULL != merge_info_) {
+          merge_info_->multiplexed_micro_count_in_new_macro_++;
+        }
       }
 
       if (OB_SUCC(ret) && nullptr != data_aggregator_) {
@@ -759,8 +767,11 @@ int ObMacroBlockWriter::append_micro_block(
     STORAGE_LOG(WARN, "fail to aggregate micro block", K(ret), K(micro_index_info));
   } else if (OB_FAIL(write_micro_block(micro_block_desc))) {
     STORAGE_LOG(WARN, "fail to write micro block", K(ret), K(micro_block_desc));
-  } else if (nullptr != data_aggregator_) {
-    data_aggregator_->reuse();
+  } else {
+    bf_cache_writer_[current_index_].set_not_need_build();
+    if (nullptr != data_aggregator_) {
+      data_aggregator_->reuse();
+    }
   }
   return ret;
 }
@@ -1063,6 +1074,10 @@ int ObMacroBlockWriter::build_micro_block()
       } else if (OB_FAIL(micro_block_adaptive_splitter_.update_compression_info(micro_block_desc.row_count_,
           block_size, micro_block_desc.buf_size_))) {
         STORAGE_LOG(WARN, "Fail to update_compression_info", K(ret), K(micro_block_desc));
+      } else {
+        // the micro block may be written to a new macro block after switch
+        (void) bf_cache_writer_[current_index_].append(micro_rowkey_hashs_);
+        micro_rowkey_hashs_.reuse();
       }
       if (OB_FAIL(ret) || !data_block_pre_warmer_.is_valid() || OB_TMP_FAIL(tmp_ret)) {
       } else if (OB_TMP_FAIL(data_block_pre_warmer_.update_and_put_kvpair(micro_block_desc))) {
@@ -1342,6 +1357,7 @@ int ObMacroBlockWriter::try_active_flush_macro_block()
 int ObMacroBlockWriter::flush_macro_block(ObMacroBlock &macro_block)
 {
   int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
   ObLogicMacroBlockId cur_logic_id;
   cur_logic_id.logic_version_ = data_store_desc_->get_logical_version();
   cur_logic_id.column_group_idx_ = data_store_desc_->get_table_cg_idx();
@@ -1374,6 +1390,12 @@ int ObMacroBlockWriter::flush_macro_block(ObMacroBlock &macro_block)
     if (nullptr != callback_) {
       DEBUG_SYNC(AFTER_DDL_WRITE_MACRO_BLOCK);
     }
+    ObMacroBloomFilterCacheWriter &bf_cache_writer = bf_cache_writer_[current_index_];
+    if (bf_cache_writer.is_need_build()
+        && OB_TMP_FAIL(bf_cache_writer.flush_to_cache(MTL_ID(), macro_handle.get_macro_id()))) {
+      STORAGE_LOG(WARN, "Fail to flush bloom filter to cache", K(tmp_ret), K(bf_cache_writer));
+    }
+    bf_cache_writer.reuse();
     ++current_macro_seq_;
     const int64_t current_macro_seq = is_need_macro_buffer_ ? current_macro_seq_ + 1 :
         current_macro_seq_;
@@ -1731,11 +1753,37 @@ int ObMacroBlockWriter::build_micro_writer(const ObDataStoreDesc *data_store_des
 
 int ObMacroBlockWriter::open_bf_cache_writer(
     const ObDataStoreDesc &desc,
-    const int64_t bloomfilter_size)
+    const int64_t max_row_count)
 {
   int ret = OB_SUCCESS;
   bf_cache_writer_[0].reset();
   bf_cache_writer_[1].reset();
+  micro_rowkey_hashs_.reuse();
+  if (desc.is_cg() || OB_ISNULL(desc.sstable_index_builder_)) {
+    // only build for rowkeys of data macro blocks
+  } else if (!GCONF._enable_macro_block_xor_filter || 0 == GCONF.bf_cache_miss_count_threshold) {
+  } else if (OB_FAIL(bf_cache_writer_[0].init(desc.get_schema_rowkey_col_cnt(), max_row_count))) {
+    STORAGE_LOG(WARN, "Fail to init bloom filter cache writer", K(ret));
+  } else if (OB_FAIL(bf_cache_writer_[1].init(desc.get_schema_rowkey_col_cnt(), max_row_count))) {
+    STORAGE_LOG(WARN, "Fail to init bloom filter cache writer", K(ret));
+  }
+  return ret;
+}
+
+int ObMacroBlockWriter::collect_rowkey_hash(const ObDatumRow &row)
+{
+  int ret = OB_SUCCESS;
+  ObDatumRowkey rowkey;
+  uint64_t hash = 0;
+  if (OB_FAIL(rowkey.assign(row.storage_datums_, data_store_desc_->get_schema_rowkey_col_cnt()))) {
+    STORAGE_LOG(WARN, "Failed to assign rowkey", K(ret), K(row));
+  } else if (OB_FAIL(rowkey.murmurhash(0, data_store_desc_->get_datum_utils(), hash))) {
+    STORAGE_LOG(WARN, "Failed to calc rowkey hash", K(ret), K(rowkey));
+  } else if (!micro_rowkey_hashs_.empty() && hash == micro_rowkey_hashs_.at(micro_rowkey_hashs_.count() - 1)) {
+    // multi versions of the same rowkey
+  } else if (OB_FAIL(micro_rowkey_hashs_.push_back(hash))) {
+    STORAGE_LOG(WARN, "Failed to push back rowkey hash", K(ret));
+  }
   return ret;
 }
 
@@ -208,7 +208,8 @@ private:
       ObIMicroBlockReader &reader,
       int64_t *column_checksum);
   int flush_reuse_macro_block(const ObDataMacroBlockMeta &macro_meta);
-  int open_bf_cache_writer(const ObDataStoreDesc &desc, const int64_t bloomfilter_size);
+  int open_bf_cache_writer(const ObDataStoreDesc &desc, const int64_t max_row_count);
+  int collect_rowkey_hash(const ObDatumRow &row);
   int update_micro_commit_info(const ObDatumRow &row);
   void dump_micro_block(ObIMicroBlockWriter &micro_writer);
   void dump_macro_block(ObMacroBlock &macro_block);
@@ -217,6 +218,7 @@ public:
 private:
   static const int64_t DEFAULT_MACRO_BLOCK_COUNT = 128;
   static const int64_t DEFAULT_MINIMUM_CS_ENCODING_BLOCK_SIZE = 16 << 10; // 16KB
+  static const int64_t MAX_BF_CACHE_ROW_COUNT = 256L * 1024L; // per macro block
   typedef common::ObSEArray<MacroBlockId, DEFAULT_MACRO_BLOCK_COUNT> MacroBlockList;
 
 protected:
@@ -244,7 +246,7 @@ private:
   compaction::ObLocalArena allocator_;
   compaction::ObLocalArena rowkey_allocator_;
   blocksstable::ObMacroBlockReader macro_reader_;
-  common::ObArray<uint32_t> micro_rowkey_hashs_;
+  common::ObArray<uint64_t> micro_rowkey_hashs_;
   common::SpinRWLock lock_;
   blocksstable::ObDatumRow datum_row_;
   blocksstable::ObDatumRow *aggregated_row_;
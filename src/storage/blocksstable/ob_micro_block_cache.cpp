@@ -19,6 +19,7 @@
 #include "storage/blocksstable/ob_macro_block_handle.h"
 #include "storage/blocksstable/ob_shared_macro_block_manager.h"
 #include "storage/blocksstable/cs_encoding/ob_cs_micro_block_transformer.h"
+#include "storage/blocksstable/ob_micro_block_disk_cache.h"
 
 namespace oceanbase
 {
@@ -115,7 +116,11 @@ int ObMicroBlockCacheKey::deep_copy(char *buf, const int64_t buf_len, ObIKVCache
 /**
  * -----------------------------------------------------ObMicroBlockCacheValue--------------------------------------------------
  */
-ObMicroBlockCacheValue::ObMicroBlockCacheValue() : block_data_(), alloc_by_block_io_(false)
+ObMicroBlockCacheValue::ObMicroBlockCacheValue()
+  : block_data_(),
+    alloc_by_block_io_(false),
+    compressor_type_(INVALID_COMPRESSOR),
+    row_store_type_(MAX_ROW_STORE)
 {
 }
 
@@ -126,7 +131,9 @@ ObMicroBlockCacheValue::ObMicroBlockCacheValue(
     const int64_t extra_size /* = 0 */,
     const ObMicroBlockData::Type block_type /* = DATA_BLOCK */)
     : block_data_(buf, size, extra_buf, extra_size, block_type),
-      alloc_by_block_io_(false)
+      alloc_by_block_io_(false),
+      compressor_type_(INVALID_COMPRESSOR),
+      row_store_type_(MAX_ROW_STORE)
 {
 }
 
@@ -134,6 +141,24 @@ ObMicroBlockCacheValue::~ObMicroBlockCacheValue()
 {
 }
 
+void ObMicroBlockCacheValue::set_des_meta(const ObMicroBlockDesMeta &des_meta)
+{
+  if (des_meta.is_valid() && !des_meta.is_encrypted()) {
+    compressor_type_ = static_cast<uint8_t>(des_meta.compressor_type_);
+    row_store_type_ = static_cast<uint8_t>(des_meta.row_store_type_);
+  }
+}
+
+bool ObMicroBlockCacheValue::get_des_meta(ObMicroBlockDesMeta &des_meta) const
+{
+  des_meta.compressor_type_ = static_cast<ObCompressorType>(compressor_type_);
+  des_meta.row_store_type_ = static_cast<ObRowStoreType>(row_store_type_);
+  des_meta.encrypt_id_ = 0;
+  des_meta.master_key_id_ = 0;
+  des_meta.encrypt_key_ = nullptr;
+  return des_meta.is_valid();
+}
+
 int64_t ObMicroBlockCacheValue::size() const
 {
   return sizeof(blocksstable::ObMicroBlockCacheValue) + block_data_.total_size();
@@ -192,11 +217,15 @@ int ObMicroBlockCacheValue::deep_copy(char *buf, const int64_t buf_len, ObIKVCac
             new_buf, block_data_.get_buf_size(),
             new_buf + block_data_.get_buf_size(), block_data_.get_extra_size(), block_data_.type_);
         pvalue->alloc_by_block_io_ = alloc_by_block_io_;
+        pvalue->compressor_type_ = compressor_type_;
+        pvalue->row_store_type_ = row_store_type_;
       }
     } else {
       pvalue = new (buf) ObMicroBlockCacheValue(new_buf, block_data_.get_buf_size(),
           nullptr, 0, block_data_.type_);
       pvalue->alloc_by_block_io_ = alloc_by_block_io_;
+      pvalue->compressor_type_ = compressor_type_;
+      pvalue->row_store_type_ = row_store_type_;
     }
     value = pvalue;
   }
@@ -293,13 +322,13 @@ int ObMultiBlockIOParam::get_block_des_info(ObIMicroBlockIOCallback &io_callback
 
 void ObMultiBlockIOCtx::reset()
 {
-  micro_index_infos_ = nullptr;
+  micro_infos_ = nullptr;
   block_count_ = 0;
 }
 
 bool ObMultiBlockIOCtx::is_valid() const
 {
-  return OB_NOT_NULL(micro_index_infos_) && block_count_ > 0;
+  return OB_NOT_NULL(micro_infos_) && block_count_ > 0;
 }
 
 /*---------------------------------------ObIMicroBlockIOCallback-------------------------------------*/
@@ -373,7 +402,6 @@ int ObIMicroBlockIOCallback::process_block(
     common::ObKVCacheHandle &cache_handle)
 {
   int ret = OB_SUCCESS;
-  ObMicroBlockData block_data;
   ObMicroBlockHeader header;
   int64_t pos = 0;
   int64_t payload_size = 0;
@@ -390,8 +418,8 @@ int ObIMicroBlockIOCallback::process_block(
   } else {
     if (OB_UNLIKELY(!use_block_cache_)) {
       // Won't put in cache
-      if (OB_FAIL(read_block_and_copy(header, *reader, buffer, size, block_data, micro_block, cache_handle))) {
-        LOG_WARN("Fail to read micro block and copy to cache value", K(ret));
+      if (OB_FAIL(read_block_without_cache(header, *reader, buffer, size, micro_block, cache_handle))) {
+        LOG_WARN("Fail to read micro block without cache", K(ret));
       }
     } else {
       ObIMicroBlockCache::BaseBlockCache *kvcache = nullptr;
@@ -413,54 +441,45 @@ int ObIMicroBlockIOCallback::process_block(
   return ret;
 }
 
-int ObIMicroBlockIOCallback::read_block_and_copy(
-    const ObMicroBlockHeader &header,
+int ObIMicroBlockIOCallback::read_block_without_cache(
+    ObMicroBlockHeader &header,
     ObMacroBlockReader &reader,
     const char *buffer,
     const int64_t size,
-    ObMicroBlockData &block_data,
     const ObMicroBlockCacheValue *&micro_block,
     ObKVCacheHandle &handle)
 {
   int ret = OB_SUCCESS;
-  block_data.type_ = cache_->get_type();
+  // The block is decompressed straight into the buffer of the value, which is handed to the
+  // decoders without another copy.
   // In normal cases, full_transform is not required if not using block cache,
   // The ObMicroBlockCSDecoder can do part_transform and use the memory whose life cycle
   // is consistent with decoder. However, at present, there are cases where rows obtained from
   // index block or data block are continued to be used after decoder deconstruction,
   // so the full_transform is also done here.
-  if (ObStoreFormat::is_row_store_type_with_cs_encoding(static_cast<ObRowStoreType>(header.row_store_type_))) {
-    if (OB_FAIL(reader.decrypt_and_full_transform_data(header, block_des_meta_,
-        buffer, size, block_data.get_buf(), block_data.get_buf_size(), nullptr))) {
-      LOG_WARN("fail to decrypt_and_full_transform_data", K(ret), K(header), K_(block_des_meta));
-    }
+  ObMicroBlockBufTransformer buf_transformer(block_des_meta_, &reader, header, buffer, size);
+  int64_t block_size = 0;
+  char *buf = nullptr;
+  handle.reset();
+  micro_block = nullptr;
+  if (OB_FAIL(buf_transformer.init())) {
+    LOG_WARN("Fail to init buf transformer", K(ret), K(header), K_(block_des_meta));
+  } else if (OB_FAIL(buf_transformer.get_buf_size(block_size))) {
+    LOG_WARN("Fail to get block buf size", K(ret), K(header));
+  } else if (OB_ISNULL(buf = static_cast<char *>(allocator_->alloc(sizeof(ObMicroBlockCacheValue) + block_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("Failed to allocate value", K(ret), K(block_size));
   } else {
-    bool is_compressed = false;
-    if (OB_FAIL(reader.do_decrypt_and_decompress_data(
-        header, block_des_meta_, buffer, size,
-        block_data.get_buf(), block_data.get_buf_size(),
-        is_compressed, false/*need deep copy*/, nullptr))) {
-      LOG_WARN("fail to do decrypt and decompress data", K(ret));
-    }
-  }
-
-  if (OB_SUCC(ret)) {
-    ObMicroBlockCacheValue value(
-        block_data.get_buf(), block_data.get_buf_size(), nullptr, 0, block_data.type_);
-    value.set_alloc_by_block_io();
-    char *buf = nullptr;
-    const int64_t buf_len = value.size();
-    handle.reset();
-    micro_block = nullptr;
-    ObIKVCacheValue *value_copy = nullptr;
-    if (OB_ISNULL(buf = static_cast<char *>(allocator_->alloc(buf_len)))) {
-      ret = OB_ALLOCATE_MEMORY_FAILED;
-      LOG_WARN("Failed to allocate value", K(ret), K(buf_len));
-    } else if (OB_FAIL(value.deep_copy(buf, buf_len, value_copy))) {
-      LOG_WARN("Failed to deep copy value", K(ret));
+    char *block_buf = buf + sizeof(ObMicroBlockCacheValue);
+    ObMicroBlockCacheValue *value = new (buf) ObMicroBlockCacheValue(
+        block_buf, block_size, nullptr, 0, cache_->get_type());
+    value->set_alloc_by_block_io();
+    if (OB_FAIL(buf_transformer.transfrom(block_buf, block_size))) {
+      LOG_WARN("Fail to transform block buf", K(ret), K(header), K_(block_des_meta));
+      value->~ObMicroBlockCacheValue();
       allocator_->free(buf);
     } else {
-      micro_block = static_cast<const ObMicroBlockCacheValue *>(value_copy);
+      micro_block = value;
     }
   }
   return ret;
@@ -529,6 +548,7 @@ ObMultiDataBlockIOCallback::ObMultiDataBlockIOCallback()
 ObMultiDataBlockIOCallback::~ObMultiDataBlockIOCallback()
 {
   free_result();
+  free_io_ctx();
 }
 
 int64_t ObMultiDataBlockIOCallback::size() const
@@ -557,8 +577,8 @@ int ObMultiDataBlockIOCallback::inner_process(const char *data_buffer, const int
 
     const int64_t block_count = io_ctx_.block_count_;
     for (int64_t i = 0; OB_SUCC(ret) && i < block_count; ++i) {
-      const int64_t data_size = io_ctx_.micro_index_infos_[i].get_block_size();
-      const int64_t data_offset = io_ctx_.micro_index_infos_[i].get_block_offset() - offset_;
+      const int64_t data_size = io_ctx_.micro_infos_[i].size_;
+      const int64_t data_offset = io_ctx_.micro_infos_[i].offset_ - offset_;
       if (OB_FAIL(process_block(
           reader,
           data_buffer + data_offset,
@@ -588,42 +608,36 @@ int ObMultiDataBlockIOCallback::set_io_ctx(
     const ObMultiBlockIOParam &io_param)
 {
   int ret = OB_SUCCESS;
+  void *ptr = nullptr;
   if (OB_UNLIKELY(!io_param.is_valid())) {
     ret = OB_INVALID_ARGUMENT;
     LOG_WARN("invalid io_param", K(ret), K(io_param));
+  } else if (OB_ISNULL(allocator_)) {
+    ret = OB_INNER_STAT_ERROR;
+    LOG_WARN("allocator_ is null", K(ret), KP(allocator_));
+  } else if (OB_ISNULL(ptr = allocator_->alloc(sizeof(ObMicroBlockInfo) * io_param.block_count_))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("alloc memory failed", K(ret), K(io_param));
   } else {
-    io_ctx_.micro_index_infos_ = &io_param.micro_index_infos_->at(io_param.start_index_);
+    io_ctx_.micro_infos_ = new (ptr) ObMicroBlockInfo[io_param.block_count_];
     io_ctx_.block_count_ = io_param.block_count_;
+    for (int64_t i = 0; OB_SUCC(ret) && i < io_param.block_count_; ++i) {
+      const ObMicroIndexInfo &micro_index_info = io_param.micro_index_infos_->at(io_param.start_index_ + i);
+      if (OB_FAIL(io_ctx_.micro_infos_[i].set(micro_index_info.get_block_offset(),
+                                              micro_index_info.get_block_size()))) {
+        LOG_WARN("Fail to set micro block info", K(ret), K(micro_index_info));
+      }
+    }
   }
   return ret;
 }
 
-int ObMultiDataBlockIOCallback::deep_copy_ctx(
-    const ObMultiBlockIOCtx &io_ctx)
+void ObMultiDataBlockIOCallback::free_io_ctx()
 {
-  int ret = OB_SUCCESS;
-  if (OB_UNLIKELY(!io_ctx.is_valid())) {
-    ret = OB_INVALID_ARGUMENT;
-    LOG_WARN("invalid io_ctx", K(ret), K(io_ctx));
-  } else if (OB_ISNULL(allocator_)) {
-    ret = OB_INNER_STAT_ERROR;
-    LOG_WARN("allocator_ is null", K(ret), KP(allocator_));
-  } else {
-    void *ptr = nullptr;
-    int64_t alloc_size = sizeof(ObMicroIndexInfo) * io_ctx.block_count_;
-    if (OB_ISNULL(ptr = allocator_->alloc(alloc_size))) {
-      ret = OB_ALLOCATE_MEMORY_FAILED;
-      LOG_WARN("alloc memory failed", K(ret), K(alloc_size));
-    } else {
-      io_ctx_.micro_index_infos_ = reinterpret_cast<ObMicroIndexInfo *>(ptr);
-      MEMCPY(io_ctx_.micro_index_infos_, io_ctx.micro_index_infos_, alloc_size);
-    }
-
-    if (OB_SUCC(ret)) {
-      io_ctx_.block_count_ = io_ctx.block_count_;
-    }
+  if (OB_NOT_NULL(allocator_) && OB_NOT_NULL(io_ctx_.micro_infos_)) {
+    allocator_->free(io_ctx_.micro_infos_);
   }
-  return ret;
+  io_ctx_.reset();
 }
 
 int ObMultiDataBlockIOCallback::alloc_result()
@@ -760,6 +774,13 @@ int ObIMicroBlockCache::get_cache_block(
     if (OB_FAIL(cache->get(key, handle.micro_block_, handle.handle_))) {
       if (OB_ENTRY_NOT_EXIST != ret) {
         STORAGE_LOG(WARN, "Fail to get micro block from block cache, ", K(ret));
+      } else if (OB_FAIL(load_from_disk_cache(key, handle.micro_block_, handle.handle_))) {
+        if (OB_ENTRY_NOT_EXIST != ret) {
+          STORAGE_LOG(WARN, "Fail to load micro block from disk cache", K(ret), K(key));
+          ret = OB_ENTRY_NOT_EXIST;
+        }
+      } else {
+        EVENT_INC(ObStatEventIds::BLOCK_CACHE_HIT);
       }
     } else {
       EVENT_INC(ObStatEventIds::BLOCK_CACHE_HIT);
@@ -806,6 +827,59 @@ int ObIMicroBlockCache::prefetch(
   return ret;
 }
 
+int ObIMicroBlockCache::prefetch(
+    const uint64_t tenant_id,
+    const MacroBlockId &macro_id,
+    const int64_t offset,
+    const int64_t size,
+    const ObMicroBlockDesMeta &des_meta,
+    ObMacroBlockHandle &macro_handle)
+{
+  int ret = OB_SUCCESS;
+  ObIAllocator *allocator = nullptr;
+  void *buf = nullptr;
+  ObAsyncSingleMicroBlockIOCallback *callback = nullptr;
+  if (OB_UNLIKELY(!macro_id.is_valid() || offset < 0 || size <= 0 || !des_meta.is_valid()
+      || des_meta.is_encrypted())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), K(macro_id), K(offset), K(size), K(des_meta));
+  } else if (OB_FAIL(get_allocator(allocator))) {
+    LOG_WARN("Fail to get allocator", K(ret));
+  } else if (OB_ISNULL(buf = allocator->alloc(sizeof(ObAsyncSingleMicroBlockIOCallback)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate callback memory failed", K(ret));
+  } else {
+    callback = new (buf) ObAsyncSingleMicroBlockIOCallback;
+    callback->allocator_ = allocator;
+    callback->cache_ = this;
+    callback->put_size_stat_ = this;
+    callback->tenant_id_ = tenant_id;
+    callback->block_id_ = macro_id;
+    callback->offset_ = offset;
+    callback->block_des_meta_.compressor_type_ = des_meta.compressor_type_;
+    callback->block_des_meta_.row_store_type_ = des_meta.row_store_type_;
+    ObMacroBlockReadInfo read_info;
+    read_info.macro_block_id_ = macro_id;
+    read_info.io_desc_.set_wait_event(ObWaitEventIds::DB_FILE_DATA_READ);
+    read_info.io_desc_.set_group_id(ObIOModule::MICRO_BLOCK_CACHE_IO);
+    read_info.io_callback_ = callback;
+    read_info.offset_ = offset;
+    read_info.size_ = size;
+    read_info.io_timeout_ms_ = GCONF._data_storage_io_timeout / 1000L;
+    if (OB_FAIL(ObBlockManager::async_read_block(read_info, macro_handle))) {
+      LOG_WARN("Fail to async read block", K(ret), K(read_info));
+    } else {
+      EVENT_INC(ObStatEventIds::IO_READ_PREFETCH_MICRO_COUNT);
+      EVENT_ADD(ObStatEventIds::IO_READ_PREFETCH_MICRO_BYTES, size);
+    }
+    if (OB_FAIL(ret) && OB_NOT_NULL(callback->get_allocator())) { //Avoid double_free with io_handle
+      callback->~ObAsyncSingleMicroBlockIOCallback();
+      allocator->free(callback);
+    }
+  }
+  return ret;
+}
+
 int ObIMicroBlockCache::prefetch(
     const uint64_t tenant_id,
     const MacroBlockId &macro_id,
@@ -1009,12 +1083,13 @@ int ObMicroBlockBufTransformer::transfrom(char *block_buf, const int64_t buf_siz
 }
 
 /*-------------------------------------ObDataMicroBlockCache--------------------------------------*/
-int ObDataMicroBlockCache::init(const char *cache_name, const int64_t priority)
+int ObDataMicroBlockCache::init(const char *cache_name, const int64_t priority,
+                                const bool enable_admission)
 {
   int ret = OB_SUCCESS;
   const int64_t mem_limit = 4 * 1024 * 1024 * 1024LL;
   if (OB_SUCCESS != (ret = common::ObKVCache<ObMicroBlockCacheKey, ObMicroBlockCacheValue>::init(
-      cache_name, priority))) {
+      cache_name, priority, enable_admission))) {
     STORAGE_LOG(WARN, "Fail to init kv cache, ", K(ret));
   } else if (OB_FAIL(allocator_.init(mem_limit, OB_MALLOC_MIDDLE_BLOCK_SIZE, OB_MALLOC_MIDDLE_BLOCK_SIZE))) {
     STORAGE_LOG(WARN, "Fail to init io allocator, ", K(ret));
@@ -1216,8 +1291,7 @@ int ObDataMicroBlockCache::put_cache_block(
     } else if (OB_FAIL(buf_transformer.get_buf_size(block_size))) {
       LOG_WARN("Fail to get block buf size", K(ret));
     } else if (FALSE_IT(value_size = calc_value_size(block_size, des_meta.row_store_type_, need_decoder))) {
-    } else if (OB_FAIL(alloc(
-        key.get_tenant_id(), sizeof(ObMicroBlockCacheKey), value_size, kvpair, cache_handle, inst_handle))) {
+    } else if (OB_FAIL(alloc(key, value_size, kvpair, cache_handle, inst_handle))) {
       LOG_WARN("Fail to allocate kvpair from kvcache", K(ret), K(value_size), K(key));
     } else {
       char *block_buf = reinterpret_cast<char *>(kvpair->value_) + sizeof(ObMicroBlockCacheValue);
@@ -1225,6 +1299,7 @@ int ObDataMicroBlockCache::put_cache_block(
       ObMicroBlockCacheValue *cache_value = new (kvpair->value_) ObMicroBlockCacheValue(block_buf, block_size);
       ObMicroBlockData &micro_data = cache_value->get_block_data();
       micro_data.type_ = get_type();
+      cache_value->set_des_meta(des_meta);
       if (OB_FAIL(buf_transformer.transfrom(block_buf, block_size))) {
         LOG_WARN("fail to transfrom", K(ret));
       } else if (need_decoder && OB_FAIL(write_extra_buf(
@@ -1238,6 +1313,70 @@ int ObDataMicroBlockCache::put_cache_block(
           ret = OB_SUCCESS;
         }
       } else {
+        const int64_t put_size = ObKVStoreMemBlock::get_align_size(key, *cache_value);
+        if (OB_FAIL(add_put_size(put_size))) {
+          LOG_WARN("add_put_size failed", K(ret), K(put_size));
+        } else if (nullptr != disk_cache_ && !des_meta.is_encrypted()) {
+          // blocks of encrypted tables are decrypted here, keep them off the disk cache
+          int tmp_ret = OB_SUCCESS;
+          if (OB_TMP_FAIL(disk_cache_->append(key, des_meta, block_buf, block_size))) {
+            LOG_DEBUG("fail to append micro block to disk cache", K(tmp_ret), K(key));
+          }
+        }
+      }
+      if (OB_FAIL(ret)) {
+        cache_handle.reset();
+        micro_block = nullptr;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObDataMicroBlockCache::load_from_disk_cache(
+    const ObMicroBlockCacheKey &key,
+    const ObMicroBlockCacheValue *&micro_block,
+    common::ObKVCacheHandle &cache_handle)
+{
+  int ret = OB_SUCCESS;
+  ObArenaAllocator allocator(ObMemAttr(MTL_ID(), "MicroDiskCache"));
+  ObMicroBlockDesMeta des_meta;
+  const char *buf = nullptr;
+  int64_t block_size = 0;
+  micro_block = nullptr;
+  if (nullptr == disk_cache_) {
+    ret = OB_ENTRY_NOT_EXIST;
+  } else if (OB_FAIL(disk_cache_->get(key, allocator, des_meta, buf, block_size))) {
+    if (OB_ENTRY_NOT_EXIST != ret) {
+      LOG_WARN("fail to get micro block from disk cache", K(ret), K(key));
+    }
+  } else {
+    ObKVCacheInstHandle inst_handle;
+    ObKVCachePair *kvpair = nullptr;
+    bool need_decoder = false;
+    const int64_t value_size = calc_value_size(block_size, des_meta.row_store_type_, need_decoder);
+    if (OB_FAIL(alloc(key, value_size, kvpair, cache_handle, inst_handle))) {
+      LOG_WARN("Fail to allocate kvpair from kvcache", K(ret), K(value_size), K(key));
+    } else {
+      char *block_buf = reinterpret_cast<char *>(kvpair->value_) + sizeof(ObMicroBlockCacheValue);
+      kvpair->key_ = new (kvpair->key_) ObMicroBlockCacheKey(key);
+      ObMicroBlockCacheValue *cache_value = new (kvpair->value_) ObMicroBlockCacheValue(block_buf, block_size);
+      ObMicroBlockData &micro_data = cache_value->get_block_data();
+      micro_data.type_ = get_type();
+      cache_value->set_des_meta(des_meta);
+      MEMCPY(block_buf, buf, block_size);
+      if (need_decoder && OB_FAIL(write_extra_buf(
+          des_meta.row_store_type_, block_buf, block_size, block_buf + block_size, micro_data))) {
+        LOG_WARN("Fail to cache decoder on extra buffer for data block", K(ret), KPC(cache_value));
+      } else if (OB_FAIL(put_kvpair(inst_handle, kvpair, cache_handle, false /* overwrite */))) {
+        if (OB_ENTRY_EXIST != ret) {
+          LOG_WARN("Fail to put micro block cache", K(ret));
+        } else if (OB_FAIL(get(key, micro_block, cache_handle))) {
+          // loaded by another thread meanwhile
+          LOG_WARN("Fail to get micro block from block cache", K(ret), K(key));
+        }
+      } else {
+        micro_block = cache_value;
         const int64_t put_size = ObKVStoreMemBlock::get_align_size(key, *cache_value);
         if (OB_FAIL(add_put_size(put_size))) {
           LOG_WARN("add_put_size failed", K(ret), K(put_size));
@@ -1454,6 +1593,7 @@ int ObIndexMicroBlockCache::put_cache_block(
       LOG_WARN("fail to transfrom block buf", K(ret));
     } else {
       ObMicroBlockCacheValue cache_value(block_buf, block_size);
+      cache_value.set_des_meta(des_meta);
       ObMicroBlockData &block_data = cache_value.get_block_data();
       block_data.type_ = get_type();
       char *allocated_buf = nullptr;
@@ -29,6 +29,7 @@ namespace oceanbase
 namespace blocksstable
 {
 class ObIMicroBlockIOCallback;
+class ObMicroBlockDiskCache;
 class ObMicroBlockCacheKey : public common::ObIKVCacheKey
 {
 public:
@@ -76,10 +77,16 @@ public:
   inline ObMicroBlockData& get_block_data() { return block_data_; }
   bool need_free() const {return alloc_by_block_io_; }
   void set_alloc_by_block_io() { alloc_by_block_io_ = true; }
-  TO_STRING_KV(K_(block_data));
+  // remember how to read the block again from disk, kept invalid for encrypted blocks
+  void set_des_meta(const ObMicroBlockDesMeta &des_meta);
+  // return false if the block can not be read again without the index row
+  bool get_des_meta(ObMicroBlockDesMeta &des_meta) const;
+  TO_STRING_KV(K_(block_data), K_(compressor_type), K_(row_store_type));
 private:
   ObMicroBlockData block_data_;
   bool alloc_by_block_io_;  // TODO: @lvling to be removed
+  uint8_t compressor_type_;
+  uint8_t row_store_type_;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObMicroBlockCacheValue);
 };
@@ -133,14 +140,15 @@ struct ObMultiBlockIOParam
 struct ObMultiBlockIOCtx
 {
   ObMultiBlockIOCtx()
-    : micro_index_infos_(nullptr), hit_cache_bitmap_(nullptr), block_count_(0) {}
+    : micro_infos_(nullptr), hit_cache_bitmap_(nullptr), block_count_(0) {}
   virtual ~ObMultiBlockIOCtx() {}
   void reset();
   bool is_valid() const;
-  ObMicroIndexInfo *micro_index_infos_;
+  // copied from the index rows, which may be released before the io is done
+  ObMicroBlockInfo *micro_infos_;
   bool *hit_cache_bitmap_;
   int64_t block_count_;
-  TO_STRING_KV(KP_(micro_index_infos), KP_(hit_cache_bitmap), K_(block_count));
+  TO_STRING_KV(KP_(micro_infos), KP_(hit_cache_bitmap), K_(block_count));
 };
 
 class ObIPutSizeStat
@@ -171,12 +179,11 @@ protected:
       const ObMicroBlockCacheValue *&micro_block,
       common::ObKVCacheHandle &cache_handle);
 private:
-  int read_block_and_copy(
-      const ObMicroBlockHeader &header,
+  int read_block_without_cache(
+      ObMicroBlockHeader &header,
       ObMacroBlockReader &reader,
       const char *buffer,
       const int64_t size,
-      ObMicroBlockData &block_data,
       const ObMicroBlockCacheValue *&micro_block,
       common::ObKVCacheHandle &handle);
   static const int64_t ALLOC_BUF_RETRY_INTERVAL = 100 * 1000;
@@ -224,8 +231,7 @@ public:
 private:
   friend class ObDataMicroBlockCache;
   int set_io_ctx(const ObMultiBlockIOParam &io_param);
-  void reset_io_ctx() { io_ctx_.reset(); }
-  int deep_copy_ctx(const ObMultiBlockIOCtx &io_ctx);
+  void free_io_ctx();
   int alloc_result();
   void free_result();
   DISALLOW_COPY_AND_ASSIGN(ObMultiDataBlockIOCallback);
@@ -294,6 +300,14 @@ public:
       const bool use_cache,
       ObMacroBlockHandle &macro_handle,
       ObIAllocator *allocator);
+  // prefetch a block without its index row, e.g. to warm up the cache after restart
+  int prefetch(
+      const uint64_t tenant_id,
+      const MacroBlockId &macro_id,
+      const int64_t offset,
+      const int64_t size,
+      const ObMicroBlockDesMeta &des_meta,
+      ObMacroBlockHandle &macro_handle);
   virtual int load_block(
       const ObMicroBlockId &micro_block_id,
       const ObMicroBlockDesMeta &des_meta,
@@ -321,6 +335,15 @@ public:
   virtual int add_put_size(const int64_t put_size) override;
 
 protected:
+  // fill the memory cache with the block from the second tier cache if there is one
+  virtual int load_from_disk_cache(
+      const ObMicroBlockCacheKey &key,
+      const ObMicroBlockCacheValue *&micro_block,
+      common::ObKVCacheHandle &cache_handle)
+  {
+    UNUSEDx(key, micro_block, cache_handle);
+    return common::OB_ENTRY_NOT_EXIST;
+  }
   int prefetch(
       const uint64_t tenant_id,
       const MacroBlockId &macro_id,
@@ -341,10 +364,12 @@ class ObDataMicroBlockCache
     public ObIMicroBlockCache
 {
 public:
-  ObDataMicroBlockCache() {}
+  ObDataMicroBlockCache() : disk_cache_(nullptr) {}
   virtual ~ObDataMicroBlockCache() {}
-  int init(const char *cache_name, const int64_t priority = 1);
+  int init(const char *cache_name, const int64_t priority = 1, const bool enable_admission = false);
   virtual void destroy() override;
+  // blocks put to the cache are also appended to %disk_cache, and read back on memory miss
+  void set_disk_cache(ObMicroBlockDiskCache *disk_cache) { disk_cache_ = disk_cache; }
   using ObIMicroBlockCache::prefetch;
   int prefetch(
       const uint64_t tenant_id,
@@ -375,6 +400,11 @@ public:
       ObKVCachePair *&kvpair,
       int64_t &kvpair_size) override;
   virtual ObMicroBlockData::Type get_type() override;
+protected:
+  virtual int load_from_disk_cache(
+      const ObMicroBlockCacheKey &key,
+      const ObMicroBlockCacheValue *&micro_block,
+      common::ObKVCacheHandle &cache_handle) override;
 private:
   int64_t calc_value_size(const int64_t data_length, const ObRowStoreType &type, bool &need_decoder);
   int write_extra_buf(
@@ -385,6 +415,7 @@ private:
       ObMicroBlockData &micro_data);
 private:
   common::ObConcurrentFIFOAllocator allocator_;
+  ObMicroBlockDiskCache *disk_cache_;
   DISALLOW_COPY_AND_ASSIGN(ObDataMicroBlockCache);
 };
 
@@ -0,0 +1,380 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include "storage/blocksstable/ob_micro_block_cache_warm_up.h"
+#include "storage/blocksstable/ob_storage_cache_suite.h"
+#include "storage/blocksstable/ob_block_manager.h"
+#include "share/rc/ob_tenant_base.h"
+#include "share/config/ob_server_config.h"
+#include "lib/checksum/ob_crc64.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace blocksstable
+{
+
+const char *ObMicroBlockCacheWarmUpTask::SNAPSHOT_FILE_NAME = "micro_block_cache_snapshot";
+
+ObMicroBlockCacheWarmUpTask::ObMicroBlockCacheWarmUpTask()
+  : is_inited_(false),
+    is_loaded_(false),
+    is_restored_(false),
+    last_snapshot_ts_(0),
+    restore_entries_(),
+    restore_pos_(0),
+    restore_cnt_(0)
+{
+  MEMSET(snapshot_path_, 0, sizeof(snapshot_path_));
+}
+
+ObMicroBlockCacheWarmUpTask::~ObMicroBlockCacheWarmUpTask()
+{
+  destroy();
+}
+
+int ObMicroBlockCacheWarmUpTask::init(const char *dir)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("cache warm up task init twice", K(ret));
+  } else if (OB_ISNULL(dir) || OB_UNLIKELY(0 == STRLEN(dir))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(dir));
+  } else if (OB_FAIL(databuff_printf(snapshot_path_, sizeof(snapshot_path_), "%s/%s",
+                                     dir, SNAPSHOT_FILE_NAME))) {
+    LOG_WARN("fail to make snapshot path", K(ret), K(dir));
+  } else {
+    restore_entries_.set_attr(ObMemAttr(OB_SERVER_TENANT_ID, "CacheWarmUp"));
+    last_snapshot_ts_ = ObTimeUtility::current_time();
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+void ObMicroBlockCacheWarmUpTask::destroy()
+{
+  for (int64_t i = 0; i < MAX_BATCH_CNT; ++i) {
+    macro_handles_[i].reset();
+  }
+  restore_entries_.reset();
+  restore_pos_ = 0;
+  restore_cnt_ = 0;
+  last_snapshot_ts_ = 0;
+  is_restored_ = false;
+  is_loaded_ = false;
+  is_inited_ = false;
+}
+
+void ObMicroBlockCacheWarmUpTask::runTimerTask()
+{
+  int ret = OB_SUCCESS;
+  const int64_t snapshot_interval = GCONF._cache_warm_up_snapshot_interval;
+  if (OB_UNLIKELY(!is_inited_)) {
+  } else if (!is_restored_) {
+    // restore after the macro blocks in use are known
+    if (OB_SERVER_BLOCK_MGR.get_start_write_seq() >= 0 && OB_FAIL(restore())) {
+      LOG_WARN("fail to restore micro block cache, give up", K(ret), KPC(this));
+      finish_restore();
+    }
+  } else if (snapshot_interval > 0
+      && ObTimeUtility::current_time() - last_snapshot_ts_ >= snapshot_interval) {
+    if (OB_FAIL(take_snapshot())) {
+      LOG_WARN("fail to take micro block cache snapshot", K(ret));
+    }
+  }
+}
+
+int ObMicroBlockCacheWarmUpTask::take_snapshot()
+{
+  int ret = OB_SUCCESS;
+  ObArray<Entry> entries;
+  entries.set_attr(ObMemAttr(OB_SERVER_TENANT_ID, "CacheWarmUp"));
+  const int64_t start_ts = ObTimeUtility::current_time();
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("cache warm up task not init", K(ret));
+  } else if (!is_restored_) {
+  } else if (OB_FAIL(collect_entries(OB_STORE_CACHE.get_index_block_cache(), true, entries))) {
+    LOG_WARN("fail to collect index block cache", K(ret));
+  } else if (OB_FAIL(collect_entries(OB_STORE_CACHE.get_block_cache(), false, entries))) {
+    LOG_WARN("fail to collect user block cache", K(ret));
+  } else {
+    shrink_entries(entries);
+    if (entries.count() > 0) {
+      std::sort(&entries.at(0), &entries.at(0) + entries.count(), EntryCompare());
+    }
+    if (OB_FAIL(write_snapshot(entries))) {
+      LOG_WARN("fail to write snapshot", K(ret), K_(snapshot_path));
+    } else {
+      FLOG_INFO("succeed to take micro block cache snapshot", "entry_cnt", entries.count(),
+          "cost_ts", ObTimeUtility::current_time() - start_ts);
+    }
+  }
+  if (is_restored_) {
+    last_snapshot_ts_ = ObTimeUtility::current_time();
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheWarmUpTask::collect_entries(
+    ObDataMicroBlockCache &cache,
+    const bool is_index_block,
+    ObArray<Entry> &entries)
+{
+  int ret = OB_SUCCESS;
+  ObKVCacheIterator iter;
+  const ObMicroBlockCacheKey *key = nullptr;
+  const ObMicroBlockCacheValue *value = nullptr;
+  int64_t get_cnt = 0;
+  ObKVCacheHandle handle;
+  ObMicroBlockDesMeta des_meta;
+  if (OB_FAIL(cache.get_iterator(iter))) {
+    LOG_WARN("fail to get cache iterator", K(ret));
+  }
+  while (OB_SUCC(ret)) {
+    if (OB_FAIL(iter.get_next_kvpair(key, value, get_cnt, handle))) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("fail to get next kvpair", K(ret));
+      }
+    } else if (get_cnt < MIN_HIT_CNT || !value->get_des_meta(des_meta)) {
+    } else {
+      const ObMicroBlockId &block_id = key->get_micro_block_id();
+      Entry entry;
+      MEMSET(&entry, 0, sizeof(entry));
+      entry.tenant_id_ = key->get_tenant_id();
+      entry.first_id_ = block_id.macro_id_.first_id();
+      entry.second_id_ = block_id.macro_id_.second_id();
+      entry.third_id_ = block_id.macro_id_.third_id();
+      entry.offset_ = block_id.offset_;
+      entry.size_ = block_id.size_;
+      entry.hit_cnt_ = get_cnt;
+      entry.is_index_block_ = is_index_block;
+      entry.compressor_type_ = static_cast<uint8_t>(des_meta.compressor_type_);
+      entry.row_store_type_ = static_cast<uint8_t>(des_meta.row_store_type_);
+      if (OB_FAIL(entries.push_back(entry))) {
+        LOG_WARN("fail to push back entry", K(ret));
+      } else if (entries.count() >= 2 * MAX_ENTRY_CNT) {
+        shrink_entries(entries);
+      }
+    }
+    handle.reset();
+  }
+  if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+  }
+  return ret;
+}
+
+void ObMicroBlockCacheWarmUpTask::shrink_entries(ObArray<Entry> &entries)
+{
+  if (entries.count() > MAX_ENTRY_CNT) {
+    Entry *begin = &entries.at(0);
+    std::nth_element(begin, begin + MAX_ENTRY_CNT, begin + entries.count(), EntryCompare());
+    while (entries.count() > MAX_ENTRY_CNT) {
+      entries.pop_back();
+    }
+  }
+}
+
+int ObMicroBlockCacheWarmUpTask::write_snapshot(const ObArray<Entry> &entries)
+{
+  int ret = OB_SUCCESS;
+  char tmp_path[OB_MAX_FILE_NAME_LENGTH] = {0};
+  const int64_t data_size = entries.count() * static_cast<int64_t>(sizeof(Entry));
+  const char *data = entries.count() > 0 ? reinterpret_cast<const char *>(&entries.at(0)) : nullptr;
+  SnapshotHeader header;
+  MEMSET(&header, 0, sizeof(header));
+  header.magic_ = SNAPSHOT_MAGIC;
+  header.version_ = SNAPSHOT_VERSION;
+  header.entry_cnt_ = entries.count();
+  header.data_checksum_ = ob_crc64(data, data_size);
+  header.checksum_ = ob_crc64(&header, offsetof(SnapshotHeader, checksum_));
+  int fd = -1;
+  if (OB_FAIL(databuff_printf(tmp_path, sizeof(tmp_path), "%s.tmp", snapshot_path_))) {
+    LOG_WARN("fail to make tmp path", K(ret), K_(snapshot_path));
+  } else if ((fd = ::open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR)) < 0) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to open snapshot file", K(ret), K(tmp_path), K(errno), KERRMSG);
+  } else {
+    const char *bufs[2] = {reinterpret_cast<const char *>(&header), data};
+    const int64_t sizes[2] = {static_cast<int64_t>(sizeof(header)), data_size};
+    for (int64_t i = 0; OB_SUCC(ret) && i < 2; ++i) {
+      int64_t pos = 0;
+      while (OB_SUCC(ret) && pos < sizes[i]) {
+        const int64_t write_size = ::write(fd, bufs[i] + pos, sizes[i] - pos);
+        if (write_size < 0 && EINTR == errno) {
+        } else if (write_size <= 0) {
+          ret = OB_IO_ERROR;
+          LOG_WARN("fail to write snapshot file", K(ret), K(tmp_path), K(errno), KERRMSG);
+        } else {
+          pos += write_size;
+        }
+      }
+    }
+    if (OB_SUCC(ret) && 0 != ::fsync(fd)) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to fsync snapshot file", K(ret), K(tmp_path), K(errno), KERRMSG);
+    }
+    ::close(fd);
+    if (OB_SUCC(ret) && 0 != ::rename(tmp_path, snapshot_path_)) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to rename snapshot file", K(ret), K(tmp_path), K_(snapshot_path),
+          K(errno), KERRMSG);
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheWarmUpTask::load_snapshot()
+{
+  int ret = OB_SUCCESS;
+  SnapshotHeader header;
+  int fd = -1;
+  if ((fd = ::open(snapshot_path_, O_RDONLY)) < 0) {
+    if (ENOENT != errno) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to open snapshot file", K(ret), K_(snapshot_path), K(errno), KERRMSG);
+    }
+  } else {
+    if (sizeof(header) != ::pread(fd, &header, sizeof(header), 0)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("fail to read snapshot header", K(ret), K_(snapshot_path), K(errno), KERRMSG);
+    } else if (SNAPSHOT_MAGIC != header.magic_
+        || SNAPSHOT_VERSION != header.version_
+        || header.checksum_ != ob_crc64(&header, offsetof(SnapshotHeader, checksum_))
+        || header.entry_cnt_ < 0
+        || header.entry_cnt_ > MAX_ENTRY_CNT) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid snapshot header", K(ret), K_(snapshot_path), K(header.magic_),
+          K(header.version_), K(header.entry_cnt_));
+    } else if (OB_FAIL(restore_entries_.prepare_allocate(header.entry_cnt_))) {
+      LOG_WARN("fail to prepare allocate entries", K(ret), K(header.entry_cnt_));
+    } else if (header.entry_cnt_ > 0) {
+      const int64_t data_size = header.entry_cnt_ * static_cast<int64_t>(sizeof(Entry));
+      char *data = reinterpret_cast<char *>(&restore_entries_.at(0));
+      if (data_size != ::pread(fd, data, data_size, sizeof(header))) {
+        ret = OB_INVALID_DATA;
+        LOG_WARN("fail to read snapshot entries", K(ret), K_(snapshot_path), K(errno), KERRMSG);
+      } else if (header.data_checksum_ != ob_crc64(data, data_size)) {
+        ret = OB_CHECKSUM_ERROR;
+        LOG_WARN("snapshot entries checksum error", K(ret), K_(snapshot_path));
+      }
+    }
+    ::close(fd);
+  }
+  if (OB_FAIL(ret)) {
+    restore_entries_.reset();
+  } else {
+    FLOG_INFO("succeed to load micro block cache snapshot", K_(snapshot_path),
+        "entry_cnt", restore_entries_.count());
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheWarmUpTask::restore()
+{
+  int ret = OB_SUCCESS;
+  int64_t budget = GCONF._cache_warm_up_bandwidth * SCHEDULE_INTERVAL / 1000000L;
+  if (!is_loaded_) {
+    is_loaded_ = true;
+    if (OB_FAIL(load_snapshot())) {
+      LOG_WARN("fail to load snapshot", K(ret));
+    }
+  }
+  while (OB_SUCC(ret) && budget > 0 && restore_pos_ < restore_entries_.count()) {
+    int64_t handle_cnt = 0;
+    while (handle_cnt < MAX_BATCH_CNT && budget > 0 && restore_pos_ < restore_entries_.count()) {
+      const Entry &entry = restore_entries_.at(restore_pos_++);
+      bool is_submitted = false;
+      int tmp_ret = OB_SUCCESS;
+      if (OB_TMP_FAIL(prefetch_entry(entry, macro_handles_[handle_cnt], is_submitted))) {
+        LOG_DEBUG("fail to prefetch entry, skip it", K(tmp_ret), K(entry));
+      } else if (is_submitted) {
+        ++handle_cnt;
+        budget -= entry.size_;
+      }
+    }
+    for (int64_t i = 0; i < handle_cnt; ++i) {
+      int tmp_ret = OB_SUCCESS;
+      if (OB_TMP_FAIL(macro_handles_[i].wait())) {
+        LOG_DEBUG("fail to wait prefetch io", K(tmp_ret));
+      } else {
+        ++restore_cnt_;
+      }
+      macro_handles_[i].reset();
+    }
+  }
+  if (OB_SUCC(ret) && restore_pos_ >= restore_entries_.count()) {
+    finish_restore();
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheWarmUpTask::prefetch_entry(
+    const Entry &entry,
+    ObMacroBlockHandle &macro_handle,
+    bool &is_submitted)
+{
+  int ret = OB_SUCCESS;
+  const MacroBlockId macro_id(entry.first_id_, entry.second_id_, entry.third_id_);
+  ObIMicroBlockCache &cache = entry.is_index_block_
+      ? static_cast<ObIMicroBlockCache &>(OB_STORE_CACHE.get_index_block_cache())
+      : static_cast<ObIMicroBlockCache &>(OB_STORE_CACHE.get_block_cache());
+  const ObMicroBlockDesMeta des_meta(static_cast<ObCompressorType>(entry.compressor_type_),
+                                     static_cast<ObRowStoreType>(entry.row_store_type_),
+                                     0 /* encrypt_id */, 0 /* master_key_id */, nullptr);
+  ObMicroBlockBufferHandle cache_handle;
+  bool is_free = true;
+  is_submitted = false;
+  if (OB_FAIL(OB_SERVER_BLOCK_MGR.check_macro_block_free(macro_id, is_free))) {
+    LOG_WARN("fail to check macro block free", K(ret), K(macro_id));
+  } else if (is_free) {
+    // the sstable is gone
+  } else if (OB_SUCC(cache.get_cache_block(entry.tenant_id_, macro_id, entry.offset_,
+                                           entry.size_, cache_handle))) {
+    // already in cache
+  } else if (OB_ENTRY_NOT_EXIST != ret) {
+    LOG_WARN("fail to get cache block", K(ret), K(entry));
+  } else {
+    ret = OB_SUCCESS;
+    MTL_SWITCH(entry.tenant_id_) {
+      if (OB_FAIL(cache.prefetch(entry.tenant_id_, macro_id, entry.offset_, entry.size_,
+                                 des_meta, macro_handle))) {
+        LOG_WARN("fail to prefetch micro block", K(ret), K(entry));
+      } else {
+        is_submitted = true;
+      }
+    }
+  }
+  return ret;
+}
+
+void ObMicroBlockCacheWarmUpTask::finish_restore()
+{
+  FLOG_INFO("finish restoring micro block cache", "entry_cnt", restore_entries_.count(),
+      K_(restore_cnt));
+  restore_entries_.reset();
+  restore_pos_ = 0;
+  is_restored_ = true;
+  last_snapshot_ts_ = ObTimeUtility::current_time();
+}
+
+} // namespace blocksstable
+} // namespace oceanbase
@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_MICRO_BLOCK_CACHE_WARM_UP_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_MICRO_BLOCK_CACHE_WARM_UP_H_
+
+#include "lib/task/ob_timer.h"
+#include "lib/container/ob_array.h"
+#include "storage/blocksstable/ob_macro_block_handle.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+class ObDataMicroBlockCache;
+
+// Warm up user block cache and index block cache after restart.
+//
+// Keys of micro blocks got from the caches are persisted to a snapshot file periodically and
+// when the server stops. After restart, the blocks in the snapshot are prefetched back to the
+// caches in the order of index blocks first and then hit count, with bandwidth limited by
+// _cache_warm_up_bandwidth. Only the keys and the way to decompress the blocks are persisted,
+// so blocks of encrypted tables are skipped.
+class ObMicroBlockCacheWarmUpTask : public common::ObTimerTask
+{
+public:
+  static const int64_t SCHEDULE_INTERVAL = 1000L * 1000L; // 1s
+  ObMicroBlockCacheWarmUpTask();
+  virtual ~ObMicroBlockCacheWarmUpTask();
+  int init(const char *dir);
+  void destroy();
+  virtual void runTimerTask() override;
+  // skipped before the blocks of last snapshot are restored, to not overwrite it
+  int take_snapshot();
+  TO_STRING_KV(K_(is_inited), K_(is_loaded), K_(is_restored), K_(snapshot_path),
+               K_(last_snapshot_ts), K_(restore_pos), K_(restore_cnt));
+
+private:
+  static const uint32_t SNAPSHOT_MAGIC = 0x4D425753; // MBWS
+  static const uint32_t SNAPSHOT_VERSION = 1;
+  static const int64_t MAX_ENTRY_CNT = 256L * 1024L;
+  static const int64_t MIN_HIT_CNT = 2; // got at least once after put
+  static const int64_t MAX_BATCH_CNT = 64;
+  static const char *SNAPSHOT_FILE_NAME;
+  struct SnapshotHeader
+  {
+    uint32_t magic_;
+    uint32_t version_;
+    int64_t entry_cnt_;
+    uint64_t data_checksum_;
+    uint64_t checksum_;
+  };
+  struct Entry
+  {
+    uint64_t tenant_id_;
+    int64_t first_id_;
+    int64_t second_id_;
+    int64_t third_id_;
+    int32_t offset_;
+    int32_t size_;
+    int64_t hit_cnt_;
+    uint8_t is_index_block_;
+    uint8_t compressor_type_;
+    uint8_t row_store_type_;
+    uint8_t reserved_[5];
+    TO_STRING_KV(K_(tenant_id), K_(first_id), K_(second_id), K_(third_id), K_(offset), K_(size),
+                 K_(hit_cnt), K_(is_index_block), K_(compressor_type), K_(row_store_type));
+  };
+  // index blocks first, then blocks with more hits
+  struct EntryCompare
+  {
+    bool operator()(const Entry &left, const Entry &right) const
+    {
+      return left.is_index_block_ != right.is_index_block_
+          ? left.is_index_block_ > right.is_index_block_
+          : left.hit_cnt_ > right.hit_cnt_;
+    }
+  };
+
+  int collect_entries(
+      ObDataMicroBlockCache &cache,
+      const bool is_index_block,
+      common::ObArray<Entry> &entries);
+  void shrink_entries(common::ObArray<Entry> &entries);
+  int write_snapshot(const common::ObArray<Entry> &entries);
+  int load_snapshot();
+  int restore();
+  int prefetch_entry(const Entry &entry, ObMacroBlockHandle &macro_handle, bool &is_submitted);
+  void finish_restore();
+
+private:
+  bool is_inited_;
+  bool is_loaded_;
+  bool is_restored_;
+  char snapshot_path_[common::OB_MAX_FILE_NAME_LENGTH];
+  int64_t last_snapshot_ts_;
+  common::ObArray<Entry> restore_entries_;
+  int64_t restore_pos_;
+  int64_t restore_cnt_;
+  ObMacroBlockHandle macro_handles_[MAX_BATCH_CNT];
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockCacheWarmUpTask);
+};
+
+} // namespace blocksstable
+} // namespace oceanbase
+
+#endif // OCEANBASE_STORAGE_BLOCKSSTABLE_MICRO_BLOCK_CACHE_WARM_UP_H_
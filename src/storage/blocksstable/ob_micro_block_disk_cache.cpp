@@ -0,0 +1,584 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include "storage/blocksstable/ob_micro_block_disk_cache.h"
+#include "storage/blocksstable/ob_micro_block_cache.h"
+#include "storage/blocksstable/ob_block_manager.h"
+#include "lib/file/file_directory_utils.h"
+#include "lib/checksum/ob_crc64.h"
+#include "lib/hash_func/murmur_hash.h"
+#include "lib/utility/ob_utility.h"
+#include "share/io/ob_io_manager.h"
+#include "share/config/ob_server_config.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace blocksstable
+{
+
+const char *ObMicroBlockDiskCache::CACHE_FILE_NAME = "micro_block_disk_cache";
+
+ObMicroBlockDiskCache::ObMicroBlockDiskCache()
+  : is_inited_(false),
+    fd_(),
+    segment_cnt_(0),
+    segment_seqs_(nullptr),
+    segment_fingerprints_(nullptr),
+    location_map_(),
+    lock_(),
+    max_seq_(0),
+    write_idx_(0),
+    flush_idx_(0),
+    write_pos_(0),
+    flush_cond_(),
+    reported_drop_cnt_(0),
+    hit_cnt_(0),
+    miss_cnt_(0),
+    drop_cnt_(0)
+{
+  MEMSET(buffers_, 0, sizeof(buffers_));
+}
+
+ObMicroBlockDiskCache::~ObMicroBlockDiskCache()
+{
+  destroy();
+}
+
+int ObMicroBlockDiskCache::init(const char *dir, const int64_t file_size)
+{
+  int ret = OB_SUCCESS;
+  const int64_t segment_cnt = file_size / SEGMENT_SIZE;
+  ObMemAttr attr(OB_SERVER_TENANT_ID, "MicroDiskCache");
+  bool is_new_file = false;
+  void *buf = nullptr;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("micro block disk cache init twice", K(ret));
+  } else if (OB_ISNULL(dir) || OB_UNLIKELY(0 == STRLEN(dir) || segment_cnt < 2)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(dir), K(file_size));
+  } else if (OB_ISNULL(segment_seqs_ = static_cast<int64_t *>(
+      ob_malloc(sizeof(int64_t) * segment_cnt, attr)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc segment seqs", K(ret), K(segment_cnt));
+  } else if (OB_ISNULL(buf = ob_malloc(sizeof(ObArray<uint64_t>) * segment_cnt, attr))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc segment fingerprints", K(ret), K(segment_cnt));
+  } else {
+    MEMSET(segment_seqs_, 0, sizeof(int64_t) * segment_cnt);
+    segment_fingerprints_ = static_cast<ObArray<uint64_t> *>(buf);
+    for (int64_t i = 0; i < segment_cnt; ++i) {
+      new (segment_fingerprints_ + i) ObArray<uint64_t>(SEGMENT_FINGERPRINT_BLOCK_SIZE,
+                                                        ModulePageAllocator(attr.label_));
+    }
+    segment_cnt_ = segment_cnt;
+    for (int64_t i = 0; OB_SUCC(ret) && i < WRITE_BUFFER_CNT; ++i) {
+      if (OB_ISNULL(buffers_[i].buf_ = static_cast<char *>(
+          ob_malloc_align(DIO_ALIGN_SIZE, SEGMENT_SIZE, attr)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("fail to alloc write buffer", K(ret));
+      }
+    }
+  }
+
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(flush_cond_.init(ObWaitEventIds::DEFAULT_COND_WAIT))) {
+    LOG_WARN("fail to init flush cond", K(ret));
+  } else if (OB_FAIL(location_map_.create(segment_cnt * AVG_RECORD_CNT_PER_SEGMENT, attr))) {
+    LOG_WARN("fail to create location map", K(ret));
+  } else if (OB_FAIL(open_file(dir, segment_cnt * SEGMENT_SIZE, is_new_file))) {
+    LOG_WARN("fail to open cache file", K(ret), K(dir));
+  } else if (!is_new_file && OB_FAIL(load_segments())) {
+    LOG_WARN("fail to load segments", K(ret));
+  } else {
+    // continue writing after the latest segment
+    int64_t latest_segment = segment_cnt_ - 1;
+    for (int64_t i = 0; i < segment_cnt_; ++i) {
+      if (segment_seqs_[i] == max_seq_ && max_seq_ > 0) {
+        latest_segment = i;
+      }
+    }
+    write_idx_ = 0;
+    flush_idx_ = 0;
+    buffers_[0].segment_ = (latest_segment + 1) % segment_cnt_;
+    buffers_[0].seq_ = ++max_seq_;
+    write_pos_ = sizeof(SegmentHeader);
+    if (OB_FAIL(lib::ThreadPool::start())) {
+      LOG_WARN("fail to start flush thread", K(ret));
+    } else {
+      is_inited_ = true;
+      LOG_INFO("succeed to init micro block disk cache", K(dir), K(file_size), K(is_new_file),
+          "indexed_block_cnt", location_map_.size(), KPC(this));
+    }
+  }
+
+  if (OB_FAIL(ret) && !is_inited_) {
+    destroy();
+  }
+  return ret;
+}
+
+void ObMicroBlockDiskCache::destroy()
+{
+  if (is_inited_) {
+    // the flusher writes all full buffers before it exits
+    lib::ThreadPool::stop();
+    {
+      ObThreadCondGuard guard(flush_cond_);
+      flush_cond_.broadcast();
+    }
+    lib::ThreadPool::wait();
+    if (write_pos_ > static_cast<int64_t>(sizeof(SegmentHeader))) {
+      // keep blocks still in the write buffer for next start
+      flush(get_write_buffer(), write_pos_);
+    }
+  }
+  lib::ThreadPool::destroy();
+  if (fd_.is_valid()) {
+    (void) THE_IO_DEVICE->close(fd_);
+    fd_.reset();
+  }
+  flush_cond_.destroy();
+  if (nullptr != segment_fingerprints_) {
+    for (int64_t i = 0; i < segment_cnt_; ++i) {
+      segment_fingerprints_[i].~ObArray<uint64_t>();
+    }
+    ob_free(segment_fingerprints_);
+    segment_fingerprints_ = nullptr;
+  }
+  if (nullptr != segment_seqs_) {
+    ob_free(segment_seqs_);
+    segment_seqs_ = nullptr;
+  }
+  for (int64_t i = 0; i < WRITE_BUFFER_CNT; ++i) {
+    if (nullptr != buffers_[i].buf_) {
+      ob_free_align(buffers_[i].buf_);
+    }
+  }
+  MEMSET(buffers_, 0, sizeof(buffers_));
+  location_map_.destroy();
+  segment_cnt_ = 0;
+  max_seq_ = 0;
+  write_idx_ = 0;
+  flush_idx_ = 0;
+  write_pos_ = 0;
+  reported_drop_cnt_ = 0;
+  is_inited_ = false;
+}
+
+int ObMicroBlockDiskCache::append(
+    const ObMicroBlockCacheKey &key,
+    const ObMicroBlockDesMeta &des_meta,
+    const char *buf,
+    const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  const int64_t record_size = upper_align(sizeof(RecordHeader) + size, RECORD_ALIGN_SIZE);
+  bool need_signal = false;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("micro block disk cache not init", K(ret));
+  } else if (OB_ISNULL(buf) || OB_UNLIKELY(size <= 0 || !des_meta.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(size), K(des_meta));
+  } else if (OB_UNLIKELY(des_meta.is_encrypted())) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("encrypted micro block is not supported by disk cache", K(ret), K(key), K(des_meta));
+  } else if (OB_UNLIKELY(record_size > SEGMENT_SIZE - static_cast<int64_t>(sizeof(SegmentHeader)))) {
+    ret = OB_SIZE_OVERFLOW;
+    LOG_DEBUG("micro block too large for disk cache", K(ret), K(size));
+  } else {
+    ObSpinLockGuard guard(lock_);
+    if (write_pos_ + record_size > SEGMENT_SIZE) {
+      if (write_idx_ + 1 - ATOMIC_LOAD(&flush_idx_) >= WRITE_BUFFER_CNT) {
+        // the flusher falls behind, reported by the flusher
+        ret = OB_EAGAIN;
+        ATOMIC_INC(&drop_cnt_);
+      } else {
+        get_write_buffer().data_size_ = write_pos_;
+        switch_write_buffer();
+        need_signal = true;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      WriteBuffer &buffer = get_write_buffer();
+      RecordHeader *header = reinterpret_cast<RecordHeader *>(buffer.buf_ + write_pos_);
+      MEMSET(header, 0, sizeof(RecordHeader));
+      header->magic_ = RECORD_MAGIC;
+      header->row_store_type_ = static_cast<int16_t>(des_meta.row_store_type_);
+      header->compressor_type_ = static_cast<int16_t>(des_meta.compressor_type_);
+      header->seq_ = buffer.seq_;
+      make_record_key(key, header->key_);
+      header->data_size_ = size;
+      header->data_checksum_ = ob_crc64(buf, size);
+      header->checksum_ = ob_crc64(header, offsetof(RecordHeader, checksum_));
+      MEMCPY(reinterpret_cast<char *>(header) + sizeof(RecordHeader), buf, size);
+      write_pos_ += record_size;
+    }
+  }
+  if (need_signal) {
+    ObThreadCondGuard guard(flush_cond_);
+    flush_cond_.signal();
+  }
+  return ret;
+}
+
+void ObMicroBlockDiskCache::run1()
+{
+  lib::set_thread_name("MicroDiskFlush");
+  while (!has_set_stop() || ATOMIC_LOAD(&flush_idx_) < ATOMIC_LOAD(&write_idx_)) {
+    if (ATOMIC_LOAD(&flush_idx_) < ATOMIC_LOAD(&write_idx_)) {
+      WriteBuffer &buffer = buffers_[flush_idx_ % WRITE_BUFFER_CNT];
+      flush(buffer, buffer.data_size_);
+      // the buffer can be reused by append from now on
+      ATOMIC_INC(&flush_idx_);
+    } else {
+      ObThreadCondGuard guard(flush_cond_);
+      if (ATOMIC_LOAD(&flush_idx_) == ATOMIC_LOAD(&write_idx_) && !has_set_stop()) {
+        flush_cond_.wait_us(FLUSH_WAIT_INTERVAL_US);
+      }
+    }
+    const int64_t drop_cnt = ATOMIC_LOAD(&drop_cnt_);
+    if (drop_cnt > reported_drop_cnt_ && REACH_TIME_INTERVAL(10 * 1000 * 1000)) {
+      LOG_INFO("micro block disk cache drops blocks as the flusher falls behind",
+          "dropped_cnt", drop_cnt - reported_drop_cnt_, KPC(this));
+      reported_drop_cnt_ = drop_cnt;
+    }
+  }
+}
+
+int ObMicroBlockDiskCache::get(
+    const ObMicroBlockCacheKey &key,
+    ObIAllocator &allocator,
+    ObMicroBlockDesMeta &des_meta,
+    const char *&buf,
+    int64_t &size)
+{
+  int ret = OB_SUCCESS;
+  RecordKey record_key;
+  make_record_key(key, record_key);
+  const uint64_t fingerprint = get_fingerprint(record_key);
+  Location location;
+  const char *record = nullptr;
+  buf = nullptr;
+  size = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("micro block disk cache not init", K(ret));
+  } else if (OB_FAIL(location_map_.get_refactored(fingerprint, location))) {
+    if (OB_HASH_NOT_EXIST == ret) {
+      ret = OB_ENTRY_NOT_EXIST;
+    } else {
+      LOG_WARN("fail to get location", K(ret), K(key));
+    }
+  } else if (ATOMIC_LOAD(&segment_seqs_[location.segment_]) != location.seq_
+      || (!location.verified_ && !check_previous_block(record_key))) {
+    ret = OB_ENTRY_NOT_EXIST;
+    erase_location(fingerprint, location);
+  } else if (OB_FAIL(read_record(location, allocator, record))) {
+    LOG_WARN("fail to read record", K(ret), K(location));
+  } else {
+    const RecordHeader *header = reinterpret_cast<const RecordHeader *>(record);
+    const char *data = record + sizeof(RecordHeader);
+    if (RECORD_MAGIC != header->magic_
+        || header->checksum_ != ob_crc64(header, offsetof(RecordHeader, checksum_))
+        || header->seq_ != location.seq_
+        || 0 != MEMCMP(&header->key_, &record_key, sizeof(RecordKey))
+        || static_cast<int64_t>(sizeof(RecordHeader)) + header->data_size_ > location.size_
+        || header->data_checksum_ != ob_crc64(data, header->data_size_)
+        || ATOMIC_LOAD(&segment_seqs_[location.segment_]) != location.seq_) {
+      // the segment is rewritten or the key has the same fingerprint as another key
+      ret = OB_ENTRY_NOT_EXIST;
+      erase_location(fingerprint, location);
+    } else {
+      des_meta.row_store_type_ = static_cast<ObRowStoreType>(header->row_store_type_);
+      des_meta.compressor_type_ = static_cast<ObCompressorType>(header->compressor_type_);
+      des_meta.encrypt_id_ = 0;
+      des_meta.master_key_id_ = 0;
+      des_meta.encrypt_key_ = nullptr;
+      buf = data;
+      size = header->data_size_;
+      if (!location.verified_) {
+        location.verified_ = true;
+        (void) location_map_.set_refactored(fingerprint, location, 1 /* overwrite */);
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    ATOMIC_INC(&hit_cnt_);
+  } else if (OB_ENTRY_NOT_EXIST == ret) {
+    ATOMIC_INC(&miss_cnt_);
+  }
+  return ret;
+}
+
+void ObMicroBlockDiskCache::make_record_key(const ObMicroBlockCacheKey &key, RecordKey &record_key)
+{
+  const ObMicroBlockId &block_id = key.get_micro_block_id();
+  record_key.tenant_id_ = key.get_tenant_id();
+  record_key.first_id_ = block_id.macro_id_.first_id();
+  record_key.second_id_ = block_id.macro_id_.second_id();
+  record_key.third_id_ = block_id.macro_id_.third_id();
+  record_key.offset_ = block_id.offset_;
+  record_key.size_ = block_id.size_;
+}
+
+uint64_t ObMicroBlockDiskCache::get_fingerprint(const RecordKey &record_key)
+{
+  return murmurhash(&record_key, sizeof(RecordKey), 0);
+}
+
+int ObMicroBlockDiskCache::open_file(const char *dir, const int64_t file_size, bool &is_new_file)
+{
+  int ret = OB_SUCCESS;
+  char path[OB_MAX_FILE_NAME_LENGTH] = {0};
+  ObIODFileStat file_stat;
+  is_new_file = false;
+  if (OB_FAIL(FileDirectoryUtils::create_full_path(dir))) {
+    LOG_WARN("fail to create cache dir", K(ret), K(dir));
+  } else if (OB_FAIL(databuff_printf(path, sizeof(path), "%s/%s", dir, CACHE_FILE_NAME))) {
+    LOG_WARN("fail to make cache file path", K(ret), K(dir));
+  } else if (OB_FAIL(THE_IO_DEVICE->open(path, O_RDWR | O_CREAT | O_DIRECT, S_IRUSR | S_IWUSR, fd_))) {
+    LOG_WARN("fail to open cache file", K(ret), K(path));
+  } else if (FALSE_IT(fd_.device_handle_ = THE_IO_DEVICE)) {
+  } else if (OB_FAIL(THE_IO_DEVICE->fstat(fd_, file_stat))) {
+    LOG_WARN("fail to stat cache file", K(ret), K(path));
+  } else if (static_cast<int64_t>(file_stat.size_) != file_size) {
+    // size changed, segments can not be located any more
+    is_new_file = true;
+    if (OB_FAIL(THE_IO_DEVICE->truncate(path, 0))) {
+      LOG_WARN("fail to truncate cache file", K(ret), K(path));
+    } else if (OB_FAIL(THE_IO_DEVICE->truncate(path, file_size))) {
+      LOG_WARN("fail to extend cache file", K(ret), K(path), K(file_size));
+    } else {
+      LOG_INFO("create micro block disk cache file", K(path), K(file_size),
+          "old_size", file_stat.size_);
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDiskCache::load_segments()
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  char *buf = buffers_[0].buf_;
+  for (int64_t i = 0; OB_SUCC(ret) && i < segment_cnt_; ++i) {
+    const SegmentHeader *header = reinterpret_cast<const SegmentHeader *>(buf);
+    int64_t read_size = 0;
+    // loaded before the IO manager starts, read from the device directly
+    if (OB_TMP_FAIL(THE_IO_DEVICE->pread(fd_, i * SEGMENT_SIZE, SEGMENT_SIZE, buf, read_size))) {
+      LOG_WARN("fail to read segment, skip it", K(tmp_ret), K(i));
+    } else if (read_size < static_cast<int64_t>(sizeof(SegmentHeader))) {
+      // never written
+    } else if (SEGMENT_MAGIC != header->magic_
+        || header->checksum_ != ob_crc64(header, offsetof(SegmentHeader, checksum_))
+        || header->seq_ <= 0
+        || header->data_size_ > read_size) {
+      // never written or broken
+    } else if (OB_FAIL(index_segment(i, buf, false /* verified */))) {
+      LOG_WARN("fail to index segment", K(ret), K(i));
+    } else {
+      segment_seqs_[i] = header->seq_;
+      max_seq_ = MAX(max_seq_, header->seq_);
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDiskCache::index_segment(const int64_t segment, const char *buf, const bool verified)
+{
+  int ret = OB_SUCCESS;
+  const SegmentHeader *segment_header = reinterpret_cast<const SegmentHeader *>(buf);
+  ObArray<uint64_t> &fingerprints = segment_fingerprints_[segment];
+  int64_t pos = sizeof(SegmentHeader);
+  fingerprints.reuse();
+  while (OB_SUCC(ret) && pos + static_cast<int64_t>(sizeof(RecordHeader)) <= segment_header->data_size_) {
+    const RecordHeader *header = reinterpret_cast<const RecordHeader *>(buf + pos);
+    const int64_t record_size = upper_align(sizeof(RecordHeader) + header->data_size_, RECORD_ALIGN_SIZE);
+    if (RECORD_MAGIC != header->magic_
+        || header->checksum_ != ob_crc64(header, offsetof(RecordHeader, checksum_))
+        || header->seq_ != segment_header->seq_
+        || header->data_size_ <= 0
+        || pos + record_size > segment_header->data_size_) {
+      LOG_WARN("invalid record in segment, skip the rest", K(segment), K(pos), K(header->seq_));
+      break;
+    } else {
+      const uint64_t fingerprint = get_fingerprint(header->key_);
+      Location location;
+      if (OB_FAIL(location_map_.get_refactored(fingerprint, location))) {
+        if (OB_HASH_NOT_EXIST == ret) {
+          ret = OB_SUCCESS;
+        } else {
+          LOG_WARN("fail to get location", K(ret));
+        }
+      } else if (location.seq_ > header->seq_) {
+        // indexed by a newer segment when loading
+        ret = OB_ENTRY_EXIST;
+      }
+      if (OB_SUCC(ret)) {
+        location = Location(segment, pos, record_size, header->seq_, verified);
+        if (OB_FAIL(location_map_.set_refactored(fingerprint, location, 1 /* overwrite */))) {
+          LOG_WARN("fail to set location", K(ret), K(location));
+        } else if (OB_FAIL(fingerprints.push_back(fingerprint))) {
+          LOG_WARN("fail to push back fingerprint", K(ret));
+        }
+      } else if (OB_ENTRY_EXIST == ret) {
+        ret = OB_SUCCESS;
+      }
+      pos += record_size;
+    }
+  }
+  return ret;
+}
+
+void ObMicroBlockDiskCache::evict_segment(const int64_t segment, const int64_t seq)
+{
+  ObArray<uint64_t> &fingerprints = segment_fingerprints_[segment];
+  for (int64_t i = 0; i < fingerprints.count(); ++i) {
+    erase_location(fingerprints.at(i), Location(segment, 0, 0, seq, false));
+  }
+  fingerprints.reuse();
+}
+
+void ObMicroBlockDiskCache::switch_write_buffer()
+{
+  const int64_t segment = get_write_buffer().segment_;
+  WriteBuffer &next_buffer = buffers_[(write_idx_ + 1) % WRITE_BUFFER_CNT];
+  next_buffer.segment_ = (segment + 1) % segment_cnt_;
+  next_buffer.seq_ = ++max_seq_;
+  ATOMIC_INC(&write_idx_);
+  write_pos_ = sizeof(SegmentHeader);
+}
+
+void ObMicroBlockDiskCache::flush(WriteBuffer &buffer, const int64_t data_size)
+{
+  int ret = OB_SUCCESS;
+  const int64_t segment = buffer.segment_;
+  const int64_t old_seq = ATOMIC_LOAD(&segment_seqs_[segment]);
+  SegmentHeader *header = reinterpret_cast<SegmentHeader *>(buffer.buf_);
+  MEMSET(header, 0, sizeof(SegmentHeader));
+  header->magic_ = SEGMENT_MAGIC;
+  header->seq_ = buffer.seq_;
+  header->data_size_ = data_size;
+  header->checksum_ = ob_crc64(header, offsetof(SegmentHeader, checksum_));
+  // readers check the seq before and after reading the segment
+  ATOMIC_STORE(&segment_seqs_[segment], 0);
+  if (old_seq > 0) {
+    evict_segment(segment, old_seq);
+  }
+  if (OB_FAIL(write_segment(buffer, data_size))) {
+    LOG_WARN("fail to write segment", K(ret), K(segment), K(data_size));
+  } else if (OB_FAIL(index_segment(segment, buffer.buf_, true /* verified */))) {
+    LOG_WARN("fail to index segment", K(ret), K(segment));
+    evict_segment(segment, buffer.seq_);
+  } else {
+    ATOMIC_STORE(&segment_seqs_[segment], buffer.seq_);
+  }
+}
+
+int ObMicroBlockDiskCache::write_segment(const WriteBuffer &buffer, const int64_t data_size)
+{
+  int ret = OB_SUCCESS;
+  ObIOInfo io_info;
+  io_info.tenant_id_ = OB_SERVER_TENANT_ID;
+  io_info.fd_ = fd_;
+  io_info.offset_ = buffer.segment_ * SEGMENT_SIZE;
+  io_info.size_ = upper_align(data_size, DIO_ALIGN_SIZE);
+  io_info.buf_ = buffer.buf_;
+  io_info.flag_.set_write();
+  io_info.flag_.set_group_id(ObIOModule::MICRO_BLOCK_CACHE_IO);
+  io_info.flag_.set_wait_event(ObWaitEventIds::DB_FILE_COMPACT_WRITE);
+  io_info.timeout_us_ = GCONF._data_storage_io_timeout;
+  if (OB_FAIL(ObIOManager::get_instance().write(io_info))) {
+    LOG_WARN("fail to write cache file", K(ret), K(io_info));
+  }
+  return ret;
+}
+
+bool ObMicroBlockDiskCache::check_previous_block(const RecordKey &record_key) const
+{
+  // New blocks are written with larger sequence than any block in use when the device is
+  // first marked, so a block written before restart is still the same one if it is in use
+  // and its sequence is not larger.
+  int ret = OB_SUCCESS;
+  bool is_valid = false;
+  bool is_free = true;
+  const MacroBlockId macro_id(record_key.first_id_, record_key.second_id_, record_key.third_id_);
+  const int64_t start_write_seq = OB_SERVER_BLOCK_MGR.get_start_write_seq();
+  if (start_write_seq < 0 || macro_id.write_seq() > start_write_seq) {
+  } else if (OB_FAIL(OB_SERVER_BLOCK_MGR.check_macro_block_free(macro_id, is_free))) {
+    LOG_WARN("fail to check macro block free", K(ret), K(macro_id));
+  } else {
+    is_valid = !is_free;
+  }
+  return is_valid;
+}
+
+int ObMicroBlockDiskCache::read_record(
+    const Location &location,
+    ObIAllocator &allocator,
+    const char *&record)
+{
+  int ret = OB_SUCCESS;
+  char *buf = nullptr;
+  record = nullptr;
+  if (OB_ISNULL(buf = static_cast<char *>(allocator.alloc(location.size_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc read buffer", K(ret), K(location));
+  } else {
+    ObIOInfo io_info;
+    ObIOHandle io_handle;
+    io_info.tenant_id_ = OB_SERVER_TENANT_ID;
+    io_info.fd_ = fd_;
+    io_info.offset_ = location.segment_ * SEGMENT_SIZE + location.offset_;
+    io_info.size_ = location.size_;
+    io_info.user_data_buf_ = buf;
+    io_info.flag_.set_read();
+    io_info.flag_.set_group_id(ObIOModule::MICRO_BLOCK_CACHE_IO);
+    io_info.flag_.set_wait_event(ObWaitEventIds::DB_FILE_DATA_READ);
+    io_info.timeout_us_ = GCONF._data_storage_io_timeout;
+    if (OB_FAIL(ObIOManager::get_instance().read(io_info, io_handle))) {
+      LOG_WARN("fail to read cache file", K(ret), K(io_info));
+    } else if (OB_UNLIKELY(io_handle.get_data_size() != location.size_)) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("unexpected read size", K(ret), K(location), "read_size", io_handle.get_data_size());
+    } else {
+      record = buf;
+    }
+  }
+  return ret;
+}
+
+void ObMicroBlockDiskCache::erase_location(const uint64_t fingerprint, const Location &location)
+{
+  struct SameLocation
+  {
+    explicit SameLocation(const Location &location) : location_(location) {}
+    bool operator()(hash::HashMapPair<uint64_t, Location> &entry) const
+    {
+      return entry.second.segment_ == location_.segment_ && entry.second.seq_ == location_.seq_;
+    }
+    const Location &location_;
+  };
+  SameLocation pred(location);
+  bool is_erased = false;
+  (void) location_map_.erase_if(fingerprint, pred, is_erased);
+}
+
+} // namespace blocksstable
+} // namespace oceanbase
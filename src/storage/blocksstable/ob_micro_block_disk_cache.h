@@ -0,0 +1,183 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_MICRO_BLOCK_DISK_CACHE_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_MICRO_BLOCK_DISK_CACHE_H_
+
+#include "lib/hash/ob_hashmap.h"
+#include "lib/container/ob_array.h"
+#include "lib/lock/ob_spin_lock.h"
+#include "lib/lock/ob_thread_cond.h"
+#include "lib/thread/thread_pool.h"
+#include "common/ob_store_format.h"
+#include "common/storage/ob_io_device.h"
+
+namespace oceanbase
+{
+namespace common
+{
+class ObIAllocator;
+}
+namespace blocksstable
+{
+class ObMicroBlockCacheKey;
+struct ObMicroBlockDesMeta;
+
+// Second tier of the data micro block cache on a local disk.
+//
+// Decompressed micro blocks put to the memory cache are appended to a cache file, which is
+// split into segments of SEGMENT_SIZE and reused in FIFO order. Appends are copied into a
+// segment sized write buffer. A full buffer is handed to a background flusher, which writes
+// it through the IO manager, while appends go on into the other buffer. Blocks become visible
+// to get() after their segment is written, and are only dropped when the flusher falls behind
+// by a whole buffer. The index from key to location is only kept in memory and rebuilt by
+// scanning segments when the file is opened again after restart.
+//
+// The cache file is not encrypted, so blocks of encrypted tables must not be appended.
+//
+// Macro block ids may be reused across restart, so blocks written before restart are only
+// returned after checking their macro blocks are still in use, see check_previous_block.
+class ObMicroBlockDiskCache : public lib::ThreadPool
+{
+public:
+  static const int64_t SEGMENT_SIZE = 2L << 20;
+  static const int64_t DIO_ALIGN_SIZE = 4096;
+  ObMicroBlockDiskCache();
+  ~ObMicroBlockDiskCache();
+  // %file_size is rounded down to SEGMENT_SIZE, file in %dir written before is reused if
+  // its size does not change.
+  int init(const char *dir, const int64_t file_size);
+  void destroy();
+  bool is_inited() const { return is_inited_; }
+  // blocks are dropped with OB_EAGAIN if all write buffers are full, only compressor and
+  // row store type of %des_meta are kept, encrypted blocks are rejected
+  int append(
+      const ObMicroBlockCacheKey &key,
+      const ObMicroBlockDesMeta &des_meta,
+      const char *buf,
+      const int64_t size);
+  // %buf is allocated from %allocator
+  int get(
+      const ObMicroBlockCacheKey &key,
+      common::ObIAllocator &allocator,
+      ObMicroBlockDesMeta &des_meta,
+      const char *&buf,
+      int64_t &size);
+  virtual void run1() override;
+  TO_STRING_KV(K_(is_inited), K_(fd), K_(segment_cnt), K_(max_seq), K_(write_idx),
+               K_(flush_idx), K_(write_pos), K_(hit_cnt), K_(miss_cnt), K_(drop_cnt));
+
+private:
+  static const uint32_t SEGMENT_MAGIC = 0x4D424443; // MBDC
+  static const uint32_t RECORD_MAGIC = 0x4D424452;  // MBDR
+  static const int64_t RECORD_ALIGN_SIZE = 8;
+  static const int64_t AVG_RECORD_CNT_PER_SEGMENT = 32;
+  static const int64_t SEGMENT_FINGERPRINT_BLOCK_SIZE = 512;
+  static const int64_t WRITE_BUFFER_CNT = 2;
+  static const int64_t FLUSH_WAIT_INTERVAL_US = 100 * 1000;
+  static const char *CACHE_FILE_NAME;
+  struct SegmentHeader
+  {
+    uint32_t magic_;
+    uint32_t reserved_;
+    int64_t seq_;
+    int64_t data_size_; // including header
+    uint64_t checksum_;
+  };
+  // fields of the key, as the key itself has a virtual table
+  struct RecordKey
+  {
+    uint64_t tenant_id_;
+    int64_t first_id_;
+    int64_t second_id_;
+    int64_t third_id_;
+    int64_t offset_;
+    int64_t size_;
+  };
+  struct RecordHeader
+  {
+    uint32_t magic_;
+    int16_t row_store_type_;
+    int16_t compressor_type_;
+    int64_t seq_;
+    RecordKey key_;
+    int64_t data_size_;
+    uint64_t data_checksum_;
+    uint64_t checksum_;
+  };
+  struct Location
+  {
+    Location() : segment_(0), offset_(0), size_(0), seq_(0), verified_(false) {}
+    Location(const int64_t segment, const int64_t offset, const int64_t size, const int64_t seq,
+             const bool verified)
+      : segment_(segment), offset_(offset), size_(size), seq_(seq), verified_(verified) {}
+    TO_STRING_KV(K_(segment), K_(offset), K_(size), K_(seq), K_(verified));
+    int64_t segment_;
+    int64_t offset_; // of record header in segment
+    int64_t size_;   // of record
+    int64_t seq_;
+    bool verified_;
+  };
+  struct WriteBuffer
+  {
+    char *buf_;
+    int64_t segment_;
+    int64_t seq_;
+    int64_t data_size_; // set when the buffer is full
+  };
+  typedef common::hash::ObHashMap<uint64_t, Location> LocationMap;
+
+  static void make_record_key(const ObMicroBlockCacheKey &key, RecordKey &record_key);
+  static uint64_t get_fingerprint(const RecordKey &record_key);
+  int open_file(const char *dir, const int64_t file_size, bool &is_new_file);
+  int load_segments();
+  // index all records of a written segment
+  int index_segment(const int64_t segment, const char *buf, const bool verified);
+  // drop the index of the segment before it is rewritten
+  void evict_segment(const int64_t segment, const int64_t seq);
+  WriteBuffer &get_write_buffer() { return buffers_[write_idx_ % WRITE_BUFFER_CNT]; }
+  void switch_write_buffer();
+  void flush(WriteBuffer &buffer, const int64_t data_size);
+  int write_segment(const WriteBuffer &buffer, const int64_t data_size);
+  bool check_previous_block(const RecordKey &record_key) const;
+  int read_record(const Location &location, common::ObIAllocator &allocator, const char *&record);
+  void erase_location(const uint64_t fingerprint, const Location &location);
+
+private:
+  bool is_inited_;
+  common::ObIOFd fd_;
+  int64_t segment_cnt_;
+  // seq of data on each segment, 0 if the segment is empty or being rewritten
+  int64_t *segment_seqs_;
+  // fingerprints indexed on each segment, only accessed by the flushing thread
+  common::ObArray<uint64_t> *segment_fingerprints_;
+  LocationMap location_map_;
+  common::ObSpinLock lock_;
+  int64_t max_seq_;
+  // buffers_[write_idx_ % WRITE_BUFFER_CNT] is being appended, buffers from flush_idx_ to
+  // write_idx_ (excluded) are full and waiting for the flusher
+  WriteBuffer buffers_[WRITE_BUFFER_CNT];
+  int64_t write_idx_;
+  int64_t flush_idx_;
+  int64_t write_pos_;
+  common::ObThreadCond flush_cond_;
+  int64_t reported_drop_cnt_;
+  int64_t hit_cnt_;
+  int64_t miss_cnt_;
+  int64_t drop_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockDiskCache);
+};
+
+} // namespace blocksstable
+} // namespace oceanbase
+
+#endif // OCEANBASE_STORAGE_BLOCKSSTABLE_MICRO_BLOCK_DISK_CACHE_H_
@@ -25,6 +25,7 @@ ObStorageCacheSuite::ObStorageCacheSuite()
     bf_cache_(),
     fuse_row_cache_(),
     storage_meta_cache_(),
+    micro_block_disk_cache_(),
     is_inited_(false)
 {
 }
@@ -55,9 +56,11 @@ int ObStorageCacheSuite::init(
     STORAGE_LOG(WARN, "The cache suite has been inited, ", K(ret));
   } else if (OB_FAIL(index_block_cache_.init("index_block_cache", index_block_cache_priority))) {
     STORAGE_LOG(ERROR, "init infrc block cache failed", K(ret));
-  } else if (OB_FAIL(user_block_cache_.init("user_block_cache", user_block_cache_priority))) {
+  } else if (OB_FAIL(user_block_cache_.init("user_block_cache", user_block_cache_priority,
+                                            true /*enable_admission*/))) {
     STORAGE_LOG(ERROR, "init user block cache failed, ", K(ret));
-  } else if (OB_FAIL(user_row_cache_.init("user_row_cache", user_row_cache_priority))) {
+  } else if (OB_FAIL(user_row_cache_.init("user_row_cache", user_row_cache_priority,
+                                          true /*enable_admission*/))) {
     STORAGE_LOG(ERROR, "init user sstable row cache failed, ", K(ret));
   } else if (OB_FAIL(bf_cache_.init("bf_cache", bf_cache_priority))) {
     STORAGE_LOG(ERROR, "init bloom filter cache failed, ", K(ret));
@@ -115,8 +118,24 @@ int ObStorageCacheSuite::set_bf_cache_miss_count_threshold(const int64_t bf_cach
   return ret;
 }
 
+int ObStorageCacheSuite::init_micro_block_disk_cache(const char *dir, const int64_t file_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "The cache suite has not been inited, ", K(ret));
+  } else if (OB_FAIL(micro_block_disk_cache_.init(dir, file_size))) {
+    STORAGE_LOG(WARN, "fail to init micro block disk cache", K(ret), K(dir), K(file_size));
+  } else {
+    user_block_cache_.set_disk_cache(&micro_block_disk_cache_);
+  }
+  return ret;
+}
+
 void ObStorageCacheSuite::destroy()
 {
+  user_block_cache_.set_disk_cache(nullptr);
+  micro_block_disk_cache_.destroy();
   index_block_cache_.destroy();
   user_block_cache_.destroy();
   user_row_cache_.destroy();
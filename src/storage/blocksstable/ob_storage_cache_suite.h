@@ -19,6 +19,7 @@
 #include "ob_row_cache.h"
 #include "ob_fuse_row_cache.h"
 #include "ob_bloom_filter_cache.h"
+#include "ob_micro_block_disk_cache.h"
 
 #define OB_STORE_CACHE oceanbase::blocksstable::ObStorageCacheSuite::get_instance()
 
@@ -47,6 +48,8 @@ public:
       const int64_t bf_cache_priority,
       const int64_t storage_meta_cache_priority);
   int set_bf_cache_miss_count_threshold(const int64_t bf_cache_miss_count_threshold);
+  // optional second tier of user block cache on local disk
+  int init_micro_block_disk_cache(const char *dir, const int64_t file_size);
   ObDataMicroBlockCache &get_block_cache() { return user_block_cache_; }
   ObIndexMicroBlockCache &get_index_block_cache() { return index_block_cache_; }
   ObDataMicroBlockCache &get_micro_block_cache(const bool is_data_block)
@@ -67,6 +70,7 @@ private:
   ObBloomFilterCache bf_cache_;
   ObFuseRowCache fuse_row_cache_;
   ObStorageMetaCache storage_meta_cache_;
+  ObMicroBlockDiskCache micro_block_disk_cache_;
   bool is_inited_;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObStorageCacheSuite);
@@ -12,6 +12,7 @@
 
 #include "observer/omt/ob_tenant_config_mgr.h"
 #include "lib/stat/ob_diagnose_info.h"
+#include "lib/compress/ob_compressor_pool.h"
 #include "common/ob_smart_var.h"
 #include "storage/ob_file_system_router.h"
 #include "share/ob_task_define.h"
@@ -119,6 +120,17 @@ int ObTmpPageCacheValue::deep_copy(char *buf, const int64_t buf_len, ObIKVCacheV
   return ret;
 }
 
+void ObTmpBlockCompressInfo::reset()
+{
+  compressor_type_ = common::NONE_COMPRESSOR;
+  MEMSET(chunk_offsets_, 0, sizeof(chunk_offsets_));
+}
+
+int64_t ObTmpBlockCompressInfo::get_chunk_size()
+{
+  return CHUNK_PAGE_NUMS * ObTmpMacroBlock::get_default_page_size();
+}
+
 int ObTmpPageCache::prefetch(
     const ObTmpPageCacheKey &key,
     const ObTmpBlockIOInfo &info,
@@ -209,6 +221,59 @@ int ObTmpPageCache::prefetch(
   return ret;
 }
 
+int ObTmpPageCache::prefetch(
+    const ObTmpBlockIOInfo &info,
+    const ObTmpBlockCompressInfo &compress_info,
+    const int64_t start_chunk_idx,
+    const int64_t end_chunk_idx,
+    ObMacroBlockHandle &mb_handle,
+    common::ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!compress_info.is_compressed() || start_chunk_idx < 0 || start_chunk_idx > end_chunk_idx
+      || end_chunk_idx >= ObTmpBlockCompressInfo::MAX_CHUNK_NUMS)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "Invalid arguments", K(ret), K(compress_info), K(start_chunk_idx), K(end_chunk_idx));
+  } else {
+    void *buf = nullptr;
+    ObTmpCompressedPageIOCallback *callback = nullptr;
+    ObTmpBlockIOInfo chunk_info(info);
+    // just skip header and padding.
+    chunk_info.offset_ = compress_info.get_chunk_offset(start_chunk_idx) + ObTmpMacroBlock::get_header_padding();
+    chunk_info.size_ = compress_info.get_chunk_offset(end_chunk_idx + 1) - compress_info.get_chunk_offset(start_chunk_idx);
+    if (OB_ISNULL(buf = allocator.alloc(sizeof(ObTmpCompressedPageIOCallback)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      STORAGE_LOG(WARN, "allocate callback memory failed", K(ret));
+    } else {
+      callback = new (buf) ObTmpCompressedPageIOCallback;
+      callback->cache_ = this;
+      callback->offset_ = chunk_info.offset_;
+      callback->allocator_ = &allocator;
+      callback->block_id_ = info.block_id_;
+      callback->tenant_id_ = info.tenant_id_;
+      callback->start_chunk_idx_ = start_chunk_idx;
+      callback->end_chunk_idx_ = end_chunk_idx;
+      callback->compress_info_ = compress_info;
+      if (OB_FAIL(read_io(chunk_info, *callback, mb_handle))) {
+        if (mb_handle.get_io_handle().is_empty()) {
+          if (OB_FAIL(mb_handle.wait())) {
+            STORAGE_LOG(WARN, "fail to wait tmp page io", K(ret));
+          } else if (OB_FAIL(read_io(chunk_info, *callback, mb_handle))) {
+            STORAGE_LOG(WARN, "fail to read tmp page from io", K(ret));
+          }
+        } else {
+          STORAGE_LOG(WARN, "fail to read tmp page from io", K(ret));
+        }
+      }
+      if (OB_FAIL(ret) && OB_NOT_NULL(callback->get_allocator())) { //Avoid double_free with io_handle
+        callback->~ObTmpCompressedPageIOCallback();
+        allocator.free(callback);
+      }
+    }
+  }
+  return ret;
+}
+
 int ObTmpPageCache::get_cache_page(const ObTmpPageCacheKey &key, ObTmpPageValueHandle &handle)
 {
   int ret = OB_SUCCESS;
@@ -372,6 +437,95 @@ const char *ObTmpPageCache::ObTmpMultiPageIOCallback::get_data()
   return data_buf_;
 }
 
+ObTmpPageCache::ObTmpCompressedPageIOCallback::ObTmpCompressedPageIOCallback()
+  : block_id_(0), tenant_id_(0), start_chunk_idx_(0), end_chunk_idx_(0), compress_info_()
+{
+  static_assert(sizeof(*this) <= CALLBACK_BUF_SIZE, "IOCallback buf size not enough");
+}
+
+ObTmpPageCache::ObTmpCompressedPageIOCallback::~ObTmpCompressedPageIOCallback()
+{
+}
+
+int ObTmpPageCache::ObTmpCompressedPageIOCallback::inner_process(const char *data_buffer, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  ObTimeGuard time_guard("TmpCompressedPage_Callback_Process", 100000); //100ms
+  if (OB_ISNULL(cache_) || OB_ISNULL(allocator_)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "Invalid tmp page cache callback or allocator", KP_(cache), KP_(allocator), K(ret));
+  } else if (OB_UNLIKELY(size <= 0 || data_buffer == nullptr)) {
+    ret = OB_INVALID_DATA;
+    STORAGE_LOG(WARN, "invalid data buffer size", K(ret), K(size), KP(data_buffer));
+  } else if (OB_FAIL(decompress(data_buffer, size))) {
+    STORAGE_LOG(WARN, "fail to decompress tmp page chunks", K(ret), K(size), KPC(this));
+  } else if (FALSE_IT(time_guard.click("decompress"))) {
+  } else {
+    const int64_t page_size = ObTmpMacroBlock::get_default_page_size();
+    const int64_t start_page_id = start_chunk_idx_ * ObTmpBlockCompressInfo::CHUNK_PAGE_NUMS;
+    const int64_t end_page_id = (end_chunk_idx_ + 1) * ObTmpBlockCompressInfo::CHUNK_PAGE_NUMS;
+    for (int64_t page_id = start_page_id; OB_SUCC(ret) && page_id < end_page_id; ++page_id) {
+      ObTmpPageCacheKey key(block_id_, page_id, tenant_id_);
+      ObTmpPageCacheValue value(data_buf_ + (page_id - start_page_id) * page_size);
+      if (OB_FAIL(process_page(key, value))) {
+        STORAGE_LOG(WARN, "fail to process tmp page cache in callback", K(ret));
+      }
+    }
+    time_guard.click("process_page");
+  }
+  if (OB_FAIL(ret) && NULL != allocator_ && NULL != data_buf_) {
+    allocator_->free(data_buf_);
+    data_buf_ = NULL;
+  }
+  return ret;
+}
+
+int ObTmpPageCache::ObTmpCompressedPageIOCallback::decompress(const char *data_buffer, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  common::ObCompressor *compressor = nullptr;
+  const int64_t chunk_size = ObTmpBlockCompressInfo::get_chunk_size();
+  const int64_t data_size = compress_info_.get_chunk_offset(end_chunk_idx_ + 1)
+      - compress_info_.get_chunk_offset(start_chunk_idx_);
+  const int64_t buf_size = (end_chunk_idx_ - start_chunk_idx_ + 1) * chunk_size;
+  if (OB_UNLIKELY(size < data_size)) {
+    ret = OB_INVALID_DATA;
+    STORAGE_LOG(WARN, "tmp page chunks are incomplete", K(ret), K(size), K(data_size));
+  } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(compress_info_.compressor_type_, compressor))) {
+    STORAGE_LOG(WARN, "fail to get compressor", K(ret), K_(compress_info));
+  } else if (OB_ISNULL(data_buf_ = static_cast<char *>(allocator_->alloc(buf_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to allocate decompress buffer", K(ret), K(buf_size));
+  } else {
+    const char *src = data_buffer;
+    for (int64_t i = start_chunk_idx_; OB_SUCC(ret) && i <= end_chunk_idx_; ++i) {
+      const int64_t chunk_data_size = compress_info_.get_chunk_data_size(i);
+      char *dst = data_buf_ + (i - start_chunk_idx_) * chunk_size;
+      int64_t decomp_size = 0;
+      if (!compress_info_.is_chunk_compressed(i)) {
+        MEMCPY(dst, src, chunk_size);
+      } else if (OB_FAIL(compressor->decompress(src, chunk_data_size, dst, chunk_size, decomp_size))) {
+        STORAGE_LOG(WARN, "fail to decompress tmp page chunk", K(ret), K(i), K(chunk_data_size));
+      } else if (OB_UNLIKELY(chunk_size != decomp_size)) {
+        ret = OB_INVALID_DATA;
+        STORAGE_LOG(WARN, "decompressed size of tmp page chunk mismatch", K(ret), K(i), K(decomp_size));
+      }
+      src += chunk_data_size;
+    }
+  }
+  return ret;
+}
+
+int64_t ObTmpPageCache::ObTmpCompressedPageIOCallback::size() const
+{
+  return sizeof(*this);
+}
+
+const char *ObTmpPageCache::ObTmpCompressedPageIOCallback::get_data()
+{
+  return data_buf_;
+}
+
 int ObTmpPageCache::read_io(const ObTmpBlockIOInfo &io_info, ObITmpPageIOCallback &callback,
     ObMacroBlockHandle &handle)
 {
@@ -1331,12 +1485,26 @@ int ObTmpTenantMemBlockManager::wash_block(const int64_t block_id, ObIOWaitInfoH
   } else {
     ObTmpBlockIOInfo info;
     char *buf = NULL;
-    SpinWLockGuard io_guard(io_lock_);
+    char *compress_buf = NULL;
     ObMacroBlockHandle &mb_handle = m_blk->get_macro_block_handle();
+    // the block is not written any more once it is washing, compress it before taking io lock,
+    // so that io of other blocks is not blocked by the compression
     if (OB_FAIL(m_blk->get_wash_io_info(info))) {
       STORAGE_LOG(WARN, "fail to get wash io info", K(ret), K_(tenant_id), K(m_blk));
+    } else if (OB_FAIL(compress_block(get_tenant_compressor_type(), *m_blk, info, compress_buf))) {
+      STORAGE_LOG(WARN, "fail to compress tmp block", K(ret), K_(tenant_id), K(*m_blk));
+    }
+    SpinWLockGuard io_guard(io_lock_);
+    if (OB_FAIL(ret)) {
     } else if (OB_FAIL(write_io(info, mb_handle))) {
       STORAGE_LOG(WARN, "fail to write tmp block", K(ret), K_(tenant_id), K(info), K(*m_blk));
+    }
+    // the data to write has been copied into io request, the compress buffer can be freed now.
+    if (OB_NOT_NULL(compress_buf)) {
+      allocator_->free(compress_buf);
+      compress_buf = NULL;
+    }
+    if (OB_FAIL(ret)) {
     } else if(OB_ISNULL(buf = static_cast<char *>(allocator_->alloc(sizeof(IOWaitInfo))))) {
       ret = OB_ALLOCATE_MEMORY_FAILED;
       STORAGE_LOG(WARN, "fail to alloc io wait info memory", K(ret), K_(tenant_id));
@@ -1357,6 +1525,7 @@ int ObTmpTenantMemBlockManager::wash_block(const int64_t block_id, ObIOWaitInfoH
     }
     if (OB_FAIL(ret) && OB_NOT_NULL(m_blk)) {
       mb_handle.reset();
+      m_blk->get_compress_info().reset();
       // don't release wait info unless ObIOWaitInfoHandle doesn't hold its ref
       if (OB_NOT_NULL(wait_info) && OB_ISNULL(handle.get_wait_info())) {
         wait_info->~IOWaitInfo();
@@ -1400,6 +1569,91 @@ int ObTmpTenantMemBlockManager::write_io(
     } else if (OB_FAIL(OB_SERVER_BLOCK_MGR.update_write_time(handle.get_macro_id(),
         true/*update_to_max_time*/))) { //just to skip bad block inspect
       STORAGE_LOG(WARN, "fail to update macro id write time", K(ret), "macro id", handle.get_macro_id());
+    } else {
+      ObTenantStatEstGuard stat_guard(tenant_id_);
+      EVENT_ADD(ObStatEventIds::TMP_FILE_WASH_BYTES, ObTmpFileStore::get_block_size());
+      EVENT_ADD(ObStatEventIds::TMP_FILE_WASH_DISK_BYTES, io_info.size_);
+    }
+  }
+  return ret;
+}
+
+ObCompressorType ObTmpTenantMemBlockManager::get_tenant_compressor_type()
+{
+  int ret = OB_SUCCESS;
+  ObCompressorType compressor_type = NONE_COMPRESSOR;
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(tenant_id_));
+  if (!tenant_config.is_valid()) {
+    // no compression
+  } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor_type(
+      tenant_config->_temporary_file_compress_func, compressor_type))) {
+    STORAGE_LOG(WARN, "fail to get compressor type", K(ret), K_(tenant_id));
+    compressor_type = NONE_COMPRESSOR;
+  }
+  return compressor_type;
+}
+
+int ObTmpTenantMemBlockManager::compress_block(
+    const ObCompressorType compressor_type,
+    ObTmpMacroBlock &blk,
+    ObTmpBlockIOInfo &io_info,
+    char *&compress_buf)
+{
+  int ret = OB_SUCCESS;
+  ObCompressor *compressor = NULL;
+  int64_t max_overflow_size = 0;
+  const int64_t chunk_size = ObTmpBlockCompressInfo::get_chunk_size();
+  ObTmpBlockCompressInfo &compress_info = blk.get_compress_info();
+  compress_info.reset();
+  compress_buf = NULL;
+  if (NONE_COMPRESSOR == compressor_type || INVALID_COMPRESSOR == compressor_type) {
+  } else if (OB_UNLIKELY(io_info.size_ != chunk_size * ObTmpBlockCompressInfo::MAX_CHUNK_NUMS)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "unexpected tmp block size", K(ret), K(io_info));
+  } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(compressor_type, compressor))) {
+    STORAGE_LOG(WARN, "fail to get compressor", K(ret), K(compressor_type));
+  } else if (OB_FAIL(compressor->get_max_overflow_size(chunk_size, max_overflow_size))) {
+    STORAGE_LOG(WARN, "fail to get max overflow size", K(ret), K(compressor_type));
+  } else if (OB_ISNULL(compress_buf = static_cast<char *>(allocator_->alloc(io_info.size_ + max_overflow_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to alloc compress buffer", K(ret), K_(tenant_id));
+  } else {
+    int64_t pos = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < ObTmpBlockCompressInfo::MAX_CHUNK_NUMS; ++i) {
+      const char *src = io_info.buf_ + i * chunk_size;
+      int64_t data_size = 0;
+      if (OB_FAIL(compressor->compress(src, chunk_size, compress_buf + pos, chunk_size + max_overflow_size,
+          data_size))) {
+        STORAGE_LOG(WARN, "fail to compress tmp block chunk", K(ret), K(i), K(compressor_type));
+      } else {
+        if (data_size >= chunk_size) {
+          // keep the chunk uncompressed
+          MEMCPY(compress_buf + pos, src, chunk_size);
+          data_size = chunk_size;
+        }
+        compress_info.chunk_offsets_[i] = static_cast<int32_t>(pos);
+        pos += data_size;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      const int64_t write_size = upper_align(pos, DIO_ALIGN_SIZE);
+      compress_info.chunk_offsets_[ObTmpBlockCompressInfo::MAX_CHUNK_NUMS] = static_cast<int32_t>(pos);
+      if (write_size < io_info.size_) {
+        compress_info.compressor_type_ = compressor_type;
+        io_info.buf_ = compress_buf;
+        io_info.size_ = write_size;
+      }
+    }
+  }
+  if (OB_FAIL(ret) || !compress_info.is_compressed()) {
+    if (OB_FAIL(ret)) {
+      STORAGE_LOG(WARN, "fail to compress tmp block, write it uncompressed", K(ret), K_(tenant_id), K(blk));
+      ret = OB_SUCCESS;
+    }
+    compress_info.reset();
+    if (OB_NOT_NULL(compress_buf)) {
+      allocator_->free(compress_buf);
+      compress_buf = NULL;
     }
   }
   return ret;
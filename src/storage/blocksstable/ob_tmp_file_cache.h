@@ -13,6 +13,7 @@
 #ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_TMP_FILE_CACHE_H_
 #define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_TMP_FILE_CACHE_H_
 
+#include "lib/compress/ob_compress_util.h"
 #include "lib/hash/ob_hashmap.h"
 #include "lib/queue/ob_link_queue.h"
 #include "share/io/ob_io_manager.h"
@@ -98,6 +99,40 @@ public:
   ObTmpPageCacheKey key_;
 };
 
+// Layout of the pages of a washed block on disk.
+//
+// Pages are compressed in chunks of CHUNK_PAGE_NUMS pages, and the chunks are stored one after
+// another behind the header padding. A chunk which can not be compressed smaller is stored as it
+// is. Tmp files are not reused after restart, so the layout is only kept in memory.
+struct ObTmpBlockCompressInfo final
+{
+public:
+  static const int64_t CHUNK_PAGE_NUMS = 12;
+  static const int64_t MAX_CHUNK_NUMS = 21;
+  ObTmpBlockCompressInfo() { reset(); }
+  ~ObTmpBlockCompressInfo() = default;
+  void reset();
+  static int64_t get_chunk_size();
+  OB_INLINE bool is_compressed() const
+  {
+    return common::NONE_COMPRESSOR != compressor_type_ && common::INVALID_COMPRESSOR != compressor_type_;
+  }
+  OB_INLINE int64_t get_chunk_offset(const int64_t chunk_idx) const { return chunk_offsets_[chunk_idx]; }
+  OB_INLINE int64_t get_chunk_data_size(const int64_t chunk_idx) const
+  {
+    return chunk_offsets_[chunk_idx + 1] - chunk_offsets_[chunk_idx];
+  }
+  OB_INLINE bool is_chunk_compressed(const int64_t chunk_idx) const
+  {
+    return get_chunk_data_size(chunk_idx) < get_chunk_size();
+  }
+  OB_INLINE int64_t get_data_size() const { return chunk_offsets_[MAX_CHUNK_NUMS]; }
+  TO_STRING_KV(K_(compressor_type), "data_size", get_data_size());
+
+  common::ObCompressorType compressor_type_;
+  int32_t chunk_offsets_[MAX_CHUNK_NUMS + 1]; // offsets of chunks behind header padding
+};
+
 class ObTmpPageCache final : public common::ObKVCache<ObTmpPageCacheKey, ObTmpPageCacheValue>
 {
 public:
@@ -115,6 +150,15 @@ public:
       const common::ObIArray<ObTmpPageIOInfo> &page_io_infos,
       ObMacroBlockHandle &mb_handle,
       common::ObIAllocator &allocator);
+  // read chunks [start_chunk_idx, end_chunk_idx] of a compressed block, all pages of them are
+  // put into cache.
+  int prefetch(
+      const ObTmpBlockIOInfo &info,
+      const ObTmpBlockCompressInfo &compress_info,
+      const int64_t start_chunk_idx,
+      const int64_t end_chunk_idx,
+      ObMacroBlockHandle &mb_handle,
+      common::ObIAllocator &allocator);
   int get_cache_page(const ObTmpPageCacheKey &key, ObTmpPageValueHandle &handle);
   int get_page(const ObTmpPageCacheKey &key, ObTmpPageValueHandle &handle);
   int put_page(const ObTmpPageCacheKey &key, const ObTmpPageCacheValue &value);
@@ -166,6 +210,26 @@ public:
     friend class ObTmpPageCache;
     common::ObArray<ObTmpPageIOInfo> page_io_infos_;
   };
+  class ObTmpCompressedPageIOCallback final : public ObITmpPageIOCallback
+  {
+  public:
+    ObTmpCompressedPageIOCallback();
+    ~ObTmpCompressedPageIOCallback();
+    int64_t size() const override;
+    int inner_process(const char *data_buffer, const int64_t size) override;
+    const char *get_data() override;
+    TO_STRING_KV("callback_type:", "ObTmpCompressedPageIOCallback", KP_(data_buf), K_(block_id),
+        K_(start_chunk_idx), K_(end_chunk_idx), K_(compress_info));
+    DISALLOW_COPY_AND_ASSIGN(ObTmpCompressedPageIOCallback);
+  private:
+    friend class ObTmpPageCache;
+    int decompress(const char *data_buffer, const int64_t size);
+    int64_t block_id_;
+    uint64_t tenant_id_;
+    int64_t start_chunk_idx_;
+    int64_t end_chunk_idx_;
+    ObTmpBlockCompressInfo compress_info_;
+  };
 private:
   ObTmpPageCache();
   ~ObTmpPageCache();
@@ -419,6 +483,14 @@ private:
   int write_io(
       const ObTmpBlockIOInfo &io_info,
       ObMacroBlockHandle &handle);
+  common::ObCompressorType get_tenant_compressor_type();
+  // compress the pages of block into %compress_buf by chunks and point %io_info to it, the block
+  // is written as it is if compression helps nothing.
+  int compress_block(
+      const common::ObCompressorType compressor_type,
+      ObTmpMacroBlock &blk,
+      ObTmpBlockIOInfo &io_info,
+      char *&compress_buf);
   int64_t get_tenant_mem_block_num();
   int check_memory_limit();
   int get_block_from_dir_cache(const int64_t dir_id, const int64_t tenant_id,
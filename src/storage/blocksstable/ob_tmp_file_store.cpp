@@ -14,6 +14,7 @@
 #include "ob_tmp_file.h"
 #include "share/ob_task_define.h"
 #include "observer/omt/ob_tenant_config_mgr.h"
+#include "lib/stat/ob_diagnose_info.h"
 
 using namespace oceanbase::share;
 
@@ -23,6 +24,8 @@ namespace blocksstable
 {
 
 const int64_t ObTmpMacroBlock::DEFAULT_PAGE_SIZE = 8192L; // 8kb
+static_assert(ObTmpBlockCompressInfo::CHUNK_PAGE_NUMS * ObTmpBlockCompressInfo::MAX_CHUNK_NUMS
+    == ObTmpFilePageBuddy::MAX_PAGE_NUMS, "chunks of compressed tmp block must cover all pages");
 
 ObTmpFilePageBuddy::ObTmpFilePageBuddy()
   : is_inited_(false),
@@ -420,6 +423,7 @@ ObTmpMacroBlock::ObTmpMacroBlock()
     macro_block_handle_(),
     tmp_file_header_(),
     io_desc_(),
+    compress_info_(),
     block_status_(MAX),
     is_sealed_(false),
     is_inited_(false),
@@ -464,6 +468,7 @@ void ObTmpMacroBlock::destroy()
   page_buddy_.destroy();
   macro_block_handle_.reset();
   tmp_file_header_.reset();
+  compress_info_.reset();
   buffer_ = NULL;
   handle_.reset();
   ATOMIC_STORE(&block_status_, MAX);
@@ -1347,7 +1352,35 @@ int ObTmpTenantFileStore::read_page(ObTmpMacroBlock *block, ObTmpBlockIOInfo &io
   }
 
   if (OB_SUCC(ret)) {
-    if (page_io_infos->count() > DEFAULT_PAGE_IO_MERGE_RATIO * page_nums) {
+    const ObTmpBlockCompressInfo &compress_info = block->get_compress_info();
+    if (compress_info.is_compressed()) {
+      if (page_io_infos->count() > 0) {
+        // pages of compressed block are read by chunks, one io for all chunks of the missed pages.
+        ObMacroBlockHandle mb_handle;
+        ObTmpBlockIOInfo info(io_info);
+        const int64_t chunk_size = ObTmpBlockCompressInfo::get_chunk_size();
+        const int64_t start_chunk_idx = page_io_infos->at(0).key_.get_page_id()
+            / ObTmpBlockCompressInfo::CHUNK_PAGE_NUMS;
+        const int64_t end_chunk_idx = page_io_infos->at(page_io_infos->count() - 1).key_.get_page_id()
+            / ObTmpBlockCompressInfo::CHUNK_PAGE_NUMS;
+        const int64_t begin = std::max(io_info.offset_, start_chunk_idx * chunk_size);
+        const int64_t end = std::min(io_info.offset_ + io_info.size_, (end_chunk_idx + 1) * chunk_size);
+        info.macro_block_id_ = block->get_macro_block_id();
+        if (OB_FAIL(page_cache_->prefetch(info, compress_info, start_chunk_idx, end_chunk_idx, mb_handle,
+            io_allocator_))) {
+          STORAGE_LOG(WARN, "fail to prefetch compressed tmp page", K(ret), K(compress_info),
+              K(start_chunk_idx), K(end_chunk_idx));
+        } else {
+          EVENT_ADD(ObStatEventIds::TMP_FILE_READ_DISK_BYTES, compress_info.get_chunk_offset(end_chunk_idx + 1)
+              - compress_info.get_chunk_offset(start_chunk_idx));
+          ObTmpFileIOHandle::ObIOReadHandle read_handle(mb_handle, io_info.buf_ + begin - io_info.offset_,
+              begin - start_chunk_idx * chunk_size, end - begin);
+          if (OB_FAIL(handle.get_io_handles().push_back(read_handle))) {
+            STORAGE_LOG(WARN, "Fail to push back into read_handles", K(ret));
+          }
+        }
+      }
+    } else if (page_io_infos->count() > DEFAULT_PAGE_IO_MERGE_RATIO * page_nums) {
       // merge multi page io into one.
       ObMacroBlockHandle mb_handle;
       ObTmpBlockIOInfo info(io_info);
@@ -1359,6 +1392,7 @@ int ObTmpTenantFileStore::read_page(ObTmpMacroBlock *block, ObTmpBlockIOInfo &io
       if (OB_FAIL(page_cache_->prefetch(info, *page_io_infos, mb_handle, io_allocator_))) {
         STORAGE_LOG(WARN, "fail to prefetch multi tmp page", K(ret));
       } else {
+        EVENT_ADD(ObStatEventIds::TMP_FILE_READ_DISK_BYTES, info.size_);
         ObTmpFileIOHandle::ObIOReadHandle read_handle(mb_handle, io_info.buf_,
             io_info.offset_ - p_offset, io_info.size_);
         if (OB_FAIL(handle.get_io_handles().push_back(read_handle))) {
@@ -1378,6 +1412,7 @@ int ObTmpTenantFileStore::read_page(ObTmpMacroBlock *block, ObTmpBlockIOInfo &io
         if (OB_FAIL(page_cache_->prefetch(page_io_infos->at(i).key_, info, mb_handle, io_allocator_))) {
           STORAGE_LOG(WARN, "fail to prefetch tmp page", K(ret));
         } else {
+          EVENT_ADD(ObStatEventIds::TMP_FILE_READ_DISK_BYTES, info.size_);
           char *buf = io_info.buf_ + ObTmpMacroBlock::calculate_offset(
               page_io_infos->at(i).key_.get_page_id(), page_io_infos->at(i).offset_) - io_info.offset_;
           ObTmpFileIOHandle::ObIOReadHandle read_handle(mb_handle, buf, page_io_infos->at(i).offset_,
@@ -184,6 +184,8 @@ public:
     }
     return (double) get_used_page_nums() * (cur_time - get_alloc_time()) / (get_access_time() - get_alloc_time());
   }
+  OB_INLINE ObTmpBlockCompressInfo &get_compress_info() { return compress_info_; }
+  OB_INLINE const ObTmpBlockCompressInfo &get_compress_info() const { return compress_info_; }
   common::ObIArray<ObTmpFileExtent *> &get_extents() { return using_extents_; }
   ObTmpBlockValueHandle &get_handle() { return handle_; }
   bool is_empty() const { return page_buddy_.is_empty(); }
@@ -192,7 +194,7 @@ public:
   int give_back_buf_into_cache(const bool is_wash = false);
 
   TO_STRING_KV(KP_(buffer), K_(page_buddy), K_(handle), K_(macro_block_handle), K_(tmp_file_header),
-      K_(io_desc), K_(block_status), K_(is_inited), K_(alloc_time), K_(access_time));
+      K_(io_desc), K_(block_status), K_(is_inited), K_(alloc_time), K_(access_time), K_(compress_info));
 private:
   bool is_sealed() const { return ATOMIC_LOAD(&is_sealed_); }
 private:
@@ -204,6 +206,7 @@ private:
   ObMacroBlockHandle macro_block_handle_;
   ObTmpFileMacroBlockHeader tmp_file_header_;
   common::ObIOFlag io_desc_;
+  ObTmpBlockCompressInfo compress_info_; // set when the block is washed
   common::SpinRWLock lock_;
   BlockStatus block_status_;
   bool is_sealed_;
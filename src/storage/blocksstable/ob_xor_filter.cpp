@@ -0,0 +1,347 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_xor_filter.h"
+#include <algorithm>
+#include <cmath>
+#include "lib/utility/serialization.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace blocksstable
+{
+
+ObXorFilter::ObXorFilter()
+  : allocator_(ObModIds::OB_BLOOM_FILTER),
+    seed_(0),
+    segment_length_(0),
+    segment_length_mask_(0),
+    segment_count_length_(0),
+    array_length_(0),
+    fingerprints_(nullptr)
+{
+}
+
+ObXorFilter::~ObXorFilter()
+{
+  destroy();
+}
+
+void ObXorFilter::destroy()
+{
+  allocator_.reset();
+  seed_ = 0;
+  segment_length_ = 0;
+  segment_length_mask_ = 0;
+  segment_count_length_ = 0;
+  array_length_ = 0;
+  fingerprints_ = nullptr;
+}
+
+int ObXorFilter::init(uint64_t *key_hashes, const int64_t count)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(is_valid())) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("xor filter has been inited", K(ret), KPC(this));
+  } else if (OB_UNLIKELY(nullptr == key_hashes || count <= 0 || count > UINT32_MAX / 2)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(key_hashes), K(count));
+  } else {
+    std::sort(key_hashes, key_hashes + count);
+    const int64_t unique_count = std::unique(key_hashes, key_hashes + count) - key_hashes;
+    calc_layout(unique_count);
+    if (OB_ISNULL(fingerprints_ = static_cast<uint8_t *>(allocator_.alloc(array_length_)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc fingerprints", K(ret), K_(array_length));
+    } else if (FALSE_IT(MEMSET(fingerprints_, 0, array_length_))) {
+    } else if (OB_FAIL(populate(key_hashes, unique_count))) {
+      if (OB_NOT_SUPPORTED != ret) {
+        LOG_WARN("failed to populate xor filter", K(ret), K(unique_count));
+      }
+    }
+    if (OB_FAIL(ret)) {
+      destroy();
+    }
+  }
+  return ret;
+}
+
+void ObXorFilter::calc_layout(const int64_t count)
+{
+  const int64_t arity = 3;
+  int64_t segment_length = count <= 1
+      ? 4 : 1L << static_cast<int64_t>(std::floor(std::log(static_cast<double>(count)) / std::log(3.33) + 2.25));
+  segment_length = min(segment_length, static_cast<int64_t>(MAX_SEGMENT_LENGTH));
+  int64_t capacity = 0;
+  if (count > 1) {
+    const double size_factor = std::max(1.125, 0.875 + 0.25 * std::log(1000000.0) / std::log(static_cast<double>(count)));
+    capacity = static_cast<int64_t>(std::round(static_cast<double>(count) * size_factor));
+  }
+  int64_t segment_count = (capacity + segment_length - 1) / segment_length;
+  segment_count = segment_count <= arity - 1 ? 1 : segment_count - (arity - 1);
+  segment_length_ = static_cast<uint32_t>(segment_length);
+  segment_length_mask_ = segment_length_ - 1;
+  segment_count_length_ = static_cast<uint32_t>(segment_count * segment_length);
+  array_length_ = static_cast<uint32_t>((segment_count + arity - 1) * segment_length);
+}
+
+uint64_t ObXorFilter::next_seed(uint64_t &seed_state)
+{
+  uint64_t z = (seed_state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+// Keys are mapped to 3 slots each. A slot referenced by only one key is peeled off together
+// with its key repeatedly until no key is left, then fingerprints are assigned in the reverse
+// order of peeling, so that the 3 slots of each key xor to its fingerprint. Keys are placed in
+// order of their hashes first to make the accesses to the slots sequential.
+int ObXorFilter::populate(const uint64_t *key_hashes, const int64_t count)
+{
+  int ret = OB_SUCCESS;
+  ObArenaAllocator tmp_allocator(ObModIds::OB_BLOOM_FILTER);
+  const int64_t capacity = array_length_;
+  int64_t block_bits = 1;
+  while ((1L << block_bits) < segment_count_length_ / segment_length_) {
+    ++block_bits;
+  }
+  const int64_t block = 1L << block_bits;
+  uint64_t *reverse_order = static_cast<uint64_t *>(tmp_allocator.alloc(sizeof(uint64_t) * (count + 1)));
+  uint8_t *reverse_h = static_cast<uint8_t *>(tmp_allocator.alloc(sizeof(uint8_t) * count));
+  uint32_t *alone = static_cast<uint32_t *>(tmp_allocator.alloc(sizeof(uint32_t) * capacity));
+  uint8_t *t2count = static_cast<uint8_t *>(tmp_allocator.alloc(sizeof(uint8_t) * capacity));
+  uint64_t *t2hash = static_cast<uint64_t *>(tmp_allocator.alloc(sizeof(uint64_t) * capacity));
+  int64_t *start_pos = static_cast<int64_t *>(tmp_allocator.alloc(sizeof(int64_t) * block));
+  if (OB_ISNULL(reverse_order) || OB_ISNULL(reverse_h) || OB_ISNULL(alone)
+      || OB_ISNULL(t2count) || OB_ISNULL(t2hash) || OB_ISNULL(start_pos)) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc memory to build xor filter", K(ret), K(count), K(capacity));
+  } else {
+    uint64_t seed_state = 0x726b2b9d438b9d4dULL;
+    uint32_t h012[5];
+    bool is_succ = false;
+    for (int64_t loop = 0; !is_succ && loop < MAX_BUILD_ITERATIONS; ++loop) {
+      seed_ = next_seed(seed_state);
+      MEMSET(reverse_order, 0, sizeof(uint64_t) * count);
+      MEMSET(t2count, 0, sizeof(uint8_t) * capacity);
+      MEMSET(t2hash, 0, sizeof(uint64_t) * capacity);
+      reverse_order[count] = 1; // sentinel
+      for (int64_t i = 0; i < block; ++i) {
+        start_pos[i] = (i * count) >> block_bits;
+      }
+      for (int64_t i = 0; i < count; ++i) {
+        const uint64_t hash = mix(key_hashes[i]);
+        uint64_t segment_idx = hash >> (64 - block_bits);
+        while (0 != reverse_order[start_pos[segment_idx]]) {
+          segment_idx = (segment_idx + 1) & (block - 1);
+        }
+        reverse_order[start_pos[segment_idx]] = hash;
+        ++start_pos[segment_idx];
+      }
+      bool is_overflow = false;
+      for (int64_t i = 0; i < count; ++i) {
+        const uint64_t hash = reverse_order[i];
+        for (int64_t j = 0; j < 3; ++j) {
+          const uint32_t h = calc_position(j, hash);
+          t2count[h] = static_cast<uint8_t>((t2count[h] + 4) ^ j);
+          t2hash[h] ^= hash;
+          is_overflow = is_overflow || t2count[h] < 4;
+        }
+      }
+      if (is_overflow) {
+        continue;
+      }
+      int64_t queue_size = 0;
+      for (int64_t i = 0; i < capacity; ++i) {
+        alone[queue_size] = static_cast<uint32_t>(i);
+        queue_size += (1 == (t2count[i] >> 2)) ? 1 : 0;
+      }
+      int64_t stack_size = 0;
+      while (queue_size > 0) {
+        const uint32_t idx = alone[--queue_size];
+        if (1 == (t2count[idx] >> 2)) {
+          const uint64_t hash = t2hash[idx];
+          const uint8_t found = t2count[idx] & 3;
+          reverse_h[stack_size] = found;
+          reverse_order[stack_size] = hash;
+          ++stack_size;
+          calc_positions(hash, h012[0], h012[1], h012[2]);
+          h012[3] = h012[0];
+          h012[4] = h012[1];
+          for (int64_t j = 1; j <= 2; ++j) {
+            const uint32_t other_idx = h012[found + j];
+            alone[queue_size] = other_idx;
+            queue_size += (2 == (t2count[other_idx] >> 2)) ? 1 : 0;
+            t2count[other_idx] = static_cast<uint8_t>((t2count[other_idx] - 4) ^ ((found + j) % 3));
+            t2hash[other_idx] ^= hash;
+          }
+        }
+      }
+      if (stack_size == count) {
+        for (int64_t i = count - 1; i >= 0; --i) {
+          const uint64_t hash = reverse_order[i];
+          const uint8_t found = reverse_h[i];
+          calc_positions(hash, h012[0], h012[1], h012[2]);
+          h012[3] = h012[0];
+          h012[4] = h012[1];
+          fingerprints_[h012[found]] = static_cast<uint8_t>(
+              fingerprint(hash) ^ fingerprints_[h012[found + 1]] ^ fingerprints_[h012[found + 2]]);
+        }
+        is_succ = true;
+      }
+    }
+    if (!is_succ) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_INFO("failed to build xor filter in limited iterations", K(ret), K(count), KPC(this));
+    }
+  }
+  return ret;
+}
+
+void ObXorFilter::may_contain(const uint64_t *key_hashes, const int64_t count, bool *is_contain) const
+{
+  static const int64_t BATCH_SIZE = 16;
+  uint64_t hashes[BATCH_SIZE];
+  uint32_t positions[BATCH_SIZE][3];
+  for (int64_t start = 0; start < count; start += BATCH_SIZE) {
+    const int64_t batch_size = min(count - start, BATCH_SIZE);
+    // calculate all positions and issue the loads first, so that cache misses of the batch
+    // are served in parallel
+    for (int64_t i = 0; i < batch_size; ++i) {
+      hashes[i] = mix(key_hashes[start + i]);
+      calc_positions(hashes[i], positions[i][0], positions[i][1], positions[i][2]);
+      __builtin_prefetch(fingerprints_ + positions[i][0]);
+      __builtin_prefetch(fingerprints_ + positions[i][1]);
+      __builtin_prefetch(fingerprints_ + positions[i][2]);
+    }
+    for (int64_t i = 0; i < batch_size; ++i) {
+      is_contain[start + i] = 0 == static_cast<uint8_t>(fingerprint(hashes[i])
+          ^ fingerprints_[positions[i][0]] ^ fingerprints_[positions[i][1]] ^ fingerprints_[positions[i][2]]);
+    }
+  }
+}
+
+int ObXorFilter::deep_copy(const ObXorFilter &other)
+{
+  int ret = OB_SUCCESS;
+  char *buf = nullptr;
+  if (OB_UNLIKELY(is_valid())) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("xor filter has been inited", K(ret), KPC(this));
+  } else if (OB_ISNULL(buf = static_cast<char *>(allocator_.alloc(other.get_deep_copy_size())))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc fingerprints", K(ret), K(other));
+  } else if (OB_FAIL(deep_copy(other, buf))) {
+    LOG_WARN("failed to deep copy xor filter", K(ret), K(other));
+  }
+  return ret;
+}
+
+int ObXorFilter::deep_copy(const ObXorFilter &other, char *buf)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!other.is_valid() || nullptr == buf)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(other), KP(buf));
+  } else {
+    seed_ = other.seed_;
+    segment_length_ = other.segment_length_;
+    segment_length_mask_ = other.segment_length_mask_;
+    segment_count_length_ = other.segment_count_length_;
+    array_length_ = other.array_length_;
+    fingerprints_ = reinterpret_cast<uint8_t *>(buf);
+    MEMCPY(fingerprints_, other.fingerprints_, array_length_);
+  }
+  return ret;
+}
+
+DEFINE_SERIALIZE(ObXorFilter)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_valid())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected invalid xor filter to serialize", K(ret), KPC(this));
+  } else if (OB_FAIL(serialization::encode_i64(buf, buf_len, pos, static_cast<int64_t>(seed_)))) {
+    LOG_WARN("failed to encode seed", K(ret), K(buf_len), K(pos));
+  } else if (OB_FAIL(serialization::encode_vi32(buf, buf_len, pos, segment_length_))) {
+    LOG_WARN("failed to encode segment length", K(ret), K(buf_len), K(pos));
+  } else if (OB_FAIL(serialization::encode_vi32(buf, buf_len, pos, segment_count_length_))) {
+    LOG_WARN("failed to encode segment count length", K(ret), K(buf_len), K(pos));
+  } else if (OB_FAIL(serialization::encode_vstr(buf, buf_len, pos, fingerprints_, array_length_))) {
+    LOG_WARN("failed to encode fingerprints", K(ret), K(buf_len), K(pos));
+  }
+  return ret;
+}
+
+DEFINE_DESERIALIZE(ObXorFilter)
+{
+  int ret = OB_SUCCESS;
+  int64_t seed = 0;
+  int32_t segment_length = 0;
+  int32_t segment_count_length = 0;
+  destroy();
+  if (OB_ISNULL(buf) || OB_UNLIKELY(data_len <= pos)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument to deserialize xor filter", K(ret), KP(buf), K(data_len), K(pos));
+  } else if (OB_FAIL(serialization::decode_i64(buf, data_len, pos, &seed))) {
+    LOG_WARN("failed to decode seed", K(ret), K(data_len), K(pos));
+  } else if (OB_FAIL(serialization::decode_vi32(buf, data_len, pos, &segment_length))) {
+    LOG_WARN("failed to decode segment length", K(ret), K(data_len), K(pos));
+  } else if (OB_FAIL(serialization::decode_vi32(buf, data_len, pos, &segment_count_length))) {
+    LOG_WARN("failed to decode segment count length", K(ret), K(data_len), K(pos));
+  } else if (OB_UNLIKELY(segment_length <= 0 || segment_length > MAX_SEGMENT_LENGTH
+      || 0 != (segment_length & (segment_length - 1))
+      || segment_count_length <= 0 || 0 != segment_count_length % segment_length)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid xor filter layout", K(ret), K(segment_length), K(segment_count_length));
+  } else {
+    const int64_t array_length = segment_count_length + 2L * segment_length;
+    int64_t decode_length = 0;
+    if (OB_ISNULL(fingerprints_ = static_cast<uint8_t *>(allocator_.alloc(array_length)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc fingerprints", K(ret), K(array_length));
+    } else if (OB_ISNULL(serialization::decode_vstr(buf, data_len, pos,
+        reinterpret_cast<char *>(fingerprints_), array_length, &decode_length))) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("failed to decode fingerprints", K(ret), K(data_len), K(pos));
+    } else if (OB_UNLIKELY(array_length != decode_length)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("unexpected fingerprints length", K(ret), K(array_length), K(decode_length));
+    } else {
+      seed_ = static_cast<uint64_t>(seed);
+      segment_length_ = static_cast<uint32_t>(segment_length);
+      segment_length_mask_ = segment_length_ - 1;
+      segment_count_length_ = static_cast<uint32_t>(segment_count_length);
+      array_length_ = static_cast<uint32_t>(array_length);
+    }
+    if (OB_FAIL(ret)) {
+      destroy();
+    }
+  }
+  return ret;
+}
+
+DEFINE_GET_SERIALIZE_SIZE(ObXorFilter)
+{
+  return serialization::encoded_length_i64(static_cast<int64_t>(seed_))
+      + serialization::encoded_length_vi32(segment_length_)
+      + serialization::encoded_length_vi32(segment_count_length_)
+      + serialization::encoded_length_vstr(array_length_);
+}
+
+} // namespace blocksstable
+} // namespace oceanbase
@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_XOR_FILTER_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_XOR_FILTER_H_
+
+#include "lib/allocator/page_arena.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+// Binary fuse filter with 8 bit fingerprints and 3 hash functions.
+//
+// The filter is static, it is built once from all key hashes and can not be inserted into
+// afterwards. It takes about 9 bits per key with a false positive rate of 1/256, compared to
+// about 12 bits per key of a bloom filter with the same false positive rate. Each lookup reads
+// 3 bytes of a small window of the fingerprint array and needs no branch, so lookups of a batch
+// of keys are interleaved to hide memory latency.
+class ObXorFilter
+{
+public:
+  ObXorFilter();
+  ~ObXorFilter();
+  // %key_hashes are sorted and deduplicated in place
+  int init(uint64_t *key_hashes, const int64_t count);
+  void destroy();
+  int deep_copy(const ObXorFilter &other);
+  int deep_copy(const ObXorFilter &other, char *buf);
+  OB_INLINE int64_t get_deep_copy_size() const { return array_length_; }
+  OB_INLINE bool is_valid() const { return nullptr != fingerprints_ && array_length_ > 0; }
+  OB_INLINE bool may_contain(const uint64_t key_hash) const
+  {
+    const uint64_t hash = mix(key_hash);
+    uint32_t h0 = 0;
+    uint32_t h1 = 0;
+    uint32_t h2 = 0;
+    calc_positions(hash, h0, h1, h2);
+    return 0 == static_cast<uint8_t>(fingerprint(hash) ^ fingerprints_[h0] ^ fingerprints_[h1] ^ fingerprints_[h2]);
+  }
+  void may_contain(const uint64_t *key_hashes, const int64_t count, bool *is_contain) const;
+  TO_STRING_KV(K_(seed), K_(segment_length), K_(segment_count_length), K_(array_length), KP_(fingerprints));
+  NEED_SERIALIZE_AND_DESERIALIZE;
+
+private:
+  static const int64_t MAX_SEGMENT_LENGTH = 1L << 18;
+  static const int64_t MAX_BUILD_ITERATIONS = 100;
+  static OB_INLINE uint64_t murmur64(uint64_t h)
+  {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+  static OB_INLINE uint64_t mulhi(const uint64_t a, const uint64_t b)
+  {
+    return static_cast<uint64_t>((static_cast<__uint128_t>(a) * b) >> 64);
+  }
+  static OB_INLINE uint8_t fingerprint(const uint64_t hash)
+  {
+    return static_cast<uint8_t>(hash ^ (hash >> 32));
+  }
+  OB_INLINE uint64_t mix(const uint64_t key_hash) const { return murmur64(key_hash + seed_); }
+  OB_INLINE void calc_positions(const uint64_t hash, uint32_t &h0, uint32_t &h1, uint32_t &h2) const
+  {
+    h0 = static_cast<uint32_t>(mulhi(hash, segment_count_length_));
+    h1 = h0 + segment_length_;
+    h2 = h1 + segment_length_;
+    h1 ^= static_cast<uint32_t>(hash >> 18) & segment_length_mask_;
+    h2 ^= static_cast<uint32_t>(hash) & segment_length_mask_;
+  }
+  OB_INLINE uint32_t calc_position(const int64_t idx, const uint64_t hash) const
+  {
+    uint64_t h = mulhi(hash, segment_count_length_) + idx * segment_length_;
+    const uint64_t hh = hash & ((1ULL << 36) - 1);
+    h ^= (hh >> (36 - 18 * idx)) & segment_length_mask_;
+    return static_cast<uint32_t>(h);
+  }
+  static uint64_t next_seed(uint64_t &seed_state);
+  void calc_layout(const int64_t count);
+  int populate(const uint64_t *key_hashes, const int64_t count);
+
+private:
+  common::ObArenaAllocator allocator_;
+  uint64_t seed_;
+  uint32_t segment_length_;
+  uint32_t segment_length_mask_;
+  uint32_t segment_count_length_;
+  uint32_t array_length_;
+  uint8_t *fingerprints_;
+  DISALLOW_COPY_AND_ASSIGN(ObXorFilter);
+};
+
+} // namespace blocksstable
+} // namespace oceanbase
+
+#endif // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_XOR_FILTER_H_
@@ -125,7 +125,7 @@ void BtreeNode<BtreeKey, BtreeVal>::copy(BtreeNode &dest, const int dest_start,
 {
   if (OB_LIKELY(start < end)) {
     for (int i = 0; i < end - start; ++i) {
-      dest.set_key_value(dest_start + i, get_key(start + i), get_val_with_tag(start + i));
+      dest.set_key_value(dest_start + i, get_key(start + i), get_sort_prefix(start + i), get_val_with_tag(start + i));
       if (dest.is_leaf()) {
         dest.index_.unsafe_insert(dest_start + i, dest_start + i);
       }
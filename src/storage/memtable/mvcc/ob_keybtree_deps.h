@@ -40,6 +40,30 @@ enum
   NODE_COUNT_PER_ALLOC = 128
 };
 
+// Order preserving 8 byte prefix of a key, 0 means no prefix. Keys which can provide one
+// specialize this trait, nodes of other trees neither store nor compare prefixes.
+template<typename BtreeKey>
+struct BtreeKeySortPrefix
+{
+  static const bool ENABLED = false;
+  static OB_INLINE uint64_t get(const BtreeKey &key) { UNUSED(key); return 0; }
+};
+
+template<bool ENABLED>
+struct BtreeSortPrefixes
+{
+  OB_INLINE uint64_t get_prefix(const int pos) const { UNUSED(pos); return 0; }
+  OB_INLINE void set_prefix(const int pos, const uint64_t prefix) { UNUSED(pos); UNUSED(prefix); }
+};
+
+template<>
+struct BtreeSortPrefixes<true>
+{
+  OB_INLINE uint64_t get_prefix(const int pos) const { return sort_prefixes_[pos]; }
+  OB_INLINE void set_prefix(const int pos, const uint64_t prefix) { sort_prefixes_[pos] = prefix; }
+  uint64_t sort_prefixes_[NODE_KEY_COUNT]; // 8 * 15 = 120byte
+};
+
 template<typename BtreeKey, typename BtreeVal>
 struct CompHelper
 {
@@ -47,6 +71,19 @@ struct CompHelper
   {
     return search_key.compare(idx_key, cmp);
   }
+  // Prefixes are order preserving and 0 means no prefix, keys are compared fully only when
+  // the prefixes are equal or missing.
+  OB_INLINE int compare(const BtreeKey search_key, const uint64_t search_prefix,
+                        const BtreeKey idx_key, const uint64_t idx_prefix, int &cmp) const
+  {
+    int ret = OB_SUCCESS;
+    if (0 != search_prefix && 0 != idx_prefix && search_prefix != idx_prefix) {
+      cmp = search_prefix < idx_prefix ? -1 : 1;
+    } else {
+      ret = search_key.compare(idx_key, cmp);
+    }
+    return ret;
+  }
 };
 
 class RWLock
@@ -170,7 +207,9 @@ static int64_t estimate_level_weight(int64_t level)
 }
 
 template<typename BtreeKey, typename BtreeVal>
-class BtreeNode: public common::ObLink
+class BtreeNode: public common::ObLink,
+                 // empty unless the key provides sort prefixes
+                 private BtreeSortPrefixes<BtreeKeySortPrefix<BtreeKey>::ENABLED>
 {
 private:
   friend class ScanHandle<BtreeKey, BtreeVal>;
@@ -244,8 +283,18 @@ public:
   }
   int get_next_active_child(int pos, int64_t version, int64_t* cnt, MultibitSet *index = nullptr);
   int get_prev_active_child(int pos, int64_t version, int64_t* cnt, MultibitSet *index = nullptr);
+  OB_INLINE uint64_t get_sort_prefix(int pos, MultibitSet *index = nullptr) const
+  {
+    return this->get_prefix(get_real_pos(pos, index));
+  }
   OB_INLINE void set_key_value(int pos, BtreeKey key, BtreeVal val)
   {
+    set_key_value(pos, key, BtreeKeySortPrefix<BtreeKey>::get(key), val);
+  }
+  OB_INLINE void set_key_value(int pos, BtreeKey key, const uint64_t sort_prefix, BtreeVal val)
+  {
+    // prefix and key are visible before the value is stored
+    this->set_prefix(pos, sort_prefix);
     kvs_[pos].key_ = key;
     ATOMIC_STORE(&kvs_[pos].val_, val);
   }
@@ -282,10 +331,11 @@ protected:
       end = size();
     }
     is_equal = false;
+    const uint64_t key_prefix = BtreeKeySortPrefix<BtreeKey>::get(key);
     while (OB_SUCC(ret) && start < end && !is_equal) {
       int mid = start + (end - start) / 2;
       int cmp_ret = 0;
-      if (OB_FAIL(nh.compare(key, get_key(mid, index), cmp_ret))) {
+      if (OB_FAIL(nh.compare(key, key_prefix, get_key(mid, index), get_sort_prefix(mid, index), cmp_ret))) {
         OB_LOG(ERROR, "failed to compare", K(key), K(get_key(mid, index)));
       } else if (0 == cmp_ret) {
         is_equal = true;
@@ -60,9 +60,38 @@ int ObIMvccCtx::register_row_commit_cb(
     const int64_t column_cnt)
 {
   int ret = OB_SUCCESS;
-  const bool is_replay = false;
   ObMvccRowCallback *cb = NULL;
 
+  if (OB_FAIL(alloc_row_commit_cb(key, value, node, data_size, old_row, memtable, seq_no, column_cnt, cb))) {
+    TRANS_LOG(WARN, "alloc row commit callback failed", K(ret));
+  } else {
+    if (OB_FAIL(append_callback(cb))) {
+      TRANS_LOG(ERROR, "register callback failed", K(*this), K(ret));
+    }
+
+    if (OB_FAIL(ret)) {
+      callback_free(cb);
+      TRANS_LOG(WARN, "append callback failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObIMvccCtx::alloc_row_commit_cb(
+    const ObMemtableKey *key,
+    ObMvccRow *value,
+    ObMvccTransNode *node,
+    const int64_t data_size,
+    const ObRowData *old_row,
+    ObMemtable *memtable,
+    const transaction::ObTxSEQ seq_no,
+    const int64_t column_cnt,
+    ObMvccRowCallback *&cb)
+{
+  int ret = OB_SUCCESS;
+  const bool is_replay = false;
+  cb = NULL;
+
   if (OB_ISNULL(key)
       || OB_ISNULL(value)
       || OB_ISNULL(node)
@@ -86,15 +115,6 @@ int ObIMvccCtx::register_row_commit_cb(
             seq_no,
             column_cnt);
     cb->set_is_link();
-
-    if (OB_FAIL(append_callback(cb))) {
-      TRANS_LOG(ERROR, "register callback failed", K(*this), K(ret));
-    }
-
-    if (OB_FAIL(ret)) {
-      callback_free(cb);
-      TRANS_LOG(WARN, "append callback failed", K(ret));
-    }
   }
   return ret;
 }
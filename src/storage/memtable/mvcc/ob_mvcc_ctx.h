@@ -158,6 +158,19 @@ public:
       ObMemtable *memtable,
       const transaction::ObTxSEQ seq_no,
       const int64_t column_cnt);
+  // allocate the callback of a row written by batch, which is appended later by append_callbacks
+  int alloc_row_commit_cb(
+      const ObMemtableKey *key,
+      ObMvccRow *value,
+      ObMvccTransNode *node,
+      const int64_t data_size,
+      const ObRowData *old_row,
+      ObMemtable *memtable,
+      const transaction::ObTxSEQ seq_no,
+      const int64_t column_cnt,
+      ObMvccRowCallback *&cb);
+  int append_callbacks(ObITransCallback *const *cbs, const int64_t cnt, int64_t &appended_cnt)
+  { return trans_mgr_.append_callbacks(cbs, cnt, appended_cnt); }
   int register_row_replay_cb(
       const ObMemtableKey *key,
       ObMvccRow *value,
@@ -23,6 +23,7 @@
 #include "storage/memtable/ob_lock_wait_mgr.h"
 #include "storage/tx/ob_trans_ctx.h"
 #include "storage/tx/ob_trans_part_ctx.h"
+#include "storage/tx/ob_trans_service.h"
 #include "storage/tx/ob_tx_stat.h"
 #include "ob_mvcc_ctx.h"
 #include "storage/memtable/ob_memtable_interface.h"
@@ -333,50 +334,103 @@ int ObTransCallbackMgr::get_tx_seq_replay_idx(const transaction::ObTxSEQ seq) co
 
 _RLOCAL(bool, ObTransCallbackMgr::parallel_replay_);
 
-// called by write and replay:
-int ObTransCallbackMgr::append(ObITransCallback *node)
+int ObTransCallbackMgr::select_callback_list_(const transaction::ObTxSEQ seq_no,
+                                              const int64_t cnt,
+                                              ObTxCallbackList *&list)
 {
   int ret = OB_SUCCESS;
-  (void)before_append(node);
-  if (!for_replay_) {
-    node->set_epoch(write_epoch_);
-  }
-  const transaction::ObTxSEQ seq_no = node->get_seq_no();
+  list = NULL;
   if (seq_no.support_branch()) {
     // NEW since version 4.3, select by branch
     int slot = seq_no.get_branch() % MAX_CALLBACK_LIST_COUNT;
     if (slot == 0) {
       // no parallel and no branch requirement
-      ret = callback_list_.append_callback(node, for_replay_, parallel_replay_, is_serial_final_());
+      list = &callback_list_;
       // try to extend callback_lists_ if required
     } else if (!callback_lists_ && OB_FAIL(extend_callback_lists_(MAX_CALLBACK_LIST_COUNT - 1))) {
       TRANS_LOG(WARN, "extend callback lists failed", K(ret));
     } else {
-      ret = callback_lists_[slot - 1].append_callback(node, for_replay_, parallel_replay_, is_serial_final_());
+      list = &callback_lists_[slot - 1];
     }
-  } else {
+  } else if (PARALLEL_STMT == ATOMIC_LOAD(&parallel_stat_)) {
     // OLD before version 4.3
     // if has parallel select from callback_lists_
     // don't select main, and merge into main finally
     const int64_t tid = get_itid() + 1;
     int slot = tid % MAX_CALLBACK_LIST_COUNT;
-    int64_t stat = ATOMIC_LOAD(&parallel_stat_);
-    if (PARALLEL_STMT == stat) {
-      if (OB_FAIL(!callback_lists_ && extend_callback_lists_(MAX_CALLBACK_LIST_COUNT))) {
-        TRANS_LOG(WARN, "extend callback lists failed", K(ret));
-      } else {
-        ret = callback_lists_[slot].append_callback(node, for_replay_, parallel_replay_, true);
-        add_slave_list_append_cnt();
-      }
+    if (!callback_lists_ && OB_FAIL(extend_callback_lists_(MAX_CALLBACK_LIST_COUNT))) {
+      TRANS_LOG(WARN, "extend callback lists failed", K(ret));
     } else {
-      ret = callback_list_.append_callback(node, for_replay_, parallel_replay_, true);
-      add_main_list_append_cnt();
+      list = &callback_lists_[slot];
+      add_slave_list_append_cnt(cnt);
     }
+  } else {
+    list = &callback_list_;
+    add_main_list_append_cnt(cnt);
+  }
+  return ret;
+}
+
+// called by write and replay:
+int ObTransCallbackMgr::append(ObITransCallback *node)
+{
+  int ret = OB_SUCCESS;
+  ObTxCallbackList *list = NULL;
+  (void)before_append(node);
+  if (!for_replay_) {
+    node->set_epoch(write_epoch_);
+  }
+  const transaction::ObTxSEQ seq_no = node->get_seq_no();
+  if (OB_FAIL(select_callback_list_(seq_no, 1, list))) {
+    TRANS_LOG(WARN, "select callback list failed", K(ret), K(seq_no));
+  } else {
+    // lists are serial final before version 4.3, they are merged into main finally
+    ret = list->append_callback(node, for_replay_, parallel_replay_,
+                                seq_no.support_branch() ? is_serial_final_() : true);
   }
   after_append(node, ret);
   return ret;
 }
 
+int ObTransCallbackMgr::append_callbacks(ObITransCallback *const *nodes,
+                                         const int64_t cnt,
+                                         int64_t &appended_cnt)
+{
+  int ret = OB_SUCCESS;
+  ObTxCallbackList *list = NULL;
+  appended_cnt = 0;
+  if (OB_UNLIKELY(for_replay_ || OB_ISNULL(nodes) || cnt <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", K(ret), K_(for_replay), KP(nodes), K(cnt));
+  } else {
+    const transaction::ObTxSEQ seq_no = nodes[0]->get_seq_no();
+    for (int64_t i = 1; OB_SUCC(ret) && i < cnt; ++i) {
+      if (OB_UNLIKELY(nodes[i]->get_seq_no() != seq_no)) {
+        ret = OB_INVALID_ARGUMENT;
+        TRANS_LOG(WARN, "callbacks of different seq_no", K(ret), K(seq_no), KPC(nodes[i]));
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    const transaction::ObTxSEQ seq_no = nodes[0]->get_seq_no();
+    // same order as append, the list is selected after the pending size is updated
+    for (int64_t i = 0; i < cnt; ++i) {
+      (void)before_append(nodes[i]);
+      nodes[i]->set_epoch(write_epoch_);
+    }
+    // all callbacks go to the same list as append
+    if (OB_FAIL(select_callback_list_(seq_no, cnt, list))) {
+      TRANS_LOG(WARN, "select callback list failed", K(ret), K(seq_no));
+    } else {
+      ret = list->append_callbacks(nodes, cnt, appended_cnt);
+    }
+    for (int64_t i = appended_cnt; i < cnt; ++i) {
+      after_append(nodes[i], ret);
+    }
+  }
+  return ret;
+}
+
 void ObTransCallbackMgr::before_append(ObITransCallback *node)
 {
   int64_t size = node->get_data_size();
@@ -1374,8 +1428,25 @@ int ObTransCallbackMgr::trans_end(const bool commit)
     if (OB_LIKELY(ATOMIC_LOAD(&callback_lists_) == NULL)) {
       ret = commit ? callback_list_.tx_commit() : callback_list_.tx_abort();
     } else {
-      CALLBACK_LISTS_FOREACH(idx, list) {
-        ret = commit ? list->tx_commit() : list->tx_abort();
+      // lists of a large transaction are ended by the idle callback list end
+      // workers together with current thread
+      ObTransService *txs = MTL(ObTransService *);
+      int64_t callback_cnt = 0;
+      int64_t non_empty_cnt = 0;
+      for (int64_t i = 0; i < MAX_CALLBACK_LIST_COUNT; ++i) {
+        const int64_t length = get_callback_list_(i, false)->get_length();
+        callback_cnt += length;
+        non_empty_cnt += (length > 0 ? 1 : 0);
+      }
+      if (OB_NOT_NULL(txs)
+          && callback_cnt >= PARALLEL_TX_END_MIN_CALLBACK_CNT
+          && non_empty_cnt > 1) {
+        const int64_t helper_cnt = MIN(non_empty_cnt - 1, ObTxCallbackListEndWorker::WORKER_CNT);
+        ret = parallel_trans_end_(commit, helper_cnt, txs->get_callback_list_end_worker());
+      } else {
+        CALLBACK_LISTS_FOREACH(idx, list) {
+          ret = commit ? list->tx_commit() : list->tx_abort();
+        }
       }
     }
   }
@@ -1385,6 +1456,167 @@ int ObTransCallbackMgr::trans_end(const bool commit)
   return ret;
 }
 
+int ObTransCallbackMgr::parallel_trans_end_(const bool commit,
+                                            const int64_t helper_cnt,
+                                            ObTxCallbackListEndWorker &worker)
+{
+  ObTxCallbackListEndCtx end_ctx(*this, commit, MAX_CALLBACK_LIST_COUNT);
+  int64_t worker_idxs[ObTxCallbackListEndWorker::WORKER_CNT];
+  int64_t dispatched_cnt = 0;
+  for (int64_t i = 0; i < helper_cnt && i < ObTxCallbackListEndWorker::WORKER_CNT; ++i) {
+    if (OB_SUCCESS != worker.dispatch(end_ctx, worker_idxs[dispatched_cnt])) {
+      // no idle worker, the left lists are ended by current thread
+      break;
+    } else {
+      dispatched_cnt++;
+    }
+  }
+  end_ctx.run();
+  for (int64_t i = 0; i < dispatched_cnt; ++i) {
+    worker.wait_or_revoke(worker_idxs[i], end_ctx);
+  }
+  return end_ctx.get_ret();
+}
+
+void ObTxCallbackListEndCtx::run()
+{
+  int64_t idx = 0;
+  while ((idx = ATOMIC_FAA(&next_idx_, 1)) < list_cnt_) {
+    int ret = OB_SUCCESS;
+    ObTxCallbackList *list = mgr_.get_callback_list_(idx, false);
+    if (OB_FAIL(commit_ ? list->tx_commit() : list->tx_abort())) {
+      TRANS_LOG(WARN, "end callback list failed", K(ret), K(idx), K_(commit));
+      ATOMIC_BCAS(&ret_, OB_SUCCESS, ret);
+    }
+  }
+}
+
+int ObTxCallbackListEndWorker::init()
+{
+  int ret = OB_SUCCESS;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    TRANS_LOG(WARN, "callback list end worker inited twice", K(ret));
+  } else if (OB_FAIL(lib::ThreadPool::set_thread_count(WORKER_CNT))) {
+    TRANS_LOG(WARN, "set thread count failed", K(ret));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < WORKER_CNT; ++i) {
+      if (OB_FAIL(slots_[i].cond_.init(ObWaitEventIds::DEFAULT_COND_WAIT))) {
+        TRANS_LOG(WARN, "init worker cond failed", K(ret), K(i));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      is_inited_ = true;
+    }
+  }
+  return ret;
+}
+
+int ObTxCallbackListEndWorker::start()
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    TRANS_LOG(WARN, "callback list end worker not inited", K(ret));
+  } else {
+    lib::ThreadPool::set_run_wrapper(MTL_CTX());
+    ret = lib::ThreadPool::start();
+  }
+  TRANS_LOG(INFO, "start callback list end worker", K(ret));
+  return ret;
+}
+
+void ObTxCallbackListEndWorker::stop()
+{
+  lib::ThreadPool::stop();
+  if (IS_INIT) {
+    for (int64_t i = 0; i < WORKER_CNT; ++i) {
+      ObThreadCondGuard guard(slots_[i].cond_);
+      slots_[i].cond_.broadcast();
+    }
+  }
+}
+
+void ObTxCallbackListEndWorker::wait()
+{
+  lib::ThreadPool::wait();
+}
+
+void ObTxCallbackListEndWorker::destroy()
+{
+  lib::ThreadPool::destroy();
+  if (IS_INIT) {
+    for (int64_t i = 0; i < WORKER_CNT; ++i) {
+      slots_[i].cond_.destroy();
+    }
+    is_inited_ = false;
+  }
+}
+
+void ObTxCallbackListEndWorker::run1()
+{
+  const int64_t idx = get_thread_idx();
+  lib::set_thread_name("TxCbListEnd");
+  if (idx >= 0 && idx < WORKER_CNT) {
+    Slot &slot = slots_[idx];
+    bool stopped = false;
+    while (!stopped) {
+      ObTxCallbackListEndCtx *ctx = NULL;
+      {
+        ObThreadCondGuard guard(slot.cond_);
+        while (NULL == slot.ctx_ && !has_set_stop()) {
+          slot.cond_.wait_us(1000 * 1000);
+        }
+        if (NULL == slot.ctx_) {
+          stopped = true;
+        } else {
+          slot.is_running_ = true;
+          ctx = slot.ctx_;
+        }
+      }
+      if (NULL != ctx) {
+        ctx->run();
+        ObThreadCondGuard guard(slot.cond_);
+        slot.ctx_ = NULL;
+        slot.is_running_ = false;
+        slot.cond_.broadcast();
+      }
+    }
+  }
+}
+
+int ObTxCallbackListEndWorker::dispatch(ObTxCallbackListEndCtx &ctx, int64_t &worker_idx)
+{
+  int ret = OB_EAGAIN;
+  if (IS_INIT && !has_set_stop()) {
+    for (int64_t i = 0; OB_EAGAIN == ret && i < WORKER_CNT; ++i) {
+      Slot &slot = slots_[i];
+      ObThreadCondGuard guard(slot.cond_);
+      if (NULL == slot.ctx_) {
+        slot.ctx_ = &ctx;
+        worker_idx = i;
+        slot.cond_.broadcast();
+        ret = OB_SUCCESS;
+      }
+    }
+  }
+  return ret;
+}
+
+void ObTxCallbackListEndWorker::wait_or_revoke(const int64_t worker_idx, ObTxCallbackListEndCtx &ctx)
+{
+  Slot &slot = slots_[worker_idx];
+  ObThreadCondGuard guard(slot.cond_);
+  while (&ctx == slot.ctx_) {
+    if (!slot.is_running_) {
+      // all lists have been taken, so the worker has nothing to do
+      slot.ctx_ = NULL;
+    } else {
+      slot.cond_.wait_us(1000);
+    }
+  }
+}
+
 int ObTransCallbackMgr::calc_checksum_all(ObIArray<uint64_t> &checksum)
 {
   RDLockGuard guard(rwlock_);
@@ -14,6 +14,8 @@
 #define OCEANBASE_MVCC_OB_MVCC_TRANS_CTX_
 #include "lib/utility/ob_macro_utils.h"
 #include "lib/utility/utility.h"
+#include "lib/lock/ob_thread_cond.h"
+#include "lib/thread/thread_pool.h"
 #include "common/ob_tablet_id.h"
 #include "ob_row_data.h"
 #include "ob_mvcc_row.h"
@@ -152,9 +154,70 @@ private:
   ObITransCallback *cur_;
 };
 
+class ObTransCallbackMgr;
+
+// Commit or abort callback lists of a large transaction in parallel.
+//
+// Lists are taken one by one through an atomic index by the committing thread
+// and the helpers, so every list not taken by a helper is ended by the
+// committing thread itself.
+class ObTxCallbackListEndCtx
+{
+public:
+  ObTxCallbackListEndCtx(ObTransCallbackMgr &mgr, const bool commit, const int64_t list_cnt)
+    : mgr_(mgr), commit_(commit), list_cnt_(list_cnt), next_idx_(0), ret_(OB_SUCCESS) {}
+  ~ObTxCallbackListEndCtx() {}
+  // take and end lists until no list is left
+  void run();
+  int get_ret() const { return ATOMIC_LOAD(&ret_); }
+  TO_STRING_KV(K_(commit), K_(list_cnt), K_(next_idx), K_(ret));
+private:
+  ObTransCallbackMgr &mgr_;
+  bool commit_;
+  int64_t list_cnt_;
+  int64_t next_idx_;
+  int ret_;
+  DISALLOW_COPY_AND_ASSIGN(ObTxCallbackListEndCtx);
+};
+
+// Tenant level helper threads of ObTxCallbackListEndCtx.
+//
+// A ctx is only handed to an idle worker and never queued, so the committing
+// thread does not wait for a helper stuck behind other work. A ctx handed to a
+// worker which has not started it yet is taken back by the committing thread.
+class ObTxCallbackListEndWorker : public lib::ThreadPool
+{
+public:
+  static const int64_t WORKER_CNT = 2;
+  ObTxCallbackListEndWorker() : is_inited_(false) {}
+  ~ObTxCallbackListEndWorker() { destroy(); }
+  int init();
+  int start();
+  void stop();
+  void wait();
+  void destroy();
+  void run1() override;
+  // hand the ctx to an idle worker, return OB_EAGAIN if all workers are busy
+  int dispatch(ObTxCallbackListEndCtx &ctx, int64_t &worker_idx);
+  // wait until the worker has ended the ctx, or take the ctx back from it
+  void wait_or_revoke(const int64_t worker_idx, ObTxCallbackListEndCtx &ctx);
+private:
+  struct Slot
+  {
+    Slot() : ctx_(NULL), is_running_(false), cond_() {}
+    ObTxCallbackListEndCtx *ctx_;
+    bool is_running_;
+    common::ObThreadCond cond_;
+  };
+  bool is_inited_;
+  Slot slots_[WORKER_CNT];
+  DISALLOW_COPY_AND_ASSIGN(ObTxCallbackListEndWorker);
+};
+
 // 事务commit/abort的callback不允许出错，也没法返回错误，就算返回错误调用者也没法处理，所以callback都返回void
 class ObTransCallbackMgr
 {
+  friend class ObTxCallbackListEndCtx;
 public:
   class WRLockGuard
   {
@@ -218,6 +281,8 @@ public:
   void *callback_alloc(const int64_t size);
   void callback_free(ObITransCallback *cb);
   int append(ObITransCallback *node);
+  // append callbacks of one batch write, which have the same seq_no
+  int append_callbacks(ObITransCallback *const *nodes, const int64_t cnt, int64_t &appended_cnt);
   void before_append(ObITransCallback *node);
   void after_append(ObITransCallback *node, const int ret_code);
   void trans_start();
@@ -244,8 +309,17 @@ public:
   int get_tx_seq_replay_idx(const transaction::ObTxSEQ seq) const;
   common::SpinRWLock& get_rwlock() { return rwlock_; }
 private:
+  // transactions with less callbacks are ended by the committing thread alone
+  static const int64_t PARALLEL_TX_END_MIN_CALLBACK_CNT = 64 * 1024;
   void wakeup_waiting_txns_();
   int extend_callback_lists_(const int16_t cnt);
+  // select the list to append %cnt callbacks of %seq_no, and count the append
+  int select_callback_list_(const transaction::ObTxSEQ seq_no,
+                            const int64_t cnt,
+                            ObTxCallbackList *&list);
+  int parallel_trans_end_(const bool commit,
+                          const int64_t helper_cnt,
+                          ObTxCallbackListEndWorker &worker);
 public:
   bool is_logging_blocked(bool &has_pending_log) const;
   int fill_log(ObTxFillRedoCtx &ctx, ObITxFillRedoFunctor &func);
@@ -27,6 +27,15 @@ namespace common
 {
 class ObIAllocator;
 }
+namespace keybtree
+{
+template<>
+struct BtreeKeySortPrefix<memtable::ObStoreRowkeyWrapper>
+{
+  static const bool ENABLED = true;
+  static OB_INLINE uint64_t get(const memtable::ObStoreRowkeyWrapper &key) { return key.get_sort_prefix(); }
+};
+}
 namespace memtable
 {
 class ObMvccRow;
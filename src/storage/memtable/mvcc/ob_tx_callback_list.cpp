@@ -128,6 +128,37 @@ int ObTxCallbackList::append_callback(ObITransCallback *callback,
   return ret;
 }
 
+int ObTxCallbackList::append_callbacks(ObITransCallback *const *callbacks,
+                                       const int64_t cnt,
+                                       int64_t &appended_cnt)
+{
+  int ret = OB_SUCCESS;
+  const bool for_replay = false;
+  appended_cnt = 0;
+  LockGuard gaurd(*this, LOCK_MODE::LOCK_APPEND);
+  const bool repos_lc = (log_cursor_ == &head_);
+  for (int64_t i = 0; OB_SUCC(ret) && i < cnt; ++i) {
+    ObITransCallback *callback = callbacks[i];
+    if (OB_ISNULL(callback)) {
+      ret = OB_ERR_UNEXPECTED;
+      TRANS_LOG(ERROR, "before_append_cb failed", K(ret), K(i), K(cnt));
+    } else if (OB_FAIL(callback->before_append_cb(for_replay))) {
+      TRANS_LOG(WARN, "before_append_cb failed", K(ret), KPC(callback));
+    } else {
+      (void)get_tail()->append(callback);
+      ++appended_;
+      ATOMIC_INC(&length_);
+      data_size_ += callback->get_data_size();
+      if (repos_lc && 0 == appended_cnt) {
+        log_cursor_ = callback;
+      }
+      ++appended_cnt;
+      (void)callback->after_append_cb(for_replay);
+    }
+  }
+  return ret;
+}
+
 int64_t ObTxCallbackList::concat_callbacks(ObTxCallbackList &that)
 {
   int64_t cnt = 0;
@@ -37,6 +37,13 @@ public:
                       const bool parallel_replay = false,
                       const bool serial_final = false);
 
+  // append_callbacks appends the callbacks of a batch write to the tail of the
+  // list in order under one append latch. It stops at the first failure and
+  // returns the count of callbacks appended already by appended_cnt.
+  int append_callbacks(ObITransCallback *const *callbacks,
+                       const int64_t cnt,
+                       int64_t &appended_cnt);
+
   // concat_callbacks will append all callbacks in other into itself and reset
   // other. And it will return the concat number during concat_callbacks.
   int64_t concat_callbacks(ObTxCallbackList &other);
@@ -367,8 +367,10 @@ void ObLockWaitMgr::wakeup(uint64_t hash)
     node = fetch_waiter(hash);
 
     if (NULL != node) {
+      const int64_t wait_time = ObTimeUtility::current_time() - node->lock_ts_;
       EVENT_INC(MEMSTORE_WRITE_LOCK_WAKENUP_COUNT);
-      EVENT_ADD(MEMSTORE_WAIT_WRITE_LOCK_TIME, ObTimeUtility::current_time() - node->lock_ts_);
+      EVENT_ADD(MEMSTORE_WAIT_WRITE_LOCK_TIME, wait_time);
+      record_wait_time(hash, wait_time);
       node->on_retry_lock(hash);
       (void)repost(node);
     }
@@ -379,8 +381,15 @@ void ObLockWaitMgr::wakeup(uint64_t hash)
 }
 
 ObLockWaitMgr::Node* ObLockWaitMgr::next(Node*& iter, Node* target)
+{
+  int64_t unused_queue_depth = 0;
+  return next(iter, target, unused_queue_depth);
+}
+
+ObLockWaitMgr::Node* ObLockWaitMgr::next(Node*& iter, Node* target, int64_t &queue_depth)
 {
   CriticalGuard(get_qs());
+  queue_depth = 0;
   if (NULL != (iter = hash_.next(iter))) {
     *target = *iter;
     Node *node = hash_.get_next_internal(target->hash());
@@ -390,6 +399,11 @@ ObLockWaitMgr::Node* ObLockWaitMgr::next(Node*& iter, Node* target)
     if (NULL != node && node->hash() == target->hash()) {
       target->set_block_sessid(node->sessid_);
     }
+    // requests waiting on the same key are adjacent and ordered by recv_ts
+    while (NULL != node && node->hash() == target->hash()) {
+      queue_depth++;
+      node = (Node*)link_next(node);
+    }
   } else {
     target = NULL;
   }
@@ -539,8 +553,10 @@ void ObLockWaitMgr::retire_node(ObLink*& tail, Node* node)
 {
   int err = 0;
   Node* tmp_node = NULL;
+  const int64_t wait_time = ObTimeUtility::current_time() - node->lock_ts_;
   EVENT_INC(MEMSTORE_WRITE_LOCK_WAKENUP_COUNT);
-  EVENT_ADD(MEMSTORE_WAIT_WRITE_LOCK_TIME, ObTimeUtility::current_time() - node->lock_ts_);
+  EVENT_ADD(MEMSTORE_WAIT_WRITE_LOCK_TIME, wait_time);
+  record_wait_time(node->hash(), wait_time);
   while (-EAGAIN == (err = hash_.del(node, tmp_node)))
     ;
   if (0 == err) {
@@ -722,6 +738,23 @@ int ObLockWaitMgr::transform_row_lock_to_tx_lock(const ObTabletID &tablet_id,
   return ret;
 }
 
+void ObLockWaitMgr::set_hash_holder(const ObTabletID &tablet_id,
+                                    const Key &key,
+                                    const ObTransID &tx_id)
+{
+  uint64_t &hold_key = get_thread_hold_key();
+  if (0 != hold_key
+      && NULL != get_thread_node()
+      && hold_key == LockHashHelper::hash_rowkey(tablet_id, key)) {
+    // hot row is handed over to the next waiter when the lock is released
+    // (commit, abort or early lock release), waking it up when the request
+    // ends only makes it fail and wait again
+    hold_key = 0;
+    EVENT_INC(MEMSTORE_WRITE_LOCK_HANDOVER_COUNT);
+  }
+  row_holder_mapper_.set_hash_holder(tablet_id, key, tx_id);
+}
+
 void ObLockWaitMgr::wakeup(const ObTabletID &tablet_id, const Key& key)
 {
   TRANS_LOG(TRACE, "LockWaitMgr.wakeup.byRowKey", K(tablet_id), K(key), K(lbt()));
@@ -17,6 +17,7 @@
 #include "lib/allocator/ob_qsync.h"
 #include "lib/hash/ob_linear_hash_map.h"
 #include "lib/hash/ob_link_hashmap.h"
+#include "lib/lock/ob_small_spin_lock.h"
 #include "lib/oblog/ob_log_module.h"
 #include "lib/rowid/ob_urowid.h"
 #include "lib/stat/ob_diagnose_info.h"
@@ -197,6 +198,14 @@ public:
     TO_STRING_KV(K(sess_id_));
   };
   typedef ObSEArray<SessPair, OB_SESSPAIR_COUNT> DeadlockedSessionArray;
+  // accumulated wait stat of a key
+  struct KeyWaitStat {
+    KeyWaitStat() : hash_(0), wakeup_cnt_(0), wait_time_(0) {}
+    uint64_t hash_;
+    int64_t wakeup_cnt_;
+    int64_t wait_time_;
+    TO_STRING_KV(K_(hash), K_(wakeup_cnt), K_(wait_time));
+  };
 
 public:
   ObLockWaitMgr();
@@ -263,13 +272,34 @@ public:
   void wakeup(const transaction::ObTransID &tx_id);
   // wakeup the request waiting on the tablelock.
   void wakeup(const transaction::tablelock::ObLockID &lock_id);
+  // the row is locked by the transaction, it is recorded for deadlock
+  // detector. And if current request was woken up to retry on the row, it
+  // needn't wakeup the next waiter when it ends, because the release of the
+  // row lock will do it
+  void set_hash_holder(const ObTabletID &tablet_id,
+                       const Key &key,
+                       const transaction::ObTransID &tx_id);
   // for deadlock
-  DELEGATE_WITH_RET(row_holder_mapper_, set_hash_holder, void);
   DELEGATE_WITH_RET(row_holder_mapper_, get_hash_holder, int);
   DELEGATE_WITH_RET(row_holder_mapper_, reset_hash_holder, void);
   DELEGATE_WITH_RET(row_holder_mapper_, get_rowkey_holder, int);
 
   Node* next(Node*& iter, Node* target);
+  // same as above, and return the number of requests waiting on the same key
+  Node* next(Node*& iter, Node* target, int64_t &queue_depth);
+  // stat is kept for the last key waited on in each lock bucket, so the stat of a key is
+  // restarted once another key of its bucket is waited on
+  void get_key_wait_stat(const uint64_t hash, KeyWaitStat &stat)
+  {
+    KeyWaitSlot &slot = key_wait_slots_[(hash >> 1) % LOCK_BUCKET_COUNT];
+    common::ObByteLockGuard guard(slot.lock_);
+    if (slot.stat_.hash_ == hash) {
+      stat = slot.stat_;
+    } else {
+      stat = KeyWaitStat();
+      stat.hash_ = hash;
+    }
+  }
 
   static Node*& get_thread_node()
   {
@@ -332,11 +362,27 @@ private:
   {
     return ATOMIC_LOAD(&sequence_[(hash >> 1) % LOCK_BUCKET_COUNT]);
   }
+  void record_wait_time(uint64_t hash, const int64_t wait_time)
+  {
+    KeyWaitSlot &slot = key_wait_slots_[(hash >> 1) % LOCK_BUCKET_COUNT];
+    common::ObByteLockGuard guard(slot.lock_);
+    if (slot.stat_.hash_ != hash) {
+      slot.stat_ = KeyWaitStat();
+      slot.stat_.hash_ = hash;
+    }
+    slot.stat_.wakeup_cnt_++;
+    slot.stat_.wait_time_ += wait_time;
+  }
+  struct KeyWaitSlot {
+    common::ObByteLock lock_;
+    KeyWaitStat stat_;
+  };
 
 private:
   bool is_inited_;
   Hash hash_;
   int64_t sequence_[LOCK_BUCKET_COUNT];
+  KeyWaitSlot key_wait_slots_[LOCK_BUCKET_COUNT];
   char hash_buf_[sizeof(SpHashNode) * LOCK_BUCKET_COUNT];
   int64_t last_check_session_idle_ts_;
 
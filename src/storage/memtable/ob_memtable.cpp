@@ -2836,8 +2836,10 @@ int ObMemtable::multi_set_(
   }
 
   // 1. Check write conflict in memtables.
-  for (int64_t i = 0 ; OB_SUCC(ret) && i < row_count; ++i) {
-    const uint32_t permutation_idx = rows_info.get_permutation_idx(i);
+  // Rows are written in rowkey order, so that the keys of adjacent rows are
+  // inserted into the same or neighbouring btree leaves.
+  for (int64_t permutation_idx = 0 ; OB_SUCC(ret) && permutation_idx < row_count; ++permutation_idx) {
+    const int64_t i = rows_info.rowkeys_.at(permutation_idx).row_idx_;
     if (OB_FAIL(set_(param, columns, rows[i], nullptr, nullptr, memtable_keys[i], context, &(mvcc_rows[permutation_idx]), check_exist))) {
       if (OB_UNLIKELY(OB_TRY_LOCK_ROW_CONFLICT != ret && OB_TRANSACTION_SET_VIOLATION != ret)) {
         TRANS_LOG(WARN, "Failed to insert new row", K(ret), K(i), K(permutation_idx), K(rows[i]));
@@ -2876,7 +2878,13 @@ int ObMemtable::multi_set_(
     }
   }
 
-  // 3. Roll back all rows that have been inserted if meet failure.
+  // 3. Append callbacks of all rows to the callback list at once.
+  if (OB_SUCC(ret) && OB_FAIL(append_row_callbacks_(ctx, mvcc_rows))) {
+    TRANS_LOG(WARN, "Failed to append row callbacks", K(ret));
+  }
+  free_row_callbacks_(ctx, mvcc_rows);
+
+  // 4. Roll back all rows that have been inserted if meet failure.
   if (OB_FAIL(ret)) {
     for (int64_t i = 0; i < mvcc_rows.count(); ++i) {
       if (conflict_idx != i) {
@@ -2910,6 +2918,46 @@ int ObMemtable::multi_set_(
   return ret;
 }
 
+int ObMemtable::append_row_callbacks_(
+    storage::ObStoreCtx &ctx,
+    ObMvccRowAndWriteResults &mvcc_rows)
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<ObITransCallback *, 16> callbacks;
+  int64_t appended_cnt = 0;
+  for (int64_t i = 0; OB_SUCC(ret) && i < mvcc_rows.count(); ++i) {
+    if (OB_NOT_NULL(mvcc_rows[i].callback_) && OB_FAIL(callbacks.push_back(mvcc_rows[i].callback_))) {
+      TRANS_LOG(WARN, "Failed to push back callback", K(ret), K(i));
+    }
+  }
+  if (OB_FAIL(ret) || callbacks.empty()) {
+  } else if (OB_FAIL(ctx.mvcc_acc_ctx_.get_mem_ctx()->append_callbacks(&callbacks.at(0),
+                                                                      callbacks.count(),
+                                                                      appended_cnt))) {
+    TRANS_LOG(WARN, "Failed to append callbacks", K(ret), K(appended_cnt), K(callbacks.count()));
+  }
+  // callbacks in the list are owned by the list from now on
+  for (int64_t i = 0; i < mvcc_rows.count() && appended_cnt > 0; ++i) {
+    if (OB_NOT_NULL(mvcc_rows[i].callback_)) {
+      mvcc_rows[i].callback_ = nullptr;
+      --appended_cnt;
+    }
+  }
+  return ret;
+}
+
+void ObMemtable::free_row_callbacks_(
+    storage::ObStoreCtx &ctx,
+    ObMvccRowAndWriteResults &mvcc_rows)
+{
+  for (int64_t i = 0; i < mvcc_rows.count(); ++i) {
+    if (OB_NOT_NULL(mvcc_rows[i].callback_)) {
+      ctx.mvcc_acc_ctx_.get_mem_ctx()->callback_free(mvcc_rows[i].callback_);
+      mvcc_rows[i].callback_ = nullptr;
+    }
+  }
+}
+
 int ObMemtable::set_(
     const storage::ObTableIterParam &param,
     const common::ObIArray<share::schema::ObColDesc> &columns,
@@ -3113,6 +3161,7 @@ int ObMemtable::mvcc_write_(
   RowHeaderGetter getter;
   ObMvccRow *value = NULL;
   ObMvccWriteResult res;
+  ObMvccRowCallback *callback = NULL;
   ObStoreCtx &ctx = *(context.store_ctx_);
   ObIMemtableCtx *mem_ctx = ctx.mvcc_acc_ctx_.get_mem_ctx();
   SCN snapshot_version = ctx.mvcc_acc_ctx_.get_snapshot_version();
@@ -3159,6 +3208,22 @@ int ObMemtable::mvcc_write_(
     }
     TRANS_LOG(WARN, "prepare kv after lock fail", K(ret));
   } else if (res.has_insert()
+             && nullptr != mvcc_row
+             && OB_FAIL(mem_ctx->alloc_row_commit_cb(&stored_key,
+                                                     value,
+                                                     res.tx_node_,
+                                                     arg.data_->dup_size(),
+                                                     arg.old_row_,
+                                                     this,
+                                                     arg.seq_no_,
+                                                     arg.column_cnt_,
+                                                     callback))) {
+    // callbacks of multi_set_ are appended together after all rows are written
+    (void)mvcc_engine_.mvcc_undo(value);
+    res.is_mvcc_undo_ = true;
+    TRANS_LOG(WARN, "alloc row commit callback failed", K(ret));
+  } else if (res.has_insert()
+             && nullptr == mvcc_row
              && OB_FAIL(mem_ctx->register_row_commit_cb(&stored_key,
                                                         value,
                                                         res.tx_node_,
@@ -3183,6 +3248,7 @@ int ObMemtable::mvcc_write_(
   if (OB_SUCC(ret) && mvcc_row) {
     mvcc_row->mvcc_row_ = value;
     mvcc_row->write_result_ = res;
+    mvcc_row->callback_ = callback;
   }
 
   if (OB_FAIL(ret) || NULL == res.tx_node_ || !res.has_insert()) {
@@ -51,6 +51,7 @@ namespace memtable
 {
 class ObMemtableScanIterator;
 class ObMemtableGetIterator;
+class ObMvccRowCallback;
 
 
 /*
@@ -80,9 +81,12 @@ struct ObMtStat
 
 struct ObMvccRowAndWriteResult
 {
+  ObMvccRowAndWriteResult() : mvcc_row_(nullptr), write_result_(), callback_(nullptr) {}
   ObMvccRow *mvcc_row_;
   ObMvccWriteResult write_result_;
-  TO_STRING_KV(K_(write_result), KP_(mvcc_row));
+  // callback of the written row, appended by multi_set_ together with other rows
+  ObMvccRowCallback *callback_;
+  TO_STRING_KV(K_(write_result), KP_(mvcc_row), KP_(callback));
 };
 
 class ObMTKVBuilder
@@ -578,6 +582,12 @@ private:
   int check_standby_cluster_schema_condition_(storage::ObStoreCtx &ctx,
                                               const int64_t table_id,
                                               const int64_t table_version);
+  int append_row_callbacks_(
+      storage::ObStoreCtx &ctx,
+      ObMvccRowAndWriteResults &mvcc_rows);
+  void free_row_callbacks_(
+      storage::ObStoreCtx &ctx,
+      ObMvccRowAndWriteResults &mvcc_rows);
   int set_(
       const storage::ObTableIterParam &param,
       const common::ObIArray<share::schema::ObColDesc> &columns,
@@ -301,6 +301,24 @@ public:
   int64_t to_string(char *buf, const int64_t buf_len) const { return rowkey_->to_string(buf, buf_len); }
   const ObObj *get_ptr() const { return rowkey_->get_obj_ptr(); }
   const char *repr() const { return rowkey_->repr(); }
+  // Order preserving prefix of the first integer column, 0 means no prefix.
+  // Signed and unsigned values share the same mapping, unsigned values not less than 2^63
+  // saturate to UINT64_MAX, so different prefixes always mean different first columns.
+  uint64_t get_sort_prefix() const
+  {
+    static const uint64_t SIGN_BIT = 1ULL << 63;
+    uint64_t prefix = 0;
+    const common::ObObj *obj = nullptr;
+    if (OB_NOT_NULL(rowkey_) && rowkey_->get_obj_cnt() > 0 && OB_NOT_NULL(obj = rowkey_->get_obj_ptr())) {
+      if (common::ObIntTC == obj->get_type_class()) {
+        prefix = static_cast<uint64_t>(obj->get_int()) ^ SIGN_BIT;
+      } else if (common::ObUIntTC == obj->get_type_class()) {
+        const uint64_t value = obj->get_uint64();
+        prefix = value < SIGN_BIT ? (value | SIGN_BIT) : UINT64_MAX;
+      }
+    }
+    return prefix;
+  }
 public:
   const common::ObStoreRowkey *rowkey_;
 };
@@ -175,11 +175,10 @@ int ObBloomFilterBuildTask::build_bloom_filter()
       } else if (OB_UNLIKELY(!macro_header.is_valid() || macro_header.is_normal_cg_)) {
         ret = OB_ERR_UNEXPECTED;
         LOG_WARN("Invalid macro block header", K(ret), K(macro_header));
-      } else if (OB_FAIL(bfcache_value.init(prefix_len_, macro_header.fixed_header_.row_count_))) {
-        LOG_WARN("Fail to init bloom filter", K(ret));
       } else {
         ObStorageDatumUtils datum_utils;
         ObDatumRowkey rowkey;
+        ObArray<uint64_t> key_hashs;
         if (OB_FAIL(datum_utils.init(macro_bare_iter->get_rowkey_column_descs(),
                                      macro_header.fixed_header_.rowkey_column_count_,
                                      compat_mode == lib::Worker::CompatMode::ORACLE,
@@ -192,12 +191,16 @@ int ObBloomFilterBuildTask::build_bloom_filter()
             STORAGE_LOG(WARN, "Failed to assign rowkey", K(ret), KPC(row), K(prefix_len_));
           } else if (OB_FAIL(rowkey.murmurhash(0, datum_utils, key_hash))) {
             STORAGE_LOG(WARN, "Failed to calc rowkey hash", K(ret), K(rowkey), K(datum_utils));
-          } else if (OB_FAIL(bfcache_value.insert(static_cast<uint32_t>(key_hash)))) {
-            LOG_WARN("Fail to insert rowkey to bfcache", K(ret));
+          } else if (OB_FAIL(key_hashs.push_back(key_hash))) {
+            LOG_WARN("Fail to push back rowkey hash", K(ret));
           }
         }
         if (OB_UNLIKELY(OB_ITER_END != ret)) {
           LOG_WARN("Fail to iterate macro block", K(ret));
+        } else if (OB_UNLIKELY(key_hashs.empty())) {
+          ret = OB_SUCCESS;
+        } else if (OB_FAIL(bfcache_value.init_with_xor_filter(prefix_len_, &key_hashs.at(0), key_hashs.count()))) {
+          LOG_WARN("Fail to init xor filter", K(ret));
         } else if (OB_FAIL(ObStorageCacheSuite::get_instance().get_bf_cache().put_bloom_filter(
             tenant_id_, macro_id_, bfcache_value, true/* adaptive */))) {
           LOG_WARN("Fail to put value to bloom filter cache", K(ret), K_(tenant_id), K_(macro_id));
@@ -163,6 +163,11 @@ int ObTableStoreStat::add(const ObTableStoreStat& other)
 
     logical_read_cnt_ += other.logical_read_cnt_;
     physical_read_cnt_ += other.physical_read_cnt_;
+    prefetch_micro_cnt_ += other.prefetch_micro_cnt_;
+    prefetch_wait_cnt_ += other.prefetch_wait_cnt_;
+    max_prefetch_depth_ = MAX(max_prefetch_depth_, other.max_prefetch_depth_);
+    multi_block_io_cnt_ += other.multi_block_io_cnt_;
+    multi_block_io_micro_cnt_ += other.multi_block_io_micro_cnt_;
   }
   return ret;
 }
@@ -113,7 +113,9 @@ public:
                K_(exist_row), K_(get_row), K_(scan_row),
                K_(sstable_bf_filter_cnt), K_(sstable_bf_empty_read_cnt),
                K_(sstable_bf_access_cnt), K_(rowkey_prefix),
-               K_(logical_read_cnt), K_(physical_read_cnt));
+               K_(logical_read_cnt), K_(physical_read_cnt),
+               K_(prefetch_micro_cnt), K_(prefetch_wait_cnt), K_(max_prefetch_depth),
+               K_(multi_block_io_cnt), K_(multi_block_io_micro_cnt));
 
   share::ObLSID ls_id_;
   common::ObTabletID tablet_id_;
@@ -152,6 +154,11 @@ public:
   int64_t rowkey_prefix_;
   int64_t logical_read_cnt_;
   int64_t physical_read_cnt_;
+  int64_t prefetch_micro_cnt_;
+  int64_t prefetch_wait_cnt_;
+  int64_t max_prefetch_depth_;
+  int64_t multi_block_io_cnt_;
+  int64_t multi_block_io_micro_cnt_;
 };
 
 struct ObTableStoreStatKey
@@ -163,6 +163,8 @@ int ObTransService::init(const ObAddr &self,
     TRANS_LOG(WARN, "init dup_tablet_scan_task_ failed",K(ret));
   } else if (OB_FAIL(rollback_sp_msg_mgr_.init(lib::ObMemAttr(tenant_id, "RollbackSPMgr")))) {
     TRANS_LOG(WARN, "init rollback msg map failed", KR(ret));
+  } else if (OB_FAIL(callback_list_end_worker_.init())) {
+    TRANS_LOG(WARN, "init callback list end worker failed", KR(ret));
   } else {
     self_ = self;
     tenant_id_ = tenant_id;
@@ -233,6 +235,8 @@ int ObTransService::start()
     TRANS_LOG(WARN, "tx_ctx_mgr_ start error", KR(ret));
   } else if (OB_FAIL(tx_desc_mgr_.start())) {
     TRANS_LOG(WARN, "tx_desc_mgr_ start error", KR(ret));
+  } else if (OB_FAIL(callback_list_end_worker_.start())) {
+    TRANS_LOG(WARN, "callback list end worker start error", KR(ret));
   } else {
     is_running_ = true;
 
@@ -265,6 +269,7 @@ void ObTransService::stop()
     dup_table_rpc_->stop();
     gti_source_->stop();
     dup_table_loop_worker_.stop();
+    callback_list_end_worker_.stop();
     ObSimpleThreadPool::stop();
     is_running_ = false;
     TRANS_LOG(INFO, "transaction service stop success", KPC(this));
@@ -294,6 +299,7 @@ int ObTransService::wait_()
     // dup_table_rpc_->wait();
     gti_source_->wait();
     dup_table_loop_worker_.wait();
+    callback_list_end_worker_.wait();
     TRANS_LOG(INFO, "transaction service wait success", KPC(this));
   }
   return ret;
@@ -310,6 +316,7 @@ void ObTransService::destroy()
     dup_table_scan_timer_.destroy();
     dup_tablet_scan_task_.destroy();
     dup_table_loop_worker_.destroy();
+    callback_list_end_worker_.destroy();
     if (use_def_) {
       rpc_->destroy();
       location_adapter_->destroy();
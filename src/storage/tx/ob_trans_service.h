@@ -245,6 +245,7 @@ public:
                            const int64_t request_id = 0,
                            const ObRegisterMdsFlag &register_flag = ObRegisterMdsFlag());
   ObTxELRUtil &get_tx_elr_util() { return elr_util_; }
+  memtable::ObTxCallbackListEndWorker &get_callback_list_end_worker() { return callback_list_end_worker_; }
 #ifdef ENABLE_DEBUG_LOG
   transaction::ObDefensiveCheckMgr *get_defensive_check_mgr() { return defensive_check_mgr_; }
 #endif
@@ -341,6 +342,8 @@ private:
 
   obrpc::ObSrvRpcProxy *rpc_proxy_;
   ObTxELRUtil elr_util_;
+  // helper threads to end callback lists of large transactions
+  memtable::ObTxCallbackListEndWorker callback_list_end_worker_;
   // for rollback-savepoint request-id
   int64_t rollback_sp_msg_sequence_;
   // for rollback-savepoint msg resp callback to find tx_desc
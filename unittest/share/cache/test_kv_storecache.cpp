@@ -686,6 +686,103 @@ TEST_F(TestKVCache, test_hold_size)
   ASSERT_TRUE(cache.store_size(tenant_id_) >= hold_size);
 }
 
+TEST(ObKVCacheFrequencySketch, normal)
+{
+  const uint8_t max_freq = ObKVCacheFrequencySketch::MAX_FREQ;
+  ObKVCacheFrequencySketch *sketch = OB_NEW(ObKVCacheFrequencySketch, "TestSketch");
+  ASSERT_TRUE(nullptr != sketch);
+  // the width follows the capacity within bounds
+  ASSERT_EQ(OB_SUCCESS, sketch->init(0, ObMemAttr(OB_SERVER_TENANT_ID, "TestSketch")));
+  ASSERT_EQ(OB_INIT_TWICE, sketch->init(0, ObMemAttr(OB_SERVER_TENANT_ID, "TestSketch")));
+  ASSERT_EQ(ObKVCacheFrequencySketch::MIN_WIDTH, sketch->get_width());
+  sketch->destroy();
+  ASSERT_EQ(OB_SUCCESS, sketch->init(INT64_MAX, ObMemAttr(OB_SERVER_TENANT_ID, "TestSketch")));
+  ASSERT_EQ(ObKVCacheFrequencySketch::MAX_WIDTH, sketch->get_width());
+  sketch->destroy();
+  const int64_t capacity = 3 * ObKVCacheFrequencySketch::MIN_WIDTH;
+  ASSERT_EQ(OB_SUCCESS, sketch->init(capacity, ObMemAttr(OB_SERVER_TENANT_ID, "TestSketch")));
+  ASSERT_EQ(4 * ObKVCacheFrequencySketch::MIN_WIDTH, sketch->get_width());
+  const int64_t sample_size = sketch->get_sample_size();
+  ASSERT_EQ(ObKVCacheFrequencySketch::SAMPLE_FACTOR * sketch->get_width(), sample_size);
+
+  ASSERT_EQ(0, sketch->estimate(1));
+  sketch->increment(1);
+  ASSERT_EQ(1, sketch->estimate(1));
+  for (int64_t i = 0; i < 2 * max_freq; ++i) {
+    sketch->increment(2);
+  }
+  ASSERT_EQ(max_freq, sketch->estimate(2));
+
+  // counters are halved after enough samples
+  for (int64_t i = sketch->sample_cnt_; i < sample_size; ++i) {
+    sketch->increment(i + 100);
+  }
+  ASSERT_EQ(sample_size / 2, sketch->sample_cnt_);
+  ASSERT_EQ(max_freq / 2, sketch->estimate(2));
+  ob_delete(sketch);
+}
+
+TEST_F(TestKVCache, test_admission)
+{
+  static const int64_t K_SIZE = 16;
+  static const int64_t V_SIZE = 64;
+  typedef TestKVCacheKey<K_SIZE> TestKey;
+  typedef TestKVCacheValue<V_SIZE> TestValue;
+
+  GCONF._enable_kvcache_admission = true;
+  ObKVCache<TestKey, TestValue> cache;
+  ASSERT_EQ(OB_SUCCESS, cache.init("test_admission", 1, true /*enable_admission*/));
+  ObKVCacheInstHandle inst_handle;
+  ObKVCacheInstKey inst_key(cache.get_cache_id(), tenant_id_);
+  ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().insts_.get_cache_inst(inst_key, inst_handle));
+  ASSERT_TRUE(nullptr != inst_handle.get_inst()->sketch_);
+
+  TestKey key;
+  TestValue value;
+  const TestValue *pvalue = nullptr;
+  ObKVCacheHandle handle;
+  key.tenant_id_ = tenant_id_;
+  value.v_ = 4321;
+
+  // kv put for the first time is on probationary memblock, and moved to LFU memblock once hit
+  key.v_ = 1;
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(1, inst_handle.get_inst()->status_.admission_probation_cnt_.value());
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  ASSERT_EQ(PROBATION, handle.mb_handle_->policy_);
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  ASSERT_EQ(LFU, handle.mb_handle_->policy_);
+  ASSERT_EQ(value.v_, pvalue->v_);
+
+  // kv put again is admitted
+  key.v_ = 2;
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(2, inst_handle.get_inst()->status_.admission_probation_cnt_.value());
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  ASSERT_EQ(LRU, handle.mb_handle_->policy_);
+  handle.reset();
+
+  // hits are sampled
+  ObKVCacheInst *inst = inst_handle.get_inst();
+  const uint64_t hash = 12345;
+  const int64_t sample_rate = ObKVCacheInst::HIT_SAMPLE_RATE;
+  ASSERT_EQ(0, inst->sketch_->estimate(hash));
+  for (int64_t i = 0; i < 3 * sample_rate; ++i) {
+    inst->record_access(hash);
+  }
+  ASSERT_EQ(3, inst->sketch_->estimate(hash));
+
+  // kvs of a cache are all admitted when admission is off
+  GCONF._enable_kvcache_admission = false;
+  key.v_ = 3;
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(2, inst->status_.admission_probation_cnt_.value());
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  ASSERT_EQ(LRU, handle.mb_handle_->policy_);
+  handle.reset();
+}
+
 // TEST_F(TestKVCache, sync_wash_mbs)
 // {
 //   CHUNK_MGR.set_limit(512 * 1024 * 1024);
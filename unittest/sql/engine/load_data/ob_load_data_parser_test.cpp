@@ -13,6 +13,7 @@
 #define USING_LOG_PREFIX SQL
 
 #include <gtest/gtest.h>
+#include <vector>
 //#include "lib/utility/ob_test_util.h"
 //#include "sql/engine/test_engine_util.h"
 #include "sql/ob_sql_init.h"
@@ -305,6 +306,48 @@ TEST_F(TestParser, general_parser_escape)
 
 }
 
+TEST_F(TestParser, general_parser_long_fields)
+{
+  ObDataInFileStruct file_struct;
+  file_struct.field_term_str_ = ",";
+  file_struct.field_enclosed_str_ = "\"";
+  file_struct.field_enclosed_char_ = '"';
+  ObCSVGeneralParser parser;
+  ASSERT_EQ(OB_SUCCESS, parser.init(file_struct, 3, CS_TYPE_UTF8MB4_BIN));
+
+  // fields longer than one simd block, with escaped, enclosed and multi-byte chars
+  std::string f1(70, 'a');
+  std::string f2 = std::string(40, 'b') + "\"\"" + std::string(20, 'c');
+  std::string f3 = std::string(33, 'd') + "\\t" + "\xe4\xb8\xad\xe6\x96\x87" + std::string(31, 'e');
+  std::string line = f1 + ",\"" + f2 + "\"," + f3 + "\n";
+  std::string data = line + line;
+
+  char escape_buf[1024];
+  std::vector<std::string> values;
+  auto handle_line = [&values](ObIArray<ObCSVGeneralParser::FieldValue> &arr) -> int {
+    for (int64_t i = 0; i < arr.count(); ++i) {
+      values.push_back(std::string(arr.at(i).ptr_, arr.at(i).len_));
+    }
+    return OB_SUCCESS;
+  };
+  ObSEArray<ObCSVGeneralParser::LineErrRec, 4> error_msgs;
+  const char *ptr = data.c_str();
+  const char *end = ptr + data.length();
+  int64_t nrows = 10;
+  ASSERT_EQ(OB_SUCCESS, (parser.scan<decltype(handle_line), true>(ptr, end, nrows,
+                                     escape_buf, escape_buf + sizeof(escape_buf),
+                                     handle_line, error_msgs, false)));
+  ASSERT_EQ(2, nrows);
+  ASSERT_EQ(0, error_msgs.count());
+  ASSERT_EQ(6, static_cast<int64_t>(values.size()));
+  for (int64_t i = 0; i < 2; ++i) {
+    ASSERT_EQ(f1, values[i * 3]);
+    ASSERT_EQ(std::string(40, 'b') + "\"" + std::string(20, 'c'), values[i * 3 + 1]);
+    ASSERT_EQ(std::string(33, 'd') + "\t" + "\xe4\xb8\xad\xe6\x96\x87" + std::string(31, 'e'),
+              values[i * 3 + 2]);
+  }
+}
+
 int main(int argc, char **argv)
 {
   init_sql_factories();
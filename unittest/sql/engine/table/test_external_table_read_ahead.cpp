@@ -0,0 +1,245 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <fstream>
+#include <string>
+#define private public
+#define protected public
+#include "sql/engine/table/ob_external_table_read_ahead.h"
+#include "sql/engine/table/ob_external_table_access_service.h"
+#include "share/ob_device_manager.h"
+#include "lib/allocator/page_arena.h"
+#include "lib/worker.h"
+#undef private
+#undef protected
+
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+namespace
+{
+static const int64_t BUF_SIZE = 64;
+static const int64_t WINDOW = 4;
+
+class TestExternalTableReadAhead : public ::testing::Test
+{
+public:
+  static void SetUpTestCase()
+  {
+    ASSERT_EQ(OB_SUCCESS, oceanbase::common::ObDeviceManager::get_instance().init_devices_env());
+  }
+  static void TearDownTestCase()
+  {
+    oceanbase::common::ObDeviceManager::get_instance().destroy();
+  }
+  virtual void SetUp() override
+  {
+    char cwd[OB_MAX_FILE_NAME_LENGTH];
+    ASSERT_NE(nullptr, getcwd(cwd, sizeof(cwd)));
+    dir_ = std::string(cwd) + "/test_external_table_read_ahead_dir";
+    ASSERT_EQ(0, system(("rm -rf " + dir_ + " && mkdir -p " + dir_).c_str()));
+    const std::string location = "file://" + dir_;
+    ASSERT_EQ(OB_SUCCESS, driver_.init(ObString(location.c_str()), ObString()));
+  }
+  virtual void TearDown() override
+  {
+    reader_.destroy();
+    if (driver_.is_opened()) {
+      driver_.close();
+    }
+    THIS_WORKER.set_timeout_ts(INT64_MAX);
+    system(("rm -rf " + dir_).c_str());
+  }
+  // write a file of %size bytes with known content and open it with the driver
+  void open_file(const int64_t size)
+  {
+    if (driver_.is_opened()) {
+      driver_.close();
+    }
+    const std::string path = dir_ + "/data";
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    for (int64_t i = 0; i < size; ++i) {
+      out.put(byte_at(i));
+    }
+    out.close();
+    url_ = "file://" + path;
+    ASSERT_EQ(OB_SUCCESS, driver_.open(ObString(url_.c_str())));
+  }
+  static char byte_at(const int64_t offset) { return static_cast<char>(offset % 251); }
+  // read the whole file by %chunk bytes and check the content
+  void read_all(const int64_t file_size, const int64_t chunk)
+  {
+    char buf[1024];
+    int64_t offset = 0;
+    int64_t read_size = 0;
+    ASSERT_LE(chunk, static_cast<int64_t>(sizeof(buf)));
+    do {
+      ASSERT_EQ(OB_SUCCESS, reader_.read(buf, chunk, read_size));
+      ASSERT_EQ(MIN(chunk, file_size - offset), read_size) << offset;
+      for (int64_t i = 0; i < read_size; ++i) {
+        ASSERT_EQ(byte_at(offset + i), buf[i]) << offset + i;
+      }
+      offset += read_size;
+    } while (read_size > 0);
+    ASSERT_EQ(file_size, offset);
+    // stays at the end of file
+    ASSERT_EQ(OB_SUCCESS, reader_.read(buf, chunk, read_size));
+    ASSERT_EQ(0, read_size);
+  }
+protected:
+  std::string dir_;
+  std::string url_;
+  ObArenaAllocator allocator_;
+  ObExternalDataAccessDriver driver_;
+  ObExternalScanStat stat_;
+  ObExternalReadAheader reader_;
+};
+
+TEST_F(TestExternalTableReadAhead, init)
+{
+  ObExternalReadAheader reader;
+  char buf[16];
+  int64_t read_size = 0;
+  ASSERT_EQ(OB_NOT_INIT, reader.read(buf, sizeof(buf), read_size));
+  ASSERT_EQ(OB_NOT_INIT, reader.start(100));
+  ASSERT_EQ(OB_SUCCESS, reader.stop());
+  ASSERT_EQ(OB_INVALID_ARGUMENT, reader.init(allocator_, driver_, 0, BUF_SIZE, stat_));
+  ASSERT_EQ(OB_INVALID_ARGUMENT,
+            reader.init(allocator_, driver_, ObExternalReadAheader::MAX_WINDOW + 1, BUF_SIZE, stat_));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, reader.init(allocator_, driver_, WINDOW, 0, stat_));
+  ASSERT_EQ(OB_SUCCESS, reader.init(allocator_, driver_, WINDOW, BUF_SIZE, stat_));
+  ASSERT_EQ(OB_INIT_TWICE, reader.init(allocator_, driver_, WINDOW, BUF_SIZE, stat_));
+}
+
+TEST_F(TestExternalTableReadAhead, buffer_boundary)
+{
+  ASSERT_EQ(OB_SUCCESS, reader_.init(allocator_, driver_, WINDOW, BUF_SIZE, stat_));
+  // smaller than one buffer, exactly the window, across several windows
+  const int64_t file_sizes[] = {1, BUF_SIZE - 1, BUF_SIZE, BUF_SIZE + 1, WINDOW * BUF_SIZE,
+                                10 * BUF_SIZE + 37};
+  const int64_t chunks[] = {1, BUF_SIZE - 1, BUF_SIZE, BUF_SIZE + 1, 3 * BUF_SIZE + 5, 1000};
+  for (const int64_t file_size : file_sizes) {
+    for (const int64_t chunk : chunks) {
+      open_file(file_size);
+      stat_.reset();
+      ASSERT_EQ(OB_SUCCESS, reader_.start(file_size));
+      read_all(file_size, chunk);
+      ASSERT_EQ(OB_SUCCESS, reader_.stop());
+      ASSERT_EQ(0, reader_.inflight_cnt_);
+      ASSERT_EQ(file_size, stat_.read_bytes_);
+    }
+  }
+}
+
+TEST_F(TestExternalTableReadAhead, empty_file)
+{
+  ASSERT_EQ(OB_SUCCESS, reader_.init(allocator_, driver_, WINDOW, BUF_SIZE, stat_));
+  open_file(0);
+  ASSERT_EQ(OB_SUCCESS, reader_.start(0));
+  read_all(0, BUF_SIZE);
+  ASSERT_EQ(0, stat_.read_count_);
+}
+
+TEST_F(TestExternalTableReadAhead, restart_before_eof)
+{
+  const int64_t file_size = 10 * BUF_SIZE + 37;
+  ASSERT_EQ(OB_SUCCESS, reader_.init(allocator_, driver_, WINDOW, BUF_SIZE, stat_));
+  open_file(file_size);
+  ASSERT_EQ(OB_SUCCESS, reader_.start(file_size));
+  char buf[BUF_SIZE];
+  int64_t read_size = 0;
+  ASSERT_EQ(OB_SUCCESS, reader_.read(buf, BUF_SIZE / 2, read_size));
+  ASSERT_EQ(BUF_SIZE / 2, read_size);
+  // reads left of the last file are waited or canceled, then the new one is read from start
+  ASSERT_EQ(OB_SUCCESS, reader_.start(file_size));
+  read_all(file_size, BUF_SIZE + 1);
+}
+
+TEST_F(TestExternalTableReadAhead, read_error)
+{
+  const int64_t file_size = 3 * BUF_SIZE;
+  ASSERT_EQ(OB_SUCCESS, reader_.init(allocator_, driver_, WINDOW, BUF_SIZE, stat_));
+  open_file(file_size);
+  // the file is shorter than expected, the data before the error is still returned
+  ASSERT_EQ(OB_SUCCESS, reader_.start(file_size + BUF_SIZE / 2));
+  char buf[4 * BUF_SIZE];
+  int64_t read_size = 0;
+  ASSERT_EQ(OB_SUCCESS, reader_.read(buf, file_size, read_size));
+  ASSERT_EQ(file_size, read_size);
+  ASSERT_NE(OB_SUCCESS, reader_.read(buf, BUF_SIZE, read_size));
+  ASSERT_EQ(OB_SUCCESS, reader_.stop());
+}
+
+TEST_F(TestExternalTableReadAhead, interrupt)
+{
+  ASSERT_EQ(OB_SUCCESS, reader_.init(allocator_, driver_, WINDOW, BUF_SIZE, stat_));
+  open_file(BUF_SIZE);
+  ASSERT_EQ(OB_SUCCESS, reader_.start(0));
+  // a read never done
+  ObExternalReadAheader::Slot &slot = reader_.slots_[0];
+  slot.offset_ = 0;
+  slot.data_len_ = BUF_SIZE;
+  slot.state_ = ObExternalReadAheader::SLOT_READING;
+  reader_.file_size_ = BUF_SIZE;
+  reader_.next_offset_ = BUF_SIZE;
+  reader_.inflight_cnt_ = 1;
+
+  THIS_WORKER.set_timeout_ts(ObTimeUtility::current_time() - 1);
+  char buf[BUF_SIZE];
+  int64_t read_size = 0;
+  ASSERT_EQ(OB_TIMEOUT, reader_.read(buf, BUF_SIZE, read_size));
+  ASSERT_EQ(OB_TIMEOUT, reader_.stop());
+  ASSERT_EQ(OB_TIMEOUT, reader_.start(BUF_SIZE));
+
+  // the read is done after stop, it is canceled without touching the file
+  THIS_WORKER.set_timeout_ts(INT64_MAX);
+  reader_.do_read(slot);
+  ASSERT_EQ(OB_CANCELED, slot.ret_);
+  ASSERT_EQ(0, reader_.inflight_cnt_);
+  ASSERT_EQ(OB_SUCCESS, reader_.stop());
+  ASSERT_EQ(OB_SUCCESS, reader_.start(BUF_SIZE));
+  read_all(BUF_SIZE, BUF_SIZE);
+}
+
+// keep it the last one, the shared pool is not usable after
+TEST_F(TestExternalTableReadAhead, pool_full)
+{
+  const int64_t file_size = 10 * BUF_SIZE + 37;
+  ObExternalReadAheadPool &pool = ObExternalReadAheadPool::get_instance();
+  ASSERT_EQ(OB_SUCCESS, reader_.init(allocator_, driver_, WINDOW, BUF_SIZE, stat_));
+  open_file(file_size);
+  ASSERT_EQ(OB_SUCCESS, reader_.start(file_size));
+  read_all(file_size, BUF_SIZE);
+  ASSERT_TRUE(pool.is_inited_);
+  // io threads are gone, every read is done by the scan thread
+  pool.ObSimpleThreadPool::destroy();
+  stat_.reset();
+  ASSERT_EQ(OB_SUCCESS, reader_.start(file_size));
+  ASSERT_EQ(0, reader_.inflight_cnt_);
+  ASSERT_EQ(WINDOW * BUF_SIZE, stat_.read_bytes_);
+  read_all(file_size, BUF_SIZE - 1);
+  ASSERT_EQ(file_size, stat_.read_bytes_);
+}
+}
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_external_table_read_ahead.log*");
+  OB_LOGGER.set_file_name("test_external_table_read_ahead.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,832 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+#include <vector>
+#define private public
+#define protected public
+#include "sql/engine/table/ob_parquet_table_row_iter.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
+#include "lib/compress/ob_compressor_pool.h"
+#undef private
+#undef protected
+
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+namespace
+{
+typedef ObParquetThriftReader TR;
+
+// Thrift compact protocol writer, the counterpart of ObParquetThriftReader
+class ThriftWriter
+{
+public:
+  ThriftWriter() : last_id_(0) {}
+  void byte(const uint8_t v) { buf_.push_back(static_cast<char>(v)); }
+  void varint(uint64_t v)
+  {
+    while (v >= 0x80) {
+      byte(static_cast<uint8_t>(v | 0x80));
+      v >>= 7;
+    }
+    byte(static_cast<uint8_t>(v));
+  }
+  void zigzag(const int64_t v) { varint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63)); }
+  void field(const int8_t type, const int16_t id)
+  {
+    const int16_t delta = id - last_id_;
+    if (delta > 0 && delta <= 15) {
+      byte(static_cast<uint8_t>((delta << 4) | type));
+    } else {
+      byte(static_cast<uint8_t>(type));
+      zigzag(id);
+    }
+    last_id_ = id;
+  }
+  void i32(const int16_t id, const int32_t v) { field(TR::T_I32, id); zigzag(v); }
+  void i64(const int16_t id, const int64_t v) { field(TR::T_I64, id); zigzag(v); }
+  void boolean(const int16_t id, const bool v) { field(v ? TR::T_BOOL_TRUE : TR::T_BOOL_FALSE, id); }
+  void binary(const int16_t id, const std::string &v)
+  {
+    field(TR::T_BINARY, id);
+    varint(v.size());
+    buf_.append(v);
+  }
+  void begin_struct(const int16_t id) { field(TR::T_STRUCT, id); begin_elem(); }
+  // struct element of a list has no field header
+  void begin_elem() { ids_.push_back(last_id_); last_id_ = 0; }
+  void end_struct() { byte(TR::T_STOP); last_id_ = ids_.back(); ids_.pop_back(); }
+  void begin_list(const int16_t id, const int8_t elem_type, const int64_t size)
+  {
+    field(TR::T_LIST, id);
+    if (size < 15) {
+      byte(static_cast<uint8_t>((size << 4) | elem_type));
+    } else {
+      byte(static_cast<uint8_t>(0xf0 | elem_type));
+      varint(size);
+    }
+  }
+  void stop() { byte(TR::T_STOP); }
+  const std::string &str() const { return buf_; }
+private:
+  std::string buf_;
+  int16_t last_id_;
+  std::vector<int16_t> ids_;
+};
+
+template <typename T>
+std::string plain(const std::vector<T> &values)
+{
+  return std::string(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+}
+
+std::string plain_strings(const std::vector<std::string> &values)
+{
+  std::string buf;
+  for (const std::string &v : values) {
+    const uint32_t len = static_cast<uint32_t>(v.size());
+    buf.append(reinterpret_cast<const char *>(&len), 4).append(v);
+  }
+  return buf;
+}
+
+// RLE runs of consecutive equal values, one byte per value
+std::string rle_levels(const std::vector<uint32_t> &levels)
+{
+  ThriftWriter w;
+  for (size_t i = 0; i < levels.size();) {
+    size_t j = i;
+    while (j < levels.size() && levels[j] == levels[i]) {
+      ++j;
+    }
+    w.varint((j - i) << 1);
+    w.byte(static_cast<uint8_t>(levels[i]));
+    i = j;
+  }
+  return w.str();
+}
+
+// one bit packed run, padded to groups of 8 values
+std::string bit_packed(const std::vector<uint32_t> &values, const int32_t bit_width)
+{
+  ThriftWriter w;
+  const int64_t groups = (values.size() + 7) / 8;
+  std::string packed(groups * bit_width, '\0');
+  for (size_t i = 0; i < values.size(); ++i) {
+    for (int32_t b = 0; b < bit_width; ++b) {
+      if (values[i] & (1U << b)) {
+        const int64_t bit = i * bit_width + b;
+        packed[bit >> 3] = static_cast<char>(packed[bit >> 3] | (1 << (bit & 7)));
+      }
+    }
+  }
+  w.varint((groups << 1) | 1);
+  return w.str() + packed;
+}
+
+std::string compress_page(const int32_t codec, const std::string &src)
+{
+  ObCompressorType type = INVALID_COMPRESSOR;
+  switch (codec) {
+    case 1: type = SNAPPY_COMPRESSOR; break;
+    case 6: type = ZSTD_COMPRESSOR; break;
+    case 7: type = LZ4_COMPRESSOR; break;
+    default: return src;
+  }
+  ObCompressor *compressor = nullptr;
+  int64_t overflow = 0;
+  int64_t len = 0;
+  EXPECT_EQ(OB_SUCCESS, ObCompressorPool::get_instance().get_compressor(type, compressor));
+  EXPECT_EQ(OB_SUCCESS, compressor->get_max_overflow_size(src.size(), overflow));
+  std::string dst(src.size() + overflow, '\0');
+  EXPECT_EQ(OB_SUCCESS, compressor->compress(src.data(), src.size(), &dst[0], dst.size(), len));
+  dst.resize(len);
+  return dst;
+}
+
+struct PageOpt
+{
+  PageOpt() : codec_(0), is_v2_(false), has_def_(false), encoding_(0) {}
+  int32_t codec_;
+  bool is_v2_;
+  bool has_def_;
+  int32_t encoding_;
+};
+
+std::string dict_page(const std::string &values, const int32_t num_values, const int32_t codec)
+{
+  const std::string body = compress_page(codec, values);
+  ThriftWriter w;
+  w.i32(1, 2 /* DICTIONARY_PAGE */);
+  w.i32(2, values.size());
+  w.i32(3, body.size());
+  w.begin_struct(7);
+  w.i32(1, num_values);
+  w.i32(2, 0 /* PLAIN */);
+  w.end_struct();
+  w.stop();
+  return w.str() + body;
+}
+
+std::string data_page(const std::vector<uint32_t> &def_levels, const std::string &values,
+                      const int32_t num_values, const PageOpt &opt)
+{
+  ThriftWriter w;
+  std::string levels = opt.has_def_ ? rle_levels(def_levels) : "";
+  std::string raw;
+  std::string body;
+  if (opt.is_v2_) {
+    const std::string compressed = compress_page(opt.codec_, values);
+    raw = levels + values;
+    body = levels + compressed;
+    w.i32(1, 3 /* DATA_PAGE_V2 */);
+  } else {
+    if (opt.has_def_) {
+      const uint32_t len = static_cast<uint32_t>(levels.size());
+      raw.append(reinterpret_cast<const char *>(&len), 4).append(levels);
+    }
+    raw.append(values);
+    body = compress_page(opt.codec_, raw);
+    w.i32(1, 0 /* DATA_PAGE */);
+  }
+  w.i32(2, raw.size());
+  w.i32(3, body.size());
+  if (opt.is_v2_) {
+    w.begin_struct(8);
+    w.i32(1, num_values);
+    w.i32(2, 0);
+    w.i32(3, num_values);
+    w.i32(4, opt.encoding_);
+    w.i32(5, levels.size());
+    w.i32(6, 0);
+    w.boolean(7, true);
+    w.end_struct();
+  } else {
+    w.begin_struct(5);
+    w.i32(1, num_values);
+    w.i32(2, opt.encoding_);
+    w.i32(3, 3 /* RLE */);
+    w.i32(4, 3 /* RLE */);
+    w.end_struct();
+  }
+  w.stop();
+  return w.str() + body;
+}
+
+ObParquetColumnDesc make_desc(const int32_t physical_type, const int16_t max_def_level = 0,
+                              const int32_t converted_type = ObParquetColumnDesc::NONE)
+{
+  ObParquetColumnDesc desc;
+  desc.physical_type_ = physical_type;
+  desc.max_def_level_ = max_def_level;
+  desc.converted_type_ = converted_type;
+  return desc;
+}
+
+std::string le_bytes(const int64_t v, const int64_t width)
+{
+  return std::string(reinterpret_cast<const char *>(&v), width);
+}
+
+std::string le_double(const double v)
+{
+  return std::string(reinterpret_cast<const char *>(&v), sizeof(v));
+}
+}
+
+class TestParquetTableRowIter : public ::testing::Test
+{
+public:
+  TestParquetTableRowIter() : allocator_(), rg_allocator_(), batch_allocator_() {}
+  virtual void TearDown() override
+  {
+    rg_allocator_.reset();
+    batch_allocator_.reset();
+  }
+  // read %expected.size() values of the chunk, "NULL" stands for null
+  void check_chunk(const ObParquetColumnDesc &desc, const std::string &chunk, const int32_t codec,
+                   const std::vector<std::string> &expected)
+  {
+    ObParquetColumnReader reader(allocator_);
+    ObParquetChunkMeta meta;
+    std::vector<ObDatum> datums(expected.size());
+    meta.codec_ = codec;
+    meta.num_values_ = expected.size();
+    meta.size_ = chunk.size();
+    reader.set_desc(desc);
+    ASSERT_EQ(OB_SUCCESS, reader.open_chunk(meta, chunk.data(), rg_allocator_));
+    // read in two batches, so that a batch may cross pages
+    const int64_t first = expected.size() / 2;
+    ASSERT_EQ(OB_SUCCESS, reader.read(datums.data(), first, batch_allocator_));
+    ASSERT_EQ(OB_SUCCESS, reader.read(datums.data() + first, expected.size() - first, batch_allocator_));
+    for (size_t i = 0; i < expected.size(); ++i) {
+      if (expected[i] == "NULL") {
+        EXPECT_TRUE(datums[i].is_null()) << i;
+      } else {
+        ASSERT_FALSE(datums[i].is_null()) << i;
+        EXPECT_EQ(expected[i], std::string(datums[i].get_string().ptr(), datums[i].get_string().length())) << i;
+      }
+    }
+    // no more values in the chunk
+    ObDatum extra;
+    EXPECT_EQ(OB_INVALID_DATA, reader.read(&extra, 1, batch_allocator_));
+  }
+  int read_chunk(const ObParquetColumnDesc &desc, const std::string &chunk, const int64_t count)
+  {
+    int ret = OB_SUCCESS;
+    ObParquetColumnReader reader(allocator_);
+    ObParquetChunkMeta meta;
+    std::vector<ObDatum> datums(count);
+    meta.size_ = chunk.size();
+    reader.set_desc(desc);
+    if (OB_SUCC(reader.open_chunk(meta, chunk.data(), rg_allocator_))) {
+      ret = reader.read(datums.data(), count, batch_allocator_);
+    }
+    return ret;
+  }
+  // file metadata with columns id INT64 required, name UTF8 optional, score DOUBLE optional,
+  // and two row groups of 3 and 2 rows
+  static std::string make_file_meta(const bool with_repeated = false)
+  {
+    ThriftWriter w;
+    w.i32(1, 1);
+    w.begin_list(2, TR::T_STRUCT, with_repeated ? 5 : 4);
+    w.begin_elem();
+    w.binary(4, "schema");
+    w.i32(5, with_repeated ? 4 : 3);
+    w.end_struct();
+    w.begin_elem();
+    w.i32(1, ObParquetColumnDesc::INT64);
+    w.i32(3, 0 /* REQUIRED */);
+    w.binary(4, "id");
+    w.end_struct();
+    w.begin_elem();
+    w.i32(1, ObParquetColumnDesc::BYTE_ARRAY);
+    w.i32(3, 1 /* OPTIONAL */);
+    w.binary(4, "name");
+    w.i32(6, ObParquetColumnDesc::UTF8);
+    w.end_struct();
+    w.begin_elem();
+    w.i32(1, ObParquetColumnDesc::DOUBLE);
+    w.i32(3, 1 /* OPTIONAL */);
+    w.binary(4, "score");
+    w.end_struct();
+    if (with_repeated) {
+      w.begin_elem();
+      w.i32(1, ObParquetColumnDesc::INT32);
+      w.i32(3, 2 /* REPEATED */);
+      w.binary(4, "tags");
+      w.end_struct();
+    }
+    w.i64(3, 5);
+    w.begin_list(4, TR::T_STRUCT, 2);
+    for (int64_t rg = 0; rg < 2; ++rg) {
+      w.begin_elem();
+      w.begin_list(1, TR::T_STRUCT, with_repeated ? 4 : 3);
+      for (int64_t col = 0; col < (with_repeated ? 4 : 3); ++col) {
+        const int64_t base = 4 + rg * 3000 + col * 1000;
+        w.begin_elem();
+        w.i64(2, base);
+        w.begin_struct(3);
+        w.i32(1, ObParquetColumnDesc::INT64);
+        w.i32(4, 1 /* SNAPPY */);
+        w.i64(5, 3 - rg);
+        w.i64(7, 900);
+        w.i64(9, base + 100);
+        if (1 == col) {
+          // dictionary page is in front of data pages
+          w.i64(11, base);
+        }
+        if (0 == col) {
+          w.begin_struct(12);
+          w.i64(3, 0);
+          w.binary(5, le_bytes(10 * (rg + 1) + 9, 8));
+          w.binary(6, le_bytes(10 * (rg + 1), 8));
+          w.end_struct();
+        }
+        w.end_struct();
+        w.end_struct();
+      }
+      w.i64(2, 2700);
+      w.i64(3, 3 - rg);
+      w.end_struct();
+    }
+    w.stop();
+    return w.str();
+  }
+  static void prepare_iter(ObParquetTableRowIterator &iter, const std::vector<int64_t> &leaf_idxs)
+  {
+    iter.file_size_ = 1L << 20;
+    for (const int64_t leaf_idx : leaf_idxs) {
+      ObParquetColumnReader *reader = OB_NEWx(ObParquetColumnReader, &iter.allocator_, iter.allocator_);
+      ASSERT_TRUE(nullptr != reader);
+      ASSERT_EQ(OB_SUCCESS, iter.column_readers_.push_back(reader));
+      ASSERT_EQ(OB_SUCCESS, iter.file_col_leaf_idxs_.push_back(leaf_idx));
+    }
+  }
+  static void reuse_meta(ObParquetTableRowIterator &iter)
+  {
+    iter.leaf_descs_.reuse();
+    iter.row_groups_.reuse();
+    iter.chunk_metas_.reuse();
+  }
+protected:
+  ObArenaAllocator allocator_;
+  ObArenaAllocator rg_allocator_;
+  ObArenaAllocator batch_allocator_;
+};
+
+TEST_F(TestParquetTableRowIter, thrift_reader)
+{
+  ThriftWriter w;
+  w.i32(1, -5);
+  w.i64(3, 1L << 40);
+  w.binary(20, "abc");
+  w.begin_list(21, TR::T_I32, 20);
+  for (int64_t i = 0; i < 20; ++i) {
+    w.zigzag(i);
+  }
+  w.stop();
+  const std::string &buf = w.str();
+
+  TR reader(buf.data(), buf.size());
+  int8_t type = TR::T_STOP;
+  int16_t field_id = 0;
+  int32_t i32 = 0;
+  int64_t i64 = 0;
+  ObString str;
+  ASSERT_EQ(OB_SUCCESS, reader.read_field_begin(type, field_id));
+  ASSERT_EQ(TR::T_I32, type);
+  ASSERT_EQ(1, field_id);
+  ASSERT_EQ(OB_SUCCESS, reader.read_i32(i32));
+  ASSERT_EQ(-5, i32);
+  ASSERT_EQ(OB_SUCCESS, reader.read_field_begin(type, field_id));
+  ASSERT_EQ(3, field_id);
+  ASSERT_EQ(OB_SUCCESS, reader.read_i64(i64));
+  ASSERT_EQ(1L << 40, i64);
+  // field id delta larger than 15 is written in full
+  ASSERT_EQ(OB_SUCCESS, reader.read_field_begin(type, field_id));
+  ASSERT_EQ(20, field_id);
+  ASSERT_EQ(OB_SUCCESS, reader.read_binary(str));
+  ASSERT_EQ(0, str.compare("abc"));
+  ASSERT_EQ(OB_SUCCESS, reader.read_field_begin(type, field_id));
+  ASSERT_EQ(TR::T_LIST, type);
+  ASSERT_EQ(OB_SUCCESS, reader.skip(type));
+  ASSERT_EQ(OB_SUCCESS, reader.read_field_begin(type, field_id));
+  ASSERT_EQ(TR::T_STOP, type);
+
+  // truncated input at any position is invalid
+  for (int64_t len = 0; len < static_cast<int64_t>(buf.size()); ++len) {
+    TR truncated(buf.data(), len);
+    int ret = OB_SUCCESS;
+    field_id = 0;
+    do {
+      if (OB_FAIL(truncated.read_field_begin(type, field_id))) {
+      } else if (TR::T_STOP != type) {
+        ret = truncated.skip(type);
+      }
+    } while (OB_SUCC(ret) && TR::T_STOP != type);
+    ASSERT_EQ(OB_INVALID_DATA, ret) << len;
+  }
+
+  // too deep nesting and unknown type
+  std::string deep;
+  for (int64_t i = 0; i < 100; ++i) {
+    deep.push_back(static_cast<char>((1 << 4) | TR::T_STRUCT));
+  }
+  TR deep_reader(deep.data(), deep.size());
+  ASSERT_EQ(OB_INVALID_DATA, deep_reader.skip(TR::T_STRUCT));
+  TR unknown_reader(deep.data(), deep.size());
+  ASSERT_EQ(OB_INVALID_DATA, unknown_reader.skip(13));
+}
+
+TEST_F(TestParquetTableRowIter, parse_file_meta)
+{
+  const std::string meta = make_file_meta();
+  ObParquetTableRowIterator iter;
+  prepare_iter(iter, {0, 2});
+  ASSERT_EQ(OB_SUCCESS, iter.parse_file_meta(meta.data(), meta.size()));
+
+  ASSERT_EQ(3, iter.leaf_descs_.count());
+  EXPECT_EQ(ObParquetColumnDesc::INT64, iter.leaf_descs_.at(0).physical_type_);
+  EXPECT_EQ(0, iter.leaf_descs_.at(0).max_def_level_);
+  EXPECT_EQ(ObParquetColumnDesc::BYTE_ARRAY, iter.leaf_descs_.at(1).physical_type_);
+  EXPECT_EQ(ObParquetColumnDesc::UTF8, iter.leaf_descs_.at(1).converted_type_);
+  EXPECT_EQ(1, iter.leaf_descs_.at(1).max_def_level_);
+  EXPECT_EQ(ObParquetColumnDesc::DOUBLE, iter.column_readers_.at(1)->get_desc().physical_type_);
+
+  ASSERT_EQ(2, iter.row_groups_.count());
+  EXPECT_EQ(3, iter.row_groups_.at(0).num_rows_);
+  EXPECT_EQ(1, iter.row_groups_.at(0).first_row_);
+  EXPECT_EQ(2, iter.row_groups_.at(1).num_rows_);
+  EXPECT_EQ(4, iter.row_groups_.at(1).first_row_);
+
+  // only the projected columns are kept, row group by row group
+  ASSERT_EQ(4, iter.chunk_metas_.count());
+  const ObParquetChunkMeta &id_meta = iter.chunk_metas_.at(2);
+  EXPECT_EQ(1, id_meta.codec_);
+  EXPECT_EQ(2, id_meta.num_values_);
+  EXPECT_EQ(4 + 3000 + 100, id_meta.offset_);
+  EXPECT_EQ(900, id_meta.size_);
+  EXPECT_TRUE(id_meta.has_stats_);
+  EXPECT_EQ(0, id_meta.null_count_);
+  EXPECT_EQ(20, *reinterpret_cast<const int64_t *>(id_meta.min_.ptr()));
+  EXPECT_EQ(29, *reinterpret_cast<const int64_t *>(id_meta.max_.ptr()));
+  EXPECT_FALSE(iter.chunk_metas_.at(1).has_stats_);
+
+  // dictionary page offset is the start of the chunk
+  ObParquetTableRowIterator name_iter;
+  prepare_iter(name_iter, {1});
+  ASSERT_EQ(OB_SUCCESS, name_iter.parse_file_meta(meta.data(), meta.size()));
+  EXPECT_EQ(4 + 1000, name_iter.chunk_metas_.at(0).offset_);
+
+  // repeated column can not be read
+  const std::string repeated_meta = make_file_meta(true);
+  ObParquetTableRowIterator repeated_iter;
+  prepare_iter(repeated_iter, {3});
+  ASSERT_EQ(OB_NOT_SUPPORTED, repeated_iter.parse_file_meta(repeated_meta.data(), repeated_meta.size()));
+}
+
+TEST_F(TestParquetTableRowIter, corrupt_file_meta)
+{
+  const std::string meta = make_file_meta();
+  ObParquetTableRowIterator iter;
+  prepare_iter(iter, {0, 2});
+
+  // truncated metadata
+  for (int64_t len = 0; len < static_cast<int64_t>(meta.size()); ++len) {
+    reuse_meta(iter);
+    ASSERT_EQ(OB_INVALID_DATA, iter.parse_file_meta(meta.data(), len)) << len;
+  }
+
+  // column chunk out of file
+  reuse_meta(iter);
+  iter.file_size_ = 4000;
+  ASSERT_EQ(OB_INVALID_DATA, iter.parse_file_meta(meta.data(), meta.size()));
+
+  // garbage in metadata, never crash
+  std::string garbage = meta;
+  for (size_t i = 0; i < garbage.size(); i += 7) {
+    garbage[i] = static_cast<char>(garbage[i] ^ 0x5a);
+  }
+  reuse_meta(iter);
+  iter.file_size_ = 1L << 20;
+  ASSERT_NE(OB_SUCCESS, iter.parse_file_meta(garbage.data(), garbage.size()));
+
+  // file too small to hold footer, checked before any read
+  iter.file_size_ = ObParquetTableRowIterator::FOOTER_SIZE + 3;
+  ASSERT_EQ(OB_INVALID_DATA, iter.read_file_meta());
+}
+
+TEST_F(TestParquetTableRowIter, plain_pages)
+{
+  const ObParquetColumnDesc int_desc = make_desc(ObParquetColumnDesc::INT64);
+  const ObParquetColumnDesc str_desc = make_desc(ObParquetColumnDesc::BYTE_ARRAY, 0, ObParquetColumnDesc::UTF8);
+  const ObParquetColumnDesc double_desc = make_desc(ObParquetColumnDesc::DOUBLE);
+  const ObParquetColumnDesc date_desc = make_desc(ObParquetColumnDesc::INT32, 0, ObParquetColumnDesc::DATE);
+  const ObParquetColumnDesc bool_desc = make_desc(ObParquetColumnDesc::BOOLEAN);
+  for (int64_t v2 = 0; v2 < 2; ++v2) {
+    PageOpt opt;
+    opt.is_v2_ = (1 == v2);
+    // two pages in one chunk
+    std::string chunk = data_page({}, plain<int64_t>({1, -2}), 2, opt)
+                        + data_page({}, plain<int64_t>({INT64_MAX}), 1, opt);
+    check_chunk(int_desc, chunk, 0, {"1", "-2", "9223372036854775807"});
+
+    chunk = data_page({}, plain_strings({"abc", "", "hello world"}), 3, opt);
+    check_chunk(str_desc, chunk, 0, {"abc", "", "hello world"});
+
+    chunk = data_page({}, plain<double>({1.5, -0.25}), 2, opt);
+    check_chunk(double_desc, chunk, 0, {"1.5", "-0.25"});
+
+    chunk = data_page({}, plain<int32_t>({0, 19000}), 2, opt);
+    check_chunk(date_desc, chunk, 0, {"1970-01-01", "2022-01-08"});
+
+    chunk = data_page({}, std::string(1, static_cast<char>(0x05)), 3, opt);
+    check_chunk(bool_desc, chunk, 0, {"1", "0", "1"});
+  }
+}
+
+TEST_F(TestParquetTableRowIter, dictionary_pages)
+{
+  const ObParquetColumnDesc str_desc = make_desc(ObParquetColumnDesc::BYTE_ARRAY, 0, ObParquetColumnDesc::UTF8);
+  const ObParquetColumnDesc int_desc = make_desc(ObParquetColumnDesc::INT32);
+  const std::vector<uint32_t> idxs = {2, 0, 1, 1, 2, 0, 0, 2, 1};
+  const std::vector<std::string> expected = {"c", "a", "b", "b", "c", "a", "a", "c", "b"};
+  for (int64_t v2 = 0; v2 < 2; ++v2) {
+    for (const int32_t encoding : {2 /* PLAIN_DICTIONARY */, 8 /* RLE_DICTIONARY */}) {
+      PageOpt opt;
+      opt.is_v2_ = (1 == v2);
+      opt.encoding_ = encoding;
+      // bit packed indexes
+      std::string chunk = dict_page(plain_strings({"a", "b", "c"}), 3, 0)
+                          + data_page({}, std::string(1, 2) + bit_packed(idxs, 2), idxs.size(), opt);
+      check_chunk(str_desc, chunk, 0, expected);
+      // rle indexes
+      chunk = dict_page(plain<int32_t>({7, -7}), 2, 0)
+              + data_page({}, std::string(1, 1) + rle_levels({1, 1, 1, 0}), 4, opt);
+      check_chunk(int_desc, chunk, 0, {"-7", "-7", "-7", "7"});
+    }
+  }
+
+  // data page without dictionary page
+  PageOpt opt;
+  opt.encoding_ = 8;
+  const std::string chunk = data_page({}, std::string(1, 1) + rle_levels({1}), 1, opt);
+  ASSERT_EQ(OB_INVALID_DATA, read_chunk(int_desc, chunk, 1));
+  // index out of dictionary
+  const std::string bad_idx_chunk = dict_page(plain<int32_t>({7}), 1, 0)
+                                    + data_page({}, std::string(1, 2) + rle_levels({3}), 1, opt);
+  ASSERT_EQ(OB_INVALID_DATA, read_chunk(int_desc, bad_idx_chunk, 1));
+}
+
+TEST_F(TestParquetTableRowIter, codecs)
+{
+  const ObParquetColumnDesc str_desc = make_desc(ObParquetColumnDesc::BYTE_ARRAY, 1, ObParquetColumnDesc::UTF8);
+  std::vector<std::string> values;
+  std::vector<std::string> expected;
+  std::vector<uint32_t> def_levels;
+  for (int64_t i = 0; i < 200; ++i) {
+    def_levels.push_back(i % 5 == 0 ? 0 : 1);
+    if (i % 5 == 0) {
+      expected.push_back("NULL");
+    } else {
+      values.push_back("value_" + std::to_string(i % 13));
+      expected.push_back(values.back());
+    }
+  }
+  for (const int32_t codec : {0 /* UNCOMPRESSED */, 1 /* SNAPPY */, 6 /* ZSTD */, 7 /* LZ4_RAW */}) {
+    for (int64_t v2 = 0; v2 < 2; ++v2) {
+      PageOpt opt;
+      opt.codec_ = codec;
+      opt.is_v2_ = (1 == v2);
+      opt.has_def_ = true;
+      const std::string chunk = data_page(def_levels, plain_strings(values), def_levels.size(), opt);
+      check_chunk(str_desc, chunk, codec, expected);
+    }
+    // dictionary page is compressed as well
+    PageOpt opt;
+    opt.codec_ = codec;
+    opt.encoding_ = 8;
+    const std::string chunk = dict_page(plain_strings({"x", "y"}), 2, codec)
+                              + data_page({}, std::string(1, 1) + rle_levels({1, 0}), 2, opt);
+    check_chunk(make_desc(ObParquetColumnDesc::BYTE_ARRAY), chunk, codec, {"y", "x"});
+  }
+
+  // GZIP is not supported
+  PageOpt opt;
+  const std::string chunk = data_page({}, plain<int64_t>({1}), 1, opt);
+  ObParquetColumnReader reader(allocator_);
+  ObParquetChunkMeta meta;
+  ObDatum datum;
+  meta.codec_ = 2;
+  meta.size_ = chunk.size();
+  reader.set_desc(make_desc(ObParquetColumnDesc::INT64));
+  ASSERT_EQ(OB_SUCCESS, reader.open_chunk(meta, chunk.data(), rg_allocator_));
+  ASSERT_EQ(OB_NOT_SUPPORTED, reader.read(&datum, 1, batch_allocator_));
+}
+
+TEST_F(TestParquetTableRowIter, nulls)
+{
+  const ObParquetColumnDesc int_desc = make_desc(ObParquetColumnDesc::INT64, 1);
+  for (int64_t v2 = 0; v2 < 2; ++v2) {
+    PageOpt opt;
+    opt.is_v2_ = (1 == v2);
+    opt.has_def_ = true;
+    std::string chunk = data_page({0, 1, 1, 0, 0, 1}, plain<int64_t>({1, 2, 3}), 6, opt);
+    check_chunk(int_desc, chunk, 0, {"NULL", "1", "2", "NULL", "NULL", "3"});
+
+    // page of nulls only, then a dictionary encoded page
+    chunk = data_page({0, 0}, "", 2, opt);
+    check_chunk(int_desc, chunk, 0, {"NULL", "NULL"});
+    opt.encoding_ = 8;
+    chunk = dict_page(plain<int64_t>({42}), 1, 0) + data_page({0, 0, 0}, "", 3, opt)
+            + data_page({1, 0}, std::string(1, 1) + rle_levels({0}), 2, opt);
+    check_chunk(int_desc, chunk, 0, {"NULL", "NULL", "NULL", "42", "NULL"});
+  }
+
+  // skip goes over nulls and values
+  PageOpt opt;
+  opt.has_def_ = true;
+  const std::string chunk = data_page({1, 0, 1, 1}, plain<int64_t>({1, 2, 3}), 4, opt);
+  ObParquetColumnReader reader(allocator_);
+  ObParquetChunkMeta meta;
+  ObDatum datum;
+  meta.size_ = chunk.size();
+  reader.set_desc(int_desc);
+  ASSERT_EQ(OB_SUCCESS, reader.open_chunk(meta, chunk.data(), rg_allocator_));
+  ASSERT_EQ(OB_SUCCESS, reader.skip(3));
+  ASSERT_EQ(OB_SUCCESS, reader.read(&datum, 1, batch_allocator_));
+  ASSERT_EQ(0, datum.get_string().compare("3"));
+}
+
+TEST_F(TestParquetTableRowIter, corrupt_pages)
+{
+  const ObParquetColumnDesc int_desc = make_desc(ObParquetColumnDesc::INT64, 1);
+  PageOpt opt;
+  opt.has_def_ = true;
+  const std::string chunk = data_page({1, 0, 1}, plain<int64_t>({1, 2}), 3, opt);
+  ASSERT_EQ(OB_SUCCESS, read_chunk(int_desc, chunk, 3));
+
+  // truncated chunk
+  for (int64_t len = 0; len < static_cast<int64_t>(chunk.size()); ++len) {
+    ASSERT_EQ(OB_INVALID_DATA, read_chunk(int_desc, chunk.substr(0, len), 3)) << len;
+  }
+  // more values than the page has
+  ASSERT_EQ(OB_INVALID_DATA, read_chunk(int_desc, chunk, 4));
+  // page claims more values than its data holds
+  const std::string short_chunk = data_page({1, 1, 1}, plain<int64_t>({1, 2}), 3, opt);
+  ASSERT_EQ(OB_INVALID_DATA, read_chunk(int_desc, short_chunk, 3));
+  // compressed size out of chunk
+  ThriftWriter w;
+  w.i32(1, 0);
+  w.i32(2, 10);
+  w.i32(3, 1000);
+  w.stop();
+  const std::string bad_size = w.str() + plain<int64_t>({1});
+  ASSERT_EQ(OB_INVALID_DATA, read_chunk(int_desc, bad_size, 1));
+
+  // uncompressed size does not match the compressed data
+  const std::string raw = plain<int64_t>({1, 2});
+  const std::string body = compress_page(1, raw);
+  ThriftWriter hw;
+  hw.i32(1, 0);
+  hw.i32(2, raw.size() + 8);
+  hw.i32(3, body.size());
+  hw.begin_struct(5);
+  hw.i32(1, 2);
+  hw.i32(2, 0);
+  hw.end_struct();
+  hw.stop();
+  const std::string compressed = hw.str() + body;
+  ObParquetColumnReader reader(allocator_);
+  ObParquetChunkMeta meta;
+  std::vector<ObDatum> datums(2);
+  meta.codec_ = 1;
+  meta.size_ = compressed.size();
+  reader.set_desc(make_desc(ObParquetColumnDesc::INT64));
+  ASSERT_EQ(OB_SUCCESS, reader.open_chunk(meta, compressed.data(), rg_allocator_));
+  ASSERT_EQ(OB_INVALID_DATA, reader.read(datums.data(), 2, batch_allocator_));
+
+  // uncompressed dictionary page claims more bytes than it has, reaching out of the chunk
+  const std::string dict = plain<int64_t>({7, 8});
+  ThriftWriter dw;
+  dw.i32(1, 2 /* DICTIONARY_PAGE */);
+  dw.i32(2, 4096);
+  dw.i32(3, dict.size());
+  dw.begin_struct(7);
+  dw.i32(1, 512);
+  dw.i32(2, 0);
+  dw.end_struct();
+  dw.stop();
+  PageOpt dict_opt;
+  dict_opt.encoding_ = 8;
+  const std::string bad_dict = dw.str() + dict
+                               + data_page({}, std::string(1, 1) + rle_levels({1}), 1, dict_opt);
+  ASSERT_EQ(OB_INVALID_DATA, read_chunk(make_desc(ObParquetColumnDesc::INT64), bad_dict, 1));
+}
+
+TEST_F(TestParquetTableRowIter, prune_by_stats)
+{
+  const ObParquetColumnDesc int_desc = make_desc(ObParquetColumnDesc::INT32);
+  const ObParquetColumnDesc double_desc = make_desc(ObParquetColumnDesc::DOUBLE);
+  const ObParquetColumnDesc str_desc = make_desc(ObParquetColumnDesc::BYTE_ARRAY);
+  const std::string int_min = le_bytes(10, 4);
+  const std::string int_max = le_bytes(20, 4);
+  ObParquetChunkMeta meta;
+  meta.has_stats_ = true;
+  meta.num_values_ = 100;
+  meta.null_count_ = 0;
+  meta.min_.assign_ptr(int_min.data(), int_min.size());
+  meta.max_.assign_ptr(int_max.data(), int_max.size());
+  int64_t ints[2] = {0, 0};
+  double doubles[2] = {0, 0};
+  ObDatum params[2] = {ObDatum(reinterpret_cast<const char *>(&ints[0]), sizeof(int64_t), false),
+                       ObDatum(reinterpret_cast<const char *>(&ints[1]), sizeof(int64_t), false)};
+  auto set_int = [&](const int64_t a, const int64_t b) {
+    params[0].set_int(a);
+    params[1].set_int(b);
+  };
+  auto skip = [&](const ObParquetColumnDesc &desc, const int64_t op, const int64_t cnt) {
+    return ObParquetTableRowIterator::can_skip_by_stats(desc, meta, op, params, cnt);
+  };
+
+  set_int(5, 0);
+  EXPECT_TRUE(skip(int_desc, WHITE_OP_EQ, 1));
+  EXPECT_TRUE(skip(int_desc, WHITE_OP_LT, 1));
+  EXPECT_TRUE(skip(int_desc, WHITE_OP_LE, 1));
+  EXPECT_FALSE(skip(int_desc, WHITE_OP_GT, 1));
+  EXPECT_FALSE(skip(int_desc, WHITE_OP_GE, 1));
+  set_int(10, 0);
+  EXPECT_FALSE(skip(int_desc, WHITE_OP_EQ, 1));
+  EXPECT_TRUE(skip(int_desc, WHITE_OP_LT, 1));
+  EXPECT_FALSE(skip(int_desc, WHITE_OP_LE, 1));
+  set_int(20, 0);
+  EXPECT_TRUE(skip(int_desc, WHITE_OP_GT, 1));
+  EXPECT_FALSE(skip(int_desc, WHITE_OP_GE, 1));
+  set_int(21, 30);
+  EXPECT_TRUE(skip(int_desc, WHITE_OP_BT, 2));
+  set_int(15, 30);
+  EXPECT_FALSE(skip(int_desc, WHITE_OP_BT, 2));
+  set_int(1, 9);
+  EXPECT_TRUE(skip(int_desc, WHITE_OP_BT, 2));
+  // wrong param count, unsupported op, non numeric column and missing stats keep the row group
+  EXPECT_FALSE(skip(int_desc, WHITE_OP_BT, 1));
+  EXPECT_FALSE(skip(int_desc, WHITE_OP_NE, 1));
+  EXPECT_FALSE(skip(str_desc, WHITE_OP_EQ, 1));
+  meta.has_stats_ = false;
+  EXPECT_FALSE(skip(int_desc, WHITE_OP_LT, 1));
+  meta.has_stats_ = true;
+  // min/max of another width
+  EXPECT_FALSE(skip(make_desc(ObParquetColumnDesc::INT64), WHITE_OP_LT, 1));
+
+  // null count
+  EXPECT_TRUE(skip(int_desc, WHITE_OP_NU, 0));
+  EXPECT_FALSE(skip(int_desc, WHITE_OP_NN, 0));
+  meta.null_count_ = 100;
+  EXPECT_FALSE(skip(int_desc, WHITE_OP_NU, 0));
+  EXPECT_TRUE(skip(int_desc, WHITE_OP_NN, 0));
+  meta.null_count_ = -1;
+  EXPECT_FALSE(skip(int_desc, WHITE_OP_NU, 0));
+  EXPECT_FALSE(skip(int_desc, WHITE_OP_NN, 0));
+
+  // floating point
+  const std::string double_min = le_double(-1.5);
+  const std::string double_max = le_double(2.5);
+  meta.min_.assign_ptr(double_min.data(), double_min.size());
+  meta.max_.assign_ptr(double_max.data(), double_max.size());
+  params[0] = ObDatum(reinterpret_cast<const char *>(&doubles[0]), sizeof(double), false);
+  params[0].set_double(3.0);
+  EXPECT_TRUE(skip(double_desc, WHITE_OP_GE, 1));
+  EXPECT_FALSE(skip(double_desc, WHITE_OP_LE, 1));
+  params[0].set_double(-1.5);
+  EXPECT_TRUE(skip(double_desc, WHITE_OP_LT, 1));
+  EXPECT_FALSE(skip(double_desc, WHITE_OP_EQ, 1));
+  // NaN in statistics never prunes
+  const std::string nan_max = le_double(NAN);
+  meta.max_.assign_ptr(nan_max.data(), nan_max.size());
+  EXPECT_FALSE(skip(double_desc, WHITE_OP_LT, 1));
+}
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_parquet_table_row_iter.log*");
+  OB_LOGGER.set_file_name("test_parquet_table_row_iter.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
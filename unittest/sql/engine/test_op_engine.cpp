@@ -598,7 +598,7 @@ int TestOpEngine::basic_random_test(const std::string &test_file)
   int ret = OB_SUCCESS;
   std::string line;
 
-  while (std::getline(if_tests, line)) {
+  while (OB_SUCC(ret) && std::getline(if_tests, line)) {
     // handle query
     if (line.size() <= 0) continue;
     if (line.at(0) == '#') continue;
@@ -610,7 +610,6 @@ int TestOpEngine::basic_random_test(const std::string &test_file)
       system(("cat /dev/null > " + ObTestOpConfig::get_instance().test_filename_vec_output_file_).c_str());
     }
 
-    ret = OB_SUCCESS;
     ObOperator *original_root = NULL;
     ObOperator *vec_2_root = NULL;
     ObExecutor original_exector;
@@ -691,7 +690,7 @@ int TestOpEngine::basic_random_test(const std::string &test_file)
 
       //if output to file, compare data in file at last
       if (ObTestOpConfig::get_instance().output_result_to_file_) {
-        if (original_root->get_spec().get_type() == PHY_HASH_JOIN && original_root->get_spec().get_type() == PHY_VEC_HASH_JOIN) {
+        if (original_root->get_spec().get_type() == PHY_HASH_JOIN || vec_2_root->get_spec().get_type() == PHY_VEC_HASH_JOIN) {
           system(("sort " + ObTestOpConfig::get_instance().test_filename_origin_output_file_ + " -o "
                   + ObTestOpConfig::get_instance().test_filename_origin_output_file_)
                    .c_str());
@@ -705,7 +704,8 @@ int TestOpEngine::basic_random_test(const std::string &test_file)
         LOG_ERROR("CODE: ", K(WEXITSTATUS(system_ret)));
 
         if (WEXITSTATUS(system_ret) != 0) {
-          LOG_ERROR("Two operator output different!");
+          ret = OB_ERR_UNEXPECTED;
+          LOG_ERROR("Two operator output different!", K(ret));
           // Preserve the site
 
           uint64_t ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
@@ -0,0 +1,242 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#define protected public
+#define private public
+#include "storage/blocksstable/ob_micro_block_cache_warm_up.h"
+#include "storage/blocksstable/ob_data_file_prepare.h"
+#include "share/ob_simple_mem_limit_getter.h"
+#include "lib/checksum/ob_crc64.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace blocksstable;
+
+namespace unittest
+{
+static const char *TEST_DIR = "./test_micro_block_cache_warm_up_dir";
+static ObSimpleMemLimitGetter getter;
+
+class TestMicroBlockCacheWarmUp : public TestDataFilePrepare
+{
+public:
+  typedef ObMicroBlockCacheWarmUpTask Task;
+  TestMicroBlockCacheWarmUp()
+    : TestDataFilePrepare(&getter, "TestMicroBlockCacheWarmUp", 2 * 1024 * 1024, 100)
+  {}
+  virtual void SetUp() override
+  {
+    TestDataFilePrepare::SetUp();
+    system("rm -rf ./test_micro_block_cache_warm_up_dir && mkdir -p ./test_micro_block_cache_warm_up_dir");
+  }
+  virtual void TearDown() override
+  {
+    system("rm -rf ./test_micro_block_cache_warm_up_dir");
+    TestDataFilePrepare::TearDown();
+  }
+  // entries of macro blocks not allocated, %is_index_block for the even ones
+  static void make_entries(const int64_t cnt, ObArray<Task::Entry> &entries)
+  {
+    for (int64_t i = 0; i < cnt; ++i) {
+      Task::Entry entry;
+      MEMSET(&entry, 0, sizeof(entry));
+      entry.tenant_id_ = 1001;
+      entry.first_id_ = 0;
+      entry.second_id_ = 100 + i;
+      entry.third_id_ = 0;
+      entry.offset_ = 4096 * (i + 1);
+      entry.size_ = 4096;
+      entry.hit_cnt_ = cnt - i;
+      entry.is_index_block_ = (0 == i % 2);
+      entry.compressor_type_ = static_cast<uint8_t>(LZ4_COMPRESSOR);
+      entry.row_store_type_ = static_cast<uint8_t>(ENCODING_ROW_STORE);
+      ASSERT_EQ(OB_SUCCESS, entries.push_back(entry));
+    }
+  }
+  static std::string read_file(const char *path)
+  {
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+  }
+  static void write_file(const char *path, const std::string &content)
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(content.data(), content.size());
+  }
+  // rewrite the header of %content with a valid checksum
+  static void rewrite_header(std::string &content, const uint32_t version, const int64_t entry_cnt)
+  {
+    Task::SnapshotHeader *header = reinterpret_cast<Task::SnapshotHeader *>(&content[0]);
+    header->version_ = version;
+    header->entry_cnt_ = entry_cnt;
+    header->checksum_ = ob_crc64(header, offsetof(Task::SnapshotHeader, checksum_));
+  }
+};
+
+TEST_F(TestMicroBlockCacheWarmUp, snapshot_round_trip)
+{
+  Task task;
+  ASSERT_EQ(OB_INVALID_ARGUMENT, task.init(""));
+  ASSERT_EQ(OB_SUCCESS, task.init(TEST_DIR));
+  ASSERT_EQ(OB_INIT_TWICE, task.init(TEST_DIR));
+
+  // no snapshot file is not an error
+  ASSERT_EQ(OB_SUCCESS, task.load_snapshot());
+  ASSERT_EQ(0, task.restore_entries_.count());
+
+  ObArray<Task::Entry> entries;
+  make_entries(100, entries);
+  ASSERT_EQ(OB_SUCCESS, task.write_snapshot(entries));
+  ASSERT_EQ(OB_SUCCESS, task.load_snapshot());
+  ASSERT_EQ(entries.count(), task.restore_entries_.count());
+  for (int64_t i = 0; i < entries.count(); ++i) {
+    ASSERT_EQ(0, MEMCMP(&entries.at(i), &task.restore_entries_.at(i), sizeof(Task::Entry)));
+  }
+
+  // an empty snapshot replaces the old one
+  entries.reset();
+  ASSERT_EQ(OB_SUCCESS, task.write_snapshot(entries));
+  ASSERT_EQ(OB_SUCCESS, task.load_snapshot());
+  ASSERT_EQ(0, task.restore_entries_.count());
+
+  // hot entries are kept when shrinking, index blocks first
+  make_entries(Task::MAX_ENTRY_CNT + 10, entries);
+  task.shrink_entries(entries);
+  ASSERT_EQ(Task::MAX_ENTRY_CNT, entries.count());
+  std::sort(&entries.at(0), &entries.at(0) + entries.count(), Task::EntryCompare());
+  ASSERT_TRUE(entries.at(0).is_index_block_);
+  ASSERT_FALSE(entries.at(entries.count() - 1).is_index_block_);
+  for (int64_t i = 1; i < entries.count(); ++i) {
+    if (entries.at(i).is_index_block_ == entries.at(i - 1).is_index_block_) {
+      ASSERT_LE(entries.at(i).hit_cnt_, entries.at(i - 1).hit_cnt_);
+    }
+  }
+}
+
+TEST_F(TestMicroBlockCacheWarmUp, reject_broken_snapshot)
+{
+  Task task;
+  ASSERT_EQ(OB_SUCCESS, task.init(TEST_DIR));
+  ObArray<Task::Entry> entries;
+  make_entries(10, entries);
+  ASSERT_EQ(OB_SUCCESS, task.write_snapshot(entries));
+  const std::string content = read_file(task.snapshot_path_);
+  const int64_t header_size = sizeof(Task::SnapshotHeader);
+  ASSERT_EQ(header_size + 10 * static_cast<int64_t>(sizeof(Task::Entry)),
+            static_cast<int64_t>(content.size()));
+
+  // truncated in header or entries
+  for (const int64_t len : {int64_t(0), header_size / 2, header_size + 1,
+                            static_cast<int64_t>(content.size()) - 1}) {
+    write_file(task.snapshot_path_, content.substr(0, len));
+    ASSERT_EQ(OB_INVALID_DATA, task.load_snapshot()) << len;
+    ASSERT_EQ(0, task.restore_entries_.count());
+  }
+
+  // corrupt entry
+  std::string broken = content;
+  broken[header_size + 3] = static_cast<char>(broken[header_size + 3] ^ 0xff);
+  write_file(task.snapshot_path_, broken);
+  ASSERT_EQ(OB_CHECKSUM_ERROR, task.load_snapshot());
+  ASSERT_EQ(0, task.restore_entries_.count());
+
+  // corrupt header
+  broken = content;
+  broken[offsetof(Task::SnapshotHeader, entry_cnt_)] ^= 0x01;
+  write_file(task.snapshot_path_, broken);
+  ASSERT_EQ(OB_INVALID_DATA, task.load_snapshot());
+
+  // bad magic
+  broken = content;
+  reinterpret_cast<Task::SnapshotHeader *>(&broken[0])->magic_ = 0;
+  rewrite_header(broken, Task::SNAPSHOT_VERSION, 10);
+  write_file(task.snapshot_path_, broken);
+  ASSERT_EQ(OB_INVALID_DATA, task.load_snapshot());
+
+  // version mismatch
+  broken = content;
+  rewrite_header(broken, Task::SNAPSHOT_VERSION + 1, 10);
+  write_file(task.snapshot_path_, broken);
+  ASSERT_EQ(OB_INVALID_DATA, task.load_snapshot());
+
+  // too many entries
+  broken = content;
+  rewrite_header(broken, Task::SNAPSHOT_VERSION, Task::MAX_ENTRY_CNT + 1);
+  write_file(task.snapshot_path_, broken);
+  ASSERT_EQ(OB_INVALID_DATA, task.load_snapshot());
+
+  // entry count larger than the file holds
+  broken = content;
+  rewrite_header(broken, Task::SNAPSHOT_VERSION, 11);
+  write_file(task.snapshot_path_, broken);
+  ASSERT_EQ(OB_INVALID_DATA, task.load_snapshot());
+  ASSERT_EQ(0, task.restore_entries_.count());
+
+  // the original one is still fine
+  write_file(task.snapshot_path_, content);
+  ASSERT_EQ(OB_SUCCESS, task.load_snapshot());
+  ASSERT_EQ(10, task.restore_entries_.count());
+}
+
+TEST_F(TestMicroBlockCacheWarmUp, restore_skip_freed_blocks)
+{
+  Task task;
+  ASSERT_EQ(OB_SUCCESS, task.init(TEST_DIR));
+  ObArray<Task::Entry> entries;
+  make_entries(2 * Task::MAX_BATCH_CNT + 3, entries);
+  // an entry of invalid macro id is skipped as well
+  entries.at(1).second_id_ = INT64_MAX;
+
+  // the macro blocks are not in use, nothing is read
+  ObMacroBlockHandle macro_handle;
+  bool is_submitted = true;
+  ASSERT_EQ(OB_SUCCESS, task.prefetch_entry(entries.at(0), macro_handle, is_submitted));
+  ASSERT_FALSE(is_submitted);
+  ASSERT_EQ(OB_INVALID_ARGUMENT, task.prefetch_entry(entries.at(1), macro_handle, is_submitted));
+  ASSERT_FALSE(is_submitted);
+
+  // restore goes through all entries in one round as no io is issued
+  ASSERT_EQ(OB_SUCCESS, task.write_snapshot(entries));
+  ASSERT_FALSE(task.is_restored_);
+  ASSERT_EQ(OB_SUCCESS, task.restore());
+  ASSERT_TRUE(task.is_loaded_);
+  ASSERT_TRUE(task.is_restored_);
+  ASSERT_EQ(0, task.restore_cnt_);
+  ASSERT_EQ(0, task.restore_pos_);
+  ASSERT_EQ(0, task.restore_entries_.count());
+
+  // broken snapshot is given up without restoring anything
+  Task broken_task;
+  ASSERT_EQ(OB_SUCCESS, broken_task.init(TEST_DIR));
+  write_file(broken_task.snapshot_path_, "broken");
+  ASSERT_EQ(OB_INVALID_DATA, broken_task.restore());
+  ASSERT_EQ(0, broken_task.restore_entries_.count());
+  ASSERT_EQ(0, broken_task.restore_cnt_);
+}
+}
+}
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_micro_block_cache_warm_up.log*");
+  OB_LOGGER.set_file_name("test_micro_block_cache_warm_up.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,319 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define protected public
+#define private public
+#include "storage/blocksstable/ob_micro_block_disk_cache.h"
+#include "storage/blocksstable/ob_micro_block_cache.h"
+#include "storage/blocksstable/ob_micro_block_header.h"
+#include "storage/blocksstable/ob_macro_block_reader.h"
+#include "lib/checksum/ob_crc64.h"
+#include "storage/blocksstable/ob_data_file_prepare.h"
+#include "share/ob_simple_mem_limit_getter.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace blocksstable;
+
+namespace unittest
+{
+static const char *TEST_DIR = "./test_micro_block_disk_cache_dir";
+static const int64_t BLOCK_SIZE = 64L << 10;
+static ObSimpleMemLimitGetter getter;
+
+class TestMicroBlockDiskCache : public TestDataFilePrepare
+{
+public:
+  TestMicroBlockDiskCache()
+    : TestDataFilePrepare(&getter, "TestMicroBlockDiskCache", 2 * 1024 * 1024, 100),
+      allocator_()
+  {}
+  virtual void SetUp() override
+  {
+    TestDataFilePrepare::SetUp();
+    system("rm -rf ./test_micro_block_disk_cache_dir");
+    MEMSET(buf_, 0, sizeof(buf_));
+  }
+  virtual void TearDown() override
+  {
+    system("rm -rf ./test_micro_block_disk_cache_dir");
+    TestDataFilePrepare::TearDown();
+  }
+  static int64_t get_cnt_per_segment()
+  {
+    const int64_t record_size = upper_align(sizeof(ObMicroBlockDiskCache::RecordHeader) + BLOCK_SIZE,
+                                            ObMicroBlockDiskCache::RECORD_ALIGN_SIZE);
+    return (ObMicroBlockDiskCache::SEGMENT_SIZE - sizeof(ObMicroBlockDiskCache::SegmentHeader)) / record_size;
+  }
+  static void wait_flushed(ObMicroBlockDiskCache &cache)
+  {
+    while (ATOMIC_LOAD(&cache.flush_idx_) < ATOMIC_LOAD(&cache.write_idx_)) {
+      ob_usleep(1000);
+    }
+  }
+  static ObMicroBlockCacheKey make_key(const int64_t i)
+  {
+    return ObMicroBlockCacheKey(1, MacroBlockId(0, 100 + i, 0), 0, BLOCK_SIZE);
+  }
+  static ObMicroBlockDesMeta make_des_meta()
+  {
+    return ObMicroBlockDesMeta(ObCompressorType::LZ4_COMPRESSOR, ENCODING_ROW_STORE, 0, 0, nullptr);
+  }
+  int append(ObMicroBlockDiskCache &cache, const int64_t i)
+  {
+    MEMSET(buf_, static_cast<char>(i), BLOCK_SIZE);
+    return cache.append(make_key(i), make_des_meta(), buf_, BLOCK_SIZE);
+  }
+  int check_get(ObMicroBlockDiskCache &cache, const int64_t i)
+  {
+    int ret = OB_SUCCESS;
+    ObMicroBlockDesMeta des_meta;
+    const char *buf = nullptr;
+    int64_t size = 0;
+    if (OB_SUCC(cache.get(make_key(i), allocator_, des_meta, buf, size))) {
+      EXPECT_EQ(ENCODING_ROW_STORE, des_meta.row_store_type_);
+      EXPECT_EQ(ObCompressorType::LZ4_COMPRESSOR, des_meta.compressor_type_);
+      EXPECT_FALSE(des_meta.is_encrypted());
+      EXPECT_EQ(BLOCK_SIZE, size);
+      EXPECT_EQ(static_cast<char>(i), buf[0]);
+      EXPECT_EQ(static_cast<char>(i), buf[size - 1]);
+    }
+    return ret;
+  }
+  // micro block as read from the macro block, flat and not compressed
+  static int64_t make_raw_block(const int64_t i, char *buf)
+  {
+    ObMicroBlockHeader header;
+    header.header_size_ = ObMicroBlockHeader::get_serialize_size(1, false);
+    header.column_count_ = 1;
+    header.rowkey_column_count_ = 1;
+    header.row_count_ = 1;
+    header.row_store_type_ = FLAT_ROW_STORE;
+    const int64_t payload_size = BLOCK_SIZE / 2;
+    char *payload = buf + header.header_size_;
+    MEMSET(payload, static_cast<char>(i), payload_size);
+    header.data_length_ = payload_size;
+    header.data_zlength_ = payload_size;
+    header.original_length_ = payload_size;
+    header.data_checksum_ = ob_crc64_sse42(0, payload, payload_size);
+    header.set_header_checksum();
+    int64_t pos = 0;
+    EXPECT_EQ(OB_SUCCESS, header.serialize(buf, header.header_size_, pos));
+    return header.header_size_ + payload_size;
+  }
+protected:
+  ObArenaAllocator allocator_;
+  char buf_[BLOCK_SIZE];
+};
+
+TEST_F(TestMicroBlockDiskCache, append_and_get)
+{
+  ObMicroBlockDiskCache cache;
+  const int64_t segment_size = ObMicroBlockDiskCache::SEGMENT_SIZE;
+  ASSERT_EQ(OB_INVALID_ARGUMENT, cache.init(TEST_DIR, segment_size));
+  ASSERT_EQ(OB_SUCCESS, cache.init(TEST_DIR, 4 * segment_size));
+  ASSERT_EQ(OB_INIT_TWICE, cache.init(TEST_DIR, 4 * segment_size));
+
+  // blocks are visible after the write buffer is flushed
+  const int64_t cnt_per_segment = get_cnt_per_segment();
+  ASSERT_EQ(OB_SUCCESS, append(cache, 0));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, check_get(cache, 0));
+  int64_t cnt = 1;
+  for (; cnt <= cnt_per_segment; ++cnt) {
+    ASSERT_EQ(OB_SUCCESS, append(cache, cnt));
+  }
+  wait_flushed(cache);
+  ASSERT_EQ(cnt_per_segment, cache.location_map_.size());
+  for (int64_t i = 0; i < cnt_per_segment; ++i) {
+    ASSERT_EQ(OB_SUCCESS, check_get(cache, i));
+  }
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, check_get(cache, cnt_per_segment));
+
+  // the oldest segment is reused after all segments are written
+  for (int64_t i = 0; i < 4 * cnt_per_segment; ++i) {
+    ASSERT_EQ(OB_SUCCESS, append(cache, cnt++));
+    if (0 == cnt % cnt_per_segment) {
+      wait_flushed(cache);
+    }
+  }
+  wait_flushed(cache);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, check_get(cache, 0));
+  ASSERT_EQ(OB_SUCCESS, check_get(cache, 3 * cnt_per_segment));
+  cache.destroy();
+}
+
+TEST_F(TestMicroBlockDiskCache, append_while_flushing)
+{
+  ObMicroBlockDiskCache cache;
+  const int64_t segment_size = ObMicroBlockDiskCache::SEGMENT_SIZE;
+  const int64_t cnt_per_segment = get_cnt_per_segment();
+  ASSERT_EQ(OB_SUCCESS, cache.init(TEST_DIR, 4 * segment_size));
+  // hold the flusher so that the first full buffer stays pending
+  cache.lib::ThreadPool::stop();
+  cache.lib::ThreadPool::wait();
+
+  // appends go on into the second buffer while the first one is not flushed
+  int64_t cnt = 0;
+  for (; cnt < 2 * cnt_per_segment; ++cnt) {
+    ASSERT_EQ(OB_SUCCESS, append(cache, cnt));
+  }
+  ASSERT_EQ(1, cache.write_idx_);
+  ASSERT_EQ(0, cache.flush_idx_);
+
+  // blocks are dropped only if both buffers are full
+  ASSERT_EQ(OB_EAGAIN, append(cache, cnt));
+  ASSERT_EQ(1, cache.drop_cnt_);
+
+  // flush the pending buffer as the flusher does, then appends succeed again
+  ObMicroBlockDiskCache::WriteBuffer &buffer = cache.buffers_[0];
+  cache.flush(buffer, buffer.data_size_);
+  ATOMIC_INC(&cache.flush_idx_);
+  ASSERT_EQ(OB_SUCCESS, append(cache, cnt));
+  ASSERT_EQ(2, cache.write_idx_);
+  ASSERT_EQ(OB_SUCCESS, check_get(cache, 0));
+  ASSERT_EQ(OB_SUCCESS, check_get(cache, cnt_per_segment - 1));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, check_get(cache, cnt_per_segment));
+  cache.destroy();
+}
+
+TEST_F(TestMicroBlockDiskCache, segment_rewritten)
+{
+  ObMicroBlockDiskCache cache;
+  const int64_t cnt_per_segment = get_cnt_per_segment();
+  ASSERT_EQ(OB_SUCCESS, cache.init(TEST_DIR, 4 * ObMicroBlockDiskCache::SEGMENT_SIZE));
+  for (int64_t i = 0; i <= cnt_per_segment; ++i) {
+    ASSERT_EQ(OB_SUCCESS, append(cache, i));
+  }
+  wait_flushed(cache);
+  ObMicroBlockDiskCache::RecordKey record_key;
+  ObMicroBlockDiskCache::Location location;
+  ObMicroBlockDiskCache::make_record_key(make_key(0), record_key);
+  const uint64_t fingerprint = ObMicroBlockDiskCache::get_fingerprint(record_key);
+  ASSERT_EQ(OB_SUCCESS, cache.location_map_.get_refactored(fingerprint, location));
+  const int64_t seq = location.seq_;
+
+  // blocks are not returned while their segment is being rewritten, and the index is dropped
+  ATOMIC_STORE(&cache.segment_seqs_[location.segment_], 0);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, check_get(cache, 0));
+  ASSERT_EQ(OB_HASH_NOT_EXIST, cache.location_map_.get_refactored(fingerprint, location));
+
+  // nor after the segment is rewritten with newer blocks
+  ATOMIC_STORE(&cache.segment_seqs_[location.segment_], seq + 1);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, check_get(cache, 1));
+  ATOMIC_STORE(&cache.segment_seqs_[location.segment_], seq);
+  ASSERT_EQ(OB_SUCCESS, check_get(cache, 2));
+  cache.destroy();
+}
+
+TEST_F(TestMicroBlockDiskCache, load_into_memory_cache)
+{
+  ObMicroBlockDiskCache disk_cache;
+  ObDataMicroBlockCache cache;
+  ObMacroBlockReader reader;
+  ASSERT_EQ(OB_SUCCESS, disk_cache.init(TEST_DIR, 4 * ObMicroBlockDiskCache::SEGMENT_SIZE));
+  ASSERT_EQ(OB_SUCCESS, cache.init("test_micro_disk_cache", 1));
+  cache.set_disk_cache(&disk_cache);
+
+  // encrypted blocks are never written to the cache file
+  ObMicroBlockDesMeta des_meta(ObCompressorType::NONE_COMPRESSOR, FLAT_ROW_STORE, 0, 0, nullptr);
+  ObMicroBlockDesMeta encrypted_des_meta = des_meta;
+  encrypted_des_meta.encrypt_id_ = share::ObCipherOpMode::ob_aes_128_ecb;
+  ASSERT_EQ(OB_NOT_SUPPORTED, disk_cache.append(make_key(0), encrypted_des_meta, buf_, BLOCK_SIZE));
+
+  const uint64_t tenant_id = 1;
+  const MacroBlockId macro_id(0, 1000, 0);
+  const MacroBlockId encrypted_macro_id(0, 1001, 0);
+  char raw_buf[BLOCK_SIZE];
+  const int64_t size = make_raw_block(7, raw_buf);
+  const ObMicroBlockCacheKey key(tenant_id, macro_id, 0, size);
+  const ObMicroBlockCacheKey encrypted_key(tenant_id, encrypted_macro_id, 0, size);
+  const ObMicroBlockCacheValue *micro_block = nullptr;
+  ObKVCacheHandle handle;
+  ASSERT_EQ(OB_SUCCESS, cache.put_cache_block(des_meta, raw_buf, key, reader, allocator_, micro_block, handle));
+  handle.reset();
+#ifndef OB_BUILD_TDE_SECURITY
+  // not decrypted by this build, but still kept off the cache file
+  ASSERT_EQ(OB_SUCCESS, cache.put_cache_block(
+      encrypted_des_meta, raw_buf, encrypted_key, reader, allocator_, micro_block, handle));
+  handle.reset();
+#endif
+
+  // fill the write buffer so that the blocks are flushed
+  for (int64_t i = 0; i < get_cnt_per_segment(); ++i) {
+    ASSERT_EQ(OB_SUCCESS, append(disk_cache, i));
+  }
+  wait_flushed(disk_cache);
+
+  // blocks missed in memory are loaded from the disk cache with their des meta
+  ObMicroBlockBufferHandle buf_handle;
+  ASSERT_EQ(OB_SUCCESS, cache.erase(key));
+  ASSERT_EQ(OB_SUCCESS, cache.get_cache_block(tenant_id, macro_id, 0, size, buf_handle));
+  ASSERT_EQ(1, disk_cache.hit_cnt_);
+  ASSERT_TRUE(buf_handle.is_valid());
+  const ObMicroBlockData *block_data = buf_handle.get_block_data();
+  ASSERT_EQ(size, block_data->get_buf_size());
+  ASSERT_EQ(0, MEMCMP(raw_buf + size - BLOCK_SIZE / 2, block_data->get_buf() + size - BLOCK_SIZE / 2, BLOCK_SIZE / 2));
+  ObMicroBlockDesMeta loaded_des_meta;
+  ASSERT_TRUE(buf_handle.micro_block_->get_des_meta(loaded_des_meta));
+  ASSERT_EQ(ObCompressorType::NONE_COMPRESSOR, loaded_des_meta.compressor_type_);
+  ASSERT_EQ(FLAT_ROW_STORE, loaded_des_meta.row_store_type_);
+  buf_handle.reset();
+
+  // then hit in memory
+  ASSERT_EQ(OB_SUCCESS, cache.get_cache_block(tenant_id, macro_id, 0, size, buf_handle));
+  ASSERT_EQ(1, disk_cache.hit_cnt_);
+  buf_handle.reset();
+
+#ifndef OB_BUILD_TDE_SECURITY
+  ASSERT_EQ(OB_SUCCESS, cache.erase(encrypted_key));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get_cache_block(tenant_id, encrypted_macro_id, 0, size, buf_handle));
+#endif
+  cache.destroy();
+  disk_cache.destroy();
+}
+
+TEST_F(TestMicroBlockDiskCache, reopen)
+{
+  ObMicroBlockDiskCache cache;
+  const int64_t segment_size = ObMicroBlockDiskCache::SEGMENT_SIZE;
+  ASSERT_EQ(OB_SUCCESS, cache.init(TEST_DIR, 4 * segment_size));
+  for (int64_t i = 0; i < 10; ++i) {
+    ASSERT_EQ(OB_SUCCESS, append(cache, i));
+  }
+  cache.destroy();
+
+  // blocks written before are indexed again, but not returned before the
+  // macro blocks are known to be still in use
+  ASSERT_EQ(OB_SUCCESS, cache.init(TEST_DIR, 4 * segment_size));
+  ASSERT_EQ(10, cache.location_map_.size());
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, check_get(cache, 0));
+  ASSERT_EQ(9, cache.location_map_.size());
+  cache.destroy();
+
+  // file of another size is truncated
+  ASSERT_EQ(OB_SUCCESS, cache.init(TEST_DIR, 3 * segment_size));
+  ASSERT_EQ(0, cache.location_map_.size());
+  cache.destroy();
+}
+}
+}
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_micro_block_disk_cache.log*");
+  OB_LOGGER.set_file_name("test_micro_block_disk_cache.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
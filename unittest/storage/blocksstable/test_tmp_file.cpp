@@ -2255,6 +2255,87 @@ TEST_F(TestTmpFile, test_truncate_free_block) {
 
 }
 
+TEST_F(TestTmpFile, test_compress_block)
+{
+  int ret = OB_SUCCESS;
+  int64_t dir = -1;
+  int64_t fd = -1;
+  ObTmpFileIOInfo io_info;
+  ret = ObTmpFileManager::get_instance().alloc_dir(dir);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ret = ObTmpFileManager::get_instance().open(fd, dir);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  const int64_t write_size = 16 * 1024;
+  char *write_buf = (char *)malloc(write_size);
+  for (int64_t i = 0; i < write_size; ++i) {
+    write_buf[i] = static_cast<char>((i / 64) % 16);
+  }
+  io_info.fd_ = fd;
+  io_info.tenant_id_ = 1;
+  io_info.io_desc_.set_group_id(THIS_WORKER.get_group_id());
+  io_info.io_desc_.set_wait_event(2);
+  io_info.buf_ = write_buf;
+  io_info.size_ = write_size;
+  io_info.io_timeout_ms_ = DEFAULT_IO_WAIT_TIME_MS;
+  ret = ObTmpFileManager::get_instance().write(io_info);
+  ASSERT_EQ(OB_SUCCESS, ret);
+
+  ObTmpTenantFileStoreHandle store_handle;
+  OB_TMP_FILE_STORE.get_store(1, store_handle);
+  ObTmpTenantMemBlockManager &mem_block_mgr = store_handle.get_tenant_store()->tmp_mem_block_manager_;
+  ASSERT_EQ(1, mem_block_mgr.t_mblk_map_.size());
+  ObTmpMacroBlock *block = mem_block_mgr.t_mblk_map_.begin()->second;
+  ASSERT_TRUE(nullptr != block);
+  // fill the unused pages of block too
+  char *block_buf = block->get_buffer();
+  for (int64_t i = 0; i < ObTmpFileStore::get_block_size(); ++i) {
+    block_buf[i] = static_cast<char>((i / 64) % 16);
+  }
+  ObTmpBlockIOInfo info;
+  char *compress_buf = nullptr;
+  ASSERT_EQ(OB_SUCCESS, block->get_wash_io_info(info));
+
+  // no compression
+  ASSERT_EQ(OB_SUCCESS, mem_block_mgr.compress_block(NONE_COMPRESSOR, *block, info, compress_buf));
+  ASSERT_TRUE(nullptr == compress_buf);
+  ASSERT_FALSE(block->get_compress_info().is_compressed());
+  ASSERT_EQ(ObTmpFileStore::get_block_size(), info.size_);
+
+  ASSERT_EQ(OB_SUCCESS, mem_block_mgr.compress_block(LZ4_COMPRESSOR, *block, info, compress_buf));
+  ASSERT_TRUE(nullptr != compress_buf);
+  const ObTmpBlockCompressInfo &compress_info = block->get_compress_info();
+  ASSERT_TRUE(compress_info.is_compressed());
+  ASSERT_LT(info.size_, ObTmpFileStore::get_block_size() / 2);
+  ASSERT_EQ(0, info.size_ % DIO_ALIGN_SIZE);
+  ASSERT_TRUE(compress_info.is_chunk_compressed(0));
+
+  // decompress the first chunk and put its pages into page cache
+  ObArenaAllocator allocator;
+  ObTmpPageCache &page_cache = ObTmpPageCache::get_instance();
+  ObTmpPageCache::ObTmpCompressedPageIOCallback callback;
+  callback.cache_ = &page_cache;
+  callback.allocator_ = &allocator;
+  callback.block_id_ = block->get_block_id();
+  callback.tenant_id_ = 1;
+  callback.start_chunk_idx_ = 0;
+  callback.end_chunk_idx_ = 0;
+  callback.compress_info_ = compress_info;
+  ret = callback.inner_process(compress_buf, compress_info.get_chunk_data_size(0));
+  ASSERT_EQ(OB_SUCCESS, ret);
+  const int64_t page_size = ObTmpMacroBlock::get_default_page_size();
+  for (int64_t i = 0; i < ObTmpBlockCompressInfo::CHUNK_PAGE_NUMS; ++i) {
+    ObTmpPageCacheKey key(block->get_block_id(), i, 1);
+    ObTmpPageValueHandle p_handle;
+    ASSERT_EQ(OB_SUCCESS, page_cache.get_page(key, p_handle));
+    ASSERT_EQ(0, memcmp(p_handle.value_->get_buffer(), block_buf + i * page_size, page_size));
+  }
+  mem_block_mgr.allocator_->free(compress_buf);
+  block->get_compress_info().reset();
+  free(write_buf);
+
+  ObTmpFileManager::get_instance().remove(fd);
+}
+
 
 }  // end namespace unittest
 }  // end namespace oceanbase
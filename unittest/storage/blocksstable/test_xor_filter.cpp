@@ -0,0 +1,192 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define protected public
+#define private public
+#include "storage/blocksstable/ob_xor_filter.h"
+#include "storage/blocksstable/ob_bloom_filter_cache.h"
+#include "lib/hash_func/murmur_hash.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace blocksstable;
+
+namespace unittest
+{
+class TestXorFilter : public ::testing::Test
+{
+public:
+  TestXorFilter() : allocator_(), next_key_(0) {}
+  void SetUp() {}
+  void TearDown() { allocator_.reset(); }
+  uint64_t *gen_hashes(const int64_t count)
+  {
+    uint64_t *hashes = static_cast<uint64_t *>(allocator_.alloc(sizeof(uint64_t) * count));
+    for (int64_t i = 0; i < count; ++i) {
+      const int64_t key = next_key_++;
+      hashes[i] = murmurhash(&key, sizeof(key), 0);
+    }
+    return hashes;
+  }
+protected:
+  ObArenaAllocator allocator_;
+  int64_t next_key_;
+};
+
+TEST_F(TestXorFilter, build_and_probe)
+{
+  const int64_t counts[] = {1, 2, 10, 1000, 100000};
+  for (int64_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c) {
+    const int64_t count = counts[c];
+    uint64_t *hashes = gen_hashes(count);
+    uint64_t *build_hashes = static_cast<uint64_t *>(allocator_.alloc(sizeof(uint64_t) * count * 2));
+    // duplicated hashes are allowed
+    MEMCPY(build_hashes, hashes, sizeof(uint64_t) * count);
+    MEMCPY(build_hashes + count, hashes, sizeof(uint64_t) * count);
+    ObXorFilter filter;
+    ASSERT_EQ(OB_SUCCESS, filter.init(build_hashes, count * 2));
+    ASSERT_EQ(OB_INIT_TWICE, filter.init(build_hashes, count * 2));
+    for (int64_t i = 0; i < count; ++i) {
+      ASSERT_TRUE(filter.may_contain(hashes[i]));
+    }
+
+    // false positive rate is about 1/256
+    const int64_t probe_cnt = 100000;
+    uint64_t *probe_hashes = gen_hashes(probe_cnt);
+    bool *is_contain = static_cast<bool *>(allocator_.alloc(probe_cnt));
+    filter.may_contain(probe_hashes, probe_cnt, is_contain);
+    int64_t pass_cnt = 0;
+    for (int64_t i = 0; i < probe_cnt; ++i) {
+      ASSERT_EQ(filter.may_contain(probe_hashes[i]), is_contain[i]);
+      pass_cnt += is_contain[i] ? 1 : 0;
+    }
+    ASSERT_LT(pass_cnt, probe_cnt / 100);
+    if (count >= 1000) {
+      ASSERT_LT(filter.get_deep_copy_size() * 8, count * 12);
+    }
+  }
+}
+
+TEST_F(TestXorFilter, serialize)
+{
+  const int64_t count = 5000;
+  uint64_t *hashes = gen_hashes(count);
+  ObXorFilter filter;
+  ASSERT_EQ(OB_SUCCESS, filter.init(hashes, count));
+  const int64_t buf_len = filter.get_serialize_size();
+  char *buf = static_cast<char *>(allocator_.alloc(buf_len));
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, filter.serialize(buf, buf_len, pos));
+  ASSERT_EQ(buf_len, pos);
+
+  ObXorFilter other;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, other.deserialize(buf, buf_len, pos));
+  ASSERT_EQ(filter.array_length_, other.array_length_);
+  ASSERT_EQ(0, MEMCMP(filter.fingerprints_, other.fingerprints_, filter.array_length_));
+  for (int64_t i = 0; i < count; ++i) {
+    ASSERT_TRUE(other.may_contain(hashes[i]));
+  }
+}
+
+TEST_F(TestXorFilter, cache_value)
+{
+  const int64_t count = 5000;
+  uint64_t *hashes = gen_hashes(count);
+  uint64_t *build_hashes = static_cast<uint64_t *>(allocator_.alloc(sizeof(uint64_t) * count));
+  MEMCPY(build_hashes, hashes, sizeof(uint64_t) * count);
+  ObBloomFilterCacheValue value;
+  ASSERT_EQ(OB_SUCCESS, value.init_with_xor_filter(2, build_hashes, count));
+  ASSERT_TRUE(value.is_xor_filter());
+  ASSERT_EQ(OB_NOT_SUPPORTED, value.insert(1));
+
+  // deep copy to kvcache buffer
+  char *buf = static_cast<char *>(allocator_.alloc(value.size()));
+  ObIKVCacheValue *copy = nullptr;
+  ASSERT_EQ(OB_SUCCESS, value.deep_copy(buf, value.size(), copy));
+  const ObBloomFilterCacheValue *copy_value = static_cast<ObBloomFilterCacheValue *>(copy);
+  bool *is_contain = static_cast<bool *>(allocator_.alloc(count));
+  ASSERT_EQ(OB_SUCCESS, copy_value->may_contain(hashes, count, is_contain));
+  for (int64_t i = 0; i < count; ++i) {
+    ASSERT_TRUE(is_contain[i]);
+  }
+
+  // serialize with version of xor filter
+  const int64_t buf_len = value.get_serialize_size();
+  char *ser_buf = static_cast<char *>(allocator_.alloc(buf_len));
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, value.serialize(ser_buf, buf_len, pos));
+  ObBloomFilterCacheValue other;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, other.deserialize(ser_buf, buf_len, pos));
+  ASSERT_TRUE(other.is_xor_filter());
+  bool contain = false;
+  ASSERT_EQ(OB_SUCCESS, other.may_contain(hashes[0], contain));
+  ASSERT_TRUE(contain);
+  copy_value->~ObBloomFilterCacheValue();
+}
+
+TEST_F(TestXorFilter, cache_value_version)
+{
+  // the leading version tells the filter kind, not the unis version
+  const int64_t bf_version = ObBloomFilterCacheValue::BLOOM_FILTER_CACHE_VALUE_VERSION;
+  const int64_t xor_version = ObBloomFilterCacheValue::XOR_FILTER_CACHE_VALUE_VERSION;
+  const int64_t count = 100;
+  uint64_t *hashes = gen_hashes(count);
+  ObBloomFilterCacheValue bf_value;
+  ObBloomFilterCacheValue xor_value;
+  ASSERT_EQ(OB_SUCCESS, bf_value.init(2, count));
+  for (int64_t i = 0; i < count; ++i) {
+    ASSERT_EQ(OB_SUCCESS, bf_value.insert(static_cast<uint32_t>(hashes[i])));
+  }
+  ASSERT_EQ(OB_SUCCESS, xor_value.init_with_xor_filter(2, gen_hashes(count), count));
+  const ObBloomFilterCacheValue *values[] = {&bf_value, &xor_value};
+  const int64_t versions[] = {bf_version, xor_version};
+  for (int64_t i = 0; i < 2; ++i) {
+    const int64_t buf_len = values[i]->get_serialize_size();
+    char *buf = static_cast<char *>(allocator_.alloc(buf_len));
+    int64_t pos = 0;
+    ASSERT_EQ(OB_SUCCESS, values[i]->serialize(buf, buf_len, pos));
+    ASSERT_EQ(buf_len, pos);
+    int16_t version = 0;
+    pos = 0;
+    ASSERT_EQ(OB_SUCCESS, serialization::decode_i16(buf, buf_len, pos, &version));
+    ASSERT_EQ(versions[i], version);
+
+    ObBloomFilterCacheValue other;
+    pos = 0;
+    ASSERT_EQ(OB_SUCCESS, other.deserialize(buf, buf_len, pos));
+    ASSERT_EQ(buf_len, pos);
+    ASSERT_EQ(values[i]->is_xor_filter(), other.is_xor_filter());
+    ASSERT_EQ(values[i]->get_row_count(), other.get_row_count());
+
+    // a version not known is not taken as a bloom filter
+    pos = 0;
+    ASSERT_EQ(OB_SUCCESS, serialization::encode_i16(buf, buf_len, pos, static_cast<int16_t>(xor_version + 1)));
+    pos = 0;
+    ASSERT_EQ(OB_NOT_SUPPORTED, other.deserialize(buf, buf_len, pos));
+    ASSERT_FALSE(other.is_valid());
+  }
+}
+}
+}
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_xor_filter.log*");
+  OB_LOGGER.set_file_name("test_xor_filter.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -260,6 +260,33 @@ TEST_F(TestTxCallbackList, remove_callback_on_failure)
   EXPECT_EQ(2, callback_list_.get_length());
 }
 
+TEST_F(TestTxCallbackList, append_callbacks)
+{
+  ObMemtable *memtable = create_memtable();
+  auto cb0 = create_and_append_callback(memtable);
+
+  ObITransCallback *cbs[3];
+  for (int64_t i = 0; i < 3; i++) {
+    cbs[i] = create_callback(memtable);
+  }
+  int64_t appended_cnt = 0;
+  EXPECT_EQ(OB_SUCCESS, callback_list_.append_callbacks(cbs, 3, appended_cnt));
+  EXPECT_EQ(3, appended_cnt);
+  EXPECT_EQ(4, callback_list_.get_length());
+  EXPECT_EQ(cb0, cbs[0]->get_prev());
+  EXPECT_EQ(cbs[1], cbs[0]->get_next());
+  EXPECT_EQ(cbs[2], cbs[1]->get_next());
+  EXPECT_EQ(cbs[2], callback_list_.get_tail());
+
+  // stop at the first invalid callback
+  ObITransCallback *cbs2[3] = {create_callback(memtable), nullptr, create_callback(memtable)};
+  EXPECT_EQ(OB_ERR_UNEXPECTED, callback_list_.append_callbacks(cbs2, 3, appended_cnt));
+  EXPECT_EQ(1, appended_cnt);
+  EXPECT_EQ(5, callback_list_.get_length());
+  EXPECT_EQ(cbs2[0], callback_list_.get_tail());
+  delete cbs2[2];
+}
+
 TEST_F(TestTxCallbackList, remove_callback_by_tx_commit)
 {
   ObMemtable *memtable = create_memtable();
@@ -306,6 +333,114 @@ TEST_F(TestTxCallbackList, remove_callback_by_tx_abort)
   EXPECT_EQ(3, mgr_.get_callback_remove_for_trans_end_count());
 }
 
+TEST_F(TestTxCallbackList, parallel_trans_end_commit)
+{
+  ObMemtable *memtable = create_memtable();
+  share::SCN scn_1;
+  scn_1.convert_for_logservice(1);
+  ASSERT_EQ(OB_SUCCESS, cb_allocator_.init(OB_SERVER_TENANT_ID));
+  ASSERT_EQ(OB_SUCCESS, mgr_.extend_callback_lists_(ObTransCallbackMgr::MAX_CALLBACK_LIST_COUNT - 1));
+
+  int64_t total_cnt = 0;
+  for (int64_t i = 0; i < ObTransCallbackMgr::MAX_CALLBACK_LIST_COUNT; i += 3) {
+    ObTxCallbackList *list = mgr_.get_callback_list_(i, false);
+    for (int64_t j = 0; j < 100; j++) {
+      ObMockTxCallback *cb = create_callback(memtable, false/*need_submit_log*/, scn_1);
+      EXPECT_EQ(OB_SUCCESS, list->append_callback(cb, false/*for_replay*/));
+      total_cnt++;
+    }
+  }
+
+  ObTxCallbackListEndWorker worker;
+  ASSERT_EQ(OB_SUCCESS, worker.init());
+  ASSERT_EQ(OB_SUCCESS, worker.start());
+  EXPECT_EQ(OB_SUCCESS, mgr_.parallel_trans_end_(true/*commit*/,
+                                                 ObTxCallbackListEndWorker::WORKER_CNT,
+                                                 worker));
+  for (int64_t i = 0; i < ObTransCallbackMgr::MAX_CALLBACK_LIST_COUNT; i++) {
+    EXPECT_TRUE(mgr_.get_callback_list_(i, false)->empty());
+  }
+  EXPECT_EQ(total_cnt, mgr_.get_callback_remove_for_trans_end_count());
+  // all workers are idle again
+  for (int64_t i = 0; i < ObTxCallbackListEndWorker::WORKER_CNT; i++) {
+    EXPECT_EQ(NULL, worker.slots_[i].ctx_);
+  }
+  worker.stop();
+  worker.wait();
+  worker.destroy();
+}
+
+TEST_F(TestTxCallbackList, parallel_trans_end_abort)
+{
+  ObMemtable *memtable = create_memtable();
+  share::SCN scn_1;
+  scn_1.convert_for_logservice(1);
+  ASSERT_EQ(OB_SUCCESS, cb_allocator_.init(OB_SERVER_TENANT_ID));
+  ASSERT_EQ(OB_SUCCESS, mgr_.extend_callback_lists_(ObTransCallbackMgr::MAX_CALLBACK_LIST_COUNT - 1));
+
+  int64_t total_cnt = 0;
+  for (int64_t i = 0; i < ObTransCallbackMgr::MAX_CALLBACK_LIST_COUNT; i++) {
+    ObTxCallbackList *list = mgr_.get_callback_list_(i, false);
+    for (int64_t j = 0; j < 50; j++) {
+      // synced callbacks and unsynced callbacks are both aborted
+      ObMockTxCallback *cb = (j % 2 == 0)
+        ? create_callback(memtable, false/*need_submit_log*/, scn_1)
+        : create_callback(memtable, false/*need_submit_log*/);
+      EXPECT_EQ(OB_SUCCESS, list->append_callback(cb, false/*for_replay*/));
+      total_cnt++;
+    }
+  }
+
+  ObTxCallbackListEndWorker worker;
+  ASSERT_EQ(OB_SUCCESS, worker.init());
+  ASSERT_EQ(OB_SUCCESS, worker.start());
+  EXPECT_EQ(OB_SUCCESS, mgr_.parallel_trans_end_(false/*commit*/,
+                                                 ObTxCallbackListEndWorker::WORKER_CNT,
+                                                 worker));
+  for (int64_t i = 0; i < ObTransCallbackMgr::MAX_CALLBACK_LIST_COUNT; i++) {
+    EXPECT_TRUE(mgr_.get_callback_list_(i, false)->empty());
+  }
+  EXPECT_EQ(total_cnt, mgr_.get_callback_remove_for_trans_end_count());
+  worker.stop();
+  worker.wait();
+  worker.destroy();
+}
+
+TEST_F(TestTxCallbackList, parallel_trans_end_without_idle_worker)
+{
+  ObMemtable *memtable = create_memtable();
+  share::SCN scn_1;
+  scn_1.convert_for_logservice(1);
+  ASSERT_EQ(OB_SUCCESS, cb_allocator_.init(OB_SERVER_TENANT_ID));
+  ASSERT_EQ(OB_SUCCESS, mgr_.extend_callback_lists_(ObTransCallbackMgr::MAX_CALLBACK_LIST_COUNT - 1));
+
+  int64_t total_cnt = 0;
+  for (int64_t i = 0; i < ObTransCallbackMgr::MAX_CALLBACK_LIST_COUNT; i += 7) {
+    ObTxCallbackList *list = mgr_.get_callback_list_(i, false);
+    for (int64_t j = 0; j < 10; j++) {
+      ObMockTxCallback *cb = create_callback(memtable, false/*need_submit_log*/, scn_1);
+      EXPECT_EQ(OB_SUCCESS, list->append_callback(cb, false/*for_replay*/));
+      total_cnt++;
+    }
+  }
+
+  // the worker is not started, so nothing can be dispatched to it and all
+  // lists are ended by current thread
+  ObTxCallbackListEndWorker worker;
+  ASSERT_EQ(OB_SUCCESS, worker.init());
+  ObTxCallbackListEndCtx ctx(mgr_, true/*commit*/, ObTransCallbackMgr::MAX_CALLBACK_LIST_COUNT);
+  int64_t worker_idx = -1;
+  EXPECT_EQ(OB_EAGAIN, worker.dispatch(ctx, worker_idx));
+  EXPECT_EQ(OB_SUCCESS, mgr_.parallel_trans_end_(true/*commit*/,
+                                                 ObTxCallbackListEndWorker::WORKER_CNT,
+                                                 worker));
+  for (int64_t i = 0; i < ObTransCallbackMgr::MAX_CALLBACK_LIST_COUNT; i++) {
+    EXPECT_TRUE(mgr_.get_callback_list_(i, false)->empty());
+  }
+  EXPECT_EQ(total_cnt, mgr_.get_callback_remove_for_trans_end_count());
+  worker.destroy();
+}
+
 TEST_F(TestTxCallbackList, remove_callback_by_release_memtable)
 {
   ObMemtable *memtable1 = create_memtable();
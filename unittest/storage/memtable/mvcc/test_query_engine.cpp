@@ -19,7 +19,10 @@
 #include "../utils_mod_allocator.h"
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
 #include <thread>
+#include <vector>
 
 namespace oceanbase
 {
@@ -159,6 +162,87 @@ TEST(TestObQueryEngine, smoke_test)
   test_scan(5, false,  5, false);
 }
 
+TEST(TestObQueryEngine, sort_prefix)
+{
+  static const int64_t R_COUNT = 10;
+  ObModAllocator allocator;
+  ObMemtableKey *mtk[R_COUNT];
+  // ascending keys, signed and unsigned first columns are mixed
+  INIT_MTK(allocator, mtk[0], OBMIN());
+  INIT_MTK(allocator, mtk[1], I(INT64_MIN), I(1));
+  INIT_MTK(allocator, mtk[2], IT(-1));
+  INIT_MTK(allocator, mtk[3], UI(0));
+  INIT_MTK(allocator, mtk[4], I(1), I(0));
+  INIT_MTK(allocator, mtk[5], I(1), I(1));
+  INIT_MTK(allocator, mtk[6], UIS(2));
+  INIT_MTK(allocator, mtk[7], I(INT64_MAX));
+  INIT_MTK(allocator, mtk[8], UI(UINT64_MAX));
+  INIT_MTK(allocator, mtk[9], OBMAX());
+
+  EXPECT_EQ(0UL, memtable::ObStoreRowkeyWrapper(mtk[0]->get_rowkey()).get_sort_prefix());
+  EXPECT_EQ(0UL, memtable::ObStoreRowkeyWrapper(mtk[9]->get_rowkey()).get_sort_prefix());
+  CompHelper<memtable::ObStoreRowkeyWrapper, ObMvccRow *> comp;
+  for (int64_t i = 0; i < R_COUNT; i++) {
+    for (int64_t j = 0; j < R_COUNT; j++) {
+      const memtable::ObStoreRowkeyWrapper left(mtk[i]->get_rowkey());
+      const memtable::ObStoreRowkeyWrapper right(mtk[j]->get_rowkey());
+      int cmp = 0;
+      ASSERT_EQ(OB_SUCCESS, comp.compare(left, left.get_sort_prefix(), right, right.get_sort_prefix(), cmp));
+      ASSERT_EQ(i < j ? -1 : (i == j ? 0 : 1), cmp > 0 ? 1 : (cmp < 0 ? -1 : 0)) << i << " " << j;
+    }
+  }
+}
+
+// insert and point get throughput of the memtable btree, int keys are compared by the sort
+// prefixes and varchar keys fully, run with --gtest_also_run_disabled_tests
+TEST(TestObQueryEngine, DISABLED_keybtree_perf)
+{
+  static const int64_t R_COUNT = 1L << 20;
+  ObModAllocator allocator;
+  ObQueryEngine::BtreeNodeAllocator node_allocator(allocator);
+  ObObj *objs = static_cast<ObObj *>(allocator.alloc(sizeof(ObObj) * R_COUNT));
+  ObStoreRowkey *rowkeys = static_cast<ObStoreRowkey *>(allocator.alloc(sizeof(ObStoreRowkey) * R_COUNT));
+  char *strs = static_cast<char *>(allocator.alloc(16 * R_COUNT));
+  ASSERT_TRUE(nullptr != objs && nullptr != rowkeys && nullptr != strs);
+  std::vector<int64_t> order(R_COUNT);
+  for (int64_t i = 0; i < R_COUNT; i++) {
+    order[i] = i;
+  }
+  std::shuffle(order.begin(), order.end(), std::mt19937_64(R_COUNT));
+
+  for (int64_t round = 0; round < 2; round++) {
+    const bool is_int = (0 == round);
+    for (int64_t i = 0; i < R_COUNT; i++) {
+      if (is_int) {
+        objs[i].set_int(order[i]);
+      } else {
+        snprintf(strs + i * 16, 16, "%015ld", order[i]);
+        objs[i].set_varchar(strs + i * 16, 15);
+        objs[i].set_collation_type(CS_TYPE_UTF8MB4_BIN);
+      }
+      new (rowkeys + i) ObStoreRowkey(objs + i, 1);
+    }
+    ObMemtableKeyBtree btree(node_allocator);
+    ASSERT_EQ(OB_SUCCESS, btree.init());
+    int64_t start_ts = ObTimeUtility::current_time();
+    for (int64_t i = 0; i < R_COUNT; i++) {
+      ObMvccRow *value = reinterpret_cast<ObMvccRow *>((i + 1) << 3);
+      ASSERT_EQ(OB_SUCCESS, btree.insert(memtable::ObStoreRowkeyWrapper(rowkeys + i), value));
+    }
+    const int64_t insert_us = ObTimeUtility::current_time() - start_ts;
+    start_ts = ObTimeUtility::current_time();
+    for (int64_t i = 0; i < R_COUNT; i++) {
+      ObMvccRow *value = nullptr;
+      ASSERT_EQ(OB_SUCCESS, btree.get(memtable::ObStoreRowkeyWrapper(rowkeys + i), value));
+      ASSERT_EQ(reinterpret_cast<ObMvccRow *>((i + 1) << 3), value);
+    }
+    const int64_t get_us = ObTimeUtility::current_time() - start_ts;
+    fprintf(stdout, "%s keys: insert %ld/s, get %ld/s\n", is_int ? "int" : "varchar",
+            R_COUNT * 1000000 / std::max(insert_us, 1L), R_COUNT * 1000000 / std::max(get_us, 1L));
+    ASSERT_EQ(OB_SUCCESS, btree.destroy(false /*is_batch_destroy*/));
+  }
+}
+
 }
 }
 
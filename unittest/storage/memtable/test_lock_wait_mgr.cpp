@@ -0,0 +1,271 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+#define private public
+#define protected public
+#include "storage/memtable/ob_lock_wait_mgr.h"
+#include "share/config/ob_server_config.h"
+#include "common/ob_clock_generator.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace memtable;
+using namespace transaction;
+namespace unittest
+{
+typedef ObLockWaitMgr::Node Node;
+
+// requests woken up are recorded instead of being pushed to the worker queue
+class MockLockWaitMgr : public ObLockWaitMgr
+{
+public:
+  virtual int repost(Node *node) override
+  {
+    reposted_.push_back(node);
+    return OB_SUCCESS;
+  }
+  std::vector<Node *> reposted_;
+};
+
+class TestLockWaitMgr : public ::testing::Test
+{
+public:
+  TestLockWaitMgr() : rowkey_(&obj_, 1), key_(&rowkey_), tablet_id_(200001), hash_(0) {}
+  virtual void SetUp() override
+  {
+    // deadlock detector needs the session of the request, not available here
+    ObServerConfig::get_instance()._lcl_op_interval = 0;
+    obj_.set_int(1);
+    hash_ = LockHashHelper::hash_rowkey(tablet_id_, key_);
+    mgr_.stop_ = false;
+    mgr_.is_inited_ = true;
+    mgr_.last_check_session_idle_ts_ = ObClockGenerator::getClock();
+  }
+  virtual void TearDown() override
+  {
+    ObLockWaitMgr::clear_thread_node();
+    mgr_.reposted_.clear();
+  }
+  // the request conflicts on the row and waits in the queue
+  void wait_on_row(Node &node, const int64_t recv_ts, const int64_t abs_timeout, const int64_t tx_id)
+  {
+    bool need_wait = false;
+    mgr_.setup(node, recv_ts);
+    node.set(&node, hash_, mgr_.get_seq(hash_), abs_timeout, tablet_id_.id(), 0, 0, "k", tx_id, 1);
+    node.set_need_wait();
+    ASSERT_TRUE(mgr_.post_process(true, need_wait));
+    ASSERT_TRUE(need_wait);
+    ObLockWaitMgr::clear_thread_node();
+  }
+  // the request woken up runs again, and ends with the row locked or not
+  void retry(Node &node, const bool lock_row)
+  {
+    bool need_wait = false;
+    mgr_.setup(node, node.recv_ts_);
+    ASSERT_EQ(hash_, ObLockWaitMgr::get_thread_hold_key());
+    if (lock_row) {
+      mgr_.set_hash_holder(tablet_id_, key_, ObTransID(node.tx_id_));
+      ASSERT_EQ(0U, ObLockWaitMgr::get_thread_hold_key());
+    }
+    ASSERT_FALSE(mgr_.post_process(false, need_wait));
+    ASSERT_FALSE(need_wait);
+    ObLockWaitMgr::clear_thread_node();
+  }
+  // one round of the background check, same as run1
+  void check_timeout()
+  {
+    ObLink *iter = mgr_.check_timeout();
+    while (NULL != iter) {
+      Node *cur = CONTAINER_OF(iter, Node, retire_link_);
+      iter = iter->next_;
+      (void)mgr_.repost(cur);
+    }
+  }
+  void release_row() { mgr_.wakeup(tablet_id_, key_); }
+protected:
+  ObObj obj_;
+  ObStoreRowkey rowkey_;
+  ObMemtableKey key_;
+  ObTabletID tablet_id_;
+  uint64_t hash_;
+  MockLockWaitMgr mgr_;
+};
+
+TEST_F(TestLockWaitMgr, handover_to_head_waiter)
+{
+  Node nodes[3];
+  // queued by the receive time, not the arrival order
+  wait_on_row(nodes[2], 300, INT64_MAX, 3);
+  wait_on_row(nodes[0], 100, INT64_MAX, 1);
+  wait_on_row(nodes[1], 200, INT64_MAX, 2);
+
+  // release of the row wakes the head waiter only
+  release_row();
+  ASSERT_EQ(1, static_cast<int64_t>(mgr_.reposted_.size()));
+  ASSERT_EQ(&nodes[0], mgr_.reposted_[0]);
+
+  // the head waiter gets the row, the next one is left to the next release
+  retry(nodes[0], true);
+  ASSERT_EQ(1, static_cast<int64_t>(mgr_.reposted_.size()));
+  release_row();
+  ASSERT_EQ(2, static_cast<int64_t>(mgr_.reposted_.size()));
+  ASSERT_EQ(&nodes[1], mgr_.reposted_[1]);
+
+  // the head waiter fails to get the row, it still wakes the next one
+  retry(nodes[1], false);
+  ASSERT_EQ(3, static_cast<int64_t>(mgr_.reposted_.size()));
+  ASSERT_EQ(&nodes[2], mgr_.reposted_[2]);
+  ASSERT_TRUE(mgr_.is_hash_empty());
+
+  // locking another row keeps the hold key
+  Node node;
+  wait_on_row(node, 400, INT64_MAX, 4);
+  release_row();
+  ASSERT_EQ(&node, mgr_.reposted_.back());
+  mgr_.setup(node, node.recv_ts_);
+  ObObj other_obj;
+  other_obj.set_int(2);
+  ObStoreRowkey other_rowkey(&other_obj, 1);
+  ObMemtableKey other_key(&other_rowkey);
+  mgr_.set_hash_holder(tablet_id_, other_key, ObTransID(node.tx_id_));
+  ASSERT_EQ(hash_, ObLockWaitMgr::get_thread_hold_key());
+}
+
+TEST_F(TestLockWaitMgr, waiter_timeout_before_handover)
+{
+  Node nodes[3];
+  wait_on_row(nodes[0], 100, ObTimeUtility::current_time() - 1, 1);
+  wait_on_row(nodes[1], 200, INT64_MAX, 2);
+  wait_on_row(nodes[2], 300, INT64_MAX, 3);
+
+  // the timed out head waiter is popped, it holds nothing to hand over
+  check_timeout();
+  ASSERT_EQ(1, static_cast<int64_t>(mgr_.reposted_.size()));
+  ASSERT_EQ(&nodes[0], mgr_.reposted_[0]);
+  ASSERT_EQ(0U, nodes[0].hold_key_);
+
+  // the release goes to the next waiter
+  release_row();
+  ASSERT_EQ(2, static_cast<int64_t>(mgr_.reposted_.size()));
+  ASSERT_EQ(&nodes[1], mgr_.reposted_[1]);
+
+  // woken up but timed out before getting the row, the handover is passed on
+  retry(nodes[1], false);
+  ASSERT_EQ(3, static_cast<int64_t>(mgr_.reposted_.size()));
+  ASSERT_EQ(&nodes[2], mgr_.reposted_[2]);
+  ASSERT_TRUE(mgr_.is_hash_empty());
+}
+
+TEST_F(TestLockWaitMgr, waiter_killed_before_handover)
+{
+  const uint32_t sessid = 1000;
+  Node nodes[2];
+  wait_on_row(nodes[0], 100, INT64_MAX, 1);
+  wait_on_row(nodes[1], 200, INT64_MAX, 2);
+
+  // the session of the head waiter is killed by the deadlock detector
+  nodes[0].sessid_ = sessid;
+  ASSERT_EQ(OB_SUCCESS, mgr_.notify_deadlocked_session(sessid));
+  check_timeout();
+  ASSERT_EQ(1, static_cast<int64_t>(mgr_.reposted_.size()));
+  ASSERT_EQ(&nodes[0], mgr_.reposted_[0]);
+
+  release_row();
+  ASSERT_EQ(2, static_cast<int64_t>(mgr_.reposted_.size()));
+  ASSERT_EQ(&nodes[1], mgr_.reposted_[1]);
+  ASSERT_TRUE(mgr_.is_hash_empty());
+}
+
+TEST_F(TestLockWaitMgr, no_lost_wakeup)
+{
+  // the row is released after the request conflicts and before it waits
+  Node node;
+  const int64_t lock_seq = mgr_.get_seq(hash_);
+  release_row();
+  ASSERT_EQ(0, static_cast<int64_t>(mgr_.reposted_.size()));
+  bool need_wait = false;
+  mgr_.setup(node, 100);
+  node.set(&node, hash_, lock_seq, INT64_MAX, tablet_id_.id(), 0, 0, "k", 1, 2);
+  node.set_need_wait();
+  ASSERT_TRUE(mgr_.post_process(true, need_wait));
+  ObLockWaitMgr::clear_thread_node();
+  ASSERT_TRUE(node.is_standalone_task());
+
+  // nobody is going to release the row, the background check wakes it up
+  check_timeout();
+  ASSERT_EQ(1, static_cast<int64_t>(mgr_.reposted_.size()));
+  ASSERT_EQ(&node, mgr_.reposted_[0]);
+  ASSERT_EQ(hash_, node.hold_key_);
+  ASSERT_TRUE(mgr_.is_hash_empty());
+
+  // every release in a long queue wakes exactly one waiter, in order
+  const int64_t cnt = 16;
+  Node waiters[cnt];
+  for (int64_t i = 0; i < cnt; ++i) {
+    wait_on_row(waiters[i], 1000 + i, INT64_MAX, 10 + i);
+  }
+  mgr_.reposted_.clear();
+  for (int64_t i = 0; i < cnt; ++i) {
+    release_row();
+    ASSERT_EQ(i + 1, static_cast<int64_t>(mgr_.reposted_.size()));
+    ASSERT_EQ(&waiters[i], mgr_.reposted_[i]);
+    retry(waiters[i], true);
+    ASSERT_EQ(i + 1, static_cast<int64_t>(mgr_.reposted_.size()));
+  }
+  ASSERT_TRUE(mgr_.is_hash_empty());
+}
+
+TEST_F(TestLockWaitMgr, key_wait_stat)
+{
+  ObLockWaitMgr::KeyWaitStat stat;
+  mgr_.get_key_wait_stat(hash_, stat);
+  ASSERT_EQ(0, stat.wakeup_cnt_);
+
+  // wakeup on release is counted for the key
+  Node nodes[2];
+  wait_on_row(nodes[0], 100, INT64_MAX, 1);
+  wait_on_row(nodes[1], 200, INT64_MAX, 2);
+  release_row();
+  retry(nodes[0], false);
+  mgr_.get_key_wait_stat(hash_, stat);
+  ASSERT_EQ(hash_, stat.hash_);
+  ASSERT_EQ(2, stat.wakeup_cnt_);
+  ASSERT_GE(stat.wait_time_, 0);
+
+  // another key of the same lock bucket does not see the stat, and takes it over
+  const uint64_t bucket_cnt = ObLockWaitMgr::LOCK_BUCKET_COUNT;
+  const uint64_t other_hash = hash_ + 2 * bucket_cnt;
+  mgr_.get_key_wait_stat(other_hash, stat);
+  ASSERT_EQ(0, stat.wakeup_cnt_);
+  mgr_.record_wait_time(other_hash, 10);
+  mgr_.record_wait_time(other_hash, 20);
+  mgr_.get_key_wait_stat(other_hash, stat);
+  ASSERT_EQ(2, stat.wakeup_cnt_);
+  ASSERT_EQ(30, stat.wait_time_);
+  mgr_.get_key_wait_stat(hash_, stat);
+  ASSERT_EQ(0, stat.wakeup_cnt_);
+  ASSERT_EQ(0, stat.wait_time_);
+}
+}
+}
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_lock_wait_mgr.log*");
+  OB_LOGGER.set_file_name("test_lock_wait_mgr.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,236 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <utility>
+#include <vector>
+#define private public
+#define protected public
+#include "storage/access/ob_index_tree_prefetcher.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace blocksstable;
+using namespace storage;
+namespace unittest
+{
+typedef ObIndexTreeMultiPassPrefetcher<32, 3> Prefetcher;
+
+class TestIndexTreePrefetcher : public ::testing::Test
+{
+public:
+  struct Block
+  {
+    int64_t macro_seq_;
+    int32_t offset_;
+    int32_t size_;
+    bool is_hit_;
+  };
+  void prepare(const std::vector<Block> &blocks)
+  {
+    headers_.resize(blocks.size());
+    infos_.resize(blocks.size());
+    for (int64_t i = 0; i < static_cast<int64_t>(blocks.size()); ++i) {
+      headers_[i].block_offset_ = blocks[i].offset_;
+      headers_[i].block_size_ = blocks[i].size_;
+      infos_[i].row_header_ = &headers_[i];
+      infos_[i].parent_macro_id_ = MacroBlockId(0, blocks[i].macro_seq_, 0);
+    }
+  }
+  // group the blocks missed in cache to ios the same way as prefetch_data_block
+  void collect_ios(const std::vector<Block> &blocks, std::vector<std::pair<int64_t, int64_t>> &ios)
+  {
+    int64_t io_start_idx = 0;
+    int64_t io_cnt = 0;
+    prepare(blocks);
+    ios.clear();
+    for (int64_t i = 0; i < static_cast<int64_t>(blocks.size()); ++i) {
+      if (blocks[i].is_hit_) {
+      } else {
+        if (0 < io_cnt && !Prefetcher::can_merge_block_io(
+            infos_[io_start_idx + io_cnt - 1], io_start_idx + io_cnt, io_cnt, infos_[i], i)) {
+          ios.push_back(std::make_pair(io_start_idx, io_cnt));
+          io_cnt = 0;
+        }
+        if (0 == io_cnt) {
+          io_start_idx = i;
+        }
+        ++io_cnt;
+      }
+    }
+    if (0 < io_cnt) {
+      ios.push_back(std::make_pair(io_start_idx, io_cnt));
+    }
+  }
+protected:
+  std::vector<ObIndexBlockRowHeader> headers_;
+  std::vector<ObMicroIndexInfo> infos_;
+};
+
+TEST_F(TestIndexTreePrefetcher, adjust_prefetch_depth)
+{
+  const int32_t max_depth = Prefetcher::DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT;
+  // nothing observed yet, grows as before
+  int32_t depth = 1;
+  for (int64_t i = 0; i < 10; ++i) {
+    depth = Prefetcher::adjust_prefetch_depth(depth, 0, 0, 0);
+  }
+  ASSERT_EQ(max_depth, depth);
+
+  // reader waited, grows until the max
+  depth = 1;
+  depth = Prefetcher::adjust_prefetch_depth(depth, 0, 1, 1);
+  ASSERT_EQ(2, depth);
+  depth = Prefetcher::adjust_prefetch_depth(depth, 10, 0, 1);
+  ASSERT_EQ(4, depth);
+  depth = Prefetcher::adjust_prefetch_depth(max_depth - 1, 3, 5, 2);
+  ASSERT_EQ(max_depth, depth);
+
+  // mostly cache hits, shrinks until 1
+  depth = max_depth;
+  depth = Prefetcher::adjust_prefetch_depth(depth, 9, 1, 0);
+  ASSERT_EQ(max_depth / 2, depth);
+  depth = Prefetcher::adjust_prefetch_depth(depth, 10, 0, 0);
+  ASSERT_EQ(max_depth / 4, depth);
+  for (int64_t i = 0; i < 10; ++i) {
+    depth = Prefetcher::adjust_prefetch_depth(depth, 100, 0, 0);
+  }
+  ASSERT_EQ(1, depth);
+
+  // io without waiting, keeps the depth
+  ASSERT_EQ(8, Prefetcher::adjust_prefetch_depth(8, 8, 2, 0));
+  ASSERT_EQ(8, Prefetcher::adjust_prefetch_depth(8, 0, 8, 0));
+  ASSERT_EQ(8, Prefetcher::adjust_prefetch_depth(8, 89, 11, 0));
+  ASSERT_EQ(4, Prefetcher::adjust_prefetch_depth(8, 90, 10, 0));
+
+  // waiting wins over hits
+  ASSERT_EQ(16, Prefetcher::adjust_prefetch_depth(8, 100, 0, 1));
+}
+
+TEST_F(TestIndexTreePrefetcher, merge_adjacent_blocks)
+{
+  std::vector<std::pair<int64_t, int64_t>> ios;
+  // all adjacent in one macro block
+  collect_ios({{1, 0, 100, false}, {1, 100, 200, false}, {1, 300, 50, false}}, ios);
+  ASSERT_EQ(1, static_cast<int64_t>(ios.size()));
+  ASSERT_EQ(std::make_pair(int64_t(0), int64_t(3)), ios[0]);
+
+  // gap between blocks
+  collect_ios({{1, 0, 100, false}, {1, 100, 100, false}, {1, 4096, 100, false}, {1, 4196, 100, false}}, ios);
+  ASSERT_EQ(2, static_cast<int64_t>(ios.size()));
+  ASSERT_EQ(std::make_pair(int64_t(0), int64_t(2)), ios[0]);
+  ASSERT_EQ(std::make_pair(int64_t(2), int64_t(2)), ios[1]);
+
+  // out of order is not adjacent
+  collect_ios({{1, 100, 100, false}, {1, 0, 100, false}}, ios);
+  ASSERT_EQ(2, static_cast<int64_t>(ios.size()));
+
+  // cross macro blocks, even if the offsets follow
+  collect_ios({{1, 0, 100, false}, {1, 100, 100, false}, {2, 200, 100, false}, {2, 300, 100, false}}, ios);
+  ASSERT_EQ(2, static_cast<int64_t>(ios.size()));
+  ASSERT_EQ(std::make_pair(int64_t(0), int64_t(2)), ios[0]);
+  ASSERT_EQ(std::make_pair(int64_t(2), int64_t(2)), ios[1]);
+
+  // a block in cache splits the run
+  collect_ios({{1, 0, 100, false}, {1, 100, 100, true}, {1, 200, 100, false}, {1, 300, 100, false}}, ios);
+  ASSERT_EQ(2, static_cast<int64_t>(ios.size()));
+  ASSERT_EQ(std::make_pair(int64_t(0), int64_t(1)), ios[0]);
+  ASSERT_EQ(std::make_pair(int64_t(2), int64_t(2)), ios[1]);
+
+  // all in cache
+  collect_ios({{1, 0, 100, true}, {1, 100, 100, true}}, ios);
+  ASSERT_EQ(0, static_cast<int64_t>(ios.size()));
+
+  // split by the max block count of one io
+  const int64_t max_cnt = Prefetcher::MAX_MULTI_BLOCK_IO_CNT;
+  std::vector<Block> blocks;
+  for (int64_t i = 0; i < 2 * max_cnt + 1; ++i) {
+    blocks.push_back({1, static_cast<int32_t>(i * 100), 100, false});
+  }
+  collect_ios(blocks, ios);
+  ASSERT_EQ(3, static_cast<int64_t>(ios.size()));
+  ASSERT_EQ(std::make_pair(int64_t(0), max_cnt), ios[0]);
+  ASSERT_EQ(std::make_pair(max_cnt, max_cnt), ios[1]);
+  ASSERT_EQ(std::make_pair(2 * max_cnt, int64_t(1)), ios[2]);
+}
+
+TEST_F(TestIndexTreePrefetcher, nested_offset)
+{
+  // blocks of a nested macro block are adjacent by their real offsets
+  prepare({{1, 0, 100, false}, {1, 100, 100, false}});
+  infos_[0].nested_offset_ = 4096;
+  ASSERT_FALSE(Prefetcher::can_merge_block_io(infos_[0], 1, 1, infos_[1], 1));
+  infos_[1].nested_offset_ = 4096;
+  ASSERT_TRUE(Prefetcher::can_merge_block_io(infos_[0], 1, 1, infos_[1], 1));
+  // not the next block to prefetch
+  ASSERT_FALSE(Prefetcher::can_merge_block_io(infos_[0], 1, 1, infos_[1], 2));
+}
+
+TEST_F(TestIndexTreePrefetcher, share_prefetched_handle)
+{
+  typedef ObIndexTreeMultiPrefetcher::ObSSTableReadHandleExt ReadHandle;
+  const int32_t window = 4;
+  ObArenaAllocator allocator;
+  ObIndexTreeMultiPrefetcher prefetcher;
+  prefetcher.max_handle_prefetching_cnt_ = window;
+  prefetcher.ext_read_handles_.set_allocator(&allocator);
+  ASSERT_EQ(OB_SUCCESS, prefetcher.ext_read_handles_.prepare_reallocate(window));
+  // the next block of the same macro block, and the same offset of another macro block
+  prepare({{1, 0, 100, false}, {1, 100, 100, false}, {2, 0, 100, false}});
+
+  // the first rowkey reads block 0
+  ReadHandle &first = prefetcher.ext_read_handles_[0];
+  first.range_idx_ = 0;
+  ObMicroBlockDataHandle &handle = first.get_read_handle();
+  handle.tenant_id_ = MTL_ID();
+  handle.macro_block_id_ = infos_[0].get_macro_id();
+  handle.micro_info_.offset_ = 0;
+  handle.micro_info_.size_ = 100;
+  handle.block_state_ = ObSSTableMicroBlockState::IN_BLOCK_IO;
+  first.set_cur_micro_handle(handle);
+
+  // the second rowkey in the same block reuses the handle, io in flight or done
+  ReadHandle &second = prefetcher.ext_read_handles_[1];
+  second.range_idx_ = 1;
+  ASSERT_EQ(&handle, prefetcher.get_prefetched_handle(second, infos_[0]));
+  handle.block_state_ = ObSSTableMicroBlockState::IN_BLOCK_CACHE;
+  ASSERT_EQ(&handle, prefetcher.get_prefetched_handle(second, infos_[0]));
+  // never for a different block
+  ASSERT_EQ(nullptr, prefetcher.get_prefetched_handle(second, infos_[1]));
+  ASSERT_EQ(nullptr, prefetcher.get_prefetched_handle(second, infos_[2]));
+  // nor a block not read
+  handle.block_state_ = ObSSTableMicroBlockState::NEED_SYNC_IO;
+  ASSERT_EQ(nullptr, prefetcher.get_prefetched_handle(second, infos_[0]));
+  handle.block_state_ = ObSSTableMicroBlockState::IN_BLOCK_CACHE;
+
+  // only the rowkeys before it in the prefetching window are searched
+  ASSERT_EQ(nullptr, prefetcher.get_prefetched_handle(first, infos_[0]));
+  ReadHandle &last = prefetcher.ext_read_handles_[window - 1];
+  last.range_idx_ = window - 1;
+  ASSERT_EQ(&handle, prefetcher.get_prefetched_handle(last, infos_[0]));
+  ReadHandle next;
+  next.range_idx_ = window;
+  ASSERT_EQ(nullptr, prefetcher.get_prefetched_handle(next, infos_[0]));
+  handle.block_state_ = ObSSTableMicroBlockState::UNKNOWN_STATE;
+}
+}
+}
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_index_tree_prefetcher.log*");
+  OB_LOGGER.set_file_name("test_index_tree_prefetcher.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
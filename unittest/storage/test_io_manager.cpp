@@ -46,10 +46,10 @@ static const int64_t IO_MEMORY_LIMIT = 10L * 1024L * 1024L * 1024L;
 static const uint64_t TEST_TENANT_ID = 1001;
 
 
-int init_device(const int64_t media_id, ObLocalDevice &device)
+int init_device(const int64_t media_id, ObLocalDevice &device, const char *io_engine = "libaio")
 {
   int ret = OB_SUCCESS;
-  const int64_t IO_OPT_COUNT = 6;
+  const int64_t IO_OPT_COUNT = 7;
   const int64_t block_size = 1024L * 1024L * 2L; // 2MB
   const int64_t data_disk_size = 1024L * 1024L * 1024L; // 1GB
   const int64_t data_disk_percentage = 50L;
@@ -60,6 +60,7 @@ int init_device(const int64_t media_id, ObLocalDevice &device)
   io_opts[3].key_ = "datafile_disk_percentage";   io_opts[3].value_.value_int64 = data_disk_percentage;
   io_opts[4].key_ = "datafile_size";              io_opts[4].value_.value_int64 = data_disk_size;
   io_opts[5].key_ = "media_id";                   io_opts[5].value_.value_int64 = media_id;
+  io_opts[6].key_ = "io_engine";                  io_opts[6].value_.value_str = io_engine;
   ObIODOpts init_opts;
   init_opts.opts_ = io_opts;
   init_opts.opt_cnt_ = IO_OPT_COUNT;
@@ -536,6 +537,73 @@ TEST_F(TestIOStruct, IOStat)
   ASSERT_GE(avg_cpu, 0);
 }
 
+TEST_F(TestIOStruct, IOLatencyController)
+{
+  for (int64_t delay_us = 0; delay_us < 1000L * 1000L; delay_us += 7) {
+    const int64_t upper_bound = ObIOLatencyController::get_bucket_upper_bound(ObIOLatencyController::get_bucket_idx(delay_us));
+    ASSERT_GE(upper_bound, delay_us);
+    ASSERT_LE(upper_bound, delay_us + delay_us / 4);
+  }
+
+  ObIOLatencyController controller;
+  ObIORequest req;
+  const int64_t target_us = 1000;
+  ASSERT_EQ(INT64_MAX, controller.get_background_iops_limit());
+  req.time_log_.submit_ts_ = 1000;
+  req.time_log_.return_ts_ = 3000;
+  // nothing is recorded before the target is set
+  controller.record_io(0, req);
+  controller.record_io(ObIOModule::SSTABLE_MACRO_BLOCK_WRITE_IO, req);
+  ASSERT_EQ(0, controller.background_cnt_);
+  ASSERT_EQ(0, controller.buckets_[ObIOLatencyController::get_bucket_idx(2000)]);
+  controller.adjust(target_us);
+  ASSERT_EQ(0, controller.foreground_cnt_);
+  // foreground io is slow, background io is throttled to half of its iops
+  for (int64_t i = 0; i < 1000; ++i) {
+    controller.record_io(0, req);
+    controller.record_io(ObIOModule::MICRO_BLOCK_CACHE_IO, req);
+  }
+  for (int64_t i = 0; i < 1000; ++i) {
+    controller.record_io(ObIOModule::SSTABLE_MACRO_BLOCK_WRITE_IO, req);
+  }
+  controller.last_adjust_ts_ = ObTimeUtility::fast_current_time() - 1000L * 1000L;
+  controller.adjust(target_us);
+  ASSERT_GE(controller.get_foreground_p99_us(), 2000);
+  ASSERT_LT(controller.get_foreground_p99_us(), 2500);
+  ASSERT_NEAR(500, controller.get_background_iops_limit(), 10);
+  const int64_t first_limit = controller.get_background_iops_limit();
+  for (int64_t i = 0; i < 1000; ++i) {
+    controller.record_io(0, req);
+  }
+  controller.adjust(target_us);
+  ASSERT_EQ(first_limit / 2, controller.get_background_iops_limit());
+
+  // foreground io is fast, the limit is raised and removed when background io does not use it up
+  req.time_log_.return_ts_ = 1100;
+  for (int64_t i = 0; i < 1000; ++i) {
+    controller.record_io(0, req);
+  }
+  controller.adjust(target_us);
+  ASSERT_EQ(INT64_MAX, controller.get_background_iops_limit());
+
+  // disabled
+  req.time_log_.return_ts_ = 3000;
+  for (int64_t i = 0; i < 1000; ++i) {
+    controller.record_io(0, req);
+    controller.record_io(ObIOModule::BACKUP_READER_IO, req);
+  }
+  controller.adjust(0);
+  ASSERT_EQ(INT64_MAX, controller.get_background_iops_limit());
+  for (int64_t i = 0; i < 1000; ++i) {
+    controller.record_io(0, req);
+    controller.record_io(ObIOModule::BACKUP_READER_IO, req);
+  }
+  ASSERT_EQ(0, controller.background_cnt_);
+  for (int64_t i = 0; i < ObIOLatencyController::BUCKET_CNT; ++i) {
+    ASSERT_EQ(0, controller.buckets_[i]);
+  }
+}
+
 TEST_F(TestIOStruct, IOScheduler)
 {
   ObIOCalibration::get_instance().init();
@@ -1383,6 +1451,145 @@ TEST_F(TestIOManager, perf)
   LOG_INFO("wenqu: perf finished");
 }
 
+TEST_F(TestIOManager, io_uring)
+{
+  // io_uring may be missing in the kernel or forbidden by seccomp, the device falls back to libaio then
+  bool is_uring_supported = false;
+  {
+    ObIOUring probe_ring;
+    is_uring_supported = OB_SUCCESS == probe_ring.init(8, false/*sqpoll*/, -1/*fixed_fd*/);
+  }
+  LOG_INFO("io uring support", K(is_uring_supported));
+
+  // the engine in use
+  ObLocalDevice libaio_device;
+  ObLocalDevice uring_device;
+  ObIOContext *io_context = nullptr;
+  ASSERT_SUCC(init_device(0, libaio_device));
+  ASSERT_SUCC(libaio_device.io_setup(8, io_context));
+  ASSERT_EQ(nullptr, dynamic_cast<ObLocalIOUringContext *>(io_context));
+  ASSERT_NE(nullptr, dynamic_cast<ObLocalIOContext *>(io_context));
+  ASSERT_SUCC(libaio_device.io_destroy(io_context));
+  libaio_device.destroy();
+  ASSERT_SUCC(init_device(0, uring_device, "io_uring"));
+  ASSERT_SUCC(uring_device.io_setup(8, io_context));
+  ASSERT_EQ(is_uring_supported, nullptr != dynamic_cast<ObLocalIOUringContext *>(io_context));
+  ASSERT_EQ(is_uring_supported, nullptr == dynamic_cast<ObLocalIOContext *>(io_context));
+  ASSERT_SUCC(uring_device.io_destroy(io_context));
+
+  const int64_t IO_CNT = 16;
+  const int64_t IO_SIZE = DIO_READ_ALIGN_SIZE * 4;
+  const int64_t FILE_SIZE = IO_CNT * IO_SIZE;
+  ObIOFd fd;
+  ASSERT_SUCC(uring_device.open(TEST_ROOT_DIR "/test_io_uring_file", O_CREAT | O_DIRECT | O_TRUNC | O_RDWR, 0644, fd));
+  ASSERT_TRUE(fd.is_valid());
+  fd.device_handle_ = &uring_device;
+  ASSERT_SUCC(uring_device.fallocate(fd, 0, 0, FILE_SIZE));
+  char *write_buf = static_cast<char *>(ob_malloc_align(DIO_READ_ALIGN_SIZE, FILE_SIZE, ObNewModIds::TEST));
+  char *read_buf = static_cast<char *>(ob_malloc_align(DIO_READ_ALIGN_SIZE, FILE_SIZE, ObNewModIds::TEST));
+  ASSERT_NE(nullptr, write_buf);
+  ASSERT_NE(nullptr, read_buf);
+  for (int64_t i = 0; i < FILE_SIZE; ++i) {
+    write_buf[i] = static_cast<char>(ObRandom::rand(0, 255));
+  }
+
+  // raw ring, all requests are in flight before reaping
+  if (is_uring_supported) {
+    const int32_t raw_fd = static_cast<int32_t>(fd.second_id_);
+    ObIOUring ring;
+    struct iocb cbs[IO_CNT];
+    struct io_event events[IO_CNT];
+    ASSERT_SUCC(ring.init(IO_CNT, false/*sqpoll*/, raw_fd));
+    for (int64_t round = 0; round < 2; ++round) {
+      const bool is_write = 0 == round;
+      char *buf = is_write ? write_buf : read_buf;
+      MEMSET(read_buf, 0, FILE_SIZE);
+      // submit in reverse order, completions may come in any order
+      for (int64_t i = IO_CNT - 1; i >= 0; --i) {
+        if (is_write) {
+          io_prep_pwrite(&cbs[i], raw_fd, buf + i * IO_SIZE, IO_SIZE, i * IO_SIZE);
+        } else {
+          io_prep_pread(&cbs[i], raw_fd, buf + i * IO_SIZE, IO_SIZE, i * IO_SIZE);
+        }
+        cbs[i].data = reinterpret_cast<void *>(i);
+        ASSERT_SUCC(ring.submit(cbs[i]));
+      }
+      bool is_done[IO_CNT] = { false };
+      int64_t done_cnt = 0;
+      const struct timespec timeout = { 1, 0 };
+      while (done_cnt < IO_CNT) {
+        int64_t complete_cnt = 0;
+        ASSERT_SUCC(ring.get_events(1, IO_CNT, events, &timeout, complete_cnt));
+        ASSERT_GT(complete_cnt, 0);
+        for (int64_t i = 0; i < complete_cnt; ++i) {
+          const int64_t idx = reinterpret_cast<int64_t>(events[i].data);
+          ASSERT_EQ(&cbs[idx], events[i].obj);
+          ASSERT_EQ(IO_SIZE, static_cast<int64_t>(events[i].res));
+          ASSERT_FALSE(is_done[idx]);
+          is_done[idx] = true;
+          ++done_cnt;
+        }
+      }
+    }
+    ASSERT_EQ(0, MEMCMP(write_buf, read_buf, FILE_SIZE));
+
+    // nothing in flight, returns once the timeout is reached
+    const struct timespec timeout = { 0, 100 * 1000 * 1000 };
+    int64_t complete_cnt = 0;
+    const int64_t begin_us = ObTimeUtility::current_time();
+    ASSERT_SUCC(ring.get_events(1, IO_CNT, events, &timeout, complete_cnt));
+    const int64_t cost_us = ObTimeUtility::current_time() - begin_us;
+    ASSERT_EQ(0, complete_cnt);
+    ASSERT_GE(cost_us, 100 * 1000);
+    ASSERT_LT(cost_us, 1000 * 1000);
+  }
+
+  // round trip through io manager on the device, with all requests in flight
+  ASSERT_SUCC(OB_IO_MANAGER.add_device_channel(&uring_device, 8/*async*/, 1/*sync*/, 64/*max_io_depth*/));
+  ObIOHandle handles[IO_CNT];
+  ObIOInfo io_info;
+  io_info.tenant_id_ = OB_SERVER_TENANT_ID;
+  io_info.fd_ = fd;
+  io_info.flag_.set_group_id(0);
+  io_info.flag_.set_wait_event(ObWaitEventIds::DB_FILE_DATA_READ);
+  io_info.size_ = IO_SIZE;
+  io_info.timeout_us_ = DEFAULT_IO_WAIT_TIME_US;
+  MEMSET(read_buf, 0, FILE_SIZE);
+  for (int64_t i = 0; i < FILE_SIZE; ++i) {
+    write_buf[i] = static_cast<char>(i * 7 + 3);
+  }
+  io_info.flag_.set_write();
+  for (int64_t i = 0; i < IO_CNT; ++i) {
+    io_info.offset_ = i * IO_SIZE;
+    io_info.buf_ = write_buf + i * IO_SIZE;
+    ASSERT_SUCC(OB_IO_MANAGER.aio_write(io_info, handles[i]));
+  }
+  for (int64_t i = 0; i < IO_CNT; ++i) {
+    ASSERT_SUCC(handles[i].wait());
+    handles[i].reset();
+  }
+  io_info.flag_.set_read();
+  io_info.buf_ = nullptr;
+  for (int64_t i = 0; i < IO_CNT; ++i) {
+    io_info.offset_ = i * IO_SIZE;
+    io_info.user_data_buf_ = read_buf + i * IO_SIZE;
+    ASSERT_SUCC(OB_IO_MANAGER.aio_read(io_info, handles[i]));
+  }
+  for (int64_t i = 0; i < IO_CNT; ++i) {
+    ASSERT_SUCC(handles[i].wait());
+    ASSERT_EQ(IO_SIZE, handles[i].get_data_size());
+    ASSERT_EQ(0, MEMCMP(write_buf + i * IO_SIZE, handles[i].get_buffer(), IO_SIZE));
+    handles[i].reset();
+  }
+  ASSERT_EQ(0, MEMCMP(write_buf, read_buf, FILE_SIZE));
+
+  ASSERT_SUCC(OB_IO_MANAGER.remove_device_channel(&uring_device));
+  ASSERT_SUCC(uring_device.close(fd));
+  ob_free_align(write_buf);
+  ob_free_align(read_buf);
+  uring_device.destroy();
+}
+
 TEST_F(TestIOManager, alloc_memory)
 {
   // use multi thread to do some io stress, maybe use test_io_performance